@@ -2,6 +2,15 @@
 #include "MountedCombat.h"
 #include "DynamicPackages.h"
 #include "SpecialMovesets.h" // For IsInStandGround, IsInRapidFire
+#include "LogRateLimit.h"
+#include "GroundHeight.h"
+#include "MotionHistory.h"
+#include "HazardMap.h"
+#include "OccupancyGrid.h"
+#include "SteeringKernel.h"
+#include "CombatRecorder.h"
+#include "PerfCounters.h"
+#include "SpatialGrid.h"
 #include <mutex>
 #include <vector>
 #include <thread>
@@ -32,7 +41,7 @@ namespace MountedNPCCombatVR
 
 		for (UInt32 formID : pending)
 		{
-			TESForm* form = LookupFormByID(formID);
+			TESForm* form = CountedLookupFormByID(formID);
 			if (!form) continue;
 			Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
 			if (!actor) continue;
@@ -680,7 +689,7 @@ namespace MountedNPCCombatVR
 		// VALIDATE FORM ID BY LOOKING IT UP
 		// This ensures the FormID is still valid in the game
 		// ============================================
-		TESForm* verifyForm = LookupFormByID(actorFormID);
+		TESForm* verifyForm = CountedLookupFormByID(actorFormID);
 		if (!verifyForm)
 		{
 			_MESSAGE("StopActorCombatAlarm: Actor %08X form lookup failed - skipping", actorFormID);
@@ -834,7 +843,7 @@ namespace MountedNPCCombatVR
 		UInt32 actorFormID = g_disengageQueue[oldestIdx].actorFormID;
 		
 		// Look up the actor
-		TESForm* form = LookupFormByID(actorFormID);
+		TESForm* form = CountedLookupFormByID(actorFormID);
 		if (!form)
 		{
 			_MESSAGE("ProcessQueuedDisengages: Actor %08X form not found - removing from queue", actorFormID);
@@ -863,11 +872,14 @@ namespace MountedNPCCombatVR
 	// MOUNT OBSTRUCTION DETECTION
 	// ============================================
 	
-	const int MAX_OBSTRUCTION_TRACKED = 5;
-	const float OBSTRUCTION_CHECK_INTERVAL = 0.25f;  // Check every 250ms
-	const float OBSTRUCTION_MOVE_THRESHOLD = 5.0f;   // Must move at least 5 units
+	const int MAX_OBSTRUCTION_TRACKED = 16;
+	const float OBSTRUCTION_CHECK_INTERVAL = 0.25f;  // Check each horse every 250ms
+	const int OBSTRUCTION_STAGGER_SLOTS = 8;         // Horses' checks are spread over this many phases of the interval
 	const float OBSTRUCTION_STATIONARY_TIME = 2.0f;  // Stationary for 2 sec = obstructed
 	const float OBSTRUCTION_RUNNING_TIME = 3.0f;     // Running in place for 3 sec = severely obstructed
+	const float OBSTRUCTION_OSCILLATION = 1.0f;      // Radians of back-and-forth turning per window = running in place
+	const float HAZARD_SIDE_PROBE_FORWARD = 200.0f;  // Known-hazard probes for side selection
+	const float HAZARD_SIDE_PROBE_SIDE = 256.0f;
 	const float SIDE_CHECK_DISTANCE =150.0f; // How far to check for side obstructions
 	const float SHEER_DROP_HEIGHT =400.0f; // Sheer drop threshold (units)
 	const float SHEER_PROBE_FORWARD =200.0f; // Forward probe distance
@@ -875,7 +887,7 @@ namespace MountedNPCCombatVR
 	
 	static HorseObstructionInfo g_obstructionData[MAX_OBSTRUCTION_TRACKED];
 	static int g_obstructionCount =0;
-	static float g_lastObstructionCheckTime =0;
+	static int g_obstructionStaggerPhase = 0;
 	
 	// Sheer drop cache
 	struct HorseSheerInfo
@@ -923,24 +935,40 @@ namespace MountedNPCCombatVR
 		HorseObstructionInfo* existing = GetHorseObstructionInfo(horseFormID);
 		if (existing) return existing;
 		
-		// Create new entry
+		// Create new entry (when full, reuse the entry checked longest ago)
+		HorseObstructionInfo* info = nullptr;
 		if (g_obstructionCount < MAX_OBSTRUCTION_TRACKED)
 		{
-			HorseObstructionInfo* info = &g_obstructionData[g_obstructionCount];
+			info = &g_obstructionData[g_obstructionCount];
+			g_obstructionCount++;
+		}
+		else
+		{
+			info = &g_obstructionData[0];
+			for (int i = 1; i < g_obstructionCount; i++)
+			{
+				if (g_obstructionData[i].nextCheckTime < info->nextCheckTime) info = &g_obstructionData[i];
+			}
+		}
+		
+		{
+			float now = GetObstructionTime();
+			int phase = g_obstructionStaggerPhase++ % OBSTRUCTION_STAGGER_SLOTS;
+			
 			info->horseFormID = horseFormID;
 			info->type = ObstructionType::None;
 			info->side = ObstructionSide::Unknown;
 			info->stuckDuration = 0;
-			info->lastMovementTime = GetObstructionTime();
+			info->lastMovementTime = now;
 			info->lastPosition = NiPoint3();
 			info->intendedDirection = NiPoint3();
 			info->stuckCount = 0;
+			info->nextCheckTime = now + phase * (OBSTRUCTION_CHECK_INTERVAL / OBSTRUCTION_STAGGER_SLOTS);
+			info->hazardRecorded = false;
 			info->isValid = true;
-			g_obstructionCount++;
-			return info;
 		}
 		
-		return nullptr;
+		return info;
 	}
 	
 	void ClearHorseObstructionInfo(UInt32 horseFormID)
@@ -955,6 +983,7 @@ namespace MountedNPCCombatVR
 					g_obstructionData[j] = g_obstructionData[j + 1];
 				}
 				g_obstructionCount--;
+				Motion::StopTrackingHorse(horseFormID);
 				return;
 			}
 		}
@@ -967,6 +996,7 @@ namespace MountedNPCCombatVR
 			g_obstructionData[i].isValid = false;
 		}
 		g_obstructionCount = 0;
+		g_obstructionStaggerPhase = 0;
 	}
 	
 	// ============================================
@@ -977,12 +1007,57 @@ namespace MountedNPCCombatVR
 	// If horse is stuck facing forward, we check which way the horse
 	// was drifting to determine which side has the obstruction.
 	
+	static bool IsKnownHazardAt(TESObjectCELL* cell, float x, float y)
+	{
+		return HazardMap::IsHazardAt(cell, x, y, HazardMap::HAZARD_STUCK) ||
+			HazardMap::IsHazardAt(cell, x, y, HazardMap::HAZARD_DROP);
+	}
+	
+	// ============================================
+	// ACTOR CHECK FOR STUCK HAZARDS
+	// ============================================
+	// A horse blocked by riders, their horses or anyone on foot is not
+	// stuck on the terrain. Any live actor (other than the horse and its
+	// own rider) within HAZARD_ACTOR_CLEARANCE counts.
+	
+	const float HAZARD_ACTOR_CLEARANCE = 300.0f;
+	
+	struct HazardActorFilter
+	{
+		UInt32 horseFormID;
+		UInt32 riderFormID;
+	};
+	
+	static bool IsOtherLiveActor(Actor* actor, void* context)
+	{
+		const HazardActorFilter* filter = static_cast<const HazardActorFilter*>(context);
+		return actor->formID != filter->horseFormID &&
+			actor->formID != filter->riderFormID &&
+			!actor->IsDead(1);
+	}
+	
+	static bool IsActorNearForHazard(Actor* horse)
+	{
+		HazardActorFilter filter;
+		filter.horseFormID = horse->formID;
+		filter.riderFormID = 0;
+		
+		NiPointer<Actor> rider;
+		if (CALL_MEMBER_FN(horse, GetMountedBy)(rider) && rider)
+		{
+			filter.riderFormID = rider->formID;
+		}
+		
+		return SpatialGrid::FindNearest(horse->pos.x, horse->pos.y, horse->pos.z,
+			HAZARD_ACTOR_CLEARANCE, IsOtherLiveActor, &filter) != nullptr;
+	}
+	
 	static ObstructionSide DetermineObstructionSide(Actor* horse, Actor* target)
 	{
 		if (!horse) return ObstructionSide::Unknown;
 		
-		// Get horse's current facing direction
-		float horseAngle = horse->rot.z;
+		// Get horse's facing direction (including this frame's queued turn)
+		float horseAngle = Steering::GetHeading(horse);
 		
 		// Calculate horse's forward and right vectors
 		float forwardX = sin(horseAngle);
@@ -1024,6 +1099,38 @@ namespace MountedNPCCombatVR
 			}
 		}
 		
+		// Known hazards (hazard map) just ahead on one side only
+		{
+			float aheadX = horse->pos.x + forwardX * HAZARD_SIDE_PROBE_FORWARD;
+			float aheadY = horse->pos.y + forwardY * HAZARD_SIDE_PROBE_FORWARD;
+			bool leftHazard = IsKnownHazardAt(horse->parentCell,
+				aheadX - rightX * HAZARD_SIDE_PROBE_SIDE, aheadY - rightY * HAZARD_SIDE_PROBE_SIDE);
+			bool rightHazard = IsKnownHazardAt(horse->parentCell,
+				aheadX + rightX * HAZARD_SIDE_PROBE_SIDE, aheadY + rightY * HAZARD_SIDE_PROBE_SIDE);
+			
+			if (leftHazard && !rightHazard)
+			{
+				_MESSAGE("AILogging: Known hazard ahead-left - LEFT side obstructed");
+				return ObstructionSide::Left;
+			}
+			if (rightHazard && !leftHazard)
+			{
+				_MESSAGE("AILogging: Known hazard ahead-right - RIGHT side obstructed");
+				return ObstructionSide::Right;
+			}
+		}
+		
+		// Nearest clear lane in the encounter's occupancy grid
+		{
+			float lateral = 0.0f;
+			if (Occupancy::FindClearLateralOffset(horse, horseAngle, 0, lateral))
+			{
+				_MESSAGE("AILogging: Clear lane %.0f units %s - %s side obstructed",
+					fabs(lateral), (lateral > 0.0f) ? "right" : "left", (lateral > 0.0f) ? "LEFT" : "RIGHT");
+				return (lateral > 0.0f) ? ObstructionSide::Left : ObstructionSide::Right;
+			}
+		}
+		
 		// If no clear drift, check the intended direction vs current facing
 		if (target)
 		{
@@ -1226,23 +1333,23 @@ namespace MountedNPCCombatVR
 		
 		float currentTime = GetObstructionTime();
 		
-		// Rate limit checks
-		if ((currentTime - g_lastObstructionCheckTime) < OBSTRUCTION_CHECK_INTERVAL)
-		{
-			// Return cached type if we have it
-			HorseObstructionInfo* info = GetHorseObstructionInfo(horse->formID);
-			if (info) return info->type;
-			return ObstructionType::None;
-		}
-		g_lastObstructionCheckTime = currentTime;
+		// Motion history is sampled every frame; keep it alive while we ask
+		Motion::HorseMotion* motion = Motion::TrackHorse(horse);
 		
 		HorseObstructionInfo* info = GetOrCreateObstructionInfo(horse->formID);
-		if (!info) return ObstructionType::None;
+		if (!info || !motion) return ObstructionType::None;
 		
-		// Calculate distance moved since last check
-		float dx = horse->pos.x - info->lastPosition.x;
-		float dy = horse->pos.y - info->lastPosition.y;
-		float distanceMoved = sqrt(dx * dx + dy * dy);
+		// Per-horse rate limit - each horse has its own phase in the interval,
+		// so checks are spread across frames and no horse gets another's result
+		if (currentTime < info->nextCheckTime)
+		{
+			return info->type;
+		}
+		if ((currentTime - info->nextCheckTime) > OBSTRUCTION_CHECK_INTERVAL)
+		{
+			info->nextCheckTime = currentTime;
+		}
+		info->nextCheckTime += OBSTRUCTION_CHECK_INTERVAL;
 		
 		// Store intended direction (toward target)
 		if (target)
@@ -1252,33 +1359,28 @@ namespace MountedNPCCombatVR
 			info->intendedDirection.z = 0;
 		}
 		
-		// If horse moved enough, update position and reset
-		if (distanceMoved > OBSTRUCTION_MOVE_THRESHOLD)
+		// Stuck clock and drift anchor come from the motion history
+		info->lastPosition = motion->anchor;
+		info->lastMovementTime = motion->lastMovedTime;
+		info->stuckDuration = Motion::GetStillDuration(motion, currentTime);
+		
+		// Horse moved recently - reset
+		if (info->stuckDuration < OBSTRUCTION_STATIONARY_TIME)
 		{
-			info->lastPosition = horse->pos;
-			info->lastMovementTime = currentTime;
-			info->stuckDuration = 0;
 			info->type = ObstructionType::None;
 			info->side = ObstructionSide::Unknown;
+			info->hazardRecorded = false;
 			return ObstructionType::None;
 		}
 		
-		// Initialize if first check
-		if (info->lastMovementTime == 0)
-		{
-			info->lastPosition = horse->pos;
-			info->lastMovementTime = currentTime;
-			return ObstructionType::None;
-		}
-		
-		// Calculate how long we've been stuck
-		info->stuckDuration = currentTime - info->lastMovementTime;
-		
-		// Determine obstruction type based on duration
+		// Determine obstruction type based on duration and how the horse is
+		// behaving in place (swinging back and forth = trying to get out)
 		ObstructionType newType = ObstructionType::None;
 		ObstructionSide newSide = ObstructionSide::Unknown;
 		
-		if (info->stuckDuration >= OBSTRUCTION_RUNNING_TIME)
+		bool oscillating = Motion::GetHeadingOscillation(motion) >= OBSTRUCTION_OSCILLATION;
+		
+		if (info->stuckDuration >= OBSTRUCTION_RUNNING_TIME || oscillating)
 		{
 			// Check if there's a MovementBlocked package
 			TESPackage* pkg = GetActorCurrentPackage(horse);
@@ -1294,7 +1396,7 @@ namespace MountedNPCCombatVR
 			// Determine which side is blocked
 			newSide = DetermineObstructionSide(horse, target);
 		}
-		else if (info->stuckDuration >= OBSTRUCTION_STATIONARY_TIME)
+		else
 		{
 			newType = ObstructionType::Stationary;
 			newSide = DetermineObstructionSide(horse, target);
@@ -1307,6 +1409,17 @@ namespace MountedNPCCombatVR
 			LogObstructionDiagnostic(horse, target, newType, newSide);
 		}
 		
+		// Teach the hazard map once per stuck episode (it needs
+		// HAZARD_STUCK_CONFIRM episodes on the same spot before steering
+		// trusts it). Actors are not hazards: while another live actor is
+		// close, the block is probably them, so nothing is recorded yet.
+		if (newType != ObstructionType::Stationary && !info->hazardRecorded &&
+			!IsActorNearForHazard(horse))
+		{
+			HazardMap::MarkHazard(horse->parentCell, horse->pos.x, horse->pos.y, HazardMap::HAZARD_STUCK);
+			info->hazardRecorded = true;
+		}
+		
 		info->type = newType;
 		info->side = newSide;
 		return newType;
@@ -1320,18 +1433,27 @@ namespace MountedNPCCombatVR
 				return &g_horseSheerData[i];
 		}
 		
+		// New entry (when full, reuse the entry checked longest ago)
+		HorseSheerInfo* info = nullptr;
 		if (g_horseSheerCount < MAX_OBSTRUCTION_TRACKED)
 		{
-			HorseSheerInfo* info = &g_horseSheerData[g_horseSheerCount];
-			info->horseFormID = horseFormID;
-			info->nearSheer = false;
-			info->lastCheckTime =0;
-			info->isValid = true;
+			info = &g_horseSheerData[g_horseSheerCount];
 			g_horseSheerCount++;
-			return info;
+		}
+		else
+		{
+			info = &g_horseSheerData[0];
+			for (int i = 1; i < g_horseSheerCount; i++)
+			{
+				if (g_horseSheerData[i].lastCheckTime < info->lastCheckTime) info = &g_horseSheerData[i];
+			}
 		}
 		
-		return nullptr;
+		info->horseFormID = horseFormID;
+		info->nearSheer = false;
+		info->lastCheckTime =0;
+		info->isValid = true;
+		return info;
 	}
 	
 	bool IsHorseNearSheerDrop(UInt32 horseFormID)
@@ -1340,13 +1462,16 @@ namespace MountedNPCCombatVR
 		return s ? s->nearSheer : false;
 	}
 	
-	// Simple helper to sample ground Z at a world position. Uses a small downward probe by
-	// checking objects at the position - fallback to current position Z if not found.
-	static float SampleGroundZAt(const NiPoint3& pos)
+	// Ground Z at a probe from the cached terrain tiles. Falls back to the
+	// probe's own Z (no drop) where no tile covers it. Only called when
+	// terrain is usable, which needs the experimental TerrainHeightSampling.
+	static float SampleGroundZAt(UInt32 worldSpaceFormID, const NiPoint3& pos)
 	{
-		// Heuristic: try HasLOS downward to see if there's ground. As a fallback, assume terrain at pos.z -0.
-		// We don't have an explicit terrain height API here, so use pos.z as proxy and rely on relative checks.
-		// In practice this will work because our probes offset Z relative to horse and we care about large differences.
+		float groundZ = 0.0f;
+		if (GroundHeight::GetGroundHeight(worldSpaceFormID, pos.x, pos.y, groundZ))
+		{
+			return groundZ;
+		}
 		return pos.z;
 	}
 	
@@ -1361,12 +1486,21 @@ namespace MountedNPCCombatVR
 		// Rate limit shear checks to obstruction interval
 		if ((now - s->lastCheckTime) < OBSTRUCTION_CHECK_INTERVAL)
 		{
+			if (s->nearSheer) CombatRecorder::NoteInputFlags(horse->formID, CombatRecorder::RECORDER_INPUT_SHEER_DROP);
 			return s->nearSheer;
 		}
 		s->lastCheckTime = now;
 		
+		// Terrain for the horse's cell (read once, then cached), checked
+		// against where the horse actually stands before it is trusted.
+		// Without terrain, only edges already in the hazard map are found.
+		UInt32 worldSpaceFormID = GroundHeight::GetCellWorldSpaceID(horse->parentCell);
+		bool terrainUsable = GroundHeight::CacheCellHeights(horse->parentCell) &&
+			GroundHeight::CalibrateAt(worldSpaceFormID, horse->pos.x, horse->pos.y, horse->pos.z);
+		bool terrainVerified = terrainUsable && GroundHeight::IsEngineSamplingVerified();
+		
 		// Compute probe points (forward, forward-left, forward-right, left, right)
-		float angle = horse->rot.z;
+		float angle = Steering::GetHeading(horse);
 		float fwdX = sin(angle);
 		float fwdY = cos(angle);
 		float rightX = cos(angle);
@@ -1403,9 +1537,25 @@ namespace MountedNPCCombatVR
 		
 		for (int i =0; i <5; i++)
 		{
-			float groundZ = SampleGroundZAt(probes[i]);
-			float drop = horseZ - groundZ;
-			if (drop >= SHEER_DROP_HEIGHT)
+			bool isDrop = false;
+			if (terrainUsable)
+			{
+				float groundZ = SampleGroundZAt(worldSpaceFormID, probes[i]);
+				isDrop = (horseZ - groundZ) >= SHEER_DROP_HEIGHT;
+				
+				// Remember the edge for later sessions (only once the
+				// terrain data has been verified - a bad read must not persist)
+				if (isDrop && terrainVerified)
+				{
+					HazardMap::MarkHazard(horse->parentCell, probes[i].x, probes[i].y, HazardMap::HAZARD_DROP);
+				}
+			}
+			if (!isDrop)
+			{
+				isDrop = HazardMap::IsHazardAt(horse->parentCell, probes[i].x, probes[i].y, HazardMap::HAZARD_DROP);
+			}
+			
+			if (isDrop)
 			{
 				foundSheer = true;
 				// Map probe to side
@@ -1417,6 +1567,11 @@ namespace MountedNPCCombatVR
 		
 		s->nearSheer = foundSheer;
 		
+		uint8_t terrainInputs = CombatRecorder::RECORDER_INPUT_TERRAIN_CHECKED;
+		if (terrainUsable) terrainInputs |= CombatRecorder::RECORDER_INPUT_TERRAIN_USABLE;
+		if (foundSheer) terrainInputs |= CombatRecorder::RECORDER_INPUT_SHEER_DROP;
+		CombatRecorder::NoteInputFlags(horse->formID, terrainInputs);
+		
 		if (foundSheer)
 		{
 			const char* which = "UNKNOWN";
@@ -1424,7 +1579,7 @@ namespace MountedNPCCombatVR
 			else if (!sideSheerLeft && sideSheerRight) which = "RIGHT";
 			else if (sideSheerLeft && sideSheerRight) which = "BOTH/FRONT";
 			
-			_MESSAGE("AILogging: SHEER DROP DETECTED near Horse %08X - Direction: %s - threshold: %.1f units", 
+			LOG_LIMITED(LOGSYS_AI_LOGGING, horse->formID, 0.5f, 2.0f, "AILogging: SHEER DROP DETECTED near Horse %08X - Direction: %s - threshold: %.1f units", 
 				horse->formID, which, SHEER_DROP_HEIGHT);
 		}
 		
@@ -83,6 +83,8 @@ namespace MountedNPCCombatVR
 		NiPoint3 lastPosition; // Last known good position
 		NiPoint3 intendedDirection; // Where it's trying to go
 		int stuckCount; // How many times stuck this session
+		float nextCheckTime; // Per-horse rate limit (staggered phase)
+		bool hazardRecorded; // This stuck episode was written to the hazard map
 		bool isValid;
 	};
 	
@@ -3,6 +3,10 @@
 #include "DynamicPackages.h"
 #include "Helper.h"
 #include "config.h"
+#include "AsyncLogger.h"
+#include "ManeuverScript.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include "skse64/GameObjects.h"
@@ -107,7 +111,10 @@ namespace MountedNPCCombatVR
 	const float BOW_EQUIP_DELAY = 1.5f;      // Must have bow equipped for 1.5 seconds before drawing
 	const float BOW_DRAW_MIN_TIME = 2.0f;    // Minimum draw hold time
 	const float BOW_DRAW_MAX_TIME = 3.5f;    // Maximum draw hold time
-	const float BOW_STATE_TIMEOUT = 3.5f;    // Force release if stuck in draw/hold for 3.5 seconds (failsafe)
+	const float BOW_STATE_TIMEOUT = 3.5f;    // Restart the equip wait if attacks stay disallowed this long (failsafe)
+	
+	// Sent by the behavior graph when the bow reaches full draw
+	static const char* BOW_FULL_DRAW_EVENT = "BowDrawn";
 	
 	// Cached bow attack idles
 	static TESIdleForm* g_bowAttackCharge = nullptr;
@@ -115,6 +122,8 @@ namespace MountedNPCCombatVR
 	static bool g_bowIdlesInitialized = false;
 	
 	// Bow attack state tracking per rider
+	// The sequence runs as a maneuver script (RunBowAttackScript); the
+	// state only reports its current phase (IsBowDrawnAndReady)
 	enum class BowAttackState
 	{
 		None = 0,
@@ -131,7 +140,8 @@ namespace MountedNPCCombatVR
 		float bowEquipTime;       // When bow was equipped
 		float drawStartTime;    // When draw animation started
 		float holdDuration;               // Random hold time (2-3.5 seconds)
-		float stateEntryTime;        // When current state was entered (for timeout detection)
+		int drawRejections;       // Consecutive rejected draw animations
+		ManeuverScript::ScriptState script;  // RunBowAttackScript
 		bool arrowsEquippedThisSession; // True if arrows were equipped this combat session
 		bool isValid;
 	};
@@ -215,6 +225,57 @@ namespace MountedNPCCombatVR
 		return get_vfunc<_IAnimationGraphManagerHolder_NotifyAnimationGraph>(&actor->animGraphHolder, 0x1)(&actor->animGraphHolder, event);
 	}
 	
+	// ============================================
+	// ANIMATION EVENT HOOK
+	// ============================================
+	// Feeds the maneuver script animation event mailbox
+	// (SCRIPT_WAIT_ANIM_EVENT). Every Character shares one
+	// BSTEventSink<BSAnimationGraphEvent> vtable, so its ReceiveEvent slot
+	// is swapped once, read from the first rider that needs it (same
+	// scheme as the projectile update hooks). Runs on the animation
+	// graph's thread; PostAnimationEvent drops unwatched actors without
+	// taking a lock.
+	// ============================================
+	
+	// Layout of BSAnimationGraphEvent
+	struct AnimationGraphEventData
+	{
+		BSFixedString tag;
+		TESObjectREFR* holder;
+		BSFixedString payload;
+	};
+	
+	typedef EventResult (*_ReceiveAnimationGraphEvent)(void* sink, AnimationGraphEventData* evn, void* dispatcher);
+	static _ReceiveAnimationGraphEvent g_originalReceiveAnimEvent = nullptr;
+	static bool g_animEventHookInstalled = false;
+	
+	static EventResult ReceiveAnimationGraphEvent_Hook(void* sink, AnimationGraphEventData* evn, void* dispatcher)
+	{
+		if (evn && evn->holder && evn->tag.data)
+		{
+			ManeuverScript::PostAnimationEvent(evn->holder->formID, evn->tag.data);
+		}
+		return g_originalReceiveAnimEvent(sink, evn, dispatcher);
+	}
+	
+	static void InstallAnimationEventHook(Actor* rider)
+	{
+		if (g_animEventHookInstalled || !rider) return;
+		
+		// The player has a vtable of its own
+		if (rider == *g_thePlayer) return;
+		
+		uintptr_t* vtbl = *(uintptr_t**)&rider->animGraphEventSink;
+		if (!vtbl) return;
+		
+		// Save original function, then write our hook
+		g_originalReceiveAnimEvent = (_ReceiveAnimationGraphEvent)vtbl[1];
+		SafeWrite64((uintptr_t)&vtbl[1], (uintptr_t)&ReceiveAnimationGraphEvent_Hook);
+		
+		g_animEventHookInstalled = true;
+		_MESSAGE("ArrowSystem: Animation event hook installed (from rider %08X)", rider->formID);
+	}
+	
 	// ============================================
 	// PROJECTILE UPDATE HOOK
 	// ============================================
@@ -231,6 +292,8 @@ namespace MountedNPCCombatVR
 		if (!g_hookProcessingEnabled || !proj) return;
 		if (proj->formID == 0 || proj->formID == 0xFFFFFFFF) return;
 		
+		TRACE_SCOPE_FORM("ProjectileHook", proj->formID);
+		
 		try
 		{
 			// Removed per-projectile logging - too verbose
@@ -313,8 +376,10 @@ namespace MountedNPCCombatVR
 						if (proj->velocity.x < 0.0f)
 							proj->rot.z += 3.14159265f;
 						
+						PERF_COUNT(ProjectileRedirects);
+						
 						// Only log redirects - significant events
-						_MESSAGE("ArrowSystem: Redirected arrow %08X from %08X", proj->formID, shooterFormID);
+						ASYNC_MESSAGE("ArrowSystem: Redirected arrow %08X from %08X", proj->formID, shooterFormID);
 					}
 					
 					g_redirectedProjectiles[proj->formID] = true;
@@ -440,8 +505,8 @@ namespace MountedNPCCombatVR
 			// Validate form IDs
 			if (shooterID == 0 || targetID == 0) continue;
 			
-			TESForm* shooterForm = LookupFormByID(shooterID);
-			TESForm* targetForm = LookupFormByID(targetID);
+			TESForm* shooterForm = CountedLookupFormByID(shooterID);
+			TESForm* targetForm = CountedLookupFormByID(targetID);
 			
 			if (!shooterForm || !targetForm) continue;
 			
@@ -486,8 +551,8 @@ namespace MountedNPCCombatVR
 		
 		virtual void Run() override
 		{
-			TESForm* shooterForm = LookupFormByID(m_shooterFormID);
-			TESForm* targetForm = LookupFormByID(m_targetFormID);
+			TESForm* shooterForm = CountedLookupFormByID(m_shooterFormID);
+			TESForm* targetForm = CountedLookupFormByID(m_targetFormID);
 			
 			if (!shooterForm || !targetForm)
 			{
@@ -508,7 +573,7 @@ namespace MountedNPCCombatVR
 				UInt32 spellFormID = GetFullFormIdMine(ARROW_SPELL_ESP_NAME, ARROW_SPELL_BASE_FORMID);
 				if (spellFormID != 0)
 				{
-					TESForm* spellForm = LookupFormByID(spellFormID);
+					TESForm* spellForm = CountedLookupFormByID(spellFormID);
 					if (spellForm)
 					{
 						g_arrowSpell = DYNAMIC_CAST(spellForm, TESForm, SpellItem);
@@ -591,6 +656,7 @@ namespace MountedNPCCombatVR
 			targetIsPlayer ? "YES" : "NO");
 		
 		// Queue the spell cast task
+		PERF_COUNT(TaskSubmissions);
 		g_task->AddTask(new TaskCastArrowSpell(shooter, target, targetPos.x, targetPos.y, targetAimZ));
 		
 		return true;
@@ -610,7 +676,7 @@ namespace MountedNPCCombatVR
 		
 		if (chargeFormID != 0)
 		{
-			TESForm* chargeForm = LookupFormByID(chargeFormID);
+			TESForm* chargeForm = CountedLookupFormByID(chargeFormID);
 			if (chargeForm)
 			{
 				g_bowAttackCharge = DYNAMIC_CAST(chargeForm, TESForm, TESIdleForm);
@@ -623,7 +689,7 @@ namespace MountedNPCCombatVR
 		
 		if (releaseFormID != 0)
 		{
-			TESForm* releaseForm = LookupFormByID(releaseFormID);
+			TESForm* releaseForm = CountedLookupFormByID(releaseFormID);
 			if (releaseForm)
 			{
 				g_bowAttackRelease = DYNAMIC_CAST(releaseForm, TESForm, TESIdleForm);
@@ -661,7 +727,8 @@ namespace MountedNPCCombatVR
 			data->bowEquipTime = 0;
 			data->drawStartTime = 0;
 			data->holdDuration = 0;
-			data->stateEntryTime = 0;
+			data->drawRejections = 0;
+			ManeuverScript::ResetScript(data->script);
 			data->arrowsEquippedThisSession = false;
 			data->isValid = true;
 			g_riderBowCount++;
@@ -685,7 +752,7 @@ namespace MountedNPCCombatVR
 				if (g_riderBowData[i].state == BowAttackState::Drawing || 
 					g_riderBowData[i].state == BowAttackState::Holding)
 				{
-					TESForm* riderForm = LookupFormByID(riderFormID);
+					TESForm* riderForm = CountedLookupFormByID(riderFormID);
 					if (riderForm)
 					{
 						Actor* rider = DYNAMIC_CAST(riderForm, TESForm, Actor);
@@ -712,7 +779,34 @@ namespace MountedNPCCombatVR
 				g_riderBowData[i].bowEquipTime = 0;
 				g_riderBowData[i].drawStartTime = 0;
 				g_riderBowData[i].holdDuration = 0;
-				g_riderBowData[i].stateEntryTime = 0;
+				g_riderBowData[i].drawRejections = 0;
+				ManeuverScript::StopScript(g_riderBowData[i].script);
+				ManeuverScript::UnwatchAnimationEvents(riderFormID);
+				return;
+			}
+		}
+	}
+	
+	void RemoveBowAttackRider(UInt32 riderFormID)
+	{
+		if (riderFormID == 0) return;
+		
+		// The watch may outlive the bow slot (ResetArrowSystemCache)
+		ManeuverScript::UnwatchAnimationEvents(riderFormID);
+		
+		for (int i = 0; i < g_riderBowCount; i++)
+		{
+			if (g_riderBowData[i].isValid && g_riderBowData[i].riderFormID == riderFormID)
+			{
+				// Shift the rest down (ScriptState is plain data)
+				for (int j = i; j < g_riderBowCount - 1; j++)
+				{
+					g_riderBowData[j] = g_riderBowData[j + 1];
+				}
+				g_riderBowCount--;
+				g_riderBowData[g_riderBowCount].isValid = false;
+				g_riderBowData[g_riderBowCount].riderFormID = 0;
+				ManeuverScript::ResetScript(g_riderBowData[g_riderBowCount].script);
 				return;
 			}
 		}
@@ -758,9 +852,9 @@ namespace MountedNPCCombatVR
 					
 					if (PlayBowReleaseAnimation(rider, target))
 					{
-						// Reset state after release
+						// Start the sequence over (equip delay before the next draw)
 						g_riderBowData[i].state = BowAttackState::Released;
-						g_riderBowData[i].stateEntryTime = GetGameTimeSeconds();
+						ManeuverScript::StartScript(g_riderBowData[i].script, GetGameTimeSeconds());
 						return true;
 					}
 					else
@@ -769,6 +863,7 @@ namespace MountedNPCCombatVR
 						_MESSAGE("ArrowSystem: FORCE RELEASE - Animation failed, firing arrow directly for rider %08X", rider->formID);
 						ScheduleDelayedArrowFire(rider, target);
 						g_riderBowData[i].state = BowAttackState::None;
+						ManeuverScript::StopScript(g_riderBowData[i].script);
 						return true;
 					}
 				}
@@ -879,9 +974,92 @@ namespace MountedNPCCombatVR
 	}
 	
 	// ============================================
-	// BOW ATTACK STATE MACHINE
+	// BOW ATTACK SCRIPT
 	// ============================================
 	
+	// Equip arrows once per session and start the draw animation.
+	// Returns false if the graph rejected the draw.
+	static bool StartBowDraw(RiderBowAttackData* data, Actor* rider, float currentTime)
+	{
+		if (!data->arrowsEquippedThisSession)
+		{
+			EquipArrows(rider);
+			data->arrowsEquippedThisSession = true;
+		}
+		
+		if (!PlayBowDrawAnimation(rider))
+		{
+			// Animation rejected - track and log if it keeps happening
+			data->drawRejections++;
+			if (data->drawRejections >= 5)
+			{
+				_MESSAGE("ArrowSystem: Rider %08X - 5 consecutive animation rejections, full reset", rider->formID);
+				data->drawRejections = 0;
+			}
+			return false;
+		}
+		
+		data->drawRejections = 0;
+		data->drawStartTime = currentTime;
+		
+		EnsureRandomSeeded();
+		float randomRange = BowDrawMaxTime - BowDrawMinTime;
+		data->holdDuration = BowDrawMinTime + (((float)(rand() % 100)) / 100.0f * randomRange);
+		return true;
+	}
+	
+	// Equip delay, draw, hold, release - repeated while the bow stays
+	// equipped and drawn. Returns true while suspended.
+	static bool RunBowAttackScript(RiderBowAttackData* data, Actor* rider, bool allowAttack, Actor* target, float now)
+	{
+		SCRIPT_BEGIN(data->script);
+		
+		for (;;)
+		{
+			data->state = BowAttackState::WaitingToEquip;
+			data->bowEquipTime = now;
+			SCRIPT_WAIT_SECONDS(data->script, now, BOW_EQUIP_DELAY);
+			
+			// Attacks disallowed for too long - start the equip wait over
+			SCRIPT_WAIT_UNTIL(data->script, now, allowAttack, BOW_STATE_TIMEOUT - BOW_EQUIP_DELAY);
+			if (data->script.timedOut)
+			{
+				_MESSAGE("ArrowSystem: Rider %08X stuck in WaitingToEquip for %.1fs - resetting", rider->formID, now - data->bowEquipTime);
+				continue;
+			}
+			
+			// Draw rejected - try again after another equip delay
+			if (!StartBowDraw(data, rider, now))
+			{
+				continue;
+			}
+			
+			data->state = BowAttackState::Drawing;
+			SCRIPT_YIELD(data->script);
+			
+			// The hold time counts from full draw. If the graph never
+			// reports it (draw interrupted), release once the hold time
+			// has passed since the draw started.
+			data->state = BowAttackState::Holding;
+			SCRIPT_WAIT_ANIM_EVENT(data->script, now, data->riderFormID, BOW_FULL_DRAW_EVENT, data->holdDuration);
+			if (!data->script.timedOut)
+			{
+				SCRIPT_WAIT_SECONDS(data->script, now, data->holdDuration);
+			}
+			
+			if (!PlayBowReleaseAnimation(rider, target))
+			{
+				_MESSAGE("ArrowSystem: Rider %08X bow release failed - resetting", rider->formID);
+				continue;
+			}
+			
+			data->state = BowAttackState::Released;
+			SCRIPT_YIELD(data->script);
+		}
+		
+		SCRIPT_END(data->script);
+	}
+	
 	bool UpdateBowAttack(Actor* rider, bool allowAttack, Actor* target)
 	{
 		if (!rider) return false;
@@ -908,141 +1086,20 @@ namespace MountedNPCCombatVR
 		
 		float currentTime = GetGameTimeSeconds();
 		
-		// Timeout check - ALSO reset if stuck for too long
-		if (data->state != BowAttackState::None && data->stateEntryTime > 0)
+		if (!ManeuverScript::IsScriptRunning(data->script))
 		{
-			float timeInState = currentTime - data->stateEntryTime;
-			
-			if (timeInState >= BOW_STATE_TIMEOUT)
-			{
-				if (data->state == BowAttackState::Drawing || data->state == BowAttackState::Holding)
-				{
-					// Don't use animation cancel - just reset state cleanly
-					// Animation cancel can cause rider to stand on horse
-					_MESSAGE("ArrowSystem: Rider %08X bow state TIMEOUT (%.1fs) - resetting state (no animation cancel)", rider->formID, timeInState);
-					data->state = BowAttackState::None;
-					data->bowEquipTime = currentTime;
-					data->stateEntryTime = currentTime;
-					return false;
-				}
-				else if (data->state == BowAttackState::WaitingToEquip)
-				{
-					// Stuck in waiting state too long - reset
-					_MESSAGE("ArrowSystem: Rider %08X stuck in WaitingToEquip for %.1fs - resetting", rider->formID, timeInState);
-					data->state = BowAttackState::None;
-					data->bowEquipTime = currentTime;
-					data->stateEntryTime = currentTime;
-					return false;
-				}
-				else
-				{
-					data->state = BowAttackState::None;
-					data->bowEquipTime = currentTime;
-					data->stateEntryTime = currentTime;
-					return false;
-				}
-			}
+			InstallAnimationEventHook(rider);
+			ManeuverScript::WatchAnimationEvents(rider->formID);
+			ManeuverScript::StartScript(data->script, currentTime);
 		}
 		
-		// Track consecutive animation rejections
-		static int s_consecutiveRejections = 0;
-		
-		switch (data->state)
+		// A script waiting out a delay is not entered until it is due
+		if (ManeuverScript::IsScriptDue(data->script, currentTime))
 		{
-			case BowAttackState::None:
-			{
-				data->state = BowAttackState::WaitingToEquip;
-				data->bowEquipTime = currentTime;
-				data->stateEntryTime = currentTime;
-				s_consecutiveRejections = 0;  // Reset rejection counter
-				return false;
-			}
-			
-			case BowAttackState::WaitingToEquip:
-			{
-				if ((currentTime - data->bowEquipTime) >= BOW_EQUIP_DELAY)
-				{
-					if (allowAttack)
-					{
-						if (!data->arrowsEquippedThisSession)
-						{
-							EquipArrows(rider);
-							data->arrowsEquippedThisSession = true;
-						}
-						
-						if (PlayBowDrawAnimation(rider))
-						{
-							data->state = BowAttackState::Drawing;
-							data->drawStartTime = currentTime;
-							data->stateEntryTime = currentTime;
-							s_consecutiveRejections = 0;  // Reset on success
-							
-							EnsureRandomSeeded();
-							float randomRange = BowDrawMaxTime - BowDrawMinTime;
-							data->holdDuration = BowDrawMinTime + (((float)(rand() % 100)) / 100.0f * randomRange);
-						}
-						else
-						{
-							// Animation rejected - track and reset if too many
-							s_consecutiveRejections++;
-							
-							if (s_consecutiveRejections >= 5)
-							{
-								_MESSAGE("ArrowSystem: Rider %08X - 5 consecutive animation rejections, full reset", rider->formID);
-								data->state = BowAttackState::None;
-								data->stateEntryTime = currentTime;
-								s_consecutiveRejections = 0;
-							}
-							else
-							{
-								// Just reset the equip timer to try again
-								data->bowEquipTime = currentTime;
-							}
-						}
-					}
-				}
-				return false;
-			}
-			
-			case BowAttackState::Drawing:
-			{
-				data->state = BowAttackState::Holding;
-				data->stateEntryTime = currentTime;
-				return true;
-			}
-			
-			case BowAttackState::Holding:
-			{
-				if ((currentTime - data->drawStartTime) >= data->holdDuration)
-				{
-					if (PlayBowReleaseAnimation(rider, target))
-					{
-						data->state = BowAttackState::Released;
-						data->stateEntryTime = currentTime;
-					}
-					else
-					{
-						// Release failed - go back to None and try again
-						_MESSAGE("ArrowSystem: Rider %08X bow release failed - resetting", rider->formID);
-						data->state = BowAttackState::None;
-						data->bowEquipTime = currentTime;
-						data->stateEntryTime = currentTime;
-					}
-				}
-				return true;
-			}
-			
-			case BowAttackState::Released:
-			{
-				data->state = BowAttackState::None;
-				data->bowEquipTime = currentTime;
-				data->stateEntryTime = currentTime;
-				return false;
-			}
-			
-			default:
-				return false;
+			RunBowAttackScript(data, rider, allowAttack, target, currentTime);
 		}
+		
+		return (data->state == BowAttackState::Drawing || data->state == BowAttackState::Holding);
 	}
 	
 	// ============================================
@@ -1069,6 +1126,13 @@ namespace MountedNPCCombatVR
 		
 		ClearPendingProjectileAims();
 		
+		// Dropping the slots must drop their watches too, or the
+		// ANIM_EVENT_WATCH_SLOTS fill up with riders nobody tracks
+		for (int i = 0; i < g_riderBowCount; i++)
+		{
+			if (g_riderBowData[i].isValid) ManeuverScript::UnwatchAnimationEvents(g_riderBowData[i].riderFormID);
+		}
+		
 		g_riderBowCount = 0;
 		for (int i = 0; i < 5; i++)
 		{
@@ -1097,7 +1161,7 @@ namespace MountedNPCCombatVR
 		// Initialize Ice Spike spell if needed
 		if (!g_rapidFireIceSpikeInitialized)
 		{
-			TESForm* spellForm = LookupFormByID(RAPID_FIRE_ICE_SPIKE_FORMID);
+			TESForm* spellForm = CountedLookupFormByID(RAPID_FIRE_ICE_SPIKE_FORMID);
 			if (spellForm)
 			{
 				g_rapidFireIceSpikeSpell = DYNAMIC_CAST(spellForm, TESForm, SpellItem);
@@ -1437,7 +1501,7 @@ namespace MountedNPCCombatVR
 					(g_rapidFireBowData[i].state == RapidFireBowState::Drawing ||
 					 g_rapidFireBowData[i].state == RapidFireBowState::Holding))
 				{
-					TESForm* riderForm = LookupFormByID(riderFormID);
+					TESForm* riderForm = CountedLookupFormByID(riderFormID);
 					if (riderForm)
 					{
 						Actor* rider = DYNAMIC_CAST(riderForm, TESForm, Actor);
@@ -1534,10 +1598,12 @@ namespace MountedNPCCombatVR
 			g_riderBowData[i].bowEquipTime = 0;
 			g_riderBowData[i].drawStartTime = 0;
 			g_riderBowData[i].holdDuration = 0;
-			g_riderBowData[i].stateEntryTime = 0;
+			g_riderBowData[i].drawRejections = 0;
+			ManeuverScript::ResetScript(g_riderBowData[i].script);
 			g_riderBowData[i].arrowsEquippedThisSession = false;
 		}
 		g_riderBowCount = 0;
+		ManeuverScript::ClearAnimationEvents();
 		
 		// Reset rapid fire bow attack data
 		for (int i = 0; i < MAX_RAPID_FIRE_RIDERS; i++)
@@ -80,6 +80,11 @@ namespace MountedNPCCombatVR
 	// Reset bow attack state (call when bow is unequipped)
 	void ResetBowAttackState(UInt32 riderFormID);
 	
+	// Forget a rider that is no longer tracked (died, untracked, companion
+	// unregistered): frees its bow slot and its animation event watch.
+	// Does not touch the actor, so it is safe for dead riders.
+	void RemoveBowAttackRider(UInt32 riderFormID);
+	
 	// Check if rider has bow drawn and ready to fire (in Drawing or Holding state)
 	// Used to decide whether to fire before switching weapons
 	bool IsBowDrawnAndReady(UInt32 riderFormID);
@@ -0,0 +1,308 @@
+#include "AsyncLogger.h"
+#include "common/IDebugLog.h"  // _MESSAGE only, so the logger builds with a stand-in (tests/)
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+namespace MountedNPCCombatVR
+{
+	namespace AsyncLog
+	{
+		// ============================================
+		// BOUNDED MPSC RING (sequence-numbered cells)
+		// ============================================
+		// Producers claim a ticket with a CAS on the enqueue position,
+		// fill the cell in place and publish it by bumping the cell
+		// sequence. The single consumer (background thread) waits for
+		// the sequence, formats the record and hands the cell back.
+		// ============================================
+
+		struct Cell
+		{
+			std::atomic<uint64_t> sequence;
+			Record record;
+		};
+
+		static_assert((ASYNC_LOG_RING_CAPACITY & (ASYNC_LOG_RING_CAPACITY - 1)) == 0, "Ring capacity must be a power of two");
+		const uint64_t RING_MASK = ASYNC_LOG_RING_CAPACITY - 1;
+
+		static Cell g_ring[ASYNC_LOG_RING_CAPACITY];
+		static std::atomic<uint64_t> g_enqueuePos(0);
+		static uint64_t g_dequeuePos = 0;  // Background thread only
+		static std::atomic<uint64_t> g_writtenCount(0);
+		static std::atomic<uint64_t> g_droppedCount(0);
+		static std::atomic<bool> g_ringInitialized(false);
+		static std::atomic<bool> g_writerStarted(false);
+
+		static void InitRing()
+		{
+			// Cell i starts out free for ticket i
+			for (uint64_t i = 0; i < ASYNC_LOG_RING_CAPACITY; i++)
+			{
+				g_ring[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			g_ringInitialized.store(true, std::memory_order_release);
+		}
+
+		Record* BeginRecord(uint64_t& outTicket)
+		{
+			if (!g_ringInitialized.load(std::memory_order_acquire))
+			{
+				g_droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			uint64_t pos = g_enqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Cell& cell = g_ring[pos & RING_MASK];
+				uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+				int64_t diff = (int64_t)seq - (int64_t)pos;
+
+				if (diff == 0)
+				{
+					if (g_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						outTicket = pos;
+						return &cell.record;
+					}
+				}
+				else if (diff < 0)
+				{
+					// Ring full - drop rather than stall the game thread
+					g_droppedCount.fetch_add(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+				else
+				{
+					pos = g_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void CommitRecord(uint64_t ticket)
+		{
+			g_ring[ticket & RING_MASK].sequence.store(ticket + 1, std::memory_order_release);
+		}
+
+		// ============================================
+		// FORMATTING (background thread)
+		// ============================================
+		// Walks the format string and formats each conversion with its
+		// captured argument. Length modifiers in the original format are
+		// replaced by the width the argument was captured with.
+		// ============================================
+
+		static bool IsFlagChar(char c)
+		{
+			return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+		}
+
+		static bool IsLengthChar(char c)
+		{
+			return c == 'h' || c == 'l' || c == 'L' || c == 'z' || c == 'j' || c == 't' || c == 'I' || c == '6' || c == '4' || c == '3' || c == '2';
+		}
+
+		static const char* GetStringArg(const Record& rec, int index)
+		{
+			uint16_t offset = rec.args[index].stringOffset;
+			if (offset == ASYNC_LOG_NULL_STRING || offset >= ASYNC_LOG_STRING_BYTES) return "(null)";
+			return rec.strings + offset;
+		}
+
+		static uint64_t GetUnsignedArg(const Record& rec, int index)
+		{
+			switch (rec.types[index])
+			{
+				case ArgType::Signed32: return (uint64_t)(uint32_t)rec.args[index].i;
+				case ArgType::Signed64: return (uint64_t)rec.args[index].i;
+				case ArgType::Double: return (uint64_t)rec.args[index].d;
+				case ArgType::Pointer: return (uint64_t)(uintptr_t)rec.args[index].p;
+				default: return rec.args[index].u;
+			}
+		}
+
+		static int64_t GetSignedArg(const Record& rec, int index)
+		{
+			switch (rec.types[index])
+			{
+				case ArgType::Signed32:
+				case ArgType::Signed64: return rec.args[index].i;
+				case ArgType::Double: return (int64_t)rec.args[index].d;
+				default: return (int64_t)GetUnsignedArg(rec, index);
+			}
+		}
+
+		static double GetDoubleArg(const Record& rec, int index)
+		{
+			switch (rec.types[index])
+			{
+				case ArgType::Double: return rec.args[index].d;
+				case ArgType::Signed32:
+				case ArgType::Signed64: return (double)rec.args[index].i;
+				default: return (double)GetUnsignedArg(rec, index);
+			}
+		}
+
+		void FormatRecord(const Record& rec, char* out, size_t outSize)
+		{
+			if (!out || outSize == 0) return;
+
+			size_t written = 0;
+			int argIndex = 0;
+			const char* p = rec.fmt ? rec.fmt : "";
+
+			while (*p && written + 1 < outSize)
+			{
+				if (*p != '%')
+				{
+					out[written++] = *p++;
+					continue;
+				}
+
+				if (p[1] == '%')
+				{
+					out[written++] = '%';
+					p += 2;
+					continue;
+				}
+
+				// Parse "%[flags][width][.precision][length]conv"
+				char spec[32];
+				size_t specLen = 0;
+				const char* specStart = p;
+				spec[specLen++] = *p++;
+
+				while (*p && IsFlagChar(*p) && specLen < 16) spec[specLen++] = *p++;
+				while (*p && ((*p >= '0' && *p <= '9') || *p == '.') && specLen < 24) spec[specLen++] = *p++;
+				while (*p && IsLengthChar(*p)) p++;
+
+				char conv = *p;
+				if (!conv) break;
+				p++;
+
+				if (argIndex >= rec.argCount || conv == '*' || conv == 'n')
+				{
+					// Missing argument or unsupported conversion - emit the spec verbatim
+					size_t rawLen = (size_t)(p - specStart);
+					for (size_t i = 0; i < rawLen && written + 1 < outSize; i++) out[written++] = specStart[i];
+					continue;
+				}
+
+				int result = 0;
+				char* dest = out + written;
+				size_t remaining = outSize - written;
+
+				switch (conv)
+				{
+					case 'd':
+					case 'i':
+						spec[specLen++] = 'l'; spec[specLen++] = 'l'; spec[specLen++] = 'd'; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec, (long long)GetSignedArg(rec, argIndex));
+						break;
+					case 'u':
+					case 'x':
+					case 'X':
+					case 'o':
+						spec[specLen++] = 'l'; spec[specLen++] = 'l'; spec[specLen++] = conv; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec, (unsigned long long)GetUnsignedArg(rec, argIndex));
+						break;
+					case 'c':
+						spec[specLen++] = 'c'; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec, (int)GetSignedArg(rec, argIndex));
+						break;
+					case 's':
+						spec[specLen++] = 's'; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec,
+							rec.types[argIndex] == ArgType::String ? GetStringArg(rec, argIndex) : "(?)");
+						break;
+					case 'p':
+						spec[specLen++] = 'p'; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec, rec.args[argIndex].p);
+						break;
+					default:
+						// f, F, e, E, g, G, a, A
+						spec[specLen++] = conv; spec[specLen] = '\0';
+						result = snprintf(dest, remaining, spec, GetDoubleArg(rec, argIndex));
+						break;
+				}
+
+				argIndex++;
+
+				if (result < 0) continue;
+				written += ((size_t)result < remaining) ? (size_t)result : (remaining - 1);
+			}
+
+			out[written] = '\0';
+		}
+
+		// ============================================
+		// BACKGROUND WRITER
+		// ============================================
+
+		static void WriterThread()
+		{
+			char line[4096];
+			uint64_t reportedDrops = 0;
+
+			for (;;)
+			{
+				Cell& cell = g_ring[g_dequeuePos & RING_MASK];
+				uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+
+				if (seq == g_dequeuePos + 1)
+				{
+					FormatRecord(cell.record, line, sizeof(line));
+
+					// Hand the cell back to producers for ticket + capacity
+					cell.sequence.store(g_dequeuePos + ASYNC_LOG_RING_CAPACITY, std::memory_order_release);
+					g_dequeuePos++;
+
+					_MESSAGE("%s", line);
+					g_writtenCount.store(g_dequeuePos, std::memory_order_release);
+					continue;
+				}
+
+				// Idle - report drops since last time, then back off
+				uint64_t drops = g_droppedCount.load(std::memory_order_relaxed);
+				if (drops != reportedDrops)
+				{
+					_MESSAGE("AsyncLog: %llu messages dropped (ring full) - %llu total",
+						(unsigned long long)(drops - reportedDrops), (unsigned long long)drops);
+					reportedDrops = drops;
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+		}
+
+		void StartAsyncLogger()
+		{
+			bool expected = false;
+			if (!g_writerStarted.compare_exchange_strong(expected, true)) return;
+
+			InitRing();
+			std::thread(WriterThread).detach();
+			_MESSAGE("AsyncLog: Background writer started (ring capacity %u)", ASYNC_LOG_RING_CAPACITY);
+		}
+
+		void FlushAsyncLogger(int timeoutMs)
+		{
+			if (!g_writerStarted.load()) return;
+
+			uint64_t target = g_enqueuePos.load(std::memory_order_acquire);
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+			while (g_writtenCount.load(std::memory_order_acquire) < target)
+			{
+				if (std::chrono::steady_clock::now() > deadline) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		uint64_t GetDroppedMessageCount()
+		{
+			return g_droppedCount.load(std::memory_order_relaxed);
+		}
+	}
+}
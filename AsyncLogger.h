@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ============================================
+// ASYNCHRONOUS RING-BUFFER LOGGER
+// ============================================
+// Replacement for _MESSAGE on per-tick paths. The calling thread
+// only copies the format pointer and the raw arguments into a
+// lock-free MPSC ring buffer; formatting and the IDebugLog write
+// happen on a background thread.
+//
+// Rules for call sites:
+// - The format string MUST be a string literal (only the pointer
+//   is stored).
+// - %s arguments are copied into the record, so temporary strings
+//   (actor names, std::string::c_str()) are safe.
+// - At most ASYNC_LOG_MAX_ARGS arguments; extra ones are dropped.
+//
+// When the ring is full the message is dropped and counted; the
+// background thread reports the drop count in the log.
+//
+// ORDERING: async lines are written when the background thread gets
+// to them (it polls every 2 ms when idle). A synchronous _MESSAGE
+// from the same frame can therefore appear BEFORE an ASYNC_MESSAGE
+// that was posted earlier. Lines from one thread through this logger
+// stay in order. Call FlushAsyncLogger() before a _MESSAGE that must
+// follow the queued lines (shutdown, crash diagnostics).
+//
+// Benchmark: tests/AsyncLoggerBench.cpp
+// ============================================
+
+// ============================================
+// COMPILE-TIME LEVEL STRIPPING
+// ============================================
+// Define ASYNC_LOG_COMPILE_LEVEL lower to strip the more verbose
+// macros completely from the binary (arguments are not evaluated).
+
+#define ASYNC_LOG_LEVEL_ERROR   0
+#define ASYNC_LOG_LEVEL_WARN    1
+#define ASYNC_LOG_LEVEL_INFO    2
+#define ASYNC_LOG_LEVEL_VERBOSE 3
+
+#ifndef ASYNC_LOG_COMPILE_LEVEL
+#define ASYNC_LOG_COMPILE_LEVEL ASYNC_LOG_LEVEL_VERBOSE
+#endif
+
+namespace MountedNPCCombatVR
+{
+	extern int logging;
+
+	namespace AsyncLog
+	{
+		const int ASYNC_LOG_MAX_ARGS = 12;
+		const int ASYNC_LOG_STRING_BYTES = 192;
+		const uint32_t ASYNC_LOG_RING_CAPACITY = 4096;  // Must be a power of two
+		const uint16_t ASYNC_LOG_NULL_STRING = 0xFFFF;
+
+		enum class ArgType : uint8_t
+		{
+			Signed32,     // int and smaller (re-narrowed for %x / %u)
+			Signed64,
+			Unsigned,
+			Double,
+			String,       // Offset into Record::strings
+			Pointer
+		};
+
+		union ArgValue
+		{
+			int64_t i;
+			uint64_t u;
+			double d;
+			const void* p;
+			uint16_t stringOffset;
+		};
+
+		struct Record
+		{
+			const char* fmt;
+			uint8_t argCount;
+			uint16_t stringBytesUsed;
+			ArgType types[ASYNC_LOG_MAX_ARGS];
+			ArgValue args[ASYNC_LOG_MAX_ARGS];
+			char strings[ASYNC_LOG_STRING_BYTES];
+		};
+
+		// ============================================
+		// ARGUMENT CAPTURE
+		// ============================================
+
+		inline void CaptureArg(Record& rec, double value)
+		{
+			if (rec.argCount >= ASYNC_LOG_MAX_ARGS) return;
+			rec.types[rec.argCount] = ArgType::Double;
+			rec.args[rec.argCount].d = value;
+			rec.argCount++;
+		}
+
+		inline void CaptureArg(Record& rec, const char* value)
+		{
+			if (rec.argCount >= ASYNC_LOG_MAX_ARGS) return;
+			rec.types[rec.argCount] = ArgType::String;
+
+			if (!value)
+			{
+				rec.args[rec.argCount].stringOffset = ASYNC_LOG_NULL_STRING;
+			}
+			else
+			{
+				// Copy (truncated) into the record - the source may be freed
+				// or changed before the background thread formats it
+				uint16_t offset = rec.stringBytesUsed;
+				size_t available = (offset < ASYNC_LOG_STRING_BYTES) ? (ASYNC_LOG_STRING_BYTES - offset) : 0;
+				if (available == 0)
+				{
+					rec.args[rec.argCount].stringOffset = ASYNC_LOG_NULL_STRING;
+				}
+				else
+				{
+					size_t length = strnlen(value, available - 1);
+					memcpy(rec.strings + offset, value, length);
+					rec.strings[offset + length] = '\0';
+					rec.args[rec.argCount].stringOffset = offset;
+					rec.stringBytesUsed = (uint16_t)(offset + length + 1);
+				}
+			}
+			rec.argCount++;
+		}
+
+		inline void CaptureArg(Record& rec, char* value)
+		{
+			CaptureArg(rec, (const char*)value);
+		}
+
+		template <typename T>
+		inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+			CaptureArg(Record& rec, T value)
+		{
+			if (rec.argCount >= ASYNC_LOG_MAX_ARGS) return;
+
+			if (std::is_enum<T>::value || std::is_signed<T>::value)
+			{
+				rec.types[rec.argCount] = (sizeof(T) <= 4) ? ArgType::Signed32 : ArgType::Signed64;
+				rec.args[rec.argCount].i = (int64_t)value;
+			}
+			else
+			{
+				rec.types[rec.argCount] = ArgType::Unsigned;
+				rec.args[rec.argCount].u = (uint64_t)value;
+			}
+			rec.argCount++;
+		}
+
+		template <typename T>
+		inline void CaptureArg(Record& rec, T* value)
+		{
+			if (rec.argCount >= ASYNC_LOG_MAX_ARGS) return;
+			rec.types[rec.argCount] = ArgType::Pointer;
+			rec.args[rec.argCount].p = (const void*)value;
+			rec.argCount++;
+		}
+
+		// ============================================
+		// RING BUFFER
+		// ============================================
+
+		// Claim a slot in the ring (returns nullptr and counts a drop if full)
+		Record* BeginRecord(uint64_t& outTicket);
+
+		// Publish a claimed slot to the background thread
+		void CommitRecord(uint64_t ticket);
+
+		template <typename... Args>
+		inline void Post(const char* fmt, Args... args)
+		{
+			uint64_t ticket = 0;
+			Record* rec = BeginRecord(ticket);
+			if (!rec) return;
+
+			rec->fmt = fmt;
+			rec->argCount = 0;
+			rec->stringBytesUsed = 0;
+			(CaptureArg(*rec, args), ...);
+
+			CommitRecord(ticket);
+		}
+
+		// Format a captured record into a buffer (used by the background thread)
+		void FormatRecord(const Record& rec, char* out, size_t outSize);
+
+		// ============================================
+		// BACKGROUND THREAD CONTROL
+		// ============================================
+
+		// Start the background writer (call once after gLog is opened)
+		void StartAsyncLogger();
+
+		// Block until everything queued so far has been written (or timeout)
+		void FlushAsyncLogger(int timeoutMs = 500);
+
+		// Total messages dropped because the ring was full
+		uint64_t GetDroppedMessageCount();
+	}
+}
+
+// ============================================
+// LOG MACROS
+// ============================================
+// ASYNC_MESSAGE mirrors _MESSAGE (always written at runtime).
+// ASYNC_LOG_ERR/WARN/INFO mirror LOG_ERR/LOG/LOG_INFO and also
+// respect the runtime "Logging" INI level.
+
+#if ASYNC_LOG_COMPILE_LEVEL >= ASYNC_LOG_LEVEL_VERBOSE
+#define ASYNC_MESSAGE(fmt, ...) ::MountedNPCCombatVR::AsyncLog::Post(fmt, ##__VA_ARGS__)
+#else
+#define ASYNC_MESSAGE(fmt, ...) ((void)0)
+#endif
+
+#if ASYNC_LOG_COMPILE_LEVEL >= ASYNC_LOG_LEVEL_INFO
+#define ASYNC_LOG_INFO(fmt, ...) do { if (::MountedNPCCombatVR::logging >= ASYNC_LOG_LEVEL_INFO) ::MountedNPCCombatVR::AsyncLog::Post(fmt, ##__VA_ARGS__); } while (0)
+#else
+#define ASYNC_LOG_INFO(fmt, ...) ((void)0)
+#endif
+
+#if ASYNC_LOG_COMPILE_LEVEL >= ASYNC_LOG_LEVEL_WARN
+#define ASYNC_LOG_WARN(fmt, ...) do { if (::MountedNPCCombatVR::logging >= ASYNC_LOG_LEVEL_WARN) ::MountedNPCCombatVR::AsyncLog::Post(fmt, ##__VA_ARGS__); } while (0)
+#else
+#define ASYNC_LOG_WARN(fmt, ...) ((void)0)
+#endif
+
+#define ASYNC_LOG_ERR(fmt, ...) ::MountedNPCCombatVR::AsyncLog::Post(fmt, ##__VA_ARGS__)
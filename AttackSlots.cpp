@@ -0,0 +1,392 @@
+#include "AttackSlots.h"
+#include "Helper.h"
+#include "PerfCounters.h"
+#include "SteeringKernel.h"
+#include <cmath>
+
+namespace MountedNPCCombatVR
+{
+	namespace AttackSlots
+	{
+		// ============================================
+		// STORAGE
+		// ============================================
+		// g_rings[r].holder[ring][sector] is an index into g_holders (-1 = free).
+		// Each holder points back at its ring / sector.
+		// ============================================
+
+		struct TargetRings
+		{
+			UInt32 targetFormID;
+			int holder[(int)SlotRing::Count][SLOT_MAX_SECTORS];
+			int holderCount;
+			bool isValid;
+		};
+
+		struct SlotHolder
+		{
+			UInt32 horseFormID;
+			int ringIndex;
+			SlotRing ring;
+			int sector;
+			float radius;
+			float distance;     // Horse to slot (last UpdateSlotRings / reserve)
+			bool clockwise;     // Slot is right of the horse's line to the target
+			bool isValid;
+		};
+
+		static TargetRings g_rings[SLOT_MAX_RINGS];
+		static SlotHolder g_holders[SLOT_MAX_HOLDERS];
+
+		// Sector directions in the target's local frame (x = right, y = forward)
+		static float g_sectorSin[(int)SlotRing::Count][SLOT_MAX_SECTORS];
+		static float g_sectorCos[(int)SlotRing::Count][SLOT_MAX_SECTORS];
+		static bool g_tablesBuilt = false;
+
+		static int GetSectorCount(SlotRing ring)
+		{
+			return (ring == SlotRing::Melee) ? SLOT_MELEE_SECTORS : SLOT_RANGED_SECTORS;
+		}
+
+		static void BuildTables()
+		{
+			if (g_tablesBuilt) return;
+
+			for (int r = 0; r < (int)SlotRing::Count; r++)
+			{
+				int count = GetSectorCount((SlotRing)r);
+				for (int s = 0; s < count; s++)
+				{
+					float angle = 6.28318f * (float)s / (float)count;
+					g_sectorSin[r][s] = sinf(angle);
+					g_sectorCos[r][s] = cosf(angle);
+				}
+			}
+
+			for (int i = 0; i < SLOT_MAX_RINGS; i++)
+			{
+				g_rings[i].isValid = false;
+			}
+			for (int i = 0; i < SLOT_MAX_HOLDERS; i++)
+			{
+				g_holders[i].isValid = false;
+			}
+
+			g_tablesBuilt = true;
+		}
+
+		// ============================================
+		// LOOKUP
+		// ============================================
+
+		static int FindHolder(UInt32 horseFormID)
+		{
+			for (int i = 0; i < SLOT_MAX_HOLDERS; i++)
+			{
+				if (g_holders[i].isValid && g_holders[i].horseFormID == horseFormID) return i;
+			}
+			return -1;
+		}
+
+		static int FindOrCreateRing(UInt32 targetFormID)
+		{
+			int freeIndex = -1;
+
+			for (int i = 0; i < SLOT_MAX_RINGS; i++)
+			{
+				if (g_rings[i].isValid)
+				{
+					if (g_rings[i].targetFormID == targetFormID) return i;
+				}
+				else if (freeIndex < 0)
+				{
+					freeIndex = i;
+				}
+			}
+
+			if (freeIndex < 0) return -1;
+
+			TargetRings& rings = g_rings[freeIndex];
+			rings.targetFormID = targetFormID;
+			rings.holderCount = 0;
+			rings.isValid = true;
+			for (int r = 0; r < (int)SlotRing::Count; r++)
+			{
+				for (int s = 0; s < SLOT_MAX_SECTORS; s++)
+				{
+					rings.holder[r][s] = -1;
+				}
+			}
+			return freeIndex;
+		}
+
+		static void ReleaseHolder(int holderIndex)
+		{
+			SlotHolder& holder = g_holders[holderIndex];
+			if (!holder.isValid) return;
+
+			TargetRings& rings = g_rings[holder.ringIndex];
+			rings.holder[(int)holder.ring][holder.sector] = -1;
+			rings.holderCount--;
+			if (rings.holderCount <= 0)
+			{
+				rings.isValid = false;
+			}
+
+			holder.isValid = false;
+		}
+
+		// Free sector nearest 'preferred', searching outward in both directions
+		static int FindFreeSectorNear(const TargetRings& rings, SlotRing ring, int preferred)
+		{
+			int count = GetSectorCount(ring);
+
+			for (int step = 0; step <= count / 2; step++)
+			{
+				int right = (preferred + step) % count;
+				if (rings.holder[(int)ring][right] < 0) return right;
+
+				int left = (preferred - step + count) % count;
+				if (rings.holder[(int)ring][left] < 0) return left;
+			}
+			return -1;
+		}
+
+		// Slot position / side for one holder. sinH/cosH = target heading.
+		static void ComputeApproach(SlotHolder& holder, float horseX, float horseY,
+			float targetX, float targetY, float sinH, float cosH)
+		{
+			float localSin = g_sectorSin[(int)holder.ring][holder.sector];
+			float localCos = g_sectorCos[(int)holder.ring][holder.sector];
+
+			// Rotate local sector direction by the target heading
+			float dirX = sinH * localCos + cosH * localSin;
+			float dirY = cosH * localCos - sinH * localSin;
+
+			float slotX = targetX + dirX * holder.radius;
+			float slotY = targetY + dirY * holder.radius;
+
+			float toSlotX = slotX - horseX;
+			float toSlotY = slotY - horseY;
+			float toTargetX = targetX - horseX;
+			float toTargetY = targetY - horseY;
+
+			holder.distance = sqrtf(toSlotX * toSlotX + toSlotY * toSlotY);
+
+			// Right of the forward vector (fx, fy) is (fy, -fx)
+			holder.clockwise = (toSlotX * toTargetY - toSlotY * toTargetX) > 0.0f;
+		}
+
+		// ============================================
+		// RESERVE / RELEASE
+		// ============================================
+
+		bool ReserveSlot(Actor* horse, Actor* target, SlotRing ring, float radius)
+		{
+			if (!horse || !target) return false;
+			BuildTables();
+
+			int holderIndex = FindHolder(horse->formID);
+			if (holderIndex >= 0)
+			{
+				SlotHolder& existing = g_holders[holderIndex];
+				if (g_rings[existing.ringIndex].targetFormID == target->formID && existing.ring == ring)
+				{
+					existing.radius = radius;
+					return true;  // Keep the slot we already have
+				}
+
+				ReleaseHolder(holderIndex);
+			}
+			else
+			{
+				for (int i = 0; i < SLOT_MAX_HOLDERS; i++)
+				{
+					if (!g_holders[i].isValid)
+					{
+						holderIndex = i;
+						break;
+					}
+				}
+				if (holderIndex < 0) return false;
+			}
+
+			int ringIndex = FindOrCreateRing(target->formID);
+			if (ringIndex < 0) return false;
+
+			TargetRings& rings = g_rings[ringIndex];
+
+			// Sector nearest the horse's current bearing in the target's local frame
+			int count = GetSectorCount(ring);
+			float bearing = atan2f(horse->pos.x - target->pos.x, horse->pos.y - target->pos.y) - Steering::GetHeading(target);
+			float sectorWidth = 6.28318f / (float)count;
+			int preferred = (int)floorf(bearing / sectorWidth + 0.5f) % count;
+			if (preferred < 0) preferred += count;
+
+			int sector = FindFreeSectorNear(rings, ring, preferred);
+			if (sector < 0)
+			{
+				if (rings.holderCount == 0) rings.isValid = false;
+				return false;  // Ring full - caller keeps its default positioning
+			}
+
+			SlotHolder& holder = g_holders[holderIndex];
+			holder.horseFormID = horse->formID;
+			holder.ringIndex = ringIndex;
+			holder.ring = ring;
+			holder.sector = sector;
+			holder.radius = radius;
+			holder.isValid = true;
+
+			rings.holder[(int)ring][sector] = holderIndex;
+			rings.holderCount++;
+
+			float targetHeading = Steering::GetHeading(target);
+			ComputeApproach(holder, horse->pos.x, horse->pos.y, target->pos.x, target->pos.y,
+				sinf(targetHeading), cosf(targetHeading));
+			return true;
+		}
+
+		void ReleaseSlot(UInt32 horseFormID)
+		{
+			if (!g_tablesBuilt) return;
+
+			int holderIndex = FindHolder(horseFormID);
+			if (holderIndex >= 0)
+			{
+				ReleaseHolder(holderIndex);
+			}
+		}
+
+		bool AdvanceSlot(UInt32 horseFormID, bool clockwise)
+		{
+			if (!g_tablesBuilt) return false;
+
+			int holderIndex = FindHolder(horseFormID);
+			if (holderIndex < 0) return false;
+
+			SlotHolder& holder = g_holders[holderIndex];
+			TargetRings& rings = g_rings[holder.ringIndex];
+			int count = GetSectorCount(holder.ring);
+			int step = clockwise ? 1 : count - 1;
+
+			for (int i = 1; i < count; i++)
+			{
+				int next = (holder.sector + step * i) % count;
+				if (rings.holder[(int)holder.ring][next] < 0)
+				{
+					rings.holder[(int)holder.ring][holder.sector] = -1;
+					rings.holder[(int)holder.ring][next] = holderIndex;
+					holder.sector = next;
+					return true;
+				}
+			}
+			return false;  // Every other sector is taken
+		}
+
+		// ============================================
+		// QUERIES
+		// ============================================
+
+		bool GetSlotLocalOffset(UInt32 horseFormID, float& outX, float& outY)
+		{
+			if (!g_tablesBuilt) return false;
+
+			int holderIndex = FindHolder(horseFormID);
+			if (holderIndex < 0) return false;
+
+			const SlotHolder& holder = g_holders[holderIndex];
+			outX = g_sectorSin[(int)holder.ring][holder.sector] * holder.radius;
+			outY = g_sectorCos[(int)holder.ring][holder.sector] * holder.radius;
+			return true;
+		}
+
+		bool GetSlotSideClockwise(UInt32 horseFormID, bool& outClockwise)
+		{
+			if (!g_tablesBuilt) return false;
+
+			int holderIndex = FindHolder(horseFormID);
+			if (holderIndex < 0) return false;
+
+			outClockwise = g_holders[holderIndex].clockwise;
+			return true;
+		}
+
+		bool GetSlotDistance(UInt32 horseFormID, float& outDistance)
+		{
+			if (!g_tablesBuilt) return false;
+
+			int holderIndex = FindHolder(horseFormID);
+			if (holderIndex < 0) return false;
+
+			outDistance = g_holders[holderIndex].distance;
+			return true;
+		}
+
+		// ============================================
+		// PER-TICK UPDATE (one pass per target)
+		// ============================================
+
+		void UpdateSlotRings()
+		{
+			if (!g_tablesBuilt) return;
+
+			for (int r = 0; r < SLOT_MAX_RINGS; r++)
+			{
+				TargetRings& rings = g_rings[r];
+				if (!rings.isValid) continue;
+
+				TESForm* targetForm = CountedLookupFormByID(rings.targetFormID);
+				Actor* target = (targetForm && targetForm->formType == kFormType_Character) ?
+					static_cast<Actor*>(targetForm) : nullptr;
+				bool targetGone = !target || target->IsDead(1);
+
+				float heading = target ? Steering::GetHeading(target) : 0.0f;
+				float sinH = sinf(heading);
+				float cosH = cosf(heading);
+
+				for (int ring = 0; ring < (int)SlotRing::Count && rings.isValid; ring++)
+				{
+					int count = GetSectorCount((SlotRing)ring);
+
+					for (int s = 0; s < count && rings.isValid; s++)
+					{
+						int holderIndex = rings.holder[ring][s];
+						if (holderIndex < 0) continue;
+
+						if (targetGone)
+						{
+							ReleaseHolder(holderIndex);
+							continue;
+						}
+
+						SlotHolder& holder = g_holders[holderIndex];
+						TESForm* horseForm = CountedLookupFormByID(holder.horseFormID);
+						if (!horseForm || horseForm->formType != kFormType_Character)
+						{
+							ReleaseHolder(holderIndex);
+							continue;
+						}
+
+						Actor* horse = static_cast<Actor*>(horseForm);
+						float dx = target->pos.x - horse->pos.x;
+						float dy = target->pos.y - horse->pos.y;
+						if (horse->IsDead(1) || (dx * dx + dy * dy) > SLOT_RELEASE_DISTANCE * SLOT_RELEASE_DISTANCE)
+						{
+							ReleaseHolder(holderIndex);
+							continue;
+						}
+
+						ComputeApproach(holder, horse->pos.x, horse->pos.y, target->pos.x, target->pos.y, sinH, cosH);
+					}
+				}
+			}
+		}
+
+		void ResetSlotRings()
+		{
+			g_tablesBuilt = false;
+			BuildTables();
+		}
+	}
+}
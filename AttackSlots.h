@@ -0,0 +1,80 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// ATTACK SLOT RINGS (circling / flanking positions)
+	// ============================================
+	// Every melee horse used to follow its target at the same local offset
+	// (200 right, 300 behind), and picked its 90-degree turn and intercept
+	// side with its own coin flip. Several riders on one target converged
+	// on the same spot and blocked each other (CollisionBlocked).
+	//
+	// Each target gets two rings of angular sectors, laid out in the target's
+	// local frame (0 = in front, PI/2 = right):
+	// - Melee ring: SLOT_MELEE_SECTORS sectors at the melee follow offset.
+	// - Ranged ring: SLOT_RANGED_SECTORS sectors for ranged role riders and
+	//   mages (the radius comes from the caller, e.g. DynamicRangedRoleIdealDistance).
+	//
+	// A horse reserves the free sector nearest its current bearing and keeps
+	// it while it fights the same target. Each holder records its ring and
+	// sector, so release and AdvanceSlot are O(1) (plus a scan over at most
+	// SLOT_MAX_SECTORS for the next free sector).
+	//
+	// UpdateSlotRings (once per tick) computes every slot's world position
+	// and every holder's approach vector in one pass per target: one sin/cos
+	// of the target heading, then a rotation of the precomputed sector table.
+	// The turn / intercept code reads the side from there instead of
+	// recomputing angles per horse.
+	//
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace AttackSlots
+	{
+		enum class SlotRing : int
+		{
+			Melee = 0,
+			Ranged,
+			Count
+		};
+
+		const int SLOT_MELEE_SECTORS = 8;
+		const int SLOT_RANGED_SECTORS = 12;
+		const int SLOT_MAX_SECTORS = 12;
+		const int SLOT_MAX_RINGS = 16;              // Targets with reserved slots
+		const int SLOT_MAX_HOLDERS = 32;            // Horses holding a slot
+		const float SLOT_MELEE_RADIUS = 360.0f;     // Same distance as the old (200, -300) offset
+		const float SLOT_ARRIVE_DISTANCE = 150.0f;  // Horse counts as "at its slot" inside this
+		const float SLOT_RELEASE_DISTANCE = 4100.0f;  // Holders further than this from the target are released
+
+		// Reserve (or keep) a slot for this horse on this target.
+		// radius = distance from the target for this holder.
+		bool ReserveSlot(Actor* horse, Actor* target, SlotRing ring, float radius);
+
+		// Free the horse's slot (target changed, horse cleared)
+		void ReleaseSlot(UInt32 horseFormID);
+
+		// Move the horse to the next free sector around its ring (circling)
+		bool AdvanceSlot(UInt32 horseFormID, bool clockwise);
+
+		// Slot offset in the target's local frame (for KeepOffsetFromActor)
+		bool GetSlotLocalOffset(UInt32 horseFormID, float& outX, float& outY);
+
+		// From the last UpdateSlotRings: is the slot to the right of the
+		// horse's line to the target (turn clockwise to reach it)?
+		bool GetSlotSideClockwise(UInt32 horseFormID, bool& outClockwise);
+
+		// From the last UpdateSlotRings: distance from the horse to its slot
+		bool GetSlotDistance(UInt32 horseFormID, float& outDistance);
+
+		// Recompute slot positions / approach vectors; drop stale holders
+		void UpdateSlotRings();
+
+		// Forget everything (mod deactivate)
+		void ResetSlotRings();
+	}
+}
@@ -0,0 +1,156 @@
+#include "CellScanCursor.h"
+#include "PerfCounters.h"
+
+namespace MountedNPCCombatVR
+{
+	CellScanCursor::CellScanCursor(UInt32 sliceSize) :
+		m_cell(nullptr), m_anchor(nullptr), m_listData(nullptr), m_listCount(0), m_index(0),
+		m_sliceSize(sliceSize > 0 ? sliceSize : 1), m_sliceRemaining(0),
+		m_passCount(0), m_mutationCount(0), m_passCompleted(false)
+	{
+	}
+
+	// True if the last ref handed out is still just before 'index'
+	bool CellScanCursor::AnchorStillAt(TESObjectCELL* cell, UInt32 index) const
+	{
+		if (index == 0) return true;
+
+		TESObjectREFR* ref = nullptr;
+		cell->objectList.GetNthItem(index - 1, ref);
+		return ref == m_anchor;
+	}
+
+	// After a mutation, find where the last ref handed out moved to and
+	// resume right after it. Removals/inserts before it shift it down/up.
+	// If it was removed itself, back up by the number of refs removed so
+	// nothing shifted past the cursor is skipped.
+	UInt32 CellScanCursor::FindResumeIndex(TESObjectCELL* cell, UInt32 count) const
+	{
+		if (m_index == 0) return 0;
+
+		if (m_anchor)
+		{
+			// Search outward from the old position (most mutations are small)
+			UInt32 oldPos = m_index - 1;
+			UInt32 maxOffset = (count > oldPos) ? count : oldPos + 1;
+
+			for (UInt32 offset = 0; offset < maxOffset; offset++)
+			{
+				TESObjectREFR* ref = nullptr;
+
+				if (oldPos >= offset && oldPos - offset < count)
+				{
+					cell->objectList.GetNthItem(oldPos - offset, ref);
+					if (ref == m_anchor) return oldPos - offset + 1;
+				}
+
+				if (offset > 0 && oldPos + offset < count)
+				{
+					cell->objectList.GetNthItem(oldPos + offset, ref);
+					if (ref == m_anchor) return oldPos + offset + 1;
+				}
+			}
+		}
+
+		UInt32 resume = m_index;
+		if (count < m_listCount)
+		{
+			UInt32 removed = m_listCount - count;
+			resume = (resume > removed) ? resume - removed : 0;
+		}
+		return (resume > count) ? count : resume;
+	}
+
+	bool CellScanCursor::BeginSlice(TESObjectCELL* cell)
+	{
+		m_sliceRemaining = 0;
+
+		if (!cell)
+		{
+			Reset();
+			return false;
+		}
+
+		// Previous slice finished the pass - start a new one
+		if (m_passCompleted)
+		{
+			m_index = 0;
+			m_passCompleted = false;
+		}
+
+		UInt32 count = cell->objectList.count;
+		const void* data = cell->objectList.entries;
+
+		if (cell != m_cell)
+		{
+			// Different cell - nothing from the old position applies
+			m_cell = cell;
+			m_index = 0;
+		}
+		else if (count != m_listCount || data != m_listData || !AnchorStillAt(cell, m_index))
+		{
+			m_mutationCount++;
+			m_index = FindResumeIndex(cell, count);
+		}
+
+		m_listData = data;
+		m_listCount = count;
+		m_sliceRemaining = m_sliceSize;
+		PERF_COUNT(CellScans);
+
+		if (m_index >= count)
+		{
+			// Empty list (or nothing left) - this slice completes the pass
+			m_passCompleted = true;
+			m_passCount++;
+		}
+
+		return true;
+	}
+
+	bool CellScanCursor::Next(TESObjectREFR*& outRef)
+	{
+		outRef = nullptr;
+
+		while (m_sliceRemaining > 0 && !m_passCompleted)
+		{
+			if (m_index >= m_listCount)
+			{
+				m_passCompleted = true;
+				m_passCount++;
+				return false;
+			}
+
+			TESObjectREFR* ref = nullptr;
+			m_cell->objectList.GetNthItem(m_index, ref);
+			m_anchor = ref;
+			m_index++;
+			m_sliceRemaining--;
+
+			if (m_index >= m_listCount)
+			{
+				m_passCompleted = true;
+				m_passCount++;
+			}
+
+			if (ref)
+			{
+				outRef = ref;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CellScanCursor::Reset()
+	{
+		m_cell = nullptr;
+		m_anchor = nullptr;
+		m_listData = nullptr;
+		m_listCount = 0;
+		m_index = 0;
+		m_sliceRemaining = 0;
+		m_passCompleted = false;
+	}
+}
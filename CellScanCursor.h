@@ -0,0 +1,83 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+// ============================================
+// TIME-SLICED CELL SCANNING
+// ============================================
+// Periodic scanners used to walk cell->objectList from index 0 every
+// time they ran. A scanner that stops early (candidate cap, "one per
+// scan") therefore never reached the refs at the end of the list, and
+// kept re-examining the refs at the front.
+//
+// A CellScanCursor keeps its place between frames. Each frame hands
+// out at most 'sliceSize' refs, continuing where the last slice ended.
+// A pass over a list of N refs takes ceil(N / sliceSize) slices. Refs
+// the caller skips by stopping early are the first ones handed out by
+// the next slice.
+//
+// List mutation (cell pointer, list pointer, count, or the last ref
+// handed out no longer sitting just before the cursor) is handled by:
+// - Different cell: the pass restarts at 0.
+// - Same cell: the cursor finds where the last ref handed out moved to
+//   and resumes right after it, so refs inserted/removed before it do
+//   not cause skips. If that ref was removed, the cursor backs up by the
+//   number of refs removed (a few may be seen twice).
+//
+// Usage:
+//     static CellScanCursor s_cursor(CELL_SCAN_SLICE_SIZE);
+//     if (!s_cursor.IsMidPass() && interval not elapsed) return;
+//     s_cursor.BeginSlice(cell);
+//     TESObjectREFR* ref = nullptr;
+//     while (s_cursor.Next(ref)) { ... }
+//     if (s_cursor.PassCompleted()) { ... end-of-pass work ... }
+//
+// GAME THREAD ONLY.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	// Default slice for the periodic scanners (refs per frame)
+	const UInt32 CELL_SCAN_SLICE_SIZE = 64;
+
+	class CellScanCursor
+	{
+	public:
+		explicit CellScanCursor(UInt32 sliceSize);
+
+		// Start this frame's slice. Returns false if there is no cell.
+		bool BeginSlice(TESObjectCELL* cell);
+
+		// Next ref in this frame's slice (null refs are skipped).
+		// Returns false when the slice is used up or the pass ends.
+		bool Next(TESObjectREFR*& outRef);
+
+		// True if the current slice reached the end of the list
+		bool PassCompleted() const { return m_passCompleted; }
+
+		// True if a pass is in progress (the next slice continues it)
+		bool IsMidPass() const { return m_index > 0 && !m_passCompleted; }
+
+		// Forget the position (cell change, mod deactivate)
+		void Reset();
+
+		UInt32 GetPassCount() const { return m_passCount; }
+		UInt32 GetMutationCount() const { return m_mutationCount; }
+
+	private:
+		bool AnchorStillAt(TESObjectCELL* cell, UInt32 index) const;
+		UInt32 FindResumeIndex(TESObjectCELL* cell, UInt32 count) const;
+
+		TESObjectCELL* m_cell;
+		TESObjectREFR* m_anchor;   // Last ref handed out (compared, never dereferenced)
+		const void* m_listData;    // objectList.entries when the position was taken
+		UInt32 m_listCount;        // objectList.count when the position was taken
+		UInt32 m_index;            // Next index to hand out
+		UInt32 m_sliceSize;
+		UInt32 m_sliceRemaining;
+		UInt32 m_passCount;
+		UInt32 m_mutationCount;
+		bool m_passCompleted;
+	};
+}
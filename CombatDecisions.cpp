@@ -0,0 +1,180 @@
+#include "CombatDecisions.h"
+#include <cmath>
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// AGGRESSIVE STATE
+	// ============================================
+
+	MountedCombatState DecideAggressiveState(float distance, float weaponReach, bool isBow, bool pathClear)
+	{
+		float attackRange = weaponReach > 0 ? weaponReach : DEFAULT_ATTACK_RANGE;
+
+		// Adjust ranges based on weapon type
+		if (isBow)
+		{
+			// Ranged weapon - can attack from far, prefer medium distance
+			if (distance <= 512.0f)
+			{
+				return MountedCombatState::Circling;  // Too close for bow, circle
+			}
+			else if (distance <= 2048.0f)
+			{
+				return MountedCombatState::Attacking;  // Good bow range
+			}
+			else
+			{
+				return MountedCombatState::Engaging;  // Close distance
+			}
+		}
+
+		// Melee weapon
+		if (distance <= attackRange + 64.0f)  // Add some buffer
+		{
+			return MountedCombatState::Attacking;
+		}
+		else if (distance <= 512.0f)
+		{
+			return MountedCombatState::Charging;  // Close enough to charge
+		}
+		else if (distance <= 1024.0f)
+		{
+			return pathClear ? MountedCombatState::Charging : MountedCombatState::Engaging;
+		}
+
+		return MountedCombatState::Engaging;
+	}
+
+	// ============================================
+	// COMBAT STYLE STATE
+	// ============================================
+
+	MountedCombatState DecideStyleState(float distance, bool hasBow)
+	{
+		if (hasBow && distance > RANGED_MIN_RANGE && distance <= RANGED_MAX_RANGE)
+		{
+			return MountedCombatState::RangedAttack;
+		}
+
+		if (distance <= MELEE_ATTACK_RANGE) return MountedCombatState::Attacking;
+		if (distance <= MELEE_CHARGE_RANGE) return MountedCombatState::Charging;
+		return MountedCombatState::Engaging;
+	}
+
+	// ============================================
+	// RIDER DECISION STAGE
+	// ============================================
+
+	void DecideRiderStates(const RiderSnapshot* snapshots, int count, RiderDecision* outDecisions)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			const RiderSnapshot& in = snapshots[i];
+			RiderDecision& out = outDecisions[i];
+
+			out.state = MountedCombatState::None;
+			out.distanceToTarget = 0.0f;
+
+			if (!in.hasTarget)
+			{
+				continue;
+			}
+
+			float dx = in.targetX - in.riderX;
+			float dy = in.targetY - in.riderY;
+			float dz = in.targetZ - in.riderZ;
+			out.distanceToTarget = sqrtf(dx * dx + dy * dy + dz * dz);
+
+			if (in.usesStyleRules)
+			{
+				out.state = DecideStyleState(out.distanceToTarget, in.hasBow);
+			}
+		}
+	}
+
+	bool ApplyDecidedState(MountedCombatState decidedState, MountedCombatState& state, float& stateStartTime, float currentTime)
+	{
+		if (decidedState == MountedCombatState::None || decidedState == state)
+		{
+			return false;
+		}
+
+		state = decidedState;
+		stateStartTime = currentTime;
+		return true;
+	}
+
+	// ============================================
+	// RANGED FOLLOW MODE
+	// ============================================
+
+	RangedFollowSwitch DecideRangedFollowSwitch(bool isInRangedMode, float distanceToTarget, float timeSinceLastSwitch)
+	{
+		// Check cooldown - prevent spam switching
+		if (timeSinceLastSwitch < RANGED_SWITCH_COOLDOWN)
+		{
+			return RangedFollowSwitch::None;
+		}
+
+		if (isInRangedMode)
+		{
+			// Target is too close - switch to melee follow
+			return (distanceToTarget < RANGED_TO_MELEE_DISTANCE) ? RangedFollowSwitch::ToMelee : RangedFollowSwitch::None;
+		}
+
+		// Target is far enough - switch back to ranged follow
+		return (distanceToTarget > MELEE_TO_RANGED_DISTANCE) ? RangedFollowSwitch::ToRanged : RangedFollowSwitch::None;
+	}
+
+	// ============================================
+	// WEAPON FOR DISTANCE
+	// ============================================
+
+	WeaponRequest DecideWeaponForDistance(float distanceToTarget, float switchDistance, bool targetIsMounted,
+		bool hasBow, bool bowEquipped, bool& outForce)
+	{
+		outForce = false;
+
+		if (distanceToTarget <= switchDistance)
+		{
+			// Within melee range - being stuck with a bow here is deadly,
+			// so that switch bypasses the cooldown
+			outForce = bowEquipped;
+
+			// Mounted vs mounted prefers the glaive
+			return targetIsMounted ? WeaponRequest::Glaive : WeaponRequest::Melee;
+		}
+
+		if (hasBow)
+		{
+			// Beyond switch distance and has bow - use bow
+			return WeaponRequest::Bow;
+		}
+
+		// Beyond switch distance but no bow - use melee anyway
+		return targetIsMounted ? WeaponRequest::Glaive : WeaponRequest::Melee;
+	}
+
+	// ============================================
+	// FLEE DIRECTION
+	// ============================================
+
+	void DecideFleeDirection(float actorX, float actorY, float threatX, float threatY, float& outX, float& outY)
+	{
+		float dx = actorX - threatX;
+		float dy = actorY - threatY;
+		float length = sqrtf(dx * dx + dy * dy);
+
+		if (length > 0)
+		{
+			outX = dx / length;
+			outY = dy / length;
+		}
+		else
+		{
+			outX = 0;
+			outY = 0;
+		}
+	}
+}
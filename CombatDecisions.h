@@ -0,0 +1,157 @@
+#pragma once
+
+// ============================================
+// ENGINE-INDEPENDENT COMBAT DECISIONS
+// ============================================
+// Pure decision functions used by MountedCombat, DynamicPackages and
+// WeaponDetection. They take plain numbers in and return a decision,
+// with no Actor lookups, package calls or logging. This keeps the
+// decision logic in one place and lets it be compiled and driven
+// outside the game (headless simulation / benchmarks, see
+// tests/CombatSimBench.cpp).
+//
+// RULE: nothing in this header may include SKSE or game headers.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// Combat State
+	// ============================================
+
+	enum class MountedCombatState
+	{
+		None,
+		Engaging,
+		Attacking,
+		Circling,
+		Charging,
+		RangedAttack,
+		Fleeing,
+		Retreating
+	};
+
+	// ============================================
+	// Weapon Requests
+	// ============================================
+
+	enum class WeaponRequest
+	{
+		None,
+		Melee,
+		Bow,
+		Glaive,  // Preferred weapon for mounted vs mounted combat
+		Staff    // Warstaff for MageCaster class riders ONLY
+	};
+
+	// ============================================
+	// AGGRESSIVE STATE
+	// ============================================
+
+	// Default reach used when the weapon reports none
+	const float DEFAULT_ATTACK_RANGE = 256.0f;
+
+	// Pick the aggressive combat state from distance and weapon
+	MountedCombatState DecideAggressiveState(float distance, float weaponReach, bool isBow, bool pathClear);
+
+	// ============================================
+	// COMBAT STYLE STATE
+	// ============================================
+
+	const float MELEE_ATTACK_RANGE = 200.0f;
+	const float MELEE_CHARGE_RANGE = 512.0f;
+	const float RANGED_MIN_RANGE = 333.0f;
+	const float RANGED_MAX_RANGE = 2000.0f;
+
+	// State for the guard/soldier/bandit/mage styles (they share one rule set)
+	// hasBow: bow equipped or in inventory
+	MountedCombatState DecideStyleState(float distance, bool hasBow);
+
+	// ============================================
+	// RIDER DECISION STAGE
+	// ============================================
+	// The rider loop in UpdateMountedCombat runs in three phases:
+	// 1. Gather (game thread): validity checks, target lookup, weapon
+	//    info, then one RiderSnapshot per rider that reaches its combat
+	//    style.
+	// 2. Decide: DecideRiderStates over the whole batch. Snapshots are
+	//    plain data, and each decision reads only its own snapshot.
+	// 3. Apply (game thread): the combat styles, which apply the decided
+	//    state and then run everything else.
+	//
+	// The batch decides ONE thing: the distance to the target and the
+	// style state from DecideStyleState. The other decisions stay in the
+	// apply phase, with the systems that own their state:
+	// - ranged follow switching (DecideRangedFollowSwitch) and weapon for
+	//   distance (DecideWeaponForDistance) need per-rider cooldowns and
+	//   equip state (DynamicPackages, WeaponDetection, CombatStyles)
+	// - tactical flee and steering read and write engine state every call
+	//   (FleeingBehavior, SteeringKernel)
+	// - DecideAggressiveState has no caller on the rider loop
+	// They are pure where they can be (the functions below), but they are
+	// not part of the batch.
+	//
+	// The decide phase runs inline on the game thread. There is no worker
+	// pool. MaxTrackedMountedNPCs caps the batch at 10 riders, which
+	// decide in about 20 ns, while handing a batch to a worker and
+	// waiting for it costs microseconds. Gather, decide and apply run in
+	// the same tick, so the snapshot array is not double-buffered. A
+	// second buffer only helps when decisions are applied a frame late.
+	// ============================================
+
+	struct RiderSnapshot
+	{
+		float riderX, riderY, riderZ;
+		float targetX, targetY, targetZ;
+		bool hasTarget;
+		bool hasBow;            // Bow equipped or in inventory
+		bool usesStyleRules;    // False for classes with no combat style (None, CivilianFlee)
+	};
+
+	struct RiderDecision
+	{
+		MountedCombatState state;   // None = keep the current state
+		float distanceToTarget;     // 3D (0 without a target)
+	};
+
+	void DecideRiderStates(const RiderSnapshot* snapshots, int count, RiderDecision* outDecisions);
+
+	// State change the combat styles make for a decided state
+	// (None keeps the current state). Returns true if the state changed.
+	bool ApplyDecidedState(MountedCombatState decidedState, MountedCombatState& state, float& stateStartTime, float currentTime);
+
+	// ============================================
+	// RANGED FOLLOW MODE (hysteresis)
+	// ============================================
+
+	const float RANGED_TO_MELEE_DISTANCE = 340.0f;    // Switch to melee follow when closer than this
+	const float MELEE_TO_RANGED_DISTANCE = 500.0f;    // Switch back to ranged when further than this
+	const float RANGED_SWITCH_COOLDOWN = 2.0f;        // Minimum time between switches to prevent spam
+
+	enum class RangedFollowSwitch
+	{
+		None,
+		ToMelee,
+		ToRanged
+	};
+
+	RangedFollowSwitch DecideRangedFollowSwitch(bool isInRangedMode, float distanceToTarget, float timeSinceLastSwitch);
+
+	// ============================================
+	// WEAPON FOR DISTANCE
+	// ============================================
+
+	// Choose the weapon a (non-mage) rider should hold at this distance
+	// outForce is set when the switch must bypass the cooldown
+	// (bow equipped while already inside melee range)
+	WeaponRequest DecideWeaponForDistance(float distanceToTarget, float switchDistance, bool targetIsMounted,
+		bool hasBow, bool bowEquipped, bool& outForce);
+
+	// ============================================
+	// FLEE DIRECTION
+	// ============================================
+
+	// Unit vector on the ground plane pointing away from the threat
+	// (0,0 if both positions coincide)
+	void DecideFleeDirection(float actorX, float actorY, float threatX, float threatY, float& outX, float& outY);
+}
@@ -0,0 +1,385 @@
+#include "CombatRecorder.h"
+#include "Helper.h"
+#include "config.h"
+#include <shlobj.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace MountedNPCCombatVR
+{
+	namespace CombatRecorder
+	{
+		// ============================================
+		// DOUBLE BUFFER
+		// ============================================
+		// The game thread fills one buffer while the writer thread drains
+		// the other. A buffer is only touched by the game thread while
+		// Free/Filling and only by the writer while Full.
+		// ============================================
+
+		enum BufferState : int
+		{
+			BUFFER_FREE = 0,
+			BUFFER_FULL = 1
+		};
+
+		struct FrameBuffer
+		{
+			std::atomic<int> state;
+			uint32_t used;
+			uint8_t data[RECORDER_BUFFER_BYTES];
+		};
+
+		const uint32_t MAX_FRAME_BYTES = sizeof(RecorderFrameHeader) + RECORDER_MAX_RIDERS_PER_FRAME * sizeof(RecorderRiderRecord);
+		static_assert(MAX_FRAME_BYTES <= RECORDER_BUFFER_BYTES, "Recorder buffer must hold at least one frame");
+
+		static FrameBuffer g_buffers[2];
+		static int g_activeBuffer = 0;     // Game thread
+		static int g_writeBuffer = 0;      // Writer thread
+
+		// Open frame (game thread)
+		static bool g_frameOpen = false;
+		static uint32_t g_frameOffset = 0;
+		static uint32_t g_frameRiderCount = 0;
+		static uint32_t g_frameIndex = 0;
+		static uint32_t g_droppedSinceLastFrame = 0;
+		static float g_frameTime = 0.0f;
+		static float g_lastHandOffTime = 0.0f;
+
+		// Decision inputs noted this frame, keyed by mount (game thread)
+		struct NotedInputs
+		{
+			uint32_t mountFormID;
+			uint8_t pathCheck;
+			uint8_t obstruction;
+			uint8_t inputFlags;
+		};
+
+		static NotedInputs g_notedInputs[RECORDER_MAX_RIDERS_PER_FRAME];
+		static uint32_t g_notedInputCount = 0;
+
+		static std::atomic<uint64_t> g_droppedFrames(0);
+		static std::atomic<bool> g_writerStarted(false);
+		static std::atomic<bool> g_closeRequested(false);
+		static std::atomic<bool> g_fileFailed(false);
+
+		// ============================================
+		// WRITER THREAD
+		// ============================================
+
+		static FILE* OpenCaptureFile()
+		{
+			char documentsPath[MAX_PATH];
+			if (FAILED(SHGetFolderPathA(NULL, CSIDL_MYDOCUMENTS, NULL, SHGFP_TYPE_CURRENT, documentsPath)))
+			{
+				return nullptr;
+			}
+
+			time_t now = time(nullptr);
+			struct tm localTime;
+			localtime_s(&localTime, &now);
+			char stamp[32];
+			strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &localTime);
+
+			std::string filepath = std::string(documentsPath) + "\\My Games\\Skyrim VR\\SKSE\\Mounted_NPC_Combat_VR_capture_" + stamp + ".bin";
+
+			FILE* file = fopen(filepath.c_str(), "wb");
+			if (!file)
+			{
+				_MESSAGE("CombatRecorder: Failed to open %s - recording disabled", filepath.c_str());
+				return nullptr;
+			}
+
+			RecorderFileHeader header;
+			header.magic = RECORDER_MAGIC;
+			header.version = RECORDER_VERSION;
+			header.frameHeaderSize = sizeof(RecorderFrameHeader);
+			header.riderRecordSize = sizeof(RecorderRiderRecord);
+			fwrite(&header, sizeof(header), 1, file);
+
+			_MESSAGE("CombatRecorder: Capturing to %s", filepath.c_str());
+			return file;
+		}
+
+		static void WriterThread()
+		{
+			FILE* file = nullptr;
+
+			for (;;)
+			{
+				FrameBuffer& buffer = g_buffers[g_writeBuffer];
+
+				if (buffer.state.load(std::memory_order_acquire) == BUFFER_FULL)
+				{
+					if (!file && !g_fileFailed.load(std::memory_order_relaxed))
+					{
+						file = OpenCaptureFile();
+						if (!file) g_fileFailed.store(true, std::memory_order_relaxed);
+					}
+
+					if (file && buffer.used > 0)
+					{
+						fwrite(buffer.data, 1, buffer.used, file);
+						fflush(file);
+					}
+
+					buffer.used = 0;
+					buffer.state.store(BUFFER_FREE, std::memory_order_release);
+					g_writeBuffer ^= 1;
+					continue;
+				}
+
+				if (g_closeRequested.load(std::memory_order_acquire))
+				{
+					if (file)
+					{
+						fclose(file);
+						file = nullptr;
+					}
+					g_fileFailed.store(false, std::memory_order_relaxed);
+					g_closeRequested.store(false, std::memory_order_release);
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			}
+		}
+
+		static void StartWriter()
+		{
+			bool expected = false;
+			if (!g_writerStarted.compare_exchange_strong(expected, true)) return;
+
+			for (int i = 0; i < 2; i++)
+			{
+				g_buffers[i].used = 0;
+				g_buffers[i].state.store(BUFFER_FREE, std::memory_order_relaxed);
+			}
+
+			std::thread(WriterThread).detach();
+			_MESSAGE("CombatRecorder: Writer thread started (2 x %u KB buffers)", RECORDER_BUFFER_BYTES / 1024);
+		}
+
+		// Queue the active buffer for writing and switch to the other one
+		// Returns false if the other buffer is still being written
+		static bool HandOffActiveBuffer()
+		{
+			FrameBuffer& other = g_buffers[g_activeBuffer ^ 1];
+			if (other.state.load(std::memory_order_acquire) != BUFFER_FREE)
+			{
+				return false;
+			}
+
+			g_buffers[g_activeBuffer].state.store(BUFFER_FULL, std::memory_order_release);
+			g_activeBuffer ^= 1;
+			g_lastHandOffTime = g_frameTime;
+			return true;
+		}
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		void BeginFrame(float gameTime)
+		{
+			g_frameOpen = false;
+			g_frameIndex++;
+			g_notedInputCount = 0;
+
+			if (!RecorderEnabled || g_fileFailed.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			StartWriter();
+
+			FrameBuffer* buffer = &g_buffers[g_activeBuffer];
+			if (buffer->used + MAX_FRAME_BYTES > RECORDER_BUFFER_BYTES)
+			{
+				if (!HandOffActiveBuffer())
+				{
+					// Writer behind - drop this frame instead of blocking
+					g_droppedSinceLastFrame++;
+					g_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				buffer = &g_buffers[g_activeBuffer];
+			}
+
+			g_frameTime = gameTime;
+			g_frameOffset = buffer->used;
+			g_frameRiderCount = 0;
+
+			RecorderFrameHeader* header = (RecorderFrameHeader*)(buffer->data + g_frameOffset);
+			header->frameIndex = g_frameIndex;
+			header->gameTime = gameTime;
+			header->riderCount = 0;
+			header->droppedFramesBefore = g_droppedSinceLastFrame;
+
+			g_frameOpen = true;
+		}
+
+		bool IsRecording()
+		{
+			return g_frameOpen;
+		}
+
+		void RecordRider(const RecorderRiderRecord& record)
+		{
+			if (!g_frameOpen || g_frameRiderCount >= RECORDER_MAX_RIDERS_PER_FRAME)
+			{
+				return;
+			}
+
+			FrameBuffer& buffer = g_buffers[g_activeBuffer];
+			uint32_t offset = g_frameOffset + sizeof(RecorderFrameHeader) + g_frameRiderCount * sizeof(RecorderRiderRecord);
+			RecorderRiderRecord* stored = (RecorderRiderRecord*)(buffer.data + offset);
+			memcpy(stored, &record, sizeof(RecorderRiderRecord));
+			g_frameRiderCount++;
+
+			for (uint32_t i = 0; i < g_notedInputCount; i++)
+			{
+				NotedInputs& noted = g_notedInputs[i];
+				if (noted.mountFormID != record.mountFormID) continue;
+
+				if (noted.pathCheck != RECORDER_PATH_NOT_CHECKED) stored->pathCheck = noted.pathCheck;
+				if (noted.obstruction != 0) stored->obstruction = noted.obstruction;
+				stored->inputFlags |= noted.inputFlags;
+
+				// Consumed - a later record for the same horse starts clean
+				g_notedInputs[i] = g_notedInputs[--g_notedInputCount];
+				break;
+			}
+		}
+
+		// Inputs for a horse this frame (nullptr if not recording or full)
+		static NotedInputs* GetNotedInputs(uint32_t mountFormID)
+		{
+			if (!g_frameOpen || mountFormID == 0)
+			{
+				return nullptr;
+			}
+
+			for (uint32_t i = 0; i < g_notedInputCount; i++)
+			{
+				if (g_notedInputs[i].mountFormID == mountFormID)
+				{
+					return &g_notedInputs[i];
+				}
+			}
+
+			if (g_notedInputCount >= RECORDER_MAX_RIDERS_PER_FRAME)
+			{
+				return nullptr;
+			}
+
+			NotedInputs* noted = &g_notedInputs[g_notedInputCount++];
+			noted->mountFormID = mountFormID;
+			noted->pathCheck = RECORDER_PATH_NOT_CHECKED;
+			noted->obstruction = 0;
+			noted->inputFlags = 0;
+			return noted;
+		}
+
+		void NotePathCheck(uint32_t mountFormID, bool clear)
+		{
+			NotedInputs* noted = GetNotedInputs(mountFormID);
+			if (noted) noted->pathCheck = clear ? RECORDER_PATH_CLEAR : RECORDER_PATH_BLOCKED;
+		}
+
+		void NoteObstruction(uint32_t mountFormID, uint8_t obstructionType)
+		{
+			NotedInputs* noted = GetNotedInputs(mountFormID);
+			if (noted) noted->obstruction = obstructionType;
+		}
+
+		void NoteInputFlags(uint32_t mountFormID, uint8_t inputFlags)
+		{
+			NotedInputs* noted = GetNotedInputs(mountFormID);
+			if (noted) noted->inputFlags |= inputFlags;
+		}
+
+		void EndFrame()
+		{
+			if (!g_frameOpen)
+			{
+				return;
+			}
+
+			g_frameOpen = false;
+
+			// Nothing processed this tick - keep the stream small
+			if (g_frameRiderCount == 0)
+			{
+				return;
+			}
+
+			FrameBuffer& buffer = g_buffers[g_activeBuffer];
+			RecorderFrameHeader* header = (RecorderFrameHeader*)(buffer.data + g_frameOffset);
+			header->riderCount = g_frameRiderCount;
+
+			buffer.used = g_frameOffset + sizeof(RecorderFrameHeader) + g_frameRiderCount * sizeof(RecorderRiderRecord);
+			g_droppedSinceLastFrame = 0;
+
+			// Write partial buffers periodically so a crash still leaves
+			// the last few seconds on disk
+			if ((g_frameTime - g_lastHandOffTime) >= RECORDER_FLUSH_INTERVAL || g_frameTime < g_lastHandOffTime)
+			{
+				HandOffActiveBuffer();
+			}
+		}
+
+		void FlushRecorder(int timeoutMs)
+		{
+			g_frameOpen = false;
+
+			if (!g_writerStarted.load())
+			{
+				return;
+			}
+
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+			// Hand off whatever is buffered (waits for the other buffer if needed)
+			if (g_buffers[g_activeBuffer].used > 0)
+			{
+				while (!HandOffActiveBuffer())
+				{
+					if (std::chrono::steady_clock::now() > deadline) break;
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			// Wait for both buffers to be written
+			while (g_buffers[0].state.load(std::memory_order_acquire) != BUFFER_FREE ||
+				g_buffers[1].state.load(std::memory_order_acquire) != BUFFER_FREE)
+			{
+				if (std::chrono::steady_clock::now() > deadline) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			// Close the file
+			g_closeRequested.store(true, std::memory_order_release);
+			while (g_closeRequested.load(std::memory_order_acquire))
+			{
+				if (std::chrono::steady_clock::now() > deadline) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			uint64_t dropped = g_droppedFrames.load(std::memory_order_relaxed);
+			if (dropped > 0)
+			{
+				_MESSAGE("CombatRecorder: %llu frames dropped so far (writer behind)", (unsigned long long)dropped);
+			}
+		}
+
+		uint64_t GetDroppedFrameCount()
+		{
+			return g_droppedFrames.load(std::memory_order_relaxed);
+		}
+	}
+}
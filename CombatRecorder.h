@@ -0,0 +1,164 @@
+#pragma once
+
+#include "CombatDecisions.h"
+#include <cstdint>
+
+// ============================================
+// COMBAT RECORDER (per-tick capture)
+// ============================================
+// Opt-in (RecorderEnabled INI) binary capture of the rider loop for
+// reproducing field bug reports and perf regressions offline.
+//
+// Each tick the rider loop writes one frame: a frame header followed
+// by one fixed-size record per rider it processed (positions, heading,
+// health, combat flags, the decide-phase state and the state before/
+// after the combat style ran).
+//
+// Engine-side checks made while a rider's combat style runs (path
+// check, obstruction classification and response, sheer drop / terrain
+// sampling) are noted against the horse with the Note* functions and
+// folded into that rider's record, so a replay sees every input the
+// decisions were made from.
+//
+// Cost on the game thread is a memcpy into one of two preallocated
+// buffers. Full buffers are handed to a background thread that writes
+// them to disk. If the writer falls behind, whole frames are dropped
+// (and counted) rather than stalling the tick.
+//
+// FILE LAYOUT (little endian, fixed-size records):
+//   RecorderFileHeader
+//   repeated { RecorderFrameHeader, riderCount x RecorderRiderRecord }
+//
+// The record types below use only plain integer/float fields and the
+// enums from CombatDecisions.h, so a replay tool can read the stream
+// and feed it back through the decision functions without the game
+// (tests/CombatReplay.cpp).
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	namespace CombatRecorder
+	{
+		const uint32_t RECORDER_MAGIC = 0x52434E4D;  // "MNCR"
+		const uint32_t RECORDER_VERSION = 2;
+
+		const uint32_t RECORDER_BUFFER_BYTES = 256 * 1024;
+		const uint32_t RECORDER_MAX_RIDERS_PER_FRAME = 32;
+		const float RECORDER_FLUSH_INTERVAL = 2.0f;   // Seconds between partial-buffer writes
+
+		// ============================================
+		// RIDER FLAGS
+		// ============================================
+
+		enum RecorderRiderFlags : uint8_t
+		{
+			RECORDER_FLAG_HAS_TARGET      = 1 << 0,
+			RECORDER_FLAG_TARGET_MOUNTED  = 1 << 1,
+			RECORDER_FLAG_WEAPON_DRAWN    = 1 << 2,
+			RECORDER_FLAG_IS_BOW          = 1 << 3,
+			RECORDER_FLAG_FLEEING         = 1 << 4,  // Skipped - flee system owns this rider
+			RECORDER_FLAG_FLEE_TRIGGERED  = 1 << 5   // Tactical flee started this tick
+		};
+
+		// ============================================
+		// DECISION INPUTS
+		// ============================================
+
+		enum RecorderPathCheck : uint8_t
+		{
+			RECORDER_PATH_NOT_CHECKED = 0,
+			RECORDER_PATH_CLEAR       = 1,
+			RECORDER_PATH_BLOCKED     = 2
+		};
+
+		enum RecorderInputFlags : uint8_t
+		{
+			RECORDER_INPUT_HAS_BOW_INVENTORY = 1 << 0,  // Bow in inventory (decide-phase hasBow)
+			RECORDER_INPUT_TERRAIN_CHECKED   = 1 << 1,  // Sheer drop probes ran this tick
+			RECORDER_INPUT_TERRAIN_USABLE    = 1 << 2,  // Terrain heights were available and calibrated
+			RECORDER_INPUT_SHEER_DROP        = 1 << 3,  // Sheer drop reported near the horse
+			RECORDER_INPUT_BLOCKED_BY_NPC    = 1 << 4,  // Obstruction attributed to an actor
+			RECORDER_INPUT_STEERED           = 1 << 5,  // Steered around the obstruction
+			RECORDER_INPUT_JUMPED            = 1 << 6   // Jumped to escape the obstruction
+		};
+
+		// ============================================
+		// STREAM RECORDS
+		// ============================================
+
+		#pragma pack(push, 4)
+
+		struct RecorderFileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t frameHeaderSize;
+			uint32_t riderRecordSize;
+		};
+
+		struct RecorderFrameHeader
+		{
+			uint32_t frameIndex;
+			float gameTime;
+			uint32_t riderCount;
+			uint32_t droppedFramesBefore;  // Frames dropped since the previous written frame
+		};
+
+		struct RecorderRiderRecord
+		{
+			uint32_t riderFormID;
+			uint32_t mountFormID;
+			uint32_t targetFormID;
+			float riderPos[3];
+			float mountPos[3];
+			float targetPos[3];
+			float mountHeading;        // rot.z in radians
+			float riderHealth;
+			float targetHealth;
+			float distanceToTarget;
+			float weaponReach;
+			uint8_t stateBefore;       // MountedCombatState
+			uint8_t stateAfter;        // MountedCombatState (the decision taken)
+			uint8_t combatClass;       // MountedCombatClass
+			uint8_t flags;             // RecorderRiderFlags
+			uint8_t decidedState;      // MountedCombatState from the decide phase (None = keep)
+			uint8_t pathCheck;         // RecorderPathCheck
+			uint8_t obstruction;       // ObstructionType (AILogging.h)
+			uint8_t inputFlags;        // RecorderInputFlags
+		};
+
+		#pragma pack(pop)
+
+		static_assert(sizeof(RecorderFileHeader) == 16, "Recorder file header layout changed");
+		static_assert(sizeof(RecorderFrameHeader) == 16, "Recorder frame header layout changed");
+		static_assert(sizeof(RecorderRiderRecord) == 76, "Recorder rider record layout changed");
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Open a frame (no-op unless RecorderEnabled)
+		void BeginFrame(float gameTime);
+
+		// True between BeginFrame and EndFrame when a frame is being captured
+		bool IsRecording();
+
+		// Append a rider to the open frame. Inputs noted for its mount
+		// this frame are merged into the record.
+		void RecordRider(const RecorderRiderRecord& record);
+
+		// Note decision inputs for a horse (no-op unless a frame is open)
+		void NotePathCheck(uint32_t mountFormID, bool clear);
+		void NoteObstruction(uint32_t mountFormID, uint8_t obstructionType);
+		void NoteInputFlags(uint32_t mountFormID, uint8_t inputFlags);
+
+		// Close the frame (empty frames are discarded)
+		void EndFrame();
+
+		// Hand off buffered frames, wait for the writer and close the file
+		// (called on mod deactivate; the next session opens a new file)
+		void FlushRecorder(int timeoutMs = 1000);
+
+		uint64_t GetDroppedFrameCount();
+	}
+}
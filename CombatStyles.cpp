@@ -10,7 +10,10 @@
 #include "CompanionCombat.h"// For IsCompanion
 #include "FleeingBehavior.h"  // For StopTacticalFlee, StopCivilianFlee
 #include "FactionData.h"  // For IsActorHostileToActor
+#include "EncounterGraph.h"  // For per-encounter ranged role
 #include "config.h"  // For MountedAttackStagger settings
+#include "PerfCounters.h"
+#include "SteeringKernel.h"
 #include "skse64/GameData.h"
 #include "skse64/GameReferences.h"
 #include "skse64/GameForms.h"
@@ -28,10 +31,7 @@ namespace MountedNPCCombatVR
 	// Configuration
 	// ============================================
 
-	const float MELEE_ATTACK_RANGE = 200.0f;
-	const float MELEE_CHARGE_RANGE = 512.0f;
-	const float RANGED_MIN_RANGE = 333.0f;
-	const float RANGED_MAX_RANGE = 2000.0f;
+	// Style ranges (MELEE_ATTACK_RANGE etc.) are in CombatDecisions.h
 	const float FOLLOW_UPDATE_INTERVAL = 0.1f;  // Update every 100ms for smooth rotation
 	const float TARGET_SWITCH_COOLDOWN = 10.0f;  // 10 seconds between target switches
 	
@@ -234,7 +234,7 @@ namespace MountedNPCCombatVR
 		
 		if (leftFormID != 0)
 		{
-			TESForm* leftForm = LookupFormByID(leftFormID);
+			TESForm* leftForm = CountedLookupFormByID(leftFormID);
 			if (leftForm)
 			{
 				g_idleAttackLeft = DYNAMIC_CAST(leftForm, TESForm, TESIdleForm);
@@ -255,7 +255,7 @@ namespace MountedNPCCombatVR
 		
 		if (rightFormID != 0)
 		{
-			TESForm* rightForm = LookupFormByID(rightFormID);
+			TESForm* rightForm = CountedLookupFormByID(rightFormID);
 			if (rightForm)
 			{
 				g_idleAttackRight = DYNAMIC_CAST(rightForm, TESForm, TESIdleForm);
@@ -275,7 +275,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Load Power Attack Idles from Update.esm
-		TESForm* powerLeftForm = LookupFormByID(IDLE_POWER_ATTACK_LEFT_FORMID);
+		TESForm* powerLeftForm = CountedLookupFormByID(IDLE_POWER_ATTACK_LEFT_FORMID);
 		if (powerLeftForm)
 		{
 			g_idlePowerAttackLeft = DYNAMIC_CAST(powerLeftForm, TESForm, TESIdleForm);
@@ -289,7 +289,7 @@ namespace MountedNPCCombatVR
 			_MESSAGE("CombatStyles: ERROR - Could not find IDLE_POWER_ATTACK_LEFT (FormID: %08X)", IDLE_POWER_ATTACK_LEFT_FORMID);
 		}
 		
-		TESForm* powerRightForm = LookupFormByID(IDLE_POWER_ATTACK_RIGHT_FORMID);
+		TESForm* powerRightForm = CountedLookupFormByID(IDLE_POWER_ATTACK_RIGHT_FORMID);
 		if (powerRightForm)
 		{
 			g_idlePowerAttackRight = DYNAMIC_CAST(powerRightForm, TESForm, TESIdleForm);
@@ -867,7 +867,7 @@ namespace MountedNPCCombatVR
 			
 			UInt32 actorFormID = g_followingNPCs[i].actorFormID;
 			
-			TESForm* form = LookupFormByID(actorFormID);
+			TESForm* form = CountedLookupFormByID(actorFormID);
 			if (!form || form->formType != kFormType_Character)
 			{
 				g_followingNPCs[i].isValid = false;
@@ -1067,7 +1067,7 @@ namespace MountedNPCCombatVR
 			// ============================================
 			if (!target && storedTargetFormID != 0)
 			{
-				TESForm* targetForm = LookupFormByID(storedTargetFormID);
+				TESForm* targetForm = CountedLookupFormByID(storedTargetFormID);
 				if (targetForm && targetForm->formType == kFormType_Character)
 				{
 					target = static_cast<Actor*>(targetForm);
@@ -1188,7 +1188,7 @@ namespace MountedNPCCombatVR
 				if (mountValid)
 				{
 					float angleAwayFromTarget = atan2(-dx, -dy);
-					mount->rot.z = angleAwayFromTarget;
+					Steering::SnapHeading(mount, angleAwayFromTarget);
 				}
 				
 				// Clear weapon state data (data only - no game calls)
@@ -1382,16 +1382,10 @@ namespace MountedNPCCombatVR
 			if (!actor || !mount || !target || !weaponInfo) return MountedCombatState::None;
 			
 			float distance = GetDistanceBetween(actor, target);
-			
-			if ((weaponInfo->isBow || weaponInfo->hasBowInInventory) && distance > RANGED_MIN_RANGE && distance <= RANGED_MAX_RANGE)
-				return MountedCombatState::RangedAttack;
-			
-			if (distance <= MELEE_ATTACK_RANGE) return MountedCombatState::Attacking;
-			if (distance <= MELEE_CHARGE_RANGE) return MountedCombatState::Charging;
-			return MountedCombatState::Engaging;
+			return DecideStyleState(distance, weaponInfo->isBow || weaponInfo->hasBowInInventory);
 		}
 		
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target)
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState)
 		{
 			if (!npcData || !actor || !mount) return;
 			
@@ -1415,12 +1409,8 @@ namespace MountedNPCCombatVR
 			
 			if (!target) return;
 			
-			MountedCombatState newState = DetermineState(actor, mount, target, &npcData->weaponInfo);
-			if (newState != npcData->state && newState != MountedCombatState::None)
-			{
-				npcData->state = newState;
-				npcData->stateStartTime = currentTime;
-			}
+			// State was decided from this tick's snapshot
+			ApplyDecidedState(decidedState, npcData->State(), npcData->StateStartTime(), currentTime);
 		}
 		
 		bool ShouldUseRanged(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo)
@@ -1437,9 +1427,9 @@ namespace MountedNPCCombatVR
 			return GuardCombat::DetermineState(actor, mount, target, weaponInfo);
 		}
 		
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target)
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState)
 		{
-			GuardCombat::ExecuteBehavior(npcData, actor, mount, target);
+			GuardCombat::ExecuteBehavior(npcData, actor, mount, target, decidedState);
 		}
 		
 		bool ShouldUseRanged(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo)
@@ -1455,9 +1445,9 @@ namespace MountedNPCCombatVR
 			return GuardCombat::DetermineState(actor, mount, target, weaponInfo);
 		}
 		
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target)
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState)
 		{
-			GuardCombat::ExecuteBehavior(npcData, actor, mount, target);
+			GuardCombat::ExecuteBehavior(npcData, actor, mount, target, decidedState);
 		}
 		
 		bool ShouldUseMelee(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo)
@@ -1474,9 +1464,9 @@ namespace MountedNPCCombatVR
 			return GuardCombat::DetermineState(actor, mount, target, weaponInfo);
 		}
 		
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target)
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState)
 		{
-			GuardCombat::ExecuteBehavior(npcData, actor, mount, target);
+			GuardCombat::ExecuteBehavior(npcData, actor, mount, target, decidedState);
 		}
 	}
 	// ============================================
@@ -1592,7 +1582,7 @@ namespace MountedNPCCombatVR
 		
 		g_bloodImpactInitialized = true;
 		
-		TESForm* form = LookupFormByID(BLOOD_IMPACT_DATASET_FORMID);
+		TESForm* form = CountedLookupFormByID(BLOOD_IMPACT_DATASET_FORMID);
 		if (!form)
 		{
 			_MESSAGE("CombatStyles: ERROR - Could not find blood impact dataset (FormID: %08X)", BLOOD_IMPACT_DATASET_FORMID);
@@ -1695,7 +1685,7 @@ namespace MountedNPCCombatVR
 		if (!actor) return;
 		
 		// Look up the sound form (SOUN type)
-		TESForm* form = LookupFormByID(soundFormID);
+		TESForm* form = CountedLookupFormByID(soundFormID);
 		if (!form) 
 		{
 			_MESSAGE("CombatStyles: Failed to find sound form %08X", soundFormID);
@@ -1724,7 +1714,7 @@ namespace MountedNPCCombatVR
 	{
 		if (g_mountedStaggerIdle != nullptr) return true;
 		
-		TESForm* form = LookupFormByID(MOUNTED_STAGGER_IDLE_FORMID);
+		TESForm* form = CountedLookupFormByID(MOUNTED_STAGGER_IDLE_FORMID);
 		if (!form)
 		{
 			_MESSAGE("CombatStyles: ERROR - Could not find mounted stagger idle (FormID: %08X)", MOUNTED_STAGGER_IDLE_FORMID);
@@ -1826,7 +1816,7 @@ namespace MountedNPCCombatVR
 			float angleToAttacker = atan2(dx, dy);  // Angle from target to attacker
 			
 			// Get the direction the target is facing
-			float targetFacing = actor->rot.z;
+			float targetFacing = Steering::GetHeading(actor);
 			
 			// Calculate angle difference
 			float angleDiff = angleToAttacker - targetFacing;
@@ -2301,6 +2291,23 @@ namespace MountedNPCCombatVR
 		return (data != nullptr && data->mode == RangedRoleMode::Ranged);
 	}
 	
+	// True if a rider in this encounter already holds the ranged role
+	// (riders the encounter graph does not know share encounter -1)
+	static bool EncounterHasRangedRole(int encounterId)
+	{
+		for (int i = 0; i < MAX_RANGED_ROLE_TRACKED; i++)
+		{
+			if (!g_rangedRoleData[i].isValid) continue;
+			if (g_rangedRoleData[i].mode == RangedRoleMode::None) continue;
+			
+			if (Encounters::GetEncounterId(g_rangedRoleData[i].riderFormID) == encounterId)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	
 	// ============================================
 	// RANGED ROLE ASSIGNMENT - Main update function
 	// Called periodically to update which riders are in ranged role
@@ -2317,16 +2324,17 @@ namespace MountedNPCCombatVR
 		float currentTime = GetCurrentGameTime();
 		
 		// ============================================
-		// STEP 1: Count valid non-mage riders and find their target
+		// STEP 1: Count valid non-mage riders and find their encounter
 		// ============================================
 		int validRiderCount = 0;
-		Actor* sharedTarget = nullptr;
 		
 		struct RiderInfo {
 			UInt32 riderFormID;
 			UInt32 horseFormID;
 			Actor* riderActor;
-			float distanceToTarget;
+			Actor* target;
+			int encounterId;
+			float distanceSqToTarget;   // Planar, squared (only compared)
 			bool isLeaderOrCaptain;
 			bool isMage;
 		};
@@ -2337,7 +2345,7 @@ namespace MountedNPCCombatVR
 		{
 			if (!g_followingNPCs[i].isValid) continue;
 			
-			TESForm* riderForm = LookupFormByID(g_followingNPCs[i].actorFormID);
+			TESForm* riderForm = CountedLookupFormByID(g_followingNPCs[i].actorFormID);
 			if (!riderForm || riderForm->formType != kFormType_Character) continue;
 			
 			Actor* rider = static_cast<Actor*>(riderForm);
@@ -2383,21 +2391,17 @@ namespace MountedNPCCombatVR
 			
 			if (!target) continue;
 			
-			// Use first target as shared target reference
-			if (!sharedTarget)
-			{
-				sharedTarget = target;
-			}
-			
-			// Calculate distance to target
+			// Calculate distance to target (squared - only used to pick the furthest)
 			float dx = target->pos.x - rider->pos.x;
 			float dy = target->pos.y - rider->pos.y;
-			float distance = sqrt(dx * dx + dy * dy);
+			float distanceSq = dx * dx + dy * dy;
 			
 			riders[validRiderCount].riderFormID = rider->formID;
 			riders[validRiderCount].horseFormID = mount->formID;
 			riders[validRiderCount].riderActor = rider;
-			riders[validRiderCount].distanceToTarget = distance;
+			riders[validRiderCount].target = target;
+			riders[validRiderCount].encounterId = Encounters::GetEncounterId(rider->formID);
+			riders[validRiderCount].distanceSqToTarget = distanceSq;
 			riders[validRiderCount].isLeaderOrCaptain = IsLeaderOrCaptainByName(rider);
 			riders[validRiderCount].isMage = false;
 			
@@ -2411,93 +2415,115 @@ namespace MountedNPCCombatVR
 		}
 		
 		// ============================================
-		// CHECK IF RANGED ROLE IS ALREADY ASSIGNED
-		// Once assigned, it stays until combat ends - NO REASSIGNMENT!
+		// PLAN EACH ENCOUNTER INDEPENDENTLY
+		// Riders in unrelated battles each get their own ranged role
+		// and their own shared target (EncounterGraph.h).
 		// ============================================
-		for (int i = 0; i < MAX_RANGED_ROLE_TRACKED; i++)
+		bool encounterPlanned[5] = { false, false, false, false, false };
+		
+		for (int first = 0; first < validRiderCount; first++)
 		{
-			if (g_rangedRoleData[i].isValid && g_rangedRoleData[i].mode != RangedRoleMode::None)
+			if (encounterPlanned[first]) continue;
+			
+			int encounterId = riders[first].encounterId;
+			int members[5];
+			int memberCount = 0;
+			
+			for (int i = first; i < validRiderCount; i++)
 			{
-				// Ranged role already assigned - skip assignment, just update existing
-				// (mode switching between Ranged/Melee is handled in STEP 4)
-				goto step4_update_existing;
+				if (riders[i].encounterId != encounterId) continue;
+				encounterPlanned[i] = true;
+				members[memberCount++] = i;
 			}
-		}
-		
-		// ============================================
-		// STEP 2: Determine who gets ranged role
-		// Priority: Leaders/Captains first, then furthest from target
-		// ============================================
-		int rangedRoleRiderIndex = -1;
-		
-		// First check for leader/captain
-		for (int i = 0; i < validRiderCount; i++)
-		{
-			if (riders[i].isLeaderOrCaptain)
+			
+			// Need at least configured number of non-mage riders in this encounter
+			if (memberCount < DynamicRangedRoleMinRiders) continue;
+			
+			// ============================================
+			// CHECK IF RANGED ROLE IS ALREADY ASSIGNED IN THIS ENCOUNTER
+			// Once assigned, it stays until combat ends - NO REASSIGNMENT!
+			// (mode switching between Ranged/Melee is handled in STEP 4)
+			// ============================================
+			if (EncounterHasRangedRole(encounterId)) continue;
+			
+			// Use first target as shared target reference
+			Actor* sharedTarget = riders[first].target;
+			
+			// ============================================
+			// STEP 2: Determine who gets ranged role
+			// Priority: Leaders/Captains first, then furthest from target
+			// ============================================
+			int rangedRoleRiderIndex = -1;
+			
+			// First check for leader/captain
+			for (int m = 0; m < memberCount; m++)
 			{
-				rangedRoleRiderIndex = i;
-				break;
+				if (riders[members[m]].isLeaderOrCaptain)
+				{
+					rangedRoleRiderIndex = members[m];
+					break;
+				}
 			}
-		}
-		
-		// If no leader/captain, find furthest from target
-		if (rangedRoleRiderIndex == -1)
-		{
-			float maxDistance = 0;
-			for (int i = 0; i < validRiderCount; i++)
+			
+			// If no leader/captain, find furthest from target
+			if (rangedRoleRiderIndex == -1)
 			{
-				if (riders[i].distanceToTarget > maxDistance)
+				float maxDistanceSq = 0;
+				for (int m = 0; m < memberCount; m++)
 				{
-					maxDistance = riders[i].distanceToTarget;
-					rangedRoleRiderIndex = i;
+					if (riders[members[m]].distanceSqToTarget > maxDistanceSq)
+					{
+						maxDistanceSq = riders[members[m]].distanceSqToTarget;
+						rangedRoleRiderIndex = members[m];
+					}
 				}
 			}
-		}
-		
-		// ============================================
-		// STEP 3: Assign ranged role to selected rider
-		// ============================================
-		if (rangedRoleRiderIndex >= 0)
-		{
-			UInt32 riderFormID = riders[rangedRoleRiderIndex].riderFormID;
 			
-			// Check if already assigned
-			RangedRoleData* existingData = GetRangedRoleData(riderFormID);
-			if (!existingData || existingData->mode == RangedRoleMode::None)
+			// ============================================
+			// STEP 3: Assign ranged role to selected rider
+			// ============================================
+			if (rangedRoleRiderIndex >= 0)
 			{
-				// Assign new ranged role
-				RangedRoleData* data = GetOrCreateRangedRoleData(riderFormID);
-				if (data)
+				UInt32 riderFormID = riders[rangedRoleRiderIndex].riderFormID;
+			
+				// Check if already assigned
+				RangedRoleData* existingData = GetRangedRoleData(riderFormID);
+				if (!existingData || existingData->mode == RangedRoleMode::None)
 				{
-					data->horseFormID = riders[rangedRoleRiderIndex].horseFormID;
-					data->targetFormID = sharedTarget ? sharedTarget->formID : 0;
-					data->mode = RangedRoleMode::Ranged;
-					data->isLeaderOrCaptain = riders[rangedRoleRiderIndex].isLeaderOrCaptain;
-					data->lastModeSwitchTime = currentTime;
-					data->assignedTime = currentTime;
+					// Assign new ranged role
+					RangedRoleData* data = GetOrCreateRangedRoleData(riderFormID);
+					if (data)
+					{
+						data->horseFormID = riders[rangedRoleRiderIndex].horseFormID;
+						data->targetFormID = sharedTarget ? sharedTarget->formID : 0;
+						data->mode = RangedRoleMode::Ranged;
+						data->isLeaderOrCaptain = riders[rangedRoleRiderIndex].isLeaderOrCaptain;
+						data->lastModeSwitchTime = currentTime;
+						data->assignedTime = currentTime;
 					
-					const char* riderName = CALL_MEMBER_FN(riders[rangedRoleRiderIndex].riderActor, GetReferenceName)();
-					_MESSAGE("CombatStyles: '%s' (%08X) assigned RANGED role (%s, dist: %.0f)",
-						riderName ? riderName : "Unknown",
-						riderFormID,
-						riders[rangedRoleRiderIndex].isLeaderOrCaptain ? "leader/captain" : "furthest",
-						riders[rangedRoleRiderIndex].distanceToTarget);
+						const char* riderName = CALL_MEMBER_FN(riders[rangedRoleRiderIndex].riderActor, GetReferenceName)();
+						_MESSAGE("CombatStyles: '%s' (%08X) assigned RANGED role (%s, dist: %.0f)",
+							riderName ? riderName : "Unknown",
+							riderFormID,
+							riders[rangedRoleRiderIndex].isLeaderOrCaptain ? "leader/captain" : "furthest",
+							sqrt(riders[rangedRoleRiderIndex].distanceSqToTarget));
 					
-					// Track this assignment to prevent immediate follow package crash
-					g_lastRangedRoleAssignmentTime = currentTime;
-					g_lastAssignedRiderFormID = riderFormID;
+						// Track this assignment to prevent immediate follow package crash
+						g_lastRangedRoleAssignmentTime = currentTime;
+						g_lastAssignedRiderFormID = riderFormID;
 					
-					// Give bow if needed
-					if (!HasBowInInventory(riders[rangedRoleRiderIndex].riderActor))
-					{
-						GiveDefaultBow(riders[rangedRoleRiderIndex].riderActor);
-					}
+						// Give bow if needed
+						if (!HasBowInInventory(riders[rangedRoleRiderIndex].riderActor))
+						{
+							GiveDefaultBow(riders[rangedRoleRiderIndex].riderActor);
+						}
 					
-					// Give arrows if needed
-					EquipArrows(riders[rangedRoleRiderIndex].riderActor);
+						// Give arrows if needed
+						EquipArrows(riders[rangedRoleRiderIndex].riderActor);
 					
-					// Request weapon switch to bow
-					RequestWeaponSwitch(riders[rangedRoleRiderIndex].riderActor, WeaponRequest::Bow);
+						// Request weapon switch to bow
+						RequestWeaponSwitch(riders[rangedRoleRiderIndex].riderActor, WeaponRequest::Bow);
+					}
 				}
 			}
 		}
@@ -2506,7 +2532,6 @@ namespace MountedNPCCombatVR
 		// STEP 4: Update mode for existing ranged role riders
 		// Switch between Ranged and Melee based on distance
 		// ============================================
-	step4_update_existing:
 		for (int i = 0; i < MAX_RANGED_ROLE_TRACKED; i++)
 		{
 			if (!g_rangedRoleData[i].isValid) continue;
@@ -2514,7 +2539,7 @@ namespace MountedNPCCombatVR
 			
 			UInt32 riderFormID = g_rangedRoleData[i].riderFormID;
 			
-			TESForm* riderForm = LookupFormByID(riderFormID);
+			TESForm* riderForm = CountedLookupFormByID(riderFormID);
 			if (!riderForm || riderForm->formType != kFormType_Character)
 			{
 				g_rangedRoleData[i].Reset();
@@ -132,32 +132,36 @@ namespace MountedNPCCombatVR
 	// ============================================
 	// Combat Style Namespaces
 	// ============================================
+	// ExecuteBehavior is the apply phase of the rider loop: decidedState
+	// comes from DecideRiderStates (CombatDecisions.h). DetermineState
+	// applies the same rule to live actors.
+	// ============================================
 	
 	namespace GuardCombat
 	{
 		MountedCombatState DetermineState(Actor* actor, Actor* mount, Actor* target, MountedWeaponInfo* weaponInfo);
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target);
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState);
 		bool ShouldUseRanged(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo);
 	}
 	
 	namespace SoldierCombat
 	{
 		MountedCombatState DetermineState(Actor* actor, Actor* mount, Actor* target, MountedWeaponInfo* weaponInfo);
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target);
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState);
 		bool ShouldUseRanged(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo);
 	}
 	
 	namespace BanditCombat
 	{
 		MountedCombatState DetermineState(Actor* actor, Actor* mount, Actor* target, MountedWeaponInfo* weaponInfo);
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target);
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState);
 		bool ShouldUseMelee(Actor* actor, Actor* target, MountedWeaponInfo* weaponInfo);
 	}
 	
 	namespace MageCombat
 	{
 		MountedCombatState DetermineState(Actor* actor, Actor* mount, Actor* target, MountedWeaponInfo* weaponInfo);
-		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target);
+		void ExecuteBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target, MountedCombatState decidedState);
 	}
 
 	// ============================================
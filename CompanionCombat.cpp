@@ -5,11 +5,13 @@
 #include "WeaponDetection.h"
 #include "NPCProtection.h"
 #include "CombatStyles.h"  // For ClearNPCFollowTarget
-#include "ArrowSystem.h"  // For ResetBowAttackState
+#include "ArrowSystem.h"  // For ResetBowAttackState, RemoveBowAttackRider
 #include "SpecialMovesets.h"  // For ClearAllMovesetData
 
 #include "Helper.h"  // For GetGameTime
 #include "config.h"
+#include "CellScanCursor.h"
+#include "PerfCounters.h"
 #include "skse64/GameRTTI.h"
 #include <cmath>
 
@@ -25,6 +27,7 @@ namespace MountedNPCCombatVR
 	
 	// Scan interval tracking - declared early so ResetCompanionCombat can use it
 	static float g_lastCompanionScanTime = 0;
+	static CellScanCursor g_companionScanCursor(CELL_SCAN_SLICE_SIZE);  // Resumable position in the player's cell
 	const float COMPANION_SCAN_INTERVAL = 2.0f;  // Scan every 2 seconds
 	
 	// ============================================
@@ -64,6 +67,7 @@ namespace MountedNPCCombatVR
 		
 		// Reset scan timer so companions are detected fresh
 		g_lastCompanionScanTime = 0;
+		g_companionScanCursor.Reset();
 		
 		// ============================================
 		// CRITICAL: Do NOT call LookupFormByID during reset!
@@ -200,7 +204,7 @@ namespace MountedNPCCombatVR
 				g_trackedCompanions[i].companionFormID == companionFormID)
 			{
 				// Clear protection and packages
-				TESForm* form = LookupFormByID(companionFormID);
+				TESForm* form = CountedLookupFormByID(companionFormID);
 				if (form)
 				{
 					Actor* companion = DYNAMIC_CAST(form, TESForm, Actor);
@@ -238,10 +242,13 @@ namespace MountedNPCCombatVR
 					}
 				}
 				
+				// Bow slot and animation event watch (also for dead companions)
+				RemoveBowAttackRider(companionFormID);
+				
 				// Clear mount packages and special movesets
 				if (g_trackedCompanions[i].mountFormID != 0)
 				{
-					TESForm* mountForm = LookupFormByID(g_trackedCompanions[i].mountFormID);
+					TESForm* mountForm = CountedLookupFormByID(g_trackedCompanions[i].mountFormID);
 					if (mountForm)
 					{
 						Actor* mount = DYNAMIC_CAST(mountForm, TESForm, Actor);
@@ -251,6 +258,7 @@ namespace MountedNPCCombatVR
 							ClearAllMovesetData(mount->formID);
 							
 							Actor_ClearKeepOffsetFromActor(mount);
+							PERF_COUNT(EvaluatePackageCalls);
 							Actor_EvaluatePackage(mount, false, false);
 						}
 					}
@@ -276,6 +284,15 @@ namespace MountedNPCCombatVR
 		return nullptr;
 	}
 	
+	MountedCompanionData* GetCompanionDataByIndex(int index)
+	{
+		if (index < 0 || index >= MAX_TRACKED_COMPANIONS)
+		{
+			return nullptr;
+		}
+		return &g_trackedCompanions[index];
+	}
+	
 	int GetMountedCompanionCount()
 	{
 		return g_trackedCompanionCount;
@@ -345,18 +362,15 @@ namespace MountedNPCCombatVR
 		if (!g_thePlayer || !(*g_thePlayer)) return;
 		
 		Actor* player = *g_thePlayer;
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return;
 		
 		// Only scan if player is in combat
 		if (!player->IsInCombat()) return;
 		
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		if (!g_companionScanCursor.BeginSlice(player->parentCell)) return;
+		
+		TESObjectREFR* ref = nullptr;
+		while (g_companionScanCursor.Next(ref))
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
 			if (ref->formType != kFormType_Character) continue;
 			
 			Actor* actor = static_cast<Actor*>(ref);
@@ -381,9 +395,9 @@ namespace MountedNPCCombatVR
 			float dx = actor->pos.x - player->pos.x;
 			float dy = actor->pos.y - player->pos.y;
 			float dz = actor->pos.z - player->pos.z;
-			float dist = sqrt(dx * dx + dy * dy + dz * dz);
+			float distSq = dx * dx + dy * dy + dz * dz;
 			
-			if (dist > CompanionScanRange) continue;
+			if (distSq > CompanionScanRange * CompanionScanRange) continue;
 			
 			// Register this companion!
 			_MESSAGE("CompanionCombat: SCAN DETECTED new mounted companion near player in combat");
@@ -451,8 +465,14 @@ namespace MountedNPCCombatVR
 		if (g_playerIsDead || !g_playerInExterior) return;
 		
 		// Periodic scan for new mounted companions when player is in combat
+		// The interval gates the start of a pass; a pass in progress
+		// continues one slice per frame
 		float currentTime = GetGameTime();
-		if ((currentTime - g_lastCompanionScanTime) >= COMPANION_SCAN_INTERVAL)
+		if (g_companionScanCursor.IsMidPass())
+		{
+			ScanForMountedCompanions();
+		}
+		else if ((currentTime - g_lastCompanionScanTime) >= COMPANION_SCAN_INTERVAL)
 		{
 			g_lastCompanionScanTime = currentTime;
 			ScanForMountedCompanions();
@@ -465,7 +485,7 @@ namespace MountedNPCCombatVR
 			if (!data->isValid) continue;
 			
 			// Look up companion
-			TESForm* companionForm = LookupFormByID(data->companionFormID);
+			TESForm* companionForm = CountedLookupFormByID(data->companionFormID);
 			if (!companionForm)
 			{
 				data->Reset();
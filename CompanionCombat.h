@@ -77,6 +77,7 @@ namespace MountedNPCCombatVR
 	
 	// Get tracking data for a companion
 	MountedCompanionData* GetCompanionData(UInt32 companionFormID);
+	MountedCompanionData* GetCompanionDataByIndex(int index);  // For iteration
 	
 	// Get count of currently tracked mounted companions
 	int GetMountedCompanionCount();
@@ -7,7 +7,15 @@
 #include "FleeingBehavior.h"
 #include "MagicCastingSystem.h"
 #include "AILogging.h"
+#include "AttackSlots.h"
+#include "PursuitField.h"
+#include "SteeringKernel.h"
+#include "OccupancyGrid.h"
+#include "CombatRecorder.h"
+#include "LogRateLimit.h"
 #include "config.h"  // For DynamicRangedRole settings
+#include "PerfCounters.h"
+#include "Tracer.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include <cmath>
@@ -91,9 +99,7 @@ namespace MountedNPCCombatVR
 	// Switches back to ranged when target exceeds MELEE_TO_RANGED_DISTANCE
 	// THREAD SAFE: Uses mutex for multi-rider scenarios
 	
-	const float RANGED_TO_MELEE_DISTANCE = 340.0f;    // Switch to melee follow when closer than this
-	const float MELEE_TO_RANGED_DISTANCE = 500.0f;    // Switch back to ranged when further than this
-	const float RANGED_SWITCH_COOLDOWN = 2.0f;  // Minimum time between switches to prevent spam
+	// Distances and cooldown live in CombatDecisions.h
 	
 	struct RangedFollowStateData
 	{
@@ -322,6 +328,7 @@ namespace MountedNPCCombatVR
 		// and let the next update cycle handle it
 		
 		// Force AI re-evaluation
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
 		// Re-apply follow behavior to the ACTUAL target (not player!)
@@ -370,6 +377,9 @@ namespace MountedNPCCombatVR
 	
 	// Check if obstruction is caused by an NPC (not terrain/geometry)
 	static bool IsObstructionCausedByNPC(Actor* horse, Actor* target);
+	
+	// Turn toward a clear lane in the encounter's occupancy grid
+	static bool TrySteerAroundObstruction(Actor* horse, Actor* target);
 
 	// ============================================
 	// INJECT FOLLOW PACKAGE
@@ -621,6 +631,7 @@ namespace MountedNPCCombatVR
 			get_vfunc<_Actor_PauseCurrentDialogue>(actor, 0x4F)(actor);
 		}
 
+		PERF_COUNT(PackageCreations);
 		TESPackage* package = CreatePackageByType(kPackageType_BumpReaction);
 		if (!package)
 		{
@@ -672,10 +683,27 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(actor, false, false);
 		return true;
 	}
 
+	// ============================================
+	// SHARED TARGET HANDLE
+	// Every follower of a target uses the handle from its pursuit field
+	// (created once per tick) instead of creating its own
+	// ============================================
+
+	static UInt32 GetPursuitTargetHandle(Actor* target)
+	{
+		const Pursuit::PursuitField* pursuit = Pursuit::GetPursuitField(target);
+		if (pursuit)
+		{
+			return pursuit->targetHandle;
+		}
+		return target->CreateRefHandle();
+	}
+
 	// ============================================
 	// SET NPC KEEP OFFSET FROM TARGET
 	// ============================================
@@ -687,7 +715,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 
-		UInt32 targetHandle = target->CreateRefHandle();
+		UInt32 targetHandle = GetPursuitTargetHandle(target);
 
 		if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
 		{
@@ -724,7 +752,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 
-		UInt32 targetHandle = target->CreateRefHandle();
+		UInt32 targetHandle = GetPursuitTargetHandle(target);
 
 		if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
 		{
@@ -746,7 +774,7 @@ namespace MountedNPCCombatVR
 		float catchUp = DynamicRangedRoleIdealDistance + 200.0f;
 		Actor_KeepOffsetFromActor(actor, targetHandle, offset, offsetAngle, catchUp, DynamicRangedRoleIdealDistance);
 		
-		_MESSAGE("DynamicPackages: Set RANGED follow for actor %08X (%.0f units from target %08X)", 
+		LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, actor->formID, 2.0f, 10.0f, "DynamicPackages: Set RANGED follow for actor %08X (%.0f units from target %08X)", 
 			actor->formID, DynamicRangedRoleIdealDistance, target->formID);
 		return true;
 	}
@@ -801,10 +829,11 @@ namespace MountedNPCCombatVR
 		
 		float timeSinceLastSwitch = currentTime - lastSwitchTime;
 		
-		// Check cooldown - prevent spam switching
-		if (timeSinceLastSwitch < RANGED_SWITCH_COOLDOWN)
+		// Cooldown + hysteresis decision (engine-independent)
+		RangedFollowSwitch decision = DecideRangedFollowSwitch(isInRangedMode, distanceToTarget, timeSinceLastSwitch);
+		if (decision == RangedFollowSwitch::None)
 		{
-			return false;// Still on cooldown
+			return false;
 		}
 		
 		bool switchOccurred = false;
@@ -813,7 +842,7 @@ namespace MountedNPCCombatVR
 		// Currently in RANGED mode - check if should switch to MELEE
 		if (isInRangedMode)
 		{
-			if (distanceToTarget < RANGED_TO_MELEE_DISTANCE)
+			if (decision == RangedFollowSwitch::ToMelee)
 			{
 				// Target is too close - switch to melee follow
 				// Get actor's mount to apply the follow package
@@ -828,7 +857,7 @@ namespace MountedNPCCombatVR
 						newRangedMode = false;
 						switchOccurred = true;
 						
-						_MESSAGE("DynamicPackages: Ranged actor %08X switched to MELEE follow (distance: %.0f < %.0f)",
+						LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, actor->formID, 2.0f, 10.0f, "DynamicPackages: Ranged actor %08X switched to MELEE follow (distance: %.0f < %.0f)",
 							actor->formID, distanceToTarget, RANGED_TO_MELEE_DISTANCE);
 					}
 				}
@@ -837,7 +866,7 @@ namespace MountedNPCCombatVR
 		// Currently in MELEE mode - check if should switch back to RANGED
 		else
 		{
-			if (distanceToTarget > MELEE_TO_RANGED_DISTANCE)
+			if (decision == RangedFollowSwitch::ToRanged)
 			{
 				// Target is far enough - switch back to ranged follow
 				NiPointer<Actor> mount;
@@ -851,7 +880,7 @@ namespace MountedNPCCombatVR
 						newRangedMode = true;
 					 switchOccurred = true;
 						
-						_MESSAGE("DynamicPackages: Ranged actor %08X switched back to RANGED follow (distance: %.0f > %.0f)",
+						LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, actor->formID, 2.0f, 10.0f, "DynamicPackages: Ranged actor %08X switched back to RANGED follow (distance: %.0f > %.0f)",
 							actor->formID, distanceToTarget, MELEE_TO_RANGED_DISTANCE);
 					}
 				}
@@ -905,7 +934,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 
-		UInt32 targetHandle = target->CreateRefHandle();
+		UInt32 targetHandle = GetPursuitTargetHandle(target);
 
 		if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
 		{
@@ -927,7 +956,7 @@ namespace MountedNPCCombatVR
 		float catchUp = MageRoleIdealDistance + 150.0f;
 		Actor_KeepOffsetFromActor(actor, targetHandle, offset, offsetAngle, catchUp, MageRoleIdealDistance);
 		
-		_MESSAGE("DynamicPackages: Set MAGE follow for actor %08X (%.0f units from target %08X)", 
+		LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, actor->formID, 2.0f, 10.0f, "DynamicPackages: Set MAGE follow for actor %08X (%.0f units from target %08X)", 
 			actor->formID, MageRoleIdealDistance, target->formID);
 		return true;
 	}
@@ -944,6 +973,7 @@ namespace MountedNPCCombatVR
 		}
 
 		Actor_ClearKeepOffsetFromActor(actor);
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(actor, false, false);
 		return true;
 	}
@@ -1013,7 +1043,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 
-		UInt32 targetHandle = target->CreateRefHandle();
+		UInt32 targetHandle = GetPursuitTargetHandle(target);
 		if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
 		{
 			return false;
@@ -1036,9 +1066,10 @@ namespace MountedNPCCombatVR
 		// catchUpRadius slightly larger than melee range, followRadius = melee range
 		float catchUp = CompanionMeleeRange + 100.0f;
 		Actor_KeepOffsetFromActor(horse, targetHandle, offset, offsetAngle, catchUp, CompanionMeleeRange);
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
-		_MESSAGE("DynamicPackages: Companion horse %08X set to melee range %.0f from target %08X", 
+		LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, horse->formID, 2.0f, 10.0f, "DynamicPackages: Companion horse %08X set to melee range %.0f from target %08X", 
 			horse->formID, CompanionMeleeRange, target->formID);
 
 		return true;
@@ -1064,13 +1095,13 @@ namespace MountedNPCCombatVR
 		// ============================================
 		if (horse->formID == 0 || horse->formID == 0xFFFFFFFF)
 		{
-			_MESSAGE("ForceHorseCombatWithTarget: Invalid horse formID - skipping");
+			LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, 0, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Invalid horse formID - skipping");
 			return false;
 		}
 		
 		if (target->formID == 0 || target->formID == 0xFFFFFFFF)
 		{
-			_MESSAGE("ForceHorseCombatWithTarget: Invalid target formID - skipping");
+			LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, horse->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Invalid target formID - skipping");
 			return false;
 		}
 		
@@ -1078,18 +1109,18 @@ namespace MountedNPCCombatVR
 		// CRITICAL: VERIFY FORMIDS BY LOOKUP
 		// Ensure the FormIDs are still valid in the game
 		// ============================================
-		TESForm* horseForm = LookupFormByID(horse->formID);
-		TESForm* targetForm = LookupFormByID(target->formID);
+		TESForm* horseForm = CountedLookupFormByID(horse->formID);
+		TESForm* targetForm = CountedLookupFormByID(target->formID);
 		
 		if (!horseForm || horseForm != (TESForm*)horse)
 		{
-			_MESSAGE("ForceHorseCombatWithTarget: Horse %08X form mismatch - skipping", horse->formID);
+			LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, horse->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Horse %08X form mismatch - skipping", horse->formID);
 			return false;
 		}
 		
 		if (!targetForm || targetForm != (TESForm*)target)
 		{
-			_MESSAGE("ForceHorseCombatWithTarget: Target %08X form mismatch - skipping", target->formID);
+			LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, horse->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Target %08X form mismatch - skipping", target->formID);
 			return false;
 		}
 		
@@ -1106,7 +1137,7 @@ namespace MountedNPCCombatVR
 		{
 			if (IsNPCOnDisengageCooldown(rider->formID))
 			{
-				_MESSAGE("ForceHorseCombatWithTarget: Rider %08X on disengage cooldown - skipping follow injection", rider->formID);
+				LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, rider->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Rider %08X on disengage cooldown - skipping follow injection", rider->formID);
 				return false;
 			}
 		}
@@ -1170,12 +1201,13 @@ namespace MountedNPCCombatVR
 		const float MAX_FOLLOW_DISTANCE = 4100.0f;  // Don't attempt pathfinding beyond this
 		if (distanceToTarget > MAX_FOLLOW_DISTANCE)
 		{
-			_MESSAGE("ForceHorseCombatWithTarget: Target %08X too far (%.0f > %.0f) - skipping follow",
+			LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, horse->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: Target %08X too far (%.0f > %.0f) - skipping follow",
 				target->formID, distanceToTarget, MAX_FOLLOW_DISTANCE);
 			return false;
 		}
 
-		UInt32 targetHandle = target->CreateRefHandle();
+		const Pursuit::PursuitField* pursuit = Pursuit::GetPursuitField(target);
+		UInt32 targetHandle = pursuit ? pursuit->targetHandle : target->CreateRefHandle();
 		if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
 		{
 			return false;
@@ -1206,6 +1238,8 @@ namespace MountedNPCCombatVR
 		float followDistance = 300.0f;  // Default melee follow distance
 		float offsetX = 200.0f;   // Default side offset
 		float catchUpRadius = 1000.0f;  // Default catch-up radius
+		AttackSlots::SlotRing slotRing = AttackSlots::SlotRing::Melee;
+		float slotRadius = pursuit ? pursuit->meleeRingRadius : AttackSlots::SLOT_MELEE_RADIUS;
 		
 		// Check rider's combat class if we have a rider
 		if (hasRider && rider)
@@ -1219,13 +1253,15 @@ namespace MountedNPCCombatVR
 				followDistance = MageRoleIdealDistance;
 				offsetX = 0.0f;  // No side offset for mages - they want direct line of sight
 				catchUpRadius = MageRoleIdealDistance + 200.0f;
+				slotRing = AttackSlots::SlotRing::Ranged;
+				slotRadius = pursuit ? pursuit->mageRingRadius : MageRoleIdealDistance;
 				
 				// Only log once per mage (use static to track)
 				static UInt32 lastLoggedMage = 0;
 				if (lastLoggedMage != rider->formID)
 				{
 					lastLoggedMage = rider->formID;
-					_MESSAGE("ForceHorseCombatWithTarget: MAGE rider %08X - using follow distance %.0f", 
+					LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, rider->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: MAGE rider %08X - using follow distance %.0f", 
 						rider->formID, followDistance);
 				}
 			}
@@ -1239,12 +1275,14 @@ namespace MountedNPCCombatVR
 				followDistance = DynamicRangedRoleIdealDistance;
 				offsetX = 0.0f;  // No side offset - direct line of sight for bow
 				catchUpRadius = DynamicRangedRoleIdealDistance + 200.0f;
+				slotRing = AttackSlots::SlotRing::Ranged;
+				slotRadius = pursuit ? pursuit->rangedRingRadius : DynamicRangedRoleIdealDistance;
 				
 				static UInt32 lastLoggedRanged = 0;
 				if (lastLoggedRanged != rider->formID)
 				{
 					lastLoggedRanged = rider->formID;
-					_MESSAGE("ForceHorseCombatWithTarget: RANGED ROLE rider %08X - using follow distance %.0f", 
+					LOG_LIMITED(LOGSYS_DYNAMIC_PACKAGES, rider->formID, 2.0f, 10.0f, "ForceHorseCombatWithTarget: RANGED ROLE rider %08X - using follow distance %.0f", 
 						rider->formID, followDistance);
 				}
 			}
@@ -1256,12 +1294,26 @@ namespace MountedNPCCombatVR
 		offset.y = -followDistance;
 		offset.z = 0;
 
+		// ============================================
+		// ATTACK SLOT - spread riders on the same target around it
+		// Falls back to the fixed offset above if the ring is full
+		// ============================================
+		float slotX = 0.0f;
+		float slotY = 0.0f;
+		if (AttackSlots::ReserveSlot(horse, target, slotRing, slotRadius) &&
+			AttackSlots::GetSlotLocalOffset(horse->formID, slotX, slotY))
+		{
+			offset.x = slotX;
+			offset.y = slotY;
+		}
+
 		NiPoint3 offsetAngle;
 		offsetAngle.x = 0;
 		offsetAngle.y = 0;
 		offsetAngle.z = 0;
 
 		Actor_KeepOffsetFromActor(horse, targetHandle, offset, offsetAngle, catchUpRadius, followDistance);
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 
 		return true;
@@ -1326,6 +1378,8 @@ namespace MountedNPCCombatVR
 			return 0;
 		}
 		
+		TRACE_SCOPE_FORM("InjectTravelPackageToHorse", horse->formID);
+		
 		// ============================================
 		// CHECK IF RIDER IS FLEEING - SKIP ALL PROCESSING
 		// Fleeing riders are controlled by tactical flee system
@@ -1435,18 +1489,29 @@ namespace MountedNPCCombatVR
 		// - Mounted target: MeleeRangeMounted (300 default)
 		// ============================================
 		float meleeRange = MeleeRangeOnFoot;  // Default for player
+		bool targetIsMountedCheck = false;
 		
-		// Check if target is mounted
-		NiPointer<Actor> targetMount;
-		bool targetIsMountedCheck = CALL_MEMBER_FN(target, GetMount)(targetMount) && targetMount;
-		
-		// ============================================
-		// MOUNTED VS MOUNTED COMBAT DETECTION
-		// No verbose logging - just set melee range
-		// ============================================
-		if (targetIsMountedCheck)
+		// Target facts are shared by every rider chasing this target
+		const Pursuit::PursuitField* pursuit = Pursuit::GetPursuitField(target);
+		if (pursuit)
+		{
+			targetIsMountedCheck = pursuit->isMounted;
+			meleeRange = pursuit->meleeRange;
+		}
+		else
 		{
-			meleeRange = MeleeRangeMounted;
+			// Check if target is mounted
+			NiPointer<Actor> targetMount;
+			targetIsMountedCheck = CALL_MEMBER_FN(target, GetMount)(targetMount) && targetMount;
+			
+			// ============================================
+			// MOUNTED VS MOUNTED COMBAT DETECTION
+			// No verbose logging - just set melee range
+			// ============================================
+			if (targetIsMountedCheck)
+			{
+				meleeRange = MeleeRangeMounted;
+			}
 		}
 
 		// ============================================
@@ -1473,17 +1538,11 @@ namespace MountedNPCCombatVR
 			StopHorseSprint(horse);
 			
 			// Horse ROTATES to face target but stays stationary
-			float currentAngle = horse->rot.z;
-			float angleDiff = angleToTarget - currentAngle;
-			while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-			while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+			float angleDiff = Steering::HeadingDelta(angleToTarget, horse->rot.z);
 			
 			if (fabs(angleDiff) > 0.03f)  // Tighter threshold for smoother stop
 			{
-				float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);  // Use config value
-				while (newAngle > 3.14159f) newAngle -= 6.28318f;
-				while (newAngle < -3.14159f) newAngle += 6.28318f;
-				horse->rot.z = newAngle;
+				Steering::QueueHeading(horse, angleToTarget, HorseRotationSpeed);  // Use config value
 			}
 			
 			// Return 5 - horse stays stationery but rotates (rapid fire mode)
@@ -1522,7 +1581,7 @@ namespace MountedNPCCombatVR
 				{
 					// Rotation is locked - set horse to EXACT locked angle
 					float lockedAngle = GetStandGroundLockedAngle(horse->formID);
-					horse->rot.z = lockedAngle;  // Force exact angle every frame
+					Steering::SnapHeading(horse, lockedAngle);  // Force exact angle every frame
 					
 					// Trigger attacks based on current position
 					float horseRightX = cos(lockedAngle);
@@ -1572,9 +1631,7 @@ namespace MountedNPCCombatVR
 				targetAngle = GetStandGroundTarget90DegreeAngle(horse->formID, angleToTarget);
 				
 				float currentAngle = horse->rot.z;
-				float angleDiff = targetAngle - currentAngle;
-				while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-				while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+				float angleDiff = Steering::HeadingDelta(targetAngle, currentAngle);
 				
 				// Check if 90-degree turn is complete (within threshold)
 				const float TURN_COMPLETE_THRESHOLD = 0.15f;  // ~8.6 degrees
@@ -1587,10 +1644,7 @@ namespace MountedNPCCombatVR
 				}
 				
 				// Still turning - apply rotation toward target angle
-				float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);
-				while (newAngle > 3.14159f) newAngle -= 6.28318f;
-				while (newAngle < -3.14159f) newAngle += 6.28318f;
-				horse->rot.z = newAngle;
+				Steering::QueueHeading(horse, targetAngle, HorseRotationSpeed);
 				
 				// CRITICAL: Return immediately to skip ALL OTHER rotation code
 				return 7;  // Horse standing ground, still turning
@@ -1730,16 +1784,10 @@ namespace MountedNPCCombatVR
 			// FORCE 90-degree turn at breathing distance as failsafe
 			// This prevents the horse from walking into the target
 			float targetAngle90 = Get90DegreeTurnAngle(horse->formID, angleToTarget);
-			float currentAngle = horse->rot.z;
-			float angleDiff = targetAngle90 - currentAngle;
-			while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-			while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+			float angleDiff = Steering::HeadingDelta(targetAngle90, horse->rot.z);
 			
 			// Apply rotation toward 90-degree angle
-			float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);
-			while (newAngle > 3.14159f) newAngle -= 6.28318f;
-			while (newAngle < -3.14159f) newAngle += 6.28318f;
-			horse->rot.z = newAngle;
+			Steering::QueueHeading(horse, targetAngle90, HorseRotationSpeed);
 			
 			// Check if in attack position and trigger attack
 			bool targetIsPlayer = (g_thePlayer && (*g_thePlayer) && target == (*g_thePlayer));
@@ -1823,6 +1871,7 @@ namespace MountedNPCCombatVR
 				!IsHorseCharging(horse->formID))
 			{
 				ObstructionType obstruction = CheckAndLogHorseObstruction(horse, target, distanceToTarget);
+				CombatRecorder::NoteObstruction(horse->formID, (uint8_t)obstruction);
 				
 				if (obstruction == ObstructionType::Stationary ||
 					obstruction == ObstructionType::RunningInPlace || 
@@ -1835,8 +1884,15 @@ namespace MountedNPCCombatVR
 					// ============================================
 					if (IsObstructionCausedByNPC(horse, target))
 					{
-						// Obstruction is an NPC - skip jump/avoidance maneuvers
-						// The combat system will handle engaging or maneuvering around them
+						CombatRecorder::NoteInputFlags(horse->formID, CombatRecorder::RECORDER_INPUT_BLOCKED_BY_NPC);
+						
+						// Obstruction is an NPC - skip jump maneuvers
+						// Steer around them if the occupancy grid shows a clear lane
+						if (TrySteerAroundObstruction(horse, target))
+						{
+							CombatRecorder::NoteInputFlags(horse->formID, CombatRecorder::RECORDER_INPUT_STEERED);
+							return 1;  // Turning
+						}
 					}
 					else if (CheckAndLogSheerDrop(horse))
 					{
@@ -1851,9 +1907,16 @@ namespace MountedNPCCombatVR
 						
 						if (TryHorseJumpToEscape(horse))
 						{
+							CombatRecorder::NoteInputFlags(horse->formID, CombatRecorder::RECORDER_INPUT_JUMPED);
 							// Jump triggered - log only
 							_MESSAGE("DynamicPackages: Horse %08X jumped to escape obstruction", horse->formID);
 						}
+						else if (TrySteerAroundObstruction(horse, target))
+						{
+							// Jump on cooldown (or not possible) - turn toward a clear lane
+							CombatRecorder::NoteInputFlags(horse->formID, CombatRecorder::RECORDER_INPUT_STEERED);
+							return 1;  // Turning
+						}
 					}
 				}
 				
@@ -1925,75 +1988,59 @@ namespace MountedNPCCombatVR
 		bool targetIsMounted = targetIsMountedCheck;
 		
 		// ============================================
-		// CHARGE MANEUVER CHECK (700-1500 units away)
+		// CHARGE MANEUVER UPDATE
 		// ============================================
 
 		NiPointer<Actor> riderForCharge;
-		if (CALL_MEMBER_FN(horse, GetMountedBy)(riderForCharge) && riderForCharge)
+		bool hasRider = CALL_MEMBER_FN(horse, GetMountedBy)(riderForCharge) && riderForCharge;
+		
+		if (hasRider && IsHorseCharging(horse->formID))
 		{
-			if (IsHorseCharging(horse->formID))
+			if (UpdateChargeManeuver(horse, riderForCharge.get(), target, distanceToTarget, meleeRange))
 			{
-				if (UpdateChargeManeuver(horse, riderForCharge.get(), target, distanceToTarget, meleeRange))
-				{
-					targetAngle = angleToTarget;
-					
-					float currentAngle = horse->rot.z;
-					float angleDiff = targetAngle - currentAngle;
-					while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-					while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-					
-					float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);  // Use config value
-					horse->rot.z = newAngle;
-					
-					return 4;
-				}
+				targetAngle = angleToTarget;
+				
+				Steering::QueueHeading(horse, targetAngle, HorseRotationSpeed);  // Use config value
+				
+				return 4;
 			}
-			else if (distanceToTarget >= 700.0f && distanceToTarget <= 1500.0f)
+		}
+		
+		// ============================================
+		// SPECIAL MANEUVER ARBITRATION
+		// Rear up, charge, rapid fire, stand ground and player aggro
+		// switch are rolled together - at most one starts per tick
+		// (if already in rapid fire / stand ground we returned early above)
+		// ============================================
+		if (!IsHorseCharging(horse->formID))
+		{
+			ManeuverChoice maneuver = ArbitrateManeuvers(horse, hasRider ? riderForCharge.get() : nullptr, target, distanceToTarget, meleeRange);
+			
+			if (maneuver == ManeuverChoice::Charge || maneuver == ManeuverChoice::PlayerAggroSwitch)
 			{
-				if (TryChargeManeuver(horse, riderForCharge.get(), target, distanceToTarget))
-				{
-					targetAngle = angleToTarget;
-					
-					float currentAngle = horse->rot.z;
-					float angleDiff = targetAngle - currentAngle;
-					while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-					while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-					
-					float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);  // Use config value
-					horse->rot.z = newAngle;
-					
-					return 4;
-				}
+				// Charging (or just switched to the player) - return charging state
+				targetAngle = angleToTarget;
+				
+				Steering::QueueHeading(horse, targetAngle, HorseRotationSpeed);  // Use config value
+				
+				return 4;
 			}
 			
-			// ============================================
-			// RAPID FIRE MANEUVER CHECK
-			// ============================================
-			// Note: If already in rapid fire, we returned early above (line ~680)
-			// This is only for TRIGGERING new rapid fire
-			if (distanceToTarget > meleeRange && GetCombatElapsedTime() >= 20.0f)
+			if (maneuver == ManeuverChoice::RapidFire)
 			{
-				if (TryRapidFireManeuver(horse, riderForCharge.get(), target, distanceToTarget, meleeRange))
-				{
-					// Rapid fire just triggered - stop horse movement immediately
-					Actor_ClearKeepOffsetFromActor(horse);
-					ClearInjectedPackages(horse);
-		Actor_EvaluatePackage(horse, false, false);
+				// Rapid fire just triggered - stop horse movement immediately
+				Actor_ClearKeepOffsetFromActor(horse);
+				ClearInjectedPackages(horse);
+				PERF_COUNT(EvaluatePackageCalls);
+				Actor_EvaluatePackage(horse, false, false);
 
-					_MESSAGE("DynamicPackages: RAPID FIRE TRIGGERED - Horse %08X movement STOPPED (rotation continues)", horse->formID);
-					
-				 targetAngle = angleToTarget;
-					
-					float currentAngle = horse->rot.z;
-					float angleDiff = targetAngle - currentAngle;
-					while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-					while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-					
-					float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);  // Use config value
-					horse->rot.z = newAngle;
-					
-					return 5;
-				}
+				_MESSAGE("DynamicPackages: RAPID FIRE TRIGGERED - Horse %08X movement STOPPED (rotation continues)", horse->formID);
+				
+				targetAngle = angleToTarget;
+				
+				Steering::QueueHeading(horse, targetAngle, HorseRotationSpeed);  // Use config value
+				
+				return 5;
 			}
 		}
 		
@@ -2003,8 +2050,6 @@ namespace MountedNPCCombatVR
 		
 		if (distanceToTarget < meleeRange)
 		{
-		 TryRearUpOnApproach(horse, target, distanceToTarget);
-			
 			// ============================================
 			// CLOSE RANGE MELEE ASSAULT - EMERGENCY CLOSE COMBAT
 			// When target is within CloseRangeMeleeAssaultDistance (145 units),
@@ -2022,38 +2067,9 @@ namespace MountedNPCCombatVR
 				}
 			}
 			
-			// ============================================
-			// TRY STAND GROUND MANEUVER (vs non-player NPCs only)
-			// 25% chance when within 260 units of a mobile NPC target
-			// ============================================
+			// Stand ground and player aggro switch are rolled by the
+			// maneuver arbitration above
 			bool targetIsPlayer = (g_thePlayer && (*g_thePlayer) && target == (*g_thePlayer));
-			if (!targetIsPlayer && !IsInStandGround(horse->formID))
-			{
-				NiPointer<Actor> riderForStand;
-				if (CALL_MEMBER_FN(horse, GetMountedBy)(riderForStand) && riderForStand)
-				{
-					TryStandGroundManeuver(horse, riderForStand.get(), target, distanceToTarget);
-				}
-			}
-			
-			// ============================================
-			// TRY PLAYER AGGRO SWITCH (vs non-player NPCs only)
-		 // 15% chance every 20 seconds when player is within 1500 units
-			// Switches target to player and triggers a charge!
-			// ============================================
-			if (!targetIsPlayer && !IsHorseCharging(horse->formID) && !IsInRapidFire(horse->formID))
-			{
-				NiPointer<Actor> riderForAggro;
-				if (CALL_MEMBER_FN(horse, GetMountedBy)(riderForAggro) && riderForAggro)
-				{
-					if (TryPlayerAggroSwitch(horse, riderForAggro.get(), target))
-					{
-						// Successfully switched to player - charge maneuver started
-						// Return charging state
-						return 4;
-					}
-				}
-			}
 			
 			if (targetIsMounted)
 			{
@@ -2106,9 +2122,7 @@ namespace MountedNPCCombatVR
 				attackState = 1;
 				
 				float currentAngle = horse->rot.z;
-				float angleDiff = targetAngle - currentAngle;
-				while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-				while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+				float angleDiff = Steering::HeadingDelta(targetAngle, currentAngle);
 				
 				// Use config value for attack angle threshold (mounted vs mounted)
 				if (fabs(angleDiff) < AttackAngleMounted)
@@ -2154,9 +2168,7 @@ namespace MountedNPCCombatVR
 				attackState = 1;
 				
 				float currentAngle = horse->rot.z;
-				float angleDiff = targetAngle - currentAngle;
-				while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-				while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+				float angleDiff = Steering::HeadingDelta(targetAngle, currentAngle);
 				
 				// Use config value for attack angle threshold
 				// More lenient for NPCs (AttackAngleNPC) vs Player (AttackAnglePlayer)
@@ -2237,18 +2249,7 @@ namespace MountedNPCCombatVR
 		
 			}
 		
-		float currentAngle = horse->rot.z;
-		float angleDiff = targetAngle - currentAngle;
-		
-		while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-		while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-		
-		float newAngle = currentAngle + (angleDiff * HorseRotationSpeed);  // Use config value
-		
-		while (newAngle > 3.14159f) newAngle -= 6.28318f;
-		while (newAngle < -3.14159f) newAngle += 6.28318f;
-		
-		horse->rot.z = newAngle;
+		Steering::QueueHeading(horse, targetAngle, HorseRotationSpeed);  // Use config value
 		
 		// ============================================
 		// CREATE TRAVEL PACKAGE
@@ -2256,6 +2257,7 @@ namespace MountedNPCCombatVR
 
 		if (distanceToTarget >= meleeRange)
 		{
+			PERF_COUNT(PackageCreations);
 			TESPackage* package = CreatePackageByType(6);
 			if (package)
 			{
@@ -2372,6 +2374,7 @@ namespace MountedNPCCombatVR
 		const float NPC_OBSTRUCTION_RANGE = 300.0f;  // Check within 300 units
 		
 		// Check all actors in cell
+		PERF_COUNT(CellScans);
 		for (UInt32 i = 0; i < cell->objectList.count; i++)
 		{
 			TESObjectREFR* ref = nullptr;
@@ -2409,11 +2412,7 @@ namespace MountedNPCCombatVR
 				// Check if actor is in FRONT of the horse (the direction we're trying to go)
 				float horseAngle = horse->rot.z;
 				float angleToActor = atan2(dx, dy);
-				float angleDiff = angleToActor - horseAngle;
-				
-				// Normalize
-				while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-				while (angleDiff < -3.14159f) angleDiff += 6.28318f;
+				float angleDiff = Steering::HeadingDelta(angleToActor, horseAngle);
 				
 				// If actor is within ~90 degrees of where we're facing, they're likely blocking us
 				if (fabs(angleDiff) < 1.57f)  // 90 degrees
@@ -2428,5 +2427,44 @@ namespace MountedNPCCombatVR
 		
 		return false;
 	}
+	
+	// ============================================
+	// STEER AROUND OBSTRUCTION (OCCUPANCY GRID)
+	// ============================================
+	// Picks the nearest clear lane beside the horse's heading (the target's
+	// side first) and queues a turn toward its end. Returns false if the
+	// encounter has no grid or every lane is blocked.
+	
+	static bool TrySteerAroundObstruction(Actor* horse, Actor* target)
+	{
+		if (!horse) return false;
+		
+		float heading = horse->rot.z;
+		float rightX = cos(heading);
+		float rightY = -sin(heading);
+		
+		int preferredSign = 1;
+		if (target)
+		{
+			float dotRight = (target->pos.x - horse->pos.x) * rightX + (target->pos.y - horse->pos.y) * rightY;
+			preferredSign = (dotRight < 0.0f) ? -1 : 1;
+		}
+		
+		float lateral = 0.0f;
+		if (!Occupancy::FindClearLateralOffset(horse, heading, preferredSign, lateral))
+		{
+			return false;
+		}
+		
+		float laneX = horse->pos.x + sin(heading) * Occupancy::OCC_LOOKAHEAD + rightX * lateral;
+		float laneY = horse->pos.y + cos(heading) * Occupancy::OCC_LOOKAHEAD + rightY * lateral;
+		float laneAngle = atan2(laneX - horse->pos.x, laneY - horse->pos.y);
+		
+		Steering::QueueHeading(horse, laneAngle, HorseRotationSpeed);
+		
+		_MESSAGE("DynamicPackages: Horse %08X steering around obstruction (lane %.0f units %s)",
+			horse->formID, fabs(lateral), (lateral > 0.0f) ? "RIGHT" : "LEFT");
+		return true;
+	}
 }
 
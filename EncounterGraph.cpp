@@ -0,0 +1,315 @@
+#include "EncounterGraph.h"
+#include "MountedCombat.h"
+#include "CompanionCombat.h"
+#include "FactionData.h"
+#include "Profiler.h"
+#include "Helper.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
+
+namespace MountedNPCCombatVR
+{
+	namespace Encounters
+	{
+		// ============================================
+		// GRAPH STORAGE
+		// ============================================
+		// Nodes are actors (formIDs). g_parent/g_size form the union-find
+		// forest. After a build, g_nodeEncounter holds each node's
+		// encounter index and riders are listed per encounter in CSR
+		// layout: encounter e owns g_encounterRiders[g_encounterStart[e] ..
+		// g_encounterStart[e + 1]).
+		// ============================================
+
+		static UInt32 g_nodeFormID[ENCOUNTER_MAX_NODES];
+		static int g_parent[ENCOUNTER_MAX_NODES];
+		static int g_size[ENCOUNTER_MAX_NODES];
+		static int g_nodeEncounter[ENCOUNTER_MAX_NODES];
+		static int g_nodeCount = 0;
+
+		struct RiderNode
+		{
+			UInt32 formID;
+			Actor* actor;
+			int node;
+		};
+
+		static RiderNode g_riders[ENCOUNTER_MAX_RIDERS];
+		static int g_riderCount = 0;
+
+		static int g_encounterStart[ENCOUNTER_MAX_RIDERS + 1];
+		static UInt32 g_encounterRiders[ENCOUNTER_MAX_RIDERS];
+		static int g_encounterCount = 0;
+
+		static float g_lastBuildTime = -1000.0f;
+		static bool g_graphValid = false;
+		static bool g_loggedOverflow = false;
+
+		// ============================================
+		// UNION-FIND
+		// ============================================
+
+		static int FindRoot(int node)
+		{
+			while (g_parent[node] != node)
+			{
+				g_parent[node] = g_parent[g_parent[node]];  // Path halving
+				node = g_parent[node];
+			}
+			return node;
+		}
+
+		static void Union(int a, int b)
+		{
+			if (a < 0 || b < 0) return;
+
+			int rootA = FindRoot(a);
+			int rootB = FindRoot(b);
+			if (rootA == rootB) return;
+
+			// Union by size
+			if (g_size[rootA] < g_size[rootB])
+			{
+				int swap = rootA;
+				rootA = rootB;
+				rootB = swap;
+			}
+			g_parent[rootB] = rootA;
+			g_size[rootA] += g_size[rootB];
+		}
+
+		static int FindNode(UInt32 formID)
+		{
+			for (int i = 0; i < g_nodeCount; i++)
+			{
+				if (g_nodeFormID[i] == formID) return i;
+			}
+			return -1;
+		}
+
+		static int FindOrAddNode(UInt32 formID)
+		{
+			if (formID == 0) return -1;
+
+			int node = FindNode(formID);
+			if (node >= 0) return node;
+
+			if (g_nodeCount >= ENCOUNTER_MAX_NODES) return -1;
+
+			node = g_nodeCount++;
+			g_nodeFormID[node] = formID;
+			g_parent[node] = node;
+			g_size[node] = 1;
+			g_nodeEncounter[node] = -1;
+			return node;
+		}
+
+		// ============================================
+		// BUILD
+		// ============================================
+
+		static void AddRider(UInt32 riderFormID, UInt32 mountFormID, UInt32 targetFormID)
+		{
+			if (riderFormID == 0) return;
+
+			// Same NPC tracked twice (mounted NPC + companion tracker)
+			for (int i = 0; i < g_riderCount; i++)
+			{
+				if (g_riders[i].formID == riderFormID) return;
+			}
+
+			if (g_riderCount >= ENCOUNTER_MAX_RIDERS)
+			{
+				if (!g_loggedOverflow)
+				{
+					_MESSAGE("Encounters: More than %d riders - extra riders not partitioned", ENCOUNTER_MAX_RIDERS);
+					g_loggedOverflow = true;
+				}
+				return;
+			}
+
+			TESForm* form = CountedLookupFormByID(riderFormID);
+			if (!form || form->formType != kFormType_Character) return;
+
+			int riderNode = FindOrAddNode(riderFormID);
+			if (riderNode < 0) return;
+
+			RiderNode& rider = g_riders[g_riderCount++];
+			rider.formID = riderFormID;
+			rider.actor = static_cast<Actor*>(form);
+			rider.node = riderNode;
+
+			Union(riderNode, FindOrAddNode(mountFormID));
+			Union(riderNode, FindOrAddNode(targetFormID));
+		}
+
+		static void Rebuild()
+		{
+			PROFILE_SCOPE(EncounterRebuild);
+			TRACE_SCOPE("EncounterRebuild");
+
+			g_nodeCount = 0;
+			g_riderCount = 0;
+			g_encounterCount = 0;
+
+			for (int i = 0; i < MAX_TRACKED_NPCS; i++)
+			{
+				if (!g_riderColumns.valid[i]) continue;
+
+				AddRider(g_riderColumns.actorFormID[i], g_riderColumns.mountFormID[i], g_riderColumns.targetFormID[i]);
+			}
+
+			for (int i = 0; i < MAX_TRACKED_COMPANIONS; i++)
+			{
+				MountedCompanionData* data = GetCompanionDataByIndex(i);
+				if (!data || !data->isValid) continue;
+
+				AddRider(data->companionFormID, data->mountFormID, data->targetFormID);
+			}
+
+			// Ally proximity edges (riders only - a handful, pairwise is fine)
+			const float allyRadiusSq = ENCOUNTER_ALLY_RADIUS * ENCOUNTER_ALLY_RADIUS;
+
+			for (int i = 0; i < g_riderCount; i++)
+			{
+				for (int j = i + 1; j < g_riderCount; j++)
+				{
+					if (FindRoot(g_riders[i].node) == FindRoot(g_riders[j].node)) continue;
+
+					Actor* a = g_riders[i].actor;
+					Actor* b = g_riders[j].actor;
+
+					float dx = a->pos.x - b->pos.x;
+					float dy = a->pos.y - b->pos.y;
+					float dz = a->pos.z - b->pos.z;
+					if ((dx * dx + dy * dy + dz * dz) > allyRadiusSq) continue;
+
+					if (IsActorHostileToActor(a, b) || IsActorHostileToActor(b, a)) continue;
+
+					Union(g_riders[i].node, g_riders[j].node);
+				}
+			}
+
+			// Number the encounters (one per root that owns a rider)
+			for (int i = 0; i < g_riderCount; i++)
+			{
+				int root = FindRoot(g_riders[i].node);
+				if (g_nodeEncounter[root] < 0)
+				{
+					g_nodeEncounter[root] = g_encounterCount++;
+				}
+			}
+
+			for (int n = 0; n < g_nodeCount; n++)
+			{
+				g_nodeEncounter[n] = g_nodeEncounter[FindRoot(n)];
+			}
+
+			// Riders per encounter (counting sort)
+			for (int e = 0; e <= g_encounterCount; e++)
+			{
+				g_encounterStart[e] = 0;
+			}
+
+			for (int i = 0; i < g_riderCount; i++)
+			{
+				g_encounterStart[g_nodeEncounter[g_riders[i].node] + 1]++;
+			}
+
+			for (int e = 0; e < g_encounterCount; e++)
+			{
+				g_encounterStart[e + 1] += g_encounterStart[e];
+			}
+
+			int cursor[ENCOUNTER_MAX_RIDERS];
+			for (int e = 0; e < g_encounterCount; e++)
+			{
+				cursor[e] = g_encounterStart[e];
+			}
+
+			for (int i = 0; i < g_riderCount; i++)
+			{
+				int e = g_nodeEncounter[g_riders[i].node];
+				g_encounterRiders[cursor[e]++] = g_riders[i].formID;
+			}
+		}
+
+		static void EnsureFresh()
+		{
+			float now = GetGameTime();
+			if (g_graphValid && (now - g_lastBuildTime) < ENCOUNTER_MAX_AGE && now >= g_lastBuildTime)
+			{
+				return;
+			}
+
+			Rebuild();
+			g_lastBuildTime = now;
+			g_graphValid = true;
+		}
+
+		// ============================================
+		// QUERIES
+		// ============================================
+
+		void UpdateEncounters()
+		{
+			EnsureFresh();
+		}
+
+		int GetEncounterId(UInt32 formID)
+		{
+			if (formID == 0) return -1;
+
+			EnsureFresh();
+
+			int node = FindNode(formID);
+			return (node >= 0) ? g_nodeEncounter[node] : -1;
+		}
+
+		bool AreInSameEncounter(UInt32 formIDA, UInt32 formIDB)
+		{
+			if (formIDA == formIDB) return formIDA != 0;
+
+			int encounterA = GetEncounterId(formIDA);
+			if (encounterA < 0) return false;
+
+			return encounterA == GetEncounterId(formIDB);
+		}
+
+		int GetEncounterCount()
+		{
+			EnsureFresh();
+			return g_encounterCount;
+		}
+
+		int GetEncounterRiders(int encounterId, UInt32* outRiderFormIDs, int maxResults)
+		{
+			if (!outRiderFormIDs || maxResults <= 0) return 0;
+
+			EnsureFresh();
+			if (encounterId < 0 || encounterId >= g_encounterCount) return 0;
+
+			int count = 0;
+			for (int i = g_encounterStart[encounterId]; i < g_encounterStart[encounterId + 1] && count < maxResults; i++)
+			{
+				outRiderFormIDs[count++] = g_encounterRiders[i];
+			}
+			return count;
+		}
+
+		void InvalidateEncounters()
+		{
+			g_graphValid = false;
+		}
+
+		void ResetEncounters()
+		{
+			g_nodeCount = 0;
+			g_riderCount = 0;
+			g_encounterCount = 0;
+			g_graphValid = false;
+			g_lastBuildTime = -1000.0f;
+			g_loggedOverflow = false;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// ENCOUNTER GRAPH (independent battles)
+	// ============================================
+	// Every tracked rider used to be planned as one group: one shared
+	// ranged-role target, one global rear-up / rapid-fire cooldown and
+	// one tactical flee slot for the whole world. Two unrelated fights
+	// (a patrol fighting bandits on one side of the player, guards
+	// chasing the player on the other) throttled each other.
+	//
+	// The graph partitions actors into encounters with union-find:
+	// - rider -- mount          (same actor on the battlefield)
+	// - rider -- tracked target (rider->target edge)
+	// - rider -- rider          (within ENCOUNTER_ALLY_RADIUS and not
+	//                            hostile to each other: ally proximity)
+	//
+	// Riders come from the mounted NPC and companion trackers. Actors
+	// the trackers do not know about are not in any encounter.
+	//
+	// The graph is rebuilt lazily by the first query once it is older
+	// than ENCOUNTER_MAX_AGE, so all queries in a tick share one build.
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace Encounters
+	{
+		const int ENCOUNTER_MAX_RIDERS = 32;                         // Riders considered per build
+		const int ENCOUNTER_MAX_NODES = ENCOUNTER_MAX_RIDERS * 3;    // Rider + mount + target each
+		const float ENCOUNTER_ALLY_RADIUS = 2048.0f;                 // Allied riders closer than this share an encounter
+		const float ENCOUNTER_MAX_AGE = 0.1f;                        // Seconds before a query triggers a rebuild
+
+		// Rebuild now if the graph is stale (called once per tick from the rider loop)
+		void UpdateEncounters();
+
+		// Encounter index of a rider, mount or target (0 .. GetEncounterCount()-1),
+		// or -1 if the actor is not in any encounter. Indices are only
+		// stable until the next rebuild - do not store them across ticks.
+		int GetEncounterId(UInt32 formID);
+
+		// True if both actors are in the same encounter (or are the same actor)
+		bool AreInSameEncounter(UInt32 formIDA, UInt32 formIDB);
+
+		int GetEncounterCount();
+
+		// Rider formIDs in an encounter (mounts and targets are not listed).
+		// Returns the number written to outRiderFormIDs.
+		int GetEncounterRiders(int encounterId, UInt32* outRiderFormIDs, int maxResults);
+
+		// Force the next query to rebuild (rider registered/removed)
+		void InvalidateEncounters();
+
+		// Forget everything (mod deactivate / cell change)
+		void ResetEncounters();
+	}
+}
@@ -5,6 +5,8 @@
 #include "Helper.h"
 #include "config.h"
 #include "FactionData.h"
+#include "EncounterGraph.h"
+#include "PerfCounters.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include <cstdlib>
@@ -63,6 +65,9 @@ namespace MountedNPCCombatVR
 	const float FLEE_MIN_DURATION = 4.0f;
 	const float FLEE_MAX_DURATION = 10.0f;
 	
+	// One flee slot per encounter - this only bounds concurrent battles
+	const int MAX_TACTICAL_FLEEING_RIDERS = 5;
+	
 	// ============================================
 	// FLEE STATE TRACKING
 	// ============================================
@@ -91,7 +96,7 @@ namespace MountedNPCCombatVR
 		}
 	};
 	
-	static TacticalFleeData g_currentFleeingRider;
+	static TacticalFleeData g_fleeingRiders[MAX_TACTICAL_FLEEING_RIDERS];
 	static bool g_fleeSystemInitialized = false;
 	static bool g_randomSeeded = false;
 	
@@ -163,6 +168,42 @@ namespace MountedNPCCombatVR
 		return true;
 	}
 	
+	// ============================================
+	// FLEE SLOTS
+	// ============================================
+	
+	static TacticalFleeData* FindFleeSlot(UInt32 riderFormID)
+	{
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			if (g_fleeingRiders[i].isFleeing && g_fleeingRiders[i].riderFormID == riderFormID)
+			{
+				return &g_fleeingRiders[i];
+			}
+		}
+		return nullptr;
+	}
+	
+	static TacticalFleeData* FindFreeFleeSlot()
+	{
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			if (!g_fleeingRiders[i].isFleeing)
+			{
+				return &g_fleeingRiders[i];
+			}
+		}
+		return nullptr;
+	}
+	
+	static void ResetAllFleeSlots()
+	{
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			g_fleeingRiders[i].Reset();
+		}
+	}
+	
 	// ============================================
 	// INITIALIZATION
 	// ============================================
@@ -172,7 +213,7 @@ namespace MountedNPCCombatVR
 		if (g_fleeSystemInitialized) return;
 		
 		_MESSAGE("TacticalFlee: Initializing tactical flee system...");
-		g_currentFleeingRider.Reset();
+		ResetAllFleeSlots();
 		g_fleeSystemInitialized = true;
 		_MESSAGE("TacticalFlee: System initialized");
 	}
@@ -183,12 +224,15 @@ namespace MountedNPCCombatVR
 		
 		_MESSAGE("TacticalFlee: Shutting down...");
 		
-		if (g_currentFleeingRider.isFleeing)
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
 		{
-			StopTacticalFlee(g_currentFleeingRider.riderFormID);
+			if (g_fleeingRiders[i].isFleeing)
+			{
+				StopTacticalFlee(g_fleeingRiders[i].riderFormID);
+			}
 		}
 		
-		g_currentFleeingRider.Reset();
+		ResetAllFleeSlots();
 		g_fleeSystemInitialized = false;
 	}
 	
@@ -202,7 +246,7 @@ namespace MountedNPCCombatVR
 		// Just clear the tracking data - let game handle actual actor cleanup
 		// ============================================
 		
-		g_currentFleeingRider.Reset();
+		ResetAllFleeSlots();
 		_MESSAGE("TacticalFlee: State reset complete");
 	}
 	
@@ -214,7 +258,14 @@ namespace MountedNPCCombatVR
 	{
 		if (!rider || !horse || !target) return false;
 		
-		if (g_currentFleeingRider.isFleeing)
+		// Only one rider per encounter can flee at a time
+		if (IsAnyRiderFleeingInEncounter(rider->formID))
+		{
+			return false;
+		}
+		
+		TacticalFleeData* flee = FindFreeFleeSlot();
+		if (!flee)
 		{
 			return false;
 		}
@@ -236,6 +287,7 @@ namespace MountedNPCCombatVR
 		
 		SetWeaponDrawn(rider, false);
 		
+		PERF_COUNT(PackageCreations);
 		TESPackage* fleePackage = CreatePackageByType(TESPackage::kPackageType_Flee);
 		if (fleePackage)
 		{
@@ -286,6 +338,7 @@ namespace MountedNPCCombatVR
 				if (targetHandle != 0 && targetHandle != *g_invalidRefHandle)
 				{
 					Actor_KeepOffsetFromActor(horse, targetHandle, offset, offsetAngle, 2000.0f, 500.0f);
+					PERF_COUNT(EvaluatePackageCalls);
 					Actor_EvaluatePackage(horse, false, false);
 				}
 			}
@@ -293,14 +346,14 @@ namespace MountedNPCCombatVR
 			StartHorseSprint(horse);
 		}
 		
-		g_currentFleeingRider.riderFormID = rider->formID;
-		g_currentFleeingRider.horseFormID = horse->formID;
-		g_currentFleeingRider.targetFormID = target->formID;
-		g_currentFleeingRider.fleeStartTime = GetGameTime();
-		g_currentFleeingRider.fleeDuration = fleeDuration;
-		g_currentFleeingRider.lastFleeCheckTime = GetGameTime();
-		g_currentFleeingRider.isFleeing = true;
-		g_currentFleeingRider.isValid = true;
+		flee->riderFormID = rider->formID;
+		flee->horseFormID = horse->formID;
+		flee->targetFormID = target->formID;
+		flee->fleeStartTime = GetGameTime();
+		flee->fleeDuration = fleeDuration;
+		flee->lastFleeCheckTime = GetGameTime();
+		flee->isFleeing = true;
+		flee->isValid = true;
 		
 		return true;
 	}
@@ -311,16 +364,16 @@ namespace MountedNPCCombatVR
 	
 	void StopTacticalFlee(UInt32 riderFormID)
 	{
-		if (!g_currentFleeingRider.isFleeing) return;
-		if (g_currentFleeingRider.riderFormID != riderFormID) return;
+		TacticalFleeData* flee = FindFleeSlot(riderFormID);
+		if (!flee) return;
 		
-		TESForm* riderForm = LookupFormByID(g_currentFleeingRider.riderFormID);
-		TESForm* horseForm = LookupFormByID(g_currentFleeingRider.horseFormID);
-		TESForm* targetForm = LookupFormByID(g_currentFleeingRider.targetFormID);
+		TESForm* riderForm = CountedLookupFormByID(flee->riderFormID);
+		TESForm* horseForm = CountedLookupFormByID(flee->horseFormID);
+		TESForm* targetForm = CountedLookupFormByID(flee->targetFormID);
 		
 		if (!riderForm || !horseForm)
 		{
-			g_currentFleeingRider.Reset();
+			flee->Reset();
 			return;
 		}
 		
@@ -330,12 +383,12 @@ namespace MountedNPCCombatVR
 		
 		if (!rider || !horse)
 		{
-			g_currentFleeingRider.Reset();
+			flee->Reset();
 			return;
 		}
 		
 		const char* riderName = CALL_MEMBER_FN(rider, GetReferenceName)();
-		float fleeTime = GetGameTime() - g_currentFleeingRider.fleeStartTime;
+		float fleeTime = GetGameTime() - flee->fleeStartTime;
 		
 		_MESSAGE("TacticalFlee: ========================================");
 		_MESSAGE("TacticalFlee: '%s' (%08X) ENDING TACTICAL RETREAT",
@@ -348,7 +401,9 @@ namespace MountedNPCCombatVR
 		Actor_ClearKeepOffsetFromActor(horse);
 		ClearInjectedPackages(horse);
 		
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(rider, false, false);
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
 		if (target && !target->IsDead(1))
@@ -374,7 +429,7 @@ namespace MountedNPCCombatVR
 			_MESSAGE("TacticalFlee: No valid target to re-engage");
 		}
 		
-		g_currentFleeingRider.Reset();
+		flee->Reset();
 	}
 	
 	// ============================================
@@ -386,7 +441,7 @@ namespace MountedNPCCombatVR
 		if (!g_fleeSystemInitialized) return false;
 		if (!rider || !horse || !target) return false;
 		
-		if (g_currentFleeingRider.isFleeing) return false;
+		if (IsAnyRiderFleeingInEncounter(rider->formID)) return false;
 		
 		if (!IsEligibleForFlee(rider, horse)) return false;
 		
@@ -421,27 +476,26 @@ namespace MountedNPCCombatVR
 	// UPDATE TACTICAL FLEE - Call every frame
 	// ============================================
 	
-	void UpdateTacticalFlee()
+	static void UpdateFleeSlot(TacticalFleeData& flee)
 	{
-		if (!g_fleeSystemInitialized) return;
-		if (!g_currentFleeingRider.isFleeing) return;
+		if (!flee.isFleeing) return;
 		
 		float currentTime = GetGameTime();
-		float elapsedTime = currentTime - g_currentFleeingRider.fleeStartTime;
+		float elapsedTime = currentTime - flee.fleeStartTime;
 		
-		if (elapsedTime >= g_currentFleeingRider.fleeDuration)
+		if (elapsedTime >= flee.fleeDuration)
 		{
-			StopTacticalFlee(g_currentFleeingRider.riderFormID);
+			StopTacticalFlee(flee.riderFormID);
 			return;
 		}
 		
-		TESForm* riderForm = LookupFormByID(g_currentFleeingRider.riderFormID);
-		TESForm* horseForm = LookupFormByID(g_currentFleeingRider.horseFormID);
+		TESForm* riderForm = CountedLookupFormByID(flee.riderFormID);
+		TESForm* horseForm = CountedLookupFormByID(flee.horseFormID);
 		
 		if (!riderForm || !horseForm)
 		{
 			_MESSAGE("TacticalFlee: Rider or horse form invalid - stopping flee");
-			g_currentFleeingRider.Reset();
+			flee.Reset();
 			return;
 		}
 		
@@ -451,14 +505,14 @@ namespace MountedNPCCombatVR
 		if (!rider || !horse)
 		{
 			_MESSAGE("TacticalFlee: Rider or horse cast failed - stopping flee");
-			g_currentFleeingRider.Reset();
+			flee.Reset();
 			return;
 		}
 		
 		if (rider->IsDead(1))
 		{
 			_MESSAGE("TacticalFlee: Rider died during flee - stopping");
-			g_currentFleeingRider.Reset();
+			flee.Reset();
 			return;
 		}
 		
@@ -466,7 +520,7 @@ namespace MountedNPCCombatVR
 		if (!CALL_MEMBER_FN(rider, GetMount)(currentMount) || !currentMount)
 		{
 			_MESSAGE("TacticalFlee: Rider dismounted during flee - stopping");
-			g_currentFleeingRider.Reset();
+			flee.Reset();
 			return;
 		}
 		
@@ -476,7 +530,17 @@ namespace MountedNPCCombatVR
 			s_lastProgressLog = currentTime;
 			const char* riderName = CALL_MEMBER_FN(rider, GetReferenceName)();
 			_MESSAGE("TacticalFlee: '%s' fleeing - %.1f / %.1f seconds",
-				riderName ? riderName : "Unknown", elapsedTime, g_currentFleeingRider.fleeDuration);
+				riderName ? riderName : "Unknown", elapsedTime, flee.fleeDuration);
+		}
+	}
+	
+	void UpdateTacticalFlee()
+	{
+		if (!g_fleeSystemInitialized) return;
+		
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			UpdateFleeSlot(g_fleeingRiders[i]);
 		}
 	}
 	
@@ -486,36 +550,60 @@ namespace MountedNPCCombatVR
 	
 	bool IsRiderFleeing(UInt32 riderFormID)
 	{
-		return g_currentFleeingRider.isFleeing && 
-		       g_currentFleeingRider.riderFormID == riderFormID;
+		return FindFleeSlot(riderFormID) != nullptr;
 	}
 	
 	bool IsAnyRiderFleeing()
 	{
-		return g_currentFleeingRider.isFleeing;
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			if (g_fleeingRiders[i].isFleeing) return true;
+		}
+		return false;
+	}
+	
+	bool IsAnyRiderFleeingInEncounter(UInt32 riderFormID)
+	{
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			if (!g_fleeingRiders[i].isFleeing) continue;
+			
+			if (Encounters::AreInSameEncounter(g_fleeingRiders[i].riderFormID, riderFormID))
+			{
+				return true;
+			}
+		}
+		return false;
 	}
 	
 	UInt32 GetFleeingRiderFormID()
 	{
-		return g_currentFleeingRider.isFleeing ? g_currentFleeingRider.riderFormID : 0;
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
+		{
+			if (g_fleeingRiders[i].isFleeing) return g_fleeingRiders[i].riderFormID;
+		}
+		return 0;
 	}
 	
 	float GetFleeTimeRemaining(UInt32 riderFormID)
 	{
-		if (!g_currentFleeingRider.isFleeing) return 0;
-		if (g_currentFleeingRider.riderFormID != riderFormID) return 0;
+		TacticalFleeData* flee = FindFleeSlot(riderFormID);
+		if (!flee) return 0;
 		
-		float elapsed = GetGameTime() - g_currentFleeingRider.fleeStartTime;
-		float remaining = g_currentFleeingRider.fleeDuration - elapsed;
+		float elapsed = GetGameTime() - flee->fleeStartTime;
+		float remaining = flee->fleeDuration - elapsed;
 		return (remaining > 0) ? remaining : 0;
 	}
 	
 	bool IsHorseRiderFleeing(UInt32 horseFormID)
 	{
 		// Check tactical flee
-		if (g_currentFleeingRider.isFleeing && g_currentFleeingRider.horseFormID == horseFormID)
+		for (int i = 0; i < MAX_TACTICAL_FLEEING_RIDERS; i++)
 		{
-			return true;
+			if (g_fleeingRiders[i].isFleeing && g_fleeingRiders[i].horseFormID == horseFormID)
+			{
+				return true;
+			}
 		}
 		
 		// Check civilian flee
@@ -633,6 +721,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Create and inject flee package targeting the threat
+		PERF_COUNT(PackageCreations);
 		TESPackage* fleePackage = CreatePackageByType(TESPackage::kPackageType_Flee);
 		if (fleePackage)
 		{
@@ -692,8 +781,8 @@ namespace MountedNPCCombatVR
 		
 		if (!data || !data->isFleeing) return;
 		
-		TESForm* riderForm = LookupFormByID(data->riderFormID);
-		TESForm* horseForm = LookupFormByID(data->horseFormID);
+		TESForm* riderForm = CountedLookupFormByID(data->riderFormID);
+		TESForm* horseForm = CountedLookupFormByID(data->horseFormID);
 		
 		if (!riderForm || !horseForm)
 		{
@@ -739,7 +828,9 @@ namespace MountedNPCCombatVR
 			horse->flags2 &= ~Actor::kFlag_kAttackOnSight;
 			
 			// Force AI re-evaluation to return to default behavior
+			PERF_COUNT(EvaluatePackageCalls);
 			Actor_EvaluatePackage(rider, false, false);
+			PERF_COUNT(EvaluatePackageCalls);
 			Actor_EvaluatePackage(horse, false, false);
 			
 			_MESSAGE("CivilianFlee: '%s' AI reset to default behavior", riderName ? riderName : "Civilian");
@@ -767,9 +858,9 @@ namespace MountedNPCCombatVR
 			data->lastCheckTime = currentTime;
 			
 			// Lookup actors
-			TESForm* riderForm = LookupFormByID(data->riderFormID);
-			TESForm* horseForm = LookupFormByID(data->horseFormID);
-			TESForm* threatForm = LookupFormByID(data->threatFormID);
+			TESForm* riderForm = CountedLookupFormByID(data->riderFormID);
+			TESForm* horseForm = CountedLookupFormByID(data->horseFormID);
+			TESForm* threatForm = CountedLookupFormByID(data->threatFormID);
 			
 			if (!riderForm || !horseForm)
 			{
@@ -12,7 +12,8 @@ namespace MountedNPCCombatVR
 	// when below 30% health.
 	// 
 	// Flee lasts 4-10 seconds (randomized), then they return to combat.
-	// Only ONE rider can flee at a time to prevent mass retreats.
+	// Only ONE rider per encounter (EncounterGraph.h) can flee at a time
+	// to prevent mass retreats; unrelated battles do not block each other.
 	// ============================================
 	
 	// Initialize tactical flee system
@@ -25,7 +26,7 @@ namespace MountedNPCCombatVR
 	void ResetTacticalFlee();
 	
 	// Start tactical flee for a rider
-	// Returns true if flee was started, false if not eligible or another rider is fleeing
+	// Returns true if flee was started, false if not eligible or another rider in the encounter is fleeing
 	bool StartTacticalFlee(Actor* rider, Actor* horse, Actor* target);
 	
 	// Stop tactical flee and return to combat
@@ -41,6 +42,7 @@ namespace MountedNPCCombatVR
 	// Query functions
 	bool IsRiderFleeing(UInt32 riderFormID);
 	bool IsAnyRiderFleeing();
+	bool IsAnyRiderFleeingInEncounter(UInt32 riderFormID);  // Flee limit check
 	UInt32 GetFleeingRiderFormID();
 	float GetFleeTimeRemaining(UInt32 riderFormID);
 	
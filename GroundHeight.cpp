@@ -0,0 +1,285 @@
+#include "GroundHeight.h"
+#include "Helper.h"
+#include "config.h"
+#include <cmath>
+#include <cstring>
+
+namespace MountedNPCCombatVR
+{
+	namespace GroundHeight
+	{
+		// ============================================
+		// ENGINE LAYOUT (SE TESObjectCELL / TESObjectLAND)
+		// ============================================
+		// Not exposed by the SKSE64 VR headers. Only read inside
+		// ReadLoadedLand (SEH-guarded) and cross-checked by CalibrateAt.
+
+		const UInt32 CELL_OFFSET_EXTERIOR_DATA = 0x60;    // EXTERIOR_DATA* { SInt32 cellX, cellY, ... }
+		const UInt32 CELL_OFFSET_LAND = 0x68;             // TESObjectLAND*
+		const UInt32 LAND_OFFSET_PARENT_CELL = 0x30;      // TESObjectCELL* (back pointer)
+		const UInt32 LAND_OFFSET_LOADED_DATA = 0x40;      // LoadedLandData* (null until the land is loaded)
+		const UInt32 LOADED_LAND_OFFSET_HEIGHTS = 0x30;   // float[4][17 * 17] quadrant heights
+
+		const float LAND_MAX_ABS_HEIGHT = 100000.0f;       // Anything beyond this is not terrain
+
+		struct HeightTile
+		{
+			UInt32 worldSpaceFormID;
+			int cellX;
+			int cellY;
+			bool hasLand;          // False = cell read but had no usable land
+			float retryTime;       // hasLand == false: time to try again
+			UInt32 lastUseTick;
+			float heights[LAND_GRID_DIM * LAND_GRID_DIM];
+			bool isValid;
+		};
+
+		static HeightTile g_tiles[GROUND_MAX_TILES];
+		static UInt32 g_useTick = 0;
+		static int g_matchCount = 0;
+		static int g_mismatchCount = 0;
+		static bool g_engineSamplingDisabled = false;
+
+		// ============================================
+		// TILE CACHE
+		// ============================================
+
+		static HeightTile* FindTile(UInt32 worldSpaceFormID, int cellX, int cellY)
+		{
+			for (int i = 0; i < GROUND_MAX_TILES; i++)
+			{
+				HeightTile* tile = &g_tiles[i];
+				if (tile->isValid && tile->worldSpaceFormID == worldSpaceFormID &&
+					tile->cellX == cellX && tile->cellY == cellY)
+				{
+					return tile;
+				}
+			}
+			return nullptr;
+		}
+
+		// Existing tile for the cell, else a free slot, else the least recently used
+		static HeightTile* ClaimTile(UInt32 worldSpaceFormID, int cellX, int cellY)
+		{
+			HeightTile* tile = FindTile(worldSpaceFormID, cellX, cellY);
+			if (tile) return tile;
+
+			HeightTile* oldest = &g_tiles[0];
+			for (int i = 0; i < GROUND_MAX_TILES; i++)
+			{
+				if (!g_tiles[i].isValid) return &g_tiles[i];
+				if (g_tiles[i].lastUseTick < oldest->lastUseTick) oldest = &g_tiles[i];
+			}
+			return oldest;
+		}
+
+		void StoreTile(UInt32 worldSpaceFormID, int cellX, int cellY, const float* heights)
+		{
+			HeightTile* tile = ClaimTile(worldSpaceFormID, cellX, cellY);
+
+			tile->worldSpaceFormID = worldSpaceFormID;
+			tile->cellX = cellX;
+			tile->cellY = cellY;
+			tile->hasLand = true;
+			tile->retryTime = 0.0f;
+			tile->lastUseTick = ++g_useTick;
+			memcpy(tile->heights, heights, sizeof(tile->heights));
+			tile->isValid = true;
+		}
+
+		bool GetGroundHeight(UInt32 worldSpaceFormID, float x, float y, float& outZ)
+		{
+			int cellX = WorldToCell(x);
+			int cellY = WorldToCell(y);
+
+			HeightTile* tile = FindTile(worldSpaceFormID, cellX, cellY);
+			if (!tile || !tile->hasLand) return false;
+
+			tile->lastUseTick = ++g_useTick;
+			outZ = SampleTileBilinear(tile->heights,
+				x - (float)cellX * LAND_CELL_SIZE,
+				y - (float)cellY * LAND_CELL_SIZE);
+			return true;
+		}
+
+		// ============================================
+		// ENGINE READ
+		// ============================================
+
+		static bool IsPlausibleHeight(float h)
+		{
+			// NaN fails both compares
+			return h > -LAND_MAX_ABS_HEIGHT && h < LAND_MAX_ABS_HEIGHT;
+		}
+
+		// Cell grid coordinates of an exterior cell
+		static bool ReadExteriorCoords(TESObjectCELL* cell, int& outCellX, int& outCellY)
+		{
+			__try
+			{
+				UInt8* cellBytes = reinterpret_cast<UInt8*>(cell);
+				SInt32* exterior = *reinterpret_cast<SInt32**>(cellBytes + CELL_OFFSET_EXTERIOR_DATA);
+				if (!exterior) return false;
+
+				outCellX = exterior[0];
+				outCellY = exterior[1];
+				return true;
+			}
+			__except (EXCEPTION_EXECUTE_HANDLER)
+			{
+				return false;
+			}
+		}
+
+		// Copy the loaded quadrant heights of an exterior cell.
+		// Returns false if the land is not loaded or anything looks off.
+		static bool ReadLoadedLand(TESObjectCELL* cell, float* outQuadrants)
+		{
+			__try
+			{
+				UInt8* cellBytes = reinterpret_cast<UInt8*>(cell);
+				TESForm* land = *reinterpret_cast<TESForm**>(cellBytes + CELL_OFFSET_LAND);
+				if (!land || land->formType != kFormType_Land) return false;
+
+				UInt8* landBytes = reinterpret_cast<UInt8*>(land);
+				if (*reinterpret_cast<TESObjectCELL**>(landBytes + LAND_OFFSET_PARENT_CELL) != cell) return false;
+
+				UInt8* loaded = *reinterpret_cast<UInt8**>(landBytes + LAND_OFFSET_LOADED_DATA);
+				if (!loaded) return false;
+
+				const float* heights = reinterpret_cast<const float*>(loaded + LOADED_LAND_OFFSET_HEIGHTS);
+				for (int i = 0; i < 4 * LAND_QUADRANT_VERTS; i++)
+				{
+					if (!IsPlausibleHeight(heights[i])) return false;
+					outQuadrants[i] = heights[i];
+				}
+				return true;
+			}
+			__except (EXCEPTION_EXECUTE_HANDLER)
+			{
+				return false;
+			}
+		}
+
+		UInt32 GetCellWorldSpaceID(TESObjectCELL* cell)
+		{
+			if (!cell) return 0;
+			TESWorldSpace* worldspace = cell->unk120;
+			return worldspace ? worldspace->formID : 0;
+		}
+
+		bool CacheCellHeights(TESObjectCELL* cell)
+		{
+			if (!TerrainHeightSampling || g_engineSamplingDisabled) return false;
+
+			static bool s_announced = false;
+			if (!s_announced)
+			{
+				s_announced = true;
+				_MESSAGE("GroundHeight: TerrainHeightSampling is experimental (SE land offsets, unverified on VR) - waiting for calibration");
+			}
+
+			UInt32 worldSpaceFormID = GetCellWorldSpaceID(cell);
+			if (worldSpaceFormID == 0) return false;  // Interior - no land
+
+			int cellX = 0;
+			int cellY = 0;
+			if (!ReadExteriorCoords(cell, cellX, cellY)) return false;
+
+			// Cached (or read recently and found no land)
+			float now = GetGameTime();
+			HeightTile* tile = FindTile(worldSpaceFormID, cellX, cellY);
+			if (tile)
+			{
+				tile->lastUseTick = ++g_useTick;
+				if (tile->hasLand) return true;
+				if (now < tile->retryTime) return false;
+			}
+
+			static float s_quadrants[4 * LAND_QUADRANT_VERTS];
+			static float s_heights[LAND_GRID_DIM * LAND_GRID_DIM];
+
+			if (!ReadLoadedLand(cell, s_quadrants))
+			{
+				tile = ClaimTile(worldSpaceFormID, cellX, cellY);
+				tile->worldSpaceFormID = worldSpaceFormID;
+				tile->cellX = cellX;
+				tile->cellY = cellY;
+				tile->hasLand = false;
+				tile->retryTime = now + GROUND_RETRY_INTERVAL;
+				tile->lastUseTick = ++g_useTick;
+				tile->isValid = true;
+				return false;
+			}
+
+			StitchQuadrantHeights(s_quadrants, s_heights);
+			StoreTile(worldSpaceFormID, cellX, cellY, s_heights);
+			return true;
+		}
+
+		bool CalibrateAt(UInt32 worldSpaceFormID, float x, float y, float actualZ)
+		{
+			float groundZ = 0.0f;
+			if (!GetGroundHeight(worldSpaceFormID, x, y, groundZ)) return false;
+
+			if (fabsf(groundZ - actualZ) <= GROUND_CALIBRATION_TOLERANCE)
+			{
+				g_matchCount++;
+				if (g_matchCount == GROUND_VERIFIED_MATCHES)
+				{
+					_MESSAGE("GroundHeight: terrain heights verified against %d grounded horses (%d mismatches first)",
+						g_matchCount, g_mismatchCount);
+				}
+				return true;
+			}
+
+			if (g_matchCount >= GROUND_VERIFIED_MATCHES) return false;
+
+			g_mismatchCount++;
+			if (g_mismatchCount >= GROUND_MAX_MISMATCHES && !g_engineSamplingDisabled)
+			{
+				g_engineSamplingDisabled = true;
+				_MESSAGE("GroundHeight: terrain heights disagree with grounded horses (%d checks, last %.0f vs %.0f) - terrain sampling disabled",
+					g_mismatchCount, groundZ, actualZ);
+
+				for (int i = 0; i < GROUND_MAX_TILES; i++)
+				{
+					g_tiles[i].isValid = false;
+				}
+			}
+			return false;
+		}
+
+		bool IsEngineSamplingActive()
+		{
+			return TerrainHeightSampling && !g_engineSamplingDisabled;
+		}
+
+		bool IsEngineSamplingVerified()
+		{
+			return IsEngineSamplingActive() && g_matchCount >= GROUND_VERIFIED_MATCHES;
+		}
+
+		int GetCachedTileCount()
+		{
+			int count = 0;
+			for (int i = 0; i < GROUND_MAX_TILES; i++)
+			{
+				if (g_tiles[i].isValid && g_tiles[i].hasLand) count++;
+			}
+			return count;
+		}
+
+		void ResetGroundHeight()
+		{
+			for (int i = 0; i < GROUND_MAX_TILES; i++)
+			{
+				g_tiles[i].isValid = false;
+			}
+			g_useTick = 0;
+			g_matchCount = 0;
+			g_mismatchCount = 0;
+			g_engineSamplingDisabled = false;
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// GROUND HEIGHT (cached terrain heightfield)
+	// ============================================
+	// Sheer-drop detection sampled "ground" at each probe with a stub
+	// that returned the probe's own Z, so the drop was always 0 and
+	// horses were never warned off cliff edges.
+	//
+	// This service copies the loaded land heights of an exterior cell
+	// into a tile (33 x 33 vertices, 128 units apart, one tile per
+	// 4096-unit cell) the first time the cell is seen. After that a
+	// height lookup is a tile search plus a bilinear blend of four
+	// vertices - the 5 probes per horse per check cost a few reads.
+	//
+	// The engine stores loaded land as four 17 x 17 quadrants (one per
+	// quadrant mesh, sharing their edge rows). StitchQuadrantHeights
+	// turns them into the 33 x 33 tile; it and the tile cache are plain
+	// C++ and do not touch the engine.
+	//
+	// The land data is read through SE offsets that are not exposed by
+	// SKSE64 VR, so every read is SEH-guarded and the tiles are checked
+	// against grounded horses (CalibrateAt). If the heights keep
+	// disagreeing with where horses actually stand, engine sampling
+	// turns itself off and callers fall back to "no terrain data".
+	// Interior cells have no land and always report no data.
+	//
+	// EXPERIMENTAL, OFF BY DEFAULT (TerrainHeightSampling = 0). The
+	// offsets above have not been verified against the VR runtime, so a
+	// default install never reads land: CacheCellHeights returns false,
+	// sheer-drop probes see no drop from terrain, and only edges already
+	// in the hazard map are found. Turning it on logs whether the
+	// calibration verified the data or disabled sampling.
+	//
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace GroundHeight
+	{
+		const int LAND_GRID_DIM = 33;                  // Vertices per tile edge
+		const int LAND_QUADRANT_DIM = 17;              // Vertices per quadrant edge
+		const int LAND_QUADRANT_VERTS = LAND_QUADRANT_DIM * LAND_QUADRANT_DIM;
+		const float LAND_CELL_SIZE = 4096.0f;          // Units per cell edge
+		const float LAND_VERTEX_SPACING = 128.0f;      // Units between vertices
+		const int GROUND_MAX_TILES = 16;               // Cached cells (LRU)
+		const float GROUND_RETRY_INTERVAL = 5.0f;      // Seconds before re-reading a cell with no land
+		const float GROUND_CALIBRATION_TOLERANCE = 160.0f;  // Max |tile height - grounded horse Z|
+		const int GROUND_VERIFIED_MATCHES = 4;         // Agreements that prove the land data is read correctly
+		const int GROUND_MAX_MISMATCHES = 12;          // Disagreements (before verified) that turn engine sampling off
+
+		// ============================================
+		// HEIGHTFIELD HELPERS (engine independent, GroundHeightMath.cpp)
+		// ============================================
+
+		// quadrants[q][row * 17 + col], q = 0 SW, 1 SE, 2 NW, 3 NE
+		// out[row * 33 + col], row 0 = south edge, col 0 = west edge
+		void StitchQuadrantHeights(const float* quadrants, float* outHeights);
+
+		// Bilinear height at a cell-local position (0..LAND_CELL_SIZE, clamped)
+		float SampleTileBilinear(const float* heights, float localX, float localY);
+
+		// Cell coordinate containing a world coordinate
+		int WorldToCell(float worldCoord);
+
+		// ============================================
+		// TILE CACHE
+		// ============================================
+
+		// Copy a 33 x 33 heightfield into the cache (replaces an existing tile)
+		void StoreTile(UInt32 worldSpaceFormID, int cellX, int cellY, const float* heights);
+
+		// Ground height at (x, y) from cached tiles only. False if no tile covers it.
+		bool GetGroundHeight(UInt32 worldSpaceFormID, float x, float y, float& outZ);
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Make sure the cell's land is cached (no-op for interiors, cached
+		// cells, cells retried recently, or when engine sampling is off).
+		// Returns true if the cell has a tile.
+		bool CacheCellHeights(TESObjectCELL* cell);
+
+		// World space FormID used as the cache key (0 for interiors)
+		UInt32 GetCellWorldSpaceID(TESObjectCELL* cell);
+
+		// Compare the tile height under a grounded actor with its Z.
+		// Returns true if they agree. Disagreement is normal on bridges
+		// and mid-jump, so it only disables engine sampling (for the
+		// session) if it keeps happening before the data was verified.
+		bool CalibrateAt(UInt32 worldSpaceFormID, float x, float y, float actualZ);
+
+		bool IsEngineSamplingActive();
+
+		// Active and confirmed by GROUND_VERIFIED_MATCHES grounded horses.
+		// Only verified heights may be persisted (hazard map drop edges).
+		bool IsEngineSamplingVerified();
+
+		int GetCachedTileCount();
+
+		// Drop all tiles and re-enable engine sampling (mod deactivate)
+		void ResetGroundHeight();
+	}
+}
@@ -0,0 +1,70 @@
+#include "GroundHeight.h"
+#include <cmath>
+
+// Heightfield math for GroundHeight. Engine independent (no engine
+// reads) so it can be built and tested on its own; see
+// tests/GroundHeightTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace GroundHeight
+	{
+		// ============================================
+		// HEIGHTFIELD HELPERS (no engine access)
+		// ============================================
+
+		void StitchQuadrantHeights(const float* quadrants, float* outHeights)
+		{
+			// Quadrant q covers rows [qy * 16, qy * 16 + 16] and cols [qx * 16, qx * 16 + 16].
+			// Shared edge vertices are written twice with the same value.
+			const int half = LAND_QUADRANT_DIM - 1;
+
+			for (int q = 0; q < 4; q++)
+			{
+				int colBase = (q & 1) * half;
+				int rowBase = (q >> 1) * half;
+				const float* quad = quadrants + q * LAND_QUADRANT_VERTS;
+
+				for (int row = 0; row < LAND_QUADRANT_DIM; row++)
+				{
+					for (int col = 0; col < LAND_QUADRANT_DIM; col++)
+					{
+						outHeights[(rowBase + row) * LAND_GRID_DIM + colBase + col] = quad[row * LAND_QUADRANT_DIM + col];
+					}
+				}
+			}
+		}
+
+		float SampleTileBilinear(const float* heights, float localX, float localY)
+		{
+			const float maxGrid = (float)(LAND_GRID_DIM - 1);
+
+			float gx = localX / LAND_VERTEX_SPACING;
+			float gy = localY / LAND_VERTEX_SPACING;
+			if (gx < 0.0f) gx = 0.0f;
+			if (gy < 0.0f) gy = 0.0f;
+			if (gx > maxGrid) gx = maxGrid;
+			if (gy > maxGrid) gy = maxGrid;
+
+			int col = (int)gx;
+			int row = (int)gy;
+			if (col > LAND_GRID_DIM - 2) col = LAND_GRID_DIM - 2;
+			if (row > LAND_GRID_DIM - 2) row = LAND_GRID_DIM - 2;
+
+			float fx = gx - (float)col;
+			float fy = gy - (float)row;
+
+			const float* south = heights + row * LAND_GRID_DIM + col;
+			const float* north = south + LAND_GRID_DIM;
+
+			float h0 = south[0] + (south[1] - south[0]) * fx;
+			float h1 = north[0] + (north[1] - north[0]) * fx;
+			return h0 + (h1 - h0) * fy;
+		}
+
+		int WorldToCell(float worldCoord)
+		{
+			return (int)floorf(worldCoord / LAND_CELL_SIZE);
+		}
+	}
+}
@@ -0,0 +1,193 @@
+#include "HazardMap.h"
+#include "GroundHeight.h"  // For GetCellWorldSpaceID
+#include "Helper.h"
+#include "config.h"
+#include "SkyrimVRESLAPI.h"  // For NEWLookupModByFormID
+#include <shlobj.h>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+namespace MountedNPCCombatVR
+{
+	namespace HazardMap
+	{
+		// ============================================
+		// MAPPED FILE (one worldspace at a time)
+		// ============================================
+
+		static HANDLE g_file = INVALID_HANDLE_VALUE;
+		static HANDLE g_mapping = NULL;
+		static void* g_view = nullptr;
+		static uint32_t g_viewWorldSpace = 0;
+		static bool g_dirty = false;
+		static float g_lastFlushTime = 0.0f;
+		static uint32_t g_failedWorldSpace = 0;
+		static float g_failedTime = 0.0f;
+
+		static uint32_t GetCurrentDay()
+		{
+			return (uint32_t)(time(nullptr) / (24 * 60 * 60));
+		}
+
+		// Worldspace FormID without the load order index (light plugins keep 12 bits)
+		static uint32_t GetLocalFormID(uint32_t formID)
+		{
+			return ((formID >> 24) == 0xFE) ? (formID & 0x00000FFF) : (formID & 0x00FFFFFF);
+		}
+
+		// Path keyed by plugin name and local FormID. False for worldspaces
+		// without a plugin (created at runtime).
+		static bool BuildHazardPath(uint32_t worldSpaceFormID, std::string& outPath)
+		{
+			const ModInfo* modInfo = NEWLookupModByFormID(worldSpaceFormID);
+			if (!modInfo || !modInfo->name[0]) return false;
+
+			char documentsPath[MAX_PATH];
+			if (FAILED(SHGetFolderPathA(NULL, CSIDL_MYDOCUMENTS, NULL, SHGFP_TYPE_CURRENT, documentsPath)))
+			{
+				return false;
+			}
+
+			char name[MAX_PATH];
+			sprintf_s(name, sizeof(name), "Mounted_NPC_Combat_VR_hazards_%s_%06X.bin",
+				modInfo->name, GetLocalFormID(worldSpaceFormID));
+			outPath = std::string(documentsPath) + "\\My Games\\Skyrim VR\\SKSE\\" + name;
+			return true;
+		}
+
+		void FlushHazardMap()
+		{
+			if (!g_view || !g_dirty) return;
+
+			FlushViewOfFile(g_view, 0);
+			g_dirty = false;
+			g_lastFlushTime = GetGameTime();
+		}
+
+		void CloseHazardMap()
+		{
+			FlushHazardMap();
+
+			if (g_view) UnmapViewOfFile(g_view);
+			if (g_mapping) CloseHandle(g_mapping);
+			if (g_file != INVALID_HANDLE_VALUE) CloseHandle(g_file);
+
+			g_view = nullptr;
+			g_mapping = NULL;
+			g_file = INVALID_HANDLE_VALUE;
+			g_viewWorldSpace = 0;
+			g_dirty = false;
+			g_failedWorldSpace = 0;
+		}
+
+		static bool OpenHazardMap(uint32_t worldSpaceFormID)
+		{
+			std::string path;
+			if (!BuildHazardPath(worldSpaceFormID, path)) return false;
+
+			uint32_t size = GetHazardFileSize();
+
+			g_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+				OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (g_file == INVALID_HANDLE_VALUE)
+			{
+				_MESSAGE("HazardMap: Failed to open %s", path.c_str());
+				return false;
+			}
+
+			LARGE_INTEGER existingSize;
+			bool sizeMatches = GetFileSizeEx(g_file, &existingSize) && existingSize.QuadPart == size;
+
+			// Mapping with an explicit size grows a new/short file to the full layout
+			g_mapping = CreateFileMappingA(g_file, NULL, PAGE_READWRITE, 0, size, NULL);
+			if (g_mapping) g_view = MapViewOfFile(g_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+			if (!g_view)
+			{
+				_MESSAGE("HazardMap: Failed to map %s", path.c_str());
+				CloseHazardMap();
+				return false;
+			}
+
+			g_viewWorldSpace = worldSpaceFormID;
+
+			uint32_t localID = GetLocalFormID(worldSpaceFormID);
+			if (!sizeMatches || !ValidateHazardView(g_view, size, localID))
+			{
+				InitHazardView(g_view, localID);
+				g_dirty = true;
+				_MESSAGE("HazardMap: %s %s", sizeMatches ? "Replaced unreadable" : "Created", path.c_str());
+			}
+			else
+			{
+				int decayed = DecayHazardView(g_view, GetCurrentDay());
+				if (decayed > 0) g_dirty = true;
+				_MESSAGE("HazardMap: Loaded %s (%u cells with hazards, %d decayed)", path.c_str(),
+					static_cast<HazardFileHeader*>(g_view)->usedTiles, decayed);
+			}
+
+			return true;
+		}
+
+		// Mapping for the worldspace (switches files on worldspace change)
+		static void* GetViewForWorldSpace(uint32_t worldSpaceFormID)
+		{
+			if (!HazardMapEnabled) return nullptr;
+			if (worldSpaceFormID == 0) return nullptr;
+
+			if (g_view && g_viewWorldSpace == worldSpaceFormID) return g_view;
+
+			float now = GetGameTime();
+			if (worldSpaceFormID == g_failedWorldSpace && (now - g_failedTime) < HAZARD_RETRY_INTERVAL)
+			{
+				return nullptr;
+			}
+
+			CloseHazardMap();
+
+			if (!OpenHazardMap(worldSpaceFormID))
+			{
+				g_failedWorldSpace = worldSpaceFormID;
+				g_failedTime = now;
+				return nullptr;
+			}
+
+			g_lastFlushTime = now;
+			return g_view;
+		}
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		bool MarkHazard(TESObjectCELL* cell, float x, float y, HazardKind kind)
+		{
+			void* view = GetViewForWorldSpace(GroundHeight::GetCellWorldSpaceID(cell));
+			if (!view) return false;
+
+			if (!MarkHazardInView(view, x, y, kind, GetCurrentDay())) return false;
+
+			g_dirty = true;
+			if ((GetGameTime() - g_lastFlushTime) >= HAZARD_FLUSH_INTERVAL)
+			{
+				FlushHazardMap();
+			}
+			return true;
+		}
+
+		bool IsHazardAt(TESObjectCELL* cell, float x, float y, HazardKind kind)
+		{
+			return IsHazardAt(GroundHeight::GetCellWorldSpaceID(cell), x, y, kind);
+		}
+
+		bool IsHazardAt(uint32_t worldSpaceFormID, float x, float y, HazardKind kind)
+		{
+			void* view = GetViewForWorldSpace(worldSpaceFormID);
+			if (!view) return false;
+
+			return TestHazardInView(view, x, y, kind);
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+#include <cstdint>
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// HAZARD MAP (learned, persisted per worldspace)
+	// ============================================
+	// Horses get stuck on the same rocks and bridges and walk up to the
+	// same cliff edges every session. Obstruction detection and the
+	// sheer-drop probes found them again each time, and by then the horse
+	// was already stuck.
+	//
+	// The hazard map remembers them. Each worldspace has one fixed-size
+	// file: a header plus an open-addressed table of tiles, one tile per
+	// exterior cell. A tile counts events on a 16 x 16 grid of 256-unit
+	// squares, one 4-bit counter per kind:
+	// - stuck: a horse got obstructed here by terrain or geometry
+	//   (not by an actor)
+	// - drop: a sheer-drop probe found an edge here (only from verified
+	//   terrain heights)
+	// A square counts as a hazard once it has HAZARD_*_CONFIRM events.
+	// Every HAZARD_DECAY_DAYS (real days) without a new event in a cell,
+	// each square in it forgets one event, so a moved obstacle or a bad
+	// mark fades out instead of steering horses forever.
+	//
+	// The file is memory-mapped when a horse in that worldspace first
+	// needs it. Lookups read the mapping directly (zero copy). New bits
+	// are written straight into the mapping, and the OS writes the dirty
+	// pages back (flushed every HAZARD_FLUSH_INTERVAL and on deactivate).
+	//
+	// The format functions (InitHazardView / ValidateHazardView /
+	// MarkHazardInView / TestHazardInView / DecayHazardView) work on any
+	// buffer of GetHazardFileSize() bytes and do not touch the engine or
+	// the OS (HazardMapMath.cpp, tested by tests/HazardMapTest.cpp). A
+	// file that fails validation is replaced with an empty map.
+	//
+	// The file is keyed by the worldspace's plugin and local FormID, so it
+	// survives load order changes:
+	// My Games\Skyrim VR\SKSE\Mounted_NPC_Combat_VR_hazards_<plugin>_<localID>.bin
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace HazardMap
+	{
+		const uint32_t HAZARD_MAGIC = 0x5A484E4D;     // "MNHZ"
+		const uint32_t HAZARD_VERSION = 2;
+
+		const float HAZARD_CELL_SIZE = 4096.0f;       // One tile per exterior cell
+		const float HAZARD_SQUARE_SIZE = 256.0f;      // One bit per square
+		const int HAZARD_TILE_DIM = 16;               // Squares per tile edge
+		const int HAZARD_TILE_SQUARES = HAZARD_TILE_DIM * HAZARD_TILE_DIM;
+		const uint32_t HAZARD_MAX_TILES = 2048;       // Power of two (hash mask)
+		const float HAZARD_FLUSH_INTERVAL = 30.0f;    // Seconds between flushes of new bits
+		const float HAZARD_RETRY_INTERVAL = 30.0f;    // Seconds before retrying a file that failed to open
+		const uint8_t HAZARD_STUCK_CONFIRM = 2;       // Stuck events on a square before it is trusted
+		const uint8_t HAZARD_DROP_CONFIRM = 2;        // Drop probe hits on a square before it is trusted
+		const uint8_t HAZARD_MAX_EVENTS = 6;          // Counters saturate here (bounds how long decay takes)
+		const uint32_t HAZARD_DECAY_DAYS = 7;         // Days without an event in a cell before it forgets one
+
+		enum HazardKind : uint8_t
+		{
+			HAZARD_STUCK = 1,
+			HAZARD_DROP = 2
+		};
+
+		// ============================================
+		// FILE LAYOUT (little endian, fixed size)
+		// ============================================
+
+		#pragma pack(push, 4)
+
+		struct HazardFileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t worldSpaceLocalID;   // FormID without the load order index
+			uint32_t maxTiles;
+			uint32_t tileSize;
+			uint32_t usedTiles;
+		};
+
+		struct HazardTile
+		{
+			int16_t cellX;
+			int16_t cellY;
+			uint32_t isUsed;
+			uint32_t lastEventDay;        // Day of the last event (advanced by decay)
+			uint8_t events[HAZARD_TILE_SQUARES];  // Low nibble stuck, high nibble drop
+		};
+
+		#pragma pack(pop)
+
+		static_assert(sizeof(HazardFileHeader) == 24, "Hazard file header layout changed");
+		static_assert(sizeof(HazardTile) == 268, "Hazard tile layout changed");
+
+		// ============================================
+		// FORMAT (buffer based)
+		// ============================================
+
+		uint32_t GetHazardFileSize();
+
+		// Write an empty map for this worldspace into the buffer
+		void InitHazardView(void* base, uint32_t worldSpaceLocalID);
+
+		// True if the buffer holds a map of this version for this worldspace,
+		// with a consistent tile table (every tile reachable by lookup, no
+		// duplicates, counters in range, usedTiles matches)
+		bool ValidateHazardView(const void* base, uint32_t size, uint32_t worldSpaceLocalID);
+
+		// Count a hazard event at a world position on 'day' (any day
+		// number, e.g. days since 1970). Returns true if the map changed.
+		bool MarkHazardInView(void* base, float x, float y, HazardKind kind, uint32_t day);
+
+		// True if the square has at least HAZARD_*_CONFIRM events of this kind
+		bool TestHazardInView(const void* base, float x, float y, HazardKind kind);
+
+		// Forget one event per HAZARD_DECAY_DAYS since each cell's last
+		// event. Returns the number of tiles that lost events.
+		int DecayHazardView(void* base, uint32_t day);
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Learn / query a hazard in the cell's worldspace (interiors are ignored)
+		bool MarkHazard(TESObjectCELL* cell, float x, float y, HazardKind kind);
+		bool IsHazardAt(TESObjectCELL* cell, float x, float y, HazardKind kind);
+
+		// Query by worldspace FormID (see GroundHeight::GetCellWorldSpaceID)
+		bool IsHazardAt(uint32_t worldSpaceFormID, float x, float y, HazardKind kind);
+
+		// Push new bits to disk now
+		void FlushHazardMap();
+
+		// Flush and unmap (mod deactivate)
+		void CloseHazardMap();
+	}
+}
@@ -0,0 +1,239 @@
+#include "HazardMap.h"
+#include <cmath>
+#include <cstring>
+
+// Buffer-level hazard map format (layout, lookups, decay, validation).
+// Engine independent so it can be built and tested on its own; see
+// tests/HazardMapTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace HazardMap
+	{
+		// ============================================
+		// FORMAT
+		// ============================================
+
+		static_assert((HAZARD_MAX_TILES & (HAZARD_MAX_TILES - 1)) == 0, "HAZARD_MAX_TILES must be a power of two");
+		static_assert(HAZARD_MAX_EVENTS <= 15, "Event counters are 4 bits");
+		static_assert(HAZARD_STUCK_CONFIRM <= HAZARD_MAX_EVENTS && HAZARD_DROP_CONFIRM <= HAZARD_MAX_EVENTS,
+			"A hazard must be reachable before the counter saturates");
+
+		uint32_t GetHazardFileSize()
+		{
+			return (uint32_t)(sizeof(HazardFileHeader) + HAZARD_MAX_TILES * sizeof(HazardTile));
+		}
+
+		static HazardTile* GetTiles(void* base)
+		{
+			return reinterpret_cast<HazardTile*>(static_cast<uint8_t*>(base) + sizeof(HazardFileHeader));
+		}
+
+		static const HazardTile* GetTiles(const void* base)
+		{
+			return reinterpret_cast<const HazardTile*>(static_cast<const uint8_t*>(base) + sizeof(HazardFileHeader));
+		}
+
+		static uint32_t HashCell(int cellX, int cellY)
+		{
+			uint32_t h = (uint32_t)cellX * 73856093u ^ (uint32_t)cellY * 19349663u;
+			return h & (HAZARD_MAX_TILES - 1);
+		}
+
+		// Tile and square for a world position. False if the cell is outside the stored range.
+		static bool LocateSquare(float x, float y, int& outCellX, int& outCellY, int& outSquare)
+		{
+			int squareX = (int)floorf(x / HAZARD_SQUARE_SIZE);
+			int squareY = (int)floorf(y / HAZARD_SQUARE_SIZE);
+			int cellX = (int)floorf(x / HAZARD_CELL_SIZE);
+			int cellY = (int)floorf(y / HAZARD_CELL_SIZE);
+
+			if (cellX < INT16_MIN || cellX > INT16_MAX || cellY < INT16_MIN || cellY > INT16_MAX) return false;
+
+			int localX = squareX - cellX * HAZARD_TILE_DIM;
+			int localY = squareY - cellY * HAZARD_TILE_DIM;
+			if (localX < 0 || localX >= HAZARD_TILE_DIM || localY < 0 || localY >= HAZARD_TILE_DIM) return false;
+
+			outCellX = cellX;
+			outCellY = cellY;
+			outSquare = localY * HAZARD_TILE_DIM + localX;
+			return true;
+		}
+
+		// Event count of one kind in a square's counter byte
+		static uint8_t GetEventCount(uint8_t events, HazardKind kind)
+		{
+			return (kind == HAZARD_DROP) ? (uint8_t)(events >> 4) : (uint8_t)(events & 0x0F);
+		}
+
+		static uint8_t SetEventCount(uint8_t events, HazardKind kind, uint8_t count)
+		{
+			return (kind == HAZARD_DROP) ? (uint8_t)((events & 0x0F) | (count << 4)) : (uint8_t)((events & 0xF0) | count);
+		}
+
+		// Tile for the cell (nullptr if absent and !create, or the table is full)
+		static HazardTile* FindTile(void* base, int cellX, int cellY, bool create)
+		{
+			HazardTile* tiles = GetTiles(base);
+			uint32_t slot = HashCell(cellX, cellY);
+
+			for (uint32_t probe = 0; probe < HAZARD_MAX_TILES; probe++)
+			{
+				HazardTile& tile = tiles[(slot + probe) & (HAZARD_MAX_TILES - 1)];
+
+				if (!tile.isUsed)
+				{
+					if (!create) return nullptr;
+
+					memset(&tile, 0, sizeof(tile));
+					tile.cellX = (int16_t)cellX;
+					tile.cellY = (int16_t)cellY;
+					tile.isUsed = 1;
+					static_cast<HazardFileHeader*>(base)->usedTiles++;
+					return &tile;
+				}
+
+				if (tile.cellX == cellX && tile.cellY == cellY) return &tile;
+			}
+
+			return nullptr;
+		}
+
+		void InitHazardView(void* base, uint32_t worldSpaceLocalID)
+		{
+			memset(base, 0, GetHazardFileSize());
+
+			HazardFileHeader* header = static_cast<HazardFileHeader*>(base);
+			header->magic = HAZARD_MAGIC;
+			header->version = HAZARD_VERSION;
+			header->worldSpaceLocalID = worldSpaceLocalID;
+			header->maxTiles = HAZARD_MAX_TILES;
+			header->tileSize = sizeof(HazardTile);
+			header->usedTiles = 0;
+		}
+
+		// True if a lookup for this tile's cell, starting at its hash slot,
+		// reaches 'index' without passing an empty slot or the same cell
+		static bool IsTileReachable(const HazardTile* tiles, uint32_t index)
+		{
+			const HazardTile& tile = tiles[index];
+			uint32_t slot = HashCell(tile.cellX, tile.cellY);
+
+			for (uint32_t probe = 0; probe < HAZARD_MAX_TILES; probe++)
+			{
+				uint32_t at = (slot + probe) & (HAZARD_MAX_TILES - 1);
+				if (at == index) return true;
+
+				const HazardTile& other = tiles[at];
+				if (!other.isUsed) return false;
+				if (other.cellX == tile.cellX && other.cellY == tile.cellY) return false;  // Duplicate
+			}
+			return false;
+		}
+
+		bool ValidateHazardView(const void* base, uint32_t size, uint32_t worldSpaceLocalID)
+		{
+			if (!base || size != GetHazardFileSize()) return false;
+
+			const HazardFileHeader* header = static_cast<const HazardFileHeader*>(base);
+			if (header->magic != HAZARD_MAGIC ||
+				header->version != HAZARD_VERSION ||
+				header->worldSpaceLocalID != worldSpaceLocalID ||
+				header->maxTiles != HAZARD_MAX_TILES ||
+				header->tileSize != sizeof(HazardTile) ||
+				header->usedTiles > HAZARD_MAX_TILES)
+			{
+				return false;
+			}
+
+			// Table: lookups must find every tile, and no counter may be
+			// past HAZARD_MAX_EVENTS (decay would never clear it)
+			const HazardTile* tiles = GetTiles(base);
+			uint32_t usedTiles = 0;
+
+			for (uint32_t i = 0; i < HAZARD_MAX_TILES; i++)
+			{
+				const HazardTile& tile = tiles[i];
+				if (tile.isUsed == 0) continue;
+				if (tile.isUsed != 1) return false;
+				if (!IsTileReachable(tiles, i)) return false;
+
+				for (int s = 0; s < HAZARD_TILE_SQUARES; s++)
+				{
+					if (GetEventCount(tile.events[s], HAZARD_STUCK) > HAZARD_MAX_EVENTS ||
+						GetEventCount(tile.events[s], HAZARD_DROP) > HAZARD_MAX_EVENTS)
+					{
+						return false;
+					}
+				}
+				usedTiles++;
+			}
+
+			return usedTiles == header->usedTiles;
+		}
+
+		bool MarkHazardInView(void* base, float x, float y, HazardKind kind, uint32_t day)
+		{
+			int cellX, cellY, square;
+			if (!LocateSquare(x, y, cellX, cellY, square)) return false;
+
+			HazardTile* tile = FindTile(base, cellX, cellY, true);
+			if (!tile) return false;
+
+			// Any event restarts the cell's decay clock
+			bool changed = (tile->lastEventDay != day);
+			tile->lastEventDay = day;
+
+			uint8_t count = GetEventCount(tile->events[square], kind);
+			if (count < HAZARD_MAX_EVENTS)
+			{
+				tile->events[square] = SetEventCount(tile->events[square], kind, count + 1);
+				changed = true;
+			}
+			return changed;
+		}
+
+		bool TestHazardInView(const void* base, float x, float y, HazardKind kind)
+		{
+			int cellX, cellY, square;
+			if (!LocateSquare(x, y, cellX, cellY, square)) return false;
+
+			const HazardTile* tile = FindTile(const_cast<void*>(base), cellX, cellY, false);
+			if (!tile) return false;
+
+			uint8_t confirm = (kind == HAZARD_DROP) ? HAZARD_DROP_CONFIRM : HAZARD_STUCK_CONFIRM;
+			return GetEventCount(tile->events[square], kind) >= confirm;
+		}
+
+		int DecayHazardView(void* base, uint32_t day)
+		{
+			HazardTile* tiles = GetTiles(base);
+			int decayedTiles = 0;
+
+			for (uint32_t i = 0; i < HAZARD_MAX_TILES; i++)
+			{
+				HazardTile& tile = tiles[i];
+				if (!tile.isUsed || day <= tile.lastEventDay) continue;
+
+				uint32_t steps = (day - tile.lastEventDay) / HAZARD_DECAY_DAYS;
+				if (steps == 0) continue;
+
+				// Keep the remainder so the next step comes on schedule.
+				// Emptied tiles stay in the table (removing would break probing).
+				tile.lastEventDay += steps * HAZARD_DECAY_DAYS;
+				uint8_t forget = (steps > HAZARD_MAX_EVENTS) ? HAZARD_MAX_EVENTS : (uint8_t)steps;
+				for (int s = 0; s < HAZARD_TILE_SQUARES; s++)
+				{
+					uint8_t stuck = GetEventCount(tile.events[s], HAZARD_STUCK);
+					uint8_t drop = GetEventCount(tile.events[s], HAZARD_DROP);
+					stuck = (stuck > forget) ? (uint8_t)(stuck - forget) : 0;
+					drop = (drop > forget) ? (uint8_t)(drop - forget) : 0;
+					tile.events[s] = (uint8_t)(stuck | (drop << 4));
+				}
+				decayedTiles++;
+			}
+
+			return decayedTiles;
+		}
+	}
+}
@@ -10,8 +10,23 @@
 #include "FleeingBehavior.h"
 #include "MagicCastingSystem.h"
 #include "HorseMountScanner.h"
+#include "SpatialGrid.h"
+#include "EncounterGraph.h"
+#include "TargetAllocation.h"
+#include "AttackSlots.h"
+#include "PursuitField.h"
+#include "SteeringKernel.h"
+#include "GroundHeight.h"
+#include "MotionHistory.h"
+#include "HazardMap.h"
+#include "OccupancyGrid.h"
 #include "AILogging.h"  // For ClearAlarmCooldowns
+#include "Profiler.h"
+#include "CombatRecorder.h"
+#include "AsyncLogger.h"
 #include "config.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
 
 namespace MountedNPCCombatVR
 {
@@ -290,17 +305,50 @@ namespace MountedNPCCombatVR
 			return OriginalDismount(actor);
 		}
 		
-		// Update mounted combat system
-		UpdateMountedCombat();
-		
-		// Update horse mount scanner (for remounting dismounted NPCs)
-		UpdateHorseMountScanner();
-		
-		// ============================================
-		// PROCESS QUEUED DISENGAGES
-		// For multi-rider scenarios - process one disengage at a time
-		// ============================================
-		ProcessQueuedDisengages();
+		uint64_t frameStartNs = Profiler::NowNs();
+		Tracer::BeginFrame();
+		{
+			PROFILE_SCOPE(Frame);
+			TRACE_SCOPE("Frame");
+			
+			// Settings reloaded since the last frame take effect here
+			ApplyPendingConfig();
+			
+			// Update mounted combat system
+			UpdateMountedCombat();
+			
+			// Update horse mount scanner (for remounting dismounted NPCs)
+			{
+				PROFILE_SCOPE(HorseMountScanner);
+				TRACE_SCOPE("HorseMountScanner");
+				UpdateHorseMountScanner();
+			}
+			
+			// ============================================
+			// PROCESS QUEUED DISENGAGES
+			// For multi-rider scenarios - process one disengage at a time
+			// ============================================
+			{
+				PROFILE_SCOPE(QueuedDisengages);
+				TRACE_SCOPE("QueuedDisengages");
+				ProcessQueuedDisengages();
+			}
+			
+			// Apply every horse heading queued this frame in one batch
+			{
+				PROFILE_SCOPE(SteeringFlush);
+				TRACE_SCOPE("SteeringFlush");
+				Steering::FlushHeadings();
+			}
+			
+			PerfCounters::SetGauge(PerfCounters::Gauge::TrackedRiders, GetTrackedNPCCount());
+			PerfCounters::SetGauge(PerfCounters::Gauge::FollowingNPCs, GetFollowingNPCCount());
+			PerfCounters::SetGauge(PerfCounters::Gauge::DismountedNPCs, GetDismountedNPCCount());
+			PerfCounters::SetGauge(PerfCounters::Gauge::AvailableHorses, GetLastScanHorseCount());
+		}
+		PROFILE_FRAME_END();
+		PerfCounters::EndFrame(Profiler::NowNs() - frameStartNs);
+		Tracer::EndFrame();
 		
 		// Validate actor with SEH protection
 		if (!IsActorValid(actor))
@@ -639,6 +687,53 @@ namespace MountedNPCCombatVR
 		StopHorseMountScanner();
 		ResetHorseMountScanner();
 		
+		// Drop actor pointers held by the spatial grid
+		SpatialGrid::ResetGrid();
+		
+		// Forget encounter partitions
+		Encounters::ResetEncounters();
+		
+		// Forget target allocation prices
+		TargetAllocation::ResetTargetAllocation();
+		
+		// Free all attack slots
+		AttackSlots::ResetSlotRings();
+		
+		// Forget per-target pursuit fields
+		Pursuit::ResetPursuitFields();
+		
+		// Drop queued horse headings
+		Steering::ResetSteering();
+		
+		// Drop cached terrain tiles
+		GroundHeight::ResetGroundHeight();
+		
+		// Drop horse motion histories and obstruction state
+		Motion::ResetMotionRings();
+		ClearAllObstructionInfo();
+		
+		// Write learned hazards back and unmap the file
+		HazardMap::CloseHazardMap();
+		
+		// Drop encounter occupancy grids
+		Occupancy::ResetOccupancyGrids();
+		
+		// ============================================
+		// RESET DIAGNOSTICS
+		// ============================================
+		
+		// Discard profiler samples from the previous session
+		Profiler::ResetProfiler();
+		
+		// Write out and close the combat capture from the previous session
+		CombatRecorder::FlushRecorder();
+		
+		// Write out and close the frame trace from the previous session
+		Tracer::FlushTracer();
+		
+		// Write out queued async log messages from the previous session
+		AsyncLog::FlushAsyncLogger();
+		
 		_MESSAGE("MountedNPCCombatVR: Mod DEACTIVATED - all state reset");
 	}
 	
@@ -884,7 +979,7 @@ namespace MountedNPCCombatVR
 		fullFormId = GetFullFormIdFromEspAndFormId(pluginName.c_str(), GetBaseFormID(baseFormId));
 		if (fullFormId > 0) 
 		{
-			TESForm* form = LookupFormByID(fullFormId);
+			TESForm* form = CountedLookupFormByID(fullFormId);
 			if (form) 
 			{
 				T* castedForm = nullptr;
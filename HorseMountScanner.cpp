@@ -7,6 +7,13 @@
 #include "config.h"
 #include "FactionData.h"
 #include "CompanionCombat.h"  // For IsCompanion
+#include "AsyncLogger.h"
+#include "LogRateLimit.h"
+#include "SpatialGrid.h"
+#include "CellScanCursor.h"
+#include "RemountAssignment.h"
+#include "SteeringKernel.h"
+#include "PerfCounters.h"
 #include "skse64/GameReferences.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
@@ -17,6 +24,7 @@
 #include "skse64_common/Relocation.h"
 #include <cmath>
 #include <chrono>
+#include <algorithm>
 
 namespace MountedNPCCombatVR
 {
@@ -416,7 +424,7 @@ namespace MountedNPCCombatVR
 				g_dismountedNPCs[i].dismountedTime = currentTime; // Set dismount time
 				g_dismountedNPCCount++;
 				
-				TESForm* form = LookupFormByID(npcFormID);
+				TESForm* form = CountedLookupFormByID(npcFormID);
 				if (form)
 				{
 					Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -456,7 +464,7 @@ namespace MountedNPCCombatVR
 				g_availableHorses[i].isValid = true;
 				g_availableHorseCount++;
 				
-				TESForm* form = LookupFormByID(horseFormID);
+				TESForm* form = CountedLookupFormByID(horseFormID);
 				if (form)
 				{
 					Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -518,8 +526,11 @@ namespace MountedNPCCombatVR
 	
 	void OnNPCDismounted(UInt32 npcFormID, UInt32 horseFormID)
 	{
-		// Skip if remounting is disabled
-		if (!EnableRemounting)
+		// Skip if remounting is disabled. This runs on the controller
+		// tracking thread too (SpecialDismount pull-down), so it reads the
+		// config snapshot rather than the global.
+		static const int s_enableRemountingField = FindConfigField("EnableRemounting");
+		if (!GetConfigSnapshotValue(s_enableRemountingField).b)
 		{
 			_MESSAGE("HorseMountScanner: NPC %08X dismounted but remounting is disabled", npcFormID);
 			return;
@@ -545,6 +556,17 @@ namespace MountedNPCCombatVR
 		float distanceToPlayer;
 	};
 	
+	static bool IsCloserToPlayer(const TempNPCEntry& a, const TempNPCEntry& b)
+	{
+		return a.distanceToPlayer < b.distanceToPlayer;
+	}
+	
+	// The cell is walked one slice per call; candidates accumulate over
+	// the pass and the closest are registered when the pass completes
+	static CellScanCursor g_unmountedScanCursor(CELL_SCAN_SLICE_SIZE);
+	static TempNPCEntry g_unmountedCandidates[50];
+	static int g_unmountedCandidateCount = 0;
+	
 	static void ScanCellForUnmountedCombatNPCs()
 	{
 		if (!g_thePlayer || !(*g_thePlayer)) return;
@@ -552,8 +574,12 @@ namespace MountedNPCCombatVR
 		Actor* player = *g_thePlayer;
 		if (!player->IsInCombat()) return;
 		
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return;
+		if (!g_unmountedScanCursor.IsMidPass())
+		{
+			g_unmountedCandidateCount = 0;
+		}
+		
+		if (!g_unmountedScanCursor.BeginSlice(player->parentCell)) return;
 		
 		float currentTime = GetGameTime();
 		
@@ -570,17 +596,13 @@ namespace MountedNPCCombatVR
 			}
 		}
 		
-		// Temporary array to collect all candidates
-		TempNPCEntry candidates[50];
-		int candidateCount = 0;
+		TempNPCEntry* candidates = g_unmountedCandidates;
+		int& candidateCount = g_unmountedCandidateCount;
 		
-		// Iterate through all actors in the cell
-		for (UInt32 i = 0; i < cell->objectList.count && candidateCount < 50; i++)
+		// Iterate through this frame's slice of the cell
+		TESObjectREFR* ref = nullptr;
+		while (candidateCount < 50 && g_unmountedScanCursor.Next(ref))
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
 			if (ref->formType != kFormType_Character) continue;
 			
 			Actor* actor = static_cast<Actor*>(ref);
@@ -630,66 +652,60 @@ namespace MountedNPCCombatVR
 			}
 		}
 		
-		// Sort candidates by distance (simple bubble sort for small array)
-		for (int i = 0; i < candidateCount - 1; i++)
+		// Register once the whole cell has been seen (or the candidate list is full)
+		if (!g_unmountedScanCursor.PassCompleted() && candidateCount < 50)
 		{
-			for (int j = 0; j < candidateCount - i - 1; j++)
-			{
-				if (candidates[j].distanceToPlayer > candidates[j + 1].distanceToPlayer)
-				{
-					TempNPCEntry temp = candidates[j];
-					candidates[j] = candidates[j + 1];
-					candidates[j + 1] = temp;
-				}
-			}
+			return;
 		}
 		
-		// Register only the closest NPCs (up to available slots)
+		// Register only the closest NPCs (up to available slots) - only those need ordering
 		int slotsAvailable = MAX_DISMOUNTED_NPCS - g_dismountedNPCCount;
 		int toRegister = (candidateCount < slotsAvailable) ? candidateCount : slotsAvailable;
+		if (toRegister <= 0)
+		{
+			candidateCount = 0;
+			return;
+		}
+		
+		std::partial_sort(candidates, candidates + toRegister, candidates + candidateCount, IsCloserToPlayer);
 		
 		for (int i = 0; i < toRegister; i++)
 		{
 			RegisterDismountedNPC(candidates[i].formID, 0);
 		}
+		
+		candidateCount = 0;
 	}
 	
 	// ============================================
 	// SCAN FOR AVAILABLE HORSES IN CELL
 	// Finds any riderless horses near the player
+	// Uses the spatial grid so horses in neighbouring loaded cells count
 	// ============================================
 	
+	// Grid predicate: alive, horse race, no rider
+	static bool IsAvailableHorseCandidate(Actor* actor, void* context)
+	{
+		if (actor->IsDead(1)) return false;
+		if (!IsHorseRace(actor)) return false;
+		if (IsHorseRidden(actor)) return false;
+		return true;
+	}
+	
 	static void ScanCellForAvailableHorses()
 	{
 		if (!g_thePlayer || !(*g_thePlayer)) return;
 		
 		Actor* player = *g_thePlayer;
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return;
+		if (!player->parentCell) return;
+		
+		Actor* horses[MAX_AVAILABLE_HORSES * 2];
+		int horseCount = SpatialGrid::QueryRadius(player->pos.x, player->pos.y, player->pos.z, MAX_SCAN_DISTANCE,
+			IsAvailableHorseCandidate, nullptr, horses, MAX_AVAILABLE_HORSES * 2);
 		
-		// Iterate through all actors in the cell
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		for (int i = 0; i < horseCount; i++)
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
-			if (ref->formType != kFormType_Character) continue;
-			
-			Actor* actor = static_cast<Actor*>(ref);
-			
-			// Skip dead
-			if (actor->IsDead(1)) continue;
-			
-			// Check if this is a horse
-			if (!IsHorseRace(actor)) continue;
-			
-			// Skip if horse has a rider
-			if (IsHorseRidden(actor)) continue;
-			
-			// Check distance to player
-			float dist = CalculateDistanceToPlayer(actor);
-			if (dist > MAX_SCAN_DISTANCE) continue;
+			Actor* actor = horses[i];
 			
 			// Check if already registered
 			bool alreadyRegistered = false;
@@ -731,7 +747,7 @@ namespace MountedNPCCombatVR
 				if (timeSinceRemount >= REMOUNT_STABLE_DELAY)
 				{
 					// Verify NPC is still mounted before triggering aggro
-					TESForm* form = LookupFormByID(g_dismountedNPCs[i].npcFormID);
+					TESForm* form = CountedLookupFormByID(g_dismountedNPCs[i].npcFormID);
 					if (form)
 					{
 						Actor* npc = DYNAMIC_CAST(form, TESForm, Actor);
@@ -765,8 +781,8 @@ namespace MountedNPCCombatVR
 				
 				if (timeSinceLastTeleport >= 1.0f)  // Teleport every 1 second
 				{
-					TESForm* npcForm = LookupFormByID(g_dismountedNPCs[i].npcFormID);
-					TESForm* horseForm = LookupFormByID(g_dismountedNPCs[i].targetHorseFormID);
+					TESForm* npcForm = CountedLookupFormByID(g_dismountedNPCs[i].npcFormID);
+					TESForm* horseForm = CountedLookupFormByID(g_dismountedNPCs[i].targetHorseFormID);
 					
 					if (npcForm && horseForm)
 					{
@@ -827,7 +843,7 @@ namespace MountedNPCCombatVR
 			// Skip NPCs in continuous teleport mode (handled above)
 			if (g_dismountedNPCs[i].mountActivationSucceeded && g_dismountedNPCs[i].targetHorseFormID != 0) continue;
 			
-			TESForm* form = LookupFormByID(g_dismountedNPCs[i].npcFormID);
+			TESForm* form = CountedLookupFormByID(g_dismountedNPCs[i].npcFormID);
 			if (!form) 
 			{
 				g_dismountedNPCs[i].Reset();
@@ -907,7 +923,7 @@ namespace MountedNPCCombatVR
 		{
 			if (!g_availableHorses[i].isValid) continue;
 			
-			TESForm* form = LookupFormByID(g_availableHorses[i].horseFormID);
+			TESForm* form = CountedLookupFormByID(g_availableHorses[i].horseFormID);
 			if (!form)
 			{
 				g_availableHorses[i].Reset();
@@ -977,7 +993,7 @@ namespace MountedNPCCombatVR
 		if (!npc || !horse) return;
 		
 		// Calculate position near horse (offset by ~75 units behind horse based on horse's facing)
-		float horseAngleZ = horse->rot.z;  // Radians
+		float horseAngleZ = Steering::GetHeading(horse);  // Radians (including a turn queued this frame)
 		float offsetDist = 75.0f;
 		float offsetX = offsetDist * sin(horseAngleZ);
 		float offsetY = offsetDist * cos(horseAngleZ);
@@ -1140,6 +1156,24 @@ namespace MountedNPCCombatVR
 		return result;
 	}
 	
+	// ============================================
+	// REMOUNT MATCHING
+	// Every eligible NPC used to pick its own nearest horse, so two NPCs
+	// near one horse both teleported to it and both tried to activate it.
+	// Instead, all eligible NPCs and horses are resolved once per pass and
+	// matched with a min-cost assignment (Hungarian algorithm, n <= 10):
+	// - cost = NPC to horse distance
+	// - an NPC's own horse (lastKnownHorseFormID) is cheaper by REMOUNT_OWNER_BONUS
+	// - a horse owned by another tracked NPC costs REMOUNT_OWNED_HORSE_PENALTY more
+	// Each NPC gets at most one horse and each horse at most one NPC.
+	// ============================================
+	
+	static_assert(REMOUNT_MATRIX_DIM >= MAX_DISMOUNTED_NPCS && REMOUNT_MATRIX_DIM >= MAX_AVAILABLE_HORSES,
+		"Remount matrix must hold every dismounted NPC and available horse");
+	const float REMOUNT_OWNER_BONUS = 2000.0f;
+	const float REMOUNT_OWNED_HORSE_PENALTY = 4000.0f;
+	const float REMOUNT_UNASSIGNED_COST = 1000000.0f;  // Padding rows/columns (no NPC / no horse)
+	
 	// ============================================
 	// CHECK AND TRIGGER MOUNTING FOR CLOSE NPCs
 	// Called during scan to mount NPCs within range
@@ -1149,126 +1183,143 @@ namespace MountedNPCCombatVR
 	{
 		float currentTime = GetGameTime();
 		
-		_MESSAGE("HorseMountScanner: CheckAndTriggerMounting - %d dismounted NPCs, %d available horses", 
+		LOG_LIMITED(LOGSYS_HORSE_SCANNER, 0, 2.0f, 10.0f, "HorseMountScanner: CheckAndTriggerMounting - %d dismounted NPCs, %d available horses", 
 			g_dismountedNPCCount, g_availableHorseCount);
 		
-		// For each unmounted NPC, check if they can mount a horse
+		// ============================================
+		// STEP 1: Resolve NPCs that can try to mount this pass
+		// ============================================
+		Actor* npcs[REMOUNT_MATRIX_DIM];
+		int npcSlots[REMOUNT_MATRIX_DIM];
+		int npcCount = 0;
+		
 		for (int ni = 0; ni < MAX_DISMOUNTED_NPCS; ni++)
 		{
-			if (!g_dismountedNPCs[ni].isValid) continue;
+			DismountedNPCEntry& entry = g_dismountedNPCs[ni];
+			if (!entry.isValid) continue;
 			
-			_MESSAGE("HorseMountScanner:   Checking NPC slot %d (FormID: %08X)", ni, g_dismountedNPCs[ni].npcFormID);
+			// Mount attempt in progress / succeeded / already remounted
+			if (entry.mountAttemptInProgress || entry.mountActivationSucceeded || entry.remountedSuccessfully) continue;
 			
-			// Skip if mount attempt already in progress or succeeded
-			if (g_dismountedNPCs[ni].mountAttemptInProgress)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: mount attempt in progress");
-				continue;
-			}
-			if (g_dismountedNPCs[ni].mountActivationSucceeded)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: mount activation succeeded, waiting for mount");
-				continue;
-			}
-			if (g_dismountedNPCs[ni].remountedSuccessfully)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: already remounted, waiting for aggro");
-				continue;
-			}
+			// Post-dismount delay and attempt cooldown (AttemptMountHorse would refuse anyway,
+			// and the NPC must not hold a horse another NPC could take)
+			if (currentTime - entry.dismountedTime < POST_DISMOUNT_DELAY) continue;
+			if (entry.lastMountAttemptTime > 0 && currentTime - entry.lastMountAttemptTime < MOUNT_ATTEMPT_COOLDOWN) continue;
 			
-			// Check post-dismount delay
-			float timeSinceDismount = currentTime - g_dismountedNPCs[ni].dismountedTime;
-			if (timeSinceDismount < POST_DISMOUNT_DELAY)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: post-dismount delay (%.1f/%.1f sec)", 
-					timeSinceDismount, POST_DISMOUNT_DELAY);
-				continue;
-			}
-			
-			TESForm* npcForm = LookupFormByID(g_dismountedNPCs[ni].npcFormID);
-			if (!npcForm)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: form lookup failed");
-				continue;
-			}
+			TESForm* npcForm = CountedLookupFormByID(entry.npcFormID);
+			if (!npcForm) continue;
 			
 			Actor* npc = DYNAMIC_CAST(npcForm, TESForm, Actor);
-			if (!npc)
-			{
-				_MESSAGE("HorseMountScanner:     -> SKIP: not an Actor");
-				continue;
-			}
+			if (!npc) continue;
 			
-			const char* npcName = CALL_MEMBER_FN(npc, GetReferenceName)();
-			_MESSAGE("HorseMountScanner:     NPC: '%s'", npcName ? npcName : "Unknown");
+			if (IsActorMounted(npc) || IsActorInRagdoll(npc)) continue;
 			
-			// Skip if already mounted (double-check)
-			if (IsActorMounted(npc))
-			{
-				_MESSAGE("HorseMountScanner:   -> SKIP: already mounted");
-				continue;
-			}
+			npcs[npcCount] = npc;
+			npcSlots[npcCount] = ni;
+			npcCount++;
+		}
+		
+		if (npcCount == 0) return;
+		
+		// ============================================
+		// STEP 2: Resolve free horses and their owners
+		// Horses an NPC is already being teleported onto are taken
+		// ============================================
+		Actor* horses[REMOUNT_MATRIX_DIM];
+		int horseOwnerSlot[REMOUNT_MATRIX_DIM];
+		int horseCount = 0;
+		
+		for (int hi = 0; hi < MAX_AVAILABLE_HORSES; hi++)
+		{
+			if (!g_availableHorses[hi].isValid) continue;
+			
+			UInt32 horseFormID = g_availableHorses[hi].horseFormID;
+			int ownerSlot = -1;
+			bool claimed = false;
 			
-			// Skip if in ragdoll
-			if (IsActorInRagdoll(npc))
+			for (int ni = 0; ni < MAX_DISMOUNTED_NPCS; ni++)
 			{
-				_MESSAGE("HorseMountScanner:-> SKIP: in ragdoll state");
-				continue;
+				if (!g_dismountedNPCs[ni].isValid) continue;
+				if (g_dismountedNPCs[ni].targetHorseFormID == horseFormID) claimed = true;
+				if (g_dismountedNPCs[ni].lastKnownHorseFormID == horseFormID) ownerSlot = ni;
 			}
-		
-			// Find the nearest available horse (remove distance restriction - we will teleport)
-			float nearestDist = 99999.0f;
-			int nearestHorseIdx = -1;
-			Actor* nearestHorse = nullptr;
+			if (claimed) continue;
 			
-			_MESSAGE("HorseMountScanner:     Searching %d horse slots...", MAX_AVAILABLE_HORSES);
+			TESForm* horseForm = CountedLookupFormByID(horseFormID);
+			if (!horseForm) continue;
 			
-			for (int hi = 0; hi < MAX_AVAILABLE_HORSES; hi++)
+			Actor* horse = DYNAMIC_CAST(horseForm, TESForm, Actor);
+			if (!horse || horse->IsDead(1) || IsHorseRidden(horse)) continue;
+			
+			horses[horseCount] = horse;
+			horseOwnerSlot[horseCount] = ownerSlot;
+			horseCount++;
+		}
+		
+		if (horseCount == 0)
+		{
+			LOG_LIMITED(LOGSYS_HORSE_SCANNER, 0, 2.0f, 10.0f, "HorseMountScanner:     -> NO HORSE FOUND for %d NPCs", npcCount);
+			return;
+		}
+		
+		// ============================================
+		// STEP 3: Match NPCs to horses
+		// ============================================
+		int n = (npcCount > horseCount) ? npcCount : horseCount;
+		float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM];
+		
+		for (int r = 0; r < n; r++)
+		{
+			for (int c = 0; c < n; c++)
 			{
-				if (!g_availableHorses[hi].isValid) continue;
-				
-				TESForm* horseForm = LookupFormByID(g_availableHorses[hi].horseFormID);
-				if (!horseForm) continue;
-				
-				Actor* horse = DYNAMIC_CAST(horseForm, TESForm, Actor);
-				if (!horse) continue;
-				
-				// Skip if horse now has rider
-				if (IsHorseRidden(horse))
+				if (r >= npcCount || c >= horseCount)
 				{
-					_MESSAGE("HorseMountScanner:       Horse %08X has rider, skip", horse->formID);
+					cost[r][c] = REMOUNT_UNASSIGNED_COST;
 					continue;
 				}
 				
-				float dist = CalculateDistance3D(npc, horse);
-				_MESSAGE("HorseMountScanner:       Horse %08X at %.0f units", horse->formID, dist);
-				
-				if (dist < nearestDist)
+				float dist = CalculateDistance3D(npcs[r], horses[c]);
+				if (horseOwnerSlot[c] == npcSlots[r])
 				{
-					nearestDist = dist;
-					nearestHorseIdx = hi;
-					nearestHorse = horse;
+					dist -= REMOUNT_OWNER_BONUS;
+				}
+				else if (horseOwnerSlot[c] >= 0)
+				{
+					dist += REMOUNT_OWNED_HORSE_PENALTY;
 				}
+				cost[r][c] = dist;
+			}
+		}
+		
+		int rowToCol[REMOUNT_MATRIX_DIM];
+		SolveRemountAssignment(cost, n, rowToCol);
+		
+		// ============================================
+		// STEP 4: Mount each NPC on its assigned horse (AttemptMountHorse will teleport)
+		// ============================================
+		for (int r = 0; r < npcCount; r++)
+		{
+			int c = rowToCol[r];
+			if (c >= horseCount)
+			{
+				LOG_LIMITED(LOGSYS_HORSE_SCANNER, npcs[r]->formID, 2.0f, 10.0f, "HorseMountScanner:     NPC %08X -> NO HORSE LEFT", npcs[r]->formID);
+				continue;
 			}
 			
-			// If we found ANY horse, attempt to mount (AttemptMountHorse will teleport)
-			if (nearestHorse)
+			Actor* npc = npcs[r];
+			Actor* horse = horses[c];
+			
+			ASYNC_MESSAGE("HorseMountScanner:*** TRIGGERING MOUNT -> NPC %08X to horse %08X (%.0f units%s) ***",
+				npc->formID, horse->formID, CalculateDistance3D(npc, horse),
+				(horseOwnerSlot[c] == npcSlots[r]) ? ", own horse" : "");
+			
+			if (AttemptMountHorse(npc, horse, npcSlots[r]))
 			{
-				_MESSAGE("HorseMountScanner:*** TRIGGERING MOUNT -> Horse %08X (%.0f units) ***",
-					nearestHorse->formID, nearestDist);
-				
-				if (AttemptMountHorse(npc, nearestHorse, ni))
-				{
-					_MESSAGE("HorseMountScanner:     Mount attempt STARTED");
-				}
-				else
-				{
-					_MESSAGE("HorseMountScanner:     Mount attempt FAILED to start");
-				}
+				ASYNC_MESSAGE("HorseMountScanner:     Mount attempt STARTED");
 			}
 			else
 			{
-				_MESSAGE("HorseMountScanner:     -> NO HORSE FOUND");
+				ASYNC_MESSAGE("HorseMountScanner:     Mount attempt FAILED to start");
 			}
 		}
 	}
@@ -1342,7 +1393,7 @@ namespace MountedNPCCombatVR
 		{
 			if (!g_dismountedNPCs[i].isValid) continue;
 			
-			TESForm* form = LookupFormByID(g_dismountedNPCs[i].npcFormID);
+			TESForm* form = CountedLookupFormByID(g_dismountedNPCs[i].npcFormID);
 			const char* name = "Unknown";
 			if (form)
 			{
@@ -1364,7 +1415,7 @@ namespace MountedNPCCombatVR
 		{
 			if (!g_availableHorses[i].isValid) continue;
 			
-			TESForm* form = LookupFormByID(g_availableHorses[i].horseFormID);
+			TESForm* form = CountedLookupFormByID(g_availableHorses[i].horseFormID);
 			const char* name = "Unknown";
 			if (form)
 			{
@@ -1486,6 +1537,8 @@ namespace MountedNPCCombatVR
 		g_scanAttempts = 0;
 		g_scanDisabledForSession = false;
 		ClearAllDismountedTracking();
+		g_unmountedScanCursor.Reset();
+		g_unmountedCandidateCount = 0;
 		g_scannerActivationTime = std::chrono::steady_clock::now() + std::chrono::milliseconds((int)(ACTIVATION_DELAY_SECONDS * 1000));
 		_MESSAGE("HorseMountScanner: Will activate in %.0f seconds", ACTIVATION_DELAY_SECONDS);
 	}
@@ -1590,6 +1643,12 @@ namespace MountedNPCCombatVR
 					g_scannerActive, g_dismountedNPCCount, hasPendingAggro ? 1 : 0);
 				PerformHorseScan();
 			}
+			else if (g_unmountedScanCursor.IsMidPass())
+			{
+				// Finish the unmounted-NPC cell pass one slice per frame
+				// instead of one slice per scan interval
+				ScanCellForUnmountedCombatNPCs();
+			}
 		}
 		
 		g_playerWasInCombat = playerInCombat;
@@ -1598,6 +1657,16 @@ namespace MountedNPCCombatVR
 
 	bool IsScannerActive() { return g_scannerActive; }
 	int GetLastScanHorseCount() { return g_lastScanHorseCount; }
+	
+	int GetDismountedNPCCount()
+	{
+		int count = 0;
+		for (int i = 0; i < MAX_DISMOUNTED_NPCS; i++)
+		{
+			if (g_dismountedNPCs[i].isValid) count++;
+		}
+		return count;
+	}
 	void InstallCombatStateHook() { _MESSAGE("HorseMountScanner: Poll-based (no hooks)"); }
 	
 	// ============================================
@@ -1612,6 +1681,7 @@ namespace MountedNPCCombatVR
 	
 	static float g_lastMountScanTime = 0.0f;
 	static bool g_mountScannerActive = false;
+	static CellScanCursor g_mountScanCursor(CELL_SCAN_SLICE_SIZE);
 	
 	// Track NPCs we've already logged mounting to avoid spam
 	struct MountingNPCEntry
@@ -1756,41 +1826,13 @@ namespace MountedNPCCombatVR
 		if (!g_thePlayer || !(*g_thePlayer)) return false;
 		Actor* player = *g_thePlayer;
 		
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return false;
+		if (!player->parentCell) return false;
 		
-		// Find nearest unridden horse to this NPC
-		Actor* nearestHorse = nullptr;
+		// Find nearest unridden horse to this NPC (within 300 units)
+		// Grid lookup instead of a full cell walk per NPC
 		float nearestDist = 99999.0f;
-		
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
-		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
-			if (ref->formType != kFormType_Character) continue;
-			
-			Actor* potentialHorse = static_cast<Actor*>(ref);
-			
-			// Check if it's a horse
-			if (!IsHorseRace(potentialHorse)) continue;
-			
-			// Check if horse is alive
-			if (potentialHorse->IsDead(1)) continue;
-			
-			// Check if horse has no rider
-			if (IsHorseRidden(potentialHorse)) continue;
-			
-			// Calculate distance from NPC to horse
-			float dist = CalculateDistance3D(actor, potentialHorse);
-			
-			if (dist < nearestDist && dist < 300.0f)  // Within 300 units
-			{
-				nearestDist = dist;
-				nearestHorse = potentialHorse;
-			}
-		}
+		Actor* nearestHorse = SpatialGrid::FindNearest(actor->pos.x, actor->pos.y, actor->pos.z, 300.0f,
+			IsAvailableHorseCandidate, nullptr, &nearestDist);
 		
 		if (nearestHorse && nearestDist < 300.0f)
 		{
@@ -1819,24 +1861,26 @@ namespace MountedNPCCombatVR
 		if (!g_thePlayer || !(*g_thePlayer)) return;
 		Actor* player = *g_thePlayer;
 		
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return;
+		if (!player->parentCell) return;
 		
 		float currentTime = GetGameTime();
 		
-		// Rate limit scanning
-		if ((currentTime - g_lastMountScanTime) < NPC_MOUNT_SCAN_INTERVAL) return;
-		g_lastMountScanTime = currentTime;
+		// Rate limit the start of each pass - a pass in progress continues
+		// one slice per frame
+		if (!g_mountScanCursor.IsMidPass())
+		{
+			if ((currentTime - g_lastMountScanTime) < NPC_MOUNT_SCAN_INTERVAL) return;
+			g_lastMountScanTime = currentTime;
+		}
+		
+		if (!g_mountScanCursor.BeginSlice(player->parentCell)) return;
 		
 		g_mountScannerActive = true;
 		
-		// Scan all NPCs in cell
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		// Scan this frame's slice of NPCs in cell
+		TESObjectREFR* ref = nullptr;
+		while (g_mountScanCursor.Next(ref))
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
 			if (ref->formType != kFormType_Character) continue;
 			
 			Actor* actor = static_cast<Actor*>(ref);
@@ -1907,6 +1951,7 @@ namespace MountedNPCCombatVR
 	{
 		g_lastMountScanTime = 0.0f;
 		g_mountScannerActive = false;
+		g_mountScanCursor.Reset();
 		ClearMountingTracking();
 		_MESSAGE("NPCMountScanner: Reset");
 	}
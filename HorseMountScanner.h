@@ -34,6 +34,9 @@ namespace MountedNPCCombatVR
 	// Get the last scan results count
 	int GetLastScanHorseCount();
 	
+	// Dismounted NPCs currently registered for remounting
+	int GetDismountedNPCCount();
+	
 	// ============================================
 	// DISMOUNTED NPC TRACKING
 	// ============================================
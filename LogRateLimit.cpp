@@ -0,0 +1,117 @@
+#include "LogRateLimit.h"
+#include <chrono>
+
+namespace MountedNPCCombatVR
+{
+	namespace LogRateLimit
+	{
+		static uint64_t GetNowNs()
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		CallSite::CallSite(float ratePerSecond, float burst) :
+			m_ratePerSecond(ratePerSecond > 0.0f ? ratePerSecond : 0.0f),
+			m_burst(burst >= 1.0f ? burst : 1.0f)
+		{
+			for (int i = 0; i < LOG_KEYS_PER_SITE; i++)
+			{
+				m_keys[i] = KeyState();
+				m_keys[i].inUse = false;
+			}
+		}
+
+		CallSite::KeyState& CallSite::GetKeyState(uint32_t actorKey, uint64_t now)
+		{
+			// Prefer a free slot, otherwise the least recently seen key
+			KeyState* victim = &m_keys[0];
+			for (int i = 0; i < LOG_KEYS_PER_SITE; i++)
+			{
+				KeyState& state = m_keys[i];
+				if (state.inUse && state.key == actorKey)
+				{
+					return state;
+				}
+				if (!victim->inUse) continue;
+				if (!state.inUse || state.lastSeenNs < victim->lastSeenNs)
+				{
+					victim = &state;
+				}
+			}
+
+			// New key: start with a full bucket. Counts still pending on a
+			// recycled slot belonged to another actor and are dropped.
+			victim->key = actorKey;
+			victim->inUse = true;
+			victim->hasLast = false;
+			victim->tokens = m_burst;
+			victim->lastRefillNs = now;
+			victim->lastWriteNs = 0;
+			victim->lastSeenNs = now;
+			victim->lastHash = 0;
+			victim->repeatCount = 0;
+			victim->suppressedCount = 0;
+			return *victim;
+		}
+
+		bool CallSite::Admit(uint32_t actorKey, uint32_t argHash, uint32_t& outRepeats, uint32_t& outSuppressed)
+		{
+			// Call sites are almost always hit from one thread, so the
+			// spin lock is uncontended; it only protects the projectile
+			// hooks which run on other threads
+			while (m_lock.test_and_set(std::memory_order_acquire)) {}
+
+			uint64_t now = GetNowNs();
+			KeyState& state = GetKeyState(actorKey, now);
+			state.lastSeenNs = now;
+
+			// Refill the token bucket
+			float elapsed = (float)((double)(now - state.lastRefillNs) / 1000000000.0);
+			state.lastRefillNs = now;
+			state.tokens += elapsed * m_ratePerSecond;
+			if (state.tokens > m_burst) state.tokens = m_burst;
+
+			// Collapse identical messages
+			const uint64_t windowNs = (uint64_t)(LOG_DUPLICATE_WINDOW_SECONDS * 1000000000.0f);
+			if (state.hasLast && argHash == state.lastHash && (now - state.lastWriteNs) < windowNs)
+			{
+				state.repeatCount++;
+				m_lock.clear(std::memory_order_release);
+				return false;
+			}
+
+			// Rate limit
+			if (state.tokens < 1.0f)
+			{
+				state.suppressedCount++;
+				m_lock.clear(std::memory_order_release);
+				return false;
+			}
+
+			state.tokens -= 1.0f;
+			outRepeats = state.repeatCount;
+			outSuppressed = state.suppressedCount;
+			state.repeatCount = 0;
+			state.suppressedCount = 0;
+			state.lastHash = argHash;
+			state.lastWriteNs = now;
+			state.hasLast = true;
+
+			m_lock.clear(std::memory_order_release);
+			return true;
+		}
+
+		void WriteSuppressionNotes(uint32_t repeats, uint32_t suppressed)
+		{
+			if (repeats > 0)
+			{
+				ASYNC_MESSAGE("    (last message repeated %u times)", repeats);
+			}
+			if (suppressed > 0)
+			{
+				ASYNC_MESSAGE("    (%u messages suppressed by rate limit)", suppressed);
+			}
+		}
+	}
+}
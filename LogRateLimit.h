@@ -0,0 +1,197 @@
+#pragma once
+
+#include "AsyncLogger.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// ============================================
+// PER-CALL-SITE LOG RATE LIMITING
+// ============================================
+// LOG_LIMITED(subsystem, actorKey, ratePerSec, burst, fmt, ...) gives
+// every call site its own static state, split per actor:
+//
+// - Subsystem mask: the site is skipped entirely (arguments are not
+//   even evaluated) unless its bit is set in LogSubsystemMask (INI).
+// - Actor key: usually the formID of the rider or horse the message is
+//   about (0 for site-wide messages). Each key gets its own duplicate
+//   and token state, so one noisy rider cannot hide another rider's
+//   messages from the same site. A site tracks LOG_KEYS_PER_SITE keys;
+//   past that the least recently written key is recycled.
+// - Duplicate collapsing: a message identical to the previous one from
+//   the same site and key (within LOG_DUPLICATE_WINDOW_SECONDS) is
+//   counted instead of written. The count is written as "last message
+//   repeated N times" before the next message that gets through.
+// - Token bucket: at most ratePerSec messages per second on average
+//   per key, with bursts up to 'burst'. Messages over the limit are
+//   counted and reported with the next message that gets through.
+//
+// Written messages go through the async logger (ASYNC_MESSAGE).
+// Arguments are evaluated exactly once: they are passed by value to
+// LogRateLimit::Write, which hashes and captures the same copies.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// LOG SUBSYSTEMS (bits of LogSubsystemMask)
+	// ============================================
+
+	enum LogSubsystem : uint32_t
+	{
+		LOGSYS_MOUNTED_COMBAT    = 1u << 0,
+		LOGSYS_HORSE_SCANNER     = 1u << 1,
+		LOGSYS_AI_LOGGING        = 1u << 2,
+		LOGSYS_DYNAMIC_PACKAGES  = 1u << 3,
+		LOGSYS_ARROW_SYSTEM      = 1u << 4,
+		LOGSYS_MAGIC_CASTING     = 1u << 5,
+		LOGSYS_SPECIAL_MOVESETS  = 1u << 6,
+		LOGSYS_COMPANION_COMBAT  = 1u << 7,
+		LOGSYS_WEAPON_DETECTION  = 1u << 8,
+		LOGSYS_FLEEING           = 1u << 9,
+		LOGSYS_ALL               = 0xFFFFFFFFu
+	};
+
+	// LogSubsystemMask is defined in config.cpp ("LogSubsystemMask" INI key)
+	extern uint32_t LogSubsystemMask;
+
+	inline bool IsLogSubsystemEnabled(uint32_t subsystem)
+	{
+		return (LogSubsystemMask & subsystem) != 0;
+	}
+
+	namespace LogRateLimit
+	{
+		// ============================================
+		// ARGUMENT HASHING (FNV-1a)
+		// ============================================
+		// Only used to detect "same message as last time" - the format
+		// pointer is fixed per call site so only the arguments matter.
+
+		const uint32_t FNV_OFFSET = 2166136261u;
+		const uint32_t FNV_PRIME = 16777619u;
+
+		inline uint32_t HashBytes(uint32_t hash, const void* data, size_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ bytes[i]) * FNV_PRIME;
+			}
+			return hash;
+		}
+
+		inline uint32_t HashArg(uint32_t hash, const char* value)
+		{
+			if (!value) return HashBytes(hash, "\0", 1);
+			while (*value)
+			{
+				hash = (hash ^ (uint8_t)*value++) * FNV_PRIME;
+			}
+			return (hash ^ 0xFFu) * FNV_PRIME;
+		}
+
+		inline uint32_t HashArg(uint32_t hash, char* value)
+		{
+			return HashArg(hash, (const char*)value);
+		}
+
+		template <typename T>
+		inline uint32_t HashArg(uint32_t hash, const T& value)
+		{
+			static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+				"LOG_LIMITED arguments must be numbers, enums, pointers or C strings");
+			return HashBytes(hash, &value, sizeof(T));
+		}
+
+		template <typename... Args>
+		inline uint32_t HashArgs(Args... args)
+		{
+			uint32_t hash = FNV_OFFSET;
+			((hash = HashArg(hash, args)), ...);
+			return hash;
+		}
+
+		// Identical messages are collapsed for at most this long, so a
+		// condition that never changes is still logged periodically
+		const float LOG_DUPLICATE_WINDOW_SECONDS = 10.0f;
+
+		// Actor keys tracked per call site (MAX_TRACKED_NPCS riders plus
+		// their horses fit without recycling in normal fights)
+		const int LOG_KEYS_PER_SITE = 16;
+
+		// ============================================
+		// CALL SITE STATE
+		// ============================================
+
+		class CallSite
+		{
+		public:
+			CallSite(float ratePerSecond, float burst);
+
+			// Decide whether a message for this actor key with this
+			// argument hash is written.
+			// outRepeats:    identical messages collapsed since the last write
+			// outSuppressed: messages dropped by the token bucket since the last write
+			bool Admit(uint32_t actorKey, uint32_t argHash, uint32_t& outRepeats, uint32_t& outSuppressed);
+
+		private:
+			struct KeyState
+			{
+				uint32_t key;
+				bool inUse;
+				bool hasLast;
+				float tokens;
+				uint64_t lastRefillNs;
+				uint64_t lastWriteNs;
+				uint64_t lastSeenNs;
+				uint32_t lastHash;
+				uint32_t repeatCount;
+				uint32_t suppressedCount;
+			};
+
+			// Find the state for a key, claiming a free or the least
+			// recently seen slot if the key is new. Caller holds m_lock.
+			KeyState& GetKeyState(uint32_t actorKey, uint64_t now);
+
+			std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+			float m_ratePerSecond;
+			float m_burst;
+			KeyState m_keys[LOG_KEYS_PER_SITE];
+		};
+
+		// Write the "repeated / suppressed" notes for a call site
+		void WriteSuppressionNotes(uint32_t repeats, uint32_t suppressed);
+
+		// Admit, then write. Arguments arrive by value, so each one is
+		// evaluated once by the caller and hashed/captured from the copy.
+		template <typename... Args>
+		inline void Write(CallSite& site, uint32_t actorKey, const char* fmt, Args... args)
+		{
+			uint32_t repeats = 0;
+			uint32_t suppressed = 0;
+			if (site.Admit(actorKey, HashArgs(args...), repeats, suppressed))
+			{
+				WriteSuppressionNotes(repeats, suppressed);
+				AsyncLog::Post(fmt, args...);
+			}
+		}
+	}
+}
+
+// ============================================
+// LOG_LIMITED MACRO
+// ============================================
+
+#if ASYNC_LOG_COMPILE_LEVEL >= ASYNC_LOG_LEVEL_VERBOSE
+#define LOG_LIMITED(subsystem, actorKey, ratePerSec, burst, fmt, ...) \
+	do { \
+		static ::MountedNPCCombatVR::LogRateLimit::CallSite _logSite((ratePerSec), (burst)); \
+		if (::MountedNPCCombatVR::IsLogSubsystemEnabled(subsystem)) \
+		{ \
+			::MountedNPCCombatVR::LogRateLimit::Write(_logSite, (uint32_t)(actorKey), fmt, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#else
+#define LOG_LIMITED(subsystem, actorKey, ratePerSec, burst, fmt, ...) ((void)0)
+#endif
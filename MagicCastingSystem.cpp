@@ -4,6 +4,9 @@
 #include "ArrowSystem.h"
 #include "Helper.h"
 #include "config.h"
+#include "AsyncLogger.h"
+#include "ManeuverScript.h"
+#include "PerfCounters.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include "skse64/GameObjects.h"
@@ -169,7 +172,7 @@ namespace MountedNPCCombatVR
 						proj->velocity.y = (direction.y / dirLen) * speed;
 						proj->velocity.z = (direction.z / dirLen) * speed;
 						
-						_MESSAGE("MagicCastingSystem: Redirected MISSILE spell %08X from %08X", proj->formID, shooterFormID);
+						ASYNC_MESSAGE("MagicCastingSystem: Redirected MISSILE spell %08X from %08X", proj->formID, shooterFormID);
 					}
 					
 					g_redirectedSpellProjectiles[proj->formID] = true;
@@ -319,8 +322,10 @@ namespace MountedNPCCombatVR
 	static bool g_flamesSpellCached = false;
 	
 	// ============================================
-	// MAGE SPELL CASTING STATE MACHINE
+	// MAGE SPELL CASTING STATE
 	// ============================================
+	// The sequence runs as a maneuver script (RunMageSpellScript); the
+	// state only reports its current phase (IsMageCharging)
 	
 	enum class MageSpellState
 	{
@@ -345,6 +350,7 @@ namespace MountedNPCCombatVR
 		bool wasStationary;
 		// Last spell cast time - for enforcing minimum 3 second gap between ANY spells
 		float lastSpellCastTime;
+		ManeuverScript::ScriptState script;  // RunMageSpellScript
 		
 		void Reset()
 		{
@@ -361,6 +367,7 @@ namespace MountedNPCCombatVR
 			lastPositionCheckTime = 0;
 			wasStationary = false;
 			lastSpellCastTime = 0;
+			ManeuverScript::ResetScript(script);
 		}
 	};
 	
@@ -391,7 +398,7 @@ namespace MountedNPCCombatVR
 		for (int i = 0; i < FIRE_AND_FORGET_SPELL_COUNT; i++)
 		{
 			UInt32 spellFormID = FIRE_AND_FORGET_SPELLS[i];
-			TESForm* form = LookupFormByID(spellFormID);
+			TESForm* form = CountedLookupFormByID(spellFormID);
 			if (form)
 			{
 				g_cachedSpells[i] = DYNAMIC_CAST(form, TESForm, SpellItem);
@@ -413,7 +420,7 @@ namespace MountedNPCCombatVR
 		
 		_MESSAGE("MagicCastingSystem: Caching Flames concentration spell...");
 		
-		TESForm* form = LookupFormByID(SPELL_FLAMES);
+		TESForm* form = CountedLookupFormByID(SPELL_FLAMES);
 		if (form)
 		{
 			g_cachedFlamesSpell = DYNAMIC_CAST(form, TESForm, SpellItem);
@@ -564,8 +571,8 @@ namespace MountedNPCCombatVR
 				if (m_casterFormID == 0 || m_targetFormID == 0 || m_spellFormID == 0)
 					return;
 				
-				TESForm* casterForm = LookupFormByID(m_casterFormID);
-				TESForm* targetForm = LookupFormByID(m_targetFormID);
+				TESForm* casterForm = CountedLookupFormByID(m_casterFormID);
+				TESForm* targetForm = CountedLookupFormByID(m_targetFormID);
 				
 				if (!casterForm || !targetForm) return;
 				
@@ -575,7 +582,7 @@ namespace MountedNPCCombatVR
 				if (!caster || !target) return;
 				if (caster->IsDead(1) || target->IsDead(1)) return;
 				
-				TESForm* spellForm = LookupFormByID(m_spellFormID);
+				TESForm* spellForm = CountedLookupFormByID(m_spellFormID);
 				if (!spellForm) return;
 				
 				SpellItem* spell = DYNAMIC_CAST(spellForm, TESForm, SpellItem);
@@ -646,6 +653,7 @@ namespace MountedNPCCombatVR
 			targetAimZ = targetPos.z + SpellTargetFootHeight;
 		
 		// Queue the spell cast on game thread
+		PERF_COUNT(TaskSubmissions);
 		g_task->AddTask(new TaskCastMageSpell(
 			caster->formID, target->formID, spellFormID,
 			targetPos.x, targetPos.y, targetAimZ, false
@@ -677,6 +685,7 @@ namespace MountedNPCCombatVR
 			targetAimZ = targetPos.z + SpellTargetFootHeight;
 		
 		// Queue the spell cast on game thread (concentration spell)
+		PERF_COUNT(TaskSubmissions);
 		g_task->AddTask(new TaskCastMageSpell(
 			caster->formID, target->formID, SPELL_FLAMES,
 			targetPos.x, targetPos.y, targetAimZ, true
@@ -716,6 +725,78 @@ namespace MountedNPCCombatVR
 		return nullptr;
 	}
 	
+	// ============================================
+	// MAGE SPELL SCRIPT
+	// ============================================
+	
+	// Pick the spell and charge time and log the start of the charge
+	static void BeginSpellCharge(MageSpellCastData* data, Actor* caster, Actor* target, float distanceToTarget, float currentTime)
+	{
+		data->targetFormID = target->formID;
+		data->state = MageSpellState::Charging;
+		data->stateStartTime = currentTime;
+		
+		EnsureRandomSeeded();
+		float chargeRange = SpellChargeMaxTime - SpellChargeMinTime;
+		data->chargeDuration = SpellChargeMinTime + (((float)(rand() % 100)) / 100.0f * chargeRange);
+		data->selectedSpellIndex = GetRandomSpellIndex();
+		
+		const char* casterName = CALL_MEMBER_FN(caster, GetReferenceName)();
+		_MESSAGE("MagicCastingSystem: Mage '%s' (%08X) CHARGING spell (%.1fs, dist: %.0f)",
+			casterName ? casterName : "Unknown", caster->formID, data->chargeDuration, distanceToTarget);
+	}
+	
+	// Cast the charged spell at the target picked when the charge began.
+	// Returns false if the target is gone or dead or the cast failed.
+	static bool ReleaseChargedSpell(MageSpellCastData* data, Actor* caster, float currentTime)
+	{
+		TESForm* targetForm = CountedLookupFormByID(data->targetFormID);
+		if (!targetForm) return false;
+		
+		Actor* currentTarget = DYNAMIC_CAST(targetForm, TESForm, Actor);
+		if (!currentTarget || currentTarget->IsDead(1)) return false;
+		
+		if (!FireSpellAtTarget(caster, currentTarget, data->selectedSpellIndex)) return false;
+		
+		data->lastSpellCastTime = currentTime;
+		
+		const char* casterName = CALL_MEMBER_FN(caster, GetReferenceName)();
+		_MESSAGE("MagicCastingSystem: Mage '%s' (%08X) CAST spell %d",
+			casterName ? casterName : "Unknown", caster->formID, data->selectedSpellIndex);
+		return true;
+	}
+	
+	// Minimum gap, charge, cast, cooldown. Returns true while suspended.
+	static bool RunMageSpellScript(MageSpellCastData* data, Actor* caster, Actor* target, float distanceToTarget, float now)
+	{
+		SCRIPT_BEGIN(data->script);
+		
+		// 3 second minimum gap before starting ANY new spell
+		SCRIPT_WAIT_UNTIL(data->script, now,
+			data->lastSpellCastTime <= 0 || (now - data->lastSpellCastTime) >= MIN_SPELL_CAST_INTERVAL,
+			MIN_SPELL_CAST_INTERVAL);
+		
+		BeginSpellCharge(data, caster, target, distanceToTarget, now);
+		SCRIPT_WAIT_SECONDS(data->script, now, data->chargeDuration);
+		
+		if (!ReleaseChargedSpell(data, caster, now))
+		{
+			data->state = MageSpellState::None;
+			SCRIPT_EXIT(data->script);
+		}
+		
+		data->state = MageSpellState::Casting;
+		SCRIPT_YIELD(data->script);
+		
+		// Use 3 second minimum cooldown
+		data->state = MageSpellState::Cooldown;
+		data->stateStartTime = now;
+		SCRIPT_WAIT_SECONDS(data->script, now, MIN_SPELL_CAST_INTERVAL);
+		
+		data->state = MageSpellState::None;
+		SCRIPT_END(data->script);
+	}
+	
 	// ============================================
 	// MAIN SPELL CASTING UPDATE
 	// ============================================
@@ -753,9 +834,10 @@ namespace MountedNPCCombatVR
 		{
 			// Reset state if we're out of spell range
 			MageSpellCastData* data = GetOrCreateMageSpellData(caster->formID);
-			if (data && data->state != MageSpellState::None)
+			if (data && ManeuverScript::IsScriptRunning(data->script))
 			{
 				data->state = MageSpellState::None;
+				ManeuverScript::StopScript(data->script);
 			}
 			return false;
 		}
@@ -799,99 +881,19 @@ namespace MountedNPCCombatVR
 			}
 		}
 		
-		switch (data->state)
+		// A script waiting out the charge or the cooldown is not entered
+		// until it is due
+		if (!ManeuverScript::IsScriptRunning(data->script))
 		{
-			case MageSpellState::None:
-			{
-				// Check 3 second minimum gap before starting ANY new spell
-				if (data->lastSpellCastTime > 0)
-				{
-					float timeSinceLastCast = currentTime - data->lastSpellCastTime;
-					if (timeSinceLastCast < MIN_SPELL_CAST_INTERVAL)
-					{
-						return false;
-					}
-				}
-				
-				// Start charging fire-and-forget spell
-				data->targetFormID = target->formID;
-				data->state = MageSpellState::Charging;
-				data->stateStartTime = currentTime;
-				
-				EnsureRandomSeeded();
-				float chargeRange = SpellChargeMaxTime - SpellChargeMinTime;
-				data->chargeDuration = SpellChargeMinTime + (((float)(rand() % 100)) / 100.0f * chargeRange);
-				data->selectedSpellIndex = GetRandomSpellIndex();
-				
-				const char* casterName = CALL_MEMBER_FN(caster, GetReferenceName)();
-				_MESSAGE("MagicCastingSystem: Mage '%s' (%08X) CHARGING spell (%.1fs, dist: %.0f)",
-					casterName ? casterName : "Unknown", caster->formID, data->chargeDuration, distanceToTarget);
-				
-				return true;
-			}
-			
-			case MageSpellState::Charging:
-			{
-				float timeInState = currentTime - data->stateStartTime;
-				
-				if (timeInState >= data->chargeDuration)
-				{
-					TESForm* targetForm = LookupFormByID(data->targetFormID);
-					if (!targetForm)
-					{
-						data->state = MageSpellState::None;
-						return false;
-					}
-					
-					Actor* currentTarget = DYNAMIC_CAST(targetForm, TESForm, Actor);
-					if (!currentTarget || currentTarget->IsDead(1))
-					{
-						data->state = MageSpellState::None;
-						return false;
-					}
-					
-					if (FireSpellAtTarget(caster, currentTarget, data->selectedSpellIndex))
-					{
-						data->state = MageSpellState::Casting;
-						data->stateStartTime = currentTime;
-						data->lastSpellCastTime = currentTime;
-						
-						const char* casterName = CALL_MEMBER_FN(caster, GetReferenceName)();
-						_MESSAGE("MagicCastingSystem: Mage '%s' (%08X) CAST spell %d",
-							casterName ? casterName : "Unknown", caster->formID, data->selectedSpellIndex);
-					}
-					else
-					{
-						data->state = MageSpellState::None;
-					}
-				}
-				
-				return true;
-			}
-			
-			case MageSpellState::Casting:
-			{
-				data->state = MageSpellState::Cooldown;
-				data->stateStartTime = currentTime;
-				return false;
-			}
-			
-			case MageSpellState::Cooldown:
-			{
-				float timeInState = currentTime - data->stateStartTime;
-				
-				// Use 3 second minimum cooldown
-				if (timeInState >= MIN_SPELL_CAST_INTERVAL)
-				{
-					data->state = MageSpellState::None;
-				}
-				
-				return false;
-			}
-			
-			default:
-				return false;
+			ManeuverScript::StartScript(data->script, currentTime);
 		}
+		
+		if (ManeuverScript::IsScriptDue(data->script, currentTime))
+		{
+			RunMageSpellScript(data, caster, target, distanceToTarget, currentTime);
+		}
+		
+		return data->state == MageSpellState::Charging;
 	}
 	
 	// ============================================
@@ -1099,6 +1101,7 @@ namespace MountedNPCCombatVR
 		ClearInjectedPackages(horse);
 		
 		// Create flee package
+		PERF_COUNT(PackageCreations);
 		TESPackage* fleePackage = CreatePackageByType(TESPackage::kPackageType_Flee);
 		if (fleePackage)
 		{
@@ -1126,6 +1129,7 @@ namespace MountedNPCCombatVR
 			get_vfunc<_Actor_PutCreatedPackage>(horse, 0xE1)(horse, fleePackage, true, 1);
 		}
 		
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
 		const char* mageName = CALL_MEMBER_FN(mage, GetReferenceName)();
@@ -1149,9 +1153,9 @@ namespace MountedNPCCombatVR
 				g_mageRetreatData[i].isRetreating = false;
 				
 				// Restore mage follow package
-				TESForm* mageForm = LookupFormByID(mageFormID);
-				TESForm* horseForm = LookupFormByID(g_mageRetreatData[i].horseFormID);
-				TESForm* targetForm = LookupFormByID(g_mageRetreatData[i].targetFormID);
+				TESForm* mageForm = CountedLookupFormByID(mageFormID);
+				TESForm* horseForm = CountedLookupFormByID(g_mageRetreatData[i].horseFormID);
+				TESForm* targetForm = CountedLookupFormByID(g_mageRetreatData[i].targetFormID);
 				
 				if (mageForm && horseForm && targetForm)
 				{
@@ -1167,6 +1171,7 @@ namespace MountedNPCCombatVR
 						
 						// Re-apply mage follow package
 						ForceHorseCombatWithTarget(horse, target);
+						PERF_COUNT(EvaluatePackageCalls);
 						Actor_EvaluatePackage(horse, false, false);
 						
 						const char* mageName = CALL_MEMBER_FN(mage, GetReferenceName)();
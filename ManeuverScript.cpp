@@ -0,0 +1,142 @@
+#include "ManeuverScript.h"
+#include <atomic>
+#include <mutex>
+
+// Animation event mailbox for ManeuverScript. Engine independent (the
+// engine hook that feeds it lives in ArrowSystem.cpp) so it can be built
+// and tested on its own; see tests/ManeuverScriptTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace ManeuverScript
+	{
+		// ============================================
+		// WATCH LIST
+		// ============================================
+		// Read lock-free by PostAnimationEvent, which the engine calls for
+		// every animation event of every actor.
+
+		static std::atomic<uint32_t> g_watchedFormIDs[ANIM_EVENT_WATCH_SLOTS];   // 0 = free
+
+		bool WatchAnimationEvents(uint32_t formID)
+		{
+			if (formID == 0) return false;
+			if (IsWatchingAnimationEvents(formID)) return true;
+
+			for (int i = 0; i < ANIM_EVENT_WATCH_SLOTS; i++)
+			{
+				uint32_t expected = 0;
+				if (g_watchedFormIDs[i].compare_exchange_strong(expected, formID, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void UnwatchAnimationEvents(uint32_t formID)
+		{
+			if (formID == 0) return;
+
+			for (int i = 0; i < ANIM_EVENT_WATCH_SLOTS; i++)
+			{
+				uint32_t expected = formID;
+				g_watchedFormIDs[i].compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+			}
+		}
+
+		bool IsWatchingAnimationEvents(uint32_t formID)
+		{
+			if (formID == 0) return false;
+
+			for (int i = 0; i < ANIM_EVENT_WATCH_SLOTS; i++)
+			{
+				if (g_watchedFormIDs[i].load(std::memory_order_relaxed) == formID) return true;
+			}
+			return false;
+		}
+
+		// ============================================
+		// EVENT RING
+		// ============================================
+
+		struct AnimEventRecord
+		{
+			uint32_t sequence;   // 0 = empty
+			uint32_t formID;
+			uint32_t tagHash;
+		};
+
+		static std::mutex g_eventMutex;
+		static AnimEventRecord g_events[ANIM_EVENT_RING_SIZE];   // Guarded by g_eventMutex
+		static uint32_t g_eventSequence = 0;                     // Guarded by g_eventMutex
+
+		// FNV-1a over the lower-cased tag
+		static uint32_t HashEventTag(const char* tag)
+		{
+			uint32_t hash = 2166136261u;
+			for (const char* c = tag; c && *c; c++)
+			{
+				char lower = (*c >= 'A' && *c <= 'Z') ? (char)(*c - 'A' + 'a') : *c;
+				hash = (hash ^ (uint8_t)lower) * 16777619u;
+			}
+			return hash;
+		}
+
+		void PostAnimationEvent(uint32_t formID, const char* tag)
+		{
+			if (!tag || !IsWatchingAnimationEvents(formID)) return;
+
+			uint32_t tagHash = HashEventTag(tag);
+
+			std::lock_guard<std::mutex> lock(g_eventMutex);
+			g_eventSequence++;
+			if (g_eventSequence == 0) g_eventSequence = 1;   // 0 marks empty records
+
+			AnimEventRecord& record = g_events[g_eventSequence % ANIM_EVENT_RING_SIZE];
+			record.sequence = g_eventSequence;
+			record.formID = formID;
+			record.tagHash = tagHash;
+		}
+
+		uint32_t GetAnimationEventSequence()
+		{
+			std::lock_guard<std::mutex> lock(g_eventMutex);
+			return g_eventSequence;
+		}
+
+		bool HasAnimationEventSince(uint32_t formID, const char* tag, uint32_t sequence)
+		{
+			if (!tag) return false;
+
+			uint32_t tagHash = HashEventTag(tag);
+
+			std::lock_guard<std::mutex> lock(g_eventMutex);
+			for (int i = 0; i < ANIM_EVENT_RING_SIZE; i++)
+			{
+				const AnimEventRecord& record = g_events[i];
+				if (record.sequence == 0) continue;
+
+				// Wrap-safe "after"
+				if ((int32_t)(record.sequence - sequence) <= 0) continue;
+
+				if (record.formID == formID && record.tagHash == tagHash) return true;
+			}
+			return false;
+		}
+
+		void ClearAnimationEvents()
+		{
+			for (int i = 0; i < ANIM_EVENT_WATCH_SLOTS; i++)
+			{
+				g_watchedFormIDs[i].store(0, std::memory_order_relaxed);
+			}
+
+			std::lock_guard<std::mutex> lock(g_eventMutex);
+			for (int i = 0; i < ANIM_EVENT_RING_SIZE; i++)
+			{
+				g_events[i].sequence = 0;
+			}
+		}
+	}
+}
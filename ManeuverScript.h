@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+
+// ============================================
+// MANEUVER SCRIPTS (resumable straight-line sequences)
+// ============================================
+// The special movesets used to be written as an enum plus a timestamp
+// per horse (ChargeState::RearingUp -> EquippingWeapon -> Charging ->
+// Completed). Every update switched on the enum, and most ticks did
+// nothing but check whether enough time had passed. The sequence was
+// spread over switch cases.
+//
+// A maneuver script is one function that reads top to bottom:
+//
+//     static bool RunChargeScript(HorseChargeData* data, ..., float now)
+//     {
+//         SCRIPT_BEGIN(data->script);
+//         ... start rearing up ...
+//         SCRIPT_WAIT_SECONDS(data->script, now, CHARGE_REAR_UP_DURATION);
+//         ... swap to melee ...
+//         SCRIPT_WAIT_UNTIL(data->script, now, dist <= range, timeout);
+//         ... stop sprinting ...
+//         SCRIPT_END(data->script);
+//     }
+//
+// Each wait stores a resume point in the ScriptState and returns; the
+// next call jumps straight back to it (a stackless coroutine built on
+// switch/case, as C++17 has no language coroutines). The caller only
+// calls the script when IsScriptDue() is true, so a script sleeping in
+// SCRIPT_WAIT_SECONDS costs one float compare per tick and its body is
+// not entered until the delay has passed. SCRIPT_WAIT_UNTIL re-checks
+// its condition every tick until it holds or the timeout passes.
+// SCRIPT_WAIT_ANIM_EVENT waits for an animation graph event (e.g.
+// "BowDrawn") sent to an actor after the wait began.
+//
+// Rules for script bodies:
+// - Locals do not survive a wait. Keep state in the per-horse struct
+//   (which holds the ScriptState), or compute it in a helper function.
+//   Do not declare initialized locals at script scope (a resume jumps
+//   over them); wrap them in { } blocks that contain no waits.
+// - Do not use 'switch' around a wait (the case labels would clash).
+// - The script returns true while suspended and false once finished.
+//
+// ScriptState is plain data: it can be copied (the per-horse arrays
+// shift entries on removal) and zero-initialized.
+//
+// Scripts run on the GAME THREAD ONLY. PostAnimationEvent may be called
+// from any thread (animation graphs update on worker threads).
+//
+// Engine independent (ManeuverScript.cpp); see
+// tests/ManeuverScriptTest.cpp.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	namespace ManeuverScript
+	{
+		struct ScriptState
+		{
+			int resumePoint;     // 0 = start of the script
+			float wakeTime;      // Not resumed before this (SCRIPT_WAIT_SECONDS)
+			float deadline;      // Timeout of the current SCRIPT_WAIT_UNTIL
+			uint32_t eventSequence;  // Animation events after this count (SCRIPT_WAIT_ANIM_EVENT)
+			bool timedOut;       // Last SCRIPT_WAIT_UNTIL ended by its timeout
+			bool running;
+		};
+
+		inline void ResetScript(ScriptState& script)
+		{
+			script.resumePoint = 0;
+			script.wakeTime = 0.0f;
+			script.deadline = 0.0f;
+			script.eventSequence = 0;
+			script.timedOut = false;
+			script.running = false;
+		}
+
+		// Start (or restart) from the top; the first resume may run this tick
+		inline void StartScript(ScriptState& script, float now)
+		{
+			ResetScript(script);
+			script.wakeTime = now;
+			script.running = true;
+		}
+
+		// Abandon the script where it is (no further steps run)
+		inline void StopScript(ScriptState& script)
+		{
+			ResetScript(script);
+		}
+
+		inline bool IsScriptRunning(const ScriptState& script)
+		{
+			return script.running;
+		}
+
+		// True if the script should be resumed this tick
+		inline bool IsScriptDue(const ScriptState& script, float now)
+		{
+			return script.running && now >= script.wakeTime;
+		}
+
+		// ============================================
+		// ANIMATION EVENTS
+		// ============================================
+		// Events are only kept for watched actors (a few riders at a
+		// time), in a small ring of the most recent ones. Tags compare
+		// case-insensitively, as the engine's do.
+
+		const int ANIM_EVENT_WATCH_SLOTS = 16;
+		const int ANIM_EVENT_RING_SIZE = 64;
+
+		// Start/stop keeping events for an actor. Watch returns false if
+		// all slots are taken.
+		bool WatchAnimationEvents(uint32_t formID);
+		void UnwatchAnimationEvents(uint32_t formID);
+		bool IsWatchingAnimationEvents(uint32_t formID);
+
+		// Record an event sent to an actor (ignored unless watched)
+		void PostAnimationEvent(uint32_t formID, const char* tag);
+
+		// Count of recorded events so far (start of a wait)
+		uint32_t GetAnimationEventSequence();
+
+		// True if 'tag' was sent to formID after 'sequence'
+		bool HasAnimationEventSince(uint32_t formID, const char* tag, uint32_t sequence);
+
+		// Forget all events and watches (game load)
+		void ClearAnimationEvents();
+	}
+}
+
+// ============================================
+// SCRIPT MACROS
+// ============================================
+// 'script' is a ScriptState lvalue, 'now' the current game time.
+// Resume points come from __COUNTER__ (__LINE__ is not a constant
+// expression under /ZI).
+
+#define SCRIPT_BEGIN(script) switch ((script).resumePoint) { case 0:
+
+#define SCRIPT_END(script) } ::MountedNPCCombatVR::ManeuverScript::ResetScript(script); return false
+
+// Finish early from anywhere in the script
+#define SCRIPT_EXIT(script) do { ::MountedNPCCombatVR::ManeuverScript::ResetScript(script); return false; } while (0)
+
+#define SCRIPT_YIELD_AT(script, point) \
+	do { (script).resumePoint = (point); return true; case (point):; } while (0)
+
+// Suspend until the next tick
+#define SCRIPT_YIELD(script) SCRIPT_YIELD_AT(script, __COUNTER__ + 1)
+
+// Suspend for 'seconds' (the body is not entered until then)
+#define SCRIPT_WAIT_SECONDS(script, now, seconds) \
+	do { (script).wakeTime = (now) + (seconds); SCRIPT_YIELD(script); } while (0)
+
+#define SCRIPT_WAIT_UNTIL_AT(script, now, condition, timeout, point) \
+	do { \
+		(script).deadline = (now) + (timeout); \
+		(script).timedOut = false; \
+		(script).resumePoint = (point); \
+		[[fallthrough]]; \
+		case (point): \
+		if (!(condition)) \
+		{ \
+			if ((now) < (script).deadline) return true; \
+			(script).timedOut = true; \
+		} \
+	} while (0)
+
+// Suspend until 'condition' holds (checked this tick and every tick
+// after) or 'timeout' seconds pass; (script).timedOut tells which
+#define SCRIPT_WAIT_UNTIL(script, now, condition, timeout) \
+	SCRIPT_WAIT_UNTIL_AT(script, now, condition, timeout, __COUNTER__ + 1)
+
+#define SCRIPT_WAIT_ANIM_EVENT_AT(script, now, formID, tag, timeout, point) \
+	do { \
+		(script).eventSequence = ::MountedNPCCombatVR::ManeuverScript::GetAnimationEventSequence(); \
+		SCRIPT_WAIT_UNTIL_AT(script, now, \
+			::MountedNPCCombatVR::ManeuverScript::HasAnimationEventSince(formID, tag, (script).eventSequence), \
+			timeout, point); \
+	} while (0)
+
+// Suspend until animation event 'tag' reaches formID (which must be
+// watched) or 'timeout' seconds pass; (script).timedOut tells which.
+// Only events sent after the wait began count.
+#define SCRIPT_WAIT_ANIM_EVENT(script, now, formID, tag, timeout) \
+	SCRIPT_WAIT_ANIM_EVENT_AT(script, now, formID, tag, timeout, __COUNTER__ + 1)
@@ -0,0 +1,32 @@
+#include "ManeuverSelection.h"
+
+namespace MountedNPCCombatVR
+{
+	int SumManeuverScores(const int* scores, int count)
+	{
+		int total = 0;
+		for (int k = 0; k < count; k++)
+		{
+			if (scores[k] > 0) total += scores[k];
+		}
+		return total;
+	}
+	
+	int GetManeuverRollRange(const int* scores, int count)
+	{
+		int total = SumManeuverScores(scores, count);
+		return (total > 100) ? total : 100;
+	}
+	
+	int PickManeuver(const int* scores, int count, int roll)
+	{
+		int cumulative = 0;
+		for (int k = 0; k < count; k++)
+		{
+			if (scores[k] <= 0) continue;
+			cumulative += scores[k];
+			if (roll < cumulative) return k;
+		}
+		return -1;
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// MANEUVER SELECTION (one weighted roll)
+	// ============================================
+	// The roll behind ArbitrateManeuvers (SpecialMovesets). Scores are
+	// chances out of 100, one per maneuver kind (0 = not eligible).
+	// While they add up to 100 or less each kind keeps exactly its
+	// chance and the picks are mutually exclusive; above 100 they are
+	// scaled down together.
+	// Plain C++ with no engine headers, so the distribution is tested
+	// off the game (tests/ManeuverSelectionTest.cpp).
+	// ============================================
+
+	// Sum of the positive scores
+	int SumManeuverScores(const int* scores, int count);
+
+	// Range to roll in: 100, or the total when it is above 100
+	int GetManeuverRollRange(const int* scores, int count);
+
+	// Kind whose band holds 'roll' (bands follow the kind order), or -1
+	// if the roll is past every band (nothing picked)
+	int PickManeuver(const int* scores, int count, int roll);
+}
@@ -0,0 +1,218 @@
+#include "MotionHistory.h"
+#include "SteeringKernel.h"
+#include "Helper.h"
+#include "PerfCounters.h"
+#include <cmath>
+
+namespace MountedNPCCombatVR
+{
+	namespace Motion
+	{
+		static HorseMotion g_motion[MOTION_MAX_HORSES];
+
+		static float GetMotionTime()
+		{
+			return GetGameTime();
+		}
+
+		// ============================================
+		// RING UPDATE (O(1) per sample)
+		// ============================================
+
+		static void PushSample(HorseMotion& m, Actor* horse, float now)
+		{
+			float heading = horse->rot.z;
+
+			if (m.count == 0)
+			{
+				m.newest = 0;
+				m.count = 1;
+				MotionSample& first = m.samples[0];
+				first.x = horse->pos.x;
+				first.y = horse->pos.y;
+				first.heading = heading;
+				first.speed = 0.0f;
+				first.absTurn = 0.0f;
+				first.time = now;
+
+				m.emaVelX = m.emaVelY = m.emaSpeed = 0.0f;
+				m.windowTurn = 0.0f;
+				m.anchor = horse->pos;
+				m.lastMovedTime = now;
+				return;
+			}
+
+			const MotionSample& prev = m.samples[m.newest];
+			float dt = now - prev.time;
+			if (dt <= 0.0f) return;
+
+			float dx = horse->pos.x - prev.x;
+			float dy = horse->pos.y - prev.y;
+			float velX = dx / dt;
+			float velY = dy / dt;
+			float absTurn = fabsf(Steering::HeadingDelta(prev.heading, heading));
+
+			// The sample leaving the window stops counting toward windowTurn
+			if (m.count >= MOTION_WINDOW_SAMPLES)
+			{
+				int leaving = (m.newest - MOTION_WINDOW_SAMPLES + 1 + MOTION_RING_SIZE) % MOTION_RING_SIZE;
+				m.windowTurn -= m.samples[leaving].absTurn;
+				if (m.windowTurn < 0.0f) m.windowTurn = 0.0f;
+			}
+
+			m.newest = (m.newest + 1) % MOTION_RING_SIZE;
+			if (m.count < MOTION_RING_SIZE) m.count++;
+
+			MotionSample& s = m.samples[m.newest];
+			s.x = horse->pos.x;
+			s.y = horse->pos.y;
+			s.heading = heading;
+			s.speed = sqrtf(velX * velX + velY * velY);
+			s.absTurn = absTurn;
+			s.time = now;
+
+			m.windowTurn += absTurn;
+			m.emaVelX += (velX - m.emaVelX) * MOTION_EMA_ALPHA;
+			m.emaVelY += (velY - m.emaVelY) * MOTION_EMA_ALPHA;
+			m.emaSpeed += (s.speed - m.emaSpeed) * MOTION_EMA_ALPHA;
+
+			float ax = horse->pos.x - m.anchor.x;
+			float ay = horse->pos.y - m.anchor.y;
+			if (ax * ax + ay * ay > MOTION_MOVE_THRESHOLD * MOTION_MOVE_THRESHOLD)
+			{
+				m.anchor = horse->pos;
+				m.lastMovedTime = now;
+			}
+		}
+
+		// Oldest sample still inside the window
+		static const MotionSample& GetWindowStart(const HorseMotion* motion)
+		{
+			int span = (motion->count < MOTION_WINDOW_SAMPLES) ? motion->count : MOTION_WINDOW_SAMPLES;
+			int index = (motion->newest - span + 1 + MOTION_RING_SIZE) % MOTION_RING_SIZE;
+			return motion->samples[index];
+		}
+
+		// ============================================
+		// PUBLIC API
+		// ============================================
+
+		HorseMotion* GetHorseMotion(UInt32 horseFormID)
+		{
+			for (int i = 0; i < MOTION_MAX_HORSES; i++)
+			{
+				if (g_motion[i].isValid && g_motion[i].horseFormID == horseFormID)
+				{
+					return &g_motion[i];
+				}
+			}
+			return nullptr;
+		}
+
+		HorseMotion* TrackHorse(Actor* horse)
+		{
+			if (!horse) return nullptr;
+
+			float now = GetMotionTime();
+
+			HorseMotion* motion = GetHorseMotion(horse->formID);
+			if (motion)
+			{
+				motion->lastQueryTime = now;
+				return motion;
+			}
+
+			// Free slot, else the one queried longest ago
+			HorseMotion* oldest = &g_motion[0];
+			for (int i = 0; i < MOTION_MAX_HORSES; i++)
+			{
+				if (!g_motion[i].isValid)
+				{
+					oldest = &g_motion[i];
+					break;
+				}
+				if (g_motion[i].lastQueryTime < oldest->lastQueryTime) oldest = &g_motion[i];
+			}
+
+			motion = oldest;
+			motion->horseFormID = horse->formID;
+			motion->count = 0;
+			motion->lastQueryTime = now;
+			motion->isValid = true;
+			PushSample(*motion, horse, now);
+			return motion;
+		}
+
+		void UpdateMotionRings()
+		{
+			float now = GetMotionTime();
+
+			for (int i = 0; i < MOTION_MAX_HORSES; i++)
+			{
+				HorseMotion& m = g_motion[i];
+				if (!m.isValid) continue;
+
+				if ((now - m.lastQueryTime) > MOTION_EXPIRE_TIME)
+				{
+					m.isValid = false;
+					continue;
+				}
+
+				if ((now - m.samples[m.newest].time) < MOTION_SAMPLE_INTERVAL) continue;
+
+				TESForm* form = CountedLookupFormByID(m.horseFormID);
+				if (!form || form->formType != kFormType_Character)
+				{
+					m.isValid = false;
+					continue;
+				}
+
+				PushSample(m, static_cast<Actor*>(form), now);
+			}
+		}
+
+		float GetWindowDisplacement(const HorseMotion* motion)
+		{
+			if (!motion || motion->count < 2) return 0.0f;
+
+			const MotionSample& start = GetWindowStart(motion);
+			const MotionSample& end = motion->samples[motion->newest];
+			float dx = end.x - start.x;
+			float dy = end.y - start.y;
+			return sqrtf(dx * dx + dy * dy);
+		}
+
+		float GetHeadingOscillation(const HorseMotion* motion)
+		{
+			if (!motion || motion->count < 2) return 0.0f;
+
+			const MotionSample& start = GetWindowStart(motion);
+			const MotionSample& end = motion->samples[motion->newest];
+
+			// windowTurn covers the turns INTO samples after 'start'
+			float net = fabsf(Steering::HeadingDelta(start.heading, end.heading));
+			float oscillation = motion->windowTurn - start.absTurn - net;
+			return (oscillation > 0.0f) ? oscillation : 0.0f;
+		}
+
+		float GetStillDuration(const HorseMotion* motion, float now)
+		{
+			if (!motion) return 0.0f;
+			return now - motion->lastMovedTime;
+		}
+
+		void StopTrackingHorse(UInt32 horseFormID)
+		{
+			HorseMotion* motion = GetHorseMotion(horseFormID);
+			if (motion) motion->isValid = false;
+		}
+
+		void ResetMotionRings()
+		{
+			for (int i = 0; i < MOTION_MAX_HORSES; i++)
+			{
+				g_motion[i].isValid = false;
+			}
+		}
+	}
+}
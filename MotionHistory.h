@@ -0,0 +1,93 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// MOTION HISTORY (per-horse sample rings)
+	// ============================================
+	// Obstruction detection used one global "last check" time, so with
+	// several horses only the first caller in each interval was checked
+	// and the rest got their stale result. "Stuck" was judged from a
+	// single lastPosition snapshot per horse.
+	//
+	// Each horse that obstruction detection asks about gets a ring of
+	// MOTION_RING_SIZE samples (position, heading, speed), taken every
+	// MOTION_SAMPLE_INTERVAL by UpdateMotionRings (once per frame). Each
+	// new sample updates the statistics incrementally, so every query is
+	// O(1):
+	// - EMA velocity / speed
+	// - displacement over the last MOTION_WINDOW_SAMPLES samples
+	// - heading oscillation over the same window (total turning minus
+	//   net turning - a horse swinging left/right in place)
+	// - time since the horse last moved MOTION_MOVE_THRESHOLD units
+	//   from where it last moved (the "stuck" clock)
+	//
+	// Horses nobody asked about for MOTION_EXPIRE_TIME are dropped.
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace Motion
+	{
+		const int MOTION_RING_SIZE = 16;              // Samples kept per horse
+		const int MOTION_WINDOW_SAMPLES = 10;         // Samples in the displacement / oscillation window
+		const int MOTION_MAX_HORSES = 32;
+		const float MOTION_SAMPLE_INTERVAL = 0.1f;    // Seconds between samples (window = 1 s)
+		const float MOTION_EMA_ALPHA = 0.3f;          // Weight of the newest velocity sample
+		const float MOTION_MOVE_THRESHOLD = 5.0f;     // Units from the anchor that count as "moved"
+		const float MOTION_EXPIRE_TIME = 5.0f;        // Seconds without a query before a horse is dropped
+
+		struct MotionSample
+		{
+			float x;
+			float y;
+			float heading;
+			float speed;       // Units per second since the previous sample
+			float absTurn;     // |heading change| since the previous sample
+			float time;
+		};
+
+		struct HorseMotion
+		{
+			UInt32 horseFormID;
+			MotionSample samples[MOTION_RING_SIZE];
+			int newest;                // Index of the newest sample
+			int count;                 // Samples written (saturates at MOTION_RING_SIZE)
+
+			float emaVelX;
+			float emaVelY;
+			float emaSpeed;
+			float windowTurn;          // Sum of absTurn over the window
+
+			NiPoint3 anchor;           // Where the horse last moved from
+			float lastMovedTime;
+			float lastQueryTime;
+			bool isValid;
+		};
+
+		// Start (or keep) sampling this horse. Returns its history.
+		HorseMotion* TrackHorse(Actor* horse);
+
+		// Sample every tracked horse whose interval elapsed (once per frame)
+		void UpdateMotionRings();
+
+		// History for a horse (nullptr if not tracked)
+		HorseMotion* GetHorseMotion(UInt32 horseFormID);
+
+		// Straight-line distance covered over the window (2D)
+		float GetWindowDisplacement(const HorseMotion* motion);
+
+		// Turning that cancelled out over the window (radians, >= 0)
+		float GetHeadingOscillation(const HorseMotion* motion);
+
+		// Seconds since the horse last moved MOTION_MOVE_THRESHOLD units
+		float GetStillDuration(const HorseMotion* motion, float now);
+
+		void StopTrackingHorse(UInt32 horseFormID);
+
+		// Drop all histories (mod deactivate)
+		void ResetMotionRings();
+	}
+}
@@ -11,8 +11,21 @@
 #include "HorseMountScanner.h"
 #include "FactionData.h"  // For IsActorHostileToActor, IsHostileNPC, GetHostileTypeName
 #include "MagicCastingSystem.h"  // For ResetMagicCastingSystem
+#include "Profiler.h"
+#include "CombatRecorder.h"
+#include "SpatialGrid.h"
+#include "EncounterGraph.h"
+#include "OccupancyGrid.h"
+#include "TargetAllocation.h"
+#include "AttackSlots.h"
+#include "PursuitField.h"
+#include "MotionHistory.h"
+#include "CellScanCursor.h"
+#include "AsyncLogger.h"
 #include "Helper.h"
 #include "config.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
 #include "skse64/GameRTTI.h"
 #include <cmath>
 #include <ctime>
@@ -25,10 +38,14 @@ namespace MountedNPCCombatVR
 	// ============================================
 	
 	float g_updateInterval = 0.5f;  // Update every 500ms
-	const int MAX_TRACKED_NPCS_ARRAY = 10;  // Maximum array size (hardcoded for memory safety)
+	const int MAX_TRACKED_NPCS_ARRAY = MAX_TRACKED_NPCS;  // Maximum array size (hardcoded for memory safety)
 	// Actual runtime limit is MaxTrackedMountedNPCs from config (1-10)
 	const float FLEE_SAFE_DISTANCE = 2001.0f;  // Distance at which fleeing NPCs feel safe (just over 1 cell)
 	const float ALLY_ALERT_RANGE = 400.0f;    // Range to alert allies when attacked
+	const int ALLY_ALERT_MAX_CANDIDATES = 64; // Max nearby actors considered per alert
+	
+	// Grid predicate for hostile target candidates (defined with FindNearestHostileTarget)
+	static bool IsHostileTargetCandidate(Actor* potentialTarget, void* context);
 	
 	// ============================================
 	// Horse Animation Configuration (from SingleMountedCombat)
@@ -77,10 +94,58 @@ namespace MountedNPCCombatVR
 	// Internal State
 	// ============================================
 	
+	// Rider table: hot columns + cold records, same index (see MountedCombat.h)
+	RiderHotColumns g_riderColumns = {};
 	static MountedNPCData g_trackedNPCs[MAX_TRACKED_NPCS_ARRAY];
 	static bool g_systemInitialized = false;
 	static std::mutex g_trackedNPCsMutex;  // Thread safety for multi-rider tracking
 	
+	// Free a rider slot (hot columns and cold record)
+	static void ResetRiderSlot(int index)
+	{
+		// Every removal path (death, untrack, cleanup) comes through here;
+		// a bow rider removed mid-attack never reaches ResetBowAttackState
+		RemoveBowAttackRider(g_riderColumns.actorFormID[index]);
+		
+		g_riderColumns.actorFormID[index] = 0;
+		g_riderColumns.mountFormID[index] = 0;
+		g_riderColumns.targetFormID[index] = 0;
+		g_riderColumns.state[index] = MountedCombatState::None;
+		g_riderColumns.stateStartTime[index] = 0.0f;
+		g_riderColumns.lastUpdateTime[index] = 0.0f;
+		g_riderColumns.valid[index] = false;
+		
+		g_trackedNPCs[index].ResetCold();
+		g_trackedNPCs[index].riderIndex = index;
+	}
+	
+	// Rider index for an actor (caller holds g_trackedNPCsMutex)
+	static int FindRiderSlot(UInt32 actorFormID)
+	{
+		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
+		{
+			if (g_riderColumns.valid[i] && g_riderColumns.actorFormID[i] == actorFormID)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+	
+	// Riders that reached their combat style this tick (gather -> decide -> apply)
+	struct PendingRiderTick
+	{
+		int riderIndex;
+		Actor* actor;
+		NiPointer<Actor> mount;
+		Actor* target;
+		MountedCombatState stateBefore;
+	};
+	
+	static PendingRiderTick g_pendingRiders[MAX_TRACKED_NPCS_ARRAY];
+	static RiderSnapshot g_riderSnapshots[MAX_TRACKED_NPCS_ARRAY];
+	static RiderDecision g_riderDecisions[MAX_TRACKED_NPCS_ARRAY];
+	
 	// ============================================
 	// DISENGAGE COOLDOWN TRACKING
 	// Prevents NPCs from immediately re-engaging after distance disengage
@@ -302,12 +367,12 @@ namespace MountedNPCCombatVR
 		// AND clear horse movement packages
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (g_trackedNPCs[i].isValid)
+			if (g_riderColumns.valid[i])
 			{
 				clearedCount++;
 				
 				// Clear rider protection and follow target
-				TESForm* form = LookupFormByID(g_trackedNPCs[i].actorFormID);
+				TESForm* form = CountedLookupFormByID(g_riderColumns.actorFormID[i]);
 				if (form)
 				{
 					Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -319,21 +384,22 @@ namespace MountedNPCCombatVR
 				}
 				
 				// Clear horse movement packages
-				if (g_trackedNPCs[i].mountFormID != 0)
+				if (g_riderColumns.mountFormID[i] != 0)
 				{
-					TESForm* mountForm = LookupFormByID(g_trackedNPCs[i].mountFormID);
+					TESForm* mountForm = CountedLookupFormByID(g_riderColumns.mountFormID[i]);
 					if (mountForm)
 					{
 						Actor* mount = DYNAMIC_CAST(mountForm, TESForm, Actor);
 						if (mount)
 						{
 							Actor_ClearKeepOffsetFromActor(mount);
+							PERF_COUNT(EvaluatePackageCalls);
 							Actor_EvaluatePackage(mount, false, false);
 						}
 					}
 				}
 			}
-			g_trackedNPCs[i].Reset();
+			ResetRiderSlot(i);
 		}
 		
 		if (clearedCount > 0)
@@ -400,7 +466,7 @@ namespace MountedNPCCombatVR
 		// Check each tracked NPC
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (!g_trackedNPCs[i].isValid)
+			if (!g_riderColumns.valid[i])
 			{
 				continue;
 			}
@@ -463,7 +529,7 @@ namespace MountedNPCCombatVR
 		ApplyMountedProtection(actor);
 		
 		// Update mount info
-		data->mountFormID = mount->formID;
+		data->MountFormID() = mount->formID;
 		
 		// Determine behavior type (fight or flee) based on faction
 		if (data->behavior == MountedBehaviorType::Unknown)
@@ -540,7 +606,7 @@ namespace MountedNPCCombatVR
 		
 		if (target)
 		{
-			data->targetFormID = target->formID;
+			data->TargetFormID() = target->formID;
 		}
 		else
 		{
@@ -561,7 +627,7 @@ namespace MountedNPCCombatVR
 						float distance = GetDistanceBetween(actor, player);
 						if (distance < ALLY_ALERT_RANGE)
 						{
-							data->targetFormID = player->formID;
+							data->TargetFormID() = player->formID;
 							target = player;
 							
 							UInt32 playerHandle = player->CreateRefHandle();
@@ -588,7 +654,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Set initial state based on combat class
-		if (data->state == MountedCombatState::None)
+		if (data->State() == MountedCombatState::None)
 		{
 			data->combatStartTime = GetCurrentGameTime();
 			data->weaponDrawn = false;
@@ -596,20 +662,20 @@ namespace MountedNPCCombatVR
 			switch (data->combatClass)
 			{
 				case MountedCombatClass::CivilianFlee:
-					data->state = MountedCombatState::Fleeing;
+					data->State() = MountedCombatState::Fleeing;
 					break;
 				case MountedCombatClass::BanditRanged:
 				case MountedCombatClass::MageCaster:
-					data->state = MountedCombatState::RangedAttack;
+					data->State() = MountedCombatState::RangedAttack;
 					break;
 				default:
-					data->state = MountedCombatState::Engaging;
+					data->State() = MountedCombatState::Engaging;
 					break;
 			}
-			data->stateStartTime = GetCurrentGameTime();
+			data->StateStartTime() = GetCurrentGameTime();
 		}
 		
-		data->lastUpdateTime = GetCurrentGameTime();
+		data->LastUpdateTime() = GetCurrentGameTime();
 		UpdateCombatClassBools();
 	}
 	
@@ -627,6 +693,8 @@ namespace MountedNPCCombatVR
 	// ============================================
 	
 	static float g_lastUntrackedScanTime = 0.0f;
+	static bool g_untrackedScanHeld = false;  // A re-engage ended the last slice - wait out the interval
+	static CellScanCursor g_untrackedScanCursor(CELL_SCAN_SLICE_SIZE);
 	const float UNTRACKED_SCAN_INTERVAL = 2.0f;  // Scan every 2 seconds (slower to prevent rapid re-engagement)
 	// RE_ENGAGE_DISTANCE now uses ReEngageDistance from config.h
 	const float RE_ENGAGE_MIN_DISTANCE = 500.0f;  // Must be at least this far to re-engage (prevents immediate CTD on return)
@@ -691,24 +759,27 @@ namespace MountedNPCCombatVR
 		if (player->IsDead(1)) return;
 		if (!IsPlayerInExteriorCell()) return;
 		
+		// Interval gates the start of a pass, and the slice after a
+		// re-engage (so at most one re-engage per interval). Otherwise a
+		// pass in progress continues one slice per frame until it ends.
 		float currentTime = GetCurrentGameTime();
-		if ((currentTime - g_lastUntrackedScanTime) < UNTRACKED_SCAN_INTERVAL)
+		if (!g_untrackedScanCursor.IsMidPass() || g_untrackedScanHeld)
 		{
-			return;
+			if ((currentTime - g_lastUntrackedScanTime) < UNTRACKED_SCAN_INTERVAL)
+			{
+				return;
+			}
+			g_lastUntrackedScanTime = currentTime;
+			g_untrackedScanHeld = false;
 		}
-		g_lastUntrackedScanTime = currentTime;
 		
-		TESObjectCELL* cell = player->parentCell;
-		if (!cell) return;
+		if (!g_untrackedScanCursor.BeginSlice(player->parentCell)) return;
 		
 		int reEngagedCount = 0;
 		
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		TESObjectREFR* ref = nullptr;
+		while (g_untrackedScanCursor.Next(ref))
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
 			if (ref->formType != kFormType_Character) continue;
 			
 			Actor* actor = static_cast<Actor*>(ref);
@@ -757,7 +828,10 @@ namespace MountedNPCCombatVR
 			OnDismountBlocked(actor, mount);
 			reEngagedCount++;
 			
-			// Only re-engage ONE NPC per scan to prevent overload
+			// Only re-engage ONE NPC per interval to prevent overload
+			// (the cursor resumes after this NPC once the interval is up)
+			g_lastUntrackedScanTime = currentTime;
+			g_untrackedScanHeld = true;
 			break;
 		}
 		
@@ -767,6 +841,61 @@ namespace MountedNPCCombatVR
 		}
 	}
 	
+	// ============================================
+	// COMBAT RECORDER CAPTURE
+	// ============================================
+	// Snapshot one rider into the open recorder frame (see CombatRecorder.h)
+	
+	static void RecordRiderTick(MountedNPCData* data, Actor* actor, Actor* mount, Actor* target, MountedCombatState stateBefore,
+		MountedCombatState decidedState, uint8_t flags)
+	{
+		CombatRecorder::RecorderRiderRecord record = {};
+		
+		record.riderFormID = data->ActorFormID();
+		record.mountFormID = mount ? mount->formID : data->MountFormID();
+		record.targetFormID = target ? target->formID : 0;
+		record.riderPos[0] = actor->pos.x;
+		record.riderPos[1] = actor->pos.y;
+		record.riderPos[2] = actor->pos.z;
+		record.riderHealth = actor->actorValueOwner.GetCurrent(24);
+		record.weaponReach = data->weaponInfo.weaponReach;
+		record.stateBefore = (uint8_t)stateBefore;
+		record.stateAfter = (uint8_t)data->State();
+		record.decidedState = (uint8_t)decidedState;
+		record.combatClass = (uint8_t)data->combatClass;
+		if (data->weaponInfo.hasBowInInventory) record.inputFlags |= CombatRecorder::RECORDER_INPUT_HAS_BOW_INVENTORY;
+		
+		if (mount)
+		{
+			record.mountPos[0] = mount->pos.x;
+			record.mountPos[1] = mount->pos.y;
+			record.mountPos[2] = mount->pos.z;
+			record.mountHeading = mount->rot.z;
+		}
+		
+		if (target)
+		{
+			record.targetPos[0] = target->pos.x;
+			record.targetPos[1] = target->pos.y;
+			record.targetPos[2] = target->pos.z;
+			record.targetHealth = target->actorValueOwner.GetCurrent(24);
+			record.distanceToTarget = GetDistanceBetween(actor, target);
+			flags |= CombatRecorder::RECORDER_FLAG_HAS_TARGET;
+			
+			NiPointer<Actor> targetMount;
+			if (CALL_MEMBER_FN(target, GetMount)(targetMount) && targetMount)
+			{
+				flags |= CombatRecorder::RECORDER_FLAG_TARGET_MOUNTED;
+			}
+		}
+		
+		if (data->weaponDrawn) flags |= CombatRecorder::RECORDER_FLAG_WEAPON_DRAWN;
+		if (data->weaponInfo.isBow) flags |= CombatRecorder::RECORDER_FLAG_IS_BOW;
+		record.flags = flags;
+		
+		CombatRecorder::RecordRider(record);
+	}
+	
 	void UpdateMountedCombat()
 	{
 		if (!g_systemInitialized)
@@ -787,22 +916,46 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Update delayed arrow fires (200ms delay between animation and arrow spawn)
-		UpdateDelayedArrowFires();
+		{
+			PROFILE_SCOPE(DelayedArrowFires);
+			TRACE_SCOPE("DelayedArrowFires");
+			UpdateDelayedArrowFires();
+		}
 		
 		// Update the combat styles system (reinforcement of follow packages)
-		UpdateCombatStylesSystem();
+		{
+			PROFILE_SCOPE(CombatStylesSystem);
+			TRACE_SCOPE("CombatStylesSystem");
+			UpdateCombatStylesSystem();
+		}
 		
 		// Update temporary stagger timers (restore protection after block stagger)
-		UpdateTemporaryStaggerTimers();
+		{
+			PROFILE_SCOPE(TemporaryStaggerTimers);
+			TRACE_SCOPE("TemporaryStaggerTimers");
+			UpdateTemporaryStaggerTimers();
+		}
 		
 		// Update player mounted combat state
-		UpdatePlayerMountedCombatState();
+		{
+			PROFILE_SCOPE(PlayerMountedCombatState);
+			TRACE_SCOPE("PlayerMountedCombatState");
+			UpdatePlayerMountedCombatState();
+		}
 		
 		// Update combat class bools
-		UpdateCombatClassBools();
+		{
+			PROFILE_SCOPE(CombatClassBools);
+			TRACE_SCOPE("CombatClassBools");
+			UpdateCombatClassBools();
+		}
 		
 		// Scan for hostile targets (guards/soldiers will engage hostiles within range)
-		ScanForHostileTargets();
+		{
+			PROFILE_SCOPE(HostileTargetScan);
+			TRACE_SCOPE("HostileTargetScan");
+			ScanForHostileTargets();
+		}
 		
 		// ============================================
 		// SCAN FOR UNTRACKED MOUNTED NPCs IN COMBAT
@@ -811,37 +964,72 @@ namespace MountedNPCCombatVR
 		// - Mounted, in combat, not on cooldown, not tracked
 		// Will be re-registered with full combat capability
 		// ============================================
-		ScanForUntrackedMountedCombatNPCs();
+		{
+			PROFILE_SCOPE(UntrackedNPCScan);
+			TRACE_SCOPE("UntrackedNPCScan");
+			ScanForUntrackedMountedCombatNPCs();
+		}
 		
 		float currentTime = GetCurrentGameTime();
 		
+		PROFILE_SCOPE(RiderLoop);
+		TRACE_SCOPE("RiderLoop");
+		
+		// Per-tick capture (no-op unless RecorderEnabled)
+		CombatRecorder::BeginFrame(currentTime);
+		
+		// Partition riders into independent battles before any per-encounter checks
+		Encounters::UpdateEncounters();
+		
+		// Local occupancy around each encounter (steer-around lanes)
+		Occupancy::UpdateOccupancyGrids();
+		
+		// Slot positions / approach sides for this tick (one pass per target)
+		AttackSlots::UpdateSlotRings();
+		
+		// Per-target pursuit fields are recomputed on first use this tick
+		Pursuit::BeginPursuitTick();
+		
+		// Motion samples for horses under obstruction watch (every frame)
+		Motion::UpdateMotionRings();
+		
+		// ============================================
+		// PHASE 1: GATHER
+		// Engine checks per rider; riders that reach their combat
+		// style leave a snapshot for the decide phase
+		// ============================================
+		int pendingCount = 0;
+		
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			MountedNPCData* data = &g_trackedNPCs[i];
-			
-			if (!data->isValid)
+			// Skip free slots and riders not yet due (hot columns only)
+			if (!g_riderColumns.valid[i])
 			{
 				continue;
 			}
 			
 			// Check update interval
-			if ((currentTime - data->lastUpdateTime) < g_updateInterval)
+			if ((currentTime - g_riderColumns.lastUpdateTime[i]) < g_updateInterval)
 			{
 				continue;
 			}
 			
+			MountedNPCData* data = &g_trackedNPCs[i];
+			
+			TRACE_SCOPE_FORM("Rider", data->ActorFormID());
+			
 			// Look up the actor
-			TESForm* form = LookupFormByID(data->actorFormID);
+			TESForm* form = CountedLookupFormByID(data->ActorFormID());
 			if (!form)
 			{
-				data->Reset();
+				ResetRiderSlot(i);
 				continue;
 			}
 			
 			Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
 			if (!actor)
 			{
-				data->Reset();
+				ResetRiderSlot(i);
 				continue;
 			}
 			
@@ -849,10 +1037,10 @@ namespace MountedNPCCombatVR
 			// This prevents the high mass from affecting ragdoll physics
 			if (actor->IsDead(1))
 			{
-				_MESSAGE("MountedCombat: NPC %08X DIED - removing protection immediately", data->actorFormID);
+				_MESSAGE("MountedCombat: NPC %08X DIED - removing protection immediately", data->ActorFormID());
 				RemoveMountedProtection(actor);
 				ClearNPCFollowTarget(actor);
-				data->Reset();
+				ResetRiderSlot(i);
 				continue;
 			}
 			
@@ -862,11 +1050,11 @@ namespace MountedNPCCombatVR
 			if (!stillMounted || !mountPtr)
 			{
 				// NPC dismounted - notify scanner before clearing tracking
-				OnNPCDismounted(data->actorFormID, data->mountFormID);
+				OnNPCDismounted(data->ActorFormID(), data->MountFormID());
 				
 				RemoveMountedProtection(actor);
 				ClearNPCFollowTarget(actor);
-				data->Reset();
+				ResetRiderSlot(i);
 				continue;
 			}
 			
@@ -874,9 +1062,13 @@ namespace MountedNPCCombatVR
 			// SKIP IF RIDER IS CURRENTLY FLEEING
 			// Tactical flee system handles their behavior
 			// ============================================
-			if (IsRiderFleeing(data->actorFormID))
+			if (IsRiderFleeing(data->ActorFormID()))
 			{
-				data->lastUpdateTime = currentTime;
+				if (CombatRecorder::IsRecording())
+				{
+					RecordRiderTick(data, actor, mountPtr.get(), nullptr, data->State(), MountedCombatState::None, CombatRecorder::RECORDER_FLAG_FLEEING);
+				}
+				data->LastUpdateTime() = currentTime;
 				continue;
 			}
 			
@@ -888,7 +1080,7 @@ namespace MountedNPCCombatVR
 			if (DetectDialoguePackageIssue(actor))
 			{
 				// Log the full AI state for debugging
-				LogMountedCombatAIState(actor, mountPtr.get(), data->actorFormID);
+				LogMountedCombatAIState(actor, mountPtr.get(), data->ActorFormID());
 			}
 			
 			// Check if still in combat
@@ -897,12 +1089,12 @@ namespace MountedNPCCombatVR
 				if (data->weaponDrawn)
 				{
 					SetWeaponDrawn(actor, false);
-					_MESSAGE("MountedCombat: NPC %08X - combat ended, sheathing weapon", data->actorFormID);
+					_MESSAGE("MountedCombat: NPC %08X - combat ended, sheathing weapon", data->ActorFormID());
 				}
 				
 				RemoveMountedProtection(actor);
 				ClearNPCFollowTarget(actor);
-				data->Reset();
+				ResetRiderSlot(i);
 				continue;
 			}
 			
@@ -910,7 +1102,7 @@ namespace MountedNPCCombatVR
 			Actor* target = GetCombatTarget(actor);
 			if (target)
 			{
-				data->targetFormID = target->formID;
+				data->TargetFormID() = target->formID;
 				
 				// ============================================
 				// CHECK FOR TACTICAL FLEE
@@ -919,7 +1111,11 @@ namespace MountedNPCCombatVR
 				if (CheckAndTriggerTacticalFlee(actor, mountPtr.get(), target))
 				{
 					// Flee was triggered - skip normal combat behavior this frame
-					data->lastUpdateTime = currentTime;
+					if (CombatRecorder::IsRecording())
+					{
+						RecordRiderTick(data, actor, mountPtr.get(), target, data->State(), MountedCombatState::None, CombatRecorder::RECORDER_FLAG_FLEE_TRIGGERED);
+					}
+					data->LastUpdateTime() = currentTime;
 					continue;
 				}
 			}
@@ -927,47 +1123,103 @@ namespace MountedNPCCombatVR
 			// Update weapon info periodically
 			data->weaponInfo = GetWeaponInfo(actor);
 			
-			// ============================================
-			// ROUTE TO COMBAT STYLES
-			// All combat logic is handled in CombatStyles.cpp
-			// MountedCombat.cpp only tracks and routes
-			// ============================================
+			PendingRiderTick& pending = g_pendingRiders[pendingCount];
+			pending.riderIndex = i;
+			pending.actor = actor;
+			pending.mount = mountPtr;
+			pending.target = target;
+			pending.stateBefore = data->State();
 			
-			switch (data->combatClass)
+			RiderSnapshot& snapshot = g_riderSnapshots[pendingCount];
+			snapshot.riderX = actor->pos.x;
+			snapshot.riderY = actor->pos.y;
+			snapshot.riderZ = actor->pos.z;
+			snapshot.hasTarget = (target != nullptr);
+			snapshot.targetX = target ? target->pos.x : 0.0f;
+			snapshot.targetY = target ? target->pos.y : 0.0f;
+			snapshot.targetZ = target ? target->pos.z : 0.0f;
+			snapshot.hasBow = data->weaponInfo.isBow || data->weaponInfo.hasBowInInventory;
+			snapshot.usesStyleRules = (data->combatClass != MountedCombatClass::None &&
+				data->combatClass != MountedCombatClass::CivilianFlee);
+			
+			pendingCount++;
+		}
+		
+		// ============================================
+		// PHASE 2: DECIDE
+		// Distance and style state per rider (no engine calls). The other
+		// decisions are made by the combat styles in phase 3.
+		// ============================================
+		{
+			PROFILE_SCOPE(RiderDecide);
+			TRACE_SCOPE("RiderDecide");
+			DecideRiderStates(g_riderSnapshots, pendingCount, g_riderDecisions);
+		}
+		
+		// ============================================
+		// PHASE 3: APPLY - ROUTE TO COMBAT STYLES
+		// All combat logic is handled in CombatStyles.cpp
+		// MountedCombat.cpp only tracks and routes
+		// ============================================
+		{
+			PROFILE_SCOPE(RiderApply);
+			TRACE_SCOPE("RiderApply");
+			
+			for (int p = 0; p < pendingCount; p++)
 			{
-				case MountedCombatClass::GuardMelee:
-					GuardCombat::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
-					
-				case MountedCombatClass::SoldierMelee:
-					SoldierCombat::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
-					
-				case MountedCombatClass::BanditRanged:
-					BanditCombat::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
-					
-				case MountedCombatClass::MageCaster:
-					MageCombat::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
-					
-				case MountedCombatClass::CivilianFlee:
-					// TODO: CivilianFlee behavior not yet implemented
-					// CivilianFlee::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
+				PendingRiderTick& pending = g_pendingRiders[p];
+				MountedNPCData* data = &g_trackedNPCs[pending.riderIndex];
+				Actor* actor = pending.actor;
+				Actor* mount = pending.mount;
+				Actor* target = pending.target;
+				MountedCombatState decidedState = g_riderDecisions[p].state;
 				
-				case MountedCombatClass::Other:
-					// Unknown faction - use Guard melee behavior (aggressive)
-					GuardCombat::ExecuteBehavior(data, actor, mountPtr, target);
-					break;
+				switch (data->combatClass)
+				{
+					case MountedCombatClass::GuardMelee:
+						GuardCombat::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
+						
+					case MountedCombatClass::SoldierMelee:
+						SoldierCombat::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
+						
+					case MountedCombatClass::BanditRanged:
+						BanditCombat::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
+						
+					case MountedCombatClass::MageCaster:
+						MageCombat::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
+						
+					case MountedCombatClass::CivilianFlee:
+						// TODO: CivilianFlee behavior not yet implemented
+						// CivilianFlee::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
 					
-				default:
-					// None class - do nothing, rely on vanilla AI
-					break;
+					case MountedCombatClass::Other:
+						// Unknown faction - use Guard melee behavior (aggressive)
+						GuardCombat::ExecuteBehavior(data, actor, mount, target, decidedState);
+						break;
+						
+					default:
+						// None class - do nothing, rely on vanilla AI
+						break;
+				}
+				
+				if (CombatRecorder::IsRecording())
+				{
+					RecordRiderTick(data, actor, mount, target, pending.stateBefore, decidedState, 0);
+				}
+				
+				data->LastUpdateTime() = currentTime;
+				
+				// Release the mount reference taken at gather
+				pending.mount = nullptr;
 			}
-			
-			data->lastUpdateTime = currentTime;
 		}
+		
+		CombatRecorder::EndFrame();
 	}
 
 	// ============================================
@@ -986,22 +1238,20 @@ namespace MountedNPCCombatVR
 		UInt32 formID = actor->formID;
 		
 		// First, check if already tracked
-		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
+		int index = FindRiderSlot(formID);
+		if (index >= 0)
 		{
-			if (g_trackedNPCs[i].isValid && g_trackedNPCs[i].actorFormID == formID)
-			{
-				return &g_trackedNPCs[i];
-			}
+			return &g_trackedNPCs[index];
 		}
 		
 		// Find empty slot (limited by MaxTrackedMountedNPCs config)
 		for (int i = 0; i < MaxTrackedMountedNPCs && i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (!g_trackedNPCs[i].isValid)
+			if (!g_riderColumns.valid[i])
 			{
-				g_trackedNPCs[i].Reset();
-				g_trackedNPCs[i].actorFormID = formID;
-				g_trackedNPCs[i].isValid = true;
+				ResetRiderSlot(i);
+				g_riderColumns.actorFormID[i] = formID;
+				g_riderColumns.valid[i] = true;
 				return &g_trackedNPCs[i];
 			}
 		}
@@ -1013,40 +1263,41 @@ namespace MountedNPCCombatVR
 	{
 		std::lock_guard<std::mutex> lock(g_trackedNPCsMutex);
 		
-		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
-		{
-			if (g_trackedNPCs[i].isValid && g_trackedNPCs[i].actorFormID == formID)
-			{
-				return &g_trackedNPCs[i];
-			}
-		}
-		return nullptr;
+		int index = FindRiderSlot(formID);
+		return (index >= 0) ? &g_trackedNPCs[index] : nullptr;
 	}
 	
 	MountedNPCData* GetNPCDataByIndex(int index)
 	{
 		std::lock_guard<std::mutex> lock(g_trackedNPCsMutex);
 		
-		if (index < 0 || index >= MAX_TRACKED_NPCS_ARRAY)
+		if (index < 0 || index >= MAX_TRACKED_NPCS_ARRAY || !g_riderColumns.valid[index])
 		{
 			return nullptr;
 		}
 		return &g_trackedNPCs[index];
 	}
 	
+	int GetRiderIndex(UInt32 actorFormID)
+	{
+		std::lock_guard<std::mutex> lock(g_trackedNPCsMutex);
+		
+		return FindRiderSlot(actorFormID);
+	}
+	
 	void RemoveNPCFromTracking(UInt32 formID)
 	{
 		std::lock_guard<std::mutex> lock(g_trackedNPCsMutex);
 		
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (g_trackedNPCs[i].isValid && g_trackedNPCs[i].actorFormID == formID)
+			if (g_riderColumns.valid[i] && g_riderColumns.actorFormID[i] == formID)
 			{
 				// Get the mount FormID BEFORE resetting (we need it to clear the horse)
-				UInt32 mountFormID = g_trackedNPCs[i].mountFormID;
+				UInt32 mountFormID = g_riderColumns.mountFormID[i];
 				
 				// Remove mounted protection and clear rider's follow target
-				TESForm* form = LookupFormByID(formID);
+				TESForm* form = CountedLookupFormByID(formID);
 				if (form)
 				{
 					Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -1076,7 +1327,7 @@ namespace MountedNPCCombatVR
 				// ============================================
 				if (mountFormID != 0)
 				{
-					TESForm* mountForm = LookupFormByID(mountFormID);
+					TESForm* mountForm = CountedLookupFormByID(mountFormID);
 					if (mountForm)
 					{
 						Actor* mount = DYNAMIC_CAST(mountForm, TESForm, Actor);
@@ -1093,6 +1344,7 @@ namespace MountedNPCCombatVR
 							ClearAllMovesetData(mountFormID);
 							
 							// Re-evaluate the horse's AI packages so it returns to normal behavior
+							PERF_COUNT(EvaluatePackageCalls);
 							Actor_EvaluatePackage(mount, false, false);
 						}
 					}
@@ -1103,7 +1355,7 @@ namespace MountedNPCCombatVR
 					}
 				}
 				
-				g_trackedNPCs[i].Reset();
+				ResetRiderSlot(i);
 				
 				_MESSAGE("MountedCombat: Removed NPC %08X from tracking (mount %08X also cleared)", formID, mountFormID);
 				return;
@@ -1113,7 +1365,7 @@ namespace MountedNPCCombatVR
 	
 	bool IsNPCTracked(UInt32 formID)
 	{
-		return GetNPCData(formID) != nullptr;
+		return GetRiderIndex(formID) >= 0;
 	}
 	
 	int GetTrackedNPCCount()
@@ -1121,7 +1373,7 @@ namespace MountedNPCCombatVR
 		int count = 0;
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (g_trackedNPCs[i].isValid)
+			if (g_riderColumns.valid[i])
 			{
 				count++;
 			}
@@ -1178,52 +1430,17 @@ namespace MountedNPCCombatVR
 		}
 		
 		float distance = GetDistanceBetween(actor, target);
-		float attackRange = weaponInfo->weaponReach > 0 ? weaponInfo->weaponReach : 256.0f;
+		float attackRange = weaponInfo->weaponReach > 0 ? weaponInfo->weaponReach : DEFAULT_ATTACK_RANGE;
 		
-		// Adjust ranges based on weapon type
-		if (weaponInfo->isBow)
+		// Path check is only relevant (and only paid for) in the melee charge band
+		bool pathClear = false;
+		if (!weaponInfo->isBow && distance > attackRange + 64.0f && distance > 512.0f && distance <= 1024.0f)
 		{
-			// Ranged weapon - can attack from far, prefer medium distance
-			if (distance <= 512.0f)
-			{
-				return MountedCombatState::Circling;  // Too close for bow, circle
-			}
-			else if (distance <= 2048.0f)
-			{
-				return MountedCombatState::Attacking;  // Good bow range
-			}
-			else
-			{
-				return MountedCombatState::Engaging;  // Close distance
-			}
-		}
-		else
-		{
-			// Melee weapon
-			if (distance <= attackRange + 64.0f)  // Add some buffer
-			{
-				return MountedCombatState::Attacking;
-			}
-			else if (distance <= 512.0f)
-			{
-				return MountedCombatState::Charging;  // Close enough to charge
-			}
-			else if (distance <= 1024.0f)
-			{
-				if (IsPathClear(mount, target))
-				{
-					return MountedCombatState::Charging;
-				}
-				else
-				{
-					return MountedCombatState::Engaging;
-				}
-			}
-			else
-			{
-				return MountedCombatState::Engaging;
-			}
+			pathClear = IsPathClear(mount, target);
+			CombatRecorder::NotePathCheck(mount->formID, pathClear);
 		}
+		
+		return DecideAggressiveState(distance, weaponInfo->weaponReach, weaponInfo->isBow, pathClear);
 	}
 	
 	void ExecuteAggressiveBehavior(MountedNPCData* npcData, Actor* actor, Actor* mount, Actor* target)
@@ -1237,10 +1454,10 @@ namespace MountedNPCCombatVR
 		MountedCombatState newState = DetermineAggressiveState(actor, mount, target, &npcData->weaponInfo);
 		
 		// State transition
-		if (newState != npcData->state && newState != MountedCombatState::None)
+		if (newState != npcData->State() && newState != MountedCombatState::None)
 		{
-			npcData->state = newState;
-			npcData->stateStartTime = GetCurrentGameTime();
+			npcData->State() = newState;
+			npcData->StateStartTime() = GetCurrentGameTime();
 		}
 		
 		// State tracking is done - vanilla AI + quest package handles actual movement
@@ -1254,9 +1471,25 @@ namespace MountedNPCCombatVR
 	
 	void ExecuteCircling(Actor* actor, Actor* mount, Actor* target)
 	{
-		// TODO: Command mount to circle around target
-		// This is useful for bow users or repositioning
-		// For now, rely on default AI
+		if (!mount || !target) return;
+		
+		// Circle by walking the melee slot ring: once the horse reaches its
+		// slot, move on to the next free sector on the same side it approached from
+		if (!AttackSlots::ReserveSlot(mount, target, AttackSlots::SlotRing::Melee, AttackSlots::SLOT_MELEE_RADIUS))
+		{
+			return;  // Ring full - rely on default AI
+		}
+		
+		float slotDistance = 0.0f;
+		bool clockwise = false;
+		if (AttackSlots::GetSlotDistance(mount->formID, slotDistance) &&
+			slotDistance < AttackSlots::SLOT_ARRIVE_DISTANCE &&
+			AttackSlots::GetSlotSideClockwise(mount->formID, clockwise))
+		{
+			AttackSlots::AdvanceSlot(mount->formID, clockwise);
+		}
+		
+		ForceHorseCombatWithTarget(mount, target);
 	}
 
 	// ============================================
@@ -1301,19 +1534,19 @@ namespace MountedNPCCombatVR
 		MountedCombatState newState = DeterminePassiveState(actor, mount, threat);
 		
 		// State transition
-		if (newState != npcData->state)
+		if (newState != npcData->State())
 		{
-			npcData->state = newState;
-			npcData->stateStartTime = GetCurrentGameTime();
+			npcData->State() = newState;
+			npcData->StateStartTime() = GetCurrentGameTime();
 			
 			if (newState == MountedCombatState::None)
 			{
-				_MESSAGE("MountedCombat: NPC %08X reached safe distance, stopping flee", npcData->actorFormID);
+				_MESSAGE("MountedCombat: NPC %08X reached safe distance, stopping flee", npcData->ActorFormID());
 			}
 		}
 		
 		// Execute flee
-		if (npcData->state == MountedCombatState::Fleeing)
+		if (npcData->State() == MountedCombatState::Fleeing)
 		{
 			ExecuteFleeing(actor, mount, threat);
 		}
@@ -1346,10 +1579,10 @@ namespace MountedNPCCombatVR
 		// This is set by EngageHostileTarget() or OnDismountBlocked()
 		// ============================================
 		MountedNPCData* data = GetNPCData(actor->formID);
-		if (data && data->targetFormID != 0)
+		if (data && data->TargetFormID() != 0)
 		{
 			// Guards/Soldiers should only target the player if player is genuinely hostile
-			if (data->targetFormID == 0x14 && 
+			if (data->TargetFormID() == 0x14 && 
 				(data->combatClass == MountedCombatClass::GuardMelee || 
 				 data->combatClass == MountedCombatClass::SoldierMelee))
 			{
@@ -1381,11 +1614,11 @@ namespace MountedNPCCombatVR
 				}
 				
 				// Player not genuinely hostile - clear and look for real hostiles
-				data->targetFormID = 0;
+				data->TargetFormID() = 0;
 			}
 			else
 			{
-				TESForm* targetForm = LookupFormByID(data->targetFormID);
+				TESForm* targetForm = CountedLookupFormByID(data->TargetFormID());
 				if (targetForm && targetForm->formType == kFormType_Character)
 				{
 					Actor* storedTarget = static_cast<Actor*>(targetForm);
@@ -1398,7 +1631,7 @@ namespace MountedNPCCombatVR
 					else
 					{
 						// Target died - clear it so we can find a new one
-						data->targetFormID = 0;
+						data->TargetFormID() = 0;
 					}
 				}
 			}
@@ -1431,11 +1664,13 @@ namespace MountedNPCCombatVR
 		if (data && (data->combatClass == MountedCombatClass::GuardMelee || 
 		      data->combatClass == MountedCombatClass::SoldierMelee))
 		{
-			Actor* hostile = FindNearestHostileTarget(actor, HOSTILE_SCAN_RANGE);
+			// Prefer a hostile that is not already at MaxAttackersPerTarget
+			Actor* hostile = TargetAllocation::FindBestTarget(actor, HOSTILE_SCAN_RANGE, IsHostileTargetCandidate, actor);
 			if (hostile)
 			{
 				// Store this as the new target
-				data->targetFormID = hostile->formID;
+				data->TargetFormID() = hostile->formID;
+				data->allocatedTargetFormID = hostile->formID;
 				_MESSAGE("GetCombatTarget: Guard %08X acquired new hostile target %08X", actor->formID, hostile->formID);
 				return hostile;
 			}
@@ -1457,7 +1692,7 @@ namespace MountedNPCCombatVR
 					if (distance < ALLY_ALERT_RANGE)
 					{
 						// Player is hostile and in combat nearby
-						data->targetFormID = player->formID;
+						data->TargetFormID() = player->formID;
 						_MESSAGE("GetCombatTarget: Guard %08X targeting player (hostile, in combat nearby, %.0f units)", 
 							actor->formID, distance);
 						return player;
@@ -1543,18 +1778,9 @@ namespace MountedNPCCombatVR
 			return fleeDir;
 		}
 		
-		// Calculate direction away from threat
-		fleeDir.x = actor->pos.x - threat->pos.x;
-		fleeDir.y = actor->pos.y - threat->pos.y;
-		fleeDir.z = 0;  // Keep on ground plane
-		
-		// Normalize
-		float length = sqrt(fleeDir.x * fleeDir.x + fleeDir.y * fleeDir.y);
-		if (length > 0)
-		{
-			fleeDir.x /= length;
-			fleeDir.y /= length;
-		}
+		// Direction away from threat, kept on the ground plane
+		DecideFleeDirection(actor->pos.x, actor->pos.y, threat->pos.x, threat->pos.y, fleeDir.x, fleeDir.y);
+		fleeDir.z = 0;
 		
 		return fleeDir;
 	}
@@ -1641,9 +1867,9 @@ namespace MountedNPCCombatVR
 				// Immediately reset everything
 				for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 				{
-					if (g_trackedNPCs[i].isValid)
+					if (g_riderColumns.valid[i])
 					{
-						TESForm* form = LookupFormByID(g_trackedNPCs[i].actorFormID);
+						TESForm* form = CountedLookupFormByID(g_riderColumns.actorFormID[i]);
 						if (form)
 						{
 							Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -1653,7 +1879,7 @@ namespace MountedNPCCombatVR
 							}
 						}
 						
-						g_trackedNPCs[i].Reset();
+						ResetRiderSlot(i);
 					}
 				}
 				
@@ -1738,9 +1964,9 @@ namespace MountedNPCCombatVR
 				// Clear all tracked NPCs when entering interior
 				for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 				{
-					if (g_trackedNPCs[i].isValid)
+					if (g_riderColumns.valid[i])
 					{
-						g_trackedNPCs[i].Reset();
+						ResetRiderSlot(i);
 					}
 				}
 				
@@ -1772,7 +1998,7 @@ namespace MountedNPCCombatVR
 		// Check if any tracked NPCs are aggressive (fighting the player)
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			if (g_trackedNPCs[i].isValid && 
+			if (g_riderColumns.valid[i] && 
 				g_trackedNPCs[i].behavior == MountedBehaviorType::Aggressive)
 			{
 				hasAggressiveMountedNPCs = true;
@@ -1862,6 +2088,8 @@ namespace MountedNPCCombatVR
 		if (!attackedNPC || !attacker) return;
 		if (attacker->IsDead(1)) return;
 		
+		TRACE_SCOPE_FORM("AlertNearbyMountedAllies", attackedNPC->formID);
+		
 		MountedCombatClass attackedClass = DetermineCombatClass(attackedNPC);
 		
 		// Only guards and soldiers alert allies
@@ -1871,21 +2099,32 @@ namespace MountedNPCCombatVR
 			return;
 		}
 		
-		TESObjectCELL* cell = attackedNPC->parentCell;
-		if (!cell) return;
+		if (!attackedNPC->parentCell) return;
 		
 		int alliesAlerted = 0;
 		
+		// Nearby actors from every loaded cell (not just the attacked NPC's)
+		Actor* nearbyActors[ALLY_ALERT_MAX_CANDIDATES];
+		int nearbyCount = SpatialGrid::QueryRadius(attackedNPC->pos.x, attackedNPC->pos.y, attackedNPC->pos.z,
+			ALLY_ALERT_RANGE, nullptr, nullptr, nearbyActors, ALLY_ALERT_MAX_CANDIDATES);
+		
+		// QueryRadius already limited candidates to ALLY_ALERT_RANGE of the
+		// attacked NPC; the attacker check compares squared distances
+		float maxCombatDistanceSq = MaxCombatDistance * MaxCombatDistance;
+		
 		// Scan for nearby mounted NPCs
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		for (int i = 0; i < nearbyCount; i++)
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
+			Actor* potentialAlly = nearbyActors[i];
 			
-			if (!ref) continue;
-			
-			Actor* potentialAlly = DYNAMIC_CAST(ref, TESObjectREFR, Actor);
-			if (!potentialAlly) continue;
+			// ============================================
+			// CRITICAL: CHECK DISTANCE TO ATTACKER (TARGET)
+			// Don't alert allies that are too far from the target
+			// ============================================
+			float dx = potentialAlly->pos.x - attacker->pos.x;
+			float dy = potentialAlly->pos.y - attacker->pos.y;
+			float dz = potentialAlly->pos.z - attacker->pos.z;
+			if ((dx * dx + dy * dy + dz * dz) > maxCombatDistanceSq) continue;
 			
 			// Skip self, attacker, player, dead
 			if (potentialAlly->formID == attackedNPC->formID) continue;
@@ -1904,17 +2143,6 @@ namespace MountedNPCCombatVR
 			// ============================================
 			if (IsNPCOnDisengageCooldown(potentialAlly->formID)) continue;
 			
-			// ============================================
-			// CRITICAL: CHECK DISTANCE TO ATTACKER (TARGET)
-			// Don't alert allies that are too far from the target
-			// ============================================
-			float distanceToTarget = GetDistanceBetween(potentialAlly, attacker);
-			if (distanceToTarget > MaxCombatDistance) continue;
-			
-			// Check distance to attacked ally
-			float distance = GetDistanceBetween(attackedNPC, potentialAlly);
-			if (distance > ALLY_ALERT_RANGE) continue;
-			
 			// Check if ally (same type: guard or soldier)
 			MountedCombatClass allyClass = DetermineCombatClass(potentialAlly);
 			if (allyClass != MountedCombatClass::GuardMelee &&
@@ -1925,12 +2153,26 @@ namespace MountedNPCCombatVR
 			
 			// Check if already tracked with this target
 			MountedNPCData* existingData = GetNPCData(potentialAlly->formID);
-			if (existingData && existingData->isValid)
+			if (existingData && existingData->IsValid())
 			{
-				if (existingData->targetFormID == attacker->formID) continue;
+				if (existingData->TargetFormID() == attacker->formID) continue;
+				
+				// Ally already fighting something alive - only pull it over
+				// if the attacker is not already at MaxAttackersPerTarget
+				if (existingData->TargetFormID() != 0 &&
+					!TargetAllocation::HasFreeAttackSlot(attacker->formID, potentialAlly->formID))
+				{
+					TESForm* currentForm = CountedLookupFormByID(existingData->TargetFormID());
+					if (currentForm && currentForm->formType == kFormType_Character &&
+						!static_cast<Actor*>(currentForm)->IsDead(1))
+					{
+						continue;
+					}
+				}
 				
 				// Update target
-				existingData->targetFormID = attacker->formID;
+				existingData->TargetFormID() = attacker->formID;
+				existingData->allocatedTargetFormID = attacker->formID;
 				SetNPCFollowTarget(potentialAlly, attacker);
 				alliesAlerted++;
 				continue;
@@ -1940,12 +2182,13 @@ namespace MountedNPCCombatVR
 			MountedNPCData* data = GetOrCreateNPCData(potentialAlly);
 			if (!data) continue;
 			
-			data->mountFormID = mount->formID;
-			data->targetFormID = attacker->formID;
+			data->MountFormID() = mount->formID;
+			data->TargetFormID() = attacker->formID;
+			data->allocatedTargetFormID = attacker->formID;
 			data->combatClass = allyClass;
 			data->behavior = MountedBehaviorType::Aggressive;
-			data->state = MountedCombatState::Engaging;
-			data->stateStartTime = GetCurrentGameTime();
+			data->State() = MountedCombatState::Engaging;
+			data->StateStartTime() = GetCurrentGameTime();
 			data->combatStartTime = GetCurrentGameTime();
 			data->weaponDrawn = false;
 			
@@ -1965,76 +2208,49 @@ namespace MountedNPCCombatVR
 		
 		if (alliesAlerted > 0)
 		{
-			_MESSAGE("MountedCombat: Alerted %d nearby allies to attack %08X", alliesAlerted, attacker->formID);
+			ASYNC_MESSAGE("MountedCombat: Alerted %d nearby allies to attack %08X", alliesAlerted, attacker->formID);
 		}
 	}
 	
-	// Find the nearest hostile NPC within range of a mounted guard/soldier
-	Actor* FindNearestHostileTarget(Actor* rider, float maxRange)
+	// Grid predicate for FindNearestHostileTarget (context = the rider)
+	static bool IsHostileTargetCandidate(Actor* potentialTarget, void* context)
 	{
-		if (!rider) return nullptr;
+		Actor* rider = (Actor*)context;
 		
-		TESObjectCELL* cell = rider->parentCell;
-		if (!cell) return nullptr;
+		// Skip self
+		if (potentialTarget == rider) return false;
 		
-		Actor* nearestHostile = nullptr;
-		float nearestDistance = maxRange + 1.0f;
+		// Skip dead actors
+		if (potentialTarget->IsDead(1)) return false;
 		
-		// Iterate through references in the cell
-		for (UInt32 i = 0; i < cell->objectList.count; i++)
+		// Skip player (handled separately)
+		if (g_thePlayer && (*g_thePlayer) && potentialTarget->formID == (*g_thePlayer)->formID) return false;
+		
+		// ============================================
+		// COMPANION HANDLING
+		// Only companions who are hostile to this guard can be targeted
+		// If a companion attacks a guard, the guard CAN target them
+		// ============================================
+		if (IsCompanion(potentialTarget))
 		{
-			TESObjectREFR* ref = nullptr;
-			cell->objectList.GetNthItem(i, ref);
-			
-			if (!ref) continue;
-			
-			Actor* potentialTarget = DYNAMIC_CAST(ref, TESObjectREFR, Actor);
-			if (!potentialTarget) continue;
-			
-			// Skip dead actors
-			if (potentialTarget->IsDead(1)) continue;
-			
-			// Skip player (handled separately)
-			if (g_thePlayer && (*g_thePlayer) && potentialTarget->formID == (*g_thePlayer)->formID) continue;
-			
-			// ============================================
-			// COMPANION HANDLING
-			// Only skip companions who are NOT hostile to this guard
-			// If a companion attacks a guard, the guard CAN target them
-			// ============================================
-			if (IsCompanion(potentialTarget))
-			{
-				// Check if companion is hostile to this guard (attacked them, etc.)
-				// Use the game's IsHostileToActor check
-				bool companionIsHostile = IsActorHostileToActor(potentialTarget, rider);
-				
-				if (!companionIsHostile)
-				{
-					// Companion is friendly - skip them
-					continue;
-				}
-				// else: Companion IS hostile - allow targeting
-			}
-			
-			// Check if this actor is hostile (from our FactionData lists)
-			// OR if it's a hostile companion (already passed the check above)
-			bool isKnownHostile = IsHostileNPC(potentialTarget);
-			bool isHostileCompanion = IsCompanion(potentialTarget) && IsActorHostileToActor(potentialTarget, rider);
-			
-			if (!isKnownHostile && !isHostileCompanion) continue;
-			
-			// Calculate distance
-			float distance = GetDistanceBetween(rider, potentialTarget);
-			
-			// Check if within range and closer than current nearest
-			if (distance <= maxRange && distance < nearestDistance)
-			{
-				nearestHostile = potentialTarget;
-				nearestDistance = distance;
-			}
+			// Use the game's IsHostileToActor check
+			return IsActorHostileToActor(potentialTarget, rider);
 		}
 		
-		return nearestHostile;
+		// Check if this actor is hostile (from our FactionData lists)
+		return IsHostileNPC(potentialTarget);
+	}
+	
+	// Find the nearest hostile NPC within range of a mounted guard/soldier
+	// Searches every loaded cell the spatial grid knows about, so hostiles
+	// just across a cell border are found too
+	Actor* FindNearestHostileTarget(Actor* rider, float maxRange)
+	{
+		if (!rider) return nullptr;
+		if (!rider->parentCell) return nullptr;
+		
+		return SpatialGrid::FindNearest(rider->pos.x, rider->pos.y, rider->pos.z, maxRange,
+			IsHostileTargetCandidate, rider);
 	}
 	
 	// Force a mounted NPC into combat with a target
@@ -2050,7 +2266,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Set target
-		data->targetFormID = target->formID;
+		data->TargetFormID() = target->formID;
 		
 		// Determine combat class if not set
 		if (data->combatClass == MountedCombatClass::None)
@@ -2079,8 +2295,8 @@ namespace MountedNPCCombatVR
 		data->weaponDrawn = false;
 		
 		// Set initial state
-		data->state = MountedCombatState::Engaging;
-		data->stateStartTime = GetCurrentGameTime();
+		data->State() = MountedCombatState::Engaging;
+		data->StateStartTime() = GetCurrentGameTime();
 		
 		// Inject follow package
 		SetNPCFollowTarget(rider, target);
@@ -2113,12 +2329,23 @@ namespace MountedNPCCombatVR
 			return;
 		}
 		
+		// ============================================
+		// BUILD ONE ALLOCATION PROBLEM FOR ALL GUARDS/SOLDIERS
+		// (see TargetAllocation.h)
+		// ============================================
+		TargetAllocation::BeginAllocation();
+		
+		Actor* bidders[MAX_TRACKED_NPCS_ARRAY];
+		int bidderIndex[MAX_TRACKED_NPCS_ARRAY];
+		UInt32 bidderCurrentTarget[MAX_TRACKED_NPCS_ARRAY];
+		int bidderCount = 0;
+		
 		// Scan all tracked mounted NPCs
 		for (int i = 0; i < MAX_TRACKED_NPCS_ARRAY; i++)
 		{
-			MountedNPCData* data = &g_trackedNPCs[i];
+			if (!g_riderColumns.valid[i]) continue;
 			
-			if (!data->isValid) continue;
+			MountedNPCData* data = &g_trackedNPCs[i];
 			
 			// Only guards and soldiers scan for hostiles
 		 if (data->combatClass != MountedCombatClass::GuardMelee &&
@@ -2127,16 +2354,19 @@ namespace MountedNPCCombatVR
 				continue;
 			}
 			
-			TESForm* riderForm = LookupFormByID(data->actorFormID);
+			TESForm* riderForm = CountedLookupFormByID(data->ActorFormID());
 			if (!riderForm) continue;
 			
 			Actor* rider = DYNAMIC_CAST(riderForm, TESForm, Actor);
 			if (!rider) continue;
 			
+			Actor* currentTarget = nullptr;
+			
 			// ============================================
 			// CHECK RIDER'S ACTUAL COMBAT TARGET FROM GAME
 			// If the game has set a combat target, RESPECT IT
 			// Don't override game AI target selection
+			// (a target we picked ourselves can still be rebalanced)
 			// ============================================
 			UInt32 combatTargetHandle = rider->currentCombatTarget;
 			if (combatTargetHandle != 0)
@@ -2148,13 +2378,18 @@ namespace MountedNPCCombatVR
 					Actor* actualTarget = static_cast<Actor*>(targetRef.get());
 					if (actualTarget && !actualTarget->IsDead(1))
 					{
-						// Rider has a valid combat target from the game - update our tracking
-						if (data->targetFormID != actualTarget->formID)
+						if (actualTarget->formID != data->allocatedTargetFormID)
 						{
-							data->targetFormID = actualTarget->formID;
+							// Game-chosen target - update our tracking, it uses up a slot
+							if (data->TargetFormID() != actualTarget->formID)
+							{
+								data->TargetFormID() = actualTarget->formID;
+							}
+							TargetAllocation::AddFixedAttacker(actualTarget->formID);
+							continue;
 						}
-						// Rider already has a target - skip scanning for new ones
-						continue;
+						
+						currentTarget = actualTarget;
 					}
 				}
 			}
@@ -2162,69 +2397,85 @@ namespace MountedNPCCombatVR
 			// ============================================
 			// CHECK IF STORED TARGET IS STILL VALID
 			// ============================================
-			bool needsNewTarget = false;
-			
-			if (data->targetFormID == 0)
-			{
-				needsNewTarget = true;
-			}
-			else if (data->targetFormID == 0x14)
+			if (!currentTarget)
 			{
-				// Targeting player - check if player is genuinely hostile
-				bool playerIsGenuinelyHostile = false;
-				if (combatTargetHandle != 0)
+				if (data->TargetFormID() == 0x14)
 				{
-					NiPointer<TESObjectREFR> targetRef;
-					LookupREFRByHandle(combatTargetHandle, targetRef);
-					if (targetRef && targetRef->formID == 0x14)
+					// Targeting player - check if player is genuinely hostile
+					bool playerIsGenuinelyHostile = false;
+					if (combatTargetHandle != 0)
 					{
-						playerIsGenuinelyHostile = true;
+						NiPointer<TESObjectREFR> targetRef;
+						LookupREFRByHandle(combatTargetHandle, targetRef);
+						if (targetRef && targetRef->formID == 0x14)
+						{
+							playerIsGenuinelyHostile = true;
+						}
 					}
-				}
-				
-				if (!playerIsGenuinelyHostile)
-				{
-					needsNewTarget = true;
-				}
-				else
-				{
-					continue;  // Player is hostile, keep targeting them
-				}
-			}
-			else
-			{
-				// Verify non-player target is still valid and alive
-				TESForm* targetForm = LookupFormByID(data->targetFormID);
-				if (targetForm && targetForm->formType == kFormType_Character)
-				{
-					Actor* currentTarget = static_cast<Actor*>(targetForm);
-					if (currentTarget->IsDead(1))
+					
+					if (playerIsGenuinelyHostile)
 					{
-						needsNewTarget = true;
-						data->targetFormID = 0;
+						TargetAllocation::AddFixedAttacker(0x14);
+						continue;  // Player is hostile, keep targeting them
 					}
-					// else: target is alive - continue with current target, no need for new one
 				}
-				else
+				else if (data->TargetFormID() != 0)
 				{
-					needsNewTarget = true;
-					data->targetFormID = 0;
+					// Verify non-player target is still valid and alive
+					TESForm* targetForm = CountedLookupFormByID(data->TargetFormID());
+					if (targetForm && targetForm->formType == kFormType_Character &&
+						!static_cast<Actor*>(targetForm)->IsDead(1))
+					{
+						currentTarget = static_cast<Actor*>(targetForm);
+					}
+					else
+					{
+						data->TargetFormID() = 0;
+					}
 				}
 			}
 			
-			if (!needsNewTarget) continue;
+			// Bid for a target (using config value for range)
+			int index = TargetAllocation::AddRider(rider, currentTarget, HostileDetectionRange,
+				IsHostileTargetCandidate, rider);
+			if (index < 0) continue;
 			
-			// Find nearest hostile (using config value)
-			Actor* hostile = FindNearestHostileTarget(rider, HostileDetectionRange);
-			if (hostile)
+			bidders[bidderCount] = rider;
+			bidderIndex[bidderCount] = index;
+			bidderCurrentTarget[bidderCount] = currentTarget ? currentTarget->formID : 0;
+			bidderCount++;
+		}
+		
+		if (bidderCount == 0) return;
+		
+		TargetAllocation::Solve();
+		
+		// ============================================
+		// APPLY - only riders whose target changed are touched
+		// ============================================
+		for (int b = 0; b < bidderCount; b++)
+		{
+			Actor* rider = bidders[b];
+			Actor* hostile = TargetAllocation::GetAssignedTarget(bidderIndex[b]);
+			if (!hostile) continue;
+			if (hostile->formID == bidderCurrentTarget[b]) continue;
+			
+			// Clear any existing follow behavior first if switching targets
+			if (rider->IsInCombat())
 			{
-				// Clear any existing follow behavior first if switching targets
-				if (rider->IsInCombat())
-				{
-					ClearNPCFollowTarget(rider);
-				}
-				
-				EngageHostileTarget(rider, hostile);
+				ClearNPCFollowTarget(rider);
+			}
+			
+			if (bidderCurrentTarget[b] != 0)
+			{
+				_MESSAGE("MountedCombat: Guard %08X reassigned %08X -> %08X (spreading attackers)",
+					rider->formID, bidderCurrentTarget[b], hostile->formID);
+			}
+			
+			if (EngageHostileTarget(rider, hostile))
+			{
+				MountedNPCData* data = GetNPCData(rider->formID);
+				if (data) data->allocatedTargetFormID = hostile->formID;
 			}
 			// NOTE: Removed the "stop combat" logic here
 			// If rider has no hostile target but is still in combat (e.g., vs companion),
@@ -2298,7 +2549,7 @@ namespace MountedNPCCombatVR
 		if (g_sprintIdlesInitialized) return;
 		
 		// Silently load horse animations - only log errors
-		TESForm* sprintStartForm = LookupFormByID(HORSE_SPRINT_START_FORMID);
+		TESForm* sprintStartForm = CountedLookupFormByID(HORSE_SPRINT_START_FORMID);
 		if (sprintStartForm)
 		{
 			g_horseSprintStart = DYNAMIC_CAST(sprintStartForm, TESForm, TESIdleForm);
@@ -2308,7 +2559,7 @@ namespace MountedNPCCombatVR
 			_MESSAGE("MountedCombat: ERROR - Could not find HORSE_SPRINT_START");
 			}
 		
-		TESForm* sprintStopForm = LookupFormByID(HORSE_SPRINT_STOP_FORMID);
+		TESForm* sprintStopForm = CountedLookupFormByID(HORSE_SPRINT_STOP_FORMID);
 		if (sprintStopForm)
 		{
 			g_horseSprintStop = DYNAMIC_CAST(sprintStopForm, TESForm, TESIdleForm);
@@ -2318,7 +2569,7 @@ namespace MountedNPCCombatVR
 			_MESSAGE("MountedCombat: ERROR - Could not find HORSE_SPRINT_STOP");
 		}
 		
-		TESForm* rearUpForm = LookupFormByID(HORSE_REAR_UP_FORMID);
+		TESForm* rearUpForm = CountedLookupFormByID(HORSE_REAR_UP_FORMID);
 		if (rearUpForm)
 		{
 			g_horseRearUp = DYNAMIC_CAST(rearUpForm, TESForm, TESIdleForm);
@@ -2471,6 +2722,10 @@ namespace MountedNPCCombatVR
 			g_horseJumpData[i].horseFormID = 0;
 		}
 		
+		// Forget the untracked-NPC scan position
+		g_untrackedScanCursor.Reset();
+		g_untrackedScanHeld = false;
+		
 		g_singleCombatInitialized = false;
 	}
 	
@@ -12,7 +12,7 @@ namespace MountedNPCCombatVR
 	// ============================================
 	
 	extern float g_updateInterval;
-	extern const int MAX_TRACKED_NPCS;
+	const int MAX_TRACKED_NPCS = 10;  // Rider table capacity (runtime limit is MaxTrackedMountedNPCs)
 	extern const float FLEE_SAFE_DISTANCE;
 	
 	// ============================================
@@ -68,59 +68,80 @@ namespace MountedNPCCombatVR
 		Passive
 	};
 
-	// ============================================
-	// Combat State
-	// ============================================
-	
-	enum class MountedCombatState
+	// MountedCombatState is declared in CombatDecisions.h
+	
+	// ============================================
+	// Rider Table (hot columns + cold records)
+	// ============================================
+	// MountedNPCData used to hold everything about a rider in one struct:
+	// the fields read every tick (state, timers, target) next to ones set
+	// once per engagement (the full MountedWeaponInfo, behavior, combat
+	// class). Every formID lookup and every "all riders" scan (attack slot
+	// counts, encounter graph, spatial grid cells) strided over the cold
+	// bytes to reach the few fields it compared.
+	//
+	// Riders now live in one table addressed by a dense rider index
+	// (0..MAX_TRACKED_NPCS-1, stable while the rider is tracked):
+	// - RiderHotColumns: the per-tick fields, one contiguous array per
+	//   field (SoA). Scans walk only the column they compare.
+	// - MountedNPCData: the cold record for the same index, plus
+	//   accessors that read/write the rider's hot columns.
+	//
+	// MountedNPCData pointers are only handed out for tracked riders, so
+	// riderIndex is always valid. Scanners outside MountedCombat may read
+	// g_riderColumns directly (check valid[i] first).
+	// GAME THREAD ONLY.
+	// ============================================
+	
+	struct RiderHotColumns
 	{
-		None,
-		Engaging,
-		Attacking,
-		Circling,
-		Charging,
-		RangedAttack,
-		Fleeing,
-		Retreating
+		UInt32 actorFormID[MAX_TRACKED_NPCS];
+		UInt32 mountFormID[MAX_TRACKED_NPCS];
+		UInt32 targetFormID[MAX_TRACKED_NPCS];
+		MountedCombatState state[MAX_TRACKED_NPCS];
+		float stateStartTime[MAX_TRACKED_NPCS];
+		float lastUpdateTime[MAX_TRACKED_NPCS];
+		bool valid[MAX_TRACKED_NPCS];
 	};
 	
-	// ============================================
-	// Mounted NPC Data
-	// ============================================
+	extern RiderHotColumns g_riderColumns;
 	
 	struct MountedNPCData
 	{
-		UInt32 actorFormID;
-		UInt32 mountFormID;
-		UInt32 targetFormID;
-		MountedCombatState state;
+		int riderIndex;                // Slot in g_riderColumns
+		UInt32 allocatedTargetFormID;  // Target we picked (TargetAllocation may move it); 0 = game-chosen
 		MountedBehaviorType behavior;
 		MountedCombatClass combatClass;
 		MountedWeaponInfo weaponInfo;
-		float stateStartTime;
-		float lastUpdateTime;
 		float combatStartTime;
 		bool weaponDrawn;
-		bool isValid;
 		
 		MountedNPCData() : 
-			actorFormID(0), mountFormID(0), targetFormID(0),
-			state(MountedCombatState::None), behavior(MountedBehaviorType::Unknown),
+			riderIndex(0), allocatedTargetFormID(0),
+			behavior(MountedBehaviorType::Unknown),
 			combatClass(MountedCombatClass::None), weaponInfo(),
-			stateStartTime(0.0f), lastUpdateTime(0.0f), combatStartTime(0.0f),
-			weaponDrawn(false), isValid(false) 
+			combatStartTime(0.0f), weaponDrawn(false)
 		{}
 		
-		void Reset()
+		// Cold fields only (the table resets the hot columns)
+		void ResetCold()
 		{
-			actorFormID = 0; mountFormID = 0; targetFormID = 0;
-			state = MountedCombatState::None;
+			allocatedTargetFormID = 0;
 			behavior = MountedBehaviorType::Unknown;
 			combatClass = MountedCombatClass::None;
 			weaponInfo = MountedWeaponInfo();
-			stateStartTime = 0.0f; lastUpdateTime = 0.0f; combatStartTime = 0.0f;
-			weaponDrawn = false; isValid = false;
+			combatStartTime = 0.0f;
+			weaponDrawn = false;
 		}
+		
+		// Hot fields (stored in g_riderColumns)
+		UInt32 ActorFormID() const { return g_riderColumns.actorFormID[riderIndex]; }
+		UInt32& MountFormID() { return g_riderColumns.mountFormID[riderIndex]; }
+		UInt32& TargetFormID() { return g_riderColumns.targetFormID[riderIndex]; }
+		MountedCombatState& State() { return g_riderColumns.state[riderIndex]; }
+		float& StateStartTime() { return g_riderColumns.stateStartTime[riderIndex]; }
+		float& LastUpdateTime() { return g_riderColumns.lastUpdateTime[riderIndex]; }
+		bool IsValid() const { return g_riderColumns.valid[riderIndex]; }
 	};
 
 	// ============================================
@@ -140,7 +161,8 @@ namespace MountedNPCCombatVR
 	
 	MountedNPCData* GetOrCreateNPCData(Actor* actor);
 	MountedNPCData* GetNPCData(UInt32 formID);
-	MountedNPCData* GetNPCDataByIndex(int index);  // For iteration
+	MountedNPCData* GetNPCDataByIndex(int index);  // Rider index; nullptr if the slot is free
+	int GetRiderIndex(UInt32 actorFormID);         // -1 if not tracked
 	void RemoveNPCFromTracking(UInt32 formID);
 	bool IsNPCTracked(UInt32 formID);
 	int GetTrackedNPCCount();
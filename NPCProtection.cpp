@@ -1,5 +1,6 @@
 #include "NPCProtection.h"
 #include "Helper.h"
+#include "PerfCounters.h"
 #include <set>
 #include <map>
 #include <mutex>
@@ -350,7 +351,7 @@ namespace MountedNPCCombatVR
 			if (!expiredEntries[i].shouldRestore) continue;
 			
 			// Look up actor and restore mass
-			TESForm* form = LookupFormByID(formID);
+			TESForm* form = CountedLookupFormByID(formID);
 			if (form && form->formType == kFormType_Character)
 			{
 				Actor* actor = static_cast<Actor*>(form);
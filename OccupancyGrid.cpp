@@ -0,0 +1,257 @@
+#include "OccupancyGrid.h"
+#include "EncounterGraph.h"
+#include "SpatialGrid.h"
+#include "HazardMap.h"
+#include "GroundHeight.h"  // For GetCellWorldSpaceID
+#include "PerfCounters.h"
+#include <cmath>
+#include <cstring>
+
+namespace MountedNPCCombatVR
+{
+	namespace Occupancy
+	{
+		const int OCC_SNAP_CELLS = (int)(OCC_ORIGIN_SNAP / OCC_CELL_SIZE);
+
+		// ============================================
+		// ENCOUNTER GRIDS
+		// ============================================
+
+		struct EncounterGrid
+		{
+			OccupancyGrid grid;
+			UInt32 anchorFormID;    // Lowest rider FormID of the encounter that owns the grid
+			UInt32 mountFormIDs[Encounters::ENCOUNTER_MAX_RIDERS];
+			Footprint mountFootprints[Encounters::ENCOUNTER_MAX_RIDERS];
+			int mountCount;
+			UInt32 hazardWorldSpace;
+			bool hazardValid;
+			bool isValid;           // Stamped this tick
+		};
+
+		// An encounter's mounted riders, gathered before grids are assigned
+		struct PendingGrid
+		{
+			UInt32 anchorFormID;
+			UInt32 riderFormIDs[Encounters::ENCOUNTER_MAX_RIDERS];
+			Actor* mounts[Encounters::ENCOUNTER_MAX_RIDERS];
+			int mountCount;
+			int gridIndex;
+		};
+
+		static EncounterGrid g_grids[OCC_MAX_GRIDS];
+
+		// Known hazard squares into the hazard layer (OCC_ORIGIN_SNAP squares)
+		static void RebuildHazardLayer(EncounterGrid& entry, TESObjectCELL* cell)
+		{
+			OccupancyGrid& grid = entry.grid;
+			memset(grid.hazards, 0, sizeof(grid.hazards));
+
+			for (int row = 0; row < OCC_GRID_DIM; row += OCC_SNAP_CELLS)
+			{
+				for (int col = 0; col < OCC_GRID_DIM; col += OCC_SNAP_CELLS)
+				{
+					float x = grid.originX + (col + OCC_SNAP_CELLS * 0.5f) * OCC_CELL_SIZE;
+					float y = grid.originY + (row + OCC_SNAP_CELLS * 0.5f) * OCC_CELL_SIZE;
+
+					if (!HazardMap::IsHazardAt(cell, x, y, HazardMap::HAZARD_STUCK) &&
+						!HazardMap::IsHazardAt(cell, x, y, HazardMap::HAZARD_DROP))
+					{
+						continue;
+					}
+
+					for (int r = row; r < row + OCC_SNAP_CELLS && r < OCC_GRID_DIM; r++)
+					{
+						for (int c = col; c < col + OCC_SNAP_CELLS && c < OCC_GRID_DIM; c++)
+						{
+							grid.hazards[r * OCC_GRID_DIM + c] = 1;
+						}
+					}
+				}
+			}
+
+			entry.hazardWorldSpace = GroundHeight::GetCellWorldSpaceID(cell);
+			entry.hazardValid = true;
+		}
+
+		// Mounted riders of an encounter. False if none is mounted.
+		static bool GatherEncounter(int encounterId, PendingGrid& out)
+		{
+			UInt32 riderFormIDs[Encounters::ENCOUNTER_MAX_RIDERS];
+			int riderCount = Encounters::GetEncounterRiders(encounterId, riderFormIDs, Encounters::ENCOUNTER_MAX_RIDERS);
+
+			out.anchorFormID = 0;
+			out.mountCount = 0;
+			out.gridIndex = -1;
+
+			for (int r = 0; r < riderCount; r++)
+			{
+				TESForm* form = CountedLookupFormByID(riderFormIDs[r]);
+				if (!form || form->formType != kFormType_Character) continue;
+				Actor* rider = static_cast<Actor*>(form);
+
+				NiPointer<Actor> mount;
+				if (!CALL_MEMBER_FN(rider, GetMount)(mount) || !mount) continue;
+
+				out.riderFormIDs[out.mountCount] = rider->formID;
+				out.mounts[out.mountCount] = mount.get();
+				out.mountCount++;
+
+				if (out.anchorFormID == 0 || rider->formID < out.anchorFormID)
+				{
+					out.anchorFormID = rider->formID;
+				}
+			}
+
+			return out.mountCount > 0;
+		}
+
+		static bool IsEncounterMember(const PendingGrid& pending, UInt32 formID)
+		{
+			for (int m = 0; m < pending.mountCount; m++)
+			{
+				if (pending.riderFormIDs[m] == formID || pending.mounts[m]->formID == formID) return true;
+			}
+			return false;
+		}
+
+		static void StampEncounter(EncounterGrid& entry, const PendingGrid& pending)
+		{
+			float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+			for (int m = 0; m < pending.mountCount; m++)
+			{
+				sumX += pending.mounts[m]->pos.x;
+				sumY += pending.mounts[m]->pos.y;
+				sumZ += pending.mounts[m]->pos.z;
+			}
+
+			float centerX = sumX / pending.mountCount;
+			float centerY = sumY / pending.mountCount;
+			float centerZ = sumZ / pending.mountCount;
+			TESObjectCELL* cell = pending.mounts[0]->parentCell;
+
+			OccupancyGrid& grid = entry.grid;
+			bool moved = ClearGrid(grid, centerX, centerY);
+
+			if (moved || !entry.hazardValid || entry.hazardWorldSpace != GroundHeight::GetCellWorldSpaceID(cell))
+			{
+				RebuildHazardLayer(entry, cell);
+			}
+
+			// Everyone else in the grid's footprint (corner to corner). The
+			// encounter's own riders and mounts are stamped once, below.
+			Actor* nearby[OCC_MAX_ACTORS];
+			int nearbyCount = SpatialGrid::QueryRadius(centerX, centerY, centerZ, OCC_GRID_SPAN * 0.7072f,
+				nullptr, nullptr, nearby, OCC_MAX_ACTORS);
+
+			for (int i = 0; i < nearbyCount; i++)
+			{
+				if (nearby[i]->IsDead(1)) continue;
+				if (IsEncounterMember(pending, nearby[i]->formID)) continue;
+				StampDisc(grid, grid.actors, nearby[i]->pos.x, nearby[i]->pos.y, 0);
+			}
+
+			entry.mountCount = pending.mountCount;
+			for (int m = 0; m < pending.mountCount; m++)
+			{
+				Footprint& footprint = entry.mountFootprints[m];
+				footprint.x = pending.mounts[m]->pos.x;
+				footprint.y = pending.mounts[m]->pos.y;
+				footprint.radiusCells = OCC_MOUNT_RADIUS;
+
+				entry.mountFormIDs[m] = pending.mounts[m]->formID;
+				StampDisc(grid, grid.actors, footprint.x, footprint.y, footprint.radiusCells);
+			}
+
+			entry.anchorFormID = pending.anchorFormID;
+			entry.isValid = true;
+		}
+
+		void UpdateOccupancyGrids()
+		{
+			// Mounted encounters (first OCC_MAX_GRIDS)
+			static PendingGrid s_pending[OCC_MAX_GRIDS];
+			int pendingCount = 0;
+
+			int encounterCount = Encounters::GetEncounterCount();
+			for (int e = 0; e < encounterCount && pendingCount < OCC_MAX_GRIDS; e++)
+			{
+				if (GatherEncounter(e, s_pending[pendingCount])) pendingCount++;
+			}
+
+			bool claimed[OCC_MAX_GRIDS] = {};
+			for (int g = 0; g < OCC_MAX_GRIDS; g++)
+			{
+				g_grids[g].isValid = false;
+			}
+
+			// Same anchor as last tick keeps its grid (origin and hazard layer)
+			for (int p = 0; p < pendingCount; p++)
+			{
+				for (int g = 0; g < OCC_MAX_GRIDS; g++)
+				{
+					if (!claimed[g] && g_grids[g].anchorFormID == s_pending[p].anchorFormID)
+					{
+						s_pending[p].gridIndex = g;
+						claimed[g] = true;
+						break;
+					}
+				}
+			}
+
+			// New anchors take a free grid; its hazard layer belongs to someone else
+			for (int p = 0; p < pendingCount; p++)
+			{
+				if (s_pending[p].gridIndex >= 0) continue;
+
+				for (int g = 0; g < OCC_MAX_GRIDS; g++)
+				{
+					if (!claimed[g])
+					{
+						s_pending[p].gridIndex = g;
+						claimed[g] = true;
+						g_grids[g].hazardValid = false;
+						break;
+					}
+				}
+			}
+
+			for (int p = 0; p < pendingCount; p++)
+			{
+				StampEncounter(g_grids[s_pending[p].gridIndex], s_pending[p]);
+			}
+		}
+
+		bool FindClearLateralOffset(Actor* horse, float heading, int preferredSign, float& outLateral)
+		{
+			if (!horse) return false;
+
+			for (int g = 0; g < OCC_MAX_GRIDS; g++)
+			{
+				const EncounterGrid& entry = g_grids[g];
+				if (!entry.isValid) continue;
+
+				for (int m = 0; m < entry.mountCount; m++)
+				{
+					if (entry.mountFormIDs[m] != horse->formID) continue;
+
+					return FindClearLateralOffsetInGrid(entry.grid, horse->pos.x, horse->pos.y, heading,
+						preferredSign, outLateral, &entry.mountFootprints[m]);
+				}
+			}
+
+			return false;
+		}
+
+		void ResetOccupancyGrids()
+		{
+			for (int i = 0; i < OCC_MAX_GRIDS; i++)
+			{
+				g_grids[i].isValid = false;
+				g_grids[i].hazardValid = false;
+				g_grids[i].anchorFormID = 0;
+				g_grids[i].mountCount = 0;
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// OCCUPANCY GRID (per-encounter steer-around map)
+	// ============================================
+	// When a horse was CollisionBlocked, recovery re-injected packages
+	// and turned the horse based on ObstructionSide alone, which was often
+	// a guess (Front / Unknown). Nothing knew where the other horses,
+	// riders and known hazards actually were.
+	//
+	// Each active encounter gets a small grid (OCC_GRID_DIM x OCC_GRID_DIM
+	// cells of OCC_CELL_SIZE units) centred on its riders. The grid rolls
+	// with the encounter: the origin is snapped to hazard-square multiples,
+	// so it only shifts in whole squares. Every tick it is cleared and
+	// stamped from the spatial grid's actor snapshot (mounts with a wider
+	// footprint). Known hazard squares (HazardMap) are kept in a second
+	// layer that is only rebuilt when the origin moves.
+	//
+	// Encounter ids are rebuilt every tick, so grids are not indexed by
+	// them. A grid belongs to the encounter's anchor (its lowest rider
+	// FormID) and keeps its origin and hazard layer while that rider
+	// stays in the encounter. Queries find the horse in the grid's mount
+	// list, so they always use the grid the horse was stamped into.
+	//
+	// The actor layer counts stamps per cell. A query passes the horse's
+	// own footprint, which is subtracted, so a horse never blocks its own
+	// lanes.
+	//
+	// FindClearLateralOffset walks lanes to the left and right of a horse's
+	// heading (nearest first) and returns the first lane whose path is
+	// clear in the grid. That is O(grid) at worst, with no engine raycasts.
+	//
+	// The grid functions (ClearGrid / StampDisc / IsPathClear /
+	// FindClearLateralOffsetInGrid) do not touch the engine; they live in
+	// OccupancyGridMath.cpp (tests/OccupancyGridTest.cpp,
+	// tests/OccupancyGridBench.cpp).
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace Occupancy
+	{
+		const int OCC_GRID_DIM = 32;                  // Cells per edge (4096 units)
+		const float OCC_CELL_SIZE = 128.0f;
+		const float OCC_ORIGIN_SNAP = 256.0f;         // Same as a hazard-map square
+		const int OCC_MAX_GRIDS = 8;                  // Encounters with a grid
+		const int OCC_MAX_ACTORS = 128;               // Actors stamped per grid
+		const int OCC_MOUNT_RADIUS = 1;               // Footprint (cells) of a tracked mount
+		const float OCC_SELF_CLEARANCE = 200.0f;      // Lanes start this far ahead (skips whatever the horse is pressed against)
+		const float OCC_LOOKAHEAD = 448.0f;           // Lane end distance ahead
+		const int OCC_LATERAL_STEPS = 6;              // Lanes tried per side
+		const float OCC_LATERAL_STEP = 128.0f;        // Lateral spacing between lanes
+		const float OCC_GRID_SPAN = OCC_GRID_DIM * OCC_CELL_SIZE;
+
+		struct OccupancyGrid
+		{
+			float originX;     // South-west corner
+			float originY;
+			UInt8 actors[OCC_GRID_DIM * OCC_GRID_DIM];   // Stamp counts, restamped every tick
+			UInt8 hazards[OCC_GRID_DIM * OCC_GRID_DIM];  // Rebuilt when the origin moves
+		};
+
+		// A disc stamped with StampDisc (the querying horse's own stamp)
+		struct Footprint
+		{
+			float x;
+			float y;
+			int radiusCells;
+		};
+
+		// ============================================
+		// GRID FUNCTIONS (engine independent)
+		// ============================================
+
+		// Re-centre on (x, y) and clear the actor layer. Returns true if the
+		// origin moved (the hazard layer must be rebuilt).
+		bool ClearGrid(OccupancyGrid& grid, float centerX, float centerY);
+
+		// Add one stamp to the cells within radiusCells of (x, y) in a layer
+		void StampDisc(OccupancyGrid& grid, UInt8* layer, float x, float y, int radiusCells);
+
+		// True if (x, y) is occupied in either layer (outside the grid = free).
+		// 'self' (may be nullptr) is left out of the actor count.
+		bool IsBlockedAt(const OccupancyGrid& grid, float x, float y, const Footprint* self = nullptr);
+
+		// True if no occupied cell lies on the segment
+		bool IsPathClear(const OccupancyGrid& grid, float x0, float y0, float x1, float y1,
+			const Footprint* self = nullptr);
+
+		// Nearest clear lane beside a heading. outLateral > 0 = right, < 0 = left.
+		// preferredSign (+1 / -1 / 0) breaks ties between equally near lanes.
+		bool FindClearLateralOffsetInGrid(const OccupancyGrid& grid, float x, float y, float heading,
+			int preferredSign, float& outLateral, const Footprint* self = nullptr);
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Rebuild the grids for this tick (after Encounters::UpdateEncounters)
+		void UpdateOccupancyGrids();
+
+		// Clear lane for a horse in its encounter's grid (false if no grid / no lane)
+		bool FindClearLateralOffset(Actor* horse, float heading, int preferredSign, float& outLateral);
+
+		// Drop all grids (mod deactivate)
+		void ResetOccupancyGrids();
+	}
+}
@@ -0,0 +1,149 @@
+#include "OccupancyGrid.h"
+#include <cmath>
+#include <cstring>
+
+// Grid functions for OccupancyGrid. Engine independent so they can be
+// built and tested on their own; see tests/OccupancyGridTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace Occupancy
+	{
+		// ============================================
+		// GRID FUNCTIONS
+		// ============================================
+
+		static bool CellAt(const OccupancyGrid& grid, float x, float y, int& outCol, int& outRow)
+		{
+			float fx = (x - grid.originX) / OCC_CELL_SIZE;
+			float fy = (y - grid.originY) / OCC_CELL_SIZE;
+			if (fx < 0.0f || fy < 0.0f) return false;
+
+			int col = (int)fx;
+			int row = (int)fy;
+			if (col >= OCC_GRID_DIM || row >= OCC_GRID_DIM) return false;
+
+			outCol = col;
+			outRow = row;
+			return true;
+		}
+
+		// Same cell test StampDisc uses (corners rounded off)
+		static bool IsInDisc(int dc, int dr, int radiusCells)
+		{
+			if (dr < -radiusCells || dr > radiusCells || dc < -radiusCells || dc > radiusCells) return false;
+			return dr * dr + dc * dc <= radiusCells * radiusCells + radiusCells;
+		}
+
+		static void DiscCenterCell(const OccupancyGrid& grid, float x, float y, int& outCol, int& outRow)
+		{
+			outCol = (int)floorf((x - grid.originX) / OCC_CELL_SIZE);
+			outRow = (int)floorf((y - grid.originY) / OCC_CELL_SIZE);
+		}
+
+		bool ClearGrid(OccupancyGrid& grid, float centerX, float centerY)
+		{
+			float originX = floorf(centerX / OCC_ORIGIN_SNAP) * OCC_ORIGIN_SNAP - OCC_GRID_SPAN * 0.5f;
+			float originY = floorf(centerY / OCC_ORIGIN_SNAP) * OCC_ORIGIN_SNAP - OCC_GRID_SPAN * 0.5f;
+
+			bool moved = (originX != grid.originX || originY != grid.originY);
+			grid.originX = originX;
+			grid.originY = originY;
+			memset(grid.actors, 0, sizeof(grid.actors));
+			return moved;
+		}
+
+		void StampDisc(OccupancyGrid& grid, UInt8* layer, float x, float y, int radiusCells)
+		{
+			int centerCol, centerRow;
+			DiscCenterCell(grid, x, y, centerCol, centerRow);
+
+			for (int dr = -radiusCells; dr <= radiusCells; dr++)
+			{
+				int row = centerRow + dr;
+				if (row < 0 || row >= OCC_GRID_DIM) continue;
+
+				for (int dc = -radiusCells; dc <= radiusCells; dc++)
+				{
+					int col = centerCol + dc;
+					if (col < 0 || col >= OCC_GRID_DIM) continue;
+					if (!IsInDisc(dc, dr, radiusCells)) continue;
+
+					UInt8& cell = layer[row * OCC_GRID_DIM + col];
+					if (cell < 255) cell++;
+				}
+			}
+		}
+
+		bool IsBlockedAt(const OccupancyGrid& grid, float x, float y, const Footprint* self)
+		{
+			int col, row;
+			if (!CellAt(grid, x, y, col, row)) return false;
+
+			int index = row * OCC_GRID_DIM + col;
+			if (grid.hazards[index]) return true;
+
+			int count = grid.actors[index];
+			if (self && count > 0)
+			{
+				int selfCol, selfRow;
+				DiscCenterCell(grid, self->x, self->y, selfCol, selfRow);
+				if (IsInDisc(col - selfCol, row - selfRow, self->radiusCells)) count--;
+			}
+			return count > 0;
+		}
+
+		bool IsPathClear(const OccupancyGrid& grid, float x0, float y0, float x1, float y1, const Footprint* self)
+		{
+			float dx = x1 - x0;
+			float dy = y1 - y0;
+			float length = sqrtf(dx * dx + dy * dy);
+
+			// Half-cell steps so no cell on the segment is skipped
+			int steps = (int)(length / (OCC_CELL_SIZE * 0.5f)) + 1;
+			for (int i = 0; i <= steps; i++)
+			{
+				float t = (float)i / (float)steps;
+				if (IsBlockedAt(grid, x0 + dx * t, y0 + dy * t, self)) return false;
+			}
+			return true;
+		}
+
+		bool FindClearLateralOffsetInGrid(const OccupancyGrid& grid, float x, float y, float heading,
+			int preferredSign, float& outLateral, const Footprint* self)
+		{
+			float fwdX = sinf(heading);
+			float fwdY = cosf(heading);
+			float rightX = cosf(heading);
+			float rightY = -sinf(heading);
+
+			int firstSign = (preferredSign < 0) ? -1 : 1;
+
+			for (int step = 1; step <= OCC_LATERAL_STEPS; step++)
+			{
+				for (int pass = 0; pass < 2; pass++)
+				{
+					float lateral = (pass == 0 ? firstSign : -firstSign) * step * OCC_LATERAL_STEP;
+
+					float endX = x + fwdX * OCC_LOOKAHEAD + rightX * lateral;
+					float endY = y + fwdY * OCC_LOOKAHEAD + rightY * lateral;
+
+					// Start a little ahead, on the way to the lane
+					float dirX = endX - x;
+					float dirY = endY - y;
+					float dirLength = sqrtf(dirX * dirX + dirY * dirY);
+					float startX = x + dirX / dirLength * OCC_SELF_CLEARANCE;
+					float startY = y + dirY / dirLength * OCC_SELF_CLEARANCE;
+
+					if (IsPathClear(grid, startX, startY, endX, endY, self))
+					{
+						outLateral = lateral;
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+	}
+}
@@ -0,0 +1,272 @@
+#include "PerfCounters.h"
+#include "Profiler.h"      // For NowNs
+#include "AsyncLogger.h"
+#include "Helper.h"
+#include "config.h"
+#include "skse64/GameMenus.h"
+#include "skse64/PapyrusNativeFunctions.h"
+#include "skse64/PapyrusVM.h"
+#include <shlobj.h>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace MountedNPCCombatVR
+{
+	namespace PerfCounters
+	{
+		CounterCell g_counters[COUNTER_COUNT];
+		GaugeCell g_gauges[GAUGE_COUNT];
+
+		static const char* g_counterNames[COUNTER_COUNT] = {
+			"FormLookups",
+			"CellScans",
+			"PackageCreations",
+			"EvaluatePackageCalls",
+			"WeaponSwitches",
+			"ProjectileRedirects",
+			"TaskSubmissions"
+		};
+
+		static const char* g_gaugeNames[GAUGE_COUNT] = {
+			"TrackedRiders",
+			"FollowingNPCs",
+			"DismountedNPCs",
+			"AvailableHorses"
+		};
+
+		const char* GetCounterName(Counter counter)
+		{
+			int index = (int)counter;
+			return (index >= 0 && index < COUNTER_COUNT) ? g_counterNames[index] : "Unknown";
+		}
+
+		const char* GetGaugeName(Gauge gauge)
+		{
+			int index = (int)gauge;
+			return (index >= 0 && index < GAUGE_COUNT) ? g_gaugeNames[index] : "Unknown";
+		}
+
+		// ============================================
+		// INTERVAL BASELINES
+		// ============================================
+		// The snapshot (any thread, under a mutex) and the CSV writer
+		// (game thread) each keep their own baseline, so a console dump
+		// does not shorten the CSV interval.
+		// ============================================
+
+		struct Baseline
+		{
+			uint64_t counters[COUNTER_COUNT];
+			uint64_t frames;
+			uint64_t frameNs;
+			uint64_t timeNs;     // 0 = not taken yet
+		};
+
+		// Frame totals (written by the game thread)
+		static std::atomic<uint64_t> g_frameCount(0);
+		static std::atomic<uint64_t> g_frameTotalNs(0);
+		static std::atomic<uint64_t> g_snapshotMaxFrameNs(0);   // Reset by DumpSnapshot
+
+		static Baseline g_snapshotBaseline = {};
+		static std::mutex g_snapshotMutex;
+		static bool g_sessionStarted = false;   // Game thread: first snapshot rates count from the first frame
+
+		// Game thread only
+		static Baseline g_csvBaseline = {};
+		static uint64_t g_csvMaxFrameNs = 0;
+		static bool g_csvHeaderChecked = false;
+
+		static void TakeBaseline(Baseline& baseline, uint64_t nowNs)
+		{
+			for (int c = 0; c < COUNTER_COUNT; c++)
+			{
+				baseline.counters[c] = g_counters[c].value.load(std::memory_order_relaxed);
+			}
+			baseline.frames = g_frameCount.load(std::memory_order_relaxed);
+			baseline.frameNs = g_frameTotalNs.load(std::memory_order_relaxed);
+			baseline.timeNs = nowNs;
+		}
+
+		// Average frame time (ms) since the baseline
+		static double GetAverageFrameMs(const Baseline& baseline, uint64_t& outFrames)
+		{
+			outFrames = g_frameCount.load(std::memory_order_relaxed) - baseline.frames;
+			uint64_t frameNs = g_frameTotalNs.load(std::memory_order_relaxed) - baseline.frameNs;
+			return (outFrames > 0) ? (double)frameNs / (double)outFrames / 1000000.0 : 0.0;
+		}
+
+		// ============================================
+		// CSV
+		// ============================================
+
+		static FILE* OpenCsvFile()
+		{
+			char documentsPath[MAX_PATH];
+			if (FAILED(SHGetFolderPathA(NULL, CSIDL_MYDOCUMENTS, NULL, SHGFP_TYPE_CURRENT, documentsPath)))
+			{
+				return nullptr;
+			}
+
+			std::string filepath = std::string(documentsPath) + "\\My Games\\Skyrim VR\\SKSE\\Mounted_NPC_Combat_VR_counters.csv";
+
+			bool writeHeader = false;
+			if (!g_csvHeaderChecked)
+			{
+				FILE* existing = fopen(filepath.c_str(), "r");
+				writeHeader = (existing == nullptr);
+				if (existing) fclose(existing);
+				g_csvHeaderChecked = true;
+			}
+
+			FILE* file = fopen(filepath.c_str(), "a");
+			if (file && writeHeader)
+			{
+				fprintf(file, "time,seconds,frames,avg_frame_ms,max_frame_ms");
+				for (int c = 0; c < COUNTER_COUNT; c++)
+				{
+					fprintf(file, ",%s_per_s", g_counterNames[c]);
+				}
+				for (int g = 0; g < GAUGE_COUNT; g++)
+				{
+					fprintf(file, ",%s", g_gaugeNames[g]);
+				}
+				fprintf(file, "\n");
+			}
+			return file;
+		}
+
+		static void WriteCsvRow(uint64_t nowNs)
+		{
+			FILE* csv = OpenCsvFile();
+			if (!csv) return;
+
+			double seconds = (double)(nowNs - g_csvBaseline.timeNs) / 1000000000.0;
+			uint64_t frames = 0;
+			double avgFrameMs = GetAverageFrameMs(g_csvBaseline, frames);
+
+			fprintf(csv, "%.2f,%.2f,%llu,%.3f,%.3f", GetGameTime(), seconds, (unsigned long long)frames,
+				avgFrameMs, g_csvMaxFrameNs / 1000000.0);
+
+			for (int c = 0; c < COUNTER_COUNT; c++)
+			{
+				uint64_t delta = g_counters[c].value.load(std::memory_order_relaxed) - g_csvBaseline.counters[c];
+				fprintf(csv, ",%.1f", (double)delta / seconds);
+			}
+			for (int g = 0; g < GAUGE_COUNT; g++)
+			{
+				fprintf(csv, ",%d", g_gauges[g].value.load(std::memory_order_relaxed));
+			}
+			fprintf(csv, "\n");
+			fclose(csv);
+		}
+
+		void EndFrame(uint64_t frameNs)
+		{
+			if (!g_sessionStarted)
+			{
+				std::lock_guard<std::mutex> lock(g_snapshotMutex);
+				if (g_snapshotBaseline.timeNs == 0) TakeBaseline(g_snapshotBaseline, Profiler::NowNs());
+				g_sessionStarted = true;
+			}
+
+			g_frameCount.fetch_add(1, std::memory_order_relaxed);
+			g_frameTotalNs.fetch_add(frameNs, std::memory_order_relaxed);
+
+			if (frameNs > g_snapshotMaxFrameNs.load(std::memory_order_relaxed))
+			{
+				g_snapshotMaxFrameNs.store(frameNs, std::memory_order_relaxed);
+			}
+			if (frameNs > g_csvMaxFrameNs)
+			{
+				g_csvMaxFrameNs = frameNs;
+			}
+
+			if (PerfCounterCsvInterval <= 0.0f) return;
+
+			uint64_t now = Profiler::NowNs();
+			if (g_csvBaseline.timeNs == 0)
+			{
+				TakeBaseline(g_csvBaseline, now);
+				g_csvMaxFrameNs = 0;
+				return;
+			}
+
+			uint64_t intervalNs = (uint64_t)(PerfCounterCsvInterval * 1000000000.0);
+			if ((now - g_csvBaseline.timeNs) < intervalNs) return;
+
+			WriteCsvRow(now);
+			TakeBaseline(g_csvBaseline, now);
+			g_csvMaxFrameNs = 0;
+		}
+
+		// ============================================
+		// SNAPSHOT
+		// ============================================
+
+		// Log (thread-safe writer) and console (game thread only)
+		static void PrintLine(const char* line)
+		{
+			ASYNC_MESSAGE("%s", line);
+			Console_Print("%s", line);
+		}
+
+		void DumpSnapshot()
+		{
+			std::lock_guard<std::mutex> lock(g_snapshotMutex);
+
+			uint64_t now = Profiler::NowNs();
+			bool haveBaseline = (g_snapshotBaseline.timeNs != 0);
+			double seconds = haveBaseline ? (double)(now - g_snapshotBaseline.timeNs) / 1000000000.0 : 0.0;
+
+			uint64_t frames = 0;
+			double avgFrameMs = GetAverageFrameMs(g_snapshotBaseline, frames);
+			uint64_t maxFrameNs = g_snapshotMaxFrameNs.exchange(0, std::memory_order_relaxed);
+
+			char line[192];
+			snprintf(line, sizeof(line), "PerfCounters: ---- %.1f s since last snapshot, %llu frames, avg %.2f ms, max %.2f ms ----",
+				seconds, (unsigned long long)frames, avgFrameMs, maxFrameNs / 1000000.0);
+			PrintLine(line);
+
+			for (int c = 0; c < COUNTER_COUNT; c++)
+			{
+				uint64_t total = g_counters[c].value.load(std::memory_order_relaxed);
+				double rate = (seconds > 0.0) ? (double)(total - g_snapshotBaseline.counters[c]) / seconds : 0.0;
+
+				snprintf(line, sizeof(line), "PerfCounters: %-20s total=%-10llu %8.1f/s",
+					g_counterNames[c], (unsigned long long)total, rate);
+				PrintLine(line);
+			}
+
+			for (int g = 0; g < GAUGE_COUNT; g++)
+			{
+				snprintf(line, sizeof(line), "PerfCounters: %-20s %d",
+					g_gaugeNames[g], g_gauges[g].value.load(std::memory_order_relaxed));
+				PrintLine(line);
+			}
+
+			TakeBaseline(g_snapshotBaseline, now);
+		}
+
+		// ============================================
+		// PAPYRUS
+		// ============================================
+
+		static void DumpPerfCounters_Native(StaticFunctionTag* base)
+		{
+			DumpSnapshot();
+		}
+
+		bool RegisterPapyrusFunctions(VMClassRegistry* registry)
+		{
+			registry->RegisterFunction(
+				new NativeFunction0<StaticFunctionTag, void>("DumpPerfCounters", "MountedNPCCombatVR", DumpPerfCounters_Native, registry));
+
+			// No kFunctionFlag_NoWait: the VM then runs the call on the game
+			// thread, which Console_Print needs
+
+			_MESSAGE("PerfCounters: Registered MountedNPCCombatVR.DumpPerfCounters");
+			return true;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "skse64/GameForms.h"
+#include <atomic>
+#include <cstdint>
+
+class VMClassRegistry;
+
+// ============================================
+// RUNTIME PERF COUNTERS
+// ============================================
+// The profiler (Profiler.h) times scopes, but only in profiler builds,
+// and says nothing about how often the expensive engine calls happen.
+// In a release build there was no way to tell how many form lookups,
+// cell scans or package re-evaluations a busy fight costs per second.
+//
+// This is a fixed registry of named counters and gauges, always
+// compiled in:
+// - Counters are bumped at the existing call sites with PERF_COUNT. The
+//   cost is one relaxed atomic add on a cache line of its own, so any
+//   thread can bump them.
+// - Gauges (tracked riders, following NPCs, ...) are stored once per
+//   frame by the game thread.
+// - EndFrame also totals the frame times, so the rates can be read
+//   against them.
+//
+// Output:
+// - DumpSnapshot prints totals, per-second rates since the previous
+//   snapshot, and the gauges to the log and the console.
+// - The Papyrus native MountedNPCCombatVR.DumpPerfCounters calls it
+//   (console: cgf "MountedNPCCombatVR.DumpPerfCounters"). The native is
+//   latent so the VM runs it on the game thread. The script has to be
+//   compiled to Scripts/MountedNPCCombatVR.pex with the Creation Kit
+//   compiler and shipped next to the DLL.
+// - With PerfCounterCsvInterval > 0, one CSV row per interval goes to
+//   Mounted_NPC_Combat_VR_counters.csv.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	namespace PerfCounters
+	{
+		enum class Counter : int
+		{
+			FormLookups = 0,        // LookupFormByID
+			CellScans,              // Walks (or cursor slices) of a cell's objectList
+			PackageCreations,       // CreatePackageByType
+			EvaluatePackageCalls,   // Actor_EvaluatePackage
+			WeaponSwitches,         // Weapon equips by the weapon state machine
+			ProjectileRedirects,    // Arrows re-aimed by the projectile hook
+			TaskSubmissions,        // g_task->AddTask
+			Count
+		};
+
+		enum class Gauge : int
+		{
+			TrackedRiders = 0,
+			FollowingNPCs,
+			DismountedNPCs,         // Waiting to remount
+			AvailableHorses,        // Unridden horses found by the last mount scan
+			Count
+		};
+
+		const int COUNTER_COUNT = (int)Counter::Count;
+		const int GAUGE_COUNT = (int)Gauge::Count;
+
+		const char* GetCounterName(Counter counter);
+		const char* GetGaugeName(Gauge gauge);
+
+		// ============================================
+		// UPDATES
+		// ============================================
+
+		// One cache line per value so threads bumping different counters
+		// never contend
+		struct alignas(64) CounterCell
+		{
+			std::atomic<uint64_t> value;
+		};
+
+		struct alignas(64) GaugeCell
+		{
+			std::atomic<int> value;
+		};
+
+		extern CounterCell g_counters[COUNTER_COUNT];
+		extern GaugeCell g_gauges[GAUGE_COUNT];
+
+		inline void Increment(Counter counter)
+		{
+			g_counters[(int)counter].value.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		inline void SetGauge(Gauge gauge, int value)
+		{
+			g_gauges[(int)gauge].value.store(value, std::memory_order_relaxed);
+		}
+
+		// Running total (any thread)
+		inline uint64_t GetCounter(Counter counter)
+		{
+			return g_counters[(int)counter].value.load(std::memory_order_relaxed);
+		}
+
+		// Once per update tick with the tick's duration (game thread).
+		// Writes the CSV row when PerfCounterCsvInterval has elapsed.
+		void EndFrame(uint64_t frameNs);
+
+		// ============================================
+		// REPORTING
+		// ============================================
+
+		// Totals, rates since the previous snapshot and gauges to the log
+		// and the console (game thread - Console_Print is not thread-safe)
+		void DumpSnapshot();
+
+		// Papyrus: MountedNPCCombatVR.DumpPerfCounters() global native
+		bool RegisterPapyrusFunctions(VMClassRegistry* registry);
+	}
+
+	// LookupFormByID that bumps the FormLookups counter
+	inline TESForm* CountedLookupFormByID(UInt32 formID)
+	{
+		PerfCounters::Increment(PerfCounters::Counter::FormLookups);
+		return LookupFormByID(formID);
+	}
+}
+
+#define PERF_COUNT(counter) ::MountedNPCCombatVR::PerfCounters::Increment(::MountedNPCCombatVR::PerfCounters::Counter::counter)
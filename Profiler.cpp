@@ -0,0 +1,268 @@
+#include "Profiler.h"
+#include "Helper.h"
+#include "config.h"
+#include <shlobj.h>
+#include <cstdio>
+#include <mutex>
+
+namespace MountedNPCCombatVR
+{
+	namespace Profiler
+	{
+		// ============================================
+		// PER-THREAD SLOTS
+		// ============================================
+		// Each slot is written by exactly one thread, so the hot path
+		// only needs relaxed load + store (no locked instructions).
+		// The reporter reads the running totals and diffs them against
+		// the values it saw last time.
+		// ============================================
+
+		struct ScopeData
+		{
+			std::atomic<uint32_t> buckets[HISTOGRAM_BUCKETS];
+			std::atomic<uint64_t> count;
+			std::atomic<uint64_t> totalNs;
+			std::atomic<uint64_t> maxNs;      // Reset by the reporter each interval
+		};
+
+		struct ThreadSlot
+		{
+			ScopeData scopes[SCOPE_COUNT];
+		};
+
+		struct ReporterSeen
+		{
+			uint32_t buckets[HISTOGRAM_BUCKETS];
+			uint64_t count;
+			uint64_t totalNs;
+		};
+
+		static ThreadSlot g_threadSlots[MAX_PROFILER_THREADS];
+		static std::atomic<int> g_threadSlotCount(0);
+		static thread_local ThreadSlot* t_threadSlot = nullptr;
+		static thread_local bool t_threadSlotClaimed = false;
+
+		static ReporterSeen g_reporterSeen[MAX_PROFILER_THREADS][SCOPE_COUNT];
+		static std::mutex g_reportMutex;
+		static uint64_t g_lastReportNs = 0;
+		static bool g_csvHeaderChecked = false;
+
+		static const char* g_scopeNames[SCOPE_COUNT] = {
+			"Frame",
+			"DelayedArrowFires",
+			"CombatStylesSystem",
+			"TemporaryStaggerTimers",
+			"PlayerMountedCombatState",
+			"CombatClassBools",
+			"HostileTargetScan",
+			"UntrackedNPCScan",
+			"RiderLoop",
+			"HorseMountScanner",
+			"QueuedDisengages",
+			"SpatialGridRebuild",
+			"EncounterRebuild",
+			"SteeringFlush",
+			"RiderDecide",
+			"RiderApply"
+		};
+
+		const char* GetScopeName(Scope scope)
+		{
+			int index = (int)scope;
+			if (index < 0 || index >= SCOPE_COUNT) return "Unknown";
+			return g_scopeNames[index];
+		}
+
+		// ============================================
+		// RECORDING
+		// ============================================
+
+		static ThreadSlot* GetThreadSlot()
+		{
+			if (!t_threadSlotClaimed)
+			{
+				t_threadSlotClaimed = true;
+				int index = g_threadSlotCount.fetch_add(1, std::memory_order_relaxed);
+				t_threadSlot = (index < MAX_PROFILER_THREADS) ? &g_threadSlots[index] : nullptr;
+			}
+			return t_threadSlot;
+		}
+
+		void RecordSample(Scope scope, uint64_t ns)
+		{
+			ThreadSlot* slot = GetThreadSlot();
+			if (!slot) return;
+
+			ScopeData& data = slot->scopes[(int)scope];
+			std::atomic<uint32_t>& bucket = data.buckets[GetBucketIndex(ns)];
+
+			bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			data.totalNs.store(data.totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+			data.count.store(data.count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+			// Not an atomic max: the reporter's exchange(0) can land between
+			// this load and store, so a max recorded right at an interval
+			// boundary may be reported in the next interval or lost. Benign
+			// for a diagnostic, and keeps the hot path free of RMW atomics.
+			if (ns > data.maxNs.load(std::memory_order_relaxed))
+			{
+				data.maxNs.store(ns, std::memory_order_relaxed);
+			}
+		}
+
+		// ============================================
+		// REPORTING
+		// ============================================
+
+		static void CollectIntervalLocked(ScopeSummary outSummaries[SCOPE_COUNT])
+		{
+			static uint64_t merged[HISTOGRAM_BUCKETS];
+
+			int slotCount = g_threadSlotCount.load(std::memory_order_relaxed);
+			if (slotCount > MAX_PROFILER_THREADS) slotCount = MAX_PROFILER_THREADS;
+
+			for (int s = 0; s < SCOPE_COUNT; s++)
+			{
+				ScopeSummary& summary = outSummaries[s];
+				summary.count = 0;
+				summary.totalNs = 0;
+				summary.maxNs = 0;
+				for (int b = 0; b < HISTOGRAM_BUCKETS; b++) merged[b] = 0;
+
+				for (int t = 0; t < slotCount; t++)
+				{
+					ScopeData& data = g_threadSlots[t].scopes[s];
+					ReporterSeen& seen = g_reporterSeen[t][s];
+
+					uint64_t count = data.count.load(std::memory_order_acquire);
+					uint64_t total = data.totalNs.load(std::memory_order_relaxed);
+					uint64_t maxNs = data.maxNs.exchange(0, std::memory_order_relaxed);
+
+					summary.count += count - seen.count;
+					summary.totalNs += total - seen.totalNs;
+					if (maxNs > summary.maxNs) summary.maxNs = maxNs;
+					seen.count = count;
+					seen.totalNs = total;
+
+					for (int b = 0; b < HISTOGRAM_BUCKETS; b++)
+					{
+						uint32_t value = data.buckets[b].load(std::memory_order_relaxed);
+						merged[b] += (uint32_t)(value - seen.buckets[b]);
+						seen.buckets[b] = value;
+					}
+				}
+
+				summary.p50Ns = GetPercentile(merged, summary.count, 50.0f);
+				summary.p95Ns = GetPercentile(merged, summary.count, 95.0f);
+				summary.p99Ns = GetPercentile(merged, summary.count, 99.0f);
+			}
+		}
+
+		void CollectInterval(ScopeSummary outSummaries[SCOPE_COUNT])
+		{
+			std::lock_guard<std::mutex> lock(g_reportMutex);
+			CollectIntervalLocked(outSummaries);
+		}
+
+		static FILE* OpenCsvFile()
+		{
+			char documentsPath[MAX_PATH];
+			if (FAILED(SHGetFolderPathA(NULL, CSIDL_MYDOCUMENTS, NULL, SHGFP_TYPE_CURRENT, documentsPath)))
+			{
+				return nullptr;
+			}
+
+			std::string filepath = std::string(documentsPath) + "\\My Games\\Skyrim VR\\SKSE\\Mounted_NPC_Combat_VR_profile.csv";
+
+			bool writeHeader = false;
+			if (!g_csvHeaderChecked)
+			{
+				FILE* existing = fopen(filepath.c_str(), "r");
+				writeHeader = (existing == nullptr);
+				if (existing) fclose(existing);
+				g_csvHeaderChecked = true;
+			}
+
+			FILE* file = fopen(filepath.c_str(), "a");
+			if (file && writeHeader)
+			{
+				fprintf(file, "time,scope,count,avg_us,p50_us,p95_us,p99_us,max_us\n");
+			}
+			return file;
+		}
+
+		static void DumpSummaryLocked()
+		{
+			ScopeSummary summaries[SCOPE_COUNT];
+			CollectIntervalLocked(summaries);
+
+			if (summaries[(int)Scope::Frame].count == 0) return;
+
+			FILE* csv = ProfilerWriteCsv ? OpenCsvFile() : nullptr;
+			float now = GetGameTime();
+
+			_MESSAGE("Profiler: ---- %d frames (times in microseconds) ----", (int)summaries[(int)Scope::Frame].count);
+			for (int s = 0; s < SCOPE_COUNT; s++)
+			{
+				const ScopeSummary& summary = summaries[s];
+				if (summary.count == 0) continue;
+
+				double avgUs = (double)summary.totalNs / (double)summary.count / 1000.0;
+				double p50Us = summary.p50Ns / 1000.0;
+				double p95Us = summary.p95Ns / 1000.0;
+				double p99Us = summary.p99Ns / 1000.0;
+				double maxUs = summary.maxNs / 1000.0;
+
+				_MESSAGE("Profiler: %-26s n=%-6llu avg=%8.1f p50=%8.1f p95=%8.1f p99=%8.1f max=%8.1f",
+					g_scopeNames[s], (unsigned long long)summary.count, avgUs, p50Us, p95Us, p99Us, maxUs);
+
+				if (csv)
+				{
+					fprintf(csv, "%.2f,%s,%llu,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+						now, g_scopeNames[s], (unsigned long long)summary.count, avgUs, p50Us, p95Us, p99Us, maxUs);
+				}
+			}
+
+			if (csv) fclose(csv);
+		}
+
+		void DumpSummary()
+		{
+			std::lock_guard<std::mutex> lock(g_reportMutex);
+			DumpSummaryLocked();
+		}
+
+		void OnFrameEnd()
+		{
+			if (ProfilerReportInterval <= 0.0f) return;
+
+			uint64_t now = NowNs();
+			uint64_t intervalNs = (uint64_t)(ProfilerReportInterval * 1000000000.0);
+
+			std::lock_guard<std::mutex> lock(g_reportMutex);
+
+			if (g_lastReportNs == 0)
+			{
+				g_lastReportNs = now;
+				return;
+			}
+
+			if ((now - g_lastReportNs) < intervalNs) return;
+			g_lastReportNs = now;
+
+			DumpSummaryLocked();
+		}
+
+		void ResetProfiler()
+		{
+			std::lock_guard<std::mutex> lock(g_reportMutex);
+
+			// Collecting an interval moves the reporter baseline forward,
+			// which discards everything recorded so far
+			ScopeSummary discard[SCOPE_COUNT];
+			CollectIntervalLocked(discard);
+			g_lastReportNs = 0;
+		}
+	}
+}
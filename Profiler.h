@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+
+// ============================================
+// HOT-PATH PROFILER
+// ============================================
+// RAII scoped timers for the subsystems called from
+// UpdateMountedCombat / UpdateHorseMountScanner.
+//
+// Compiled in only when MOUNTED_COMBAT_PROFILER is defined
+// (defaults to on for _DEBUG builds). In release builds the
+// PROFILE_SCOPE macro expands to nothing and costs zero.
+//
+// Each thread records into its own slot (no locks, no RMW
+// atomics on the hot path). The periodic report merges all
+// slots and prints count / avg / p50 / p95 / p99 / max per
+// scope to the log and optionally to a CSV file.
+// ============================================
+
+#if defined(_DEBUG) && !defined(MOUNTED_COMBAT_PROFILER)
+#define MOUNTED_COMBAT_PROFILER 1
+#endif
+
+namespace MountedNPCCombatVR
+{
+	namespace Profiler
+	{
+		// ============================================
+		// PROFILED SCOPES
+		// ============================================
+
+		enum class Scope : int
+		{
+			Frame = 0,              // Whole update tick (DismountHook update block)
+			DelayedArrowFires,
+			CombatStylesSystem,
+			TemporaryStaggerTimers,
+			PlayerMountedCombatState,
+			CombatClassBools,
+			HostileTargetScan,
+			UntrackedNPCScan,
+			RiderLoop,
+			HorseMountScanner,
+			QueuedDisengages,
+			SpatialGridRebuild,     // Nested inside whichever scope queries first
+			EncounterRebuild,       // Nested inside whichever scope queries first
+			SteeringFlush,
+			RiderDecide,            // Nested inside RiderLoop (decide phase)
+			RiderApply,             // Nested inside RiderLoop (apply phase)
+			Count
+		};
+
+		const int SCOPE_COUNT = (int)Scope::Count;
+
+		// Histogram layout: 4 sub-buckets per power of two (nanoseconds)
+		// Max error of a reported percentile is ~25% of its value
+		const int HISTOGRAM_SUB_BITS = 2;
+		const int HISTOGRAM_BUCKETS = 40 << HISTOGRAM_SUB_BITS;
+
+		// Maximum number of threads that can record samples
+		// Threads beyond this limit are silently ignored
+		const int MAX_PROFILER_THREADS = 8;
+
+		const char* GetScopeName(Scope scope);
+
+		// ============================================
+		// HISTOGRAM HELPERS (engine independent)
+		// ============================================
+
+		// Map a duration in nanoseconds to its histogram bucket
+		int GetBucketIndex(uint64_t ns);
+
+		// Upper bound (nanoseconds) of the values stored in a bucket
+		uint64_t GetBucketUpperBound(int bucket);
+
+		// Value at the given percentile (0-100) of a merged histogram
+		uint64_t GetPercentile(const uint64_t* buckets, uint64_t totalCount, float percentile);
+
+		// ============================================
+		// RECORDING
+		// ============================================
+
+		inline uint64_t NowNs()
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Record one sample for a scope on the calling thread's slot
+		void RecordSample(Scope scope, uint64_t ns);
+
+		class ScopedTimer
+		{
+		public:
+			explicit ScopedTimer(Scope scope) : m_scope(scope), m_start(NowNs()) {}
+			~ScopedTimer() { RecordSample(m_scope, NowNs() - m_start); }
+
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		private:
+			Scope m_scope;
+			uint64_t m_start;
+		};
+
+		// ============================================
+		// REPORTING
+		// ============================================
+
+		struct ScopeSummary
+		{
+			uint64_t count;
+			uint64_t totalNs;
+			uint64_t p50Ns;
+			uint64_t p95Ns;
+			uint64_t p99Ns;
+			uint64_t maxNs;
+		};
+
+		// Merge all thread slots into per-scope summaries for samples
+		// recorded since the previous call (resets the interval)
+		void CollectInterval(ScopeSummary outSummaries[SCOPE_COUNT]);
+
+		// Call once per update tick - dumps a summary every
+		// ProfilerReportInterval seconds (0 = never)
+		void OnFrameEnd();
+
+		// Force a summary dump now
+		void DumpSummary();
+
+		// Discard all recorded samples (call on game load)
+		void ResetProfiler();
+	}
+}
+
+// ============================================
+// PROFILE MACROS
+// ============================================
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef MOUNTED_COMBAT_PROFILER
+#define PROFILE_SCOPE(scope) ::MountedNPCCombatVR::Profiler::ScopedTimer PROFILE_CONCAT(_profileTimer, __LINE__)(::MountedNPCCombatVR::Profiler::Scope::scope)
+#define PROFILE_FRAME_END() ::MountedNPCCombatVR::Profiler::OnFrameEnd()
+#else
+#define PROFILE_SCOPE(scope) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
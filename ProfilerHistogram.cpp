@@ -0,0 +1,75 @@
+#include "Profiler.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Histogram math for the profiler. Engine independent (no SKSE or
+// Windows headers) so it can be built and tested on its own; see
+// tests/ProfilerHistogramTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace Profiler
+	{
+		// ============================================
+		// HISTOGRAM HELPERS
+		// ============================================
+
+		static int HighestBit(uint64_t value)
+		{
+#ifdef _MSC_VER
+			unsigned long index = 0;
+			_BitScanReverse64(&index, value);
+			return (int)index;
+#else
+			return 63 - __builtin_clzll(value);
+#endif
+		}
+
+		int GetBucketIndex(uint64_t ns)
+		{
+			const uint64_t subCount = 1ull << HISTOGRAM_SUB_BITS;
+			if (ns < subCount) return (int)ns;
+
+			int msb = HighestBit(ns);
+			int sub = (int)((ns >> (msb - HISTOGRAM_SUB_BITS)) & (subCount - 1));
+			int index = ((msb - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS) + sub;
+
+			if (index >= HISTOGRAM_BUCKETS) index = HISTOGRAM_BUCKETS - 1;
+			return index;
+		}
+
+		uint64_t GetBucketUpperBound(int bucket)
+		{
+			const int subCount = 1 << HISTOGRAM_SUB_BITS;
+			if (bucket < subCount) return (uint64_t)bucket;
+
+			int msb = (bucket >> HISTOGRAM_SUB_BITS) + HISTOGRAM_SUB_BITS - 1;
+			int sub = bucket & (subCount - 1);
+			uint64_t width = 1ull << (msb - HISTOGRAM_SUB_BITS);
+			uint64_t lower = (1ull << msb) + (uint64_t)sub * width;
+			return lower + width - 1;
+		}
+
+		uint64_t GetPercentile(const uint64_t* buckets, uint64_t totalCount, float percentile)
+		{
+			if (totalCount == 0) return 0;
+
+			uint64_t target = (uint64_t)((double)totalCount * percentile / 100.0 + 0.5);
+			if (target < 1) target = 1;
+			if (target > totalCount) target = totalCount;
+
+			uint64_t cumulative = 0;
+			for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+			{
+				cumulative += buckets[i];
+				if (cumulative >= target)
+				{
+					return GetBucketUpperBound(i);
+				}
+			}
+			return GetBucketUpperBound(HISTOGRAM_BUCKETS - 1);
+		}
+	}
+}
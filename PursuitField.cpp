@@ -0,0 +1,210 @@
+#include "PursuitField.h"
+#include "AttackSlots.h"
+#include "Helper.h"
+#include "config.h"
+#include "SteeringKernel.h"
+#include <cmath>
+
+namespace MountedNPCCombatVR
+{
+	namespace Pursuit
+	{
+		// ============================================
+		// STORAGE
+		// ============================================
+
+		const float PURSUIT_MIN_SAMPLE_GAP = 0.02f;  // Velocity is only resampled after this many seconds
+
+		struct PursuitEntry
+		{
+			PursuitField field;
+			UInt32 tick;            // g_tick when the field was computed
+			float computeTime;      // GetGameTime() when the field was computed
+			float lastUseTime;      // For eviction when the table is full
+			NiPoint3 samplePos;     // Last position used for velocity
+			float sampleTime;
+			bool hasSample;
+			bool isValid;
+		};
+
+		static PursuitEntry g_entries[PURSUIT_MAX_TARGETS];
+		static UInt32 g_tick = 1;
+		static UInt32 g_computeCount = 0;
+		static UInt32 g_hitCount = 0;
+
+		// ============================================
+		// LOOKUP
+		// ============================================
+
+		static PursuitEntry* FindOrCreateEntry(UInt32 targetFormID, float now)
+		{
+			int freeIndex = -1;
+			int oldestIndex = -1;
+
+			for (int i = 0; i < PURSUIT_MAX_TARGETS; i++)
+			{
+				PursuitEntry& entry = g_entries[i];
+				if (!entry.isValid)
+				{
+					if (freeIndex < 0) freeIndex = i;
+					continue;
+				}
+
+				if (entry.field.targetFormID == targetFormID) return &entry;
+
+				if (oldestIndex < 0 || entry.lastUseTime < g_entries[oldestIndex].lastUseTime)
+				{
+					oldestIndex = i;
+				}
+			}
+
+			// Table full - take over the target nobody asked about for longest
+			int index = (freeIndex >= 0) ? freeIndex : oldestIndex;
+			if (index < 0) return nullptr;
+
+			PursuitEntry& entry = g_entries[index];
+			entry.field.targetFormID = targetFormID;
+			entry.field.velocity.x = 0.0f;
+			entry.field.velocity.y = 0.0f;
+			entry.field.velocity.z = 0.0f;
+			entry.tick = 0;
+			entry.computeTime = now;
+			entry.lastUseTime = now;
+			entry.hasSample = false;
+			entry.isValid = true;
+			return &entry;
+		}
+
+		// ============================================
+		// COMPUTE
+		// ============================================
+
+		static void UpdateVelocity(PursuitEntry& entry, const NiPoint3& pos, float now)
+		{
+			PursuitField& field = entry.field;
+
+			if (!entry.hasSample)
+			{
+				entry.samplePos = pos;
+				entry.sampleTime = now;
+				entry.hasSample = true;
+				return;
+			}
+
+			float dt = now - entry.sampleTime;
+			if (dt < 0.0f || dt > PURSUIT_MAX_SAMPLE_GAP)
+			{
+				// Stale or clock went backwards - start over from this sample
+				field.velocity.x = 0.0f;
+				field.velocity.y = 0.0f;
+				entry.samplePos = pos;
+				entry.sampleTime = now;
+				return;
+			}
+
+			if (dt < PURSUIT_MIN_SAMPLE_GAP)
+			{
+				return;  // Too close to the last sample - keep the current estimate
+			}
+
+			float rawX = (pos.x - entry.samplePos.x) / dt;
+			float rawY = (pos.y - entry.samplePos.y) / dt;
+			field.velocity.x += (rawX - field.velocity.x) * PURSUIT_VELOCITY_SMOOTHING;
+			field.velocity.y += (rawY - field.velocity.y) * PURSUIT_VELOCITY_SMOOTHING;
+
+			entry.samplePos = pos;
+			entry.sampleTime = now;
+		}
+
+		static void ComputeField(PursuitEntry& entry, Actor* target, float now)
+		{
+			PursuitField& field = entry.field;
+
+			field.position = target->pos;
+			UpdateVelocity(entry, target->pos, now);
+			field.velocity.z = 0.0f;
+
+			field.speed = sqrtf(field.velocity.x * field.velocity.x + field.velocity.y * field.velocity.y);
+			field.isMoving = field.speed > PURSUIT_MOVING_SPEED;
+
+			field.predicted.x = target->pos.x + field.velocity.x * PURSUIT_LEAD_TIME;
+			field.predicted.y = target->pos.y + field.velocity.y * PURSUIT_LEAD_TIME;
+			field.predicted.z = target->pos.z;
+
+			field.facing = Steering::GetHeading(target);
+			field.facingSin = sinf(field.facing);
+			field.facingCos = cosf(field.facing);
+
+			field.isPlayer = (g_thePlayer && (*g_thePlayer) && target == (*g_thePlayer));
+
+			NiPointer<Actor> targetMount;
+			field.isMounted = CALL_MEMBER_FN(target, GetMount)(targetMount) && targetMount;
+
+			field.isMobileNPC = !field.isPlayer && !field.isMounted && !target->IsDead(1) && target->IsInCombat();
+
+			field.meleeRange = field.isMounted ? MeleeRangeMounted : MeleeRangeOnFoot;
+			field.meleeRingRadius = AttackSlots::SLOT_MELEE_RADIUS;
+			field.rangedRingRadius = DynamicRangedRoleIdealDistance;
+			field.mageRingRadius = MageRoleIdealDistance;
+
+			UInt32 handle = target->CreateRefHandle();
+			field.targetHandle = (handle == *g_invalidRefHandle) ? 0 : handle;
+
+			entry.tick = g_tick;
+			entry.computeTime = now;
+			g_computeCount++;
+		}
+
+		// ============================================
+		// PUBLIC API
+		// ============================================
+
+		const PursuitField* GetPursuitField(Actor* target)
+		{
+			if (!target || target->formID == 0) return nullptr;
+
+			float now = GetGameTime();
+			PursuitEntry* entry = FindOrCreateEntry(target->formID, now);
+			if (!entry) return nullptr;
+
+			entry->lastUseTime = now;
+
+			bool fresh = entry->tick == g_tick &&
+				now >= entry->computeTime && (now - entry->computeTime) < PURSUIT_MAX_AGE;
+			if (fresh)
+			{
+				g_hitCount++;
+				return &entry->field;
+			}
+
+			ComputeField(*entry, target, now);
+			return &entry->field;
+		}
+
+		void BeginPursuitTick()
+		{
+			g_tick++;
+			if (g_tick == 0) g_tick = 1;  // 0 means "never computed"
+		}
+
+		UInt32 GetPursuitComputeCount()
+		{
+			return g_computeCount;
+		}
+
+		UInt32 GetPursuitHitCount()
+		{
+			return g_hitCount;
+		}
+
+		void ResetPursuitFields()
+		{
+			for (int i = 0; i < PURSUIT_MAX_TARGETS; i++)
+			{
+				g_entries[i].isValid = false;
+			}
+			g_computeCount = 0;
+			g_hitCount = 0;
+		}
+	}
+}
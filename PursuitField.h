@@ -0,0 +1,82 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// PURSUIT FIELD (shared per-target chase data)
+	// ============================================
+	// InjectTravelPackageToHorse, IsTargetMobileNPC and the follow-offset
+	// setters (SetNPCKeepOffsetFromTarget, SetNPCRangedFollowFromTarget,
+	// SetNPCMageFollowFromTarget, ForceHorseCombatWithTarget) each worked
+	// out the same target facts for every rider chasing that target on
+	// every update: target mount lookup, ref handle, melee range, facing.
+	//
+	// A pursuit field holds everything about a target that does not
+	// depend on the chaser:
+	// - position, velocity (from the previous sample) and a predicted
+	//   position PURSUIT_LEAD_TIME ahead
+	// - facing (rot.z and its sin/cos)
+	// - mounted / player / mobile-NPC flags and the melee range that follows
+	// - ref handle and the melee / ranged / mage follow ring radii
+	//
+	// A field is computed by the first chaser that asks for it in a tick
+	// and reused by every other chaser of the same target. The rider loop
+	// calls BeginPursuitTick() to mark all fields stale; fields older than
+	// PURSUIT_MAX_AGE are also recomputed if the loop is not running.
+	// Per-rider geometry (bearing and distance from that horse) stays
+	// with the caller.
+	//
+	// GAME THREAD ONLY - fields are valid until the next BeginPursuitTick.
+	// ============================================
+
+	namespace Pursuit
+	{
+		const int PURSUIT_MAX_TARGETS = 32;
+		const float PURSUIT_MAX_AGE = 0.05f;            // Seconds before a query recomputes a field
+		const float PURSUIT_LEAD_TIME = 0.5f;           // Seconds of target motion in the predicted position
+		const float PURSUIT_MAX_SAMPLE_GAP = 1.0f;      // Velocity resets if samples are further apart
+		const float PURSUIT_VELOCITY_SMOOTHING = 0.5f;  // Weight of the newest velocity sample
+		const float PURSUIT_MOVING_SPEED = 50.0f;       // Units/sec above which a target counts as moving
+
+		struct PursuitField
+		{
+			UInt32 targetFormID;
+			UInt32 targetHandle;        // 0 if the handle could not be created
+
+			NiPoint3 position;
+			NiPoint3 velocity;          // Units/sec (z ignored)
+			NiPoint3 predicted;         // position + velocity * PURSUIT_LEAD_TIME
+			float speed;
+			bool isMoving;              // speed > PURSUIT_MOVING_SPEED
+
+			float facing;               // rot.z
+			float facingSin;
+			float facingCos;
+
+			bool isPlayer;
+			bool isMounted;
+			bool isMobileNPC;           // Alive, in combat, on foot and not the player
+
+			float meleeRange;           // MeleeRangeMounted or MeleeRangeOnFoot
+			float meleeRingRadius;      // AttackSlots melee ring
+			float rangedRingRadius;     // DynamicRangedRoleIdealDistance
+			float mageRingRadius;       // MageRoleIdealDistance
+		};
+
+		// Shared field for this target (nullptr if target is null or the table is full)
+		const PursuitField* GetPursuitField(Actor* target);
+
+		// Mark every field stale (called once per tick from the rider loop)
+		void BeginPursuitTick();
+
+		// Fields computed / reused since the last reset (diagnostics)
+		UInt32 GetPursuitComputeCount();
+		UInt32 GetPursuitHitCount();
+
+		// Forget all targets (mod deactivate)
+		void ResetPursuitFields();
+	}
+}
@@ -0,0 +1,91 @@
+#include "RemountAssignment.h"
+
+namespace MountedNPCCombatVR
+{
+	void SolveRemountAssignment(float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int n, int* rowToCol)
+	{
+		// Potentials and matching are 1-based; index 0 is the virtual start column
+		float u[REMOUNT_MATRIX_DIM + 1];
+		float v[REMOUNT_MATRIX_DIM + 1];
+		int colRow[REMOUNT_MATRIX_DIM + 1];    // Row matched to each column (0 = none)
+		int way[REMOUNT_MATRIX_DIM + 1];
+		float minSlack[REMOUNT_MATRIX_DIM + 1];
+		bool used[REMOUNT_MATRIX_DIM + 1];
+		
+		for (int j = 0; j <= n; j++)
+		{
+			u[j] = 0.0f;
+			v[j] = 0.0f;
+			colRow[j] = 0;
+			way[j] = 0;
+		}
+		
+		for (int row = 1; row <= n; row++)
+		{
+			colRow[0] = row;
+			int col0 = 0;
+			
+			for (int j = 0; j <= n; j++)
+			{
+				minSlack[j] = 1e30f;
+				used[j] = false;
+			}
+			
+			// Grow an alternating tree from 'row' until it reaches a free column
+			do
+			{
+				used[col0] = true;
+				int row0 = colRow[col0];
+				float delta = 1e30f;
+				int col1 = 0;
+				
+				for (int j = 1; j <= n; j++)
+				{
+					if (used[j]) continue;
+					
+					float slack = cost[row0 - 1][j - 1] - u[row0] - v[j];
+					if (slack < minSlack[j])
+					{
+						minSlack[j] = slack;
+						way[j] = col0;
+					}
+					if (minSlack[j] < delta)
+					{
+						delta = minSlack[j];
+						col1 = j;
+					}
+				}
+				
+				for (int j = 0; j <= n; j++)
+				{
+					if (used[j])
+					{
+						u[colRow[j]] += delta;
+						v[j] -= delta;
+					}
+					else
+					{
+						minSlack[j] -= delta;
+					}
+				}
+				
+				col0 = col1;
+			}
+			while (colRow[col0] != 0);
+			
+			// Flip the augmenting path
+			do
+			{
+				int col1 = way[col0];
+				colRow[col0] = colRow[col1];
+				col0 = col1;
+			}
+			while (col0 != 0);
+		}
+		
+		for (int j = 1; j <= n; j++)
+		{
+			rowToCol[colRow[j] - 1] = j - 1;
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// REMOUNT ASSIGNMENT (min-cost matching)
+	// ============================================
+	// Hungarian algorithm used by HorseMountScanner to match dismounted
+	// NPCs to horses (see REMOUNT MATCHING there for the cost model).
+	// Plain C++ with no engine headers, so it is tested against brute
+	// force off the game (tests/RemountAssignmentTest.cpp).
+	// ============================================
+
+	// Matrix edge: max(MAX_DISMOUNTED_NPCS, MAX_AVAILABLE_HORSES)
+	const int REMOUNT_MATRIX_DIM = 10;
+
+	// Min-cost perfect matching on an n x n matrix (n <= REMOUNT_MATRIX_DIM).
+	// rowToCol[r] = column for row r.
+	void SolveRemountAssignment(float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int n, int* rowToCol);
+}
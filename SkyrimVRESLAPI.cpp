@@ -97,6 +97,52 @@ const ModInfo* NEWLookupLoadedLightModByName(const char* modName)
 	}
 }
 
+const ModInfo* NEWLookupModByFormID(UInt32 formId)
+{
+	ModIndex index = GetModIndexFromFormId(formId);
+	if (index.modIndex == 0xFF)
+	{
+		return nullptr;
+	}
+
+	if (index.modIndex == 0xFE)
+	{
+		if (!g_SkyrimVRESLInterface)
+		{
+			return nullptr;
+		}
+
+		const SkyrimVRESLPluginAPI::TESFileCollection* fileCollection = g_SkyrimVRESLInterface->GetCompiledFileCollection();
+		if (fileCollection != nullptr)
+		{
+			for (int i = 0; i < fileCollection->smallFiles.count; i++)
+			{
+				ModInfo* smallFile = nullptr;
+				fileCollection->smallFiles.GetNthItem(i, smallFile);
+				if (smallFile != nullptr && smallFile->lightIndex == index.lightIndex)
+				{
+					return smallFile;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (dataHandler)
+	{
+		for (tList<ModInfo>::Iterator it = dataHandler->modList.modInfoList.Begin(); !it.End(); ++it)
+		{
+			const ModInfo* modInfo = it.Get();
+			if (modInfo != nullptr && modInfo->IsActive() && modInfo->modIndex == index.modIndex)
+			{
+				return modInfo;
+			}
+		}
+	}
+	return nullptr;
+}
+
 TESForm* ParseFormFromSplitted(std::vector<std::string>& splittedByPlugin)
 {
 	if (splittedByPlugin.size() > 1)
@@ -108,6 +108,7 @@ static inline UInt32 GetFullFormID(const ModInfo* modInfo, UInt32 formLower)
 //Useful functions
 const ModInfo* NEWLookupAllLoadedModByName(const char* modName);
 const ModInfo* NEWLookupLoadedLightModByName(const char* modName);
+const ModInfo* NEWLookupModByFormID(UInt32 formId);  // Plugin a loaded form comes from (nullptr for runtime forms)
 TESForm* ParseFormFromSplitted(std::vector<std::string>& splittedByPlugin);
 
 UInt32 GetFullFormIdFromEspAndFormId(const char* espName, UInt32 baseFormId);
@@ -0,0 +1,401 @@
+#include "SpatialGrid.h"
+#include "MountedCombat.h"
+#include "CompanionCombat.h"
+#include "Profiler.h"
+#include "Helper.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
+#include "config.h"
+#include "skse64_common/Relocation.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace MountedNPCCombatVR
+{
+	namespace SpatialGrid
+	{
+		// ============================================
+		// GRID STORAGE
+		// ============================================
+
+		static GridEntry g_gathered[GRID_MAX_ENTRIES];
+		static GridEntry g_entryStorage[GRID_MAX_ENTRIES];
+		static GridIndex g_index;
+		static Actor* g_resolved[GRID_MAX_ENTRIES];       // Actor each entry resolved to in the current query
+		static int g_queryEntries[GRID_MAX_ENTRIES];
+
+		static float g_lastBuildTime = -1000.0f;
+		static bool g_gridValid = false;
+		static bool g_loggedOverflow = false;
+
+		// ============================================
+		// LOADED GRID (SE TES / GridCellArray layout)
+		// ============================================
+		// Not exposed by the SKSE64 VR headers. The TES singleton is found
+		// by its SE ID in the VR Address Library ("id,offset" rows). The
+		// layout is only read inside ReadLoadedGrid (SEH-guarded), and a
+		// read is only used if it passes the checks there.
+
+		const UInt64 TES_SINGLETON_ID = 516923;            // Address Library ID of the TES* global
+		const char* const ADDRESS_LIBRARY_FILE = "Data\\SKSE\\Plugins\\version-1-4-15-0.csv";
+		const UInt64 IMAGE_BASE = 0x140000000;             // Subtracted from absolute addresses in the CSV
+		const UInt32 TES_OFFSET_GRID_CELLS = 0x60;         // GridCellArray*
+		const UInt32 GRID_CELLS_OFFSET_LENGTH = 0x10;      // UInt32 cells per edge (uGridsToLoad)
+		const UInt32 GRID_CELLS_OFFSET_CELLS = 0x18;       // TESObjectCELL*[length * length]
+		const int LOADED_GRID_MAX_FAILURES = 50;           // Failed reads (before one passes) that turn the walk off
+
+		static uintptr_t g_tesSingletonAddress = 0;
+		static bool g_addressLookupDone = false;
+		static bool g_loadedGridDisabled = false;
+		static bool g_loadedGridVerified = false;
+		static int g_loadedGridFailures = 0;
+
+		// Offset of an Address Library ID, 0 if the file or the ID is missing
+		static UInt64 LookupAddressLibraryOffset(UInt64 id)
+		{
+			std::string filepath = GetRuntimeDirectory() + ADDRESS_LIBRARY_FILE;
+			FILE* file = fopen(filepath.c_str(), "r");
+			if (!file) return 0;
+
+			UInt64 offset = 0;
+			char line[256];
+			while (fgets(line, sizeof(line), file))
+			{
+				char* end = nullptr;
+				UInt64 lineID = strtoull(line, &end, 10);
+				if (end == line || lineID != id) continue;
+
+				while (*end == ',' || *end == ' ' || *end == '\t') end++;
+				offset = strtoull(end, nullptr, 16);
+				if (offset >= IMAGE_BASE) offset -= IMAGE_BASE;
+				break;
+			}
+
+			fclose(file);
+			return offset;
+		}
+
+		// Cells of the loaded exterior grid. Returns the number written,
+		// or -1 if the read does not look like the loaded grid: every
+		// entry must be a cell of the player's worldspace, and the
+		// player's own cell must be among them.
+		static int ReadLoadedGrid(TESObjectCELL** outCells, TESObjectCELL* playerCell, TESWorldSpace* worldspace)
+		{
+			__try
+			{
+				UInt8* tes = *reinterpret_cast<UInt8**>(g_tesSingletonAddress);
+				if (!tes) return -1;
+
+				UInt8* grid = *reinterpret_cast<UInt8**>(tes + TES_OFFSET_GRID_CELLS);
+				if (!grid) return -1;
+
+				UInt32 length = *reinterpret_cast<UInt32*>(grid + GRID_CELLS_OFFSET_LENGTH);
+				if (length == 0 || length > (UInt32)GRID_MAX_LOADED_DIM) return -1;
+
+				TESObjectCELL** cells = *reinterpret_cast<TESObjectCELL***>(grid + GRID_CELLS_OFFSET_CELLS);
+				if (!cells) return -1;
+
+				int count = 0;
+				bool hasPlayerCell = false;
+				for (UInt32 i = 0; i < length * length; i++)
+				{
+					TESObjectCELL* cell = cells[i];
+					if (!cell) continue;
+					if (cell->formType != kFormType_Cell || cell->unk120 != worldspace) return -1;
+
+					if (cell == playerCell) hasPlayerCell = true;
+					outCells[count++] = cell;
+				}
+				return hasPlayerCell ? count : -1;
+			}
+			__except (EXCEPTION_EXECUTE_HANDLER)
+			{
+				return -1;
+			}
+		}
+
+		// ============================================
+		// SOURCE CELLS
+		// ============================================
+
+		static void AddCell(TESObjectCELL** cells, int& cellCount, TESObjectCELL* cell)
+		{
+			if (!cell || cellCount >= GRID_MAX_SOURCE_CELLS) return;
+
+			for (int i = 0; i < cellCount; i++)
+			{
+				if (cells[i] == cell) return;
+			}
+			cells[cellCount++] = cell;
+		}
+
+		static void AddCellOfForm(TESObjectCELL** cells, int& cellCount, UInt32 formID)
+		{
+			if (formID == 0) return;
+
+			TESForm* form = CountedLookupFormByID(formID);
+			if (!form || form->formType != kFormType_Character) return;
+
+			AddCell(cells, cellCount, static_cast<Actor*>(form)->parentCell);
+		}
+
+		static void AddLoadedGridCells(TESObjectCELL** cells, int& cellCount, TESObjectCELL* playerCell)
+		{
+			if (!playerCell || g_loadedGridDisabled) return;
+
+			// Interior - the player's cell is all there is
+			TESWorldSpace* worldspace = playerCell->unk120;
+			if (!worldspace) return;
+
+			if (!g_addressLookupDone)
+			{
+				g_addressLookupDone = true;
+				UInt64 offset = LookupAddressLibraryOffset(TES_SINGLETON_ID);
+				if (offset != 0)
+				{
+					g_tesSingletonAddress = RelocationManager::s_baseAddr + (uintptr_t)offset;
+				}
+			}
+
+			if (g_tesSingletonAddress == 0)
+			{
+				g_loadedGridDisabled = true;
+				_MESSAGE("SpatialGrid: TES address not found in %s - scanning tracked actors' cells only", ADDRESS_LIBRARY_FILE);
+				return;
+			}
+
+			TESObjectCELL* loaded[GRID_MAX_LOADED_DIM * GRID_MAX_LOADED_DIM];
+			int loadedCount = ReadLoadedGrid(loaded, playerCell, worldspace);
+			if (loadedCount < 0)
+			{
+				// A cell change can fail a read or two; only a layout that
+				// never passes turns the walk off
+				if (!g_loadedGridVerified && ++g_loadedGridFailures >= LOADED_GRID_MAX_FAILURES)
+				{
+					g_loadedGridDisabled = true;
+					_MESSAGE("SpatialGrid: loaded grid read failed %d times - scanning tracked actors' cells only", g_loadedGridFailures);
+				}
+				return;
+			}
+
+			if (!g_loadedGridVerified)
+			{
+				g_loadedGridVerified = true;
+				_MESSAGE("SpatialGrid: loaded grid verified (%d cells around the player)", loadedCount);
+			}
+
+			for (int i = 0; i < loadedCount; i++)
+			{
+				AddCell(cells, cellCount, loaded[i]);
+			}
+		}
+
+		static int GatherSourceCells(TESObjectCELL** cells)
+		{
+			int cellCount = 0;
+
+			// Player's cell first: if the entry cap is hit, outlying cells lose out
+			TESObjectCELL* playerCell = (g_thePlayer && (*g_thePlayer)) ? (*g_thePlayer)->parentCell : nullptr;
+			AddCell(cells, cellCount, playerCell);
+			AddLoadedGridCells(cells, cellCount, playerCell);
+
+			for (int i = 0; i < MAX_TRACKED_NPCS; i++)
+			{
+				if (!g_riderColumns.valid[i]) continue;
+
+				AddCellOfForm(cells, cellCount, g_riderColumns.actorFormID[i]);
+				AddCellOfForm(cells, cellCount, g_riderColumns.targetFormID[i]);
+			}
+
+			for (int i = 0; i < MAX_TRACKED_COMPANIONS; i++)
+			{
+				MountedCompanionData* data = GetCompanionDataByIndex(i);
+				if (!data || !data->isValid) continue;
+
+				AddCellOfForm(cells, cellCount, data->companionFormID);
+				AddCellOfForm(cells, cellCount, data->targetFormID);
+			}
+
+			return cellCount;
+		}
+
+		// ============================================
+		// REBUILD
+		// ============================================
+
+		static void Rebuild()
+		{
+			PROFILE_SCOPE(SpatialGridRebuild);
+			TRACE_SCOPE("SpatialGridRebuild");
+
+			static TESObjectCELL* s_cells[GRID_MAX_SOURCE_CELLS];
+			int cellCount = GatherSourceCells(s_cells);
+
+			int gathered = 0;
+			for (int c = 0; c < cellCount && gathered < GRID_MAX_ENTRIES; c++)
+			{
+				TESObjectCELL* cell = s_cells[c];
+				PERF_COUNT(CellScans);
+
+				for (UInt32 i = 0; i < cell->objectList.count; i++)
+				{
+					TESObjectREFR* ref = nullptr;
+					cell->objectList.GetNthItem(i, ref);
+
+					if (!ref) continue;
+					if (ref->formType != kFormType_Character) continue;
+
+					if (gathered >= GRID_MAX_ENTRIES)
+					{
+						if (!g_loggedOverflow)
+						{
+							_MESSAGE("SpatialGrid: More than %d actors in %d cells - actors in the remaining cells ignored", GRID_MAX_ENTRIES, cellCount);
+							g_loggedOverflow = true;
+						}
+						break;
+					}
+
+					GridEntry& entry = g_gathered[gathered++];
+					entry.formID = ref->formID;
+					entry.x = ref->pos.x;
+					entry.y = ref->pos.y;
+					entry.z = ref->pos.z;
+				}
+			}
+
+			g_index.entries = g_entryStorage;
+			BuildGridIndex(g_gathered, gathered, g_index);
+		}
+
+		static void EnsureFresh()
+		{
+			float now = GetGameTime();
+			if (g_gridValid && (now - g_lastBuildTime) < GRID_MAX_AGE && now >= g_lastBuildTime)
+			{
+				return;
+			}
+
+			Rebuild();
+			g_lastBuildTime = now;
+			g_gridValid = true;
+		}
+
+		// ============================================
+		// QUERIES
+		// ============================================
+
+		struct ResolveContext
+		{
+			float x, y, z;
+			GridPredicate predicate;
+			void* predicateContext;
+		};
+
+		// Resolve an entry to its live actor by formID (an actor unloaded
+		// or deleted since the build is dropped; formIDs of deleted
+		// references can be reused, so the type is checked too). The
+		// distance is replaced with the live one before the predicate.
+		static bool ResolveEntry(int entryIndex, float maxDistSq, float& inOutDistSq, void* context)
+		{
+			const ResolveContext* resolve = static_cast<const ResolveContext*>(context);
+
+			TESForm* form = CountedLookupFormByID(g_index.entries[entryIndex].formID);
+			if (!form || form->formType != kFormType_Character) return false;
+
+			Actor* actor = static_cast<Actor*>(form);
+			float dx = actor->pos.x - resolve->x;
+			float dy = actor->pos.y - resolve->y;
+			float dz = actor->pos.z - resolve->z;
+			inOutDistSq = dx * dx + dy * dy + dz * dz;
+			if (inOutDistSq > maxDistSq) return false;
+			if (resolve->predicate && !resolve->predicate(actor, resolve->predicateContext)) return false;
+
+			g_resolved[entryIndex] = actor;
+			return true;
+		}
+
+		int QueryRadius(float x, float y, float z, float radius,
+			GridPredicate predicate, void* context, Actor** outActors, int maxResults)
+		{
+			if (!outActors || maxResults <= 0 || radius < 0) return 0;
+			if (maxResults > GRID_MAX_ENTRIES) maxResults = GRID_MAX_ENTRIES;
+
+			EnsureFresh();
+
+			ResolveContext resolve = { x, y, z, predicate, context };
+			int found = QueryIndexRadius(g_index, x, y, z, radius, ResolveEntry, &resolve, g_queryEntries, maxResults);
+
+			for (int i = 0; i < found; i++)
+			{
+				outActors[i] = g_resolved[g_queryEntries[i]];
+			}
+			return found;
+		}
+
+		int QueryNearest(float x, float y, float z, float maxRadius, int k,
+			GridPredicate predicate, void* context, Actor** outActors, float* outDistances)
+		{
+			if (!outActors || k <= 0 || maxRadius < 0) return 0;
+			if (k > GRID_MAX_NEAREST) k = GRID_MAX_NEAREST;
+
+			EnsureFresh();
+
+			ResolveContext resolve = { x, y, z, predicate, context };
+			int entries[GRID_MAX_NEAREST];
+			float distSq[GRID_MAX_NEAREST];
+			int found = QueryIndexNearest(g_index, x, y, z, maxRadius, k, ResolveEntry, &resolve, entries, distSq);
+
+			for (int i = 0; i < found; i++)
+			{
+				outActors[i] = g_resolved[entries[i]];
+				if (outDistances) outDistances[i] = sqrtf(distSq[i]);
+			}
+			return found;
+		}
+
+		Actor* FindNearest(float x, float y, float z, float maxRadius,
+			GridPredicate predicate, void* context, float* outDistance)
+		{
+			Actor* nearest = nullptr;
+			float distance = 0.0f;
+
+			if (QueryNearest(x, y, z, maxRadius, 1, predicate, context, &nearest, &distance) == 0)
+			{
+				return nullptr;
+			}
+
+			if (outDistance) *outDistance = distance;
+			return nearest;
+		}
+
+		// ============================================
+		// MAINTENANCE
+		// ============================================
+
+		void InvalidateGrid()
+		{
+			g_gridValid = false;
+		}
+
+		int GetGridActorCount()
+		{
+			return g_index.entryCount;
+		}
+
+		void ResetGrid()
+		{
+			g_index.entryCount = 0;
+			g_index.dimX = 0;
+			g_index.dimY = 0;
+			g_gridValid = false;
+			g_loggedOverflow = false;
+
+			// Retry the loaded grid walk (the address lookup is kept)
+			g_loadedGridDisabled = false;
+			g_loadedGridVerified = false;
+			g_loadedGridFailures = 0;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// SPATIAL GRID (actors in all known loaded cells)
+	// ============================================
+	// The scanners used to walk player->parentCell->objectList on every
+	// query. That misses actors a few hundred units away across a cell
+	// border, and costs O(all refs in the cell) per query.
+	//
+	// This grid collects the actors from every loaded cell around the
+	// player (the engine's loaded exterior grid, uGridsToLoad x
+	// uGridsToLoad cells), plus the cells of the player, the tracked
+	// riders and their targets, and the tracked companions and their
+	// targets. It then buckets them into a uniform 2D grid.
+	//
+	// SKSE64 VR does not expose the loaded grid, so it is read through
+	// the SE layout at the VR Address Library's TES address. A read is
+	// only used if it contains the player's own cell and every entry is
+	// a cell of the player's worldspace. If that never holds, the walk
+	// turns itself off and only the tracked actors' cells are scanned.
+	// Interiors have no grid; their one cell is the player's.
+	//
+	// Capacity: GRID_MAX_ENTRIES actors per build. 25 loaded cells with
+	// a busy city among them hold a few hundred actors. The player's
+	// cell is walked first, so if the cap is ever hit, the actors left
+	// out are the ones in outlying cells (logged once per session).
+	//
+	// The grid is rebuilt lazily by the first query once it is older
+	// than GRID_MAX_AGE. All queries in the same tick share one rebuild,
+	// and the rebuild is one counting-sort pass. Positions are at most
+	// GRID_MAX_AGE old.
+	//
+	// The grid holds formIDs and build-time positions, never Actor
+	// pointers: an actor unloaded or deleted between rebuilds cannot be
+	// handed out. Candidates are resolved by formID when a query reaches
+	// them, and the final distance test uses the live position.
+	//
+	// Distances are 3D (same as GetDistanceBetween); buckets are 2D.
+	// The index build and the queries over it do not touch the engine;
+	// they live in SpatialGridMath.cpp (tests/SpatialGridBench.cpp).
+	// GAME THREAD ONLY - returned Actor pointers are valid for this tick.
+	// ============================================
+
+	namespace SpatialGrid
+	{
+		const float GRID_BUCKET_SIZE = 512.0f;        // Minimum bucket edge (grows if actors spread further)
+		const int GRID_MAX_DIM = 64;                  // Max buckets per axis
+		const int GRID_MAX_ENTRIES = 2048;            // Max actors held (see Capacity above)
+		const int GRID_MAX_LOADED_DIM = 11;           // Largest loaded grid read (uGridsToLoad up to 11)
+		const int GRID_MAX_SOURCE_CELLS = GRID_MAX_LOADED_DIM * GRID_MAX_LOADED_DIM + 32;   // Loaded grid + tracked actors' cells
+		const int GRID_MAX_NEAREST = 16;              // Max k for QueryNearest
+		const float GRID_MAX_AGE = 0.1f;              // Seconds before a query triggers a rebuild
+
+		// ============================================
+		// GRID INDEX (engine independent)
+		// ============================================
+
+		struct GridEntry
+		{
+			UInt32 formID;
+			float x, y, z;      // Position at build time (bucketing / pruning only)
+			int bucket;
+		};
+
+		// CSR layout: entries are sorted by bucket, and bucket b owns
+		// entries[bucketStart[b] .. bucketStart[b + 1]).
+		struct GridIndex
+		{
+			GridEntry* entries;            // Caller's storage, at least as many as are built
+			int bucketStart[GRID_MAX_DIM * GRID_MAX_DIM + 1];
+			int entryCount;
+			float originX;
+			float originY;
+			float bucketSize;
+			int dimX;
+			int dimY;
+		};
+
+		// Bucket gathered[0..count) into index.entries with a counting
+		// sort. Buckets start at GRID_BUCKET_SIZE and grow so the grid
+		// never exceeds GRID_MAX_DIM per axis. Rewrites gathered[].bucket.
+		void BuildGridIndex(GridEntry* gathered, int count, GridIndex& index);
+
+		// Called for each entry whose build position is in range, with
+		// its build-time distance squared. It may replace that with a live
+		// distance, and must return false if the entry is gone, fails the
+		// caller's test, or is now further than maxDistSq.
+		typedef bool (*GridEntryFilter)(int entryIndex, float maxDistSq, float& inOutDistSq, void* context);
+
+		// Entries within radius (unordered); outEntries gets entry indices
+		int QueryIndexRadius(const GridIndex& index, float x, float y, float z, float radius,
+			GridEntryFilter filter, void* context, int* outEntries, int maxResults);
+
+		// Up to k nearest entries within maxRadius, nearest first (k <=
+		// GRID_MAX_NEAREST). outDistSq may be nullptr.
+		int QueryIndexNearest(const GridIndex& index, float x, float y, float z, float maxRadius, int k,
+			GridEntryFilter filter, void* context, int* outEntries, float* outDistSq);
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Return true to accept an actor. 'context' is passed through untouched.
+		typedef bool (*GridPredicate)(Actor* actor, void* context);
+
+		// All actors within radius of (x,y,z) that pass the predicate (nullptr = all)
+		// Unordered. Returns the number written to outActors.
+		int QueryRadius(float x, float y, float z, float radius,
+			GridPredicate predicate, void* context, Actor** outActors, int maxResults);
+
+		// Up to k nearest actors within maxRadius that pass the predicate,
+		// nearest first. outDistances may be nullptr.
+		int QueryNearest(float x, float y, float z, float maxRadius, int k,
+			GridPredicate predicate, void* context, Actor** outActors, float* outDistances);
+
+		// Single nearest actor (nullptr if none)
+		Actor* FindNearest(float x, float y, float z, float maxRadius,
+			GridPredicate predicate, void* context, float* outDistance = nullptr);
+
+		// Force the next query to rebuild (e.g. after a mass spawn)
+		void InvalidateGrid();
+
+		// Actors in the last build (diagnostics)
+		int GetGridActorCount();
+
+		// Drop all entries (mod deactivate / cell change)
+		void ResetGrid();
+	}
+}
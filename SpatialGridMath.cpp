@@ -0,0 +1,235 @@
+#include "SpatialGrid.h"
+#include <cmath>
+
+// Index build and queries for SpatialGrid. Engine independent so they
+// can be built and measured on their own; see tests/SpatialGridBench.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace SpatialGrid
+	{
+		// ============================================
+		// BUILD
+		// ============================================
+
+		void BuildGridIndex(GridEntry* gathered, int count, GridIndex& index)
+		{
+			index.entryCount = 0;
+			index.dimX = 0;
+			index.dimY = 0;
+
+			if (count <= 0) return;
+
+			float minX = gathered[0].x;
+			float maxX = gathered[0].x;
+			float minY = gathered[0].y;
+			float maxY = gathered[0].y;
+
+			for (int i = 1; i < count; i++)
+			{
+				const GridEntry& entry = gathered[i];
+				if (entry.x < minX) minX = entry.x;
+				if (entry.x > maxX) maxX = entry.x;
+				if (entry.y < minY) minY = entry.y;
+				if (entry.y > maxY) maxY = entry.y;
+			}
+
+			// Grid geometry - grow buckets rather than exceed GRID_MAX_DIM
+			float extent = (maxX - minX) > (maxY - minY) ? (maxX - minX) : (maxY - minY);
+			index.bucketSize = GRID_BUCKET_SIZE;
+			if (extent / index.bucketSize >= (float)GRID_MAX_DIM)
+			{
+				index.bucketSize = extent / (float)(GRID_MAX_DIM - 1);
+			}
+
+			index.originX = minX;
+			index.originY = minY;
+			index.dimX = (int)((maxX - minX) / index.bucketSize) + 1;
+			index.dimY = (int)((maxY - minY) / index.bucketSize) + 1;
+			if (index.dimX > GRID_MAX_DIM) index.dimX = GRID_MAX_DIM;
+			if (index.dimY > GRID_MAX_DIM) index.dimY = GRID_MAX_DIM;
+
+			int bucketCount = index.dimX * index.dimY;
+
+			// Count per bucket
+			for (int b = 0; b <= bucketCount; b++)
+			{
+				index.bucketStart[b] = 0;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				GridEntry& entry = gathered[i];
+				int bx = (int)((entry.x - index.originX) / index.bucketSize);
+				int by = (int)((entry.y - index.originY) / index.bucketSize);
+				if (bx >= index.dimX) bx = index.dimX - 1;
+				if (by >= index.dimY) by = index.dimY - 1;
+				entry.bucket = by * index.dimX + bx;
+				index.bucketStart[entry.bucket + 1]++;
+			}
+
+			// Prefix sum, then scatter
+			for (int b = 0; b < bucketCount; b++)
+			{
+				index.bucketStart[b + 1] += index.bucketStart[b];
+			}
+
+			int cursor[GRID_MAX_DIM * GRID_MAX_DIM];
+			for (int b = 0; b < bucketCount; b++)
+			{
+				cursor[b] = index.bucketStart[b];
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				index.entries[cursor[gathered[i].bucket]++] = gathered[i];
+			}
+
+			index.entryCount = count;
+		}
+
+		// ============================================
+		// QUERIES
+		// ============================================
+
+		// Bucket coordinate range covering [center - radius, center + radius]
+		static void GetBucketRange(const GridIndex& index, float x, float y, float radius,
+			int& minBX, int& minBY, int& maxBX, int& maxBY)
+		{
+			minBX = (int)floorf((x - radius - index.originX) / index.bucketSize);
+			minBY = (int)floorf((y - radius - index.originY) / index.bucketSize);
+			maxBX = (int)floorf((x + radius - index.originX) / index.bucketSize);
+			maxBY = (int)floorf((y + radius - index.originY) / index.bucketSize);
+
+			if (minBX < 0) minBX = 0;
+			if (minBY < 0) minBY = 0;
+			if (maxBX >= index.dimX) maxBX = index.dimX - 1;
+			if (maxBY >= index.dimY) maxBY = index.dimY - 1;
+		}
+
+		static float DistanceSquared(const GridEntry& entry, float x, float y, float z)
+		{
+			float dx = entry.x - x;
+			float dy = entry.y - y;
+			float dz = entry.z - z;
+			return dx * dx + dy * dy + dz * dz;
+		}
+
+		int QueryIndexRadius(const GridIndex& index, float x, float y, float z, float radius,
+			GridEntryFilter filter, void* context, int* outEntries, int maxResults)
+		{
+			if (!outEntries || maxResults <= 0 || radius < 0) return 0;
+			if (index.entryCount == 0) return 0;
+
+			int minBX, minBY, maxBX, maxBY;
+			GetBucketRange(index, x, y, radius, minBX, minBY, maxBX, maxBY);
+
+			float radiusSq = radius * radius;
+			int found = 0;
+
+			for (int by = minBY; by <= maxBY; by++)
+			{
+				for (int bx = minBX; bx <= maxBX; bx++)
+				{
+					int bucket = by * index.dimX + bx;
+					for (int e = index.bucketStart[bucket]; e < index.bucketStart[bucket + 1]; e++)
+					{
+						float distSq = DistanceSquared(index.entries[e], x, y, z);
+						if (distSq > radiusSq) continue;
+						if (filter && !filter(e, radiusSq, distSq, context)) continue;
+
+						outEntries[found++] = e;
+						if (found >= maxResults) return found;
+					}
+				}
+			}
+
+			return found;
+		}
+
+		int QueryIndexNearest(const GridIndex& index, float x, float y, float z, float maxRadius, int k,
+			GridEntryFilter filter, void* context, int* outEntries, float* outDistSq)
+		{
+			if (!outEntries || k <= 0 || maxRadius < 0) return 0;
+			if (k > GRID_MAX_NEAREST) k = GRID_MAX_NEAREST;
+			if (index.entryCount == 0) return 0;
+
+			int bestEntries[GRID_MAX_NEAREST];
+			float bestDistSq[GRID_MAX_NEAREST];
+			int bestCount = 0;
+			float maxRadiusSq = maxRadius * maxRadius;
+
+			// Visit buckets in square rings around the query bucket and
+			// stop once a ring cannot contain anything closer than the
+			// current k-th best
+			int centerBX = (int)floorf((x - index.originX) / index.bucketSize);
+			int centerBY = (int)floorf((y - index.originY) / index.bucketSize);
+			int maxRing = (int)(maxRadius / index.bucketSize) + 1;
+
+			for (int ring = 0; ring <= maxRing; ring++)
+			{
+				// Every point in ring r is at least (r - 1) buckets away in 2D
+				if (ring > 1)
+				{
+					float ringMin = (ring - 1) * index.bucketSize;
+					float ringMinSq = ringMin * ringMin;
+					if (ringMinSq > maxRadiusSq) break;
+					if (bestCount == k && ringMinSq > bestDistSq[bestCount - 1]) break;
+				}
+
+				int rowMin = (centerBY - ring < 0) ? 0 : centerBY - ring;
+				int rowMax = (centerBY + ring >= index.dimY) ? index.dimY - 1 : centerBY + ring;
+
+				for (int by = rowMin; by <= rowMax; by++)
+				{
+					// Top/bottom rows of the ring are walked fully, the rest only at the two edges
+					bool fullRow = (ring == 0 || by == centerBY - ring || by == centerBY + ring);
+					int step = fullRow ? 1 : 2 * ring;
+
+					for (int bx = centerBX - ring; bx <= centerBX + ring; bx += step)
+					{
+						if (bx < 0 || bx >= index.dimX) continue;
+
+						int bucket = by * index.dimX + bx;
+						for (int e = index.bucketStart[bucket]; e < index.bucketStart[bucket + 1]; e++)
+						{
+							float limitSq = (bestCount == k) ? bestDistSq[bestCount - 1] : maxRadiusSq;
+							float distSq = DistanceSquared(index.entries[e], x, y, z);
+							if (distSq > maxRadiusSq) continue;
+							if (bestCount == k && distSq >= limitSq) continue;
+							if (filter && !filter(e, limitSq, distSq, context)) continue;
+							if (distSq > maxRadiusSq) continue;
+							if (bestCount == k && distSq >= limitSq) continue;
+
+							// Insert into the sorted best list
+							int slot = (bestCount < k) ? bestCount++ : (k - 1);
+							while (slot > 0 && bestDistSq[slot - 1] > distSq)
+							{
+								bestEntries[slot] = bestEntries[slot - 1];
+								bestDistSq[slot] = bestDistSq[slot - 1];
+								slot--;
+							}
+							bestEntries[slot] = e;
+							bestDistSq[slot] = distSq;
+						}
+					}
+				}
+
+				// Ring already covers the whole grid - nothing further out
+				if (centerBX - ring <= 0 && centerBY - ring <= 0 &&
+					centerBX + ring >= index.dimX - 1 && centerBY + ring >= index.dimY - 1)
+				{
+					break;
+				}
+			}
+
+			for (int i = 0; i < bestCount; i++)
+			{
+				outEntries[i] = bestEntries[i];
+				if (outDistSq) outDistSq[i] = bestDistSq[i];
+			}
+
+			return bestCount;
+		}
+	}
+}
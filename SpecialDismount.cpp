@@ -10,6 +10,7 @@
 #include "SpecialMovesets.h"
 #include "CombatStyles.h" // For ClearRangedRoleForRider
 #include "MagicCastingSystem.h" // For resetting mage state on dismount
+#include "PerfCounters.h"
 #include "skse64/GameReferences.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
@@ -57,8 +58,8 @@ namespace MountedNPCCombatVR
 
 	void taskPushActorAway::Run()
 	{
-		TESForm* sourceForm = LookupFormByID(m_sourceFormID);
-		TESForm* targetForm = LookupFormByID(m_targetFormID);
+		TESForm* sourceForm = CountedLookupFormByID(m_sourceFormID);
+		TESForm* targetForm = CountedLookupFormByID(m_targetFormID);
 		
 		if (!sourceForm || !targetForm) return;
 		
@@ -86,7 +87,7 @@ namespace MountedNPCCombatVR
 		
 		virtual void Run()
 		{
-			TESForm* form = LookupFormByID(m_pulledRiderFormID);
+			TESForm* form = CountedLookupFormByID(m_pulledRiderFormID);
 			if (!form) return;
 			
 			Actor* pulledRider = DYNAMIC_CAST(form, TESForm, Actor);
@@ -111,7 +112,7 @@ namespace MountedNPCCombatVR
 		
 		virtual void Run()
 		{
-			TESForm* form = LookupFormByID(m_actorFormID);
+			TESForm* form = CountedLookupFormByID(m_actorFormID);
 			if (!form) return;
 			
 			Actor* actor = DYNAMIC_CAST(form, TESForm, Actor);
@@ -123,6 +124,7 @@ namespace MountedNPCCombatVR
 			SetActorMass(actor, DEFAULT_MASS);
 			
 			// Force actor to get up / exit ragdoll by evaluating package
+			PERF_COUNT(EvaluatePackageCalls);
 			Actor_EvaluatePackage(actor, false, false);
 			
 			_MESSAGE("SpecialDismount: Restored actor %08X from ragdoll (mass reset to %.0f)", m_actorFormID, DEFAULT_MASS);
@@ -283,6 +285,7 @@ namespace MountedNPCCombatVR
 			ally->flags2 |= Actor::kFlag_kAttackOnSight;
 			
 			// Force AI re-evaluation
+			PERF_COUNT(EvaluatePackageCalls);
 			Actor_EvaluatePackage(ally, false, false);
 			
 			alliesAlerted++;
@@ -317,6 +320,7 @@ namespace MountedNPCCombatVR
 		pulledRider->flags2 |= Actor::kFlag_kAttackOnSight;
 		
 		// Force AI re-evaluation to make them attack
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(pulledRider, false, false);
 		
 		// Alert nearby allies
@@ -386,6 +390,7 @@ namespace MountedNPCCombatVR
 		
 		Actor_ClearKeepOffsetFromActor(horse);
 		ClearInjectedPackages(horse);
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
 		GrabbedHorseData* data = CreateGrabbedHorseData(horse->formID);
@@ -422,8 +427,8 @@ namespace MountedNPCCombatVR
 		
 		if (data->wasInCombat && data->riderFormID != 0 && data->targetFormID != 0)
 		{
-			TESForm* riderForm = LookupFormByID(data->riderFormID);
-			TESForm* targetForm = LookupFormByID(data->targetFormID);
+			TESForm* riderForm = CountedLookupFormByID(data->riderFormID);
+			TESForm* targetForm = CountedLookupFormByID(data->targetFormID);
 			
 			if (riderForm && targetForm)
 			{
@@ -438,12 +443,14 @@ namespace MountedNPCCombatVR
 						NiPoint3 offset = {0, -300.0f, 0};
 						NiPoint3 offsetAngle = {0, 0, 0};
 						Actor_KeepOffsetFromActor(horse, targetHandle, offset, offsetAngle, 1500.0f, 300.0f);
+						PERF_COUNT(EvaluatePackageCalls);
 						Actor_EvaluatePackage(horse, false, false);
 					}
 				}
 			}
 		}
 		
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		RemoveGrabbedHorseData(horse->formID);
 	}
@@ -507,10 +514,12 @@ namespace MountedNPCCombatVR
 		
 		// Queue ragdoll on main thread
 		Actor* player = *g_thePlayer;
+		PERF_COUNT(TaskSubmissions);
 		g_task->AddTask(new taskPushActorAway(player->formID, target->formID, RAGDOLL_FORCE));
 		
 		// Queue aggression trigger on main thread (must be done from main thread)
 		UInt32 targetFormID = target->formID;
+		PERF_COUNT(TaskSubmissions);
 		g_task->AddTask(new taskTriggerAggression(targetFormID));
 		
 		// Notify scanner that this NPC was dismounted (pulled off by player)
@@ -523,6 +532,7 @@ namespace MountedNPCCombatVR
 			
 			if (g_task)
 			{
+				PERF_COUNT(TaskSubmissions);
 				g_task->AddTask(new taskRestoreFromRagdoll(targetFormID));
 			}
 		}).detach();
@@ -587,7 +597,7 @@ namespace MountedNPCCombatVR
 			{
 				if (g_grabs[i].isValid && !g_grabs[i].isMount)
 				{
-					TESForm* form = LookupFormByID(g_grabs[i].grabbedFormID);
+					TESForm* form = CountedLookupFormByID(g_grabs[i].grabbedFormID);
 					if (!form)
 					{
 						g_grabs[i].isValid = false;
@@ -9,6 +9,15 @@
 #include "Helper.h"
 #include "config.h"
 #include "FactionData.h"  // For IsActorHostileToActor
+#include "EncounterGraph.h"
+#include "AttackSlots.h"
+#include "PursuitField.h"
+#include "SteeringKernel.h"
+#include "HazardMap.h"
+#include "GroundHeight.h"  // For GetCellWorldSpaceID
+#include "PerfCounters.h"
+#include "ManeuverScript.h"
+#include "ManeuverSelection.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include "skse64/GameReferences.h"
@@ -40,7 +49,7 @@ namespace MountedNPCCombatVR
 	
 	// Cooldown (shared between all rear up triggers)
 	// REAR_UP_COOLDOWN now uses RearUpCooldown from config
-	const float REAR_UP_GLOBAL_COOLDOWN = 8.0f; // 8 seconds global cooldown - no horse can rear up if ANY horse reared up recently
+	const float REAR_UP_GLOBAL_COOLDOWN = 8.0f; // 8 seconds encounter cooldown - no horse can rear up if ANY horse in the same encounter reared up recently
 	
 	// Horse jump (obstruction escape)
 	const UInt32 HORSE_JUMP_BASE_FORMID = 0x0008E6;  // From MountedNPCCombat.esp
@@ -54,6 +63,8 @@ namespace MountedNPCCombatVR
 	const float CHARGE_EQUIP_DURATION = 1.0f; // Time to wait for weapon equip (increased for sheathe + equip)
 	const float CHARGE_SPRINT_TIMEOUT = 5.0f;  // Max sprint time before auto-canceling charge
 	const float CHARGE_MELEE_RANGE = 110.0f;    // Closer melee range during charge (horse gets right in front of player)
+	const float CHARGE_BAND_MIN_DISTANCE = 700.0f;   // ChargeMin/MaxDistance only narrow this band
+	const float CHARGE_BAND_MAX_DISTANCE = 1500.0f;
 	
 	// Rapid Fire maneuver configuration (most now loaded from INI)
 	// RapidFireChancePercent, RapidFireCooldown, RapidFireDuration from config
@@ -82,12 +93,10 @@ namespace MountedNPCCombatVR
 	
 	static bool g_maneuverSystemInitialized = false;
 	
-	// Global rear up tracking (prevents synchronized rear ups)
-	static float g_lastGlobalRearUpTime = -8.0f;  // Initialize to allow immediate first use
-	
-	// Global rapid fire tracking (prevents synchronized rapid fires)
-	const float RAPID_FIRE_GLOBAL_COOLDOWN = 10.0f;  // 10 seconds global cooldown - no horse can rapid fire if ANY horse is rapid firing recently
-	static float g_lastGlobalRapidFireTime = -10.0f;  // Initialize to allow immediate first use
+	// Rapid fire cooldown shared by an encounter (prevents synchronized rapid fires)
+	// Rear up and rapid fire cooldowns are per encounter (EncounterGraph.h) so
+	// horses in an unrelated battle elsewhere do not block each other.
+	const float RAPID_FIRE_GLOBAL_COOLDOWN = 10.0f;  // 10 seconds encounter cooldown - no horse can rapid fire if ANY horse in the same encounter rapid fired recently
 	
 	const int MAX_TRACKED_HORSES = 10;  // Array size (hardcoded max for memory safety)
 	// Actual runtime limit uses MaxTrackedMountedNPCs from config
@@ -96,11 +105,10 @@ namespace MountedNPCCombatVR
 	static TESIdleForm* g_horseJumpIdle = nullptr;
 	static bool g_jumpIdleInitialized = false;
 	
-	// Rear up tracking per horse
+	// Rear up tracking per horse (cooldowns are in the maneuver rate limiter)
 	struct HorseRearUpTracking
 	{
 		UInt32 horseFormID;
-		float lastRearUpTime;
 		float lastKnownHealth;
 		bool isValid;
 	};
@@ -115,6 +123,7 @@ namespace MountedNPCCombatVR
 		bool clockwise;
 		bool wasInMeleeRange;
 		float lastTurnDirectionChangeTime;  // Cooldown for mounted vs mounted
+		float nextHazardCheckTime;          // Hazard side check is rate limited (AvoidKnownHazardTurn)
 		bool isValid;
 	};
 	
@@ -133,6 +142,8 @@ namespace MountedNPCCombatVR
 	static int g_horseJumpCount = 0;
 	
 	// Charge maneuver tracking per horse
+	// The sequence itself is RunChargeScript; 'state' is the phase it is
+	// in, for the IsHorseCharging / already-charging queries
 	enum class ChargeState
 	{
 		None = 0,
@@ -147,9 +158,8 @@ namespace MountedNPCCombatVR
 		UInt32 horseFormID;
 		UInt32 riderFormID;
 		ChargeState state;
-		float lastChargeCheckTime;   // For 10-second interval between checks
-		float lastChargeCompleteTime; // For 45-second cooldown after charge
 		float stateStartTime;        // When current state started
+		ManeuverScript::ScriptState script;
 		bool isValid;
 	};
 	
@@ -169,9 +179,8 @@ namespace MountedNPCCombatVR
 		UInt32 horseFormID;
 		UInt32 riderFormID;
 		RapidFireState state;
-		float lastCheckTime;         // For 10-second interval between checks
-		float lastCompleteTime;    // For 45-second cooldown
 		float stateStartTime;      // When current state started
+		ManeuverScript::ScriptState script;  // RunRapidFireScript
 		bool isValid;
 	};
 	
@@ -200,8 +209,6 @@ namespace MountedNPCCombatVR
 	{
 		UInt32 horseFormID;
 		StandGroundState state;
-		float lastCheckTime;     // For check interval
-		float lastCompleteTime;   // For cooldown
 		float stateStartTime;    // When current state started
 		float standDuration;      // How long to stand (3-8 seconds)
 		float lockedAngle;       // The angle to lock to once 90-degree turn is achieved
@@ -209,6 +216,7 @@ namespace MountedNPCCombatVR
 		bool noRotation;      // 50% chance - if true, don't do 90-degree turn, just stay facing target
 		bool rotationLocked;     // True once the 90-degree turn is complete - NO MORE ROTATION!
 		bool target90DegreeAngleSet;  // True once the target angle has been calculated
+		ManeuverScript::ScriptState script;  // RunStandGroundScript
 		bool isValid;
 	};
 	
@@ -226,15 +234,67 @@ namespace MountedNPCCombatVR
 	const int PLAYER_AGGRO_SWITCH_CHANCE_MIN = 1;      // 1% chance at max range
 	const float PLAYER_AGGRO_SWITCH_INTERVAL = 25.0f;    // Check every 20 seconds
 	
-	struct PlayerAggroSwitchData
+	// ============================================
+	// MANEUVER RATE LIMITER (shared by all rolled maneuvers)
+	// ============================================
+	// Each maneuver used to keep its own check/cooldown timestamps in
+	// its own array, plus a bespoke "any horse in this encounter" scan
+	// for rear up and rapid fire. One entry per horse now holds the
+	// timestamps of every kind, and the limits per kind come from
+	// GetManeuverLimits.
+	
+	enum ManeuverKind : int
+	{
+		MANEUVER_REAR_UP = 0,
+		MANEUVER_CHARGE,
+		MANEUVER_RAPID_FIRE,
+		MANEUVER_STAND_GROUND,
+		MANEUVER_PLAYER_AGGRO,
+		MANEUVER_KIND_COUNT
+	};
+	
+	struct ManeuverLimits
+	{
+		float checkInterval;       // Min time between rolls
+		float cooldown;            // Min time from completion to next start
+		float encounterCooldown;   // Min time from any start in the same encounter (0 = none)
+	};
+	
+	struct HorseManeuverTimes
 	{
 		UInt32 horseFormID;
-		float lastCheckTime;
+		float lastCheckTime[MANEUVER_KIND_COUNT];
+		float lastStartTime[MANEUVER_KIND_COUNT];
+		float lastCompleteTime[MANEUVER_KIND_COUNT];
 		bool isValid;
 	};
 	
-	static PlayerAggroSwitchData g_playerAggroSwitchData[MAX_TRACKED_HORSES];
-	static int g_playerAggroSwitchCount = 0;
+	const float MANEUVER_NEVER = -100000.0f;  // Timestamp that satisfies every limit
+	
+	static HorseManeuverTimes g_maneuverTimes[MAX_TRACKED_HORSES];
+	static int g_maneuverTimesCount = 0;
+	
+	// Shared inputs for one arbitration pass (gathered once per horse per tick)
+	struct ManeuverInputs
+	{
+		Actor* horse;
+		Actor* rider;              // May be null (rear up only)
+		Actor* target;
+		Actor* player;             // May be null
+		MountedCombatClass combatClass;
+		float distanceToTarget;
+		float meleeRange;
+		float distanceToPlayer;    // 2D
+		float facingError;         // |horse heading - angle to target| (radians)
+		float combatElapsed;
+		float currentTime;
+		bool targetIsPlayer;
+		bool riderFleeing;
+		bool inStandGround;
+		bool charging;
+		bool inRapidFire;
+		bool bowEquipped;
+	};
 	
 	// ============================================
 	// CLOSE RANGE MELEE ASSAULT (EMERGENCY CLOSE COMBAT)
@@ -283,6 +343,141 @@ namespace MountedNPCCombatVR
 		return GetGameTime();
 	}
 	
+	// ============================================
+	// MANEUVER RATE LIMITER
+	// ============================================
+	
+	// Limits are read from config on every call (INI reload)
+	static ManeuverLimits GetManeuverLimits(ManeuverKind kind)
+	{
+		ManeuverLimits limits = { 0.0f, 0.0f, 0.0f };
+		switch (kind)
+		{
+			case MANEUVER_REAR_UP:
+				limits.cooldown = RearUpCooldown;
+				limits.encounterCooldown = REAR_UP_GLOBAL_COOLDOWN;
+				break;
+			case MANEUVER_CHARGE:
+				limits.checkInterval = CHARGE_CHECK_INTERVAL;
+				limits.cooldown = ChargeCooldown;
+				break;
+			case MANEUVER_RAPID_FIRE:
+				limits.checkInterval = RAPID_FIRE_CHECK_INTERVAL;
+				limits.cooldown = RapidFireCooldown;
+				limits.encounterCooldown = RAPID_FIRE_GLOBAL_COOLDOWN;
+				break;
+			case MANEUVER_STAND_GROUND:
+				limits.checkInterval = StandGroundCheckInterval;
+				limits.cooldown = StandGroundCooldown;
+				break;
+			case MANEUVER_PLAYER_AGGRO:
+				limits.checkInterval = PLAYER_AGGRO_SWITCH_INTERVAL;
+				break;
+			default:
+				break;
+		}
+		return limits;
+	}
+	
+	static HorseManeuverTimes* GetOrCreateManeuverTimes(UInt32 horseFormID)
+	{
+		for (int i = 0; i < g_maneuverTimesCount; i++)
+		{
+			if (g_maneuverTimes[i].isValid && g_maneuverTimes[i].horseFormID == horseFormID)
+			{
+				return &g_maneuverTimes[i];
+			}
+		}
+		
+		if (g_maneuverTimesCount < MAX_TRACKED_HORSES)
+		{
+			HorseManeuverTimes* times = &g_maneuverTimes[g_maneuverTimesCount];
+			times->horseFormID = horseFormID;
+			for (int k = 0; k < MANEUVER_KIND_COUNT; k++)
+			{
+				times->lastCheckTime[k] = MANEUVER_NEVER;   // Allow immediate first check
+				times->lastStartTime[k] = MANEUVER_NEVER;
+				times->lastCompleteTime[k] = MANEUVER_NEVER;  // Allow immediate first use
+			}
+			times->isValid = true;
+			g_maneuverTimesCount++;
+			return times;
+		}
+		
+		return nullptr;
+	}
+	
+	// True if the check interval for this kind has passed
+	static bool IsManeuverCheckDue(const HorseManeuverTimes* times, ManeuverKind kind, float currentTime)
+	{
+		return (currentTime - times->lastCheckTime[kind]) >= GetManeuverLimits(kind).checkInterval;
+	}
+	
+	// True if this horse's own cooldown, or the encounter cooldown (any
+	// horse in the same encounter started this kind recently), is running
+	static bool IsManeuverCoolingDown(const HorseManeuverTimes* times, ManeuverKind kind, float currentTime)
+	{
+		ManeuverLimits limits = GetManeuverLimits(kind);
+		
+		if ((currentTime - times->lastCompleteTime[kind]) < limits.cooldown)
+		{
+			return true;
+		}
+		
+		if (limits.encounterCooldown > 0.0f)
+		{
+			for (int i = 0; i < g_maneuverTimesCount; i++)
+			{
+				if (!g_maneuverTimes[i].isValid) continue;
+				if ((currentTime - g_maneuverTimes[i].lastStartTime[kind]) >= limits.encounterCooldown) continue;
+				
+				if (g_maneuverTimes[i].horseFormID == times->horseFormID ||
+					Encounters::AreInSameEncounter(times->horseFormID, g_maneuverTimes[i].horseFormID))
+				{
+					return true;
+				}
+			}
+		}
+		
+		return false;
+	}
+	
+	static void MarkManeuverChecked(UInt32 horseFormID, ManeuverKind kind, float currentTime)
+	{
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horseFormID);
+		if (times) times->lastCheckTime[kind] = currentTime;
+	}
+	
+	// Also starts the encounter cooldown
+	static void MarkManeuverStarted(UInt32 horseFormID, ManeuverKind kind, float currentTime)
+	{
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horseFormID);
+		if (times) times->lastStartTime[kind] = currentTime;
+	}
+	
+	// Starts this horse's cooldown
+	static void MarkManeuverCompleted(UInt32 horseFormID, ManeuverKind kind, float currentTime)
+	{
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horseFormID);
+		if (times) times->lastCompleteTime[kind] = currentTime;
+	}
+	
+	static void ClearManeuverTimes(UInt32 horseFormID)
+	{
+		for (int i = 0; i < g_maneuverTimesCount; i++)
+		{
+			if (g_maneuverTimes[i].isValid && g_maneuverTimes[i].horseFormID == horseFormID)
+			{
+				for (int j = i; j < g_maneuverTimesCount - 1; j++)
+				{
+					g_maneuverTimes[j] = g_maneuverTimes[j + 1];
+				}
+				g_maneuverTimesCount--;
+				return;
+			}
+		}
+	}
+	
 	// Helper function to calculate angle to target
 	static float GetAngleToTarget(Actor* horse, Actor* target)
 	{
@@ -308,7 +503,6 @@ namespace MountedNPCCombatVR
 		{
 			HorseRearUpTracking* data = &g_horseRearUpTracking[g_horseRearUpCount];
 			data->horseFormID = horseFormID;
-			data->lastRearUpTime = -RearUpCooldown;  // Allow immediate first use
 			data->lastKnownHealth = 0;
 			data->isValid = true;
 			g_horseRearUpCount++;
@@ -335,7 +529,7 @@ namespace MountedNPCCombatVR
 		
 		if (jumpFormID != 0)
 		{
-			TESForm* jumpForm = LookupFormByID(jumpFormID);
+			TESForm* jumpForm = CountedLookupFormByID(jumpFormID);
 			if (jumpForm)
 			{
 				g_horseJumpIdle = DYNAMIC_CAST(jumpForm, TESForm, TESIdleForm);
@@ -373,12 +567,6 @@ namespace MountedNPCCombatVR
 		
 		_MESSAGE("SpecialMovesets: Initializing...");
 		
-		// Reset global rear up cooldown
-		g_lastGlobalRearUpTime = -REAR_UP_GLOBAL_COOLDOWN;
-		
-		// Reset global rapid fire cooldown
-		g_lastGlobalRapidFireTime = -RAPID_FIRE_GLOBAL_COOLDOWN;
-		
 		// Clear rear up tracking data
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
 		{
@@ -429,12 +617,12 @@ namespace MountedNPCCombatVR
 		}
 		g_horseStandGroundCount = 0;
 		
-		// Clear player aggro switch data
+		// Clear maneuver rate limiter (checks, cooldowns, encounter cooldowns)
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
 		{
-			g_playerAggroSwitchData[i].isValid = false;
+			g_maneuverTimes[i].isValid = false;
 		}
-		g_playerAggroSwitchCount = 0;
+		g_maneuverTimesCount = 0;
 		
 		// Clear close range melee assault data
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
@@ -470,12 +658,14 @@ namespace MountedNPCCombatVR
 			g_horseJumpData[i].isValid = false;
 			g_horseChargeData[i].isValid = false;
 			g_horseRapidFireData[i].isValid = false;
+			g_maneuverTimes[i].isValid = false;
 		}
 		g_horseRearUpCount = 0;
 		g_horseTurnCount = 0;
 		g_horseJumpCount = 0;
 		g_horseChargeCount = 0;
 		g_horseRapidFireCount = 0;
+		g_maneuverTimesCount = 0;
 		
 		g_maneuverSystemInitialized = false;
 	}
@@ -593,97 +783,45 @@ namespace MountedNPCCombatVR
 	}
 	
 	// ============================================
-	// HORSE JUMP - ON APPROACH
+	// REAR UP - ON APPROACH
 	// ============================================
+	// Rolled by ArbitrateManeuvers when the horse faces the target
+	// head-on in melee range.
 	
-	bool TryRearUpOnApproach(Actor* horse, Actor* target, float distanceToTarget)
+	// Chance to start (0 = not eligible)
+	static int ScoreRearUpOnApproach(const ManeuverInputs& in, const HorseManeuverTimes* times)
 	{
-		if (!horse || !target) return false;
-		
-		// Check if rear up is enabled
-		if (!RearUpEnabled) return false;
-		
-		// Block if rider is fleeing
-		if (IsHorseRiderFleeing(horse->formID)) return false;
-		
-		// Block if in stand ground
-		if (IsInStandGround(horse->formID)) return false;
-		
-		// ============================================
-		// EXCLUDE CIVILIANS - They flee, not fight
-		// ============================================
-		NiPointer<Actor> rider;
-		if (CALL_MEMBER_FN(horse, GetMountedBy)(rider) && rider)
-		{
-			MountedCombatClass combatClass = DetermineCombatClass(rider.get());
-			if (combatClass == MountedCombatClass::CivilianFlee)
-			{
-				return false;
-			}
-		}
-		
-		// Check distance
-		if (distanceToTarget > REAR_UP_APPROACH_DISTANCE)
-		{
-			return false;
-		}
-		
-		// Check if horse is facing target head-on
-		float dx = target->pos.x - horse->pos.x;
-		float dy = target->pos.y - horse->pos.y;
-		float angleToTarget = atan2(dx, dy);
-		
-		float currentAngle = horse->rot.z;
-		float angleDiff = angleToTarget - currentAngle;
-		
-		// Normalize angle difference
-		while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-		while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-		
-		if (fabs(angleDiff) > REAR_UP_APPROACH_ANGLE)
-		{
-			return false;  // Not facing target head-on
-		}
-		
-		float currentTime = GetCurrentTime();
+		if (!RearUpEnabled) return 0;
 		
-		// ============================================
-		// CHECK GLOBAL COOLDOWN FIRST
-		// Prevents multiple horses from rearing up at the same time
-		// ============================================
-		if ((currentTime - g_lastGlobalRearUpTime) < REAR_UP_GLOBAL_COOLDOWN)
-		{
-			return false;  // Another horse reared up recently
-		}
+		// Block if rider is fleeing or in stand ground
+		if (in.riderFleeing || in.inStandGround) return 0;
 		
-		// Check per-horse cooldown (using config value)
-		HorseRearUpTracking* data = GetOrCreateRearUpTracking(horse->formID);
-		if (!data) return false;
+		// Civilians flee, not fight
+		if (in.combatClass == MountedCombatClass::CivilianFlee) return 0;
 		
-		if ((currentTime - data->lastRearUpTime) < RearUpCooldown)
-		{
-			return false;  // This horse on cooldown
-		}
+		// In melee range, close, and facing target head-on
+		if (in.distanceToTarget >= in.meleeRange) return 0;
+		if (in.distanceToTarget > REAR_UP_APPROACH_DISTANCE) return 0;
+		if (in.facingError > REAR_UP_APPROACH_ANGLE) return 0;
 		
-		// Roll chance (using config value)
-		EnsureRandomSeeded();
-		int roll = rand() % 100;
-		if (roll >= RearUpApproachChance)
-		{
-			return false;  // Didn't roll the chance
-		}
+		// This horse, or another horse in this encounter, reared up recently
+		if (IsManeuverCoolingDown(times, MANEUVER_REAR_UP, in.currentTime)) return 0;
 		
+		return RearUpApproachChance;
+	}
+	
+	static bool StartRearUpOnApproach(const ManeuverInputs& in)
+	{
 		// Trigger rear up using SingleMountedCombat's animation function
-		if (PlayHorseRearUpAnimation(horse))
-		{
-			data->lastRearUpTime = currentTime;
-			g_lastGlobalRearUpTime = currentTime;  // Set global cooldown
-			_MESSAGE("SpecialMovesets: Horse %08X REAR UP on approach (global cooldown: %.1fs)", 
-				horse->formID, REAR_UP_GLOBAL_COOLDOWN);
-			return true;
-		}
+		if (!PlayHorseRearUpAnimation(in.horse)) return false;
 		
-		return false;
+		// The cooldown runs from the rear up itself
+		MarkManeuverStarted(in.horse->formID, MANEUVER_REAR_UP, in.currentTime);
+		MarkManeuverCompleted(in.horse->formID, MANEUVER_REAR_UP, in.currentTime);
+		
+		_MESSAGE("SpecialMovesets: Horse %08X REAR UP on approach (encounter cooldown: %.1fs)", 
+			in.horse->formID, REAR_UP_GLOBAL_COOLDOWN);
+		return true;
 	}
 	
 	// ============================================
@@ -719,21 +857,15 @@ namespace MountedNPCCombatVR
 		float currentTime = GetCurrentTime();
 		
 		// ============================================
-		// CHECK GLOBAL COOLDOWN FIRST
-		// Prevents multiple horses from rearing up at the same time
+		// CHECK COOLDOWNS (shared with rear up on approach)
+		// Prevents multiple horses in the same battle from rearing up at the same time
 		// ============================================
-		if ((currentTime - g_lastGlobalRearUpTime) < REAR_UP_GLOBAL_COOLDOWN)
-		{
-			return false;  // Another horse reared up recently
-		}
-		
-		// Check per-horse cooldown (using config value)
-		HorseRearUpTracking* data = GetOrCreateRearUpTracking(horse->formID);
-		if (!data) return false;
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horse->formID);
+		if (!times) return false;
 		
-		if ((currentTime - data->lastRearUpTime) < RearUpCooldown)
+		if (IsManeuverCoolingDown(times, MANEUVER_REAR_UP, currentTime))
 		{
-			return false;  // This horse on cooldown
+			return false;  // This horse, or another horse in this encounter, reared up recently
 		}
 		
 		// Roll chance (using config value)
@@ -747,9 +879,9 @@ namespace MountedNPCCombatVR
 		// Trigger rear up
 		if (PlayHorseRearUpAnimation(horse))
 		{
-			data->lastRearUpTime = currentTime;
-			g_lastGlobalRearUpTime = currentTime;  // Set global cooldown
-			_MESSAGE("SpecialMovesets: Horse %08X REAR UP on damage (%.0f dmg, global cooldown: %.1fs)", 
+			MarkManeuverStarted(horse->formID, MANEUVER_REAR_UP, currentTime);  // Also starts the encounter cooldown
+			MarkManeuverCompleted(horse->formID, MANEUVER_REAR_UP, currentTime);
+			_MESSAGE("SpecialMovesets: Horse %08X REAR UP on damage (%.0f dmg, encounter cooldown: %.1fs)", 
 				horse->formID, damageAmount, REAR_UP_GLOBAL_COOLDOWN);
 			return true;
 		}
@@ -842,6 +974,7 @@ namespace MountedNPCCombatVR
 			data->clockwise = false;
 			data->wasInMeleeRange = false;
 			data->lastTurnDirectionChangeTime = -5.0f;  // Allow immediate first use
+			data->nextHazardCheckTime = 0.0f;
 			data->isValid = true;
 			g_horseTurnCount++;
 			return data;
@@ -861,10 +994,19 @@ namespace MountedNPCCombatVR
 			return (rand() % 2) == 0;
 		}
 		
-		// If we haven't chosen a direction yet (or we left melee range), pick one randomly
+		// If we haven't chosen a direction yet (or we left melee range), turn toward
+		// the horse's attack slot (random if it has none)
 		if (!data->wasInMeleeRange)
 		{
-			data->clockwise = (rand() % 2) == 0;
+			bool slotClockwise = false;
+			if (AttackSlots::GetSlotSideClockwise(horseFormID, slotClockwise))
+			{
+				data->clockwise = slotClockwise;
+			}
+			else
+			{
+				data->clockwise = (rand() % 2) == 0;
+			}
 			data->wasInMeleeRange = true;
 			
 			_MESSAGE("SpecialMovesets: Horse %08X chose %s turn direction for 90-degree maneuver", 
@@ -874,9 +1016,62 @@ namespace MountedNPCCombatVR
 		return data->clockwise;
 	}
 	
+	// ============================================
+	// HAZARD-AWARE TURN SIDE
+	// If the chosen 90-degree turn heads into a known hazard (hazard map)
+	// and the other side is clear, switch sides and keep the new side.
+	// Called every frame during turns, so the horse lookup, worldspace and
+	// probes are resolved at most once per TURN_HAZARD_CHECK_INTERVAL; in
+	// between, the kept side (data->clockwise) is the answer.
+	// ============================================
+	const float TURN_HAZARD_PROBE_DISTANCE = 300.0f;
+	const float TURN_HAZARD_CHECK_INTERVAL = 1.0f;
+	
+	static bool IsKnownHazardOnHeading(UInt32 worldSpaceFormID, const NiPoint3& pos, float heading)
+	{
+		float x = pos.x + sinf(heading) * TURN_HAZARD_PROBE_DISTANCE;
+		float y = pos.y + cosf(heading) * TURN_HAZARD_PROBE_DISTANCE;
+		return HazardMap::IsHazardAt(worldSpaceFormID, x, y, HazardMap::HAZARD_DROP) ||
+			HazardMap::IsHazardAt(worldSpaceFormID, x, y, HazardMap::HAZARD_STUCK);
+	}
+	
+	static bool AvoidKnownHazardTurn(UInt32 horseFormID, float angleToTarget, bool clockwise)
+	{
+		HorseTurnData* data = GetOrCreateTurnData(horseFormID);
+		if (!data) return clockwise;
+		
+		float now = GetCurrentTime();
+		if (now < data->nextHazardCheckTime) return clockwise;
+		data->nextHazardCheckTime = now + TURN_HAZARD_CHECK_INTERVAL;
+		
+		TESForm* form = CountedLookupFormByID(horseFormID);
+		if (!form || form->formType != kFormType_Character) return clockwise;
+		Actor* horse = static_cast<Actor*>(form);
+		
+		UInt32 worldSpaceFormID = GroundHeight::GetCellWorldSpaceID(horse->parentCell);
+		if (worldSpaceFormID == 0) return clockwise;
+		
+		const float NINETY_DEGREES = 1.5708f;
+		float chosenHeading = angleToTarget + (clockwise ? NINETY_DEGREES : -NINETY_DEGREES);
+		float otherHeading = angleToTarget + (clockwise ? -NINETY_DEGREES : NINETY_DEGREES);
+		
+		if (!IsKnownHazardOnHeading(worldSpaceFormID, horse->pos, chosenHeading) ||
+			IsKnownHazardOnHeading(worldSpaceFormID, horse->pos, otherHeading))
+		{
+			return clockwise;
+		}
+		
+		data->clockwise = !clockwise;
+		
+		_MESSAGE("SpecialMovesets: Horse %08X switched to %s turn - known hazard on the other side",
+			horseFormID, !clockwise ? "CLOCKWISE" : "COUNTER-CLOCKWISE");
+		return !clockwise;
+	}
+	
 	float Get90DegreeTurnAngle(UInt32 horseFormID, float angleToTarget)
 	{
 		bool clockwise = GetHorseTurnDirectionClockwise(horseFormID);
+		clockwise = AvoidKnownHazardTurn(horseFormID, angleToTarget, clockwise);
 		
 		// 90 degrees = PI/2 radians
 		const float NINETY_DEGREES = 1.5708f;
@@ -892,8 +1087,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Normalize to -PI to PI
-		while (targetAngle > 3.14159f) targetAngle -= 6.28318f;
-		while (targetAngle < -3.14159f) targetAngle += 6.28318f;
+		targetAngle = Steering::WrapAngle(targetAngle);
 		
 		return targetAngle;
 	}
@@ -935,8 +1129,7 @@ namespace MountedNPCCombatVR
 				}
 				
 				// Normalize
-				while (targetAngle > 3.14159f) targetAngle -= 6.28318f;
-				while (targetAngle < -3.14159f) targetAngle += 6.28318f;
+				targetAngle = Steering::WrapAngle(targetAngle);
 				
 				return targetAngle;
 			}
@@ -945,6 +1138,7 @@ namespace MountedNPCCombatVR
 		// Not on cooldown or not close enough - allow normal direction selection
 		// This will trigger a new direction if wasInMeleeRange was reset
 		bool clockwise = GetHorseTurnDirectionClockwise(horseFormID);
+		clockwise = AvoidKnownHazardTurn(horseFormID, angleToTarget, clockwise);
 		
 		// Update the timestamp when direction is chosen
 		if (data->wasInMeleeRange && distanceToTarget <= MOUNTED_VS_MOUNTED_CLOSE_RANGE)
@@ -964,8 +1158,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Normalize
-		while (targetAngle > 3.14159f) targetAngle -= 6.28318f;
-		while (targetAngle < -3.14159f) targetAngle += 6.28318f;
+		targetAngle = Steering::WrapAngle(targetAngle);
 		
 		return targetAngle;
 	}
@@ -1054,6 +1247,13 @@ namespace MountedNPCCombatVR
 		
 		if (target->IsDead(1)) return false;
 		
+		// Shared per-target answer (computed once per tick for all chasers)
+		const Pursuit::PursuitField* pursuit = Pursuit::GetPursuitField(target);
+		if (pursuit)
+		{
+			return pursuit->isMobileNPC;
+		}
+		
 		// ============================================
 		// CRITICAL: Skip mobile interception if target is MOUNTED
 		// When two mounted units fight each other, they should NOT use
@@ -1074,21 +1274,40 @@ namespace MountedNPCCombatVR
 	{
 		if (!horse || !target)
 		{
-			return horse ? horse->rot.z : 0;
+			return horse ? Steering::GetHeading(horse) : 0;
 		}
 		
 		MobileInterceptData* data = GetOrCreateMobileInterceptData(horseFormID);
 		
-		float dx = target->pos.x - horse->pos.x;
-		float dy = target->pos.y - horse->pos.y;
+		// Aim at where a moving target will be, not where it is
+		float aimX = target->pos.x;
+		float aimY = target->pos.y;
+		const Pursuit::PursuitField* pursuit = Pursuit::GetPursuitField(target);
+		if (pursuit && pursuit->isMoving)
+		{
+			aimX = pursuit->predicted.x;
+			aimY = pursuit->predicted.y;
+		}
+		
+		float dx = aimX - horse->pos.x;
+		float dy = aimY - horse->pos.y;
 		float angleToTarget = atan2(dx, dy);
 		
 		if (!data || !data->sideChosen || data->targetFormID != target->formID)
 		{
 			if (data)
 			{
-				EnsureRandomSeeded();
-				data->approachFromRight = (rand() % 2) == 0;
+				// Approach from the side the horse's attack slot is on (random if none)
+				bool slotClockwise = false;
+				if (AttackSlots::GetSlotSideClockwise(horseFormID, slotClockwise))
+				{
+					data->approachFromRight = slotClockwise;
+				}
+				else
+				{
+					EnsureRandomSeeded();
+					data->approachFromRight = (rand() % 2) == 0;
+				}
 				data->sideChosen = true;
 				data->targetFormID = target->formID;
 				
@@ -1119,8 +1338,7 @@ namespace MountedNPCCombatVR
 			interceptAngle -= INTERCEPT_ANGLE_OFFSET;
 		}
 		
-		while (interceptAngle > 3.14159f) interceptAngle -= 6.28318f;
-		while (interceptAngle < -3.14159f) interceptAngle += 6.28318f;
+		interceptAngle = Steering::WrapAngle(interceptAngle);
 		
 		return interceptAngle;
 	}
@@ -1180,9 +1398,8 @@ namespace MountedNPCCombatVR
 			data->horseFormID = horseFormID;
 			data->riderFormID = 0;
 			data->state = ChargeState::None;
-			data->lastChargeCheckTime = -CHARGE_CHECK_INTERVAL;   // Allow immediate first check
-			data->lastChargeCompleteTime = -ChargeCooldown;   // Allow immediate first charge
 			data->stateStartTime = 0;
+			ManeuverScript::ResetScript(data->script);
 			data->isValid = true;
 			g_horseChargeCount++;
 			return data;
@@ -1204,91 +1421,134 @@ namespace MountedNPCCombatVR
 		return false;
 	}
 	
-	bool TryChargeManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget)
+	// Chance to start (0 = not eligible)
+	static int ScoreCharge(const ManeuverInputs& in, const HorseManeuverTimes* times)
 	{
-		if (!horse || !rider || !target) return false;
-		
-		// Check if charge is enabled
-		if (!ChargeEnabled) return false;
-		
-		// Block if rider is fleeing
-		if (IsHorseRiderFleeing(horse->formID)) return false;
+		if (!ChargeEnabled || !in.rider) return 0;
 		
-		// Block if in stand ground
-		if (IsInStandGround(horse->formID)) return false;
+		// Block if fleeing, in stand ground, or already charging
+		if (in.riderFleeing || in.inStandGround || in.charging) return 0;
 		
 		// ============================================
 		// EXCLUDE MAGE CASTERS AND CIVILIANS
 		// Mages don't charge into melee, civilians flee
 		// ============================================
-		MountedCombatClass combatClass = DetermineCombatClass(rider);
-		if (combatClass == MountedCombatClass::MageCaster || combatClass == MountedCombatClass::CivilianFlee)
+		if (in.combatClass == MountedCombatClass::MageCaster || in.combatClass == MountedCombatClass::CivilianFlee)
 		{
-			return false;
+			return 0;
 		}
 		
-		// ============================================
-		// MAXIMUM DISTANCE CHECK - Don't trigger if target too far
-		// ============================================
-		if (distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE)
-		{
-			return false;
-		}
+		// Don't trigger if target too far; must be in charge range (config
+		// values, inside the fixed 700-1500 band the charge has always
+		// been limited to)
+		if (in.distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE) return 0;
+		if (in.distanceToTarget < CHARGE_BAND_MIN_DISTANCE || in.distanceToTarget > CHARGE_BAND_MAX_DISTANCE) return 0;
+		if (in.distanceToTarget < ChargeMinDistance || in.distanceToTarget > ChargeMaxDistance) return 0;
 		
-		// Check if distance is in charge range (using config values)
-		if (distanceToTarget < ChargeMinDistance || distanceToTarget > ChargeMaxDistance)
-		{
-			return false;
-		}
+		if (!IsManeuverCheckDue(times, MANEUVER_CHARGE, in.currentTime)) return 0;
+		if (IsManeuverCoolingDown(times, MANEUVER_CHARGE, in.currentTime)) return 0;
 		
-		HorseChargeData* data = GetOrCreateChargeData(horse->formID);
+		return ChargeChancePercent;
+	}
+	
+	static bool StartCharge(const ManeuverInputs& in)
+	{
+		HorseChargeData* data = GetOrCreateChargeData(in.horse->formID);
 		if (!data) return false;
 		
-		// Already charging?
-		if (data->state != ChargeState::None && data->state != ChargeState::Completed)
+		// INITIATE CHARGE!
+		_MESSAGE("SpecialMovesets: Horse %08X INITIATING CHARGE! (distance: %.0f)", 
+			in.horse->formID, in.distanceToTarget);
+
+		// Step 1: Play rear up animation (RunChargeScript takes it from here)
+		if (PlayHorseRearUpAnimation(in.horse))
 		{
-			return false;  // Already in a charge
+			data->riderFormID = in.rider->formID;
+			data->state = ChargeState::RearingUp;
+			data->stateStartTime = in.currentTime;
+			ManeuverScript::StartScript(data->script, in.currentTime);
+			MarkManeuverStarted(in.horse->formID, MANEUVER_CHARGE, in.currentTime);
+			
+			_MESSAGE("SpecialMovesets: Horse %08X rearing up for charge", in.horse->formID);
+			return true;
 		}
 		
-		float currentTime = GetCurrentTime();
+		return false;
+	}
+	
+	// Charge sequence: rear up, swap the bow for melee, sprint at the
+	// target until in close melee range (or timeout), then settle.
+	// Started by StartCharge once the rear up animation is playing.
+	static bool RunChargeScript(HorseChargeData* data, Actor* horse, Actor* rider, float distanceToTarget, float now)
+	{
+		SCRIPT_BEGIN(data->script);
+		
+		// Wait for rear up animation to finish
+		data->state = ChargeState::RearingUp;
+		data->stateStartTime = now;
+		SCRIPT_WAIT_SECONDS(data->script, now, CHARGE_REAR_UP_DURATION);
 		
-		// Check cooldown for last charge (using config value)
-		if ((currentTime - data->lastChargeCompleteTime) < ChargeCooldown)
+		// Before charging, sheathe bow if equipped and equip melee
+		if (rider && IsBowEquipped(rider))
 		{
-			return false;  // Still on cooldown from last charge
+			SheatheCurrentWeapon(rider);
+			_MESSAGE("SpecialMovesets: Rider %08X sheathing bow for charge", rider->formID);
 		}
 		
-		// Check 10-second interval
-		if ((currentTime - data->lastChargeCheckTime) < CHARGE_CHECK_INTERVAL)
+		// Wait briefly for sheathe animation, then equip melee
+		data->state = ChargeState::EquippingWeapon;
+		data->stateStartTime = now;
+		SCRIPT_WAIT_SECONDS(data->script, now, CHARGE_EQUIP_DURATION);
+		
+		if (rider)
 		{
-			return false;  // Not time to check yet
+			ResetBowAttackState(rider->formID);
+			EquipBestMeleeWeapon(rider);
+			rider->DrawSheatheWeapon(true);  // Draw the melee weapon
+			_MESSAGE("SpecialMovesets: Rider %08X equipped melee for charge", rider->formID);
 		}
-		data->lastChargeCheckTime = currentTime;
 		
-		// Roll chance (using config value)
-		EnsureRandomSeeded();
-		int roll = rand() % 100;
-		if (roll >= ChargeChancePercent)
+		data->state = ChargeState::Charging;
+		data->stateStartTime = now;
+		StartHorseSprint(horse);
+		_MESSAGE("SpecialMovesets: Horse %08X CHARGING toward target!", horse->formID);
+		
+		// During charge, use closer melee range (110 units instead of default ~195)
+		// This makes the horse charge right up to the player
+		// FAILSAFE: sprint times out after CHARGE_SPRINT_TIMEOUT
+		SCRIPT_WAIT_UNTIL(data->script, now, distanceToTarget <= CHARGE_MELEE_RANGE, CHARGE_SPRINT_TIMEOUT);
+		
+		StopHorseSprint(horse);
+		data->state = ChargeState::Completed;
+		data->stateStartTime = now;
+		MarkManeuverCompleted(horse->formID, MANEUVER_CHARGE, now);
+		
+		if (data->script.timedOut)
 		{
-			return false;  // Didn't roll the chance
+			_MESSAGE("SpecialMovesets: Horse %08X charge TIMEOUT (dist: %.0f)", horse->formID, distanceToTarget);
+		}
+		else
+		{
+			_MESSAGE("SpecialMovesets: Horse %08X charge COMPLETE - reached target (dist: %.0f, threshold: %.0f)", 
+				horse->formID, distanceToTarget, CHARGE_MELEE_RANGE);
 		}
 		
-		// INITIATE CHARGE!
-		_MESSAGE("SpecialMovesets: Horse %08X INITIATING CHARGE! (distance: %.0f, roll: %d < %d%%)", 
-			horse->formID, distanceToTarget, roll, ChargeChancePercent);
-
-		// Step 1: Play rear up animation
-		if (PlayHorseRearUpAnimation(horse))
+		SCRIPT_WAIT_SECONDS(data->script, now, 1.0f);
+		
+		data->state = ChargeState::None;
+		MarkManeuverChecked(horse->formID, MANEUVER_CHARGE, now);
+		
+		// ============================================
+		// RESET WEAPON SWITCHING STATE
+		// Allow normal distance-based switching to resume
+		// ============================================
+		if (rider)
 		{
-			data->riderFormID = rider->formID;
-			data->state = ChargeState::RearingUp;
-			data->stateStartTime = currentTime;
-			
-			_MESSAGE("SpecialMovesets: Horse %08X rearing up for charge", horse->formID);
-			return true;
+			ClearWeaponSwitchData(rider->formID);
+			_MESSAGE("SpecialMovesets: Charge complete - cleared weapon switch data for rider %08X", rider->formID);
 		}
 		
-		return false;
+		SCRIPT_END(data->script);
 	}
 	
 	bool UpdateChargeManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange)
@@ -1299,140 +1559,33 @@ namespace MountedNPCCombatVR
 		if (!data) return false;
 		
 		// Not charging
-		if (data->state == ChargeState::None || data->state == ChargeState::Completed)
+		if (!ManeuverScript::IsScriptRunning(data->script))
 		{
 			return false;
 		}
 		
+		// Sleeping scripts (rear up, equip, settle) are not entered
 		float currentTime = GetCurrentTime();
-		float timeInState = currentTime - data->stateStartTime;
+		if (ManeuverScript::IsScriptDue(data->script, currentTime))
+		{
+			RunChargeScript(data, horse, rider, distanceToTarget, currentTime);
+		}
 		
-		switch (data->state)
+		// Still in charge maneuver until the sprint ends
+		return data->state != ChargeState::None && data->state != ChargeState::Completed;
+	}
+	
+	void StopChargeManeuver(UInt32 horseFormID)
+	{
+		for (int i = 0; i < g_horseChargeCount; i++)
 		{
-			case ChargeState::RearingUp:
+			if (g_horseChargeData[i].isValid && g_horseChargeData[i].horseFormID == horseFormID)
 			{
-				// Wait for rear up animation to finish
-				if (timeInState >= CHARGE_REAR_UP_DURATION)
+				// Stop the sprint if we were charging
+				if (g_horseChargeData[i].state == ChargeState::Charging)
 				{
-					// Before charging, sheathe bow if equipped and equip melee
-					if (rider && IsBowEquipped(rider))
-					{
-						// Sheathe the bow first
-						SheatheCurrentWeapon(rider);
-						_MESSAGE("SpecialMovesets: Rider %08X sheathing bow for charge", rider->formID);
-					}
-					
-					// Transition to equipping weapon
-					data->state = ChargeState::EquippingWeapon;
-					data->stateStartTime = currentTime;
-				}
-				return true;  // Still in charge maneuver
-			}
-			
-			case ChargeState::EquippingWeapon:
-			{
-				// Wait briefly for sheathe animation, then equip melee
-				if (timeInState >= CHARGE_EQUIP_DURATION)
-				{
-					// Now equip melee weapon
-					if (rider)
-					{
-						ResetBowAttackState(rider->formID);
-						EquipBestMeleeWeapon(rider);
-						rider->DrawSheatheWeapon(true);  // Draw the melee weapon
-						_MESSAGE("SpecialMovesets: Rider %08X equipped melee for charge", rider->formID);
-					}
-					
-					// Transition to charging
-					data->state = ChargeState::Charging;
-					data->stateStartTime = currentTime;
-					
-					_MESSAGE("SpecialMovesets: Transitioning to ChargeState::Charging for horse %08X", horse->formID);
-					
-					if (horse)
-					{
-						_MESSAGE("SpecialMovesets: About to call StartHorseSprint for horse %08X", horse->formID);
-						StartHorseSprint(horse);
-						_MESSAGE("SpecialMovesets: Horse %08X CHARGING toward target!", horse->formID);
-					}
-					else
-					{
-						_MESSAGE("SpecialMovesets: ERROR - horse is null when trying to start sprint!");
-					}
-				}
-				return true;  // Still in charge maneuver
-			}
-			
-			case ChargeState::Charging:
-			{
-				// During charge, use closer melee range (110 units instead of default ~195)
-				// This makes the horse charge right up to the player
-				const float chargeStopDistance = CHARGE_MELEE_RANGE;
-				
-				// Check if we've reached the closer charge melee range
-				if (distanceToTarget <= chargeStopDistance)
-				{
-					StopHorseSprint(horse);
-					data->state = ChargeState::Completed;
-					data->stateStartTime = currentTime;
-					data->lastChargeCompleteTime = currentTime;
-					
-					_MESSAGE("SpecialMovesets: Horse %08X charge COMPLETE - reached target (dist: %.0f, threshold: %.0f)", 
-						horse->formID, distanceToTarget, chargeStopDistance);
-					return false;
-				}
-				
-				// FAILSAFE: Check for sprint timeout (5 seconds max)
-				if (timeInState >= CHARGE_SPRINT_TIMEOUT)
-				{
-					StopHorseSprint(horse);
-					data->state = ChargeState::Completed;
-					data->stateStartTime = currentTime;
-					data->lastChargeCompleteTime = currentTime;
-					
-					_MESSAGE("SpecialMovesets: Horse %08X charge TIMEOUT (dist: %.0f)", horse->formID, distanceToTarget);
-					return false;
-				 }
-				
-				return true;  // Still charging
-			}
-			
-			case ChargeState::Completed:
-			{
-				if (timeInState >= 1.0f)
-				{
-					data->state = ChargeState::None;
-					data->lastChargeCheckTime = currentTime;
-					
-					// ============================================
-					// RESET WEAPON SWITCHING STATE
-					// Allow normal distance-based switching to resume
-					// ============================================
-					if (rider)
-					{
-						ClearWeaponSwitchData(rider->formID);
-						_MESSAGE("SpecialMovesets: Charge complete - cleared weapon switch data for rider %08X", rider->formID);
-					}
-				}
-				return false;
-			}
-			
-			default:
-				return false;
-		}
-	}
-	
-	void StopChargeManeuver(UInt32 horseFormID)
-	{
-		for (int i = 0; i < g_horseChargeCount; i++)
-		{
-			if (g_horseChargeData[i].isValid && g_horseChargeData[i].horseFormID == horseFormID)
-			{
-				// Stop the sprint if we were charging
-				if (g_horseChargeData[i].state == ChargeState::Charging)
-				{
-					TESForm* horseForm = LookupFormByID(horseFormID);
-					if (horseForm)
+					TESForm* horseForm = CountedLookupFormByID(horseFormID);
+					if (horseForm)
 					{
 						Actor* horse = DYNAMIC_CAST(horseForm, TESForm, Actor);
 						if (horse)
@@ -1443,6 +1596,7 @@ namespace MountedNPCCombatVR
 				}
 				
 				g_horseChargeData[i].state = ChargeState::None;
+				ManeuverScript::StopScript(g_horseChargeData[i].script);
 				_MESSAGE("SpecialMovesets: Stopped charge maneuver for horse %08X", horseFormID);
 				return;
 			}
@@ -1458,7 +1612,7 @@ namespace MountedNPCCombatVR
 				// Stop any active charge first
 				if (g_horseChargeData[i].state == ChargeState::Charging)
 				{
-					TESForm* horseForm = LookupFormByID(horseFormID);
+					TESForm* horseForm = CountedLookupFormByID(horseFormID);
 					if (horseForm)
 					{
 						Actor* horse = DYNAMIC_CAST(horseForm, TESForm, Actor);
@@ -1503,9 +1657,8 @@ namespace MountedNPCCombatVR
 			data->horseFormID = horseFormID;
 			data->riderFormID = 0;
 			data->state = RapidFireState::None;
-			data->lastCheckTime = -RAPID_FIRE_CHECK_INTERVAL;  // Allow immediate first check
-			data->lastCompleteTime = -RapidFireCooldown;     // Allow immediate first rapid fire
 			data->stateStartTime = 0;
+			ManeuverScript::ResetScript(data->script);
 			data->isValid = true;
 			g_horseRapidFireCount++;
 			return data;
@@ -1527,48 +1680,26 @@ namespace MountedNPCCombatVR
 		return false;
 	}
 	
-	bool TryRapidFireManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange)
+	// Chance to start (0 = not eligible)
+	static int ScoreRapidFire(const ManeuverInputs& in, const HorseManeuverTimes* times)
 	{
-		if (!horse || !rider || !target) return false;
-		
-		// Check if rapid fire is enabled
-		if (!RapidFireEnabled) return false;
+		if (!RapidFireEnabled || !in.rider) return 0;
 		
-		// Block if rider is fleeing
-		if (IsHorseRiderFleeing(horse->formID)) return false;
+		// Block if fleeing, in stand ground, or already in rapid fire
+		if (in.riderFleeing || in.inStandGround || in.inRapidFire) return 0;
 		
-		// Block if in stand ground
-		if (IsInStandGround(horse->formID)) return false;
-		
-		// ============================================
-		// EXCLUDE CIVILIANS - They flee, not fight
-		// ============================================
-		MountedCombatClass combatClass = DetermineCombatClass(rider);
-		if (combatClass == MountedCombatClass::CivilianFlee)
-		{
-			return false;
-		}
-		
-		// Check if rider is a mage
-		bool isMage = (combatClass == MountedCombatClass::MageCaster);
+		// Civilians flee, not fight
+		if (in.combatClass == MountedCombatClass::CivilianFlee) return 0;
 		
 		// ============================================
 		// MUST HAVE BOW ALREADY EQUIPPED (or be a mage)
 		// Don't force equip - rely on dynamic weapon switching
 		// Mages don't need bows - they cast Ice Spike instead
 		// ============================================
-		if (!isMage && !IsBowEquipped(rider))
-		{
-			return false;  // No bow equipped - can't do rapid fire
-		}
-
-		// ============================================
-		// MAXIMUM DISTANCE CHECK - Don't trigger if target too far
-		// ============================================
-		if (distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE)
-		{
-			return false;
-		}
+		if (in.combatClass != MountedCombatClass::MageCaster && !in.bowEquipped) return 0;
+		
+		// Out of melee range, and 20+ seconds into combat
+		if (in.distanceToTarget <= in.meleeRange || in.combatElapsed < 20.0f) return 0;
 		
 		// ============================================
 		// DISTANCE CHECK FOR RAPID FIRE
@@ -1579,71 +1710,36 @@ namespace MountedNPCCombatVR
 		const float RAPID_FIRE_MIN_DISTANCE = 400.0f;
 		const float RAPID_FIRE_MAX_DISTANCE = 1500.0f;
 		
-		if (distanceToTarget < RAPID_FIRE_MIN_DISTANCE)
-		{
-			return false;  // Too close - melee combat instead
-		}
+		if (in.distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE) return 0;
+		if (in.distanceToTarget < RAPID_FIRE_MIN_DISTANCE || in.distanceToTarget > RAPID_FIRE_MAX_DISTANCE) return 0;
 		
-		if (distanceToTarget > RAPID_FIRE_MAX_DISTANCE)
-		{
-			return false;  // Too far - should charge instead
-		}
+		if (!IsManeuverCheckDue(times, MANEUVER_RAPID_FIRE, in.currentTime)) return 0;
 		
-		// Must be 20+ seconds into combat
-		float combatTime = GetCurrentTime();  // TODO: Get actual combat start time
-		// For now we'll check this in DynamicPackages where we have combat start time
+		// This horse's cooldown, or another horse in this encounter rapid fired recently
+		if (IsManeuverCoolingDown(times, MANEUVER_RAPID_FIRE, in.currentTime)) return 0;
 		
-		HorseRapidFireData* data = GetOrCreateRapidFireData(horse->formID);
+		return RapidFireChancePercent;
+	}
+	
+	static bool StartRapidFire(const ManeuverInputs& in)
+	{
+		HorseRapidFireData* data = GetOrCreateRapidFireData(in.horse->formID);
 		if (!data) return false;
 		
-		// Already in rapid fire?
-		if (data->state == RapidFireState::Active)
-		{
-			return false;
-		}
-		
-		float currentTime = GetCurrentTime();
-		
-		// ============================================
-		// GLOBAL COOLDOWN CHECK - Prevent synchronized rapid fires
-		// No horse can rapid fire if ANY horse rapid fired recently
-		// ============================================
-		if ((currentTime - g_lastGlobalRapidFireTime) < RAPID_FIRE_GLOBAL_COOLDOWN)
-		{
-			return false;  // Another horse rapid fired recently - blocked
-		}
-		
-		// Check cooldown since last rapid fire for THIS horse (using config value)
-		if ((currentTime - data->lastCompleteTime) < RapidFireCooldown)
-		{
-			return false;  // This horse still on cooldown
-		}
-		
-		// Check 10-second interval between checks
-		if ((currentTime - data->lastCheckTime) < RAPID_FIRE_CHECK_INTERVAL)
-		{
-			return false;  // Not time to check yet
-		}
-		data->lastCheckTime = currentTime;
-		
-		// Roll chance (using config value)
-		EnsureRandomSeeded();
-		int roll = rand() % 100;
-		if (roll >= RapidFireChancePercent)
-		{
-			return false;  // Didn't roll the chance
-		}
+		Actor* horse = in.horse;
+		Actor* rider = in.rider;
+		bool isMage = (in.combatClass == MountedCombatClass::MageCaster);
 		
-		// SUCCESS - Initiate rapid fire!
-		_MESSAGE("SpecialMovesets: Horse %08X RAPID FIRE INITIATED! (rolled %d < %d%%) - Horse will STOP for %.1f seconds (global cooldown: %.1fs)",
-			horse->formID, roll, RapidFireChancePercent, RapidFireDuration, RAPID_FIRE_GLOBAL_COOLDOWN);
+		_MESSAGE("SpecialMovesets: Horse %08X RAPID FIRE INITIATED! - Horse will STOP for %.1f seconds (encounter cooldown: %.1fs)",
+			horse->formID, RapidFireDuration, RAPID_FIRE_GLOBAL_COOLDOWN);
 		
-		// Set global cooldown
-		g_lastGlobalRapidFireTime = currentTime;
+		// Start encounter cooldown
+		MarkManeuverStarted(horse->formID, MANEUVER_RAPID_FIRE, in.currentTime);
 		
 		data->riderFormID = rider->formID;
 		data->state = RapidFireState::Active;
-		data->stateStartTime = currentTime;
+		data->stateStartTime = in.currentTime;
+		ManeuverScript::StartScript(data->script, in.currentTime);
 		
 		// ============================================
 		// STOP THE HORSE MOVEMENT
@@ -1653,6 +1749,7 @@ namespace MountedNPCCombatVR
 		StopHorseSprint(horse);
 		
 		// Force AI re-evaluation to stop movement
+		PERF_COUNT(EvaluatePackageCalls);
 		Actor_EvaluatePackage(horse, false, false);
 		
 		// ============================================
@@ -1690,62 +1787,13 @@ namespace MountedNPCCombatVR
 		return true;
 	}
 	
-	bool UpdateRapidFireManeuver(Actor* horse, Actor* rider, Actor* target)
+	// One tick of the active phase: keep the horse stopped and update the
+	// bow attack. Returns false once the phase is over (target escaped,
+	// duration up or all shots fired), after switching to Completed.
+	static bool RapidFireActiveTick(HorseRapidFireData* data, Actor* horse, Actor* rider, Actor* target, float currentTime)
 	{
-		if (!horse) return false;
-		
-		HorseRapidFireData* data = GetOrCreateRapidFireData(horse->formID);
-		if (!data) return false;
-		
-		// Not in rapid fire (None or already fully reset)
-		if (data->state == RapidFireState::None)
-		{
-			return false;
-		}
-		
-		float currentTime = GetCurrentTime();
 		float timeInState = currentTime - data->stateStartTime;
 		
-		// ============================================
-		// COMPLETED STATE - Reset after short delay
-		// ============================================
-		if (data->state == RapidFireState::Completed)
-		{
-			// Reset state after a short delay (1 second)
-			if (timeInState >= 1.0f)
-			{
-				// FULL RESET of all rapid fire state
-				data->state = RapidFireState::None;
-				data->riderFormID = 0;
-				data->stateStartTime = 0;
-				// lastCheckTime stays as-is so the 10-second interval works
-				// lastCompleteTime stays as-is for the 45-second cooldown
-				
-				// Reset the rapid fire bow attack state for future use
-				if (rider)
-				{
-					// Final cleanup - ensure bow attack state is fully reset
-					ResetRapidFireBowAttack(rider->formID);
-					ResetBowAttackState(rider->formID);
-					
-					// ============================================
-					// RESET WEAPON SWITCHING STATE
-					// Allow normal distance-based switching to resume
-					// ============================================
-					ClearWeaponSwitchData(rider->formID);
-					_MESSAGE("SpecialMovesets: Rapid fire complete - cleared weapon switch data for rider %08X", rider->formID);
-				}
-				
-				_MESSAGE("SpecialMovesets: Horse %08X rapid fire state fully RESET - ready for next use after %.0f sec cooldown", 
-					horse->formID, RapidFireCooldown);
-			}
-			return false;
-		}
-		
-		// ============================================
-		// ACTIVE STATE - Horse stationary, firing arrows
-		// ============================================
-		
 		// EVERY FRAME: Ensure horse stays stopped
 		StopHorseSprint(horse);
 		
@@ -1784,7 +1832,7 @@ namespace MountedNPCCombatVR
 			// Rapid fire complete - transition to Completed state
 			data->state = RapidFireState::Completed;
 			data->stateStartTime = currentTime;
-			data->lastCompleteTime = currentTime;  // Start cooldown
+			MarkManeuverCompleted(horse->formID, MANEUVER_RAPID_FIRE, currentTime);  // Start cooldown
 			
 			_MESSAGE("SpecialMovesets: Horse %08X rapid fire complete after %.1f sec. Cooldown: %.0f sec", 
 				horse->formID, timeInState, RapidFireCooldown);
@@ -1825,7 +1873,71 @@ namespace MountedNPCCombatVR
 				rider, target);
 		}
 		
-		return true;  // Still in rapid fire
+		return true;
+	}
+	
+	// Rapid fire sequence: hold still and fire until done, then reset
+	// after a short delay. Started by StartRapidFire.
+	static bool RunRapidFireScript(HorseRapidFireData* data, Actor* horse, Actor* rider, Actor* target, float now)
+	{
+		SCRIPT_BEGIN(data->script);
+		
+		// ACTIVE - Horse stationary, firing arrows (every tick)
+		while (RapidFireActiveTick(data, horse, rider, target, now))
+		{
+			SCRIPT_YIELD(data->script);
+		}
+		
+		// COMPLETED - Reset after a short delay (1 second)
+		SCRIPT_WAIT_SECONDS(data->script, now, 1.0f);
+		
+		// FULL RESET of all rapid fire state
+		data->state = RapidFireState::None;
+		data->riderFormID = 0;
+		data->stateStartTime = 0;
+		// The check interval and cooldown keep running in the rate limiter
+		
+		// Reset the rapid fire bow attack state for future use
+		if (rider)
+		{
+			// Final cleanup - ensure bow attack state is fully reset
+			ResetRapidFireBowAttack(rider->formID);
+			ResetBowAttackState(rider->formID);
+			
+			// ============================================
+			// RESET WEAPON SWITCHING STATE
+			// Allow normal distance-based switching to resume
+			// ============================================
+			ClearWeaponSwitchData(rider->formID);
+			_MESSAGE("SpecialMovesets: Rapid fire complete - cleared weapon switch data for rider %08X", rider->formID);
+		}
+		
+		_MESSAGE("SpecialMovesets: Horse %08X rapid fire state fully RESET - ready for next use after %.0f sec cooldown", 
+			horse->formID, RapidFireCooldown);
+		
+		SCRIPT_END(data->script);
+	}
+	
+	bool UpdateRapidFireManeuver(Actor* horse, Actor* rider, Actor* target)
+	{
+		if (!horse) return false;
+		
+		HorseRapidFireData* data = GetOrCreateRapidFireData(horse->formID);
+		if (!data) return false;
+		
+		// Not in rapid fire (None or already fully reset)
+		if (!ManeuverScript::IsScriptRunning(data->script))
+		{
+			return false;
+		}
+		
+		float currentTime = GetCurrentTime();
+		if (ManeuverScript::IsScriptDue(data->script, currentTime))
+		{
+			RunRapidFireScript(data, horse, rider, target, currentTime);
+		}
+		
+		return data->state == RapidFireState::Active;  // Still in rapid fire
 	}
 	
 	void StopRapidFireManeuver(UInt32 horseFormID)
@@ -1836,7 +1948,8 @@ namespace MountedNPCCombatVR
 			{
 				float currentTime = GetCurrentTime();
 				g_horseRapidFireData[i].state = RapidFireState::None;
-				g_horseRapidFireData[i].lastCompleteTime = currentTime;
+				MarkManeuverCompleted(horseFormID, MANEUVER_RAPID_FIRE, currentTime);
+				ManeuverScript::StopScript(g_horseRapidFireData[i].script);
 				_MESSAGE("SpecialMovesets: Stopped rapid fire for horse %08X", horseFormID);
 				return;
 			}
@@ -1888,8 +2001,6 @@ namespace MountedNPCCombatVR
 			HorseStandGroundData* data = &g_horseStandGroundData[g_horseStandGroundCount];
 			data->horseFormID = horseFormID;
 			data->state = StandGroundState::None;
-			data->lastCheckTime = -StandGroundCheckInterval;
-			data->lastCompleteTime = -StandGroundCooldown;
 			data->stateStartTime = 0;
 			data->standDuration = 0;
 			data->lockedAngle = 0;
@@ -1897,6 +2008,7 @@ namespace MountedNPCCombatVR
 			data->noRotation = false;
 			data->rotationLocked = false;
 			data->target90DegreeAngleSet = false;
+			ManeuverScript::ResetScript(data->script);
 			data->isValid = true;
 			g_horseStandGroundCount++;
 			return data;
@@ -2000,79 +2112,42 @@ namespace MountedNPCCombatVR
 		return Get90DegreeTurnAngle(horseFormID, angleToTarget);
 	}
 	
-	bool TryStandGroundManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget)
+	// Chance to start (0 = not eligible)
+	static int ScoreStandGround(const ManeuverInputs& in, const HorseManeuverTimes* times)
 	{
-		if (!horse || !rider || !target) return false;
-		
-		// Check if enabled in config
-		if (!StandGroundEnabled) return false;
+		if (!StandGroundEnabled || !in.rider) return 0;
 		
-		// Block if rider is fleeing
-		if (IsHorseRiderFleeing(horse->formID)) return false;
+		// Block if fleeing or already standing ground
+		if (in.riderFleeing || in.inStandGround) return 0;
 		
 		// Only trigger when fighting a NON-PLAYER target
-		if (g_thePlayer && (*g_thePlayer) && target == (*g_thePlayer))
-		{
-			return false;
-		}
+		if (in.targetIsPlayer) return 0;
 		
 		// ============================================
 		// EXCLUDE MAGE CASTERS AND CIVILIANS
 		// Mages use their own stationary behavior, civilians flee
 		// ============================================
-		MountedCombatClass combatClass = DetermineCombatClass(rider);
-		if (combatClass == MountedCombatClass::MageCaster || combatClass == MountedCombatClass::CivilianFlee)
+		if (in.combatClass == MountedCombatClass::MageCaster || in.combatClass == MountedCombatClass::CivilianFlee)
 		{
-			return false;
+			return 0;
 		}
 		
-		// ============================================
-		// MAXIMUM DISTANCE CHECK - Don't trigger if target too far
-		// ============================================
-		if (distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE)
-		{
-			return false;
-		}
+		// In melee range and within stand ground range
+		if (in.distanceToTarget >= in.meleeRange) return 0;
+		if (in.distanceToTarget > SPECIAL_MOVESET_MAX_DISTANCE) return 0;
+		if (in.distanceToTarget > StandGroundMaxDistance) return 0;
 		
-		// Must be within stand ground range
-		if (distanceToTarget > StandGroundMaxDistance)
-		{
-			return false;
-		}
+		if (!IsManeuverCheckDue(times, MANEUVER_STAND_GROUND, in.currentTime)) return 0;
+		if (IsManeuverCoolingDown(times, MANEUVER_STAND_GROUND, in.currentTime)) return 0;
 		
-		HorseStandGroundData* data = GetOrCreateStandGroundData(horse->formID);
+		return StandGroundChancePercent;
+	}
+	
+	static bool StartStandGround(const ManeuverInputs& in)
+	{
+		HorseStandGroundData* data = GetOrCreateStandGroundData(in.horse->formID);
 		if (!data) return false;
 		
-		// Already standing ground?
-		if (data->state == StandGroundState::Active)
-		{
-			return false;
-		}
-		
-		float currentTime = GetCurrentTime();
-		
-		// Check cooldown since last stand ground
-		if ((currentTime - data->lastCompleteTime) < StandGroundCooldown)
-		{
-			return false;
-		}
-		
-		// Check interval between checks
-		if ((currentTime - data->lastCheckTime) < StandGroundCheckInterval)
-		{
-			return false;  // Not time to check yet
-		}
-		data->lastCheckTime = currentTime;
-		
-		// Roll chance
-		EnsureRandomSeeded();
-		int roll = rand() % 100;
-		if (roll >= StandGroundChancePercent)
-		{
-			return false;
-		}
-		
-		// SUCCESS - Initiate stand ground!
 		// Calculate random duration between min-max seconds
 		float durationRange = StandGroundMaxDuration - StandGroundMinDuration;
 		data->standDuration = StandGroundMinDuration + (((float)(rand() % 100)) / 100.0f * durationRange);
@@ -2084,7 +2159,7 @@ namespace MountedNPCCombatVR
 		if (!data->noRotation)
 		{
 			// always use horse->formID here
-			data->target90DegreeAngle = Get90DegreeTurnAngle(horse->formID, GetAngleToTarget(horse, target));
+			data->target90DegreeAngle = Get90DegreeTurnAngle(in.horse->formID, GetAngleToTarget(in.horse, in.target));
 			data->target90DegreeAngleSet = true;
 		}
 		else
@@ -2093,99 +2168,118 @@ namespace MountedNPCCombatVR
 		}
 		
 		data->state = StandGroundState::Active;
-		data->stateStartTime = currentTime;
+		data->stateStartTime = in.currentTime;
+		ManeuverScript::StartScript(data->script, in.currentTime);
+		MarkManeuverStarted(in.horse->formID, MANEUVER_STAND_GROUND, in.currentTime);
 
-		_MESSAGE("SpecialMovesets: Horse %08X STANDING GROUND for %.1f seconds %s (rolled %d < %d%%, dist: %.0f)",
-			horse->formID, data->standDuration, 
+		_MESSAGE("SpecialMovesets: Horse %08X STANDING GROUND for %.1f seconds %s (dist: %.0f)",
+			in.horse->formID, data->standDuration, 
 			data->noRotation ? "(NO ROTATION)" : "(with 90-deg turn)",
-			roll, StandGroundChancePercent, distanceToTarget);
+			in.distanceToTarget);
 		
 		return true;  // Stand ground initiated
 	}
-
+	
 	// NOTE: TryMountedVsMountedStandGround has been REMOVED
 	// Mounted vs mounted combat no longer uses stand ground maneuver
 	// The horses will continue to move and face each other directly
 	
-	bool UpdateStandGroundManeuver(Actor* horse, Actor* target)
+	// One tick of the active phase: keep the horse stopped. Returns false
+	// once the target moved away or the duration is up, after switching
+	// to Completed.
+	static bool StandGroundHoldTick(HorseStandGroundData* data, Actor* horse, Actor* target, float currentTime)
 	{
-		if (!horse) return false;
-		
-		HorseStandGroundData* data = GetOrCreateStandGroundData(horse->formID);
-		if (!data) return false;
-		
-		// Not standing ground
-		if (data->state == StandGroundState::None)
-		{
-			return false;
-		}
-		
-		float currentTime = GetCurrentTime();
 		float timeInState = currentTime - data->stateStartTime;
 		
-		// Completed state - reset after short delay
-		if (data->state == StandGroundState::Completed)
+		// Check if target moved too far away (aborts stand ground)
+		if (target)
 		{
-			if (timeInState >= 0.5f)
-			{
-				data->state = StandGroundState::None;
-				data->rotationLocked = false;  // Reset rotation lock
-				data->lockedAngle = 0;
-				_MESSAGE("SpecialMovesets: Horse %08X stand ground fully RESET", horse->formID);
-			}
-			return false;
-		}
-		
-		// Active state - check if duration complete or target moved away
-		if (data->state == StandGroundState::Active)
-		{
-			// Check if target moved too far away (aborts stand ground)
-			if (target)
-			{
-				float dx = target->pos.x - horse->pos.x;
-				float dy = target->pos.y - horse->pos.y;
-				float distanceToTarget = sqrt(dx * dx + dy * dy);
-				
-				// If target is now far away (>400 units), stop standing ground
-				if (distanceToTarget > 400.0f)
-				{
-					data->state = StandGroundState::Completed;
-					data->stateStartTime = currentTime;
-					data->lastCompleteTime = currentTime;
-					data->rotationLocked = false;  // Reset rotation lock
-					data->lockedAngle = 0;
-					
-					// Let dynamic weapon switching handle weapon equip based on distance
-					// Don't force melee - the distance-based system will choose appropriately
-					
-					_MESSAGE("SpecialMovesets: Horse %08X stand ground ENDED - target moved away (%.0f units)", 
-						horse->formID, distanceToTarget);
-					return false;
-				}
-			}
+			float dx = target->pos.x - horse->pos.x;
+			float dy = target->pos.y - horse->pos.y;
+			float distanceToTarget = sqrt(dx * dx + dy * dy);
 			
-			// Check if duration complete
-			if (timeInState >= data->standDuration)
+			// If target is now far away (>400 units), stop standing ground
+			if (distanceToTarget > 400.0f)
 			{
 				data->state = StandGroundState::Completed;
 				data->stateStartTime = currentTime;
-				data->lastCompleteTime = currentTime;
+				MarkManeuverCompleted(horse->formID, MANEUVER_STAND_GROUND, currentTime);
 				data->rotationLocked = false;  // Reset rotation lock
 				data->lockedAngle = 0;
 				
-				_MESSAGE("SpecialMovesets: Horse %08X stand ground COMPLETE after %.1f seconds", 
-					horse->formID, timeInState);
+				// Let dynamic weapon switching handle weapon equip based on distance
+				// Don't force melee - the distance-based system will choose appropriately
 				
+				_MESSAGE("SpecialMovesets: Horse %08X stand ground ENDED - target moved away (%.0f units)", 
+					horse->formID, distanceToTarget);
 				return false;
 			}
+		}
+		
+		// Check if duration complete
+		if (timeInState >= data->standDuration)
+		{
+			data->state = StandGroundState::Completed;
+			data->stateStartTime = currentTime;
+			MarkManeuverCompleted(horse->formID, MANEUVER_STAND_GROUND, currentTime);
+			data->rotationLocked = false;  // Reset rotation lock
+			data->lockedAngle = 0;
 			
-			// Still standing ground - ensure horse stays stopped
-			StopHorseSprint(horse);
+			_MESSAGE("SpecialMovesets: Horse %08X stand ground COMPLETE after %.1f seconds", 
+				horse->formID, timeInState);
 			
-			return true;
+			return false;
 		}
 		
-		return false;
+		// Still standing ground - ensure horse stays stopped
+		StopHorseSprint(horse);
+		
+		return true;
+	}
+	
+	// Stand ground sequence: hold position, then reset after a short
+	// delay. Started by StartStandGround.
+	static bool RunStandGroundScript(HorseStandGroundData* data, Actor* horse, Actor* target, float now)
+	{
+		SCRIPT_BEGIN(data->script);
+		
+		// ACTIVE - check every tick if duration complete or target moved away
+		while (StandGroundHoldTick(data, horse, target, now))
+		{
+			SCRIPT_YIELD(data->script);
+		}
+		
+		// COMPLETED - reset after short delay
+		SCRIPT_WAIT_SECONDS(data->script, now, 0.5f);
+		
+		data->state = StandGroundState::None;
+		data->rotationLocked = false;  // Reset rotation lock
+		data->lockedAngle = 0;
+		_MESSAGE("SpecialMovesets: Horse %08X stand ground fully RESET", horse->formID);
+		
+		SCRIPT_END(data->script);
+	}
+	
+	bool UpdateStandGroundManeuver(Actor* horse, Actor* target)
+	{
+		if (!horse) return false;
+		
+		HorseStandGroundData* data = GetOrCreateStandGroundData(horse->formID);
+		if (!data) return false;
+		
+		// Not standing ground
+		if (!ManeuverScript::IsScriptRunning(data->script))
+		{
+			return false;
+		}
+		
+		float currentTime = GetCurrentTime();
+		if (ManeuverScript::IsScriptDue(data->script, currentTime))
+		{
+			RunStandGroundScript(data, horse, target, currentTime);
+		}
+		
+		return data->state == StandGroundState::Active;
 	}
 	
 	void StopStandGroundManeuver(UInt32 horseFormID)
@@ -2196,7 +2290,8 @@ namespace MountedNPCCombatVR
 			{
 				float currentTime = GetCurrentTime();
 				g_horseStandGroundData[i].state = StandGroundState::None;
-				g_horseStandGroundData[i].lastCompleteTime = currentTime;
+				MarkManeuverCompleted(horseFormID, MANEUVER_STAND_GROUND, currentTime);
+				ManeuverScript::StopScript(g_horseStandGroundData[i].script);
 				g_horseStandGroundData[i].rotationLocked = false;  // Reset rotation lock
 				g_horseStandGroundData[i].lockedAngle = 0;
 				_MESSAGE("SpecialMovesets: Stopped stand ground for horse %08X", horseFormID);
@@ -2227,98 +2322,31 @@ namespace MountedNPCCombatVR
 	// PLAYER AGGRO SWITCH IMPLEMENTATION
 	// ============================================
 	
-	static PlayerAggroSwitchData* GetOrCreatePlayerAggroSwitchData(UInt32 horseFormID)
-	{
-		// Check if already tracked
-		for (int i = 0; i < g_playerAggroSwitchCount; i++)
-		{
-			if (g_playerAggroSwitchData[i].isValid && g_playerAggroSwitchData[i].horseFormID == horseFormID)
-			{
-				return &g_playerAggroSwitchData[i];
-			}
-		}
-		
-		// Create new entry
-		if (g_playerAggroSwitchCount < MAX_TRACKED_HORSES)
-		{
-			PlayerAggroSwitchData* data = &g_playerAggroSwitchData[g_playerAggroSwitchCount];
-			data->horseFormID = horseFormID;
-			data->lastCheckTime = -PLAYER_AGGRO_SWITCH_INTERVAL;  // Allow immediate first check
-			data->isValid = true;
-			g_playerAggroSwitchCount++;
-			return data;
-		}
-		
-		return nullptr;
-	}
-	
-	bool TryPlayerAggroSwitch(Actor* horse, Actor* rider, Actor* currentTarget)
+	// Chance to start (0 = not eligible)
+	static int ScorePlayerAggroSwitch(const ManeuverInputs& in, const HorseManeuverTimes* times)
 	{
-		if (!horse || !rider || !currentTarget) return false;
-		
-		// ============================================
-		// EXCLUDE CIVILIANS - They flee, not fight
-		// ============================================
-		MountedCombatClass combatClass = DetermineCombatClass(rider);
-		if (combatClass == MountedCombatClass::CivilianFlee)
-		{
-			return false;
-		}
-		
-		// Only trigger when fighting a NON-PLAYER target
-		if (g_thePlayer && (*g_thePlayer) && currentTarget == (*g_thePlayer))
-		{
-			return false;
-		}
-		
-		Actor* player = *g_thePlayer;
+		if (!in.rider || !in.player) return 0;
 		
-		// Skip if already targeting player
-		if (currentTarget == player) return false;
+		// Civilians flee, not fight
+		if (in.combatClass == MountedCombatClass::CivilianFlee) return 0;
 		
-		// Check if player is within range
-		float dx = player->pos.x - horse->pos.x;
-		float dy = player->pos.y - horse->pos.y;
-		float distanceToPlayer = sqrt(dx * dx + dy * dy);
+		// Only from melee with a NON-PLAYER target, and not mid-maneuver
+		if (in.targetIsPlayer) return 0;
+		if (in.distanceToTarget >= in.meleeRange) return 0;
+		if (in.charging || in.inRapidFire) return 0;
 		
-		if (distanceToPlayer > PLAYER_AGGRO_SWITCH_RANGE)
-		{
-			return false;  // Player too far
-		}
+		// Player must be close (and within special moveset range) and alive
+		if (in.distanceToPlayer > PLAYER_AGGRO_SWITCH_RANGE) return 0;
+		if (in.distanceToPlayer > SPECIAL_MOVESET_MAX_DISTANCE) return 0;
+		if (in.player->IsDead(1)) return 0;
 		
-		// ============================================
-		// MAXIMUM DISTANCE CHECK - Don't trigger if player beyond special moveset range
-		// ============================================
-		if (distanceToPlayer > SPECIAL_MOVESET_MAX_DISTANCE)
-		{
-			return false;
-		}
-		
-		// Check if player is alive
-		if (player->IsDead(1))
-		{
-			return false;
-		}
-		
-		PlayerAggroSwitchData* data = GetOrCreatePlayerAggroSwitchData(horse->formID);
-		if (!data) return false;
-		
-		float currentTime = GetCurrentTime();
-		
-		// Check 20-second interval
-		if ((currentTime - data->lastCheckTime) < PLAYER_AGGRO_SWITCH_INTERVAL)
-		{
-			return false;  // Not time to check yet
-		}
-		data->lastCheckTime = currentTime;
+		if (!IsManeuverCheckDue(times, MANEUVER_PLAYER_AGGRO, in.currentTime)) return 0;
 		
 		// ============================================
 		// DISTANCE-SCALED CHANCE
-		// Closer player = higher chance (15% at 0 units)
-		// Further player = lower chance (2% at 900 units)
-		// Linear interpolation based on distance
+		// Closer player = higher chance, linear down to the minimum at max range
 		// ============================================
-		float distanceRatio = distanceToPlayer / PLAYER_AGGRO_SWITCH_RANGE;  // 0.0 at closest, 1.0 at max range
+		float distanceRatio = in.distanceToPlayer / PLAYER_AGGRO_SWITCH_RANGE;  // 0.0 at closest, 1.0 at max range
 		int scaledChance = PLAYER_AGGRO_SWITCH_CHANCE_MAX - 
 			(int)((PLAYER_AGGRO_SWITCH_CHANCE_MAX - PLAYER_AGGRO_SWITCH_CHANCE_MIN) * distanceRatio);
 		
@@ -2326,17 +2354,20 @@ namespace MountedNPCCombatVR
 		if (scaledChance < PLAYER_AGGRO_SWITCH_CHANCE_MIN) scaledChance = PLAYER_AGGRO_SWITCH_CHANCE_MIN;
 		if (scaledChance > PLAYER_AGGRO_SWITCH_CHANCE_MAX) scaledChance = PLAYER_AGGRO_SWITCH_CHANCE_MAX;
 		
-		// Roll distance-scaled chance
-		EnsureRandomSeeded();
-		int roll = rand() % 100;
-		if (roll >= scaledChance)
-		{
-			return false;  // Didn't roll the chance
-		}
+		return scaledChance;
+	}
+	
+	static bool StartPlayerAggroSwitch(const ManeuverInputs& in)
+	{
+		Actor* horse = in.horse;
+		Actor* rider = in.rider;
+		Actor* player = in.player;
 		
 		// SUCCESS - Switch target to player!
-		_MESSAGE("SpecialMovesets: Horse %08X SWITCHING TARGET to PLAYER! (was fighting %08X, rolled %d < %d%% [dist: %.0f])",
-			horse->formID, currentTarget->formID, roll, scaledChance, distanceToPlayer);
+		_MESSAGE("SpecialMovesets: Horse %08X SWITCHING TARGET to PLAYER! (was fighting %08X [player dist: %.0f])",
+			horse->formID, in.target->formID, in.distanceToPlayer);
+		
+		MarkManeuverStarted(horse->formID, MANEUVER_PLAYER_AGGRO, in.currentTime);
 		
 		// Set combat target to player
 		UInt32 playerHandle = player->CreateRefHandle();
@@ -2355,35 +2386,155 @@ namespace MountedNPCCombatVR
 			rider->DrawSheatheWeapon(true);
 		}
 		
-		// Now trigger a charge toward the player!
-		// This makes the switch dramatic and aggressive
-		if (TryChargeManeuver(horse, rider, player, distanceToPlayer))
+		// Now roll a charge toward the player (same rules and chance as a
+		// normal charge, with the player as the target)
+		ManeuverInputs chargeInputs = in;
+		chargeInputs.target = player;
+		chargeInputs.targetIsPlayer = true;
+		chargeInputs.distanceToTarget = in.distanceToPlayer;
+		
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horse->formID);
+		int chargeChance = times ? ScoreCharge(chargeInputs, times) : 0;
+		if (chargeChance > 0)
 		{
-			_MESSAGE("SpecialMovesets: Horse %08X CHARGING at player after aggro switch!", horse->formID);
+			MarkManeuverChecked(horse->formID, MANEUVER_CHARGE, in.currentTime);
+			if ((rand() % 100) < chargeChance && StartCharge(chargeInputs))
+			{
+				_MESSAGE("SpecialMovesets: Horse %08X CHARGING at player after aggro switch!", horse->formID);
+			}
 		}
 		
 		return true;
 	}
 	
 	// ============================================
-	// CLEANUP FUNCTIONS
+	// MANEUVER ARBITRATION
 	// ============================================
+	// One pass per horse per tick replaces the separate Try* calls that
+	// each re-queried the same state and rolled their own rand(). Inputs
+	// are gathered once, each rolled maneuver scores its chance (0 = not
+	// eligible: disabled, out of range, interval or cooldown), and a
+	// single roll picks at most one to start.
+	//
+	// The scores are chances out of 100. While they add up to 100 or less
+	// each maneuver keeps exactly its configured chance; the picks are
+	// just mutually exclusive. Above 100 they are scaled down together
+	// (ManeuverSelection).
+	
+	static const char* GetManeuverName(int kind)
+	{
+		switch (kind)
+		{
+			case MANEUVER_REAR_UP: return "RearUp";
+			case MANEUVER_CHARGE: return "Charge";
+			case MANEUVER_RAPID_FIRE: return "RapidFire";
+			case MANEUVER_STAND_GROUND: return "StandGround";
+			case MANEUVER_PLAYER_AGGRO: return "PlayerAggroSwitch";
+			default: return "?";
+		}
+	}
+	
+	static void GatherManeuverInputs(ManeuverInputs& in, Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange)
+	{
+		in.horse = horse;
+		in.rider = rider;
+		in.target = target;
+		in.player = (g_thePlayer && (*g_thePlayer)) ? (*g_thePlayer) : nullptr;
+		in.combatClass = rider ? DetermineCombatClass(rider) : MountedCombatClass::None;
+		in.distanceToTarget = distanceToTarget;
+		in.meleeRange = meleeRange;
+		in.combatElapsed = GetCombatElapsedTime();
+		in.currentTime = GetCurrentTime();
+		in.targetIsPlayer = (in.player && target == in.player);
+		in.riderFleeing = IsHorseRiderFleeing(horse->formID);
+		in.inStandGround = IsInStandGround(horse->formID);
+		in.charging = IsHorseCharging(horse->formID);
+		in.inRapidFire = IsInRapidFire(horse->formID);
+		in.bowEquipped = rider && IsBowEquipped(rider);
+		
+		in.facingError = fabs(Steering::HeadingDelta(GetAngleToTarget(horse, target), Steering::GetHeading(horse)));
+		
+		in.distanceToPlayer = 1.0e9f;
+		if (in.player)
+		{
+			float dx = in.player->pos.x - horse->pos.x;
+			float dy = in.player->pos.y - horse->pos.y;
+			in.distanceToPlayer = sqrt(dx * dx + dy * dy);
+		}
+	}
 	
-	void ClearPlayerAggroSwitchData(UInt32 horseFormID)
+	static ManeuverChoice StartManeuver(int kind, const ManeuverInputs& in)
 	{
-		for (int i = 0; i < g_playerAggroSwitchCount; i++)
+		switch (kind)
 		{
-			if (g_playerAggroSwitchData[i].isValid && g_playerAggroSwitchData[i].horseFormID == horseFormID)
-			{
-				// Shift remaining entries
-				for (int j = i; j < g_playerAggroSwitchCount - 1; j++)
-				{
-					g_playerAggroSwitchData[j] = g_playerAggroSwitchData[j + 1];
-				}
-				g_playerAggroSwitchCount--;
-				_MESSAGE("SpecialMovesets: Cleared player aggro switch data for horse %08X", horseFormID);
-				return;
-			}
+			case MANEUVER_REAR_UP:
+				return StartRearUpOnApproach(in) ? ManeuverChoice::RearUp : ManeuverChoice::None;
+			case MANEUVER_CHARGE:
+				return StartCharge(in) ? ManeuverChoice::Charge : ManeuverChoice::None;
+			case MANEUVER_RAPID_FIRE:
+				return StartRapidFire(in) ? ManeuverChoice::RapidFire : ManeuverChoice::None;
+			case MANEUVER_STAND_GROUND:
+				return StartStandGround(in) ? ManeuverChoice::StandGround : ManeuverChoice::None;
+			case MANEUVER_PLAYER_AGGRO:
+				return StartPlayerAggroSwitch(in) ? ManeuverChoice::PlayerAggroSwitch : ManeuverChoice::None;
+			default:
+				return ManeuverChoice::None;
+		}
+	}
+	
+	ManeuverChoice ArbitrateManeuvers(Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange)
+	{
+		if (!horse || !target) return ManeuverChoice::None;
+		
+		HorseManeuverTimes* times = GetOrCreateManeuverTimes(horse->formID);
+		if (!times) return ManeuverChoice::None;
+		
+		ManeuverInputs in;
+		GatherManeuverInputs(in, horse, rider, target, distanceToTarget, meleeRange);
+		
+		int scores[MANEUVER_KIND_COUNT];
+		scores[MANEUVER_REAR_UP] = ScoreRearUpOnApproach(in, times);
+		scores[MANEUVER_CHARGE] = ScoreCharge(in, times);
+		scores[MANEUVER_RAPID_FIRE] = ScoreRapidFire(in, times);
+		scores[MANEUVER_STAND_GROUND] = ScoreStandGround(in, times);
+		scores[MANEUVER_PLAYER_AGGRO] = ScorePlayerAggroSwitch(in, times);
+		
+		// Every eligible maneuver had its roll this tick (its interval
+		// restarts), whichever one is picked - each keeps its configured
+		// chance per interval
+		int total = SumManeuverScores(scores, MANEUVER_KIND_COUNT);
+		if (total == 0) return ManeuverChoice::None;
+		
+		for (int k = 0; k < MANEUVER_KIND_COUNT; k++)
+		{
+			if (scores[k] > 0) times->lastCheckTime[k] = in.currentTime;
+		}
+		
+		EnsureRandomSeeded();
+		int range = GetManeuverRollRange(scores, MANEUVER_KIND_COUNT);
+		int roll = rand() % range;
+		
+		int chosen = PickManeuver(scores, MANEUVER_KIND_COUNT, roll);
+		if (chosen < 0) return ManeuverChoice::None;  // Didn't roll any
+		
+		_MESSAGE("SpecialMovesets: Horse %08X arbitration picked %s (roll %d of %d, total chance %d)",
+			horse->formID, GetManeuverName(chosen), roll, range, total);
+		
+		// If the pick can't start (e.g. the rear-up animation was
+		// rejected), fall through to another eligible maneuver, picked in
+		// proportion to the remaining scores
+		for (;;)
+		{
+			ManeuverChoice started = StartManeuver(chosen, in);
+			if (started != ManeuverChoice::None) return started;
+			
+			scores[chosen] = 0;
+			int remaining = SumManeuverScores(scores, MANEUVER_KIND_COUNT);
+			if (remaining == 0) return ManeuverChoice::None;
+			
+			chosen = PickManeuver(scores, MANEUVER_KIND_COUNT, rand() % remaining);
+			_MESSAGE("SpecialMovesets: Horse %08X arbitration pick failed to start - falling through to %s",
+				horse->formID, GetManeuverName(chosen));
 		}
 	}
 	
@@ -2546,7 +2697,7 @@ namespace MountedNPCCombatVR
 		}
 		
 		// Time for an attack! Determine which side the target is on
-		float horseAngle = horse->rot.z;
+		float horseAngle = Steering::GetHeading(horse);
 		float horseRightX = cos(horseAngle);
 		float horseRightY = -sin(horseAngle);
 		
@@ -2621,6 +2772,9 @@ namespace MountedNPCCombatVR
 		// Clear jump cooldown
 		ClearHorseJumpData(horseFormID);
 		
+		// Free the horse's attack slot
+		AttackSlots::ReleaseSlot(horseFormID);
+		
 		// Clear 90-degree turn direction data
 		for (int i = 0; i < g_horseTurnCount; i++)
 		{
@@ -2647,8 +2801,8 @@ namespace MountedNPCCombatVR
 		// Clear stand ground data
 		ClearStandGroundData(horseFormID);
 		
-		// Clear player aggro switch data
-		ClearPlayerAggroSwitchData(horseFormID);
+		// Clear maneuver checks and cooldowns
+		ClearManeuverTimes(horseFormID);
 		
 		// Clear close range melee assault data
 		ClearCloseRangeMeleeAssaultData(horseFormID);
@@ -2663,18 +2817,11 @@ namespace MountedNPCCombatVR
 	{
 		_MESSAGE("SpecialMovesets: === RESETTING ALL STATE ===");
 		
-		// Reset global rear up cooldown
-		g_lastGlobalRearUpTime = -REAR_UP_GLOBAL_COOLDOWN;
-		
-		// Reset global rapid fire cooldown
-		g_lastGlobalRapidFireTime = -RAPID_FIRE_GLOBAL_COOLDOWN;
-		
 		// Clear rear up tracking data
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
 		{
 			g_horseRearUpTracking[i].isValid = false;
 			g_horseRearUpTracking[i].horseFormID = 0;
-			g_horseRearUpTracking[i].lastRearUpTime = -RearUpCooldown;
 			g_horseRearUpTracking[i].lastKnownHealth = 0;
 		}
 		g_horseRearUpCount = 0;
@@ -2722,12 +2869,12 @@ namespace MountedNPCCombatVR
 		}
 		g_horseStandGroundCount = 0;
 		
-		// Clear player aggro switch data
+		// Clear maneuver rate limiter (checks, cooldowns, encounter cooldowns)
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
 		{
-			g_playerAggroSwitchData[i].isValid = false;
+			g_maneuverTimes[i].isValid = false;
 		}
-		g_playerAggroSwitchCount = 0;
+		g_maneuverTimesCount = 0;
 		
 		// Clear close range melee assault data
 		for (int i = 0; i < MAX_TRACKED_HORSES; i++)
@@ -90,10 +90,8 @@ namespace MountedNPCCombatVR
 	// Rear Up Moveset
 	// ============================================
 	
-	// Check and trigger rear up when horse faces target head-on (7% chance)
-	// Call this when horse enters melee range facing target
-	// Returns true if rear up was triggered
-	bool TryRearUpOnApproach(Actor* horse, Actor* target, float distanceToTarget);
+	// Rear up when facing the target head-on in melee range is rolled by
+	// ArbitrateManeuvers (see below)
 	
 	// Check and trigger rear up when horse takes large damage (10% chance)
 	// Call this from damage hook when horse takes significant hit
@@ -134,9 +132,7 @@ namespace MountedNPCCombatVR
 	// 3. Horse sprints toward target
 	// 4. Sprint stops when reaching melee range
 	
-	// Check and trigger charge maneuver when target is far
-	// Returns true if charge was initiated
-	bool TryChargeManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget);
+	// Started by ArbitrateManeuvers
 	
 	// Check if horse is currently in a charge
 	bool IsHorseCharging(UInt32 horseFormID);
@@ -162,9 +158,7 @@ namespace MountedNPCCombatVR
 	// 4. After 5 seconds, normal follow behavior resumes
 	// Has 45 second cooldown
 	
-	// Check and trigger rapid fire maneuver
-	// Returns true if rapid fire was initiated
-	bool TryRapidFireManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange);
+	// Started by ArbitrateManeuvers
 	
 	// Check if horse is currently in rapid fire mode
 	bool IsInRapidFire(UInt32 horseFormID);
@@ -189,9 +183,7 @@ namespace MountedNPCCombatVR
 	// 25% chance to trigger when conditions are met.
 	// NOTE: Only for mounted vs on-foot combat (not mounted vs mounted)
 	
-	// Check and trigger stand ground maneuver
-	// Returns true if stand ground was initiated
-	bool TryStandGroundManeuver(Actor* horse, Actor* rider, Actor* target, float distanceToTarget);
+	// Started by ArbitrateManeuvers
 	
 	// Check if horse is currently in stand ground mode
 	bool IsInStandGround(UInt32 horseFormID);
@@ -229,12 +221,33 @@ namespace MountedNPCCombatVR
 	// there's a distance-scaled chance (15% close, 2% at max range) 
 	// every 20 seconds to switch targets to the player and trigger a charge.
 	
-	// Check and trigger player aggro switch
-	// Returns true if switch was initiated (also triggers charge)
-	bool TryPlayerAggroSwitch(Actor* horse, Actor* rider, Actor* currentTarget);
-	
-	// Clear player aggro switch data for a horse
-	void ClearPlayerAggroSwitchData(UInt32 horseFormID);
+	// Started by ArbitrateManeuvers (also rolls a charge at the player)
+
+	// ============================================
+	// Maneuver Arbitration
+	// ============================================
+	// One pass per horse per tick for the rolled maneuvers (rear up on
+	// approach, charge, rapid fire, stand ground, player aggro switch).
+	// Shared inputs are gathered once, every eligible maneuver scores its
+	// chance, and one roll starts at most one of them (falling through to
+	// another eligible one if the pick can't start). Checks, cooldowns
+	// and encounter cooldowns go through one shared rate limiter.
+	// Reactive moves (jump, rear up on damage, close range assault) are
+	// not arbitrated.
+	
+	enum class ManeuverChoice
+	{
+		None = 0,
+		RearUp,
+		Charge,
+		RapidFire,
+		StandGround,
+		PlayerAggroSwitch
+	};
+	
+	// rider may be null (only rear up is possible then)
+	// Returns the maneuver started this tick, or None
+	ManeuverChoice ArbitrateManeuvers(Actor* horse, Actor* rider, Actor* target, float distanceToTarget, float meleeRange);
 
 	// ============================================
 	// Close Range Melee Assault (Emergency Close Combat)
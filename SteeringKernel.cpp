@@ -0,0 +1,169 @@
+#include "SteeringKernel.h"
+#include "PerfCounters.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define STEERING_USE_SSE2 1
+#endif
+
+namespace MountedNPCCombatVR
+{
+	namespace Steering
+	{
+		// ============================================
+		// QUEUE (one entry per horse per frame)
+		// ============================================
+
+		struct QueuedHeading
+		{
+			UInt32 horseFormID;
+			float desiredAngle;
+			float rate;
+		};
+
+		static QueuedHeading g_queue[STEERING_MAX_HORSES];
+		static int g_queueCount = 0;
+
+		static int FindQueued(UInt32 horseFormID)
+		{
+			for (int i = 0; i < g_queueCount; i++)
+			{
+				if (g_queue[i].horseFormID == horseFormID) return i;
+			}
+			return -1;
+		}
+
+		// ============================================
+		// KERNEL
+		// ============================================
+
+#ifdef STEERING_USE_SSE2
+		// Wrap four angles to [-PI, PI]: a - 2PI * round(a / 2PI)
+		// (cvtps rounds to nearest under the default MXCSR mode)
+		static inline __m128 WrapAngle4(__m128 angle)
+		{
+			const __m128 twoPi = _mm_set1_ps(STEERING_TWO_PI);
+			const __m128 invTwoPi = _mm_set1_ps(1.0f / STEERING_TWO_PI);
+
+			__m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(angle, invTwoPi)));
+			return _mm_sub_ps(angle, _mm_mul_ps(turns, twoPi));
+		}
+#endif
+
+		void SteerHeadings(const float* current, const float* desired, const float* rate, float* out, int count)
+		{
+			int i = 0;
+
+#ifdef STEERING_USE_SSE2
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 cur = _mm_loadu_ps(current + i);
+				__m128 diff = WrapAngle4(_mm_sub_ps(_mm_loadu_ps(desired + i), cur));
+				__m128 next = _mm_add_ps(cur, _mm_mul_ps(diff, _mm_loadu_ps(rate + i)));
+				_mm_storeu_ps(out + i, WrapAngle4(next));
+			}
+#endif
+
+			// Tail (or the whole batch without SSE2)
+			for (; i < count; i++)
+			{
+				float diff = WrapAngle(desired[i] - current[i]);
+				out[i] = WrapAngle(current[i] + diff * rate[i]);
+			}
+		}
+
+		// ============================================
+		// PUBLIC API
+		// ============================================
+
+		void QueueHeading(Actor* horse, float desiredAngle, float rate)
+		{
+			if (!horse) return;
+
+			int index = FindQueued(horse->formID);
+			if (index < 0)
+			{
+				if (g_queueCount >= STEERING_MAX_HORSES)
+				{
+					// Queue full - turn immediately rather than drop the request
+					float diff = WrapAngle(desiredAngle - horse->rot.z);
+					horse->rot.z = WrapAngle(horse->rot.z + diff * rate);
+					return;
+				}
+				index = g_queueCount++;
+			}
+
+			g_queue[index].horseFormID = horse->formID;
+			g_queue[index].desiredAngle = desiredAngle;
+			g_queue[index].rate = rate;
+		}
+
+		void SnapHeading(Actor* horse, float angle)
+		{
+			if (!horse) return;
+
+			horse->rot.z = angle;
+
+			int index = FindQueued(horse->formID);
+			if (index >= 0)
+			{
+				g_queue[index] = g_queue[g_queueCount - 1];
+				g_queueCount--;
+			}
+		}
+
+		float GetHeading(const TESObjectREFR* ref)
+		{
+			if (!ref) return 0.0f;
+
+			int index = FindQueued(ref->formID);
+			if (index < 0) return ref->rot.z;
+
+			// Same math as the kernel (scalar form) on the current rot.z
+			float diff = WrapAngle(g_queue[index].desiredAngle - ref->rot.z);
+			return WrapAngle(ref->rot.z + diff * g_queue[index].rate);
+		}
+
+		int FlushHeadings()
+		{
+			if (g_queueCount == 0) return 0;
+
+			// Gather into SoA (current heading is read now, after every snap this frame).
+			// Zeroed so lanes past count are never read uninitialized.
+			float current[STEERING_MAX_HORSES] = {};
+			float desired[STEERING_MAX_HORSES] = {};
+			float rate[STEERING_MAX_HORSES] = {};
+			Actor* horses[STEERING_MAX_HORSES];
+			int count = 0;
+
+			for (int i = 0; i < g_queueCount; i++)
+			{
+				TESForm* form = CountedLookupFormByID(g_queue[i].horseFormID);
+				if (!form || form->formType != kFormType_Character) continue;
+
+				Actor* horse = static_cast<Actor*>(form);
+				horses[count] = horse;
+				current[count] = horse->rot.z;
+				desired[count] = g_queue[i].desiredAngle;
+				rate[count] = g_queue[i].rate;
+				count++;
+			}
+
+			g_queueCount = 0;
+
+			SteerHeadings(current, desired, rate, current, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				horses[i]->rot.z = current[i];
+			}
+
+			return count;
+		}
+
+		void ResetSteering()
+		{
+			g_queueCount = 0;
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+#include <cmath>
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// STEERING KERNEL (batched horse heading smoothing)
+	// ============================================
+	// Every turn path in DynamicPackages (rapid fire, stand ground,
+	// breathing-distance failsafe, charge, default follow) did its own
+	//     diff = wrap(desired - rot.z); rot.z = wrap(rot.z + diff * rate)
+	// with two while-loops per wrap, and wrote rot.z on the spot.
+	//
+	// Turn paths now queue the heading they want (QueueHeading). Once per
+	// frame FlushHeadings gathers the queued horses into SoA arrays (current
+	// heading, desired heading, rate), runs one SSE2 pass over them (scalar
+	// fallback on other targets) and writes rot.z back once per horse.
+	// A horse queued twice in a frame keeps only its last request.
+	// The queue holds formIDs; FlushHeadings resolves them, so a horse
+	// unloaded before the flush is skipped rather than written through a
+	// stale pointer.
+	//
+	// rot.z only changes at the flush, so code that runs later in the
+	// frame and cares where an actor is facing (attack slots, pursuit
+	// field, intercept, sheer-drop probes) reads GetHeading instead: the
+	// heading the actor will have after the flush.
+	//
+	// Paths that must set an exact heading immediately (stand-ground lock)
+	// use SnapHeading, which also drops any queued turn for that horse.
+	//
+	// WrapAngle is the branchless replacement for the while-loop wrap.
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace Steering
+	{
+		const int STEERING_MAX_HORSES = 64;
+		const float STEERING_PI = 3.14159265f;
+		const float STEERING_TWO_PI = 6.28318531f;
+
+		// Wrap to [-PI, PI] without loops or branches
+		inline float WrapAngle(float angle)
+		{
+			return angle - STEERING_TWO_PI * floorf(angle * (1.0f / STEERING_TWO_PI) + 0.5f);
+		}
+
+		// Signed shortest turn from 'current' to 'desired'
+		inline float HeadingDelta(float desired, float current)
+		{
+			return WrapAngle(desired - current);
+		}
+
+		// out[i] = wrap(current[i] + wrap(desired[i] - current[i]) * rate[i])
+		// Arrays may alias out == current.
+		void SteerHeadings(const float* current, const float* desired, const float* rate, float* out, int count);
+
+		// Turn 'horse' toward desiredAngle by 'rate' of the remaining difference at the end of this frame
+		void QueueHeading(Actor* horse, float desiredAngle, float rate);
+
+		// Set the heading now and cancel any queued turn for this horse
+		void SnapHeading(Actor* horse, float angle);
+
+		// rot.z with this frame's queued turn applied (rot.z if none queued)
+		float GetHeading(const TESObjectREFR* ref);
+
+		// Run the kernel over all queued horses and write rot.z (once per frame)
+		// Returns the number of horses written.
+		int FlushHeadings();
+
+		// Drop queued turns (mod deactivate)
+		void ResetSteering();
+	}
+}
@@ -0,0 +1,546 @@
+#include "TargetAllocation.h"
+#include "MountedCombat.h"
+#include "Helper.h"
+#include "config.h"
+
+namespace MountedNPCCombatVR
+{
+	namespace TargetAllocation
+	{
+		// ============================================
+		// PROBLEM STORAGE
+		// ============================================
+		// Targets own a contiguous range of slots:
+		// g_slot*[target.firstSlot .. target.firstSlot + target.slotCount)
+		// ============================================
+
+		struct AllocTarget
+		{
+			UInt32 formID;
+			Actor* actor;
+			int fixedAttackers;
+			int firstSlot;
+			int slotCount;
+		};
+
+		struct AllocRider
+		{
+			Actor* rider;
+			UInt32 currentTargetFormID;
+			int candidateTarget[ALLOC_MAX_CANDIDATES + 1];  // +1 for the current target
+			float candidateValue[ALLOC_MAX_CANDIDATES + 1];
+			int candidateCount;
+			float outsideValue;   // Worth of having no slot (overflow onto the best candidate)
+			int assignedSlot;
+			Actor* result;
+		};
+
+		const int ALLOC_MAX_SLOTS = ALLOC_MAX_TARGETS * ALLOC_MAX_SLOTS_PER_TARGET;
+
+		static AllocTarget g_targets[ALLOC_MAX_TARGETS];
+		static int g_targetCount = 0;
+
+		static AllocRider g_riders[ALLOC_MAX_RIDERS];
+		static int g_riderCount = 0;
+
+		static float g_slotPrice[ALLOC_MAX_SLOTS];
+		static int g_slotOwner[ALLOC_MAX_SLOTS];
+
+		// Warm-start prices from the previous solve (lowest slot price per target)
+		struct PriceMemory
+		{
+			UInt32 formID;
+			float price;
+		};
+
+		static PriceMemory g_priceMemory[ALLOC_MAX_TARGETS];
+		static int g_priceMemoryCount = 0;
+
+		// ============================================
+		// HELPERS
+		// ============================================
+
+		static int GetSlotCap()
+		{
+			int cap = MaxAttackersPerTarget;
+			if (cap < 1) cap = 1;
+			if (cap > ALLOC_MAX_SLOTS_PER_TARGET) cap = ALLOC_MAX_SLOTS_PER_TARGET;
+			return cap;
+		}
+
+		static int FindTarget(UInt32 formID)
+		{
+			for (int i = 0; i < g_targetCount; i++)
+			{
+				if (g_targets[i].formID == formID) return i;
+			}
+			return -1;
+		}
+
+		static int FindOrAddTarget(UInt32 formID, Actor* actor)
+		{
+			int index = FindTarget(formID);
+			if (index >= 0)
+			{
+				if (!g_targets[index].actor) g_targets[index].actor = actor;
+				return index;
+			}
+
+			if (g_targetCount >= ALLOC_MAX_TARGETS) return -1;
+
+			index = g_targetCount++;
+			g_targets[index].formID = formID;
+			g_targets[index].actor = actor;
+			g_targets[index].fixedAttackers = 0;
+			g_targets[index].firstSlot = 0;
+			g_targets[index].slotCount = 0;
+			return index;
+		}
+
+		static float GetRememberedPrice(UInt32 formID)
+		{
+			for (int i = 0; i < g_priceMemoryCount; i++)
+			{
+				if (g_priceMemory[i].formID == formID) return g_priceMemory[i].price;
+			}
+			return 0.0f;
+		}
+
+		// Is 'target' currently fighting this rider (or its horse)?
+		static bool IsTargetAttackingRider(Actor* target, Actor* rider)
+		{
+			if (target->currentCombatTarget == 0) return false;
+
+			NiPointer<TESObjectREFR> targetRef;
+			LookupREFRByHandle(target->currentCombatTarget, targetRef);
+			if (!targetRef) return false;
+
+			if (targetRef->formID == rider->formID) return true;
+
+			NiPointer<Actor> mount;
+			if (CALL_MEMBER_FN(rider, GetMount)(mount) && mount)
+			{
+				return targetRef->formID == mount->formID;
+			}
+			return false;
+		}
+
+		static float ComputeValue(Actor* rider, Actor* target, float distance, bool isCurrent)
+		{
+			float value = ALLOC_BASE_VALUE - distance;
+
+			if (target->IsInCombat())
+			{
+				value += IsTargetAttackingRider(target, rider) ? ALLOC_THREAT_ATTACKING : ALLOC_THREAT_IN_COMBAT;
+			}
+
+			if (isCurrent)
+			{
+				value += ALLOC_STICKINESS_BONUS;
+			}
+
+			return value;
+		}
+
+		// ============================================
+		// PER-SCAN API
+		// ============================================
+
+		void BeginAllocation()
+		{
+			g_targetCount = 0;
+			g_riderCount = 0;
+		}
+
+		void AddFixedAttacker(UInt32 targetFormID)
+		{
+			if (targetFormID == 0) return;
+
+			int index = FindOrAddTarget(targetFormID, nullptr);
+			if (index >= 0)
+			{
+				g_targets[index].fixedAttackers++;
+			}
+		}
+
+		int AddRider(Actor* rider, Actor* currentTarget, float range,
+			SpatialGrid::GridPredicate predicate, void* context)
+		{
+			if (!rider || g_riderCount >= ALLOC_MAX_RIDERS) return -1;
+
+			int riderIndex = g_riderCount++;
+			AllocRider& entry = g_riders[riderIndex];
+			entry.rider = rider;
+			entry.currentTargetFormID = currentTarget ? currentTarget->formID : 0;
+			entry.candidateCount = 0;
+			entry.assignedSlot = -1;
+			entry.result = nullptr;
+
+			Actor* nearby[ALLOC_MAX_CANDIDATES];
+			float distances[ALLOC_MAX_CANDIDATES];
+			int nearbyCount = SpatialGrid::QueryNearest(rider->pos.x, rider->pos.y, rider->pos.z, range,
+				ALLOC_MAX_CANDIDATES, predicate, context, nearby, distances);
+
+			bool currentListed = false;
+
+			for (int i = 0; i < nearbyCount; i++)
+			{
+				int targetIndex = FindOrAddTarget(nearby[i]->formID, nearby[i]);
+				if (targetIndex < 0) continue;
+
+				bool isCurrent = (nearby[i]->formID == entry.currentTargetFormID);
+				if (isCurrent) currentListed = true;
+
+				entry.candidateTarget[entry.candidateCount] = targetIndex;
+				entry.candidateValue[entry.candidateCount] = ComputeValue(rider, nearby[i], distances[i], isCurrent);
+				entry.candidateCount++;
+			}
+
+			// Current target drifted out of range - still a candidate (stickiness)
+			if (currentTarget && !currentListed && !currentTarget->IsDead(1))
+			{
+				int targetIndex = FindOrAddTarget(currentTarget->formID, currentTarget);
+				if (targetIndex >= 0)
+				{
+					entry.candidateTarget[entry.candidateCount] = targetIndex;
+					entry.candidateValue[entry.candidateCount] =
+						ComputeValue(rider, currentTarget, GetDistanceBetween(rider, currentTarget), true);
+					entry.candidateCount++;
+				}
+			}
+
+			entry.outsideValue = 0.0f;
+			for (int c = 0; c < entry.candidateCount; c++)
+			{
+				float overflow = entry.candidateValue[c] - ALLOC_OVERFLOW_PENALTY;
+				if (c == 0 || overflow > entry.outsideValue) entry.outsideValue = overflow;
+			}
+
+			return riderIndex;
+		}
+
+		// Cheapest and second cheapest slot of a target
+		static void GetCheapestSlots(const AllocTarget& target, int& outCheapest, float& outSecondPrice)
+		{
+			outCheapest = -1;
+			float best = 0.0f;
+			outSecondPrice = 0.0f;
+			bool haveSecond = false;
+
+			for (int s = target.firstSlot; s < target.firstSlot + target.slotCount; s++)
+			{
+				float price = g_slotPrice[s];
+				if (outCheapest < 0 || price < best)
+				{
+					if (outCheapest >= 0)
+					{
+						outSecondPrice = best;
+						haveSecond = true;
+					}
+					outCheapest = s;
+					best = price;
+				}
+				else if (!haveSecond || price < outSecondPrice)
+				{
+					outSecondPrice = price;
+					haveSecond = true;
+				}
+			}
+
+			if (!haveSecond)
+			{
+				outSecondPrice = 1.0e30f;  // Only one slot
+			}
+		}
+
+		int Solve()
+		{
+			// ============================================
+			// SLOTS + WARM-START PRICES
+			// ============================================
+			int cap = GetSlotCap();
+			int slotCount = 0;
+
+			for (int t = 0; t < g_targetCount; t++)
+			{
+				AllocTarget& target = g_targets[t];
+				int free = cap - target.fixedAttackers;
+				if (free < 0) free = 0;
+
+				target.firstSlot = slotCount;
+				target.slotCount = free;
+
+				float warmPrice = GetRememberedPrice(target.formID) * ALLOC_PRICE_DECAY;
+				for (int s = 0; s < free; s++)
+				{
+					g_slotPrice[slotCount + s] = warmPrice;
+					g_slotOwner[slotCount + s] = -1;
+				}
+				slotCount += free;
+			}
+
+			// ============================================
+			// WARM-START ASSIGNMENT (keep current target if it has room)
+			// ============================================
+			int queue[ALLOC_MAX_RIDERS];
+			int queueHead = 0;
+			int queueTail = 0;
+			int queueSize = 0;
+
+			for (int r = 0; r < g_riderCount; r++)
+			{
+				AllocRider& rider = g_riders[r];
+
+				if (rider.currentTargetFormID != 0)
+				{
+					int t = FindTarget(rider.currentTargetFormID);
+					if (t >= 0)
+					{
+						for (int s = g_targets[t].firstSlot; s < g_targets[t].firstSlot + g_targets[t].slotCount; s++)
+						{
+							if (g_slotOwner[s] < 0)
+							{
+								g_slotOwner[s] = r;
+								rider.assignedSlot = s;
+								break;
+							}
+						}
+					}
+				}
+
+				if (rider.assignedSlot < 0 && rider.candidateCount > 0)
+				{
+					queue[queueTail] = r;
+					queueTail = (queueTail + 1) % ALLOC_MAX_RIDERS;
+					queueSize++;
+				}
+			}
+
+			// ============================================
+			// FORWARD AUCTION
+			// ============================================
+			int bids = 0;
+
+			while (queueSize > 0 && bids < ALLOC_MAX_BIDS)
+			{
+				int r = queue[queueHead];
+				queueHead = (queueHead + 1) % ALLOC_MAX_RIDERS;
+				queueSize--;
+
+				AllocRider& rider = g_riders[r];
+
+				// Best net value over the cheapest slot of each candidate
+				int bestCandidate = -1;
+				int bestSlot = -1;
+				float bestNet = 0.0f;
+				float bestSecondPrice = 0.0f;
+
+				for (int c = 0; c < rider.candidateCount; c++)
+				{
+					const AllocTarget& target = g_targets[rider.candidateTarget[c]];
+					if (target.slotCount == 0) continue;
+
+					int cheapest;
+					float secondPrice;
+					GetCheapestSlots(target, cheapest, secondPrice);
+
+					float net = rider.candidateValue[c] - g_slotPrice[cheapest];
+					if (bestSlot < 0 || net > bestNet)
+					{
+						bestCandidate = c;
+						bestSlot = cheapest;
+						bestNet = net;
+						bestSecondPrice = secondPrice;
+					}
+				}
+
+				if (bestSlot < 0 || bestNet < rider.outsideValue)
+				{
+					continue;  // Every slot costs more than overflowing - drop out
+				}
+
+				// Second best: another target, another slot of the same target,
+				// or overflowing without a slot
+				float secondNet = rider.candidateValue[bestCandidate] - bestSecondPrice;
+				if (secondNet < rider.outsideValue) secondNet = rider.outsideValue;
+
+				for (int c = 0; c < rider.candidateCount; c++)
+				{
+					if (c == bestCandidate) continue;
+
+					const AllocTarget& target = g_targets[rider.candidateTarget[c]];
+					if (target.slotCount == 0) continue;
+
+					int cheapest;
+					float secondPrice;
+					GetCheapestSlots(target, cheapest, secondPrice);
+
+					float net = rider.candidateValue[c] - g_slotPrice[cheapest];
+					if (net > secondNet) secondNet = net;
+				}
+
+				bids++;
+				g_slotPrice[bestSlot] += (bestNet - secondNet) + ALLOC_EPSILON;
+
+				int previousOwner = g_slotOwner[bestSlot];
+				g_slotOwner[bestSlot] = r;
+				rider.assignedSlot = bestSlot;
+
+				if (previousOwner >= 0)
+				{
+					g_riders[previousOwner].assignedSlot = -1;
+					queue[queueTail] = previousOwner;
+					queueTail = (queueTail + 1) % ALLOC_MAX_RIDERS;
+					queueSize++;
+				}
+			}
+
+			if (queueSize > 0)
+			{
+				_MESSAGE("TargetAllocation: Auction stopped after %d bids (%d riders unsettled)", bids, queueSize);
+			}
+
+			// ============================================
+			// RESULTS
+			// ============================================
+			int assigned = 0;
+
+			for (int r = 0; r < g_riderCount; r++)
+			{
+				AllocRider& rider = g_riders[r];
+
+				if (rider.assignedSlot >= 0)
+				{
+					for (int t = 0; t < g_targetCount; t++)
+					{
+						const AllocTarget& target = g_targets[t];
+						if (rider.assignedSlot >= target.firstSlot && rider.assignedSlot < target.firstSlot + target.slotCount)
+						{
+							rider.result = target.actor;
+							break;
+						}
+					}
+					assigned++;
+					continue;
+				}
+
+				// No slot: keep the current target, else best candidate over the cap
+				int bestTarget = -1;
+				float bestValue = 0.0f;
+
+				for (int c = 0; c < rider.candidateCount; c++)
+				{
+					int t = rider.candidateTarget[c];
+					if (g_targets[t].formID == rider.currentTargetFormID)
+					{
+						bestTarget = t;
+						break;
+					}
+					if (bestTarget < 0 || rider.candidateValue[c] > bestValue)
+					{
+						bestTarget = t;
+						bestValue = rider.candidateValue[c];
+					}
+				}
+
+				rider.result = (bestTarget >= 0) ? g_targets[bestTarget].actor : nullptr;
+			}
+
+			// ============================================
+			// REMEMBER PRICES FOR THE NEXT SOLVE
+			// ============================================
+			g_priceMemoryCount = 0;
+
+			for (int t = 0; t < g_targetCount && g_priceMemoryCount < ALLOC_MAX_TARGETS; t++)
+			{
+				const AllocTarget& target = g_targets[t];
+				if (target.slotCount == 0) continue;
+
+				int cheapest;
+				float secondPrice;
+				GetCheapestSlots(target, cheapest, secondPrice);
+
+				g_priceMemory[g_priceMemoryCount].formID = target.formID;
+				g_priceMemory[g_priceMemoryCount].price = g_slotPrice[cheapest];
+				g_priceMemoryCount++;
+			}
+
+			return assigned;
+		}
+
+		Actor* GetAssignedTarget(int riderIndex)
+		{
+			if (riderIndex < 0 || riderIndex >= g_riderCount) return nullptr;
+			return g_riders[riderIndex].result;
+		}
+
+		// ============================================
+		// ONE-OFF QUERIES
+		// ============================================
+
+		int CountAttackers(UInt32 targetFormID, UInt32 excludeRiderFormID)
+		{
+			if (targetFormID == 0) return 0;
+
+			int count = 0;
+			// Target column scan (one contiguous array, no record strides)
+			for (int i = 0; i < MAX_TRACKED_NPCS; i++)
+			{
+				if (!g_riderColumns.valid[i]) continue;
+				if (g_riderColumns.targetFormID[i] != targetFormID) continue;
+
+				if (g_riderColumns.actorFormID[i] != excludeRiderFormID) count++;
+			}
+			return count;
+		}
+
+		bool HasFreeAttackSlot(UInt32 targetFormID, UInt32 excludeRiderFormID)
+		{
+			return CountAttackers(targetFormID, excludeRiderFormID) < GetSlotCap();
+		}
+
+		Actor* FindBestTarget(Actor* rider, float range,
+			SpatialGrid::GridPredicate predicate, void* context)
+		{
+			if (!rider) return nullptr;
+
+			Actor* nearby[ALLOC_MAX_CANDIDATES];
+			float distances[ALLOC_MAX_CANDIDATES];
+			int nearbyCount = SpatialGrid::QueryNearest(rider->pos.x, rider->pos.y, rider->pos.z, range,
+				ALLOC_MAX_CANDIDATES, predicate, context, nearby, distances);
+
+			Actor* bestFree = nullptr;
+			float bestFreeValue = 0.0f;
+			Actor* bestFull = nullptr;
+			float bestFullValue = 0.0f;
+
+			for (int i = 0; i < nearbyCount; i++)
+			{
+				float value = ComputeValue(rider, nearby[i], distances[i], false);
+
+				if (HasFreeAttackSlot(nearby[i]->formID, rider->formID))
+				{
+					if (!bestFree || value > bestFreeValue)
+					{
+						bestFree = nearby[i];
+						bestFreeValue = value;
+					}
+				}
+				else if (!bestFull || value > bestFullValue)
+				{
+					bestFull = nearby[i];
+					bestFullValue = value;
+				}
+			}
+
+			return bestFree ? bestFree : bestFull;
+		}
+
+		void ResetTargetAllocation()
+		{
+			g_targetCount = 0;
+			g_riderCount = 0;
+			g_priceMemoryCount = 0;
+		}
+	}
+}
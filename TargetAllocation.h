@@ -0,0 +1,96 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+#include "SpatialGrid.h"
+
+namespace MountedNPCCombatVR
+{
+	// ============================================
+	// TARGET ALLOCATION (guards / soldiers vs several hostiles)
+	// ============================================
+	// Targets used to be picked greedily: every guard took its nearest
+	// hostile, and an alert pulled every ally in range onto the attacker.
+	// Ten guards would dogpile one wolf while a bandit archer went
+	// unengaged, and every retarget re-injected follow packages.
+	//
+	// The hostile scan now solves one weighted assignment per scan:
+	// - Each target has MaxAttackersPerTarget slots. Riders whose target
+	//   the game chose (or the player) use up a slot without bidding.
+	// - value(rider, target) = ALLOC_BASE_VALUE - distance
+	//                          + threat (target in combat / attacking this rider)
+	//                          + ALLOC_STICKINESS_BONUS if it is the current target
+	// - Solved with a forward auction (Bertsekas) over the slots. A rider
+	//   drops out when every slot costs more than overflowing onto its best
+	//   target without a slot (value - ALLOC_OVERFLOW_PENALTY).
+	//
+	// Warm start: riders start in a slot of their current target and
+	// slot prices start from last scan's (decayed) prices. When little
+	// changed, almost nobody bids and a scan costs O(riders x candidates).
+	//
+	// Riders left without a slot keep their current target, or (if they
+	// have none) take their best candidate anyway. The cap spreads
+	// riders out; it never leaves a guard idle next to a hostile.
+	//
+	// GAME THREAD ONLY.
+	// ============================================
+
+	namespace TargetAllocation
+	{
+		const int ALLOC_MAX_RIDERS = 16;            // Bidders per solve
+		const int ALLOC_MAX_TARGETS = 32;           // Distinct targets per solve
+		const int ALLOC_MAX_CANDIDATES = 8;         // Nearest hostiles considered per rider
+		const int ALLOC_MAX_SLOTS_PER_TARGET = 8;   // Upper bound for MaxAttackersPerTarget
+
+		const float ALLOC_BASE_VALUE = 3000.0f;       // Value of engaging a target at distance 0
+		const float ALLOC_STICKINESS_BONUS = 500.0f;  // Switching must gain more than this
+		const float ALLOC_THREAT_IN_COMBAT = 150.0f;  // Target is fighting someone
+		const float ALLOC_THREAT_ATTACKING = 350.0f;  // Target is fighting this rider
+		const float ALLOC_OVERFLOW_PENALTY = 2000.0f; // Joining a full target costs this much value (> range + stickiness,
+		                                              // so any free slot in range beats overflowing)
+		const float ALLOC_EPSILON = 50.0f;            // Minimum bid increment
+		const float ALLOC_PRICE_DECAY = 0.5f;         // Warm-start prices are scaled by this
+		const int ALLOC_MAX_BIDS = 2048;              // Safety cap on auction rounds per solve
+
+		// ============================================
+		// PER-SCAN API
+		// ============================================
+
+		// Start a new problem (clears riders/targets, keeps warm-start prices)
+		void BeginAllocation();
+
+		// A rider whose target is not ours to choose (game-chosen target, player)
+		// Uses up one of that target's slots.
+		void AddFixedAttacker(UInt32 targetFormID);
+
+		// A rider to assign. currentTarget may be nullptr. Candidates are the
+		// nearest actors within range that pass the predicate (plus the current
+		// target). Returns the rider's index, or -1 if the problem is full.
+		int AddRider(Actor* rider, Actor* currentTarget, float range,
+			SpatialGrid::GridPredicate predicate, void* context);
+
+		// Run the auction. Returns the number of riders assigned a slot.
+		int Solve();
+
+		// Result for a rider index from AddRider (nullptr = no target)
+		Actor* GetAssignedTarget(int riderIndex);
+
+		// ============================================
+		// ONE-OFF QUERIES (registration, ally alerts)
+		// ============================================
+
+		// Tracked riders currently targeting this actor (excluding one rider)
+		int CountAttackers(UInt32 targetFormID, UInt32 excludeRiderFormID);
+
+		// True if fewer than MaxAttackersPerTarget tracked riders target it
+		bool HasFreeAttackSlot(UInt32 targetFormID, UInt32 excludeRiderFormID);
+
+		// Best single target for one rider using the same values, preferring
+		// targets with a free slot (falls back to the best full one)
+		Actor* FindBestTarget(Actor* rider, float range,
+			SpatialGrid::GridPredicate predicate, void* context);
+
+		// Forget warm-start prices (mod deactivate)
+		void ResetTargetAllocation();
+	}
+}
@@ -0,0 +1,53 @@
+#include "Tracer.h"
+#include "Helper.h"
+#include "config.h"
+#include <shlobj.h>
+#include <ctime>
+#include <string>
+
+namespace MountedNPCCombatVR
+{
+	namespace Tracer
+	{
+		// ============================================
+		// GAME SIDE
+		// ============================================
+
+		FILE* OpenTraceFile()
+		{
+			char documentsPath[MAX_PATH];
+			if (FAILED(SHGetFolderPathA(NULL, CSIDL_MYDOCUMENTS, NULL, SHGFP_TYPE_CURRENT, documentsPath)))
+			{
+				return nullptr;
+			}
+
+			time_t now = time(nullptr);
+			struct tm localTime;
+			localtime_s(&localTime, &now);
+			char stamp[32];
+			strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &localTime);
+
+			std::string filepath = std::string(documentsPath) + "\\My Games\\Skyrim VR\\SKSE\\Mounted_NPC_Combat_VR_trace_" + stamp + ".json";
+
+			FILE* file = fopen(filepath.c_str(), "wb");
+			if (!file)
+			{
+				_MESSAGE("Tracer: Failed to open %s - tracing disabled", filepath.c_str());
+				return nullptr;
+			}
+
+			_MESSAGE("Tracer: Tracing to %s", filepath.c_str());
+			return file;
+		}
+
+		uint32_t GetTraceThreadID()
+		{
+			return (uint32_t)GetCurrentThreadId();
+		}
+
+		bool IsTraceEnabled()
+		{
+			return TraceEnabled;
+		}
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// ============================================
+// FRAME TRACER (Chrome trace-event export)
+// ============================================
+// The profiler and the perf counters report aggregates, which hide the
+// spikes: one frame where the hostile scan, an ally alert and three
+// travel-package injections all landed together looks like a slightly
+// higher average.
+//
+// Opt-in (TraceEnabled INI). Each stage of the frame update (rider loop
+// stages, each rider, the mount scanner, ...) records a begin and an end
+// event. Rider/horse spans carry the actor's formID. Recording an event
+// is a store into one of two preallocated buffers; full buffers are
+// handed to a background thread that appends them to
+// Mounted_NPC_Combat_VR_trace_<time>.json.
+//
+// If the writer falls behind, the whole frame being recorded is dropped
+// (and its events counted) rather than stalling the tick. Dropping single
+// events would leave unmatched begin/end pairs in the file.
+//
+// The file uses the Chrome JSON array format. It opens in
+// chrome://tracing and in ui.perfetto.dev (which imports JSON traces),
+// and stays loadable after a crash because the closing ']' is optional.
+//
+// Spans on other threads (the projectile update hooks) are recorded
+// when they close, as one complete event, into a small mutex-guarded
+// side buffer that the writer drains. A span that does not fit is
+// dropped whole. Each thread gets its own row in the viewer.
+// ============================================
+
+namespace MountedNPCCombatVR
+{
+	namespace Tracer
+	{
+		const uint32_t TRACE_BUFFER_EVENTS = 16384;   // Events per buffer (two buffers)
+		const uint32_t TRACE_SIDE_EVENTS = 2048;      // Side buffer for spans off the frame thread
+		const float TRACE_FLUSH_INTERVAL = 2.0f;      // Seconds between partial-buffer writes
+
+		enum TracePhase : uint8_t
+		{
+			TRACE_BEGIN = 'B',
+			TRACE_END = 'E',
+			TRACE_COMPLETE = 'X'  // Begin time + duration (off-thread spans)
+		};
+
+		struct TraceEvent
+		{
+			uint64_t timeNs;
+			uint64_t durationNs;  // TRACE_COMPLETE only
+			const char* name;     // String literal (stored, never copied)
+			uint32_t formID;      // 0 = none
+			uint32_t threadID;    // OS thread ID (row in the viewer)
+			uint8_t phase;        // TracePhase
+		};
+
+		// ============================================
+		// JSON OUTPUT (engine independent)
+		// ============================================
+
+		// One event as a JSON object (no separator). Timestamps are
+		// microseconds since originNs. Returns the length written
+		// (0 if it did not fit).
+		int FormatTraceEvent(const TraceEvent& event, uint64_t originNs, char* out, int outSize);
+
+		// Append events to an open array ('[' already written).
+		// 'firstEvent' tracks whether a separator is needed and is
+		// updated. Returns false on a write error.
+		bool WriteTraceEvents(FILE* file, const TraceEvent* events, uint32_t count, uint64_t originNs, bool& firstEvent);
+
+		// ============================================
+		// RECORDING
+		// ============================================
+
+		// True from the first BeginFrame with TraceEnabled until FlushTracer
+		extern bool g_tracing;
+
+		// On the frame thread: records a begin event and returns 0.
+		// Elsewhere: records nothing and returns the start time.
+		uint64_t BeginSpan(const char* name, uint32_t formID);
+
+		// Records the end event (startNs == 0) or the complete span
+		void EndSpan(const char* name, uint32_t formID, uint64_t startNs);
+
+		class ScopedSpan
+		{
+		public:
+			ScopedSpan(const char* name, uint32_t formID) : m_name(name), m_formID(formID), m_startNs(0), m_active(g_tracing)
+			{
+				if (m_active) m_startNs = BeginSpan(m_name, m_formID);
+			}
+			~ScopedSpan()
+			{
+				if (m_active) EndSpan(m_name, m_formID, m_startNs);
+			}
+
+			ScopedSpan(const ScopedSpan&) = delete;
+			ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+		private:
+			const char* m_name;
+			uint32_t m_formID;
+			uint64_t m_startNs;
+			bool m_active;
+		};
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		// Open the frame (no-op unless TraceEnabled). Frames are the unit
+		// that is dropped when the writer is behind.
+		void BeginFrame();
+
+		// Close the frame; hands off a partial buffer every TRACE_FLUSH_INTERVAL
+		void EndFrame();
+
+		// Hand off buffered events, wait for the writer and close the file
+		// (called on mod deactivate; the next session opens a new file)
+		void FlushTracer(int timeoutMs = 1000);
+
+		uint64_t GetDroppedEventCount();
+
+		// ============================================
+		// GAME SIDE (Tracer.cpp)
+		// ============================================
+		// Everything above is engine independent (TracerCore.cpp). These
+		// are the only OS / INI dependencies; tests/TracerTest.cpp
+		// supplies its own.
+
+		// New Mounted_NPC_Combat_VR_trace_<time>.json opened for writing
+		// (nullptr on failure). Called on the writer thread.
+		FILE* OpenTraceFile();
+
+		// OS thread ID of the calling thread (row in the viewer)
+		uint32_t GetTraceThreadID();
+
+		// TraceEnabled INI setting
+		bool IsTraceEnabled();
+	}
+}
+
+// ============================================
+// TRACE MACROS
+// ============================================
+// name must be a string literal
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_SCOPE(name) ::MountedNPCCombatVR::Tracer::ScopedSpan TRACE_CONCAT(_traceSpan, __LINE__)(name, 0)
+#define TRACE_SCOPE_FORM(name, formID) ::MountedNPCCombatVR::Tracer::ScopedSpan TRACE_CONCAT(_traceSpan, __LINE__)(name, formID)
@@ -0,0 +1,434 @@
+#include "Tracer.h"
+#include "Profiler.h"      // For NowNs
+#include "common/IDebugLog.h"  // _MESSAGE only, so the tracer builds with a stand-in (tests/)
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// Recording, buffering and JSON output for Tracer. Engine independent
+// (the file location, thread IDs and the INI switch are in Tracer.cpp)
+// so it can be built and tested on its own; see tests/TracerTest.cpp.
+
+namespace MountedNPCCombatVR
+{
+	namespace Tracer
+	{
+		// ============================================
+		// JSON OUTPUT
+		// ============================================
+
+		int FormatTraceEvent(const TraceEvent& event, uint64_t originNs, char* out, int outSize)
+		{
+			if (!out || outSize <= 0) return 0;
+
+			// Names are literals from our own code, but keep the JSON valid regardless
+			char name[96];
+			int n = 0;
+			for (const char* c = event.name ? event.name : "?"; *c && n < (int)sizeof(name) - 2; c++)
+			{
+				if (*c == '"' || *c == '\\') name[n++] = '\\';
+				name[n++] = *c;
+			}
+			name[n] = '\0';
+
+			uint64_t relativeNs = (event.timeNs > originNs) ? event.timeNs - originNs : 0;
+			unsigned long long us = (unsigned long long)(relativeNs / 1000);
+			unsigned int fraction = (unsigned int)(relativeNs % 1000);
+
+			int length = snprintf(out, outSize, "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u",
+				name, (char)event.phase, us, fraction, event.threadID);
+			if (length <= 0 || length >= outSize) return 0;
+
+			int extra = 0;
+			if (event.phase == TRACE_COMPLETE)
+			{
+				extra = snprintf(out + length, outSize - length, ",\"dur\":%llu.%03u",
+					(unsigned long long)(event.durationNs / 1000), (unsigned int)(event.durationNs % 1000));
+				if (extra <= 0 || extra >= outSize - length) return 0;
+				length += extra;
+			}
+
+			if (event.formID != 0)
+			{
+				extra = snprintf(out + length, outSize - length, ",\"args\":{\"formID\":\"%08X\"}}", event.formID);
+			}
+			else
+			{
+				extra = snprintf(out + length, outSize - length, "}");
+			}
+			if (extra <= 0 || extra >= outSize - length) return 0;
+
+			return length + extra;
+		}
+
+		bool WriteTraceEvents(FILE* file, const TraceEvent* events, uint32_t count, uint64_t originNs, bool& firstEvent)
+		{
+			if (!file) return false;
+
+			char line[256];
+			for (uint32_t i = 0; i < count; i++)
+			{
+				int length = FormatTraceEvent(events[i], originNs, line, sizeof(line));
+				if (length == 0) continue;
+
+				if (!firstEvent) fputs(",\n", file);
+				fwrite(line, 1, length, file);
+				firstEvent = false;
+			}
+
+			return ferror(file) == 0;
+		}
+
+		// ============================================
+		// DOUBLE BUFFER
+		// ============================================
+		// The trace thread fills one buffer while the writer thread
+		// drains the other (same scheme as the combat recorder).
+		// g_frameStart marks where the frame being recorded starts in the
+		// active buffer; only the events before it are complete frames.
+		// ============================================
+
+		enum BufferState : int
+		{
+			BUFFER_FREE = 0,
+			BUFFER_FULL = 1
+		};
+
+		struct TraceBuffer
+		{
+			std::atomic<int> state;
+			uint32_t count;
+			TraceEvent events[TRACE_BUFFER_EVENTS];
+		};
+
+		bool g_tracing = false;
+
+		static TraceBuffer g_buffers[2];
+		static int g_activeBuffer = 0;     // Trace thread
+		static int g_writeBuffer = 0;      // Writer thread
+
+		static std::thread::id g_traceThread;
+		static uint32_t g_traceThreadID = 0;
+		static uint64_t g_originNs = 0;    // Set before the first hand-off, read by the writer
+		static uint64_t g_lastHandOffNs = 0;
+
+		static uint32_t g_frameStart = 0;      // Trace thread
+		static bool g_frameDropped = false;    // Trace thread - rest of the frame is discarded
+
+		// Side buffer for spans closed on other threads
+		static std::mutex g_sideMutex;
+		static TraceEvent g_sideEvents[TRACE_SIDE_EVENTS];     // Guarded by g_sideMutex
+		static uint32_t g_sideCount = 0;                       // Guarded by g_sideMutex
+		static TraceEvent g_sideDrain[TRACE_SIDE_EVENTS];      // Writer thread
+
+		static std::atomic<uint64_t> g_droppedEvents(0);
+		static std::atomic<bool> g_writerStarted(false);
+		static std::atomic<bool> g_closeRequested(false);
+		static std::atomic<bool> g_fileFailed(false);
+
+		// ============================================
+		// WRITER THREAD
+		// ============================================
+
+		// Open the file on the first write of a session
+		static void EnsureTraceFile(FILE*& file, bool& firstEvent)
+		{
+			if (file || g_fileFailed.load(std::memory_order_relaxed)) return;
+
+			file = OpenTraceFile();
+			firstEvent = true;
+			if (!file)
+			{
+				g_fileFailed.store(true, std::memory_order_relaxed);
+				return;
+			}
+			fputs("[\n", file);
+		}
+
+		static void WriterThread()
+		{
+			FILE* file = nullptr;
+			bool firstEvent = true;
+
+			for (;;)
+			{
+				// Off-thread spans (copied out so producers never wait on the file)
+				uint32_t sideCount = 0;
+				{
+					std::lock_guard<std::mutex> lock(g_sideMutex);
+					if (g_sideCount > 0)
+					{
+						memcpy(g_sideDrain, g_sideEvents, g_sideCount * sizeof(TraceEvent));
+						sideCount = g_sideCount;
+						g_sideCount = 0;
+					}
+				}
+				if (sideCount > 0)
+				{
+					EnsureTraceFile(file, firstEvent);
+					if (file)
+					{
+						WriteTraceEvents(file, g_sideDrain, sideCount, g_originNs, firstEvent);
+						fflush(file);
+					}
+				}
+
+				TraceBuffer& buffer = g_buffers[g_writeBuffer];
+
+				if (buffer.state.load(std::memory_order_acquire) == BUFFER_FULL)
+				{
+					EnsureTraceFile(file, firstEvent);
+
+					if (file && buffer.count > 0)
+					{
+						WriteTraceEvents(file, buffer.events, buffer.count, g_originNs, firstEvent);
+						fflush(file);
+					}
+
+					buffer.count = 0;
+					buffer.state.store(BUFFER_FREE, std::memory_order_release);
+					g_writeBuffer ^= 1;
+					continue;
+				}
+
+				if (g_closeRequested.load(std::memory_order_acquire))
+				{
+					if (file)
+					{
+						fputs("\n]\n", file);
+						fclose(file);
+						file = nullptr;
+					}
+					g_fileFailed.store(false, std::memory_order_relaxed);
+					g_closeRequested.store(false, std::memory_order_release);
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			}
+		}
+
+		static void StartWriter()
+		{
+			bool expected = false;
+			if (!g_writerStarted.compare_exchange_strong(expected, true)) return;
+
+			for (int i = 0; i < 2; i++)
+			{
+				g_buffers[i].count = 0;
+				g_buffers[i].state.store(BUFFER_FREE, std::memory_order_relaxed);
+			}
+
+			std::thread(WriterThread).detach();
+			_MESSAGE("Tracer: Writer thread started (2 x %u events)", TRACE_BUFFER_EVENTS);
+		}
+
+		// Queue the complete frames in the active buffer for writing and
+		// switch to the other one. The events of the frame being recorded
+		// move with it, so a frame is never split across a dropped hand-off.
+		// Returns false if the other buffer is still being written.
+		static bool HandOffActiveBuffer()
+		{
+			TraceBuffer& active = g_buffers[g_activeBuffer];
+			TraceBuffer& other = g_buffers[g_activeBuffer ^ 1];
+			if (other.state.load(std::memory_order_acquire) != BUFFER_FREE)
+			{
+				return false;
+			}
+
+			uint32_t openEvents = active.count - g_frameStart;
+			if (openEvents > 0)
+			{
+				memcpy(other.events, active.events + g_frameStart, openEvents * sizeof(TraceEvent));
+			}
+			other.count = openEvents;
+			active.count = g_frameStart;
+
+			active.state.store(BUFFER_FULL, std::memory_order_release);
+			g_activeBuffer ^= 1;
+			g_frameStart = 0;
+			g_lastHandOffNs = Profiler::NowNs();
+			return true;
+		}
+
+		// Discard what the current frame has recorded so far and ignore
+		// the rest of it, so the file never holds half a frame
+		static void DropCurrentFrame()
+		{
+			TraceBuffer& active = g_buffers[g_activeBuffer];
+			g_droppedEvents.fetch_add(active.count - g_frameStart + 1, std::memory_order_relaxed);
+			active.count = g_frameStart;
+			g_frameDropped = true;
+		}
+
+		// Frame boundary on the trace thread (events between frames, e.g.
+		// from game event sinks, form their own group)
+		static void MarkFrameBoundary()
+		{
+			g_frameStart = g_buffers[g_activeBuffer].count;
+			g_frameDropped = false;
+		}
+
+		// ============================================
+		// RECORDING
+		// ============================================
+
+		static void RecordEvent(const char* name, uint32_t formID, TracePhase phase)
+		{
+			if (g_frameDropped)
+			{
+				g_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			TraceBuffer* buffer = &g_buffers[g_activeBuffer];
+			if (buffer->count >= TRACE_BUFFER_EVENTS)
+			{
+				// Writer behind, or one frame filled a whole buffer - drop
+				// the frame instead of blocking
+				if (g_frameStart == 0 || !HandOffActiveBuffer())
+				{
+					DropCurrentFrame();
+					return;
+				}
+				buffer = &g_buffers[g_activeBuffer];
+			}
+
+			TraceEvent& event = buffer->events[buffer->count++];
+			event.timeNs = Profiler::NowNs();
+			event.durationNs = 0;
+			event.name = name;
+			event.formID = formID;
+			event.threadID = g_traceThreadID;
+			event.phase = (uint8_t)phase;
+		}
+
+		uint64_t BeginSpan(const char* name, uint32_t formID)
+		{
+			if (std::this_thread::get_id() == g_traceThread)
+			{
+				RecordEvent(name, formID, TRACE_BEGIN);
+				return 0;
+			}
+			return Profiler::NowNs();
+		}
+
+		void EndSpan(const char* name, uint32_t formID, uint64_t startNs)
+		{
+			if (startNs == 0)
+			{
+				RecordEvent(name, formID, TRACE_END);
+				return;
+			}
+
+			uint64_t now = Profiler::NowNs();
+
+			std::lock_guard<std::mutex> lock(g_sideMutex);
+			if (g_sideCount >= TRACE_SIDE_EVENTS)
+			{
+				g_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			TraceEvent& event = g_sideEvents[g_sideCount++];
+			event.timeNs = startNs;
+			event.durationNs = now - startNs;
+			event.name = name;
+			event.formID = formID;
+			event.threadID = GetTraceThreadID();
+			event.phase = TRACE_COMPLETE;
+		}
+
+		// ============================================
+		// GAME THREAD API
+		// ============================================
+
+		void BeginFrame()
+		{
+			if (!IsTraceEnabled() || g_fileFailed.load(std::memory_order_relaxed))
+			{
+				g_tracing = false;
+				return;
+			}
+
+			if (!g_tracing)
+			{
+				StartWriter();
+				g_traceThread = std::this_thread::get_id();
+				g_traceThreadID = GetTraceThreadID();
+				if (g_originNs == 0) g_originNs = Profiler::NowNs();
+				g_lastHandOffNs = Profiler::NowNs();
+				g_tracing = true;
+			}
+
+			MarkFrameBoundary();
+		}
+
+		void EndFrame()
+		{
+			if (!g_tracing) return;
+
+			MarkFrameBoundary();
+
+			// Write partial buffers periodically so a crash still leaves
+			// the last few seconds on disk
+			uint64_t now = Profiler::NowNs();
+			if (g_buffers[g_activeBuffer].count > 0 &&
+				(now - g_lastHandOffNs) >= (uint64_t)(TRACE_FLUSH_INTERVAL * 1000000000.0))
+			{
+				HandOffActiveBuffer();
+			}
+		}
+
+		void FlushTracer(int timeoutMs)
+		{
+			g_tracing = false;
+
+			if (!g_writerStarted.load())
+			{
+				return;
+			}
+
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+			// Hand off whatever is buffered (waits for the other buffer if needed)
+			MarkFrameBoundary();
+			if (g_buffers[g_activeBuffer].count > 0)
+			{
+				while (!HandOffActiveBuffer())
+				{
+					if (std::chrono::steady_clock::now() > deadline) break;
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			// Wait for both buffers to be written
+			while (g_buffers[0].state.load(std::memory_order_acquire) != BUFFER_FREE ||
+				g_buffers[1].state.load(std::memory_order_acquire) != BUFFER_FREE)
+			{
+				if (std::chrono::steady_clock::now() > deadline) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			// Close the file (the next session starts a new one)
+			g_closeRequested.store(true, std::memory_order_release);
+			while (g_closeRequested.load(std::memory_order_acquire))
+			{
+				if (std::chrono::steady_clock::now() > deadline) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			g_originNs = 0;
+
+			uint64_t dropped = g_droppedEvents.load(std::memory_order_relaxed);
+			if (dropped > 0)
+			{
+				_MESSAGE("Tracer: %llu events dropped so far (writer behind)", (unsigned long long)dropped);
+			}
+		}
+
+		uint64_t GetDroppedEventCount()
+		{
+			return g_droppedEvents.load(std::memory_order_relaxed);
+		}
+	}
+}
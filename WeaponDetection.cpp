@@ -4,6 +4,7 @@
 #include "MountedCombat.h"  // For DetermineCombatClass, MountedCombatClass
 #include "CombatStyles.h"   // For IsInRangedRole
 #include "config.h"    // For WeaponSwitchDistance, SheatheTransitionTime
+#include "PerfCounters.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/GameData.h"
 #include <ctime>
@@ -78,7 +79,7 @@ namespace MountedNPCCombatVR
 		UInt32 testFormID = GetFullFormIdMine(GLAIVE_DANGER_ESP_NAME, GLAIVE_DANGER_2H_FORMIDS[0]);
 		if (testFormID != 0)
 		{
-			TESForm* testForm = LookupFormByID(testFormID);
+			TESForm* testForm = CountedLookupFormByID(testFormID);
 			if (testForm)
 			{
 				g_glaiveDangerAvailable = true;
@@ -115,7 +116,7 @@ namespace MountedNPCCombatVR
 			return nullptr;
 		}
 		
-		TESForm* form = LookupFormByID(fullFormID);
+		TESForm* form = CountedLookupFormByID(fullFormID);
 		if (!form)
 		{
 			_MESSAGE("WeaponDetection: Could not find GlaiveDanger form %08X", fullFormID);
@@ -310,7 +311,7 @@ namespace MountedNPCCombatVR
 	
 	static Actor* GetActorFromFormID(UInt32 formID)
 	{
-		TESForm* form = LookupFormByID(formID);
+		TESForm* form = CountedLookupFormByID(formID);
 		if (!form || form->formType != kFormType_Character) return nullptr;
 		return static_cast<Actor*>(form);
 	}
@@ -332,6 +333,8 @@ namespace MountedNPCCombatVR
 	{
 		if (!actor) return;
 		
+		PERF_COUNT(WeaponSwitches);
+		
 		const char* actorName = CALL_MEMBER_FN(actor, GetReferenceName)();
 		
 		// ============================================
@@ -380,7 +383,7 @@ namespace MountedNPCCombatVR
 			UInt32 glaiveFormID = GetFullFormIdMine(WEAPON_ESP_NAME, MOUNTED_GLAIVE_BASE_FORMID);
 			if (glaiveFormID != 0)
 			{
-				TESForm* glaiveForm = LookupFormByID(glaiveFormID);
+				TESForm* glaiveForm = CountedLookupFormByID(glaiveFormID);
 				if (glaiveForm)
 				{
 					TESObjectWEAP* fallbackGlaive = DYNAMIC_CAST(glaiveForm, TESForm, TESObjectWEAP);
@@ -452,7 +455,7 @@ namespace MountedNPCCombatVR
 			UInt32 glaiveFormID = GetFullFormIdMine(WEAPON_ESP_NAME, MOUNTED_GLAIVE_BASE_FORMID);
 			if (glaiveFormID != 0)
 			{
-				TESForm* glaiveForm = LookupFormByID(glaiveFormID);
+				TESForm* glaiveForm = CountedLookupFormByID(glaiveFormID);
 				if (glaiveForm)
 				{
 					TESObjectWEAP* fallbackGlaive = DYNAMIC_CAST(glaiveForm, TESForm, TESObjectWEAP);
@@ -535,7 +538,7 @@ namespace MountedNPCCombatVR
 			UInt32 mageStaffFormID = GetFullFormIdMine(MAGE_STAFF_ESP_NAME, MAGE_STAFF_BASE_FORMID);
 			if (mageStaffFormID != 0)
 			{
-				TESForm* staffForm = LookupFormByID(mageStaffFormID);
+				TESForm* staffForm = CountedLookupFormByID(mageStaffFormID);
 				if (staffForm)
 				{
 					TESObjectWEAP* mageStaff = DYNAMIC_CAST(staffForm, TESForm, TESObjectWEAP);
@@ -808,64 +811,29 @@ namespace MountedNPCCombatVR
 		float switchDist = targetIsMounted ? WeaponSwitchDistanceMounted : WeaponSwitchDistance;
 		bool hasBow = HasBowInInventory(actor);
 		
-		WeaponRequest request;
+		bool withinSwitchDist = (distanceToTarget <= switchDist);
+		bool bowEquipped = withinSwitchDist && IsBowEquipped(actor);
+		
 		bool forceMelee = false;  // Flag to bypass cooldown for critical melee switch
+		WeaponRequest request = DecideWeaponForDistance(distanceToTarget, switchDist, targetIsMounted, hasBow, bowEquipped, forceMelee);
 		
-		if (distanceToTarget <= switchDist)
+		if (withinSwitchDist && request == WeaponRequest::Glaive)
 		{
-			// Within melee range
-			// ============================================
-			// MOUNTED VS MOUNTED: PREFER GLAIVE
-			// When fighting a mounted target in melee range, use glaive
-			// ============================================
-			if (targetIsMounted)
-			{
-				request = WeaponRequest::Glaive;
-				_MESSAGE("WeaponState: %08X requesting GLAIVE (mounted vs mounted, dist: %.0f)", 
-					actor->formID, distanceToTarget);
-			}
-			else
-			{
-				request = WeaponRequest::Melee;
-			}
-			
-			// CRITICAL: If bow is currently equipped and we're in melee range, FORCE the switch
-			// This bypasses cooldown because being stuck with a bow in melee is deadly
-			if (IsBowEquipped(actor))
-			{
-				forceMelee = true;
-				_MESSAGE("WeaponState: FORCE MELEE - %08X has bow but is at melee range (%.0f <= %.0f)", 
-					actor->formID, distanceToTarget, switchDist);
-			}
+			_MESSAGE("WeaponState: %08X requesting GLAIVE (mounted vs mounted, dist: %.0f)", 
+				actor->formID, distanceToTarget);
 		}
-		else if (hasBow)
-		{
-			// Beyond switch distance and has bow - use bow
-			request = WeaponRequest::Bow;
-		}
-		else
+		
+		if (forceMelee)
 		{
-			// Beyond switch distance but no bow - use melee anyway
-			// ============================================
-			// MOUNTED VS MOUNTED: PREFER GLAIVE EVEN AT RANGE
-			// If target is mounted and we're closing in, use glaive
-			// ============================================
-			if (targetIsMounted)
-			{
-				request = WeaponRequest::Glaive;
-			}
-			else
-			{
-				request = WeaponRequest::Melee;
-			}
+			_MESSAGE("WeaponState: FORCE MELEE - %08X has bow but is at melee range (%.0f <= %.0f)", 
+				actor->formID, distanceToTarget, switchDist);
 		}
 		
 		// If forcing melee, bypass the normal request and directly switch
 		if (forceMelee)
 		{
-			// For mounted targets, force glaive instead of generic melee
-			WeaponRequest forceRequest = targetIsMounted ? WeaponRequest::Glaive : WeaponRequest::Melee;
-			return ForceWeaponSwitch(actor, forceRequest);
+			// Decision already picked glaive for mounted targets, melee otherwise
+			return ForceWeaponSwitch(actor, request);
 		}
 		
 		return RequestWeaponSwitch(actor, request);
@@ -1048,7 +1016,7 @@ namespace MountedNPCCombatVR
 	{
 		if (!actor) return false;
 		
-		TESForm* arrowForm = LookupFormByID(IRON_ARROW_FORMID);
+		TESForm* arrowForm = CountedLookupFormByID(IRON_ARROW_FORMID);
 		if (!arrowForm)
 		{
 			_MESSAGE("WeaponDetection: Failed to find Iron Arrow (FormID: %08X)", IRON_ARROW_FORMID);
@@ -1063,7 +1031,7 @@ namespace MountedNPCCombatVR
 	{
 		if (!actor) return false;
 		
-		TESForm* ammoForm = LookupFormByID(ammoFormID);
+		TESForm* ammoForm = CountedLookupFormByID(ammoFormID);
 		if (!ammoForm) return false;
 		
 		TESAmmo* ammo = DYNAMIC_CAST(ammoForm, TESForm, TESAmmo);
@@ -1148,7 +1116,7 @@ namespace MountedNPCCombatVR
 		
 		if (!ammoToEquip)
 		{
-			TESForm* arrowForm = LookupFormByID(IRON_ARROW_FORMID);
+			TESForm* arrowForm = CountedLookupFormByID(IRON_ARROW_FORMID);
 			if (arrowForm)
 			{
 				ammoToEquip = DYNAMIC_CAST(arrowForm, TESForm, TESAmmo);
@@ -1631,7 +1599,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 		
-		TESForm* glaiveForm = LookupFormByID(glaiveFormID);
+		TESForm* glaiveForm = CountedLookupFormByID(glaiveFormID);
 		if (!glaiveForm)
 		{
 			_MESSAGE("WeaponDetection: ERROR - Could not find glaive form %08X", glaiveFormID);
@@ -1684,7 +1652,7 @@ namespace MountedNPCCombatVR
 		
 		if (HasBowInInventory(actor)) return false;
 		
-		TESForm* bowForm = LookupFormByID(HUNTING_BOW_FORMID);
+		TESForm* bowForm = CountedLookupFormByID(HUNTING_BOW_FORMID);
 		if (!bowForm) return false;
 		
 		TESObjectWEAP* bow = DYNAMIC_CAST(bowForm, TESForm, TESObjectWEAP);
@@ -1698,7 +1666,7 @@ namespace MountedNPCCombatVR
 	{
 		if (!actor) return false;
 		
-		TESForm* bowForm = LookupFormByID(HUNTING_BOW_FORMID);
+		TESForm* bowForm = CountedLookupFormByID(HUNTING_BOW_FORMID);
 		if (!bowForm) return false;
 		
 		TESObjectWEAP* bow = DYNAMIC_CAST(bowForm, TESForm, TESObjectWEAP);
@@ -1855,7 +1823,7 @@ namespace MountedNPCCombatVR
 			return false;
 		}
 		
-		TESForm* staffForm = LookupFormByID(mageStaffFormID);
+		TESForm* staffForm = CountedLookupFormByID(mageStaffFormID);
 		if (!staffForm)
 		{
 			_MESSAGE("WeaponDetection: ERROR - Could not find Mage Staff form %08X", mageStaffFormID);
@@ -4,6 +4,7 @@
 #include "skse64/GameObjects.h"
 #include "skse64/GameExtraData.h"
 #include "skse64/NiNodes.h"
+#include "CombatDecisions.h"
 
 namespace MountedNPCCombatVR
 {
@@ -26,14 +27,7 @@ namespace MountedNPCCombatVR
 		Ready     // Weapon is equipped and drawn
 	};
 	
-	enum class WeaponRequest
-	{
-		None,
-		Melee,
-		Bow,
-		Glaive,  // Preferred weapon for mounted vs mounted combat
-		Staff    // Warstaff for MageCaster class riders ONLY
-	};
+	// WeaponRequest is declared in CombatDecisions.h
 	
 	// ============================================
 	// Weapon State Machine API
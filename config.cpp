@@ -1,10 +1,19 @@
 #include "config.h"
+#include "LogRateLimit.h"
+#include "AsyncLogger.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace MountedNPCCombatVR {
 		
 	int logging = 1;
     int leftHandedMode = 0;
 	
+	// Per-subsystem verbosity mask for LOG_LIMITED call sites (see LogRateLimit.h)
+	uint32_t LogSubsystemMask = LOGSYS_ALL;
+	
 	// ============================================
 	// GENERAL SETTINGS
 	// ============================================
@@ -191,12 +200,48 @@ namespace MountedNPCCombatVR {
 	float SpellTargetFootHeight = 60.0f;      // Target height offset when on foot
 	float SpellTargetMountedHeight = 120.0f;  // Target height offset when mounted
 
+	// ============================================
+	// PROFILER SETTINGS
+	// ============================================
+	
+	float ProfilerReportInterval = 30.0f;
+	bool ProfilerWriteCsv = false;
+
+	// ============================================
+	// PERF COUNTER SETTINGS
+	// ============================================
+	
+	float PerfCounterCsvInterval = 0.0f;
+
+	// ============================================
+	// COMBAT RECORDER SETTINGS
+	// ============================================
+	
+	bool RecorderEnabled = false;
+
+	// ============================================
+	// TRACER SETTINGS
+	// ============================================
+	
+	bool TraceEnabled = false;
+
+	// ============================================
+	// TERRAIN SETTINGS
+	// ============================================
+	
+	// Experimental, off by default: the land layout offsets are from SE
+	// and not verified on VR (CalibrateAt would turn it off, but only
+	// after reads). With it off there is no terrain-based drop detection.
+	bool TerrainHeightSampling = false;
+	bool HazardMapEnabled = true;
+
 	// ============================================
 	// HOSTILE DETECTION SETTINGS
 	// ============================================
 	
 	float HostileDetectionRange = 1400.0f;
 	float HostileScanInterval = 3.0f;
+	int MaxAttackersPerTarget = 3;
 	
 	// ============================================
 	// TRACKING LIMITS
@@ -247,33 +292,261 @@ namespace MountedNPCCombatVR {
 		return false;
 	}
 
-    void loadConfig() 
- {
-		std::string runtimeDirectory = GetRuntimeDirectory();
+	// ============================================
+	// INI FIELD TABLE
+	// ============================================
+	// One descriptor per [Settings] key. minValue < maxValue clamps the
+	// parsed value (ints and floats only).
+
+	struct ConfigField
+	{
+		const char* name;
+		ConfigFieldType type;
+		void* target;        // The global the value is applied to
+		float minValue;
+		float maxValue;
+	};
 
-   if (runtimeDirectory.empty()) 
+	static const ConfigField g_configFields[] =
+	{
+		{ "Logging", CONFIG_INT, &logging, 0.0f, 0.0f },
+		{ "LogSubsystemMask", CONFIG_MASK, &LogSubsystemMask, 0.0f, 0.0f },
+		{ "PreventNPCDismountOnAttack", CONFIG_BOOL, &PreventNPCDismountOnAttack, 0.0f, 0.0f },
+		{ "EnableRemounting", CONFIG_BOOL, &EnableRemounting, 0.0f, 0.0f },
+		// Combat Range
+		{ "WeaponSwitchDistance", CONFIG_FLOAT, &WeaponSwitchDistance, 0.0f, 0.0f },
+		{ "WeaponSwitchDistanceMounted", CONFIG_FLOAT, &WeaponSwitchDistanceMounted, 0.0f, 0.0f },
+		{ "MeleeRangeOnFoot", CONFIG_FLOAT, &MeleeRangeOnFoot, 0.0f, 0.0f },
+		{ "MeleeRangeOnFootNPC", CONFIG_FLOAT, &MeleeRangeOnFootNPC, 0.0f, 0.0f },
+		{ "MeleeRangeMounted", CONFIG_FLOAT, &MeleeRangeMounted, 0.0f, 0.0f },
+		// Weapon Switch
+		{ "WeaponSwitchCooldown", CONFIG_FLOAT, &WeaponSwitchCooldown, 0.0f, 0.0f },
+		{ "SheatheTransitionTime", CONFIG_FLOAT, &SheatheTransitionTime, 0.0f, 0.0f },
+		// Mount Rotation
+		{ "HorseRotationSpeed", CONFIG_FLOAT, &HorseRotationSpeed, 0.01f, 1.0f },
+		// Attack Angles
+		{ "AttackAnglePlayer", CONFIG_FLOAT, &AttackAnglePlayer, 0.0f, 0.0f },
+		{ "AttackAngleNPC", CONFIG_FLOAT, &AttackAngleNPC, 0.0f, 0.0f },
+		{ "AttackAngleMounted", CONFIG_FLOAT, &AttackAngleMounted, 0.0f, 0.0f },
+		// Charge
+		{ "ChargeEnabled", CONFIG_BOOL, &ChargeEnabled, 0.0f, 0.0f },
+		{ "ChargeChancePercent", CONFIG_INT, &ChargeChancePercent, 0.0f, 0.0f },
+		{ "ChargeCooldown", CONFIG_FLOAT, &ChargeCooldown, 0.0f, 0.0f },
+		{ "ChargeMinDistance", CONFIG_FLOAT, &ChargeMinDistance, 0.0f, 0.0f },
+		{ "ChargeMaxDistance", CONFIG_FLOAT, &ChargeMaxDistance, 0.0f, 0.0f },
+		// Rapid Fire
+		{ "RapidFireEnabled", CONFIG_BOOL, &RapidFireEnabled, 0.0f, 0.0f },
+		{ "RapidFireChancePercent", CONFIG_INT, &RapidFireChancePercent, 0.0f, 0.0f },
+		{ "RapidFireCooldown", CONFIG_FLOAT, &RapidFireCooldown, 0.0f, 0.0f },
+		{ "RapidFireDuration", CONFIG_FLOAT, &RapidFireDuration, 0.0f, 0.0f },
+		{ "RapidFireShotCount", CONFIG_INT, &RapidFireShotCount, 0.0f, 0.0f },
+		// Bow Attack
+		{ "RangedAttacksEnabled", CONFIG_BOOL, &RangedAttacksEnabled, 0.0f, 0.0f },
+		{ "BowDrawMinTime", CONFIG_FLOAT, &BowDrawMinTime, 0.0f, 0.0f },
+		{ "BowDrawMaxTime", CONFIG_FLOAT, &BowDrawMaxTime, 0.0f, 0.0f },
+		// Arrow Aim
+		{ "ArrowShooterHeightOffset", CONFIG_FLOAT, &ArrowShooterHeightOffset, 0.0f, 0.0f },
+		{ "ArrowTargetFootHeight", CONFIG_FLOAT, &ArrowTargetFootHeight, 0.0f, 0.0f },
+		{ "ArrowTargetMountedHeight", CONFIG_FLOAT, &ArrowTargetMountedHeight, 0.0f, 0.0f },
+		// Rear Up
+		{ "RearUpEnabled", CONFIG_BOOL, &RearUpEnabled, 0.0f, 0.0f },
+		{ "RearUpApproachChance", CONFIG_INT, &RearUpApproachChance, 0.0f, 0.0f },
+		{ "RearUpDamageChance", CONFIG_INT, &RearUpDamageChance, 0.0f, 0.0f },
+		{ "RearUpCooldown", CONFIG_FLOAT, &RearUpCooldown, 0.0f, 0.0f },
+		// Stand Ground
+		{ "StandGroundEnabled", CONFIG_BOOL, &StandGroundEnabled, 0.0f, 0.0f },
+		{ "StandGroundMaxDistance", CONFIG_FLOAT, &StandGroundMaxDistance, 0.0f, 0.0f },
+		{ "StandGroundMinDuration", CONFIG_FLOAT, &StandGroundMinDuration, 0.0f, 0.0f },
+		{ "StandGroundMaxDuration", CONFIG_FLOAT, &StandGroundMaxDuration, 0.0f, 0.0f },
+		{ "StandGroundChancePercent", CONFIG_INT, &StandGroundChancePercent, 0.0f, 0.0f },
+		{ "StandGroundCheckInterval", CONFIG_FLOAT, &StandGroundCheckInterval, 0.0f, 0.0f },
+		{ "StandGroundCooldown", CONFIG_FLOAT, &StandGroundCooldown, 0.0f, 0.0f },
+		// Special Rider Combat
+		{ "RangedRoleMinDistance", CONFIG_FLOAT, &RangedRoleMinDistance, 0.0f, 0.0f },
+		{ "RangedRoleIdealDistance", CONFIG_FLOAT, &RangedRoleIdealDistance, 0.0f, 0.0f },
+		{ "RangedRoleMaxDistanceMin", CONFIG_FLOAT, &RangedRoleMaxDistanceMin, 0.0f, 0.0f },
+		{ "RangedRoleMaxDistanceMax", CONFIG_FLOAT, &RangedRoleMaxDistanceMax, 0.0f, 0.0f },
+		{ "RangedPositionTolerance", CONFIG_FLOAT, &RangedPositionTolerance, 0.0f, 0.0f },
+		{ "RangedFireMinDistance", CONFIG_FLOAT, &RangedFireMinDistance, 0.0f, 0.0f },
+		{ "RangedFireMaxDistance", CONFIG_FLOAT, &RangedFireMaxDistance, 0.0f, 0.0f },
+		{ "MageRoleMinDistance", CONFIG_FLOAT, &MageRoleMinDistance, 0.0f, 0.0f },
+		{ "MageRoleIdealDistance", CONFIG_FLOAT, &MageRoleIdealDistance, 0.0f, 0.0f },
+		{ "MageRoleMaxDistanceMin", CONFIG_FLOAT, &MageRoleMaxDistanceMin, 0.0f, 0.0f },
+		{ "MageRoleMaxDistanceMax", CONFIG_FLOAT, &MageRoleMaxDistanceMax, 0.0f, 0.0f },
+		{ "DynamicRangedRoleIdealDistance", CONFIG_FLOAT, &DynamicRangedRoleIdealDistance, 0.0f, 0.0f },
+		{ "DynamicRangedRoleMeleeThreshold", CONFIG_FLOAT, &DynamicRangedRoleMeleeThreshold, 0.0f, 0.0f },
+		{ "DynamicRangedRoleReturnThreshold", CONFIG_FLOAT, &DynamicRangedRoleReturnThreshold, 0.0f, 0.0f },
+		{ "DynamicRangedRoleModeSwitchCooldown", CONFIG_FLOAT, &DynamicRangedRoleModeSwitchCooldown, 0.0f, 0.0f },
+		{ "DynamicRangedRoleMinRiders", CONFIG_INT, &DynamicRangedRoleMinRiders, 0.0f, 0.0f },
+		// Mounted Attack Stagger
+		{ "MountedAttackStaggerEnabled", CONFIG_BOOL, &MountedAttackStaggerEnabled, 0.0f, 0.0f },
+		{ "MountedAttackStaggerChance", CONFIG_INT, &MountedAttackStaggerChance, 0.0f, 0.0f },
+		{ "MountedAttackStaggerForce", CONFIG_FLOAT, &MountedAttackStaggerForce, 0.0f, 0.0f },
+		// Damage Multipliers
+		{ "HostileRiderDamageMultiplier", CONFIG_FLOAT, &HostileRiderDamageMultiplier, 0.0f, 0.0f },
+		{ "CompanionRiderDamageMultiplier", CONFIG_FLOAT, &CompanionRiderDamageMultiplier, 0.0f, 0.0f },
+		// Weapon Reach
+		{ "TwoHandedReachBonus", CONFIG_FLOAT, &TwoHandedReachBonus, 0.0f, 0.0f },
+		// Combat Distance
+		{ "MaxCombatDistance", CONFIG_FLOAT, &MaxCombatDistance, 0.0f, 0.0f },
+		{ "MaxCompanionCombatDistance", CONFIG_FLOAT, &MaxCompanionCombatDistance, 0.0f, 0.0f },
+		{ "ReEngageDistance", CONFIG_FLOAT, &ReEngageDistance, 0.0f, 0.0f },
+		// Mage Spell Casting
+		{ "SpellOriginForwardOffset", CONFIG_FLOAT, &SpellOriginForwardOffset, 0.0f, 0.0f },
+		{ "SpellOriginRightOffset", CONFIG_FLOAT, &SpellOriginRightOffset, 0.0f, 0.0f },
+		{ "SpellOriginUpOffset", CONFIG_FLOAT, &SpellOriginUpOffset, 0.0f, 0.0f },
+		{ "SpellChargeMinTime", CONFIG_FLOAT, &SpellChargeMinTime, 0.0f, 0.0f },
+		{ "SpellChargeMaxTime", CONFIG_FLOAT, &SpellChargeMaxTime, 0.0f, 0.0f },
+		{ "SpellCooldownTime", CONFIG_FLOAT, &SpellCooldownTime, 0.0f, 0.0f },
+		{ "SpellRangeMin", CONFIG_FLOAT, &SpellRangeMin, 0.0f, 0.0f },
+		{ "SpellRangeMax", CONFIG_FLOAT, &SpellRangeMax, 0.0f, 0.0f },
+		{ "SpellTargetFootHeight", CONFIG_FLOAT, &SpellTargetFootHeight, 0.0f, 0.0f },
+		{ "SpellTargetMountedHeight", CONFIG_FLOAT, &SpellTargetMountedHeight, 0.0f, 0.0f },
+		// Hostile Detection
+		{ "HostileDetectionRange", CONFIG_FLOAT, &HostileDetectionRange, 0.0f, 0.0f },
+		{ "HostileScanInterval", CONFIG_FLOAT, &HostileScanInterval, 0.0f, 0.0f },
+		{ "MaxAttackersPerTarget", CONFIG_INT, &MaxAttackersPerTarget, 1.0f, 8.0f },
+		// Tracking Limits
+		{ "MaxTrackedMountedNPCs", CONFIG_INT, &MaxTrackedMountedNPCs, 1.0f, 10.0f },
+		// Companion Combat
+		{ "CompanionCombatEnabled", CONFIG_BOOL, &CompanionCombatEnabled, 0.0f, 0.0f },
+		{ "MaxTrackedCompanions", CONFIG_INT, &MaxTrackedCompanions, 1.0f, 5.0f },
+		{ "CompanionScanRange", CONFIG_FLOAT, &CompanionScanRange, 0.0f, 0.0f },
+		{ "CompanionScanInterval", CONFIG_FLOAT, &CompanionScanInterval, 0.0f, 0.0f },
+		{ "CompanionTargetRange", CONFIG_FLOAT, &CompanionTargetRange, 0.0f, 0.0f },
+		{ "CompanionEngageRange", CONFIG_FLOAT, &CompanionEngageRange, 0.0f, 0.0f },
+		{ "CompanionUpdateInterval", CONFIG_FLOAT, &CompanionUpdateInterval, 0.0f, 0.0f },
+		{ "CompanionMeleeRange", CONFIG_FLOAT, &CompanionMeleeRange, 0.0f, 0.0f },
+		// Profiler
+		{ "ProfilerReportInterval", CONFIG_FLOAT, &ProfilerReportInterval, 0.0f, 0.0f },
+		{ "ProfilerWriteCsv", CONFIG_BOOL, &ProfilerWriteCsv, 0.0f, 0.0f },
+		// Perf Counters
+		{ "PerfCounterCsvInterval", CONFIG_FLOAT, &PerfCounterCsvInterval, 0.0f, 0.0f },
+		// Combat Recorder
+		{ "RecorderEnabled", CONFIG_BOOL, &RecorderEnabled, 0.0f, 0.0f },
+		// Tracer
+		{ "TraceEnabled", CONFIG_BOOL, &TraceEnabled, 0.0f, 0.0f },
+		// Terrain
+		{ "TerrainHeightSampling", CONFIG_BOOL, &TerrainHeightSampling, 0.0f, 0.0f },
+		{ "HazardMapEnabled", CONFIG_BOOL, &HazardMapEnabled, 0.0f, 0.0f },
+	};
+
+	static const int CONFIG_FIELD_COUNT = (int)(sizeof(g_configFields) / sizeof(g_configFields[0]));
+	static_assert(sizeof(g_configFields) / sizeof(g_configFields[0]) <= CONFIG_MAX_FIELDS, "Raise CONFIG_MAX_FIELDS");
+
+	static std::unordered_map<std::string, int> BuildFieldIndex()
+	{
+		std::unordered_map<std::string, int> index;
+		index.reserve(CONFIG_FIELD_COUNT * 2);
+		for (int i = 0; i < CONFIG_FIELD_COUNT; i++)
 		{
-			_MESSAGE("loadConfig: Using defaults");
-			return;
+			index[g_configFields[i].name] = i;
 		}
-		
-		std::string filepath = runtimeDirectory + "Data\\SKSE\\Plugins\\Mounted_NPC_Combat_VR.ini";
-		std::ifstream file(filepath);
+		return index;
+	}
+
+	int FindConfigField(const char* name)
+	{
+		// Built once on first use (thread-safe static init)
+		static const std::unordered_map<std::string, int> index = BuildFieldIndex();
+
+		if (!name) return -1;
+		auto it = index.find(name);
+		return (it != index.end()) ? it->second : -1;
+	}
 
-		if (!file.is_open()) 
+	// ============================================
+	// SNAPSHOT <-> GLOBALS
+	// ============================================
+
+	static void CaptureGlobals(ConfigSnapshot& snapshot)
+	{
+		for (int i = 0; i < CONFIG_FIELD_COUNT; i++)
 		{
-			transform(filepath.begin(), filepath.end(), filepath.begin(), ::tolower);
-			file.open(filepath);
+			const ConfigField& field = g_configFields[i];
+			ConfigValue& value = snapshot.values[i];
+			switch (field.type)
+			{
+			case CONFIG_INT:   value.i = *(int*)field.target; break;
+			case CONFIG_FLOAT: value.f = *(float*)field.target; break;
+			case CONFIG_BOOL:  value.b = *(bool*)field.target; break;
+			case CONFIG_MASK:  value.u = *(uint32_t*)field.target; break;
+			}
 		}
 
-		if (!file.is_open()) 
+		for (int i = 0; i < MAX_COMPANION_NAMES; i++)
 		{
-			_MESSAGE("loadConfig: INI not found, using defaults");
-			return;
+			snapshot.companionNames[i] = CompanionNameList[i];
 		}
-		
+		snapshot.companionNameCount = CompanionNameCount;
+	}
+
+	static void ApplySnapshot(const ConfigSnapshot& snapshot)
+	{
+		for (int i = 0; i < CONFIG_FIELD_COUNT; i++)
+		{
+			const ConfigField& field = g_configFields[i];
+			const ConfigValue& value = snapshot.values[i];
+			switch (field.type)
+			{
+			case CONFIG_INT:   *(int*)field.target = value.i; break;
+			case CONFIG_FLOAT: *(float*)field.target = value.f; break;
+			case CONFIG_BOOL:  *(bool*)field.target = value.b; break;
+			case CONFIG_MASK:  *(uint32_t*)field.target = value.u; break;
+			}
+		}
+
+		for (int i = 0; i < MAX_COMPANION_NAMES; i++)
+		{
+			CompanionNameList[i] = snapshot.companionNames[i];
+		}
+		CompanionNameCount = snapshot.companionNameCount;
+	}
+
+	// ============================================
+	// PARSING (any thread)
+	// ============================================
+
+	static bool ParseFieldValue(const ConfigField& field, const std::string& text, ConfigValue& out)
+	{
+		bool clamp = (field.minValue < field.maxValue);
+
+		try
+		{
+			switch (field.type)
+			{
+			case CONFIG_INT:
+				out.i = std::stoi(text);
+				if (clamp && out.i < (int)field.minValue) out.i = (int)field.minValue;
+				if (clamp && out.i > (int)field.maxValue) out.i = (int)field.maxValue;
+				break;
+			case CONFIG_FLOAT:
+				out.f = std::stof(text);
+				if (clamp && out.f < field.minValue) out.f = field.minValue;
+				if (clamp && out.f > field.maxValue) out.f = field.maxValue;
+				break;
+			case CONFIG_BOOL:
+				out.b = (std::stoi(text) != 0);
+				break;
+			case CONFIG_MASK:
+				out.u = (uint32_t)std::stoul(text, nullptr, 0);  // Decimal or 0x...
+				break;
+			}
+		}
+		catch (...)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	// Parse the [Settings] section over 'snapshot' (keys not in the file
+	// keep their previous value). Returns the number of unparsable values.
+	static int ParseConfigStream(std::istream& file, ConfigSnapshot& snapshot)
+	{
 		std::string line;
 		std::string currentSection;
+		int badValues = 0;
 
 		while (std::getline(file, line)) 
 		{
@@ -295,128 +568,19 @@ namespace MountedNPCCombatVR {
 				std::string variableName;
 				std::string variableValueStr = GetConfigSettingsStringValue(line, variableName);
 
-				// General Settings
-				if (variableName == "Logging") logging = std::stoi(variableValueStr);
-				else if (variableName == "PreventNPCDismountOnAttack") PreventNPCDismountOnAttack = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "EnableRemounting") EnableRemounting = (std::stoi(variableValueStr) != 0);
-				// Combat Range
-				else if (variableName == "WeaponSwitchDistance") WeaponSwitchDistance = std::stof(variableValueStr);
-				else if (variableName == "WeaponSwitchDistanceMounted") WeaponSwitchDistanceMounted = std::stof(variableValueStr);
-				else if (variableName == "MeleeRangeOnFoot") MeleeRangeOnFoot = std::stof(variableValueStr);
-				else if (variableName == "MeleeRangeOnFootNPC") MeleeRangeOnFootNPC = std::stof(variableValueStr);
-				else if (variableName == "MeleeRangeMounted") MeleeRangeMounted = std::stof(variableValueStr);
-				// Weapon Switch
-				else if (variableName == "WeaponSwitchCooldown") WeaponSwitchCooldown = std::stof(variableValueStr);
-				else if (variableName == "SheatheTransitionTime") SheatheTransitionTime = std::stof(variableValueStr);
-				// Mount Rotation
-				else if (variableName == "HorseRotationSpeed") 
-				{
-					HorseRotationSpeed = std::stof(variableValueStr);
-					if (HorseRotationSpeed < 0.01f) HorseRotationSpeed = 0.01f;
-					if (HorseRotationSpeed > 1.0f) HorseRotationSpeed = 1.0f;
-				}
-				// Attack Angles
-				else if (variableName == "AttackAnglePlayer") AttackAnglePlayer = std::stof(variableValueStr);
-				else if (variableName == "AttackAngleNPC") AttackAngleNPC = std::stof(variableValueStr);
-				else if (variableName == "AttackAngleMounted") AttackAngleMounted = std::stof(variableValueStr);
-				// Charge
-				else if (variableName == "ChargeEnabled") ChargeEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "ChargeChancePercent") ChargeChancePercent = std::stoi(variableValueStr);
-				else if (variableName == "ChargeCooldown") ChargeCooldown = std::stof(variableValueStr);
-				else if (variableName == "ChargeMinDistance") ChargeMinDistance = std::stof(variableValueStr);
-				else if (variableName == "ChargeMaxDistance") ChargeMaxDistance = std::stof(variableValueStr);
-				// Rapid Fire
-				else if (variableName == "RapidFireEnabled") RapidFireEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "RapidFireChancePercent") RapidFireChancePercent = std::stoi(variableValueStr);
-				else if (variableName == "RapidFireCooldown") RapidFireCooldown = std::stof(variableValueStr);
-				else if (variableName == "RapidFireDuration") RapidFireDuration = std::stof(variableValueStr);
-				else if (variableName == "RapidFireShotCount") RapidFireShotCount = std::stoi(variableValueStr);
-				// Bow Attack
-				else if (variableName == "RangedAttacksEnabled") RangedAttacksEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "BowDrawMinTime") BowDrawMinTime = std::stof(variableValueStr);
-				else if (variableName == "BowDrawMaxTime") BowDrawMaxTime = std::stof(variableValueStr);
-				// Arrow Aim
-				else if (variableName == "ArrowShooterHeightOffset") ArrowShooterHeightOffset = std::stof(variableValueStr);
-				else if (variableName == "ArrowTargetFootHeight") ArrowTargetFootHeight = std::stof(variableValueStr);
-				else if (variableName == "ArrowTargetMountedHeight") ArrowTargetMountedHeight = std::stof(variableValueStr);
-				// Rear Up
-				else if (variableName == "RearUpEnabled") RearUpEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "RearUpApproachChance") RearUpApproachChance = std::stoi(variableValueStr);
-				else if (variableName == "RearUpDamageChance") RearUpDamageChance = std::stoi(variableValueStr);
-				else if (variableName == "RearUpCooldown") RearUpCooldown = std::stof(variableValueStr);
-				// Stand Ground
-				else if (variableName == "StandGroundEnabled") StandGroundEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "StandGroundMaxDistance") StandGroundMaxDistance = std::stof(variableValueStr);
-				else if (variableName == "StandGroundMinDuration") StandGroundMinDuration = std::stof(variableValueStr);
-				else if (variableName == "StandGroundMaxDuration") StandGroundMaxDuration = std::stof(variableValueStr);
-				else if (variableName == "StandGroundChancePercent") StandGroundChancePercent = std::stoi(variableValueStr);
-				else if (variableName == "StandGroundCheckInterval") StandGroundCheckInterval = std::stof(variableValueStr);
-				else if (variableName == "StandGroundCooldown") StandGroundCooldown = std::stof(variableValueStr);
-				// Special Rider Combat
-				else if (variableName == "RangedRoleMinDistance") RangedRoleMinDistance = std::stof(variableValueStr);
-				else if (variableName == "RangedRoleIdealDistance") RangedRoleIdealDistance = std::stof(variableValueStr);
-				else if (variableName == "RangedRoleMaxDistanceMin") RangedRoleMaxDistanceMin = std::stof(variableValueStr);
-				else if (variableName == "RangedRoleMaxDistanceMax") RangedRoleMaxDistanceMax = std::stof(variableValueStr);
-				else if (variableName == "RangedPositionTolerance") RangedPositionTolerance = std::stof(variableValueStr);
-				else if (variableName == "RangedFireMinDistance") RangedFireMinDistance = std::stof(variableValueStr);
-				else if (variableName == "RangedFireMaxDistance") RangedFireMaxDistance = std::stof(variableValueStr);
-				else if (variableName == "MageRoleMinDistance") MageRoleMinDistance = std::stof(variableValueStr);
-				else if (variableName == "MageRoleIdealDistance") MageRoleIdealDistance = std::stof(variableValueStr);
-				else if (variableName == "MageRoleMaxDistanceMin") MageRoleMaxDistanceMin = std::stof(variableValueStr);
-				else if (variableName == "MageRoleMaxDistanceMax") MageRoleMaxDistanceMax = std::stof(variableValueStr);
-				else if (variableName == "DynamicRangedRoleIdealDistance") DynamicRangedRoleIdealDistance = std::stof(variableValueStr);
-				else if (variableName == "DynamicRangedRoleMeleeThreshold") DynamicRangedRoleMeleeThreshold = std::stof(variableValueStr);
-				else if (variableName == "DynamicRangedRoleReturnThreshold") DynamicRangedRoleReturnThreshold = std::stof(variableValueStr);
-				else if (variableName == "DynamicRangedRoleModeSwitchCooldown") DynamicRangedRoleModeSwitchCooldown = std::stof(variableValueStr);
-				else if (variableName == "DynamicRangedRoleMinRiders") DynamicRangedRoleMinRiders = std::stoi(variableValueStr);
-				// Mounted Attack Stagger
-				else if (variableName == "MountedAttackStaggerEnabled") MountedAttackStaggerEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "MountedAttackStaggerChance") MountedAttackStaggerChance = std::stoi(variableValueStr);
-				else if (variableName == "MountedAttackStaggerForce") MountedAttackStaggerForce = std::stof(variableValueStr);
-				// Damage Multipliers
-				else if (variableName == "HostileRiderDamageMultiplier") HostileRiderDamageMultiplier = std::stof(variableValueStr);
-				else if (variableName == "CompanionRiderDamageMultiplier") CompanionRiderDamageMultiplier = std::stof(variableValueStr);
-				// Weapon Reach
-				else if (variableName == "TwoHandedReachBonus") TwoHandedReachBonus = std::stof(variableValueStr);
-				// Combat Distance
-				else if (variableName == "MaxCombatDistance") MaxCombatDistance = std::stof(variableValueStr);
-				else if (variableName == "MaxCompanionCombatDistance") MaxCompanionCombatDistance = std::stof(variableValueStr);
-				else if (variableName == "ReEngageDistance") ReEngageDistance = std::stof(variableValueStr);
-				// Mage Spell Casting
-				else if (variableName == "SpellOriginForwardOffset") SpellOriginForwardOffset = std::stof(variableValueStr);
-				else if (variableName == "SpellOriginRightOffset") SpellOriginRightOffset = std::stof(variableValueStr);
-				else if (variableName == "SpellOriginUpOffset") SpellOriginUpOffset = std::stof(variableValueStr);
-				else if (variableName == "SpellChargeMinTime") SpellChargeMinTime = std::stof(variableValueStr);
-				else if (variableName == "SpellChargeMaxTime") SpellChargeMaxTime = std::stof(variableValueStr);
-				else if (variableName == "SpellCooldownTime") SpellCooldownTime = std::stof(variableValueStr);
-				else if (variableName == "SpellRangeMin") SpellRangeMin = std::stof(variableValueStr);
-				else if (variableName == "SpellRangeMax") SpellRangeMax = std::stof(variableValueStr);
-				else if (variableName == "SpellTargetFootHeight") SpellTargetFootHeight = std::stof(variableValueStr);
-				else if (variableName == "SpellTargetMountedHeight") SpellTargetMountedHeight = std::stof(variableValueStr);
-				// Hostile Detection
-				else if (variableName == "HostileDetectionRange") HostileDetectionRange = std::stof(variableValueStr);
-				else if (variableName == "HostileScanInterval") HostileScanInterval = std::stof(variableValueStr);
-				// Tracking Limits
-				else if (variableName == "MaxTrackedMountedNPCs") 
-				{
-					MaxTrackedMountedNPCs = std::stoi(variableValueStr);
-					if (MaxTrackedMountedNPCs < 1) MaxTrackedMountedNPCs = 1;
-					if (MaxTrackedMountedNPCs > 10) MaxTrackedMountedNPCs = 10;
-				}
-				// Companion Combat
-				else if (variableName == "CompanionCombatEnabled") CompanionCombatEnabled = (std::stoi(variableValueStr) != 0);
-				else if (variableName == "MaxTrackedCompanions") 
+				int fieldIndex = FindConfigField(variableName.c_str());
+				if (fieldIndex >= 0)
 				{
-					MaxTrackedCompanions = std::stoi(variableValueStr);
-					if (MaxTrackedCompanions < 1) MaxTrackedCompanions = 1;
-					if (MaxTrackedCompanions > 5) MaxTrackedCompanions = 5;
+					ConfigValue value;
+					if (ParseFieldValue(g_configFields[fieldIndex], variableValueStr, value))
+					{
+						snapshot.values[fieldIndex] = value;
+					}
+					else
+					{
+						badValues++;
+					}
 				}
-				else if (variableName == "CompanionScanRange") CompanionScanRange = std::stof(variableValueStr);
-				else if (variableName == "CompanionScanInterval") CompanionScanInterval = std::stof(variableValueStr);
-				else if (variableName == "CompanionTargetRange") CompanionTargetRange = std::stof(variableValueStr);
-				else if (variableName == "CompanionEngageRange") CompanionEngageRange = std::stof(variableValueStr);
-				else if (variableName == "CompanionUpdateInterval") CompanionUpdateInterval = std::stof(variableValueStr);
-				else if (variableName == "CompanionMeleeRange") CompanionMeleeRange = std::stof(variableValueStr);
 				// Companion Names
 				else if (variableName.find("CompanionName") == 0 && variableName.length() > 13)
 				{
@@ -426,18 +590,285 @@ namespace MountedNPCCombatVR {
 						int index = std::stoi(indexStr) - 1;
 						if (index >= 0 && index < MAX_COMPANION_NAMES)
 						{
-							CompanionNameList[index] = ToLowerCase(variableValueStr);
-							if (index >= CompanionNameCount) CompanionNameCount = index + 1;
+							snapshot.companionNames[index] = ToLowerCase(variableValueStr);
+							if (index >= snapshot.companionNameCount) snapshot.companionNameCount = index + 1;
 						}
 					}
 				}
 			}
 		}
-	
-		file.close();
+
+		return badValues;
+	}
+
+	// ============================================
+	// PUBLICATION
+	// ============================================
+	// The published snapshot is a shared_ptr swapped under a mutex. Readers
+	// copy the pointer (one short lock) and keep the snapshot alive for as
+	// long as they hold it; the replaced snapshot is freed with its last
+	// reference. Snapshots are immutable once published.
+
+	static std::mutex g_publishMutex;
+	static std::shared_ptr<const ConfigSnapshot> g_publishedConfig;   // Guarded by g_publishMutex
+	static std::atomic<uint32_t> g_nextGeneration(1);
+
+	// Game thread only
+	static uint32_t g_appliedGeneration = 0;
+
+	static uint32_t TakeGeneration()
+	{
+		return g_nextGeneration.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Publish unless a newer load already did. Returns false if dropped.
+	static bool PublishSnapshot(std::shared_ptr<const ConfigSnapshot> snapshot)
+	{
+		std::lock_guard<std::mutex> lock(g_publishMutex);
+		if (g_publishedConfig && g_publishedConfig->generation >= snapshot->generation)
+		{
+			return false;
+		}
+		g_publishedConfig = std::move(snapshot);
+		return true;
+	}
+
+	std::shared_ptr<const ConfigSnapshot> GetConfigSnapshot()
+	{
+		std::lock_guard<std::mutex> lock(g_publishMutex);
+		return g_publishedConfig;
+	}
+
+	ConfigValue GetConfigSnapshotValue(int fieldIndex)
+	{
+		ConfigValue value;
+		value.u = 0;
+
+		std::shared_ptr<const ConfigSnapshot> snapshot = GetConfigSnapshot();
+		if (snapshot && fieldIndex >= 0 && fieldIndex < CONFIG_FIELD_COUNT)
+		{
+			value = snapshot->values[fieldIndex];
+		}
+		return value;
+	}
+
+	void ApplyPendingConfig()
+	{
+		std::shared_ptr<const ConfigSnapshot> snapshot = GetConfigSnapshot();
+		if (!snapshot || snapshot->generation == g_appliedGeneration) return;
+
+		ApplySnapshot(*snapshot);
+		g_appliedGeneration = snapshot->generation;
+		_MESSAGE("loadConfig: Applied settings (generation %u)", snapshot->generation);
+	}
+
+	// ============================================
+	// CHANGE DETECTION
+	// ============================================
+
+	// Resolve the INI path and read its size / last write time.
+	// Returns false if the file does not exist.
+	static bool GetConfigFileStamp(std::string& outPath, uint64_t& outSize, uint64_t& outWriteTime)
+	{
+		std::string runtimeDirectory = GetRuntimeDirectory();
+		if (runtimeDirectory.empty()) return false;
+
+		std::string filepath = runtimeDirectory + "Data\\SKSE\\Plugins\\Mounted_NPC_Combat_VR.ini";
+
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if (!GetFileAttributesExA(filepath.c_str(), GetFileExInfoStandard, &attributes))
+		{
+			transform(filepath.begin(), filepath.end(), filepath.begin(), ::tolower);
+			if (!GetFileAttributesExA(filepath.c_str(), GetFileExInfoStandard, &attributes))
+			{
+				return false;
+			}
+		}
+
+		outPath = filepath;
+		outSize = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+		outWriteTime = ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+		return true;
+	}
+
+	// True if the newest snapshot was parsed from a file with this stamp.
+	// Only successful parses publish, so a failed one is retried.
+	static bool IsPublishedStamp(uint64_t size, uint64_t writeTime)
+	{
+		std::shared_ptr<const ConfigSnapshot> snapshot = GetConfigSnapshot();
+		return snapshot && snapshot->hasFileStamp &&
+			snapshot->fileSize == size && snapshot->fileWriteTime == writeTime;
+	}
+
+	// Parse the file over a copy of the newest snapshot. nullptr if the
+	// file could not be opened.
+	static std::shared_ptr<ConfigSnapshot> ParseConfigFile(const std::string& filepath, uint32_t generation,
+		uint64_t fileSize, uint64_t fileWriteTime, int& outBadValues)
+	{
+		std::ifstream file(filepath);
+		if (!file.is_open()) return nullptr;
+
+		std::shared_ptr<const ConfigSnapshot> base = GetConfigSnapshot();
+		std::shared_ptr<ConfigSnapshot> snapshot = std::make_shared<ConfigSnapshot>(*base);
+		snapshot->generation = generation;
+		snapshot->hasFileStamp = true;
+		snapshot->fileSize = fileSize;
+		snapshot->fileWriteTime = fileWriteTime;
+
+		outBadValues = ParseConfigStream(file, *snapshot);
+		return snapshot;
+	}
+
+	// ============================================
+	// RELOAD WORKER
+	// ============================================
+	// One long-lived thread (started on the first request) parses
+	// background reloads. Requests replace each other: only the newest
+	// pending one is parsed.
+
+	struct ReloadRequest
+	{
+		std::string filepath;
+		uint64_t fileSize;
+		uint64_t fileWriteTime;
+		uint32_t generation;
+	};
+
+	static std::mutex g_reloadMutex;
+	static std::condition_variable g_reloadWake;
+	static ReloadRequest g_reloadRequest;          // Guarded by g_reloadMutex
+	static bool g_reloadPending = false;           // Guarded by g_reloadMutex
+	static bool g_reloadParsing = false;           // Guarded by g_reloadMutex (g_reloadRequest is being parsed)
+	static bool g_reloadWorkerStarted = false;     // Game thread only
+
+	static void ReloadWorker()
+	{
+		for (;;)
+		{
+			ReloadRequest request;
+			{
+				std::unique_lock<std::mutex> lock(g_reloadMutex);
+				g_reloadWake.wait(lock, [] { return g_reloadPending; });
+				request = g_reloadRequest;
+				g_reloadPending = false;
+				g_reloadParsing = true;
+			}
+
+			int badValues = 0;
+			std::shared_ptr<ConfigSnapshot> snapshot = ParseConfigFile(request.filepath, request.generation,
+				request.fileSize, request.fileWriteTime, badValues);
+
+			if (!snapshot)
+			{
+				ASYNC_MESSAGE("loadConfig: INI could not be opened - keeping current settings");
+			}
+			else if (!PublishSnapshot(snapshot))
+			{
+				ASYNC_MESSAGE("loadConfig: Background reload (generation %u) superseded - dropped", request.generation);
+			}
+			else
+			{
+				ASYNC_MESSAGE("loadConfig: INI reloaded in background (generation %u, %d bad values)", request.generation, badValues);
+			}
+
+			std::lock_guard<std::mutex> lock(g_reloadMutex);
+			g_reloadParsing = false;
+		}
+	}
+
+	// ============================================
+	// LOADING
+	// ============================================
+
+	void loadConfig() 
+	{
+		// First call: the compiled defaults become the first snapshot
+		if (!GetConfigSnapshot())
+		{
+			std::shared_ptr<ConfigSnapshot> defaults = std::make_shared<ConfigSnapshot>();
+			CaptureGlobals(*defaults);
+			defaults->generation = TakeGeneration();
+			defaults->hasFileStamp = false;
+			PublishSnapshot(defaults);
+			g_appliedGeneration = defaults->generation;
+		}
+
+		std::string filepath;
+		uint64_t fileSize = 0;
+		uint64_t fileWriteTime = 0;
+		if (!GetConfigFileStamp(filepath, fileSize, fileWriteTime))
+		{
+			_MESSAGE("loadConfig: INI not found, using defaults");
+			return;
+		}
+
+		if (IsPublishedStamp(fileSize, fileWriteTime))
+		{
+			_MESSAGE("loadConfig: INI unchanged - keeping current settings");
+			ApplyPendingConfig();
+			return;
+		}
+
+		int badValues = 0;
+		std::shared_ptr<ConfigSnapshot> snapshot = ParseConfigFile(filepath, TakeGeneration(),
+			fileSize, fileWriteTime, badValues);
+		if (!snapshot)
+		{
+			_MESSAGE("loadConfig: INI not found, using defaults");
+			return;
+		}
+
+		PublishSnapshot(snapshot);
+		ApplyPendingConfig();
+
+		if (badValues > 0)
+		{
+			_MESSAGE("loadConfig: %d INI values could not be parsed (kept previous values)", badValues);
+		}
 		_MESSAGE("loadConfig: INI loaded successfully");
 	}
 
+	void RequestConfigReload()
+	{
+		// Nothing published yet - do the full synchronous load
+		if (!GetConfigSnapshot())
+		{
+			loadConfig();
+			return;
+		}
+
+		std::string filepath;
+		uint64_t fileSize = 0;
+		uint64_t fileWriteTime = 0;
+		if (!GetConfigFileStamp(filepath, fileSize, fileWriteTime)) return;
+		if (IsPublishedStamp(fileSize, fileWriteTime)) return;
+
+		{
+			std::lock_guard<std::mutex> lock(g_reloadMutex);
+
+			// Same file already queued or being parsed
+			if ((g_reloadPending || g_reloadParsing) &&
+				g_reloadRequest.fileSize == fileSize && g_reloadRequest.fileWriteTime == fileWriteTime)
+			{
+				return;
+			}
+
+			g_reloadRequest.filepath = filepath;
+			g_reloadRequest.fileSize = fileSize;
+			g_reloadRequest.fileWriteTime = fileWriteTime;
+			g_reloadRequest.generation = TakeGeneration();
+			g_reloadPending = true;
+		}
+		g_reloadWake.notify_one();
+
+		if (!g_reloadWorkerStarted)
+		{
+			g_reloadWorkerStarted = true;
+			std::thread(ReloadWorker).detach();
+		}
+		_MESSAGE("loadConfig: INI changed - reloading in background");
+	}
+
 	void Log(const int msgLogLevel, const char* fmt, ...)
 	{
 		if (msgLogLevel > logging) return;
@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include <memory>
 #include <skse64/NiProperties.h>
 #include <skse64/NiNodes.h>
 
@@ -24,6 +25,10 @@ namespace MountedNPCCombatVR {
 
 	extern int logging;
 	
+	// Per-subsystem verbosity mask for rate-limited log sites (LOGSYS_* bits in LogRateLimit.h)
+	// Accepts decimal or hex (0x...) in the INI - default: all subsystems
+	extern uint32_t LogSubsystemMask;
+	
 	// ============================================
 	// GENERAL SETTINGS
 	// ============================================
@@ -270,6 +275,9 @@ namespace MountedNPCCombatVR {
 	// How often to scan for hostiles (seconds)
 	extern float HostileScanInterval;
 	
+	// Guards/soldiers assigned to one hostile before others are spread to other hostiles (1-8)
+	extern int MaxAttackersPerTarget;
+	
 	// ============================================
 	// TRACKING LIMITS
 	// ============================================
@@ -324,7 +332,83 @@ namespace MountedNPCCombatVR {
 	// Check if an actor's name matches any in the companion list
 	bool IsInCompanionNameList(const char* actorName);
 
+	// ============================================
+	// CONFIG LOADING / HOT RELOAD
+	// ============================================
+	// Closing a menu used to re-read and re-parse the whole INI on the
+	// game thread (a long if/else chain per key), even when the file had
+	// not changed, and wrote the globals while other threads read them.
+	//
+	// Every [Settings] key now has a descriptor (name, type, target global,
+	// clamp) found through a hash table. A reload first compares the INI's
+	// size and last write time with the newest published snapshot and
+	// skips if neither changed. Otherwise the single reload worker parses
+	// the file into a new ConfigSnapshot and publishes it. The file stamp
+	// is part of the snapshot, so a failed parse is retried next time.
+	//
+	// Every load takes a generation number when it is requested. A
+	// snapshot is only published if its generation is newer than the
+	// published one, so a slow background parse can never overwrite a
+	// later synchronous loadConfig.
+	//
+	// The globals are copied from the newest snapshot in one place on the
+	// game thread (ApplyPendingConfig at the start of the frame), so a tick
+	// never sees half-updated values. Code that can run off the game thread
+	// must read the snapshot (GetConfigSnapshot / GetConfigSnapshotValue),
+	// never the globals. Snapshots are reference counted: a replaced one
+	// is freed when its last reader lets go.
+	// ============================================
+
+	const int CONFIG_MAX_FIELDS = 128;
+
+	enum ConfigFieldType : uint8_t
+	{
+		CONFIG_INT,
+		CONFIG_FLOAT,
+		CONFIG_BOOL,
+		CONFIG_MASK      // uint32, decimal or 0x... in the INI
+	};
+
+	union ConfigValue
+	{
+		int i;
+		float f;
+		bool b;
+		uint32_t u;
+	};
+
+	struct ConfigSnapshot
+	{
+		uint32_t generation;                     // Taken when the load was requested
+		bool hasFileStamp;                       // False for the compiled defaults
+		uint64_t fileSize;                       // INI stamp this snapshot was parsed from
+		uint64_t fileWriteTime;
+		ConfigValue values[CONFIG_MAX_FIELDS];   // Indexed by FindConfigField
+		std::string companionNames[MAX_COMPANION_NAMES];
+		int companionNameCount;
+	};
+
+	// Synchronous load (data loaded, game load, new game). Skips the parse
+	// if the INI has not changed since the last load.
 	void loadConfig();
+
+	// Menu closed: re-parse on the reload worker if the INI changed
+	void RequestConfigReload();
+
+	// Copy the newest published snapshot into the globals (GAME THREAD ONLY,
+	// start of the frame or while the mod is inactive)
+	void ApplyPendingConfig();
+
+	// Newest published snapshot (empty before the first loadConfig). Any
+	// thread; the snapshot stays valid while the returned pointer is held.
+	std::shared_ptr<const ConfigSnapshot> GetConfigSnapshot();
+
+	// Index of an INI key in ConfigSnapshot::values (-1 if unknown)
+	int FindConfigField(const char* name);
+
+	// One value from the newest snapshot (any thread). Zero if the field
+	// is unknown or nothing is published yet. Cache the field index.
+	ConfigValue GetConfigSnapshotValue(int fieldIndex);
 	
 	void Log(const int msgLogLevel, const char* fmt, ...);
 	enum eLogLevels
@@ -403,4 +487,43 @@ namespace MountedNPCCombatVR {
 	// Spell Target Height Offsets
 	extern float SpellTargetFootHeight;     // Target height offset when on foot
 	extern float SpellTargetMountedHeight;  // Target height offset when mounted
+
+	// ============================================
+	// PROFILER SETTINGS
+	// ============================================
+	// Only used when built with MOUNTED_COMBAT_PROFILER (see Profiler.h)
+
+	extern float ProfilerReportInterval;    // Seconds between profiler summaries (0 = disabled)
+	extern bool ProfilerWriteCsv;           // Also append summaries to Mounted_NPC_Combat_VR_profile.csv
+
+	// ============================================
+	// PERF COUNTER SETTINGS
+	// ============================================
+	// Always compiled in (see PerfCounters.h)
+
+	extern float PerfCounterCsvInterval;    // Seconds between rows in Mounted_NPC_Combat_VR_counters.csv (0 = off)
+
+	// ============================================
+	// COMBAT RECORDER SETTINGS
+	// ============================================
+	// Binary per-tick capture of the rider loop (see CombatRecorder.h)
+
+	extern bool RecorderEnabled;            // Write Mounted_NPC_Combat_VR_capture_<time>.bin each session
+
+	// ============================================
+	// TRACER SETTINGS
+	// ============================================
+	// Per-frame span export (see Tracer.h)
+
+	extern bool TraceEnabled;               // Write Mounted_NPC_Combat_VR_trace_<time>.json each session
+
+	// ============================================
+	// TERRAIN SETTINGS
+	// ============================================
+	// Ground heights for sheer-drop detection (see GroundHeight.h).
+	// TerrainHeightSampling is EXPERIMENTAL and off by default: it reads
+	// land through SE offsets that have not been verified on VR.
+
+	extern bool TerrainHeightSampling;      // Experimental, default 0. Off: sheer-drop checks only use edges already in the hazard map
+	extern bool HazardMapEnabled;           // Learn/persist stuck spots and drop edges (see HazardMap.h)
 }
\ No newline at end of file
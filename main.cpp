@@ -8,6 +8,8 @@
 #include "Helper.h"
 #include "SpecialDismount.h"
 #include "HorseMountScanner.h"
+#include "AsyncLogger.h"
+#include "PerfCounters.h"
 #include "skse64/GameMenus.h"  // For MenuOpenCloseEvent
 
 #include "skse64_common/BranchTrampoline.h"
@@ -45,9 +47,12 @@ namespace MountedNPCCombatVR
 	public:
 		virtual EventResult ReceiveEvent(MenuOpenCloseEvent* evn, EventDispatcher<MenuOpenCloseEvent>* dispatcher) override
 		{
+			// A finished background reload is applied by the next frame
+			// (ApplyPendingConfig), never from here: menu events can arrive
+			// in the middle of a frame.
 			if (evn && !evn->opening)
 			{
-				// Menu is closing - hot-reload config
+				// Menu is closing - hot-reload config if the INI changed
 				// Only reload for major menus (not every tooltip, etc.)
 				const char* menuName = evn->menuName.data;
 				if (menuName)
@@ -64,8 +69,7 @@ namespace MountedNPCCombatVR
 						strcmp(menuName, "Main Menu") == 0 ||
 						strcmp(menuName, "Loading Menu") == 0)
 					{
-						_MESSAGE("MenuOpenCloseHandler: '%s' closed - hot-reloading config", menuName);
-						loadConfig();
+						RequestConfigReload();
 					}
 				}
 			}
@@ -322,9 +326,17 @@ namespace MountedNPCCombatVR
 
 		bool SKSEPlugin_Load(const SKSEInterface* skse) {	// Called by SKSE to load this plugin
 
+			// Start the background log writer (gLog was opened in SKSEPlugin_Query)
+			AsyncLog::StartAsyncLogger();
+
 			g_task = (SKSETaskInterface*)skse->QueryInterface(kInterface_Task);
 
 			g_papyrus = (SKSEPapyrusInterface*)skse->QueryInterface(kInterface_Papyrus);
+			if (g_papyrus)
+			{
+				// MountedNPCCombatVR.DumpPerfCounters (see MountedNPCCombatVR.psc)
+				g_papyrus->Register(PerfCounters::RegisterPapyrusFunctions);
+			}
 
 			g_messaging = (SKSEMessagingInterface*)skse->QueryInterface(kInterface_Messaging);
 			g_messaging->RegisterListener(g_pluginHandle, "SKSE", OnSKSEMessage);
@@ -0,0 +1,326 @@
+// ============================================
+// COMBAT RECORDER REPLAY (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/CombatReplay.cpp CombatDecisions.cpp -o combat_replay
+//     ./combat_replay Mounted_NPC_Combat_VR_capture_<stamp>.bin
+//     ./combat_replay --self-test
+//
+// Reads a capture written by CombatRecorder (RecorderEnabled=1) and
+// feeds every recorded frame back through DecideRiderStates, the same
+// batch the rider loop's decide phase runs. Reports:
+// - frames, rider records and frames the recorder dropped
+// - decide cost per frame (mean / max)
+// - divergence: riders whose replayed decision differs from the
+//   recorded decidedState (first few are listed)
+// - the engine-side inputs captured with the records (path checks,
+//   obstruction types and responses, terrain / sheer drop results)
+//
+// Riders skipped for fleeing have no decide-phase input and are not
+// replayed. --self-test builds a synthetic stream in memory, checks it
+// replays with no divergence, then corrupts one decision and checks
+// that exactly one divergence is reported.
+// ============================================
+
+#include "CombatRecorder.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace MountedNPCCombatVR;
+using namespace MountedNPCCombatVR::CombatRecorder;
+
+// MountedCombatClass values (MountedCombat.h) that have no combat style
+static const uint8_t COMBAT_CLASS_NONE = 0;
+static const uint8_t COMBAT_CLASS_CIVILIAN_FLEE = 5;
+
+static const int OBSTRUCTION_TYPE_COUNT = 5;    // ObstructionType (AILogging.h)
+static const char* OBSTRUCTION_NAMES[OBSTRUCTION_TYPE_COUNT] = {
+	"None", "Stationary", "RunningInPlace", "CollisionBlocked", "PathfindingFailed"
+};
+static const int MAX_LISTED_DIVERGENCES = 10;
+
+struct ReplayReport
+{
+	uint64_t frames;
+	uint64_t riderRecords;
+	uint64_t replayedRiders;
+	uint64_t droppedFrames;
+	uint64_t divergences;
+	double decideNsTotal;
+	double decideNsMax;
+	uint64_t pathChecks[3];
+	uint64_t obstructions[OBSTRUCTION_TYPE_COUNT];
+	uint64_t inputFlagCounts[8];
+	bool truncated;
+};
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static RiderSnapshot SnapshotFromRecord(const RecorderRiderRecord& record)
+{
+	RiderSnapshot snapshot;
+	snapshot.riderX = record.riderPos[0];
+	snapshot.riderY = record.riderPos[1];
+	snapshot.riderZ = record.riderPos[2];
+	snapshot.hasTarget = (record.flags & RECORDER_FLAG_HAS_TARGET) != 0;
+	snapshot.targetX = record.targetPos[0];
+	snapshot.targetY = record.targetPos[1];
+	snapshot.targetZ = record.targetPos[2];
+	snapshot.hasBow = (record.flags & RECORDER_FLAG_IS_BOW) || (record.inputFlags & RECORDER_INPUT_HAS_BOW_INVENTORY);
+	snapshot.usesStyleRules = (record.combatClass != COMBAT_CLASS_NONE && record.combatClass != COMBAT_CLASS_CIVILIAN_FLEE);
+	return snapshot;
+}
+
+// Replay a whole capture held in memory. Returns false if the header is
+// not a capture this build understands.
+static bool ReplayStream(const uint8_t* data, size_t size, ReplayReport& report, bool listDivergences)
+{
+	std::memset(&report, 0, sizeof(report));
+
+	if (size < sizeof(RecorderFileHeader)) return false;
+	RecorderFileHeader fileHeader;
+	std::memcpy(&fileHeader, data, sizeof(fileHeader));
+	if (fileHeader.magic != RECORDER_MAGIC || fileHeader.version != RECORDER_VERSION ||
+		fileHeader.frameHeaderSize != sizeof(RecorderFrameHeader) || fileHeader.riderRecordSize != sizeof(RecorderRiderRecord))
+	{
+		return false;
+	}
+
+	std::vector<RecorderRiderRecord> records;
+	std::vector<RiderSnapshot> snapshots;
+	std::vector<RiderDecision> decisions;
+	std::vector<int> recordIndex;
+
+	size_t offset = sizeof(RecorderFileHeader);
+	while (offset + sizeof(RecorderFrameHeader) <= size)
+	{
+		RecorderFrameHeader frame;
+		std::memcpy(&frame, data + offset, sizeof(frame));
+		offset += sizeof(frame);
+
+		size_t frameBytes = (size_t)frame.riderCount * sizeof(RecorderRiderRecord);
+		if (frame.riderCount > RECORDER_MAX_RIDERS_PER_FRAME || offset + frameBytes > size)
+		{
+			report.truncated = true;
+			break;
+		}
+
+		records.resize(frame.riderCount);
+		std::memcpy(records.data(), data + offset, frameBytes);
+		offset += frameBytes;
+
+		report.frames++;
+		report.riderRecords += frame.riderCount;
+		report.droppedFrames += frame.droppedFramesBefore;
+
+		// Same batch the decide phase saw: riders that reached their style
+		snapshots.clear();
+		recordIndex.clear();
+		for (uint32_t r = 0; r < frame.riderCount; r++)
+		{
+			const RecorderRiderRecord& record = records[r];
+
+			if (record.pathCheck < 3) report.pathChecks[record.pathCheck]++;
+			if (record.obstruction < OBSTRUCTION_TYPE_COUNT) report.obstructions[record.obstruction]++;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				if (record.inputFlags & (1 << bit)) report.inputFlagCounts[bit]++;
+			}
+
+			if (record.flags & (RECORDER_FLAG_FLEEING | RECORDER_FLAG_FLEE_TRIGGERED)) continue;
+			snapshots.push_back(SnapshotFromRecord(record));
+			recordIndex.push_back((int)r);
+		}
+
+		decisions.resize(snapshots.size());
+		double start = NowNs();
+		DecideRiderStates(snapshots.data(), (int)snapshots.size(), decisions.data());
+		double elapsed = NowNs() - start;
+		report.decideNsTotal += elapsed;
+		if (elapsed > report.decideNsMax) report.decideNsMax = elapsed;
+		report.replayedRiders += snapshots.size();
+
+		for (size_t i = 0; i < snapshots.size(); i++)
+		{
+			const RecorderRiderRecord& record = records[recordIndex[i]];
+			if ((uint8_t)decisions[i].state == record.decidedState) continue;
+
+			if (listDivergences && report.divergences < MAX_LISTED_DIVERGENCES)
+			{
+				std::printf("  divergence: frame %u t=%.2f rider %08X recorded %u replayed %u (distance %.1f)\n",
+					frame.frameIndex, frame.gameTime, record.riderFormID, record.decidedState,
+					(unsigned)decisions[i].state, decisions[i].distanceToTarget);
+			}
+			report.divergences++;
+		}
+	}
+
+	if (offset != size) report.truncated = true;
+	return true;
+}
+
+static void PrintReport(const ReplayReport& report)
+{
+	std::printf("frames:            %llu (%llu dropped by recorder)%s\n", (unsigned long long)report.frames,
+		(unsigned long long)report.droppedFrames, report.truncated ? " - stream truncated" : "");
+	std::printf("rider records:     %llu (%llu replayed)\n", (unsigned long long)report.riderRecords,
+		(unsigned long long)report.replayedRiders);
+	std::printf("decide ns/frame:   mean %.0f, max %.0f\n",
+		report.frames ? report.decideNsTotal / (double)report.frames : 0.0, report.decideNsMax);
+	std::printf("divergences:       %llu\n", (unsigned long long)report.divergences);
+	std::printf("path checks:       %llu clear, %llu blocked, %llu not checked\n",
+		(unsigned long long)report.pathChecks[RECORDER_PATH_CLEAR], (unsigned long long)report.pathChecks[RECORDER_PATH_BLOCKED],
+		(unsigned long long)report.pathChecks[RECORDER_PATH_NOT_CHECKED]);
+	std::printf("obstructions:     ");
+	for (int i = 0; i < OBSTRUCTION_TYPE_COUNT; i++)
+	{
+		std::printf(" %s %llu", OBSTRUCTION_NAMES[i], (unsigned long long)report.obstructions[i]);
+	}
+	std::printf("\n");
+	std::printf("responses:         %llu blocked by actor, %llu steered, %llu jumped\n",
+		(unsigned long long)report.inputFlagCounts[4], (unsigned long long)report.inputFlagCounts[5],
+		(unsigned long long)report.inputFlagCounts[6]);
+	std::printf("terrain:           %llu checks, %llu with usable terrain, %llu near sheer drop\n",
+		(unsigned long long)report.inputFlagCounts[1], (unsigned long long)report.inputFlagCounts[2],
+		(unsigned long long)report.inputFlagCounts[3]);
+}
+
+// ============================================
+// SELF TEST
+// ============================================
+
+static void AppendBytes(std::vector<uint8_t>& out, const void* data, size_t size)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	out.insert(out.end(), bytes, bytes + size);
+}
+
+static std::vector<uint8_t> BuildSyntheticStream(size_t& outCorruptOffset)
+{
+	std::vector<uint8_t> stream;
+	std::mt19937 rng(2024);
+	std::uniform_real_distribution<float> coord(-3000.0f, 3000.0f);
+
+	RecorderFileHeader fileHeader = { RECORDER_MAGIC, RECORDER_VERSION, sizeof(RecorderFrameHeader), sizeof(RecorderRiderRecord) };
+	AppendBytes(stream, &fileHeader, sizeof(fileHeader));
+
+	outCorruptOffset = 0;
+	for (uint32_t frameIndex = 1; frameIndex <= 500; frameIndex++)
+	{
+		uint32_t riderCount = 1 + rng() % 10;
+		RecorderFrameHeader frame = { frameIndex, frameIndex * 0.011f, riderCount, 0 };
+		AppendBytes(stream, &frame, sizeof(frame));
+
+		for (uint32_t r = 0; r < riderCount; r++)
+		{
+			RecorderRiderRecord record = {};
+			record.riderFormID = 0xFF000100u + r;
+			record.mountFormID = 0xFF000200u + r;
+			record.targetFormID = 0x00000014u;
+			for (int k = 0; k < 3; k++)
+			{
+				record.riderPos[k] = coord(rng);
+				record.targetPos[k] = record.riderPos[k] + coord(rng) * 0.5f;
+			}
+			record.combatClass = (uint8_t)(rng() % 7);
+			record.flags = RECORDER_FLAG_HAS_TARGET | ((rng() & 1) ? RECORDER_FLAG_IS_BOW : 0);
+			if (rng() % 20 == 0) record.flags |= RECORDER_FLAG_FLEEING;
+			record.pathCheck = (uint8_t)(rng() % 3);
+			record.obstruction = (uint8_t)(rng() % OBSTRUCTION_TYPE_COUNT);
+			record.inputFlags = (uint8_t)(rng() & 0x7F);
+
+			if (!(record.flags & RECORDER_FLAG_FLEEING))
+			{
+				RiderSnapshot snapshot = SnapshotFromRecord(record);
+				RiderDecision decision;
+				DecideRiderStates(&snapshot, 1, &decision);
+				record.decidedState = (uint8_t)decision.state;
+				if (!outCorruptOffset && frameIndex == 250)
+				{
+					outCorruptOffset = stream.size() + offsetof(RecorderRiderRecord, decidedState);
+				}
+			}
+			AppendBytes(stream, &record, sizeof(record));
+		}
+	}
+	return stream;
+}
+
+static int RunSelfTest()
+{
+	int failures = 0;
+	size_t corruptOffset = 0;
+	std::vector<uint8_t> stream = BuildSyntheticStream(corruptOffset);
+
+	ReplayReport report;
+	if (!ReplayStream(stream.data(), stream.size(), report, true) || report.truncated || report.divergences != 0 ||
+		report.frames != 500)
+	{
+		std::printf("FAIL: clean synthetic stream did not replay cleanly\n");
+		failures++;
+	}
+
+	stream[corruptOffset] = (uint8_t)(stream[corruptOffset] + 1);
+	if (!ReplayStream(stream.data(), stream.size(), report, true) || report.divergences != 1)
+	{
+		std::printf("FAIL: corrupted decision not reported exactly once (%llu)\n", (unsigned long long)report.divergences);
+		failures++;
+	}
+
+	stream.resize(stream.size() - 10);
+	if (!ReplayStream(stream.data(), stream.size(), report, false) || !report.truncated)
+	{
+		std::printf("FAIL: truncated stream not reported\n");
+		failures++;
+	}
+
+	std::printf("CombatReplay self-test: %s\n", failures ? "FAILED" : "all checks passed");
+	return failures ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::printf("usage: %s <capture.bin> | --self-test\n", argv[0]);
+		return 2;
+	}
+
+	if (std::strcmp(argv[1], "--self-test") == 0)
+	{
+		return RunSelfTest();
+	}
+
+	FILE* file = std::fopen(argv[1], "rb");
+	if (!file)
+	{
+		std::printf("cannot open %s\n", argv[1]);
+		return 2;
+	}
+	std::vector<uint8_t> data;
+	uint8_t chunk[65536];
+	size_t read;
+	while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+	{
+		data.insert(data.end(), chunk, chunk + read);
+	}
+	std::fclose(file);
+
+	ReplayReport report;
+	if (!ReplayStream(data.data(), data.size(), report, true))
+	{
+		std::printf("%s is not a version %u capture\n", argv[1], RECORDER_VERSION);
+		return 2;
+	}
+
+	PrintReport(report);
+	return report.divergences ? 1 : 0;
+}
@@ -0,0 +1,408 @@
+// ============================================
+// HEADLESS COMBAT SIMULATION + SCALING BENCHMARK (Linux / any host)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/CombatSimBench.cpp CombatDecisions.cpp -o combat_sim_bench
+//     ./combat_sim_bench
+//
+// Drives N mounted riders (1..200) against scripted targets, using the
+// game stand-ins in tests/stubs/SimGame.h. Every decision is made by
+// the shipped code in CombatDecisions.cpp; the harness only does what
+// the engine does in the game (lookups, package AI, movement). Each
+// tick runs the same three phases as UpdateMountedCombat:
+// 1. Gather: look up rider, mount and target by formID, skip dead or
+//    dismounted riders, fill one RiderSnapshot per rider.
+// 2. Decide: DecideRiderStates over the batch.
+// 3. Apply: the combat style step (first tick draws the weapon, then
+//    ApplyDecidedState), then the per-rider decisions other systems
+//    make with the same inputs:
+//    - DecideRangedFollowSwitch (DynamicPackages ranged follow)
+//    - DecideWeaponForDistance (WeaponDetection weapon switching)
+//    Horses then move toward, around or away from their target; that
+//    part stands in for the follow packages and vanilla AI.
+//
+// MountedCombat.cpp / CombatStyles.cpp themselves call straight into
+// SKSE (packages, animation graphs, PapyrusVM) and are not compiled
+// here. The decisions they route through are, so a change to those
+// shows up in these numbers.
+//
+// Reports per-tick cost, cost per rider and heap allocations per tick
+// (global operator new is counted), then re-runs one scenario to
+// confirm the simulation is deterministic.
+// ============================================
+
+#include "CombatDecisions.h"
+#include "SimGame.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace MountedNPCCombatVR;
+
+// ============================================
+// ALLOCATION COUNTING
+// ============================================
+
+static std::atomic<uint64_t> g_allocations(0);
+
+void* operator new(size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	void* memory = std::malloc(size ? size : 1);
+	if (!memory) throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+// ============================================
+// SIMULATION
+// ============================================
+
+static const int MAX_SIM_RIDERS = 200;
+static const int TICKS_PER_RUN = 2000;
+static const float TICK_SECONDS = 1.0f / 90.0f;     // VR frame
+static const float WEAPON_SWITCH_DISTANCE = 250.0f; // config.cpp WeaponSwitchDistance
+static const float HORSE_SPEED = 450.0f;
+static const float TARGET_SPEED = 180.0f;
+
+struct SimRider
+{
+	UInt32 actorFormID;
+	UInt32 mountFormID;
+	UInt32 targetFormID;
+	MountedCombatState state;
+	float stateStartTime;
+	bool weaponDrawn;
+	bool inRangedMode;
+	float lastRangedSwitchTime;
+	bool usesStyleRules;
+};
+
+struct SimTarget
+{
+	UInt32 formID;
+	float centerX, centerY;
+	float radius;
+	float phase;
+};
+
+static SimRider g_riders[MAX_SIM_RIDERS];
+static int g_riderCount = 0;
+static SimTarget g_targets[MAX_SIM_RIDERS];
+static int g_targetCount = 0;
+
+// Fixed-size per-tick buffers, as in MountedCombat.cpp
+static Actor* g_pendingActors[MAX_SIM_RIDERS];
+static Actor* g_pendingMounts[MAX_SIM_RIDERS];
+static Actor* g_pendingTargets[MAX_SIM_RIDERS];
+static int g_pendingRiderIndex[MAX_SIM_RIDERS];
+static RiderSnapshot g_snapshots[MAX_SIM_RIDERS];
+static RiderDecision g_decisions[MAX_SIM_RIDERS];
+
+// Deterministic LCG so runs are repeatable on every host
+static uint32_t g_seed = 1;
+
+static float NextRandom()
+{
+	g_seed = g_seed * 1664525u + 1013904223u;
+	return (float)(g_seed >> 8) / 16777216.0f;
+}
+
+static void SetupScenario(int riderCount, uint32_t seed)
+{
+	SimWorld::Reset();
+	g_seed = seed;
+	g_riderCount = riderCount;
+	g_targetCount = std::max(1, riderCount / 4);
+
+	// Targets walk scripted circles around spread-out centres
+	for (int t = 0; t < g_targetCount; t++)
+	{
+		SimTarget& target = g_targets[t];
+		target.centerX = (NextRandom() - 0.5f) * 20000.0f;
+		target.centerY = (NextRandom() - 0.5f) * 20000.0f;
+		target.radius = 200.0f + NextRandom() * 800.0f;
+		target.phase = NextRandom() * 6.2831853f;
+		Actor* actor = SimWorld::Spawn(target.centerX + target.radius, target.centerY, 0.0f);
+		actor->inCombat = true;
+		target.formID = actor->formID;
+	}
+
+	for (int i = 0; i < riderCount; i++)
+	{
+		const SimTarget& target = g_targets[i % g_targetCount];
+		float angle = NextRandom() * 6.2831853f;
+		float distance = 300.0f + NextRandom() * 2500.0f;
+		float x = target.centerX + std::cos(angle) * distance;
+		float y = target.centerY + std::sin(angle) * distance;
+
+		Actor* horse = SimWorld::Spawn(x, y, 0.0f);
+		horse->speed = HORSE_SPEED * (0.8f + NextRandom() * 0.4f);
+		Actor* rider = SimWorld::Spawn(x, y, 120.0f);
+		rider->mount = horse;
+		rider->inCombat = true;
+		rider->combatTarget = LookupActorByID(target.formID);
+		rider->hasBowInInventory = (NextRandom() < 0.5f);
+		rider->weaponReach = 180.0f + NextRandom() * 100.0f;
+
+		SimRider& sim = g_riders[i];
+		sim.actorFormID = rider->formID;
+		sim.mountFormID = horse->formID;
+		sim.targetFormID = target.formID;
+		sim.state = MountedCombatState::Engaging;
+		sim.stateStartTime = 0.0f;
+		sim.weaponDrawn = false;
+		sim.inRangedMode = rider->hasBowInInventory;
+		sim.lastRangedSwitchTime = -100.0f;
+		sim.usesStyleRules = (i % 10) != 9;     // Every tenth rider is a civilian (no style)
+	}
+}
+
+static void MoveTargets(float gameTime)
+{
+	for (int t = 0; t < g_targetCount; t++)
+	{
+		SimTarget& target = g_targets[t];
+		Actor* actor = LookupActorByID(target.formID);
+		float angle = target.phase + gameTime * (TARGET_SPEED / target.radius);
+		actor->pos.x = target.centerX + std::cos(angle) * target.radius;
+		actor->pos.y = target.centerY + std::sin(angle) * target.radius;
+	}
+}
+
+static void MoveHorse(Actor* horse, float dirX, float dirY, float speedScale)
+{
+	horse->pos.x += dirX * horse->speed * speedScale * TICK_SECONDS;
+	horse->pos.y += dirY * horse->speed * speedScale * TICK_SECONDS;
+	if (dirX != 0.0f || dirY != 0.0f)
+	{
+		horse->rot.z = std::atan2(dirX, dirY);
+	}
+}
+
+static void SimTick()
+{
+	float gameTime = (float)SimWorld::GetGameTime();
+	MoveTargets(gameTime);
+
+	// PHASE 1: GATHER
+	int pendingCount = 0;
+	for (int i = 0; i < g_riderCount; i++)
+	{
+		SimRider& sim = g_riders[i];
+		Actor* actor = LookupActorByID(sim.actorFormID);
+		if (!actor || actor->IsDead(1) || !actor->IsInCombat()) continue;
+
+		Actor* mount = nullptr;
+		if (!actor->GetMount(mount) || !mount) continue;
+
+		Actor* target = actor->combatTarget;
+		if (target) sim.targetFormID = target->formID;
+
+		g_pendingActors[pendingCount] = actor;
+		g_pendingMounts[pendingCount] = mount;
+		g_pendingTargets[pendingCount] = target;
+		g_pendingRiderIndex[pendingCount] = i;
+
+		RiderSnapshot& snapshot = g_snapshots[pendingCount];
+		snapshot.riderX = actor->pos.x;
+		snapshot.riderY = actor->pos.y;
+		snapshot.riderZ = actor->pos.z;
+		snapshot.hasTarget = (target != nullptr);
+		snapshot.targetX = target ? target->pos.x : 0.0f;
+		snapshot.targetY = target ? target->pos.y : 0.0f;
+		snapshot.targetZ = target ? target->pos.z : 0.0f;
+		snapshot.hasBow = actor->bowEquipped || actor->hasBowInInventory;
+		snapshot.usesStyleRules = sim.usesStyleRules;
+		pendingCount++;
+	}
+
+	// PHASE 2: DECIDE
+	DecideRiderStates(g_snapshots, pendingCount, g_decisions);
+
+	// PHASE 3: APPLY
+	for (int p = 0; p < pendingCount; p++)
+	{
+		SimRider& sim = g_riders[g_pendingRiderIndex[p]];
+		Actor* actor = g_pendingActors[p];
+		Actor* mount = g_pendingMounts[p];
+		Actor* target = g_pendingTargets[p];
+		const RiderDecision& decision = g_decisions[p];
+		if (!target) continue;
+
+		// Combat style step (GuardCombat::ExecuteBehavior): the first tick
+		// only draws the weapon and starts the follow package
+		if (sim.usesStyleRules)
+		{
+			if (!sim.weaponDrawn)
+			{
+				sim.weaponDrawn = true;
+			}
+			else
+			{
+				ApplyDecidedState(decision.state, sim.state, sim.stateStartTime, gameTime);
+			}
+		}
+
+		float distance = decision.distanceToTarget;
+
+		RangedFollowSwitch followSwitch = DecideRangedFollowSwitch(sim.inRangedMode, distance, gameTime - sim.lastRangedSwitchTime);
+		if (followSwitch != RangedFollowSwitch::None)
+		{
+			sim.inRangedMode = (followSwitch == RangedFollowSwitch::ToRanged);
+			sim.lastRangedSwitchTime = gameTime;
+		}
+
+		bool bowEquipped = (distance <= WEAPON_SWITCH_DISTANCE) && actor->bowEquipped;
+		bool force = false;
+		WeaponRequest weapon = DecideWeaponForDistance(distance, WEAPON_SWITCH_DISTANCE, false,
+			actor->hasBowInInventory, bowEquipped, force);
+		if (weapon != WeaponRequest::None)
+		{
+			actor->bowEquipped = (weapon == WeaponRequest::Bow);
+		}
+
+		// Movement (follow packages / vanilla AI stand-in)
+		float dx = target->pos.x - mount->pos.x;
+		float dy = target->pos.y - mount->pos.y;
+		float length = std::sqrt(dx * dx + dy * dy);
+		float towardX = (length > 0.0f) ? dx / length : 0.0f;
+		float towardY = (length > 0.0f) ? dy / length : 0.0f;
+
+		if (!sim.usesStyleRules && distance < 600.0f)
+		{
+			float fleeX = 0.0f;
+			float fleeY = 0.0f;
+			DecideFleeDirection(mount->pos.x, mount->pos.y, target->pos.x, target->pos.y, fleeX, fleeY);
+			MoveHorse(mount, fleeX, fleeY, 1.0f);
+		}
+		else if (sim.state == MountedCombatState::RangedAttack && distance < RANGED_MIN_RANGE)
+		{
+			MoveHorse(mount, -towardX, -towardY, 0.6f);
+		}
+		else if (sim.state == MountedCombatState::Attacking)
+		{
+			// Circle the target while in melee reach
+			MoveHorse(mount, -towardY, towardX, 0.4f);
+		}
+		else
+		{
+			MoveHorse(mount, towardX, towardY, (sim.state == MountedCombatState::Charging) ? 1.2f : 1.0f);
+		}
+
+		actor->pos = mount->pos;
+		actor->pos.z += 120.0f;
+		actor->rot.z = mount->rot.z;
+	}
+
+	SimWorld::AdvanceTime(TICK_SECONDS);
+}
+
+static uint64_t HashWorld()
+{
+	uint64_t hash = 1469598103934665603ull;
+	auto mix = [&hash](const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++) hash = (hash ^ bytes[i]) * 1099511628211ull;
+	};
+	for (int i = 0; i < g_riderCount; i++)
+	{
+		Actor* actor = LookupActorByID(g_riders[i].actorFormID);
+		mix(&actor->pos, sizeof(actor->pos));
+		mix(&g_riders[i].state, sizeof(g_riders[i].state));
+		mix(&g_riders[i].inRangedMode, sizeof(g_riders[i].inRangedMode));
+	}
+	return hash;
+}
+
+// ============================================
+// BENCHMARK
+// ============================================
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main()
+{
+	static std::vector<double> tickNs(TICKS_PER_RUN);
+
+	std::printf("%-7s %12s %12s %12s %12s   %s\n", "riders", "ns/tick", "p99 ns/tick", "ns/rider", "allocs/tick", "states (eng/att/chg/rng/no style)");
+
+	const int riderCounts[] = { 1, 2, 5, 10, 20, 30, 50, 100, 150, 200 };
+	for (int riders : riderCounts)
+	{
+		SetupScenario(riders, 0xC0FFEEu + (uint32_t)riders);
+
+		// Warm-up so first-touch page faults stay out of the numbers
+		for (int t = 0; t < 50; t++) SimTick();
+
+		uint64_t allocsBefore = g_allocations.load();
+		double total = 0.0;
+		for (int t = 0; t < TICKS_PER_RUN; t++)
+		{
+			double start = NowNs();
+			SimTick();
+			tickNs[t] = NowNs() - start;
+			total += tickNs[t];
+		}
+		uint64_t allocs = g_allocations.load() - allocsBefore;
+
+		std::vector<double> sorted(tickNs);
+		std::sort(sorted.begin(), sorted.end());
+		double p99 = sorted[(size_t)(TICKS_PER_RUN * 0.99)];
+
+		int counts[5] = {};
+		for (int i = 0; i < g_riderCount; i++)
+		{
+			if (!g_riders[i].usesStyleRules)
+			{
+				counts[4]++;
+				continue;
+			}
+
+			switch (g_riders[i].state)
+			{
+				case MountedCombatState::Engaging: counts[0]++; break;
+				case MountedCombatState::Attacking: counts[1]++; break;
+				case MountedCombatState::Charging: counts[2]++; break;
+				case MountedCombatState::RangedAttack: counts[3]++; break;
+				default: break;
+			}
+		}
+
+		double mean = total / TICKS_PER_RUN;
+		std::printf("%-7d %12.0f %12.0f %12.1f %12.3f   %d/%d/%d/%d/%d\n", riders, mean, p99, mean / riders,
+			(double)allocs / TICKS_PER_RUN, counts[0], counts[1], counts[2], counts[3], counts[4]);
+	}
+
+	// Determinism: the same seed must give the same world after N ticks
+	uint64_t hashes[2] = {};
+	for (int run = 0; run < 2; run++)
+	{
+		SetupScenario(30, 12345u);
+		for (int t = 0; t < TICKS_PER_RUN; t++) SimTick();
+		hashes[run] = HashWorld();
+	}
+	bool deterministic = (hashes[0] == hashes[1]);
+	std::printf("deterministic (30 riders, %d ticks): %s\n", TICKS_PER_RUN, deterministic ? "yes" : "NO");
+
+	return deterministic ? 0 : 1;
+}
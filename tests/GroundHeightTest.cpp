@@ -0,0 +1,179 @@
+// ============================================
+// GROUND HEIGHT TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/GroundHeightTest.cpp GroundHeightMath.cpp -o ground_height_test
+//     ./ground_height_test
+//
+// Checks the engine-independent heightfield math:
+// - StitchQuadrantHeights puts every quadrant vertex at the right tile
+//   row/column (SW, SE, NW, NE) and shared edges line up
+// - SampleTileBilinear returns vertex heights exactly, reproduces a
+//   planar field everywhere, stays between the four surrounding
+//   vertices, and clamps outside the cell
+// - WorldToCell for positive, negative and boundary coordinates
+// ============================================
+
+#include "GroundHeight.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace MountedNPCCombatVR::GroundHeight;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+// Height of a tilted plane at tile vertex (row, col)
+static float PlaneAt(float row, float col)
+{
+	return 100.0f + 3.5f * col - 2.25f * row;
+}
+
+static void BuildPlaneQuadrants(float* quadrants)
+{
+	const int half = LAND_QUADRANT_DIM - 1;
+	for (int q = 0; q < 4; q++)
+	{
+		int colBase = (q & 1) * half;
+		int rowBase = (q >> 1) * half;
+		for (int row = 0; row < LAND_QUADRANT_DIM; row++)
+		{
+			for (int col = 0; col < LAND_QUADRANT_DIM; col++)
+			{
+				quadrants[q * LAND_QUADRANT_VERTS + row * LAND_QUADRANT_DIM + col] =
+					PlaneAt((float)(rowBase + row), (float)(colBase + col));
+			}
+		}
+	}
+}
+
+static void TestStitch()
+{
+	static float quadrants[4 * LAND_QUADRANT_VERTS];
+	static float tile[LAND_GRID_DIM * LAND_GRID_DIM];
+
+	// Quadrant-coded values: q * 1000 + row * 17 + col
+	for (int q = 0; q < 4; q++)
+	{
+		for (int i = 0; i < LAND_QUADRANT_VERTS; i++)
+		{
+			quadrants[q * LAND_QUADRANT_VERTS + i] = (float)(q * 1000 + i);
+		}
+	}
+	StitchQuadrantHeights(quadrants, tile);
+
+	// Corners come from SW, SE, NW, NE
+	CHECK(tile[0] == 0.0f);
+	CHECK(tile[LAND_GRID_DIM - 1] == 1000.0f + 16.0f);
+	CHECK(tile[(LAND_GRID_DIM - 1) * LAND_GRID_DIM] == 2000.0f + 16.0f * 17.0f);
+	CHECK(tile[LAND_GRID_DIM * LAND_GRID_DIM - 1] == 3000.0f + 16.0f * 17.0f + 16.0f);
+
+	// Interior of each quadrant (not on a shared edge) maps 1:1
+	for (int q = 0; q < 4; q++)
+	{
+		int colBase = (q & 1) * 16;
+		int rowBase = (q >> 1) * 16;
+		for (int row = 1; row < 16; row++)
+		{
+			for (int col = 1; col < 16; col++)
+			{
+				CHECK(tile[(rowBase + row) * LAND_GRID_DIM + colBase + col] == (float)(q * 1000 + row * 17 + col));
+			}
+		}
+	}
+
+	// Real land has matching shared edges: stitching a plane gives the plane
+	BuildPlaneQuadrants(quadrants);
+	StitchQuadrantHeights(quadrants, tile);
+	for (int row = 0; row < LAND_GRID_DIM; row++)
+	{
+		for (int col = 0; col < LAND_GRID_DIM; col++)
+		{
+			CHECK(tile[row * LAND_GRID_DIM + col] == PlaneAt((float)row, (float)col));
+		}
+	}
+}
+
+static void TestBilinear()
+{
+	static float quadrants[4 * LAND_QUADRANT_VERTS];
+	static float tile[LAND_GRID_DIM * LAND_GRID_DIM];
+	BuildPlaneQuadrants(quadrants);
+	StitchQuadrantHeights(quadrants, tile);
+
+	// Exact at vertices, planar in between
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> local(0.0f, LAND_CELL_SIZE);
+	for (int i = 0; i < 100000; i++)
+	{
+		float x = local(rng);
+		float y = local(rng);
+		float expected = PlaneAt(y / LAND_VERTEX_SPACING, x / LAND_VERTEX_SPACING);
+		CHECK(std::fabs(SampleTileBilinear(tile, x, y) - expected) < 1e-2f);
+		if (g_failures > 10) return;
+	}
+	for (int row = 0; row < LAND_GRID_DIM; row++)
+	{
+		for (int col = 0; col < LAND_GRID_DIM; col++)
+		{
+			float h = SampleTileBilinear(tile, col * LAND_VERTEX_SPACING, row * LAND_VERTEX_SPACING);
+			CHECK(std::fabs(h - PlaneAt((float)row, (float)col)) < 1e-3f);
+		}
+	}
+
+	// Clamped outside the cell
+	CHECK(SampleTileBilinear(tile, -500.0f, -500.0f) == tile[0]);
+	CHECK(std::fabs(SampleTileBilinear(tile, LAND_CELL_SIZE + 500.0f, LAND_CELL_SIZE + 500.0f) -
+		tile[LAND_GRID_DIM * LAND_GRID_DIM - 1]) < 1e-3f);
+
+	// Random field: a sample never leaves the range of its four vertices
+	for (int i = 0; i < LAND_GRID_DIM * LAND_GRID_DIM; i++)
+	{
+		tile[i] = (float)(rng() % 20000) - 10000.0f;
+	}
+	for (int i = 0; i < 100000; i++)
+	{
+		float x = local(rng);
+		float y = local(rng);
+		int col = (int)(x / LAND_VERTEX_SPACING);
+		int row = (int)(y / LAND_VERTEX_SPACING);
+		if (col > LAND_GRID_DIM - 2) col = LAND_GRID_DIM - 2;
+		if (row > LAND_GRID_DIM - 2) row = LAND_GRID_DIM - 2;
+		const float* s = tile + row * LAND_GRID_DIM + col;
+		const float* n = s + LAND_GRID_DIM;
+		float lo = std::fmin(std::fmin(s[0], s[1]), std::fmin(n[0], n[1]));
+		float hi = std::fmax(std::fmax(s[0], s[1]), std::fmax(n[0], n[1]));
+		float h = SampleTileBilinear(tile, x, y);
+		CHECK(h >= lo - 1e-2f && h <= hi + 1e-2f);
+		if (g_failures > 10) return;
+	}
+}
+
+static void TestWorldToCell()
+{
+	CHECK(WorldToCell(0.0f) == 0);
+	CHECK(WorldToCell(4095.9f) == 0);
+	CHECK(WorldToCell(4096.0f) == 1);
+	CHECK(WorldToCell(-0.1f) == -1);
+	CHECK(WorldToCell(-4096.0f) == -1);
+	CHECK(WorldToCell(-4096.1f) == -2);
+	CHECK(WorldToCell(123456.0f) == 30);
+}
+
+int main()
+{
+	TestStitch();
+	TestBilinear();
+	TestWorldToCell();
+
+	if (g_failures == 0)
+	{
+		std::printf("GroundHeightTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("GroundHeightTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,397 @@
+// ============================================
+// HAZARD MAP TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/HazardMapTest.cpp HazardMapMath.cpp -o hazard_map_test
+//     ./hazard_map_test
+//
+// Checks the buffer-level format functions (HazardMapMath.cpp):
+// - round trip: marks written to a file and read back validate and
+//   answer the same, byte for byte
+// - confirm counts, stuck/drop independence, counter saturation
+// - decay: one event per HAZARD_DECAY_DAYS, remainder kept
+// - versioning: other versions, worldspaces and layouts are rejected
+// - truncated files (short reads, header only, empty) are rejected
+// - corrupt files: bad magic, usedTiles out of range or wrong, bad
+//   isUsed, counters past HAZARD_MAX_EVENTS, a broken probe chain and a
+//   duplicate cell are all rejected
+// - a full table refuses new cells and stays valid
+// ============================================
+
+#include "HazardMap.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace MountedNPCCombatVR::HazardMap;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static const uint32_t WORLD = 0x00003C;   // Tamriel's local ID
+static const uint32_t DAY = 20000;
+
+typedef std::vector<uint8_t> Buffer;
+
+static Buffer MakeMap()
+{
+	Buffer buffer(GetHazardFileSize());
+	InitHazardView(buffer.data(), WORLD);
+	return buffer;
+}
+
+static HazardFileHeader* Header(Buffer& buffer)
+{
+	return reinterpret_cast<HazardFileHeader*>(buffer.data());
+}
+
+static HazardTile* Tiles(Buffer& buffer)
+{
+	return reinterpret_cast<HazardTile*>(buffer.data() + sizeof(HazardFileHeader));
+}
+
+static bool IsValid(Buffer& buffer)
+{
+	return ValidateHazardView(buffer.data(), (uint32_t)buffer.size(), WORLD);
+}
+
+// Home slot of a cell (part of the file format: open addressing from here)
+static uint32_t HomeSlot(int cellX, int cellY)
+{
+	uint32_t h = (uint32_t)cellX * 73856093u ^ (uint32_t)cellY * 19349663u;
+	return h & (HAZARD_MAX_TILES - 1);
+}
+
+// Centre of a square, so float rounding cannot move it
+static float SquareCenter(int cell, int square)
+{
+	return cell * HAZARD_CELL_SIZE + (square + 0.5f) * HAZARD_SQUARE_SIZE;
+}
+
+static void Mark(Buffer& buffer, float x, float y, HazardKind kind, int times, uint32_t day = DAY)
+{
+	for (int i = 0; i < times; i++) MarkHazardInView(buffer.data(), x, y, kind, day);
+}
+
+static bool WriteFile(const char* path, const uint8_t* data, size_t size)
+{
+	FILE* file = std::fopen(path, "wb");
+	if (!file) return false;
+	bool ok = std::fwrite(data, 1, size, file) == size;
+	return (std::fclose(file) == 0) && ok;
+}
+
+static Buffer ReadFile(const char* path)
+{
+	Buffer buffer;
+	FILE* file = std::fopen(path, "rb");
+	if (!file) return buffer;
+
+	uint8_t chunk[4096];
+	size_t got;
+	while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+	{
+		buffer.insert(buffer.end(), chunk, chunk + got);
+	}
+	std::fclose(file);
+	return buffer;
+}
+
+static void TestEmptyMap()
+{
+	CHECK(GetHazardFileSize() == sizeof(HazardFileHeader) + HAZARD_MAX_TILES * sizeof(HazardTile));
+
+	Buffer map = MakeMap();
+	CHECK(IsValid(map));
+	CHECK(Header(map)->usedTiles == 0);
+	CHECK(!TestHazardInView(map.data(), 100.0f, 100.0f, HAZARD_STUCK));
+	CHECK(!TestHazardInView(map.data(), 100.0f, 100.0f, HAZARD_DROP));
+	CHECK(DecayHazardView(map.data(), DAY + 100) == 0);
+}
+
+static void TestCounts()
+{
+	Buffer map = MakeMap();
+	float x = SquareCenter(3, 5);
+	float y = SquareCenter(-2, 11);
+
+	// One event is not enough
+	CHECK(MarkHazardInView(map.data(), x, y, HAZARD_STUCK, DAY));
+	CHECK(!TestHazardInView(map.data(), x, y, HAZARD_STUCK));
+
+	Mark(map, x, y, HAZARD_STUCK, HAZARD_STUCK_CONFIRM - 1);
+	CHECK(TestHazardInView(map.data(), x, y, HAZARD_STUCK));
+	CHECK(!TestHazardInView(map.data(), x, y, HAZARD_DROP));
+
+	// Neighbouring squares and the same square in another cell are untouched
+	CHECK(!TestHazardInView(map.data(), x + HAZARD_SQUARE_SIZE, y, HAZARD_STUCK));
+	CHECK(!TestHazardInView(map.data(), x + HAZARD_CELL_SIZE, y, HAZARD_STUCK));
+
+	// Drop counts separately
+	Mark(map, x, y, HAZARD_DROP, HAZARD_DROP_CONFIRM);
+	CHECK(TestHazardInView(map.data(), x, y, HAZARD_DROP));
+	CHECK(Header(map)->usedTiles == 1);
+
+	// Saturation: no change reported on the same day once full
+	Mark(map, x, y, HAZARD_STUCK, 20);
+	CHECK(!MarkHazardInView(map.data(), x, y, HAZARD_STUCK, DAY));
+	CHECK(MarkHazardInView(map.data(), x, y, HAZARD_STUCK, DAY + 1));   // New day still restarts decay
+	CHECK(IsValid(map));
+
+	// Cells past the int16 range are not stored
+	CHECK(!MarkHazardInView(map.data(), 40000.0f * HAZARD_CELL_SIZE, 0.0f, HAZARD_STUCK, DAY));
+	CHECK(Header(map)->usedTiles == 1);
+}
+
+static void TestDecay()
+{
+	Buffer map = MakeMap();
+	float x = SquareCenter(0, 0);
+	float y = SquareCenter(0, 0);
+	Mark(map, x, y, HAZARD_DROP, HAZARD_DROP_CONFIRM + 1);
+
+	// Not due yet
+	CHECK(DecayHazardView(map.data(), DAY + HAZARD_DECAY_DAYS - 1) == 0);
+	CHECK(TestHazardInView(map.data(), x, y, HAZARD_DROP));
+
+	// One step forgets one event (still confirmed), remainder carried
+	CHECK(DecayHazardView(map.data(), DAY + HAZARD_DECAY_DAYS + 3) == 1);
+	CHECK(TestHazardInView(map.data(), x, y, HAZARD_DROP));
+	CHECK(Tiles(map)[HomeSlot(0, 0)].lastEventDay == DAY + HAZARD_DECAY_DAYS);
+
+	// Second step drops below confirm
+	CHECK(DecayHazardView(map.data(), DAY + 2 * HAZARD_DECAY_DAYS) == 1);
+	CHECK(!TestHazardInView(map.data(), x, y, HAZARD_DROP));
+
+	// Emptied tiles stay in the table and the map stays valid
+	CHECK(DecayHazardView(map.data(), DAY + 100 * HAZARD_DECAY_DAYS) == 1);
+	CHECK(Header(map)->usedTiles == 1);
+	CHECK(IsValid(map));
+}
+
+static void TestRoundTrip()
+{
+	Buffer map = MakeMap();
+
+	// Spread over negative and positive cells, square and cell edges
+	const float points[][2] = {
+		{ SquareCenter(0, 0), SquareCenter(0, 0) },
+		{ SquareCenter(-1, 15), SquareCenter(-1, 15) },
+		{ SquareCenter(-30, 7), SquareCenter(25, 0) },
+		{ 0.0f, 0.0f },
+		{ -0.5f, -0.5f },
+		{ HAZARD_CELL_SIZE - 0.5f, HAZARD_CELL_SIZE },
+		{ SquareCenter(120, 3), SquareCenter(-120, 12) },
+	};
+	const int pointCount = (int)(sizeof(points) / sizeof(points[0]));
+
+	for (int i = 0; i < pointCount; i++)
+	{
+		HazardKind kind = (i & 1) ? HAZARD_DROP : HAZARD_STUCK;
+		Mark(map, points[i][0], points[i][1], kind, 2 + (i % 3), DAY + i);
+	}
+	CHECK(IsValid(map));
+
+	const char* path = "hazard_map_test.bin";
+	CHECK(WriteFile(path, map.data(), map.size()));
+	Buffer loaded = ReadFile(path);
+	std::remove(path);
+
+	CHECK(loaded.size() == map.size());
+	CHECK(IsValid(loaded));
+	CHECK(loaded == map);
+
+	for (int i = 0; i < pointCount; i++)
+	{
+		for (HazardKind kind : { HAZARD_STUCK, HAZARD_DROP })
+		{
+			CHECK(TestHazardInView(loaded.data(), points[i][0], points[i][1], kind) ==
+				TestHazardInView(map.data(), points[i][0], points[i][1], kind));
+		}
+		HazardKind marked = (i & 1) ? HAZARD_DROP : HAZARD_STUCK;
+		CHECK(TestHazardInView(loaded.data(), points[i][0], points[i][1], marked));
+	}
+
+	// Marks keep working on the loaded copy
+	CHECK(MarkHazardInView(loaded.data(), SquareCenter(7, 7), SquareCenter(7, 7), HAZARD_STUCK, DAY));
+	CHECK(IsValid(loaded));
+}
+
+static void TestVersioning()
+{
+	Buffer map = MakeMap();
+	Mark(map, 100.0f, 100.0f, HAZARD_STUCK, 3);
+	CHECK(IsValid(map));
+
+	// Older (v1 had no event counters) and newer versions are replaced, not read
+	Buffer old = map;
+	Header(old)->version = HAZARD_VERSION - 1;
+	CHECK(!IsValid(old));
+
+	Buffer newer = map;
+	Header(newer)->version = HAZARD_VERSION + 1;
+	CHECK(!IsValid(newer));
+
+	// Another worldspace's file (same name after a plugin swap)
+	CHECK(!ValidateHazardView(map.data(), (uint32_t)map.size(), WORLD + 1));
+
+	// Layout constants from another build
+	Buffer tiles = map;
+	Header(tiles)->maxTiles = HAZARD_MAX_TILES / 2;
+	CHECK(!IsValid(tiles));
+
+	Buffer tileSize = map;
+	Header(tileSize)->tileSize = sizeof(HazardTile) - 4;
+	CHECK(!IsValid(tileSize));
+}
+
+static void TestTruncated()
+{
+	Buffer map = MakeMap();
+	Mark(map, 100.0f, 100.0f, HAZARD_STUCK, 3);
+
+	CHECK(!ValidateHazardView(nullptr, GetHazardFileSize(), WORLD));
+	CHECK(!ValidateHazardView(map.data(), 0, WORLD));
+	CHECK(!ValidateHazardView(map.data(), sizeof(HazardFileHeader), WORLD));
+	CHECK(!ValidateHazardView(map.data(), GetHazardFileSize() - 1, WORLD));
+
+	// A short file on disk (crash mid-write) reads back too small
+	const char* path = "hazard_map_test_short.bin";
+	CHECK(WriteFile(path, map.data(), map.size() / 2));
+	Buffer shortRead = ReadFile(path);
+	std::remove(path);
+	CHECK(shortRead.size() == map.size() / 2);
+	CHECK(!ValidateHazardView(shortRead.data(), (uint32_t)shortRead.size(), WORLD));
+
+	// Too long is rejected as well
+	Buffer longer = map;
+	longer.resize(map.size() + 16);
+	CHECK(!ValidateHazardView(longer.data(), (uint32_t)longer.size(), WORLD));
+}
+
+static void TestCorrupt()
+{
+	// Two cells sharing a home slot, so the second sits further along the chain
+	int cellAX = 0, cellAY = 0, cellBX = 0, cellBY = 0;
+	bool foundPair = false;
+	for (int y = 1; y < 200 && !foundPair; y++)
+	{
+		for (int x = -100; x < 100; x++)
+		{
+			if ((x != 0 || y != 0) && HomeSlot(x, y) == HomeSlot(0, 0))
+			{
+				cellBX = x;
+				cellBY = y;
+				foundPair = true;
+				break;
+			}
+		}
+	}
+	CHECK(foundPair);
+
+	Buffer map = MakeMap();
+	Mark(map, SquareCenter(cellAX, 1), SquareCenter(cellAY, 1), HAZARD_STUCK, 2);
+	Mark(map, SquareCenter(cellBX, 2), SquareCenter(cellBY, 2), HAZARD_DROP, 2);
+	Mark(map, SquareCenter(9, 9), SquareCenter(-9, 9), HAZARD_STUCK, 2);
+	CHECK(IsValid(map));
+	CHECK(Header(map)->usedTiles == 3);
+
+	uint32_t slotA = HomeSlot(cellAX, cellAY);
+	uint32_t slotB = (slotA + 1) & (HAZARD_MAX_TILES - 1);
+	CHECK(Tiles(map)[slotA].isUsed == 1 && Tiles(map)[slotB].isUsed == 1);
+	CHECK(Tiles(map)[slotB].cellX == cellBX && Tiles(map)[slotB].cellY == cellBY);
+	CHECK(TestHazardInView(map.data(), SquareCenter(cellBX, 2), SquareCenter(cellBY, 2), HAZARD_DROP));
+
+	Buffer magic = map;
+	Header(magic)->magic ^= 0x01000000;
+	CHECK(!IsValid(magic));
+
+	Buffer usedHigh = map;
+	Header(usedHigh)->usedTiles = HAZARD_MAX_TILES + 1;
+	CHECK(!IsValid(usedHigh));
+
+	Buffer usedWrong = map;
+	Header(usedWrong)->usedTiles = 2;
+	CHECK(!IsValid(usedWrong));
+
+	Buffer isUsed = map;
+	Tiles(isUsed)[slotA].isUsed = 0x7F;
+	CHECK(!IsValid(isUsed));
+
+	Buffer counter = map;
+	Tiles(counter)[slotA].events[1 * HAZARD_TILE_DIM + 1] = 0xF2;   // Drop nibble 15
+	CHECK(!IsValid(counter));
+
+	// First tile of the chain zeroed: the second can no longer be found
+	Buffer chain = map;
+	Tiles(chain)[slotA].isUsed = 0;
+	Header(chain)->usedTiles = 2;
+	CHECK(!TestHazardInView(chain.data(), SquareCenter(cellBX, 2), SquareCenter(cellBY, 2), HAZARD_DROP));
+	CHECK(!IsValid(chain));
+
+	// Second tile rewritten to the first tile's cell
+	Buffer duplicate = map;
+	Tiles(duplicate)[slotB].cellX = (int16_t)cellAX;
+	Tiles(duplicate)[slotB].cellY = (int16_t)cellAY;
+	CHECK(!IsValid(duplicate));
+
+	// Random byte noise in the table
+	Buffer noise = map;
+	uint32_t seed = 42;
+	uint8_t* table = noise.data() + sizeof(HazardFileHeader);
+	size_t tableSize = noise.size() - sizeof(HazardFileHeader);
+	for (int i = 0; i < 4096; i++)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		table[(seed >> 8) % tableSize] = (uint8_t)(seed >> 24);
+	}
+	CHECK(!IsValid(noise));
+
+	// A rejected file is replaced by an empty map for the same worldspace
+	InitHazardView(noise.data(), WORLD);
+	CHECK(IsValid(noise));
+	CHECK(Header(noise)->usedTiles == 0);
+}
+
+static void TestFullTable()
+{
+	Buffer map = MakeMap();
+	int stored = 0;
+	for (int i = 0; i < (int)HAZARD_MAX_TILES; i++)
+	{
+		int cellX = (i % 64) - 32;
+		int cellY = (i / 64) - 16;
+		if (MarkHazardInView(map.data(), SquareCenter(cellX, 0), SquareCenter(cellY, 0), HAZARD_STUCK, DAY)) stored++;
+	}
+	CHECK(stored == (int)HAZARD_MAX_TILES);
+	CHECK(Header(map)->usedTiles == HAZARD_MAX_TILES);
+
+	// No room for another cell, but existing cells still count events
+	CHECK(!MarkHazardInView(map.data(), SquareCenter(500, 0), SquareCenter(500, 0), HAZARD_STUCK, DAY));
+	CHECK(MarkHazardInView(map.data(), SquareCenter(-32, 0), SquareCenter(-16, 0), HAZARD_STUCK, DAY));
+	CHECK(TestHazardInView(map.data(), SquareCenter(-32, 0), SquareCenter(-16, 0), HAZARD_STUCK));
+	CHECK(!TestHazardInView(map.data(), SquareCenter(500, 0), SquareCenter(500, 0), HAZARD_STUCK));
+	CHECK(IsValid(map));
+}
+
+int main()
+{
+	TestEmptyMap();
+	TestCounts();
+	TestDecay();
+	TestRoundTrip();
+	TestVersioning();
+	TestTruncated();
+	TestCorrupt();
+	TestFullTable();
+
+	if (g_failures == 0)
+	{
+		std::printf("HazardMapTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("HazardMapTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,294 @@
+// ============================================
+// MANEUVER SCRIPT BENCHMARK (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/ManeuverScriptBench.cpp ManeuverScript.cpp -pthread -o maneuver_script_bench
+//     ./maneuver_script_bench
+//
+// What the script form costs per tick compared with the enum + timestamp
+// state machine it replaced, for the charge shape (rear up for a fixed
+// time, wait for the weapon swap with a timeout, charge until in range
+// with a timeout). 10 / 64 / 256 horses at a 90 Hz tick, each starting
+// at a different time, over 10 simulated seconds (every horse finishes):
+// - state machine: every tick switches on the state and compares times
+// - script: every tick checks IsScriptDue; the body only runs when due
+// Both must finish every horse at the same tick with the same outcome.
+//
+// Animation events (PostAnimationEvent runs for every event of every
+// actor in the engine hook):
+// - post for an actor that is not watched, with 0 / 4 / 16 slots taken
+// - post for a watched actor, and HasAnimationEventSince over the ring
+// ============================================
+
+#include "ManeuverScript.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MountedNPCCombatVR::ManeuverScript;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static const float TICK = 1.0f / 90.0f;
+static const int TICKS = 10 * 90;
+
+static const float REAR_UP_DURATION = 1.0f;
+static const float EQUIP_TIMEOUT = 2.0f;
+static const float CHARGE_TIMEOUT = 4.0f;
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Per-horse inputs: when it starts, when its weapon is ready, when it is in range
+struct HorseInputs
+{
+	float startTime;
+	float equippedTime;
+	float inRangeTime;
+};
+
+struct Outcome
+{
+	int finishTick;
+	bool equipTimedOut;
+	bool chargeTimedOut;
+};
+
+// ============================================
+// STATE MACHINE (before)
+// ============================================
+
+enum class ChargeState { None, RearingUp, EquippingWeapon, Charging, Completed };
+
+struct OldHorse
+{
+	ChargeState state;
+	float stateEndTime;   // Timestamp the current state waits for (duration or timeout)
+	Outcome outcome;
+};
+
+static void UpdateOld(OldHorse& horse, const HorseInputs& in, float now, int tick)
+{
+	switch (horse.state)
+	{
+	case ChargeState::None:
+		if (now >= in.startTime)
+		{
+			horse.state = ChargeState::RearingUp;
+			horse.stateEndTime = now + REAR_UP_DURATION;
+		}
+		break;
+	case ChargeState::RearingUp:
+		if (now >= horse.stateEndTime)
+		{
+			horse.state = ChargeState::EquippingWeapon;
+			horse.stateEndTime = now + EQUIP_TIMEOUT;
+			[[fallthrough]];
+		}
+		else
+		{
+			break;
+		}
+	case ChargeState::EquippingWeapon:
+	{
+		bool ready = now >= in.equippedTime;
+		bool timedOut = now >= horse.stateEndTime;
+		if (!ready && !timedOut) break;
+		horse.outcome.equipTimedOut = !ready;
+		horse.state = ChargeState::Charging;
+		horse.stateEndTime = now + CHARGE_TIMEOUT;
+		[[fallthrough]];
+	}
+	case ChargeState::Charging:
+	{
+		bool inRange = now >= in.inRangeTime;
+		bool timedOut = now >= horse.stateEndTime;
+		if (!inRange && !timedOut) break;
+		horse.outcome.chargeTimedOut = !inRange;
+		horse.outcome.finishTick = tick;
+		horse.state = ChargeState::Completed;
+		break;
+	}
+	case ChargeState::Completed:
+		break;
+	}
+}
+
+// ============================================
+// SCRIPT (after)
+// ============================================
+
+struct NewHorse
+{
+	ScriptState script;
+	bool started;
+	Outcome outcome;
+};
+
+static bool RunCharge(NewHorse& horse, const HorseInputs& in, float now, int tick)
+{
+	SCRIPT_BEGIN(horse.script);
+	SCRIPT_WAIT_SECONDS(horse.script, now, REAR_UP_DURATION);
+	SCRIPT_WAIT_UNTIL(horse.script, now, now >= in.equippedTime, EQUIP_TIMEOUT);
+	horse.outcome.equipTimedOut = horse.script.timedOut;
+	SCRIPT_WAIT_UNTIL(horse.script, now, now >= in.inRangeTime, CHARGE_TIMEOUT);
+	horse.outcome.chargeTimedOut = horse.script.timedOut;
+	horse.outcome.finishTick = tick;
+	SCRIPT_END(horse.script);
+}
+
+static void UpdateNew(NewHorse& horse, const HorseInputs& in, float now, int tick)
+{
+	if (!horse.started)
+	{
+		if (now < in.startTime) return;
+		StartScript(horse.script, now);
+		horse.started = true;
+	}
+	if (IsScriptDue(horse.script, now))
+	{
+		RunCharge(horse, in, now, tick);
+	}
+}
+
+// ============================================
+// HARNESS
+// ============================================
+
+static void RunHorses(int count, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> startDist(0.0f, 2.0f);
+	std::uniform_real_distribution<float> equipDist(0.2f, 2.6f);   // Some miss the 2 s timeout
+	std::uniform_real_distribution<float> rangeDist(0.5f, 5.0f);   // Some miss the 4 s timeout
+
+	std::vector<HorseInputs> inputs(count);
+	for (HorseInputs& in : inputs)
+	{
+		in.startTime = startDist(rng);
+		in.equippedTime = in.startTime + REAR_UP_DURATION + equipDist(rng);
+		in.inRangeTime = in.equippedTime + rangeDist(rng);
+	}
+
+	std::vector<OldHorse> oldHorses(count);
+	std::vector<NewHorse> newHorses(count);
+	double best[2] = { 1e30, 1e30 };
+
+	for (int rep = 0; rep < 20; rep++)
+	{
+		for (OldHorse& horse : oldHorses) horse = OldHorse{ ChargeState::None, 0.0f, { -1, false, false } };
+		for (NewHorse& horse : newHorses)
+		{
+			ResetScript(horse.script);
+			horse.started = false;
+			horse.outcome = Outcome{ -1, false, false };
+		}
+
+		// Time is stepped the same way in both, so each sees the same 'now'
+		double start = NowNs();
+		for (int t = 0; t < TICKS; t++)
+		{
+			float now = t * TICK;
+			for (int h = 0; h < count; h++) UpdateOld(oldHorses[h], inputs[h], now, t);
+		}
+		double oldNs = (NowNs() - start) / TICKS;
+
+		start = NowNs();
+		for (int t = 0; t < TICKS; t++)
+		{
+			float now = t * TICK;
+			for (int h = 0; h < count; h++) UpdateNew(newHorses[h], inputs[h], now, t);
+		}
+		double newNs = (NowNs() - start) / TICKS;
+
+		if (oldNs < best[0]) best[0] = oldNs;
+		if (newNs < best[1]) best[1] = newNs;
+	}
+
+	int timedOut = 0;
+	for (int h = 0; h < count; h++)
+	{
+		const Outcome& a = oldHorses[h].outcome;
+		const Outcome& b = newHorses[h].outcome;
+		CHECK(a.finishTick >= 0);
+		CHECK(a.finishTick == b.finishTick);
+		CHECK(a.equipTimedOut == b.equipTimedOut);
+		CHECK(a.chargeTimedOut == b.chargeTimedOut);
+		if (b.equipTimedOut || b.chargeTimedOut) timedOut++;
+	}
+
+	std::printf("  %3d horses: state machine %7.0f ns/tick   script %7.0f ns/tick   (%.1f / %.1f ns per horse, %d timed out)\n",
+		count, best[0], best[1], best[0] / count, best[1] / count, timedOut);
+}
+
+static double TimePost(uint32_t formID, int iterations)
+{
+	double start = NowNs();
+	for (int i = 0; i < iterations; i++) PostAnimationEvent(formID, "bowDrawn");
+	return (NowNs() - start) / iterations;
+}
+
+static void RunAnimationEvents()
+{
+	const int POSTS = 2000000;
+	const uint32_t UNWATCHED = 0x00ABCDEF;
+
+	ClearAnimationEvents();
+	double empty = TimePost(UNWATCHED, POSTS);
+
+	for (uint32_t i = 1; i <= 4; i++) WatchAnimationEvents(0x00100000 + i);
+	double four = TimePost(UNWATCHED, POSTS);
+
+	for (uint32_t i = 5; i <= ANIM_EVENT_WATCH_SLOTS; i++) WatchAnimationEvents(0x00100000 + i);
+	double full = TimePost(UNWATCHED, POSTS);
+	CHECK(!WatchAnimationEvents(0x00200000));   // No slot left
+
+	uint32_t watched = 0x00100000 + ANIM_EVENT_WATCH_SLOTS;
+	uint32_t sequence = GetAnimationEventSequence();
+	double posted = TimePost(watched, POSTS / 10);
+	CHECK(HasAnimationEventSince(watched, "BowDrawn", sequence));
+	CHECK(!HasAnimationEventSince(UNWATCHED, "BowDrawn", sequence));
+
+	const int QUERIES = 200000;
+	volatile int hits = 0;
+	double start = NowNs();
+	for (int i = 0; i < QUERIES; i++) hits = hits + (HasAnimationEventSince(watched, "arrowRelease", sequence) ? 1 : 0);
+	double query = (NowNs() - start) / QUERIES;
+	CHECK(hits == 0);
+
+	// A freed slot is usable again
+	UnwatchAnimationEvents(watched);
+	CHECK(WatchAnimationEvents(0x00200000));
+	ClearAnimationEvents();
+
+	std::printf("  post, actor not watched: %.1f ns (0 watched)  %.1f ns (4)  %.1f ns (%d, all slots)\n",
+		empty, four, full, ANIM_EVENT_WATCH_SLOTS);
+	std::printf("  post, watched actor: %.1f ns   HasAnimationEventSince (miss, full ring): %.1f ns\n", posted, query);
+}
+
+int main()
+{
+	std::mt19937 rng(47);
+
+	std::printf("ManeuverScriptBench: charge sequence, %d ticks at 90 Hz\n", TICKS);
+	RunHorses(10, rng);
+	RunHorses(64, rng);
+	RunHorses(256, rng);
+
+	std::printf("ManeuverScriptBench: animation events\n");
+	RunAnimationEvents();
+
+	if (g_failures == 0)
+	{
+		std::printf("ManeuverScriptBench: all checks passed\n");
+		return 0;
+	}
+	std::printf("ManeuverScriptBench: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,386 @@
+// ============================================
+// MANEUVER SCRIPT TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/ManeuverScriptTest.cpp ManeuverScript.cpp -pthread -o maneuver_script_test
+//     ./maneuver_script_test
+//
+// Drives scripts the way the game systems do (start, then resume only
+// when IsScriptDue) on a fixed tick and checks:
+// - SCRIPT_WAIT_SECONDS resumes after the delay and not before; the body
+//   is not entered while it sleeps
+// - SCRIPT_WAIT_UNTIL ends on the condition or on the timeout, with
+//   timedOut telling which
+// - StopScript cancels mid-wait; StartScript restarts from the top
+// - a copied ScriptState (the per-horse arrays shift entries) resumes
+//   where the original was
+// - waits inside loops and SCRIPT_EXIT
+// - SCRIPT_WAIT_ANIM_EVENT: only events for the watched actor, with the
+//   right tag (any case), sent after the wait began, end the wait
+// ============================================
+
+#include "ManeuverScript.h"
+#include <cmath>
+#include <cstdio>
+
+using namespace MountedNPCCombatVR::ManeuverScript;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static const float TICK = 0.1f;
+
+static bool Near(float a, float b)
+{
+	return std::fabs(a - b) < TICK * 0.5f;
+}
+
+// ============================================
+// TEST SCRIPTS
+// ============================================
+
+struct TestData
+{
+	ScriptState script;
+	int entries;          // Times the script body was entered
+	int step;             // Last step reached
+	float stepTime[8];    // When each step was reached
+	bool condition;       // For SCRIPT_WAIT_UNTIL
+	bool timedOut[4];     // timedOut after each wait
+	int loops;
+	uint32_t formID;
+};
+
+static void ResetData(TestData& data)
+{
+	ResetScript(data.script);
+	data.entries = 0;
+	data.step = 0;
+	for (int i = 0; i < 8; i++) data.stepTime[i] = -1.0f;
+	data.condition = false;
+	for (int i = 0; i < 4; i++) data.timedOut[i] = false;
+	data.loops = 0;
+	data.formID = 0;
+}
+
+static void Reach(TestData& data, int step, float now)
+{
+	data.step = step;
+	data.stepTime[step] = now;
+}
+
+// Same shape as the charge: timed step, conditional step, timed step
+static bool RunSequence(TestData& data, float now)
+{
+	data.entries++;
+
+	SCRIPT_BEGIN(data.script);
+	Reach(data, 1, now);
+	SCRIPT_WAIT_SECONDS(data.script, now, 1.0f);
+	Reach(data, 2, now);
+	SCRIPT_WAIT_UNTIL(data.script, now, data.condition, 2.0f);
+	data.timedOut[0] = data.script.timedOut;
+	Reach(data, 3, now);
+	SCRIPT_WAIT_SECONDS(data.script, now, 0.5f);
+	Reach(data, 4, now);
+	SCRIPT_END(data.script);
+}
+
+// Loop with a yield and an early exit
+static bool RunLoop(TestData& data, float now)
+{
+	SCRIPT_BEGIN(data.script);
+	for (;;)
+	{
+		data.loops++;
+		if (data.loops == 5)
+		{
+			Reach(data, 1, now);
+			SCRIPT_EXIT(data.script);
+		}
+		SCRIPT_YIELD(data.script);
+	}
+	SCRIPT_END(data.script);
+}
+
+// Wait for an animation event, like the bow draw
+static bool RunAnimWait(TestData& data, float now)
+{
+	SCRIPT_BEGIN(data.script);
+	Reach(data, 1, now);
+	SCRIPT_WAIT_ANIM_EVENT(data.script, now, data.formID, "BowDrawn", 1.0f);
+	data.timedOut[0] = data.script.timedOut;
+	Reach(data, 2, now);
+	SCRIPT_END(data.script);
+}
+
+typedef bool (*ScriptFn)(TestData& data, float now);
+
+// Resume when due, the way the game systems call scripts
+static void Tick(ScriptFn fn, TestData& data, float now)
+{
+	if (IsScriptDue(data.script, now)) fn(data, now);
+}
+
+static float TickTime(int tick)
+{
+	return tick * TICK;
+}
+
+// ============================================
+// TESTS
+// ============================================
+
+static void TestWaits()
+{
+	// Condition set at 1.5 s, well inside the timeout
+	{
+		TestData data;
+		ResetData(data);
+		StartScript(data.script, 0.0f);
+
+		for (int t = 0; t <= 40; t++)
+		{
+			float now = TickTime(t);
+			if (Near(now, 1.5f)) data.condition = true;
+			Tick(RunSequence, data, now);
+		}
+
+		CHECK(data.step == 4);
+		CHECK(Near(data.stepTime[1], 0.0f));
+		CHECK(Near(data.stepTime[2], 1.0f));
+		CHECK(Near(data.stepTime[3], 1.5f));
+		CHECK(Near(data.stepTime[4], 2.0f));
+		CHECK(!data.timedOut[0]);
+		CHECK(!IsScriptRunning(data.script));
+
+		// Entered at 0.0, 1.0, 1.1 .. 1.5 (condition polled), 2.0
+		CHECK(data.entries == 8);
+	}
+
+	// Condition never set: the wait ends on its timeout
+	{
+		TestData data;
+		ResetData(data);
+		StartScript(data.script, 0.0f);
+
+		for (int t = 0; t <= 50; t++)
+		{
+			Tick(RunSequence, data, TickTime(t));
+		}
+
+		CHECK(data.step == 4);
+		CHECK(Near(data.stepTime[3], 3.0f));
+		CHECK(data.timedOut[0]);
+		CHECK(Near(data.stepTime[4], 3.5f));
+	}
+
+	// Condition already true: no tick is spent waiting
+	{
+		TestData data;
+		ResetData(data);
+		data.condition = true;
+		StartScript(data.script, 0.0f);
+
+		for (int t = 0; t <= 30; t++)
+		{
+			Tick(RunSequence, data, TickTime(t));
+		}
+
+		CHECK(Near(data.stepTime[2], 1.0f));
+		CHECK(Near(data.stepTime[3], 1.0f));
+	}
+}
+
+static void TestCancelAndRestart()
+{
+	TestData data;
+	ResetData(data);
+	StartScript(data.script, 0.0f);
+
+	// Cancel while sleeping in the first wait
+	for (int t = 0; t <= 5; t++)
+	{
+		Tick(RunSequence, data, TickTime(t));
+	}
+	CHECK(data.step == 1);
+	StopScript(data.script);
+	CHECK(!IsScriptRunning(data.script));
+
+	int entries = data.entries;
+	for (int t = 6; t <= 40; t++)
+	{
+		Tick(RunSequence, data, TickTime(t));
+	}
+	CHECK(data.entries == entries);
+	CHECK(data.step == 1);
+
+	// Restart runs from the top again
+	data.condition = true;
+	StartScript(data.script, 4.0f);
+	for (int t = 40; t <= 70; t++)
+	{
+		Tick(RunSequence, data, TickTime(t));
+	}
+	CHECK(data.step == 4);
+	CHECK(Near(data.stepTime[1], 4.0f));
+	CHECK(Near(data.stepTime[2], 5.0f));
+	CHECK(Near(data.stepTime[4], 5.5f));
+
+	// Restart while running also goes back to the top
+	ResetData(data);
+	StartScript(data.script, 0.0f);
+	for (int t = 0; t <= 12; t++)
+	{
+		Tick(RunSequence, data, TickTime(t));
+	}
+	CHECK(data.step == 2);
+	StartScript(data.script, TickTime(13));
+	Tick(RunSequence, data, TickTime(13));
+	CHECK(data.step == 1);
+	CHECK(Near(data.stepTime[1], 1.3f));
+}
+
+static void TestCopyResume()
+{
+	TestData entries[2];
+	ResetData(entries[0]);
+	ResetData(entries[1]);
+	StartScript(entries[1].script, 0.0f);
+
+	for (int t = 0; t <= 12; t++)
+	{
+		Tick(RunSequence, entries[1], TickTime(t));
+	}
+	CHECK(entries[1].step == 2);
+
+	// Remove entry 0 by shifting entry 1 down, as the per-horse arrays do
+	entries[0] = entries[1];
+	ResetData(entries[1]);
+
+	entries[0].condition = true;
+	for (int t = 13; t <= 30; t++)
+	{
+		Tick(RunSequence, entries[0], TickTime(t));
+	}
+	CHECK(entries[0].step == 4);
+	CHECK(Near(entries[0].stepTime[3], 1.3f));
+	CHECK(Near(entries[0].stepTime[4], 1.8f));
+}
+
+static void TestLoopAndExit()
+{
+	TestData data;
+	ResetData(data);
+	StartScript(data.script, 0.0f);
+
+	for (int t = 0; t <= 20; t++)
+	{
+		Tick(RunLoop, data, TickTime(t));
+	}
+	CHECK(data.loops == 5);
+	CHECK(Near(data.stepTime[1], 0.4f));
+	CHECK(!IsScriptRunning(data.script));
+}
+
+static void TestAnimEvents()
+{
+	const uint32_t RIDER = 0x00012345;
+	const uint32_t OTHER = 0x00054321;
+
+	ClearAnimationEvents();
+
+	// Unwatched actors are ignored
+	PostAnimationEvent(RIDER, "BowDrawn");
+	CHECK(!HasAnimationEventSince(RIDER, "BowDrawn", 0));
+
+	CHECK(WatchAnimationEvents(RIDER));
+	CHECK(WatchAnimationEvents(RIDER));   // Already watched
+	CHECK(IsWatchingAnimationEvents(RIDER));
+	CHECK(!IsWatchingAnimationEvents(OTHER));
+
+	// An event sent before the wait began does not end it
+	PostAnimationEvent(RIDER, "BowDrawn");
+
+	TestData data;
+	ResetData(data);
+	data.formID = RIDER;
+	StartScript(data.script, 0.0f);
+
+	for (int t = 0; t <= 3; t++)
+	{
+		Tick(RunAnimWait, data, TickTime(t));
+	}
+	CHECK(data.step == 1);
+
+	// Other tags and other actors do not end it either
+	CHECK(WatchAnimationEvents(OTHER));
+	PostAnimationEvent(RIDER, "BowRelease");
+	PostAnimationEvent(OTHER, "BowDrawn");
+	Tick(RunAnimWait, data, TickTime(4));
+	CHECK(data.step == 1);
+
+	// The right event, in another case
+	PostAnimationEvent(RIDER, "bowdrawn");
+	Tick(RunAnimWait, data, TickTime(5));
+	CHECK(data.step == 2);
+	CHECK(!data.timedOut[0]);
+	CHECK(Near(data.stepTime[2], 0.5f));
+
+	// No event: the wait times out
+	ResetData(data);
+	data.formID = RIDER;
+	StartScript(data.script, 1.0f);
+	for (int t = 10; t <= 30; t++)
+	{
+		Tick(RunAnimWait, data, TickTime(t));
+	}
+	CHECK(data.step == 2);
+	CHECK(data.timedOut[0]);
+	CHECK(Near(data.stepTime[2], 2.0f));
+
+	// Unwatched again: events are dropped
+	UnwatchAnimationEvents(RIDER);
+	CHECK(!IsWatchingAnimationEvents(RIDER));
+	uint32_t sequence = GetAnimationEventSequence();
+	PostAnimationEvent(RIDER, "BowDrawn");
+	CHECK(!HasAnimationEventSince(RIDER, "BowDrawn", sequence));
+	CHECK(GetAnimationEventSequence() == sequence);
+
+	// Only the most recent ANIM_EVENT_RING_SIZE events are kept
+	CHECK(WatchAnimationEvents(RIDER));
+	sequence = GetAnimationEventSequence();
+	PostAnimationEvent(RIDER, "BowDrawn");
+	for (int i = 0; i < ANIM_EVENT_RING_SIZE - 1; i++) PostAnimationEvent(OTHER, "FootLeft");
+	CHECK(HasAnimationEventSince(RIDER, "BowDrawn", sequence));
+	PostAnimationEvent(OTHER, "FootLeft");
+	CHECK(!HasAnimationEventSince(RIDER, "BowDrawn", sequence));
+
+	// Watch slots run out
+	ClearAnimationEvents();
+	for (int i = 0; i < ANIM_EVENT_WATCH_SLOTS; i++) CHECK(WatchAnimationEvents(0x100 + i));
+	CHECK(!WatchAnimationEvents(0x900));
+	UnwatchAnimationEvents(0x100);
+	CHECK(WatchAnimationEvents(0x900));
+	ClearAnimationEvents();
+	CHECK(!IsWatchingAnimationEvents(0x900));
+}
+
+int main()
+{
+	TestWaits();
+	TestCancelAndRestart();
+	TestCopyResume();
+	TestLoopAndExit();
+	TestAnimEvents();
+
+	if (g_failures == 0)
+	{
+		std::printf("ManeuverScriptTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("ManeuverScriptTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
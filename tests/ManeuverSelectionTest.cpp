@@ -0,0 +1,168 @@
+// ============================================
+// MANEUVER SELECTION TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/ManeuverSelectionTest.cpp ManeuverSelection.cpp -o maneuver_selection_test
+//     ./maneuver_selection_test
+//
+// Enumerates every roll ArbitrateManeuvers can make for random score
+// sets (5 kinds, scores 0..60) and checks the pick distribution:
+// - scores adding up to 100 or less: each kind is picked for exactly
+//   'score' of the 100 rolls, nothing for the rest
+// - above 100: each kind for exactly 'score' of 'total' rolls, and
+//   something is always picked
+// - kinds scored 0 are never picked
+// - fall-through when the pick fails to start: the failed kind's share
+//   goes to the others in proportion to their scores
+// ============================================
+
+#include "ManeuverSelection.h"
+#include <cstdio>
+#include <random>
+
+using namespace MountedNPCCombatVR;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static const int KINDS = 5;
+
+static void TestFixedCases()
+{
+	int none[KINDS] = { 0, 0, 0, 0, 0 };
+	CHECK(SumManeuverScores(none, KINDS) == 0);
+	CHECK(GetManeuverRollRange(none, KINDS) == 100);
+	CHECK(PickManeuver(none, KINDS, 0) == -1);
+
+	// Bands in kind order: [0,10) -> 0, [10,40) -> 2, [40,100) -> none
+	int scores[KINDS] = { 10, 0, 30, 0, 0 };
+	CHECK(PickManeuver(scores, KINDS, 0) == 0);
+	CHECK(PickManeuver(scores, KINDS, 9) == 0);
+	CHECK(PickManeuver(scores, KINDS, 10) == 2);
+	CHECK(PickManeuver(scores, KINDS, 39) == 2);
+	CHECK(PickManeuver(scores, KINDS, 40) == -1);
+	CHECK(PickManeuver(scores, KINDS, 99) == -1);
+
+	// Negative scores count as not eligible
+	int negative[KINDS] = { -5, 20, 0, 0, 0 };
+	CHECK(SumManeuverScores(negative, KINDS) == 20);
+	CHECK(PickManeuver(negative, KINDS, 0) == 1);
+
+	int over[KINDS] = { 60, 50, 40, 0, 0 };
+	CHECK(GetManeuverRollRange(over, KINDS) == 150);
+	CHECK(PickManeuver(over, KINDS, 149) == 2);
+}
+
+static void TestDistribution(std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> scoreDist(0, 60);
+	std::uniform_int_distribution<int> zeroDist(0, 2);
+
+	for (int trial = 0; trial < 2000; trial++)
+	{
+		int scores[KINDS];
+		for (int k = 0; k < KINDS; k++)
+		{
+			scores[k] = (zeroDist(rng) == 0) ? 0 : scoreDist(rng);
+		}
+
+		int total = SumManeuverScores(scores, KINDS);
+		int range = GetManeuverRollRange(scores, KINDS);
+		CHECK(range == (total > 100 ? total : 100));
+
+		int picks[KINDS] = { 0, 0, 0, 0, 0 };
+		int nothing = 0;
+		for (int roll = 0; roll < range; roll++)
+		{
+			int kind = PickManeuver(scores, KINDS, roll);
+			if (kind < 0) nothing++;
+			else picks[kind]++;
+		}
+
+		for (int k = 0; k < KINDS; k++)
+		{
+			CHECK(picks[k] == scores[k]);
+		}
+		CHECK(nothing == range - total);
+
+		if (g_failures > 10) return;
+	}
+}
+
+// Exact distribution of ArbitrateManeuvers when 'failing' never starts:
+// every first roll, and after a failed pick every fall-through roll
+// over the remaining total (weighted so each first roll counts equally)
+static void TestFallThrough(std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> scoreDist(1, 60);
+	std::uniform_int_distribution<int> kindDist(0, KINDS - 1);
+
+	for (int trial = 0; trial < 500; trial++)
+	{
+		int scores[KINDS];
+		for (int k = 0; k < KINDS; k++) scores[k] = scoreDist(rng);
+		int failing = kindDist(rng);
+
+		int total = SumManeuverScores(scores, KINDS);
+		int range = GetManeuverRollRange(scores, KINDS);
+
+		int remainingScores[KINDS];
+		for (int k = 0; k < KINDS; k++) remainingScores[k] = scores[k];
+		remainingScores[failing] = 0;
+		int remaining = SumManeuverScores(remainingScores, KINDS);
+
+		// Weight of each outcome, out of range * remaining
+		long long started[KINDS] = { 0, 0, 0, 0, 0 };
+		long long nothing = 0;
+		for (int roll = 0; roll < range; roll++)
+		{
+			int kind = PickManeuver(scores, KINDS, roll);
+			if (kind < 0)
+			{
+				nothing += remaining;
+			}
+			else if (kind != failing)
+			{
+				started[kind] += remaining;
+			}
+			else
+			{
+				for (int roll2 = 0; roll2 < remaining; roll2++)
+				{
+					int next = PickManeuver(remainingScores, KINDS, roll2);
+					CHECK(next >= 0 && next != failing);
+					if (next >= 0) started[next]++;
+				}
+			}
+		}
+
+		// P(k) = s_k / range * (1 + s_failing / remaining)
+		for (int k = 0; k < KINDS; k++)
+		{
+			long long expected = (k == failing) ? 0 : (long long)scores[k] * (remaining + scores[failing]);
+			CHECK(started[k] == expected);
+		}
+		CHECK(nothing == (long long)(range - total) * remaining);
+
+		if (g_failures > 10) return;
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(48);
+
+	TestFixedCases();
+	TestDistribution(rng);
+	TestFallThrough(rng);
+
+	if (g_failures == 0)
+	{
+		std::printf("ManeuverSelectionTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("ManeuverSelectionTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,135 @@
+// ============================================
+// OCCUPANCY GRID BENCHMARK (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/OccupancyGridBench.cpp OccupancyGridMath.cpp -o occupancy_grid_bench
+//     ./occupancy_grid_bench
+//
+// Per-tick cost of one encounter grid, the way UpdateOccupancyGrids and
+// FindClearLateralOffset use it:
+// - stamp: ClearGrid + OCC_MAX_ACTORS point stamps + mount discs
+// - query: one lane search per mount, with its own footprint left out,
+//   in an open field (first lane clear) and in a crowd (mostly blocked)
+// - worst case: every lane blocked (all 2 * OCC_LATERAL_STEPS tried)
+// ============================================
+
+#include "OccupancyGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace MountedNPCCombatVR::Occupancy;
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Scene
+{
+	float actorX[OCC_MAX_ACTORS];
+	float actorY[OCC_MAX_ACTORS];
+	Footprint mounts[32];
+	float headings[32];
+	int mountCount;
+};
+
+static void BuildScene(Scene& scene, int mountCount, float spread, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> pos(-spread, spread);
+	std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+	for (int i = 0; i < OCC_MAX_ACTORS; i++)
+	{
+		scene.actorX[i] = pos(rng);
+		scene.actorY[i] = pos(rng);
+	}
+	scene.mountCount = mountCount;
+	for (int m = 0; m < mountCount; m++)
+	{
+		scene.mounts[m].x = pos(rng);
+		scene.mounts[m].y = pos(rng);
+		scene.mounts[m].radiusCells = OCC_MOUNT_RADIUS;
+		scene.headings[m] = angle(rng);
+	}
+}
+
+static void StampScene(OccupancyGrid& grid, const Scene& scene)
+{
+	ClearGrid(grid, 0.0f, 0.0f);
+	for (int i = 0; i < OCC_MAX_ACTORS; i++)
+	{
+		StampDisc(grid, grid.actors, scene.actorX[i], scene.actorY[i], 0);
+	}
+	for (int m = 0; m < scene.mountCount; m++)
+	{
+		StampDisc(grid, grid.actors, scene.mounts[m].x, scene.mounts[m].y, scene.mounts[m].radiusCells);
+	}
+}
+
+static void RunScene(const char* name, float spread)
+{
+	static OccupancyGrid grid;
+	memset(&grid, 0, sizeof(grid));
+
+	Scene scene;
+	BuildScene(scene, 32, spread, 7);
+
+	const int ITERATIONS = 20000;
+	int found = 0;
+
+	double start = NowNs();
+	for (int it = 0; it < ITERATIONS; it++)
+	{
+		StampScene(grid, scene);
+	}
+	double stampNs = (NowNs() - start) / ITERATIONS;
+
+	start = NowNs();
+	for (int it = 0; it < ITERATIONS; it++)
+	{
+		for (int m = 0; m < scene.mountCount; m++)
+		{
+			float lateral = 0.0f;
+			found += FindClearLateralOffsetInGrid(grid, scene.mounts[m].x, scene.mounts[m].y, scene.headings[m],
+				1, lateral, &scene.mounts[m]) ? 1 : 0;
+		}
+	}
+	double queryNs = (NowNs() - start) / ((double)ITERATIONS * scene.mountCount);
+
+	std::printf("%-10s stamp %7.0f ns/tick   query %6.0f ns/horse   lanes found %5.1f%%\n",
+		name, stampNs, queryNs, 100.0 * found / ((double)ITERATIONS * scene.mountCount));
+}
+
+static void RunWorstCase()
+{
+	static OccupancyGrid grid;
+	memset(&grid, 0, sizeof(grid));
+	ClearGrid(grid, 0.0f, 0.0f);
+	memset(grid.hazards, 1, sizeof(grid.hazards));
+
+	const int ITERATIONS = 200000;
+	int found = 0;
+	double start = NowNs();
+	for (int it = 0; it < ITERATIONS; it++)
+	{
+		float lateral = 0.0f;
+		found += FindClearLateralOffsetInGrid(grid, 0.0f, 0.0f, it * 0.001f, 1, lateral) ? 1 : 0;
+	}
+	double queryNs = (NowNs() - start) / ITERATIONS;
+	std::printf("%-10s query %6.0f ns (every lane tried, found %d)\n", "walled", queryNs, found);
+}
+
+int main()
+{
+	std::printf("OccupancyGridBench: %d x %d cells, %d actors + 32 mounts per grid\n",
+		OCC_GRID_DIM, OCC_GRID_DIM, OCC_MAX_ACTORS);
+	RunScene("open", OCC_GRID_SPAN * 0.5f);
+	RunScene("crowd", 900.0f);
+	RunWorstCase();
+	return 0;
+}
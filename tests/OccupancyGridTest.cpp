@@ -0,0 +1,175 @@
+// ============================================
+// OCCUPANCY GRID TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/OccupancyGridTest.cpp OccupancyGridMath.cpp -o occupancy_grid_test
+//     ./occupancy_grid_test
+//
+// Checks the engine-independent grid functions:
+// - ClearGrid snaps the origin to OCC_ORIGIN_SNAP and reports moves
+// - a horse's own mount stamp never blocks its lanes, wherever it
+//   stands in its cell and whichever way it faces (this used to fail:
+//   the 3 x 3 self stamp reaches past OCC_SELF_CLEARANCE)
+// - another horse on the same spot still blocks (stamps are counted)
+// - lanes: nearest first, preferred side first, walls and full
+//   enclosure, hazard layer, outside the grid is free
+// - IsPathClear does not skip cells on diagonals
+// ============================================
+
+#include "OccupancyGrid.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace MountedNPCCombatVR::Occupancy;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static OccupancyGrid g_grid;
+
+static void ResetGrid(float centerX, float centerY)
+{
+	memset(&g_grid, 0, sizeof(g_grid));
+	ClearGrid(g_grid, centerX, centerY);
+}
+
+static void TestClearGrid()
+{
+	memset(&g_grid, 0, sizeof(g_grid));
+	CHECK(ClearGrid(g_grid, 1000.0f, -1000.0f));
+	CHECK(std::fmod(g_grid.originX + OCC_GRID_SPAN * 0.5f, OCC_ORIGIN_SNAP) == 0.0f);
+	CHECK(std::fmod(g_grid.originY + OCC_GRID_SPAN * 0.5f, OCC_ORIGIN_SNAP) == 0.0f);
+
+	// Inside the same snap square: no move, actor layer cleared
+	StampDisc(g_grid, g_grid.actors, 1000.0f, -1000.0f, 2);
+	CHECK(!ClearGrid(g_grid, 1010.0f, -990.0f));
+	bool anyActor = false;
+	for (int i = 0; i < OCC_GRID_DIM * OCC_GRID_DIM; i++) anyActor |= (g_grid.actors[i] != 0);
+	CHECK(!anyActor);
+
+	// Next snap square: moved
+	CHECK(ClearGrid(g_grid, 1000.0f + OCC_ORIGIN_SNAP, -1000.0f));
+}
+
+static void TestSelfFootprint()
+{
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> offset(-OCC_CELL_SIZE, OCC_CELL_SIZE);
+	std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+	int blockedWithoutSelf = 0;
+	for (int i = 0; i < 20000; i++)
+	{
+		ResetGrid(0.0f, 0.0f);
+		Footprint self = { offset(rng), offset(rng), OCC_MOUNT_RADIUS };
+		StampDisc(g_grid, g_grid.actors, self.x, self.y, self.radiusCells);
+
+		float heading = angle(rng);
+		float lateral = 0.0f;
+		bool found = FindClearLateralOffsetInGrid(g_grid, self.x, self.y, heading, 1, lateral, &self);
+		CHECK(found && lateral == OCC_LATERAL_STEP);
+		if (g_failures > 10) return;
+
+		// Without the footprint the old query finds its own stamp somewhere
+		float unused = 0.0f;
+		if (!FindClearLateralOffsetInGrid(g_grid, self.x, self.y, heading, 1, unused) || unused != OCC_LATERAL_STEP)
+		{
+			blockedWithoutSelf++;
+		}
+	}
+	std::printf("self stamp blocked the nearest lane in %d of 20000 queries without the footprint\n", blockedWithoutSelf);
+	CHECK(blockedWithoutSelf > 0);
+
+	// A second horse on the same spot is still an obstacle
+	ResetGrid(0.0f, 0.0f);
+	Footprint self = { 10.0f, 10.0f, OCC_MOUNT_RADIUS };
+	StampDisc(g_grid, g_grid.actors, self.x, self.y, self.radiusCells);
+	StampDisc(g_grid, g_grid.actors, self.x, self.y, self.radiusCells);
+	CHECK(IsBlockedAt(g_grid, self.x, self.y, &self));
+	CHECK(!IsBlockedAt(g_grid, self.x, self.y + 5.0f * OCC_CELL_SIZE, &self));
+}
+
+static void TestLanes()
+{
+	// Heading north (0): right is +x
+	ResetGrid(0.0f, 0.0f);
+	float lateral = 0.0f;
+	CHECK(FindClearLateralOffsetInGrid(g_grid, 0.0f, 0.0f, 0.0f, -1, lateral));
+	CHECK(lateral == -OCC_LATERAL_STEP);
+	CHECK(FindClearLateralOffsetInGrid(g_grid, 0.0f, 0.0f, 0.0f, 1, lateral));
+	CHECK(lateral == OCC_LATERAL_STEP);
+
+	// Wall across the whole right half ahead: left lane wins even when right is preferred
+	for (float x = 0.0f; x < 1200.0f; x += OCC_CELL_SIZE * 0.5f)
+	{
+		for (float y = 150.0f; y < 700.0f; y += OCC_CELL_SIZE * 0.5f)
+		{
+			StampDisc(g_grid, g_grid.actors, x, y, 0);
+		}
+	}
+	CHECK(FindClearLateralOffsetInGrid(g_grid, 0.0f, 0.0f, 0.0f, 1, lateral));
+	CHECK(lateral < 0.0f);
+
+	// Same wall on the left too: nothing
+	for (float x = -1200.0f; x < 0.0f; x += OCC_CELL_SIZE * 0.5f)
+	{
+		for (float y = 150.0f; y < 700.0f; y += OCC_CELL_SIZE * 0.5f)
+		{
+			StampDisc(g_grid, g_grid.actors, x, y, 0);
+		}
+	}
+	CHECK(!FindClearLateralOffsetInGrid(g_grid, 0.0f, 0.0f, 0.0f, 1, lateral));
+
+	// Hazard layer blocks, and survives ClearGrid
+	ResetGrid(0.0f, 0.0f);
+	g_grid.hazards[(OCC_GRID_DIM / 2 + 3) * OCC_GRID_DIM + OCC_GRID_DIM / 2] = 1;
+	ClearGrid(g_grid, 0.0f, 0.0f);
+	CHECK(IsBlockedAt(g_grid, 10.0f, 3.0f * OCC_CELL_SIZE + 10.0f));
+
+	// Outside the grid is free
+	CHECK(!IsBlockedAt(g_grid, OCC_GRID_SPAN, 0.0f));
+	CHECK(!IsBlockedAt(g_grid, -OCC_GRID_SPAN, 0.0f));
+}
+
+static void TestDiagonalPath()
+{
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> cell(4, OCC_GRID_DIM - 5);
+	for (int i = 0; i < 2000; i++)
+	{
+		ResetGrid(0.0f, 0.0f);
+		int col = cell(rng);
+		int row = cell(rng);
+		float cx = g_grid.originX + (col + 0.5f) * OCC_CELL_SIZE;
+		float cy = g_grid.originY + (row + 0.5f) * OCC_CELL_SIZE;
+		StampDisc(g_grid, g_grid.actors, cx, cy, 0);
+
+		// Diagonal through the blocked cell's centre
+		CHECK(!IsPathClear(g_grid, cx - 300.0f, cy - 300.0f, cx + 300.0f, cy + 300.0f));
+		CHECK(!IsPathClear(g_grid, cx - 300.0f, cy + 300.0f, cx + 300.0f, cy - 300.0f));
+		// Parallel line two cells away
+		CHECK(IsPathClear(g_grid, cx - 300.0f, cy - 300.0f + 2.5f * OCC_CELL_SIZE,
+			cx + 300.0f, cy + 300.0f + 2.5f * OCC_CELL_SIZE));
+		if (g_failures > 10) return;
+	}
+}
+
+int main()
+{
+	TestClearGrid();
+	TestSelfFootprint();
+	TestLanes();
+	TestDiagonalPath();
+
+	if (g_failures == 0)
+	{
+		std::printf("OccupancyGridTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("OccupancyGridTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,116 @@
+// ============================================
+// PROFILER HISTOGRAM TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/ProfilerHistogramTest.cpp ProfilerHistogram.cpp -o profiler_histogram_test
+//     ./profiler_histogram_test
+//
+// Checks:
+// - every value lands in a bucket whose range contains it
+// - bucket indices are monotonic in the value
+// - a bucket's upper bound is within 25% of any value it holds
+// - GetPercentile agrees with the exact percentile of the samples to
+//   within one bucket
+// ============================================
+
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MountedNPCCombatVR::Profiler;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static uint64_t BucketLowerBound(int bucket)
+{
+	return (bucket == 0) ? 0 : GetBucketUpperBound(bucket - 1) + 1;
+}
+
+static void TestBucketRanges()
+{
+	int lastIndex = 0;
+	for (uint64_t ns = 0; ns < 1000000; ns++)
+	{
+		int index = GetBucketIndex(ns);
+		CHECK(index >= lastIndex);
+		CHECK(ns >= BucketLowerBound(index));
+		CHECK(ns <= GetBucketUpperBound(index));
+		lastIndex = index;
+		if (g_failures > 10) return;
+	}
+}
+
+static void TestRelativeError()
+{
+	std::mt19937_64 rng(12345);
+	for (int i = 0; i < 200000; i++)
+	{
+		uint64_t ns = rng() >> (rng() % 40 + 20);   // Spread over many octaves
+		if (ns < 8) continue;
+		int index = GetBucketIndex(ns);
+		if (index == HISTOGRAM_BUCKETS - 1) continue;   // Overflow bucket is open-ended
+		double error = (double)(GetBucketUpperBound(index) - ns) / (double)ns;
+		CHECK(error <= 0.25);
+	}
+}
+
+static void TestBucketsTileTheRange()
+{
+	for (int b = 1; b < HISTOGRAM_BUCKETS; b++)
+	{
+		CHECK(GetBucketUpperBound(b) > GetBucketUpperBound(b - 1));
+		CHECK(GetBucketIndex(BucketLowerBound(b)) == b);
+		CHECK(GetBucketIndex(GetBucketUpperBound(b)) == b || b == HISTOGRAM_BUCKETS - 1);
+	}
+}
+
+static void TestPercentiles()
+{
+	std::mt19937_64 rng(777);
+	std::lognormal_distribution<double> dist(10.0, 1.5);   // ~20us median, long tail
+
+	for (int trial = 0; trial < 20; trial++)
+	{
+		std::vector<uint64_t> samples;
+		uint64_t buckets[HISTOGRAM_BUCKETS] = {};
+		int count = 1000 + trial * 500;
+		for (int i = 0; i < count; i++)
+		{
+			uint64_t ns = (uint64_t)dist(rng);
+			samples.push_back(ns);
+			buckets[GetBucketIndex(ns)]++;
+		}
+		std::sort(samples.begin(), samples.end());
+
+		const float percentiles[] = { 50.0f, 95.0f, 99.0f, 100.0f };
+		for (float p : percentiles)
+		{
+			uint64_t rank = (uint64_t)((double)count * p / 100.0 + 0.5);
+			if (rank < 1) rank = 1;
+			uint64_t exact = samples[rank - 1];
+			uint64_t reported = GetPercentile(buckets, (uint64_t)count, p);
+
+			// Reported value is the upper bound of the exact value's bucket
+			CHECK(reported == GetBucketUpperBound(GetBucketIndex(exact)));
+		}
+	}
+
+	uint64_t empty[HISTOGRAM_BUCKETS] = {};
+	CHECK(GetPercentile(empty, 0, 50.0f) == 0);
+}
+
+int main()
+{
+	TestBucketRanges();
+	TestBucketsTileTheRange();
+	TestRelativeError();
+	TestPercentiles();
+
+	if (g_failures == 0) std::printf("ProfilerHistogramTest: all checks passed\n");
+	return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// ============================================
+// REMOUNT ASSIGNMENT TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/RemountAssignmentTest.cpp RemountAssignment.cpp -o remount_assignment_test
+//     ./remount_assignment_test
+//
+// Compares SolveRemountAssignment (Hungarian) with brute force over all
+// permutations on random instances of size 1..8:
+// - the result is a permutation (each horse used once)
+// - its total cost equals the brute-force optimum
+// Instances mix plain distances, the scanner's owner bonus / owned
+// penalty, padding rows/columns (more NPCs than horses or the reverse)
+// and many ties.
+// ============================================
+
+#include "RemountAssignment.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace MountedNPCCombatVR;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+// Same constants as HorseMountScanner.cpp
+static const float OWNER_BONUS = 2000.0f;
+static const float OWNED_HORSE_PENALTY = 4000.0f;
+static const float UNASSIGNED_COST = 1000000.0f;
+
+static const int MAX_BRUTE_FORCE_N = 8;
+static const int INSTANCES_PER_SIZE = 400;
+
+static double TotalCost(float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int n, const int* rowToCol)
+{
+	double total = 0.0;
+	for (int r = 0; r < n; r++) total += cost[r][rowToCol[r]];
+	return total;
+}
+
+static double BruteForceOptimum(float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int n)
+{
+	int perm[REMOUNT_MATRIX_DIM];
+	for (int i = 0; i < n; i++) perm[i] = i;
+
+	double best = 1e300;
+	do
+	{
+		double total = TotalCost(cost, n, perm);
+		if (total < best) best = total;
+	}
+	while (std::next_permutation(perm, perm + n));
+	return best;
+}
+
+static bool IsPermutation(const int* rowToCol, int n)
+{
+	bool seen[REMOUNT_MATRIX_DIM] = {};
+	for (int r = 0; r < n; r++)
+	{
+		if (rowToCol[r] < 0 || rowToCol[r] >= n || seen[rowToCol[r]]) return false;
+		seen[rowToCol[r]] = true;
+	}
+	return true;
+}
+
+// Build a matrix the way CheckAndTriggerMounting does
+static void BuildScannerInstance(std::mt19937& rng, float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int& outN)
+{
+	int npcCount = 1 + (int)(rng() % MAX_BRUTE_FORCE_N);
+	int horseCount = 1 + (int)(rng() % MAX_BRUTE_FORCE_N);
+	int n = std::max(npcCount, horseCount);
+
+	std::uniform_real_distribution<float> coord(-3000.0f, 3000.0f);
+	float npcPos[REMOUNT_MATRIX_DIM][3];
+	float horsePos[REMOUNT_MATRIX_DIM][3];
+	int horseOwner[REMOUNT_MATRIX_DIM];
+
+	for (int i = 0; i < npcCount; i++)
+	{
+		for (int k = 0; k < 3; k++) npcPos[i][k] = coord(rng);
+	}
+	for (int c = 0; c < horseCount; c++)
+	{
+		for (int k = 0; k < 3; k++) horsePos[c][k] = coord(rng);
+		// Some horses are owned by one of the NPCs, some by nobody
+		horseOwner[c] = (rng() % 3 == 0) ? -1 : (int)(rng() % npcCount);
+	}
+
+	for (int r = 0; r < n; r++)
+	{
+		for (int c = 0; c < n; c++)
+		{
+			if (r >= npcCount || c >= horseCount)
+			{
+				cost[r][c] = UNASSIGNED_COST;
+				continue;
+			}
+
+			float dx = npcPos[r][0] - horsePos[c][0];
+			float dy = npcPos[r][1] - horsePos[c][1];
+			float dz = npcPos[r][2] - horsePos[c][2];
+			float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+			if (horseOwner[c] == r) dist -= OWNER_BONUS;
+			else if (horseOwner[c] >= 0) dist += OWNED_HORSE_PENALTY;
+			cost[r][c] = dist;
+		}
+	}
+	outN = n;
+}
+
+// Small integer costs: lots of ties and equal-cost optima
+static void BuildTiedInstance(std::mt19937& rng, float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int& outN)
+{
+	int n = 1 + (int)(rng() % MAX_BRUTE_FORCE_N);
+	for (int r = 0; r < n; r++)
+	{
+		for (int c = 0; c < n; c++)
+		{
+			cost[r][c] = (float)(rng() % 4);
+		}
+	}
+	outN = n;
+}
+
+static void CheckInstance(float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM], int n)
+{
+	int rowToCol[REMOUNT_MATRIX_DIM];
+	for (int r = 0; r < REMOUNT_MATRIX_DIM; r++) rowToCol[r] = -1;
+
+	SolveRemountAssignment(cost, n, rowToCol);
+
+	bool permutation = IsPermutation(rowToCol, n);
+	CHECK(permutation);
+	if (!permutation) return;
+
+	double hungarian = TotalCost(cost, n, rowToCol);
+	double optimum = BruteForceOptimum(cost, n);
+
+	// Costs reach 1e6 (padding), so compare relative to the magnitude
+	double tolerance = 1e-5 * std::max(1.0, std::fabs(optimum));
+	if (std::fabs(hungarian - optimum) > tolerance)
+	{
+		std::printf("  n=%d hungarian %.3f brute force %.3f\n", n, hungarian, optimum);
+		g_failures++;
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(4242);
+	float cost[REMOUNT_MATRIX_DIM][REMOUNT_MATRIX_DIM];
+	int n = 0;
+
+	for (int i = 0; i < INSTANCES_PER_SIZE * MAX_BRUTE_FORCE_N; i++)
+	{
+		BuildScannerInstance(rng, cost, n);
+		CheckInstance(cost, n);
+
+		BuildTiedInstance(rng, cost, n);
+		CheckInstance(cost, n);
+
+		if (g_failures > 10) break;
+	}
+
+	// Full-size matrix still returns a permutation (too big for brute force)
+	for (int r = 0; r < REMOUNT_MATRIX_DIM; r++)
+	{
+		for (int c = 0; c < REMOUNT_MATRIX_DIM; c++) cost[r][c] = (float)((r * 7 + c * 3) % 11);
+	}
+	int rowToCol[REMOUNT_MATRIX_DIM];
+	SolveRemountAssignment(cost, REMOUNT_MATRIX_DIM, rowToCol);
+	CHECK(IsPermutation(rowToCol, REMOUNT_MATRIX_DIM));
+
+	if (g_failures == 0)
+	{
+		std::printf("RemountAssignmentTest: all checks passed\n");
+		return 0;
+	}
+	std::printf("RemountAssignmentTest: %d check(s) failed\n", g_failures);
+	return 1;
+}
@@ -0,0 +1,300 @@
+// ============================================
+// RIDER TABLE BENCHMARK (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. tests/RiderTableBench.cpp -o rider_table_bench
+//     ./rider_table_bench
+//
+// Compares the old rider table (one MountedNPCData record per rider,
+// hot and cold fields together) with the hot columns in MountedCombat.h
+// (RiderHotColumns + cold records). The two layouts are copied here as
+// templates so the table can be sized past MAX_TRACKED_NPCS (10 in the
+// game, up to 200 in tests/CombatSimBench.cpp).
+//
+// One simulated tick runs the scans the rider loop does:
+// - FindRiderSlot for every tracked rider (formID lookup)
+// - the attack-slot count for every rider (riders in Attacking/Engaging
+//   on the same target)
+// - the update-interval check over all riders
+// Both layouts must give the same answers; the time per tick and the
+// bytes each full scan strides over are printed.
+// ============================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+typedef uint32_t UInt32;
+
+// Same shapes as MountedCombat.h / WeaponDetection.h
+enum class MountedCombatState { None = 0, Engaging, Attacking, Fleeing, Retreating };
+enum class MountedBehaviorType { Unknown = 0, Aggressive, Defensive };
+enum class MountedCombatClass { None = 0, GuardMelee, SoldierMelee, BanditRanged, MageCaster, CivilianFlee };
+enum class WeaponType { None = 0, OneHandSword, Bow };
+
+struct MountedWeaponInfo
+{
+	bool hasWeaponEquipped = false;
+	bool hasWeaponSheathed = false;
+	bool isBow = false;
+	bool isShieldEquipped = false;
+	bool hasBowInInventory = false;
+	bool hasMeleeInInventory = false;
+	WeaponType mainHandType = WeaponType::None;
+	WeaponType offHandType = WeaponType::None;
+	float weaponReach = 0.0f;
+};
+
+// ============================================
+// OLD LAYOUT (array of records)
+// ============================================
+
+struct OldRiderRecord
+{
+	UInt32 actorFormID;
+	UInt32 mountFormID;
+	UInt32 targetFormID;
+	UInt32 allocatedTargetFormID;
+	MountedCombatState state;
+	MountedBehaviorType behavior;
+	MountedCombatClass combatClass;
+	MountedWeaponInfo weaponInfo;
+	float stateStartTime;
+	float lastUpdateTime;
+	float combatStartTime;
+	bool weaponDrawn;
+	bool isValid;
+};
+
+template <int N>
+struct OldTable
+{
+	OldRiderRecord riders[N];
+
+	int FindRiderSlot(UInt32 formID) const
+	{
+		for (int i = 0; i < N; i++)
+		{
+			if (riders[i].isValid && riders[i].actorFormID == formID) return i;
+		}
+		return -1;
+	}
+
+	int CountAttackers(UInt32 targetFormID) const
+	{
+		int count = 0;
+		for (int i = 0; i < N; i++)
+		{
+			if (!riders[i].isValid || riders[i].targetFormID != targetFormID) continue;
+			if (riders[i].state == MountedCombatState::Attacking || riders[i].state == MountedCombatState::Engaging) count++;
+		}
+		return count;
+	}
+
+	int CountDue(float now, float interval) const
+	{
+		int count = 0;
+		for (int i = 0; i < N; i++)
+		{
+			if (riders[i].isValid && (now - riders[i].lastUpdateTime) >= interval) count++;
+		}
+		return count;
+	}
+};
+
+// ============================================
+// NEW LAYOUT (hot columns + cold records)
+// ============================================
+
+template <int N>
+struct HotColumns
+{
+	UInt32 actorFormID[N];
+	UInt32 mountFormID[N];
+	UInt32 targetFormID[N];
+	MountedCombatState state[N];
+	float stateStartTime[N];
+	float lastUpdateTime[N];
+	bool valid[N];
+};
+
+struct ColdRecord
+{
+	int riderIndex;
+	UInt32 allocatedTargetFormID;
+	MountedBehaviorType behavior;
+	MountedCombatClass combatClass;
+	MountedWeaponInfo weaponInfo;
+	float combatStartTime;
+	bool weaponDrawn;
+};
+
+template <int N>
+struct NewTable
+{
+	HotColumns<N> hot;
+	ColdRecord cold[N];
+
+	int FindRiderSlot(UInt32 formID) const
+	{
+		for (int i = 0; i < N; i++)
+		{
+			if (hot.valid[i] && hot.actorFormID[i] == formID) return i;
+		}
+		return -1;
+	}
+
+	int CountAttackers(UInt32 targetFormID) const
+	{
+		int count = 0;
+		for (int i = 0; i < N; i++)
+		{
+			if (!hot.valid[i] || hot.targetFormID[i] != targetFormID) continue;
+			if (hot.state[i] == MountedCombatState::Attacking || hot.state[i] == MountedCombatState::Engaging) count++;
+		}
+		return count;
+	}
+
+	int CountDue(float now, float interval) const
+	{
+		int count = 0;
+		for (int i = 0; i < N; i++)
+		{
+			if (hot.valid[i] && (now - hot.lastUpdateTime[i]) >= interval) count++;
+		}
+		return count;
+	}
+};
+
+// ============================================
+// HARNESS
+// ============================================
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <int N>
+static void Fill(OldTable<N>& oldTable, NewTable<N>& newTable, std::vector<UInt32>& lookups, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> stateDist(0, 4);
+	std::uniform_int_distribution<int> targetDist(0, 3);
+	std::uniform_real_distribution<float> timeDist(0.0f, 1.0f);
+
+	lookups.clear();
+	for (int i = 0; i < N; i++)
+	{
+		bool valid = (i % 8) != 7;   // A few free slots
+		UInt32 formID = 0x00100000u + (UInt32)(i * 7 + 3);
+		UInt32 target = 0x00020000u + (UInt32)targetDist(rng);
+		MountedCombatState state = (MountedCombatState)stateDist(rng);
+		float lastUpdate = timeDist(rng);
+
+		OldRiderRecord& rec = oldTable.riders[i];
+		rec = OldRiderRecord();
+		rec.actorFormID = formID;
+		rec.mountFormID = formID + 1;
+		rec.targetFormID = target;
+		rec.state = state;
+		rec.lastUpdateTime = lastUpdate;
+		rec.isValid = valid;
+
+		newTable.hot.actorFormID[i] = formID;
+		newTable.hot.mountFormID[i] = formID + 1;
+		newTable.hot.targetFormID[i] = target;
+		newTable.hot.state[i] = state;
+		newTable.hot.stateStartTime[i] = 0.0f;
+		newTable.hot.lastUpdateTime[i] = lastUpdate;
+		newTable.hot.valid[i] = valid;
+		newTable.cold[i] = ColdRecord();
+		newTable.cold[i].riderIndex = i;
+
+		if (valid) lookups.push_back(formID);
+	}
+	std::shuffle(lookups.begin(), lookups.end(), rng);
+}
+
+// One tick of rider-loop scans; returns a checksum of the answers
+template <typename Table>
+static long long Tick(const Table& table, const std::vector<UInt32>& lookups, float now)
+{
+	long long sum = 0;
+	for (UInt32 formID : lookups)
+	{
+		int slot = table.FindRiderSlot(formID);
+		sum += slot;
+		sum += table.CountAttackers(0x00020000u + (UInt32)(slot & 3)) * 1000;
+	}
+	sum += table.CountDue(now, 0.5f) * 1000000;
+	return sum;
+}
+
+template <int N>
+static void Run(std::mt19937& rng)
+{
+	static OldTable<N> oldTable;
+	static NewTable<N> newTable;
+	std::vector<UInt32> lookups;
+	Fill(oldTable, newTable, lookups, rng);
+
+	CHECK(Tick(oldTable, lookups, 0.75f) == Tick(newTable, lookups, 0.75f));
+	for (UInt32 formID : lookups) CHECK(oldTable.FindRiderSlot(formID) == newTable.FindRiderSlot(formID));
+	CHECK(oldTable.FindRiderSlot(0xDEADBEEF) == -1 && newTable.FindRiderSlot(0xDEADBEEF) == -1);
+
+	// Enough ticks for ~50 ms per layout
+	int ticks = (int)(4000000LL / ((long long)N * N + 1)) + 100;
+	volatile long long sink = 0;
+
+	double best[2] = { 1e30, 1e30 };
+	for (int rep = 0; rep < 5; rep++)
+	{
+		double start = NowNs();
+		for (int t = 0; t < ticks; t++) sink = sink + Tick(oldTable, lookups, 0.5f + (t & 7) * 0.1f);
+		double oldNs = (NowNs() - start) / ticks;
+
+		start = NowNs();
+		for (int t = 0; t < ticks; t++) sink = sink + Tick(newTable, lookups, 0.5f + (t & 7) * 0.1f);
+		double newNs = (NowNs() - start) / ticks;
+
+		if (oldNs < best[0]) best[0] = oldNs;
+		if (newNs < best[1]) best[1] = newNs;
+	}
+
+	// Bytes one full FindRiderSlot scan strides over
+	size_t oldBytes = sizeof(OldRiderRecord) * N;
+	size_t newBytes = (sizeof(UInt32) + sizeof(bool)) * N;
+
+	std::printf("  %3d riders: records %8.0f ns/tick   columns %8.0f ns/tick   (%.2fx)   scan stride %6zu B -> %5zu B\n",
+		N, best[0], best[1], best[0] / best[1], oldBytes, newBytes);
+}
+
+int main()
+{
+	std::mt19937 rng(49);
+
+	std::printf("RiderTableBench: record %zu B (old), hot row %zu B + cold %zu B (new)\n",
+		sizeof(OldRiderRecord), sizeof(HotColumns<1>), sizeof(ColdRecord));
+
+	Run<10>(rng);
+	Run<32>(rng);
+	Run<64>(rng);
+	Run<200>(rng);
+
+	if (g_failures == 0)
+	{
+		std::printf("RiderTableBench: all checks passed\n");
+		return 0;
+	}
+	std::printf("RiderTableBench: %d check(s) failed\n", g_failures);
+	return 1;
+}
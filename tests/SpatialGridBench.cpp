@@ -0,0 +1,278 @@
+// ============================================
+// SPATIAL GRID BENCHMARK (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -I. -Itests/stubs tests/SpatialGridBench.cpp SpatialGridMath.cpp -o spatial_grid_bench
+//     ./spatial_grid_bench
+//
+// 50 / 500 / 5000 actors spread over a 5 x 5 loaded cell grid (20480
+// units a side), most of them in a few settlements. Per actor count:
+// - build: BuildGridIndex over all actors (one rebuild)
+// - radius: QueryIndexRadius, 2000 units (horse scan)
+// - nearest: QueryIndexNearest k = 1 within 4096 with a hostility
+//   filter (FindNearestHostileTarget), and k = 8 (target allocation)
+// Each query is also answered by a linear scan over every actor, the
+// way the scanners worked before the grid, and the answers must match.
+//
+// The game build holds GRID_MAX_ENTRIES actors; the bench passes its
+// own storage so the 5000 case can be built.
+// ============================================
+
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MountedNPCCombatVR::SpatialGrid;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+static const float LOADED_SPAN = 5 * 4096.0f;
+static const float RADIUS_QUERY = 2000.0f;
+static const float NEAREST_QUERY = 4096.0f;
+static const int QUERIES = 1000;
+
+static double NowNs()
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Scenario
+{
+	std::vector<GridEntry> actors;
+	std::vector<bool> hostile;     // By formID
+	std::vector<GridEntry> gathered;
+	std::vector<GridEntry> storage;
+	GridIndex index;
+};
+
+struct FilterContext
+{
+	const GridIndex* index;
+	const std::vector<bool>* hostile;
+};
+
+static bool HostileFilter(int entryIndex, float maxDistSq, float& inOutDistSq, void* context)
+{
+	const FilterContext* filter = static_cast<const FilterContext*>(context);
+	if (inOutDistSq > maxDistSq) return false;
+	return (*filter->hostile)[filter->index->entries[entryIndex].formID];
+}
+
+static void MakeScenario(Scenario& scenario, int count, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> spanDist(0.0f, LOADED_SPAN);
+	std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+	std::normal_distribution<float> townDist(0.0f, 900.0f);
+
+	const int TOWNS = 4;
+	float townX[TOWNS];
+	float townY[TOWNS];
+	for (int t = 0; t < TOWNS; t++)
+	{
+		townX[t] = spanDist(rng);
+		townY[t] = spanDist(rng);
+	}
+
+	scenario.actors.resize(count);
+	scenario.hostile.assign(count, false);
+	for (int i = 0; i < count; i++)
+	{
+		GridEntry& actor = scenario.actors[i];
+		actor.formID = (UInt32)i;
+		if (unitDist(rng) < 0.7f)
+		{
+			int town = i % TOWNS;
+			actor.x = townX[town] + townDist(rng);
+			actor.y = townY[town] + townDist(rng);
+		}
+		else
+		{
+			actor.x = spanDist(rng);
+			actor.y = spanDist(rng);
+		}
+		actor.z = unitDist(rng) * 600.0f;
+		actor.bucket = 0;
+		scenario.hostile[i] = (unitDist(rng) < 0.25f);
+	}
+
+	scenario.gathered = scenario.actors;
+	scenario.storage.resize(count);
+	scenario.index.entries = scenario.storage.data();
+}
+
+static float DistSq(const GridEntry& entry, float x, float y, float z)
+{
+	float dx = entry.x - x;
+	float dy = entry.y - y;
+	float dz = entry.z - z;
+	return dx * dx + dy * dy + dz * dz;
+}
+
+static int BruteRadius(const Scenario& scenario, float x, float y, float z, float radius, UInt32* out)
+{
+	float radiusSq = radius * radius;
+	int found = 0;
+	for (const GridEntry& actor : scenario.actors)
+	{
+		if (DistSq(actor, x, y, z) <= radiusSq) out[found++] = actor.formID;
+	}
+	return found;
+}
+
+static int BruteNearest(const Scenario& scenario, float x, float y, float z, float maxRadius, int k, bool hostileOnly, float* outDistSq)
+{
+	float maxSq = maxRadius * maxRadius;
+	int found = 0;
+	for (const GridEntry& actor : scenario.actors)
+	{
+		if (hostileOnly && !scenario.hostile[actor.formID]) continue;
+		float distSq = DistSq(actor, x, y, z);
+		if (distSq > maxSq) continue;
+		if (found == k && distSq >= outDistSq[k - 1]) continue;
+
+		int slot = (found < k) ? found++ : k - 1;
+		while (slot > 0 && outDistSq[slot - 1] > distSq)
+		{
+			outDistSq[slot] = outDistSq[slot - 1];
+			slot--;
+		}
+		outDistSq[slot] = distSq;
+	}
+	return found;
+}
+
+static void Run(int count, std::mt19937& rng)
+{
+	Scenario scenario;
+	MakeScenario(scenario, count, rng);
+
+	// Build (the gathered copy is refreshed each time, as every rebuild gathers afresh)
+	const int BUILDS = 200;
+	double buildNs = 0.0;
+	for (int b = 0; b < BUILDS; b++)
+	{
+		std::copy(scenario.actors.begin(), scenario.actors.end(), scenario.gathered.begin());
+		double start = NowNs();
+		BuildGridIndex(scenario.gathered.data(), count, scenario.index);
+		buildNs += NowNs() - start;
+	}
+	buildNs /= BUILDS;
+	CHECK(scenario.index.entryCount == count);
+
+	// Query points: half at actors (riders stand among them), half anywhere
+	std::uniform_real_distribution<float> spanDist(0.0f, LOADED_SPAN);
+	std::uniform_int_distribution<int> actorDist(0, count - 1);
+	std::vector<float> qx(QUERIES), qy(QUERIES), qz(QUERIES);
+	for (int q = 0; q < QUERIES; q++)
+	{
+		if (q & 1)
+		{
+			qx[q] = spanDist(rng);
+			qy[q] = spanDist(rng);
+			qz[q] = 300.0f;
+		}
+		else
+		{
+			const GridEntry& actor = scenario.actors[actorDist(rng)];
+			qx[q] = actor.x;
+			qy[q] = actor.y;
+			qz[q] = actor.z;
+		}
+	}
+
+	FilterContext filter = { &scenario.index, &scenario.hostile };
+	std::vector<int> gridOut(count);
+	std::vector<UInt32> gridIDs(count), bruteIDs(count);
+	float gridDist[GRID_MAX_NEAREST], bruteDist[GRID_MAX_NEAREST];
+	int nearestOut[GRID_MAX_NEAREST];
+	volatile long long sink = 0;
+
+	// Correctness, all three query kinds
+	for (int q = 0; q < QUERIES; q++)
+	{
+		int gridFound = QueryIndexRadius(scenario.index, qx[q], qy[q], qz[q], RADIUS_QUERY, nullptr, nullptr, gridOut.data(), count);
+		int bruteFound = BruteRadius(scenario, qx[q], qy[q], qz[q], RADIUS_QUERY, bruteIDs.data());
+		CHECK(gridFound == bruteFound);
+		for (int i = 0; i < gridFound; i++) gridIDs[i] = scenario.index.entries[gridOut[i]].formID;
+		std::sort(gridIDs.begin(), gridIDs.begin() + gridFound);
+		std::sort(bruteIDs.begin(), bruteIDs.begin() + bruteFound);
+		CHECK(std::equal(gridIDs.begin(), gridIDs.begin() + gridFound, bruteIDs.begin()));
+
+		int kinds[2] = { 1, 8 };
+		for (int k : kinds)
+		{
+			int g = QueryIndexNearest(scenario.index, qx[q], qy[q], qz[q], NEAREST_QUERY, k, HostileFilter, &filter, nearestOut, gridDist);
+			int b = BruteNearest(scenario, qx[q], qy[q], qz[q], NEAREST_QUERY, k, true, bruteDist);
+			CHECK(g == b);
+			for (int i = 0; i < g && i < b; i++) CHECK(gridDist[i] == bruteDist[i]);
+		}
+
+		if (g_failures > 10) return;
+	}
+
+	// Timing
+	double start = NowNs();
+	for (int q = 0; q < QUERIES; q++)
+	{
+		sink = sink + QueryIndexRadius(scenario.index, qx[q], qy[q], qz[q], RADIUS_QUERY, nullptr, nullptr, gridOut.data(), count);
+	}
+	double radiusGrid = (NowNs() - start) / QUERIES;
+
+	start = NowNs();
+	for (int q = 0; q < QUERIES; q++)
+	{
+		sink = sink + BruteRadius(scenario, qx[q], qy[q], qz[q], RADIUS_QUERY, bruteIDs.data());
+	}
+	double radiusBrute = (NowNs() - start) / QUERIES;
+
+	double nearestGrid[2], nearestBrute[2];
+	int kinds[2] = { 1, 8 };
+	for (int n = 0; n < 2; n++)
+	{
+		start = NowNs();
+		for (int q = 0; q < QUERIES; q++)
+		{
+			sink = sink + QueryIndexNearest(scenario.index, qx[q], qy[q], qz[q], NEAREST_QUERY, kinds[n], HostileFilter, &filter, nearestOut, gridDist);
+		}
+		nearestGrid[n] = (NowNs() - start) / QUERIES;
+
+		start = NowNs();
+		for (int q = 0; q < QUERIES; q++)
+		{
+			sink = sink + BruteNearest(scenario, qx[q], qy[q], qz[q], NEAREST_QUERY, kinds[n], true, bruteDist);
+		}
+		nearestBrute[n] = (NowNs() - start) / QUERIES;
+	}
+
+	std::printf("%-7d %10.0f   %8.0f / %-8.0f   %8.0f / %-8.0f   %8.0f / %-8.0f   %dx%d @ %.0f\n",
+		count, buildNs, radiusGrid, radiusBrute, nearestGrid[0], nearestBrute[0], nearestGrid[1], nearestBrute[1],
+		scenario.index.dimX, scenario.index.dimY, scenario.index.bucketSize);
+}
+
+int main()
+{
+	std::mt19937 rng(31);
+
+	std::printf("ns per call, grid / linear scan\n");
+	std::printf("%-7s %10s   %-19s   %-19s   %-19s   %s\n", "actors", "build", "radius 2000", "nearest k=1", "nearest k=8", "buckets");
+
+	Run(50, rng);
+	Run(500, rng);
+	Run(5000, rng);
+
+	if (g_failures == 0)
+	{
+		std::printf("SpatialGridBench: all checks passed\n");
+		return 0;
+	}
+	std::printf("SpatialGridBench: %d check(s) failed\n", g_failures);
+	return 1;
+}
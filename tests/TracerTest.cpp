@@ -0,0 +1,506 @@
+// ============================================
+// TRACER TEST (Linux / any host, no game needed)
+// ============================================
+// Build and run from the repository root:
+//     g++ -std=c++17 -O2 -pthread -I. -Itests/stubs tests/TracerTest.cpp TracerCore.cpp -o tracer_test
+//     ./tracer_test
+//
+// Records whole sessions through the real buffers and writer thread,
+// flushes them, then parses the file back:
+// - the file is valid JSON (strict parse of the whole array)
+// - B/E events pair up per thread, in order, with matching names
+// - off-thread spans arrive as X events on their own threads, with a
+//   duration
+// - accounting: events recorded == events in the file + dropped
+// - overflow drops whole frames: every frame is in the file with all
+//   of its events or not at all. Covered with a frame larger than a
+//   buffer, and with the writer held up until both buffers are full.
+// The game-side hooks (file location, thread IDs, INI switch) are
+// supplied here; the file is written to the working directory.
+// ============================================
+
+#include "Tracer.h"
+#include "common/IDebugLog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MountedNPCCombatVR;
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+
+// ============================================
+// GAME SIDE STAND-INS
+// ============================================
+
+static std::atomic<bool> g_holdWriter(false);   // Writer waits in OpenTraceFile while set
+static std::atomic<int> g_sessionIndex(0);
+static std::string g_sessionPath;               // Written by the writer thread, read after FlushTracer
+
+namespace MountedNPCCombatVR
+{
+	namespace Tracer
+	{
+		FILE* OpenTraceFile()
+		{
+			while (g_holdWriter.load())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			char path[64];
+			std::snprintf(path, sizeof(path), "tracer_test_%d.json", g_sessionIndex.load());
+			g_sessionPath = path;
+			return std::fopen(path, "wb");
+		}
+
+		uint32_t GetTraceThreadID()
+		{
+			static std::atomic<uint32_t> s_nextID(100);
+			thread_local uint32_t id = s_nextID.fetch_add(1);
+			return id;
+		}
+
+		bool IsTraceEnabled()
+		{
+			return true;
+		}
+	}
+}
+
+// ============================================
+// JSON (strict parser, just enough for the trace format)
+// ============================================
+
+struct ParsedEvent
+{
+	std::string name;
+	std::string phase;
+	double ts = -1.0;
+	double dur = -1.0;
+	unsigned tid = 0;
+	unsigned formID = 0;
+};
+
+class JsonReader
+{
+public:
+	explicit JsonReader(const std::string& text) : m_text(text), m_pos(0) {}
+
+	// Whole document: an array of event objects
+	bool ReadTrace(std::vector<ParsedEvent>& out)
+	{
+		SkipSpace();
+		if (!Consume('[')) return false;
+		SkipSpace();
+		if (!Consume(']'))
+		{
+			for (;;)
+			{
+				ParsedEvent event;
+				if (!ReadEvent(event)) return false;
+				out.push_back(event);
+				SkipSpace();
+				if (Consume(']')) break;
+				if (!Consume(',')) return false;
+				SkipSpace();
+			}
+		}
+		SkipSpace();
+		return m_pos == m_text.size();
+	}
+
+private:
+	const std::string& m_text;
+	size_t m_pos;
+
+	void SkipSpace()
+	{
+		while (m_pos < m_text.size() && std::strchr(" \t\r\n", m_text[m_pos])) m_pos++;
+	}
+
+	bool Consume(char c)
+	{
+		if (m_pos < m_text.size() && m_text[m_pos] == c)
+		{
+			m_pos++;
+			return true;
+		}
+		return false;
+	}
+
+	bool ReadString(std::string& out)
+	{
+		if (!Consume('"')) return false;
+		out.clear();
+		while (m_pos < m_text.size())
+		{
+			char c = m_text[m_pos++];
+			if (c == '"') return true;
+			if ((unsigned char)c < 0x20) return false;
+			if (c == '\\')
+			{
+				if (m_pos >= m_text.size()) return false;
+				char escaped = m_text[m_pos++];
+				if (!std::strchr("\"\\/bfnrt", escaped)) return false;   // No \u in our output
+				c = escaped;
+			}
+			out += c;
+		}
+		return false;
+	}
+
+	bool ReadNumber(double& out)
+	{
+		size_t start = m_pos;
+		Consume('-');
+		if (m_pos >= m_text.size() || !isdigit((unsigned char)m_text[m_pos])) return false;
+		if (m_text[m_pos] == '0' && m_pos + 1 < m_text.size() && isdigit((unsigned char)m_text[m_pos + 1])) return false;
+		while (m_pos < m_text.size() && isdigit((unsigned char)m_text[m_pos])) m_pos++;
+		if (Consume('.'))
+		{
+			if (m_pos >= m_text.size() || !isdigit((unsigned char)m_text[m_pos])) return false;
+			while (m_pos < m_text.size() && isdigit((unsigned char)m_text[m_pos])) m_pos++;
+		}
+		out = std::strtod(m_text.c_str() + start, nullptr);
+		return true;
+	}
+
+	// {"key": string | number | {"key": string}, ...}
+	bool ReadEvent(ParsedEvent& event)
+	{
+		if (!Consume('{')) return false;
+		SkipSpace();
+		if (Consume('}')) return true;
+
+		for (;;)
+		{
+			std::string key;
+			SkipSpace();
+			if (!ReadString(key)) return false;
+			SkipSpace();
+			if (!Consume(':')) return false;
+			SkipSpace();
+
+			if (m_pos < m_text.size() && m_text[m_pos] == '"')
+			{
+				std::string value;
+				if (!ReadString(value)) return false;
+				if (key == "name") event.name = value;
+				else if (key == "ph") event.phase = value;
+			}
+			else if (m_pos < m_text.size() && m_text[m_pos] == '{')
+			{
+				ParsedEvent args;
+				size_t argsStart = m_pos;
+				if (!ReadEvent(args)) return false;
+				if (key == "args")
+				{
+					std::string argsText = m_text.substr(argsStart, m_pos - argsStart);
+					unsigned formID = 0;
+					if (std::sscanf(argsText.c_str(), "{\"formID\":\"%8X\"}", &formID) != 1) return false;
+					event.formID = formID;
+				}
+			}
+			else
+			{
+				double value = 0.0;
+				if (!ReadNumber(value)) return false;
+				if (key == "ts") event.ts = value;
+				else if (key == "dur") event.dur = value;
+				else if (key == "tid") event.tid = (unsigned)value;
+			}
+
+			SkipSpace();
+			if (Consume('}')) return true;
+			if (!Consume(',')) return false;
+		}
+	}
+};
+
+static bool ReadTraceFile(const std::string& path, std::vector<ParsedEvent>& out)
+{
+	FILE* file = std::fopen(path.c_str(), "rb");
+	if (!file) return false;
+
+	std::string text;
+	char chunk[4096];
+	size_t got;
+	while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, got);
+	std::fclose(file);
+
+	JsonReader reader(text);
+	return reader.ReadTrace(out);
+}
+
+// ============================================
+// SESSION HELPERS
+// ============================================
+
+// One frame: a "Frame" span around 'riders' rider spans with a nested
+// decision span. Every event carries the frame's tag as formID so the
+// file can be checked frame by frame. Returns the events recorded.
+static uint64_t RecordFrame(uint32_t tag, int riders)
+{
+	Tracer::BeginFrame();
+	{
+		TRACE_SCOPE_FORM("Frame", tag);
+		for (int r = 0; r < riders; r++)
+		{
+			TRACE_SCOPE_FORM("Rider", tag);
+			TRACE_SCOPE_FORM("Decide \"quoted\"", tag);   // Name needs escaping
+		}
+	}
+	Tracer::EndFrame();
+	return 2 + 4 * (uint64_t)riders;
+}
+
+static uint64_t FrameEventCount(int riders)
+{
+	return 2 + 4 * (uint64_t)riders;
+}
+
+struct SessionResult
+{
+	std::vector<ParsedEvent> events;
+	std::map<uint32_t, uint64_t> eventsPerTag;
+	unsigned frameThreadID = 0;
+	bool parsed = false;
+};
+
+static void FinishSession(SessionResult& result)
+{
+	Tracer::FlushTracer(10000);
+
+	result.parsed = ReadTraceFile(g_sessionPath, result.events);
+	CHECK(result.parsed);
+	std::remove(g_sessionPath.c_str());
+
+	for (const ParsedEvent& event : result.events)
+	{
+		if (event.formID != 0) result.eventsPerTag[event.formID]++;
+		if (event.phase == "B" || event.phase == "E") result.frameThreadID = event.tid;
+	}
+}
+
+// Per thread: every E closes the most recent open B of the same name,
+// nothing stays open, and timestamps never go backwards
+static void CheckBalanced(const SessionResult& result)
+{
+	std::map<unsigned, std::vector<std::string>> open;
+	std::map<unsigned, double> lastTs;
+	int unmatched = 0;
+	int backwards = 0;
+
+	for (const ParsedEvent& event : result.events)
+	{
+		if (event.phase != "B" && event.phase != "E") continue;
+
+		if (lastTs.count(event.tid) && event.ts < lastTs[event.tid]) backwards++;
+		lastTs[event.tid] = event.ts;
+
+		std::vector<std::string>& stack = open[event.tid];
+		if (event.phase == "B")
+		{
+			stack.push_back(event.name);
+		}
+		else if (stack.empty() || stack.back() != event.name)
+		{
+			unmatched++;
+		}
+		else
+		{
+			stack.pop_back();
+		}
+	}
+
+	CHECK(unmatched == 0);
+	CHECK(backwards == 0);
+	for (const auto& entry : open) CHECK(entry.second.empty());
+}
+
+// ============================================
+// TESTS
+// ============================================
+
+static void TestFormat()
+{
+	Tracer::TraceEvent event = {};
+	event.timeNs = 5001234;
+	event.name = "Scan";
+	event.threadID = 7;
+	event.phase = Tracer::TRACE_BEGIN;
+
+	char line[256];
+	int length = Tracer::FormatTraceEvent(event, 1000000, line, sizeof(line));
+	CHECK(length > 0 && std::strcmp(line, "{\"name\":\"Scan\",\"ph\":\"B\",\"ts\":4001.234,\"pid\":1,\"tid\":7}") == 0);
+
+	event.phase = Tracer::TRACE_COMPLETE;
+	event.durationNs = 2500;
+	event.formID = 0x0001A2B3;
+	length = Tracer::FormatTraceEvent(event, 1000000, line, sizeof(line));
+	CHECK(length > 0 && std::strstr(line, ",\"dur\":2.500,\"args\":{\"formID\":\"0001A2B3\"}}") != nullptr);
+
+	// Too small a buffer writes nothing rather than half an object
+	CHECK(Tracer::FormatTraceEvent(event, 1000000, line, 20) == 0);
+}
+
+static void TestSession()
+{
+	g_sessionIndex++;
+	uint64_t droppedBefore = Tracer::GetDroppedEventCount();
+	uint64_t recorded = 0;
+
+	// Open the session first so the side threads only run while tracing
+	recorded += RecordFrame(1, 1);
+
+	// Off-thread spans (projectile hooks) during the frames
+	const int SIDE_THREADS = 2;
+	const int SIDE_SPANS = 300;
+	std::atomic<uint64_t> sideRecorded(0);
+	std::vector<std::thread> side;
+	for (int t = 0; t < SIDE_THREADS; t++)
+	{
+		side.emplace_back([&sideRecorded]() {
+			for (int i = 0; i < SIDE_SPANS; i++)
+			{
+				{
+					TRACE_SCOPE("ProjectileHook");
+					{
+						TRACE_SCOPE_FORM("ProjectileInner", 0);
+					}
+				}
+				sideRecorded += 2;
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+			}
+		});
+	}
+
+	const int FRAMES = 400;
+	const int RIDERS = 10;
+	for (int f = 2; f <= FRAMES; f++)
+	{
+		recorded += RecordFrame((uint32_t)f, RIDERS);
+		if (f % 50 == 0)
+		{
+			TRACE_SCOPE("BetweenFrames");   // Events outside a frame form their own group
+			recorded += 2;
+		}
+		if (f % 20 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// One frame larger than a whole buffer can never be written - it
+	// must be dropped as a unit, not cut
+	const uint32_t GIANT_TAG = 0x00C0FFEE;
+	const int GIANT_RIDERS = (int)(Tracer::TRACE_BUFFER_EVENTS / 4) + 10;
+	recorded += RecordFrame(GIANT_TAG, GIANT_RIDERS);
+	recorded += RecordFrame((uint32_t)FRAMES + 1, RIDERS);
+
+	for (std::thread& thread : side) thread.join();
+	recorded += sideRecorded.load();
+
+	SessionResult result;
+	FinishSession(result);
+	if (!result.parsed) return;
+
+	uint64_t dropped = Tracer::GetDroppedEventCount() - droppedBefore;
+	CHECK((uint64_t)result.events.size() + dropped == recorded);
+
+	CHECK(result.eventsPerTag.count(GIANT_TAG) == 0);
+	CHECK(dropped >= FrameEventCount(GIANT_RIDERS));
+	CHECK(result.eventsPerTag.count((uint32_t)FRAMES + 1) == 1);   // Recording resumed after the drop
+
+	for (const auto& entry : result.eventsPerTag)
+	{
+		uint64_t expected = (entry.first == 1) ? FrameEventCount(1) : FrameEventCount(RIDERS);
+		CHECK(entry.second == expected);
+	}
+
+	CheckBalanced(result);
+
+	// Off-thread spans: complete events on the side threads' own rows
+	int sideEvents = 0;
+	std::map<unsigned, int> sideThreads;
+	for (const ParsedEvent& event : result.events)
+	{
+		if (event.phase != "X") continue;
+		sideEvents++;
+		sideThreads[event.tid]++;
+		CHECK(event.tid != result.frameThreadID);
+		CHECK(event.dur >= 0.0);
+		CHECK(event.name == "ProjectileHook" || event.name == "ProjectileInner");
+	}
+	CHECK(sideThreads.size() == (size_t)SIDE_THREADS);
+	CHECK(sideEvents > 0 && (uint64_t)sideEvents <= sideRecorded.load());
+}
+
+static void TestWriterBehind()
+{
+	g_sessionIndex++;
+	uint64_t droppedBefore = Tracer::GetDroppedEventCount();
+	uint64_t recorded = 0;
+
+	// The writer picks up the first full buffer, then stalls opening the
+	// file; the second buffer fills and every later frame must be dropped
+	g_holdWriter = true;
+
+	const int RIDERS = 40;
+	const int FRAMES = 600;   // Enough events for well over two buffers
+	for (int f = 1; f <= FRAMES; f++)
+	{
+		recorded += RecordFrame((uint32_t)f, RIDERS);
+	}
+
+	uint64_t droppedWhileHeld = Tracer::GetDroppedEventCount() - droppedBefore;
+	CHECK(droppedWhileHeld > 0);
+	CHECK(droppedWhileHeld % FrameEventCount(RIDERS) == 0);
+
+	g_holdWriter = false;
+
+	SessionResult result;
+	FinishSession(result);
+	if (!result.parsed) return;
+
+	uint64_t dropped = Tracer::GetDroppedEventCount() - droppedBefore;
+	CHECK((uint64_t)result.events.size() + dropped == recorded);
+	CHECK(dropped == droppedWhileHeld);
+
+	int framesWritten = 0;
+	for (const auto& entry : result.eventsPerTag)
+	{
+		CHECK(entry.second == FrameEventCount(RIDERS));
+		framesWritten++;
+	}
+	CHECK(framesWritten > 0 && framesWritten < FRAMES);
+	CHECK((uint64_t)(FRAMES - framesWritten) * FrameEventCount(RIDERS) == dropped);
+
+	CheckBalanced(result);
+}
+
+int main()
+{
+	TestLogSink() = stderr;   // Keep the writer's log lines out of the results
+
+	TestFormat();
+	TestSession();
+	TestWriterBehind();
+
+	if (g_failures == 0)
+	{
+		std::printf("TracerTest: all checks passed\n");
+		std::fflush(stdout);
+		std::_Exit(0);   // The writer thread is detached and never exits
+	}
+	std::printf("TracerTest: %d check(s) failed\n", g_failures);
+	std::fflush(stdout);
+	std::_Exit(1);
+}
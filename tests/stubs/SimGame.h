@@ -0,0 +1,132 @@
+#pragma once
+
+// ============================================
+// GAME STAND-INS FOR THE HEADLESS COMBAT SIMULATION
+// ============================================
+// Just enough of the SKSE object model for tests/CombatSimBench.cpp to
+// run the rider loop the way UpdateMountedCombat does: form lookup by
+// ID, reference position/rotation, mount and combat target, and a
+// game clock. Field names follow skse64 (formID, pos, rot) so the
+// harness gather code reads like MountedCombat.cpp.
+//
+// Nothing here allocates after SimWorld::Reset, so the benchmark can
+// count allocations made by the decision code alone.
+// ============================================
+
+#include <cstdint>
+#include <cstring>
+
+typedef uint8_t UInt8;
+typedef uint32_t UInt32;
+
+struct NiPoint3
+{
+	float x, y, z;
+};
+
+struct TESForm
+{
+	UInt32 formID;
+	uint8_t formType;
+};
+
+struct TESObjectREFR : TESForm
+{
+	NiPoint3 rot;
+	NiPoint3 pos;
+};
+
+struct Actor : TESObjectREFR
+{
+	Actor* mount;           // Horse (riders only)
+	Actor* combatTarget;    // Current threat
+	bool dead;
+	bool inCombat;
+	bool bowEquipped;
+	bool hasBowInInventory;
+	float weaponReach;
+	float speed;            // Units per second (horses)
+
+	bool IsDead(int) const { return dead; }
+	bool IsInCombat() const { return inCombat; }
+
+	// Mirrors CALL_MEMBER_FN(actor, GetMount)(NiPointer<Actor>&)
+	bool GetMount(Actor*& outMount) const
+	{
+		outMount = mount;
+		return mount != nullptr;
+	}
+};
+
+const uint8_t kFormType_Character = 62;
+
+// Declared only (headers take pointers to them)
+struct TESObjectCELL;
+struct TESWorldSpace;
+
+// ============================================
+// SIM WORLD
+// ============================================
+
+namespace SimWorld
+{
+	const int MAX_ACTORS = 1024;
+
+	struct World
+	{
+		Actor actors[MAX_ACTORS];
+		int actorCount;
+		double gameTime;    // Seconds since the simulation started
+	};
+
+	inline World& Get()
+	{
+		static World world;
+		return world;
+	}
+
+	inline void Reset()
+	{
+		World& world = Get();
+		std::memset(&world, 0, sizeof(world));
+	}
+
+	// Form IDs are 0xFF000000 | index, like runtime-created references
+	inline Actor* Spawn(float x, float y, float z)
+	{
+		World& world = Get();
+		if (world.actorCount >= MAX_ACTORS) return nullptr;
+		Actor* actor = &world.actors[world.actorCount];
+		actor->formID = 0xFF000000u | (UInt32)world.actorCount;
+		actor->formType = kFormType_Character;
+		actor->pos = { x, y, z };
+		world.actorCount++;
+		return actor;
+	}
+
+	inline double GetGameTime()
+	{
+		return Get().gameTime;
+	}
+
+	inline void AdvanceTime(double seconds)
+	{
+		Get().gameTime += seconds;
+	}
+}
+
+// Mirrors skse64 LookupFormByID: nullptr for unknown IDs
+inline TESForm* LookupFormByID(UInt32 formID)
+{
+	if ((formID & 0xFF000000u) != 0xFF000000u) return nullptr;
+	UInt32 index = formID & 0x00FFFFFFu;
+	SimWorld::World& world = SimWorld::Get();
+	if ((int)index >= world.actorCount) return nullptr;
+	return &world.actors[index];
+}
+
+inline Actor* LookupActorByID(UInt32 formID)
+{
+	TESForm* form = LookupFormByID(formID);
+	return (form && form->formType == kFormType_Character) ? static_cast<Actor*>(form) : nullptr;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// ============================================
+// STAND-IN: SKSE common/IDebugLog.h (tests only)
+// ============================================
+// _MESSAGE writes one line to TestLogSink() (stdout unless a test
+// points it elsewhere).
+// ============================================
+
+#include <cstdio>
+
+inline FILE*& TestLogSink()
+{
+	static FILE* sink = stdout;
+	return sink;
+}
+
+#define _MESSAGE(...) (std::fprintf(TestLogSink(), __VA_ARGS__), std::fputc('\n', TestLogSink()))
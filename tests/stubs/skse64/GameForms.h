@@ -0,0 +1,4 @@
+#pragma once
+
+// Stand-in for skse64/GameForms.h: the headless harness object model
+#include "SimGame.h"